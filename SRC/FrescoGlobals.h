@@ -77,6 +77,9 @@ static const int OF_RemoteTest_getInitialStiff  = 12;
 static const int OF_RemoteTest_getTangentStiff  = 13;
 static const int OF_RemoteTest_getDamp          = 14;
 static const int OF_RemoteTest_getMass          = 15;
+static const int OF_RemoteTest_setTrialGetDaqResponse = 16;
+static const int OF_RemoteTest_selectSite       = 17;
+static const int OF_RemoteTest_setTrialGetDaqBatch = 18;
 static const int OF_RemoteTest_DIE              = 99;
 
 // tentative remote test
@@ -85,4 +88,18 @@ static const int OF_RemoteTest_acquire          = 50;
 // Network Transmition Data Size
 static const int OF_Network_dataSize = 256; //536; 
 
+// Network Protocol
+// fixed:  every message is padded to dataSize (legacy clients)
+// framed: header (action, payload length, sequence number)
+//         followed by a payload of the exact size
+static const int OF_Network_fixed  = 0;
+static const int OF_Network_framed = 1;
+
+// Batch of Sites sharing one Connection (framed protocol only)
+// selectSite:          (action, site index), the next message is
+//                      addressed to the site with this index
+// setTrialGetDaqBatch: (action, number of sites, then site index and
+//                      trial data of each site), the reply holds the
+//                      daq data of the sites in the same order
+
 #endif
@@ -0,0 +1,177 @@
+# File: benchMacro.tcl
+#
+# $Revision$
+# $Date$
+# $URL$
+#
+# Created: 10/26
+# Revision: A
+#
+# Purpose: this file runs the macro benchmarks, i.e. the example models
+# with simulated controls, and writes the results as JSON. Each model
+# is run in its own interpreter process from within the example
+# directory. The wall time of the process is measured here, the time
+# of each analysis step is read from the elapsedTime.txt file that the
+# example scripts write. For the models with a server the server is
+# started first and the client after serverDelay milliseconds.
+#
+# Usage: tclsh benchMacro.tcl $program $examplesDir <-file $fileName>
+#            <-serverDelay $ms> <-model $name>
+#
+# $program is the OpenSees interpreter with the OpenFresco package
+# and $examplesDir is the EXAMPLES directory of OpenFresco.
+
+# ------------------------------
+# Start of benchmark definitions
+# ------------------------------
+# name, directory, control, server script, client script
+set models {
+    {TwoDOFModel        TwoDOFModel         SimUniaxialMaterials {} TwoDOF_Local.tcl}
+    {OneBayFrame        OneBayFrame/OpenSees SimUniaxialMaterials {} OneBayFrame_Local.tcl}
+    {ThreeStoryBuilding ThreeStoryBuilding  SimDomain ThreeStoryBuilding_Server.tcl ThreeStoryBuilding_Client.tcl}
+}
+# --------------------------------
+# End of benchmark definitions
+# --------------------------------
+
+# parse the arguments
+if {$argc < 2} {
+    puts stderr "usage: tclsh benchMacro.tcl program examplesDir <-file fileName> <-serverDelay ms> <-model name>"
+    exit 1
+}
+set program [lindex $argv 0]
+set examplesDir [file normalize [lindex $argv 1]]
+set fileName {}
+set serverDelay 2000
+set modelFilter {}
+for {set i 2} {$i < $argc} {incr i} {
+    set arg [lindex $argv $i]
+    if {$arg == "-file" && $i+1 < $argc} {
+        incr i
+        set fileName [file normalize [lindex $argv $i]]
+    } elseif {$arg == "-serverDelay" && $i+1 < $argc} {
+        incr i
+        set serverDelay [lindex $argv $i]
+    } elseif {$arg == "-model" && $i+1 < $argc} {
+        incr i
+        set modelFilter [lindex $argv $i]
+    } else {
+        puts stderr "WARNING unknown argument $arg"
+        exit 1
+    }
+}
+# use the full path of the program, since it is run from the example directories
+if {[file exists $program]} {
+    set program [file normalize $program]
+}
+
+# reads the step times in microseconds from elapsedTime.txt
+proc readStepTimes {fileName} {
+    set times {}
+    if {[catch {open $fileName r} fileID]} {
+        return $times
+    }
+    while {[gets $fileID line] >= 0} {
+        set t [lindex $line 0]
+        if {[string is double -strict $t]} {
+            lappend times $t
+        }
+    }
+    close $fileID
+    return $times
+}
+
+# returns the p-th percentile of a sorted list
+proc percentile {sorted p} {
+    set n [llength $sorted]
+    if {$n == 0} {
+        return 0.0
+    }
+    set k [expr {int(ceil($p/100.0*$n))-1}]
+    if {$k < 0} {
+        set k 0
+    }
+    return [lindex $sorted $k]
+}
+
+# runs one model and returns its JSON object
+proc runModel {model} {
+    global program examplesDir serverDelay
+    foreach {name dir control server client} $model {}
+
+    set oldDir [pwd]
+    cd [file join $examplesDir $dir]
+    file delete -force elapsedTime.txt
+    puts stderr "running $name ($control) ..."
+
+    set status ok
+    if {$server != {}} {
+        # start the server and give it time to listen, the wall time
+        # starts with the client
+        set serverID [open "|[list $program $server] 2>@1" r]
+        fconfigure $serverID -blocking 0
+        after $serverDelay
+    }
+    set tStart [clock clicks -milliseconds]
+    if {[catch {exec $program $client 2>@1} output]} {
+        set status failed
+        puts stderr $output
+    }
+    if {$server != {}} {
+        # wait for the server to exit
+        fconfigure $serverID -blocking 1
+        read $serverID
+        if {[catch {close $serverID} output]} {
+            set status failed
+            puts stderr $output
+        }
+    }
+    set wallTime [expr {([clock clicks -milliseconds]-$tStart)/1000.0}]
+
+    # statistics of the step times
+    set times [lsort -real [readStepTimes elapsedTime.txt]]
+    set numSteps [llength $times]
+    set sum 0.0
+    foreach t $times {
+        set sum [expr {$sum+$t}]
+    }
+    if {$numSteps > 0} {
+        set mean [expr {$sum/$numSteps}]
+    } else {
+        set mean 0.0
+        set status failed
+    }
+    cd $oldDir
+
+    puts stderr [format "%-20s %8.3f s wall, %6d steps, %10.1f us/step" \
+        $name $wallTime $numSteps $mean]
+
+    return [format "{\"name\": \"%s\", \"control\": \"%s\", \"status\": \"%s\", \"wallTime\": %.3f, \"numSteps\": %d, \"usPerStep\": %.1f, \"usPerStepP50\": %.1f, \"usPerStepP99\": %.1f, \"usPerStepMax\": %.1f}" \
+        $name $control $status $wallTime $numSteps $mean \
+        [percentile $times 50] [percentile $times 99] [percentile $times 100]]
+}
+
+# run the models
+set results {}
+foreach model $models {
+    if {$modelFilter == {} || [string match *$modelFilter* [lindex $model 0]]} {
+        lappend results [runModel $model]
+    }
+}
+
+# write the results as JSON
+set json "\{\n"
+append json "  \"suite\": \"macro\",\n"
+append json "  \"timestamp\": [clock seconds],\n"
+append json "  \"program\": \"$program\",\n"
+append json "  \"results\": \[\n    "
+append json [join $results ",\n    "]
+append json "\n  \]\n\}"
+if {$fileName != {}} {
+    set fileID [open $fileName w]
+    puts $fileID $json
+    close $fileID
+} else {
+    puts $json
+}
+exit 0
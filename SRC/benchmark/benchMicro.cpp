@@ -0,0 +1,596 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Purpose: This file is the C++ standalone program with the micro
+// benchmarks of the OpenFresco hot paths: the transformations of the
+// experimental setups (linear and nonlinear geometry), the signal
+// filters, the tangent stiffness updates, the Vector/Matrix kernels
+// and the round trips of the channels over the loopback interface.
+// Every benchmark is calibrated to run for at least minSampleTime,
+// then numSamples samples are taken and the median and the minimum
+// time per operation are written as JSON.
+//
+// Usage: benchMicro <-file fileName> <-filter string> <-samples numSamples>
+
+// standard C++ includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <ID.h>
+
+// includes OpenFresco classes
+#include <FrescoGlobals.h>
+#include <ESOneActuator.h>
+#include <ESTwoActuators2d.h>
+#include <ESThreeActuators.h>
+#include <ESThreeActuators2d.h>
+#include <ESThreeActuatorsJntOff.h>
+#include <ESThreeActuatorsJntOff2d.h>
+#include <ESInvertedVBrace2d.h>
+#include <ESInvertedVBraceJntOff2d.h>
+#include <ESFourActuators3d.h>
+#include <ESFIIRFilter.h>
+#include <ESFFIRFilter.h>
+#include <ESFErrorSimRandomGauss.h>
+#include <ESFErrorSimTimeDelay.h>
+#include <ESFErrorSimUndershoot.h>
+#include <ESFTangForceConverter.h>
+#include <ESFKrylovForceConverter.h>
+#include <ETBroyden.h>
+#include <ETBfgs.h>
+#include <ETTranspose.h>
+#include <TCP_Socket.h>
+#include <UDP_Socket.h>
+#include <SharedMemoryChannel.h>
+
+// init the global variabled defined in OPS_Globals.h
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+// benchmark settings
+static int numSamples = 5;              // number of timed samples
+static double minSampleTime = 0.02;     // minimum duration of a sample [s]
+static const char *nameFilter = 0;      // only run matching benchmarks
+
+// results of one benchmark
+struct BenchResult
+{
+    std::string name;
+    std::string group;
+    long numIter;
+    double nsPerOpMedian;
+    double nsPerOpMin;
+};
+static std::vector<BenchResult> theResults;
+
+// keeps the compiler from removing the benchmarked work
+static volatile double benchSink = 0.0;
+
+
+// runs the operation op(i) numIter times and returns the elapsed time
+template <class Op>
+static double timeIter(Op &op, long numIter)
+{
+    steady_clock::time_point t0 = steady_clock::now();
+    for (long i=0; i<numIter; i++)
+        op(i);
+    return duration<double>(steady_clock::now() - t0).count();
+}
+
+
+// checks if the benchmark is selected by the name filter
+static bool isSelected(const std::string &name)
+{
+    return nameFilter == 0 || name.find(nameFilter) != std::string::npos;
+}
+
+
+// calibrates the number of iterations, takes the samples and stores
+// the result, setup work belongs outside of op
+template <class Op>
+static void runBench(const char *group, const std::string &name, Op op,
+    long maxIter = 1L << 30)
+{
+    if (!isSelected(name))
+        return;
+
+    // double the iterations until one sample takes long enough,
+    // this also warms up the caches and the branch predictors
+    long numIter = 1;
+    while (timeIter(op, numIter) < minSampleTime && numIter < maxIter)
+        numIter *= 2;
+
+    std::vector<double> nsPerOp(numSamples);
+    for (int s=0; s<numSamples; s++)
+        nsPerOp[s] = 1.0E9*timeIter(op, numIter)/numIter;
+    std::sort(nsPerOp.begin(), nsPerOp.end());
+
+    BenchResult res;
+    res.name = name;
+    res.group = group;
+    res.numIter = numIter;
+    res.nsPerOpMedian = nsPerOp[numSamples/2];
+    res.nsPerOpMin = nsPerOp[0];
+    theResults.push_back(res);
+
+    fprintf(stderr, "%-48s %12.1f ns/op (%ld iterations)\n",
+        name.c_str(), res.nsPerOpMedian, numIter);
+}
+
+
+// round trip of a trial and a daq response through an experimental
+// setup without control, the daq response is made from the transformed
+// trial response so that the nonlinear transformations iterate as in
+// a test
+static void benchSetup(const char *setupName, ExperimentalSetup *theSetup)
+{
+    int i, j;
+    if (theSetup->setup() != OF_ReturnType_completed)  {
+        opserr << "benchMicro - failed to setup " << setupName << endln;
+        exit(OF_ReturnType_failed);
+    }
+    ID sizeT = theSetup->getTrialSize();
+    ID sizeO = theSetup->getOutSize();
+    ID sizeC = theSetup->getCtrlSize();
+    ID sizeD = theSetup->getDaqSize();
+
+    // trial/out and ctrl/daq vectors, the unused ones have size 0
+    Vector *trial[OF_Resp_All], *out[OF_Resp_All];
+    Vector *ctrl[OF_Resp_All], *daq[OF_Resp_All];
+    for (j=0; j<OF_Resp_All; j++)  {
+        trial[j] = new Vector(sizeT(j));
+        out[j] = new Vector(sizeO(j));
+        ctrl[j] = new Vector(sizeC(j));
+        daq[j] = new Vector(sizeD(j));
+    }
+    int numAct = sizeC(OF_Resp_Disp);
+    #define vecPtr(v) ((v)->Size() > 0 ? (v) : (Vector*)0)
+
+    std::string name = std::string("setup/") + setupName;
+    runBench("setup", name, [&](long n) {
+        // small harmonic trial response around the initial geometry
+        double phase = 0.01*(n % 628);
+        for (i=0; i<trial[OF_Resp_Disp]->Size(); i++)  {
+            double s = sin(phase + i);
+            (*trial[OF_Resp_Disp])(i) = 0.05*s;
+            if (trial[OF_Resp_Vel]->Size() > i)
+                (*trial[OF_Resp_Vel])(i) = 0.5*cos(phase + i);
+            if (trial[OF_Resp_Accel]->Size() > i)
+                (*trial[OF_Resp_Accel])(i) = -5.0*s;
+        }
+        for (i=0; i<trial[OF_Resp_Time]->Size(); i++)
+            (*trial[OF_Resp_Time])(i) = 0.01*n;
+        theSetup->setTrialResponse(vecPtr(trial[OF_Resp_Disp]),
+            vecPtr(trial[OF_Resp_Vel]), vecPtr(trial[OF_Resp_Accel]),
+            (Vector*)0, vecPtr(trial[OF_Resp_Time]));
+
+        // feed the ctrl response back as daq response
+        theSetup->getTrialResponse(ctrl[OF_Resp_Disp], ctrl[OF_Resp_Vel],
+            ctrl[OF_Resp_Accel], ctrl[OF_Resp_Force], ctrl[OF_Resp_Time]);
+        for (j=0; j<OF_Resp_All; j++)  {
+            for (i=0; i<daq[j]->Size() && i<ctrl[j]->Size(); i++)
+                (*daq[j])(i) = (*ctrl[j])(i);
+        }
+        for (i=0; i<daq[OF_Resp_Force]->Size() && numAct>0; i++)
+            (*daq[OF_Resp_Force])(i) = 10.0*(*ctrl[OF_Resp_Disp])(i%numAct);
+        theSetup->setDaqResponse(daq[OF_Resp_Disp], daq[OF_Resp_Vel],
+            daq[OF_Resp_Accel], daq[OF_Resp_Force], daq[OF_Resp_Time]);
+        theSetup->getDaqResponse(vecPtr(out[OF_Resp_Disp]),
+            vecPtr(out[OF_Resp_Vel]), vecPtr(out[OF_Resp_Accel]),
+            vecPtr(out[OF_Resp_Force]), vecPtr(out[OF_Resp_Time]));
+        benchSink = benchSink + (*out[OF_Resp_Disp])(0);
+    });
+
+    #undef vecPtr
+    for (j=0; j<OF_Resp_All; j++)  {
+        delete trial[j];
+        delete out[j];
+        delete ctrl[j];
+        delete daq[j];
+    }
+    delete theSetup;
+}
+
+
+static void benchSetups()
+{
+    char left[] = "left";
+    ID dof(3);
+    dof(0) = 0; dof(1) = 1; dof(2) = 2;
+
+    for (int nlGeom=0; nlGeom<2; nlGeom++)  {
+        std::string geom = (nlGeom == 0) ? "/linear" : "/nonlinear";
+
+        // the one actuator setup is geometrically linear
+        if (nlGeom == 0)
+            benchSetup("ESOneActuator", new ESOneActuator(1, 0, 1, 1));
+        benchSetup(("ESTwoActuators2d" + geom).c_str(),
+            new ESTwoActuators2d(1, 100.0, 100.0, 50.0,
+            0, nlGeom, left));
+        benchSetup(("ESThreeActuators2d" + geom).c_str(),
+            new ESThreeActuators2d(1, 54.0, 54.0, 54.0, 36.0, 36.0,
+            0, nlGeom, left));
+        benchSetup(("ESThreeActuators" + geom).c_str(),
+            new ESThreeActuators(1, dof, 3, 3, 54.0, 54.0, 54.0,
+            36.0, 36.0, 0, nlGeom, left));
+        benchSetup(("ESThreeActuatorsJntOff2d" + geom).c_str(),
+            new ESThreeActuatorsJntOff2d(1, 54.0, 54.0, 54.0,
+            12.0, 36.0, 36.0, 12.0, 12.0, 12.0, 0, nlGeom, left));
+        benchSetup(("ESThreeActuatorsJntOff" + geom).c_str(),
+            new ESThreeActuatorsJntOff(1, dof, 3, 3, 54.0, 54.0, 54.0,
+            12.0, 36.0, 36.0, 12.0, 12.0, 12.0, 0, nlGeom, left));
+        benchSetup(("ESInvertedVBrace2d" + geom).c_str(),
+            new ESInvertedVBrace2d(1, 54.0, 54.0, 54.0, 36.0, 36.0,
+            0, nlGeom, left));
+        benchSetup(("ESInvertedVBraceJntOff2d" + geom).c_str(),
+            new ESInvertedVBraceJntOff2d(1, 54.0, 54.0, 54.0,
+            12.0, 36.0, 36.0, 12.0, 12.0, 12.0, 0, nlGeom, left));
+        benchSetup(("ESFourActuators3d" + geom).c_str(),
+            new ESFourActuators3d(1, 80.0, 80.0, 80.0, 80.0,
+            20.0, 20.0, 20.0, 20.0, 30.0, 10.0, 10.0,
+            15.0, 15.0, 60.0, 60.0, 12.0, 0, nlGeom));
+    }
+}
+
+
+// batch filtering of numChannels channels per step
+static void benchFilter(const char *filterName,
+    ExperimentalSignalFilter *theFilter, int numChannels)
+{
+    std::vector<double> in(numChannels), out(numChannels);
+    char name[128];
+    sprintf(name, "filter/%s/%dch", filterName, numChannels);
+    runBench("filter", name, [&](long n) {
+        for (int c=0; c<numChannels; c++)
+            in[c] = sin(0.01*(n % 628) + c);
+        theFilter->filtering(&in[0], &out[0], numChannels);
+        benchSink = benchSink + out[0];
+    });
+    delete theFilter;
+}
+
+
+// measured forces of a linear specimen converted by the force
+// converters, the tangent is updated in every step
+static void benchConverter(const char *filterName,
+    ExperimentalSignalFilter *theFilter, int numDOF)
+{
+    Vector disp(numDOF), force(numDOF);
+    Matrix K(numDOF, numDOF);
+    for (int i=0; i<numDOF; i++)
+        for (int j=0; j<numDOF; j++)
+            K(i,j) = (i == j) ? 10.0*(i+2) : -1.0;
+    theFilter->setSize(numDOF);
+
+    char name[128];
+    sprintf(name, "filter/%s/%ddof", filterName, numDOF);
+    runBench("filter", name, [&](long n) {
+        for (int i=0; i<numDOF; i++)
+            disp(i) = sin(0.01*(n % 628) + i);
+        force.addMatrixVector(0.0, K, disp, 1.0);
+        benchSink = benchSink + theFilter->converting(&disp, &force)(0);
+    });
+    delete theFilter;
+}
+
+
+static void benchFilters()
+{
+    const int numChannels[] = {1, 8, 64};
+    for (int k=0; k<3; k++)  {
+        int nc = numChannels[k];
+        benchFilter("ESFIIRFilter-butter4", new ESFIIRFilter(1,
+            ESFIIRFilter::designButterworthLowPass(4, 20.0, 1024.0)), nc);
+        benchFilter("ESFIIRFilter-notch", new ESFIIRFilter(1,
+            ESFIIRFilter::designNotch(60.0, 30.0, 1024.0)), nc);
+        benchFilter("ESFFIRFilter-avg16", new ESFFIRFilter(1, 16), nc);
+        benchFilter("ESFErrorSimRandomGauss",
+            new ESFErrorSimRandomGauss(1, 0.0, 0.01), nc);
+        benchFilter("ESFErrorSimTimeDelay",
+            new ESFErrorSimTimeDelay(1, 5.0), nc);
+        benchFilter("ESFErrorSimUndershoot",
+            new ESFErrorSimUndershoot(1, 0.01), nc);
+    }
+
+    const int numDOF[] = {3, 12};
+    for (int k=0; k<2; k++)  {
+        int nd = numDOF[k];
+        Matrix KInit(nd, nd);
+        for (int i=0; i<nd; i++)
+            KInit(i,i) = 12.0*(i+2);
+        benchConverter("ESFTangForceConverter-Broyden",
+            new ESFTangForceConverter(1, KInit, new ETBroyden(1)), nd);
+        benchConverter("ESFKrylovForceConverter",
+            new ESFKrylovForceConverter(1, nd, KInit), nd);
+    }
+}
+
+
+// tangent stiffness updates with the increments of a linear specimen
+// plus noise, the returned stiffness is passed back as previous one
+static void benchTangentStiff(ExperimentalTangentStiff *theTangStiff,
+    int numDOF)
+{
+    Vector Ddisp(numDOF), Dforce(numDOF);
+    Matrix KInit(numDOF, numDOF), KTrue(numDOF, numDOF);
+    for (int i=0; i<numDOF; i++)  {
+        for (int j=0; j<numDOF; j++)  {
+            KTrue(i,j) = (i == j) ? 10.0*(i+2) : -1.0;
+            KInit(i,j) = 1.2*KTrue(i,j);
+        }
+    }
+    unsigned int seed = 12345;
+    const Matrix *K = &KInit;
+
+    char name[128];
+    sprintf(name, "tangentStiff/%s/%ddof", theTangStiff->getClassType(),
+        numDOF);
+    runBench("tangentStiff", name, [&](long n) {
+        for (int i=0; i<numDOF; i++)  {
+            seed = 1664525*seed + 1013904223;
+            Ddisp(i) = (double)(seed >> 8)/(1 << 24) - 0.5;
+        }
+        Dforce.addMatrixVector(0.0, KTrue, Ddisp, 1.0);
+        for (int i=0; i<numDOF; i++)  {
+            seed = 1664525*seed + 1013904223;
+            Dforce(i) += 0.01*((double)(seed >> 8)/(1 << 24) - 0.5);
+        }
+        K = &theTangStiff->updateTangentStiff(&Ddisp, (Vector*)0,
+            (Vector*)0, &Dforce, (Vector*)0, &KInit, K);
+        benchSink = benchSink + (*K)(0,0);
+    });
+    delete theTangStiff;
+}
+
+
+static void benchTangentStiffs()
+{
+    const int numDOF[] = {3, 12};
+    for (int k=0; k<2; k++)  {
+        benchTangentStiff(new ETBroyden(1), numDOF[k]);
+        benchTangentStiff(new ETBfgs(1), numDOF[k]);
+        benchTangentStiff(new ETTranspose(1, 2*numDOF[k]), numDOF[k]);
+    }
+}
+
+
+// the Vector/Matrix kernels used by the elements and the setups
+static void benchKernels()
+{
+    const int size[] = {3, 12, 48};
+    for (int k=0; k<3; k++)  {
+        int n = size[k];
+        Vector a(n), b(n), c(n);
+        Matrix A(n,n), B(n,n), C(n,n), T(n,n);
+        for (int i=0; i<n; i++)  {
+            a(i) = 1.0 + i;
+            b(i) = 2.0 - i;
+            for (int j=0; j<n; j++)  {
+                A(i,j) = (i == j) ? 4.0*n : 1.0/(1.0 + i + j);
+                B(i,j) = 0.5*A(i,j);
+                T(i,j) = (i == j) ? 1.0 : 0.1;
+            }
+        }
+        char name[128];
+
+        sprintf(name, "kernel/Vector::addVector/n=%d", n);
+        runBench("kernel", name, [&](long) {
+            a.addVector(1.0, b, 1.0E-9);
+            benchSink = benchSink + a(0);
+        });
+        sprintf(name, "kernel/Vector::operator=/n=%d", n);
+        runBench("kernel", name, [&](long) {
+            c = a;
+            benchSink = benchSink + c(0);
+        });
+        sprintf(name, "kernel/Vector::addMatrixVector/n=%d", n);
+        runBench("kernel", name, [&](long) {
+            c.addMatrixVector(0.0, A, a, 1.0);
+            benchSink = benchSink + c(0);
+        });
+        sprintf(name, "kernel/Vector::addMatrixTransposeVector/n=%d", n);
+        runBench("kernel", name, [&](long) {
+            c.addMatrixTransposeVector(0.0, A, a, 1.0);
+            benchSink = benchSink + c(0);
+        });
+        sprintf(name, "kernel/Matrix::addMatrixProduct/n=%d", n);
+        runBench("kernel", name, [&](long) {
+            C.addMatrixProduct(0.0, A, B, 1.0);
+            benchSink = benchSink + C(0,0);
+        });
+        sprintf(name, "kernel/Matrix::addMatrixTripleProduct/n=%d", n);
+        runBench("kernel", name, [&](long) {
+            C.addMatrixTripleProduct(0.0, T, A, 1.0);
+            benchSink = benchSink + C(0,0);
+        });
+        sprintf(name, "kernel/Matrix::Solve/n=%d", n);
+        runBench("kernel", name, [&](long) {
+            A.Solve(a, c);
+            benchSink = benchSink + c(0);
+        });
+    }
+}
+
+
+// echo server for the channel round trips, a negative first entry
+// ends the loop
+static void echoServer(Channel *theChannel, int dataSize)
+{
+    if (theChannel->setUpConnection() != 0)  {
+        opserr << "benchMicro - failed to setup server connection\n";
+        exit(OF_ReturnType_failed);
+    }
+    Vector data(dataSize);
+    for (;;)  {
+        if (theChannel->recvVector(0, 0, data, 0) < 0)
+            break;
+        if (data(0) < 0.0)
+            break;
+        theChannel->sendVector(0, 0, data, 0);
+    }
+}
+
+
+// round trips of a vector of dataSize doubles between two threads,
+// the server channel is created first so that the client can connect
+static void benchChannel(const char *channelName, Channel *theServer,
+    Channel *theClient, int dataSize)
+{
+    char name[128];
+    sprintf(name, "channel/%s/%d", channelName, dataSize);
+    if (!isSelected(name))  {
+        delete theClient;
+        delete theServer;
+        return;
+    }
+
+    std::thread theThread(echoServer, theServer, dataSize);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    if (theClient->setUpConnection() != 0)  {
+        opserr << "benchMicro - failed to setup client connection\n";
+        exit(OF_ReturnType_failed);
+    }
+
+    Vector data(dataSize);
+    runBench("channel", name, [&](long n) {
+        data(0) = (double)n;
+        theClient->sendVector(0, 0, data, 0);
+        theClient->recvVector(0, 0, data, 0);
+        benchSink = benchSink + data(0);
+    }, 1L << 20);
+
+    // stop the echo server
+    data(0) = -1.0;
+    theClient->sendVector(0, 0, data, 0);
+    theThread.join();
+    delete theClient;
+    delete theServer;
+}
+
+
+static void benchChannels()
+{
+    const int dataSize[] = {8, OF_Network_dataSize};
+    unsigned int port = 44100;
+    for (int k=0; k<2; k++)  {
+        int ds = dataSize[k];
+
+        TCP_Socket *theTCPServer = new TCP_Socket(port);
+        theTCPServer->listenForConnections(1);
+        benchChannel("TCP_Socket", theTCPServer,
+            new TCP_Socket(port, "127.0.0.1"), ds);
+        port++;
+
+        char localhost[] = "127.0.0.1";
+        benchChannel("UDP_Socket", new UDP_Socket(port),
+            new UDP_Socket(port, localhost), ds);
+        port++;
+
+        benchChannel("SharedMemoryChannel", new SharedMemoryChannel(port),
+            new SharedMemoryChannel(port, "127.0.0.1"), ds);
+        port++;
+    }
+}
+
+
+// writes the results as JSON
+static void writeResults(FILE *out)
+{
+    fprintf(out, "{\n");
+    fprintf(out, "  \"suite\": \"micro\",\n");
+    fprintf(out, "  \"timestamp\": %ld,\n", (long)time(0));
+    fprintf(out, "  \"numSamples\": %d,\n", numSamples);
+    fprintf(out, "  \"results\": [\n");
+    for (size_t k=0; k<theResults.size(); k++)  {
+        const BenchResult &res = theResults[k];
+        fprintf(out, "    {\"name\": \"%s\", \"group\": \"%s\", "
+            "\"iterations\": %ld, \"nsPerOp\": %.2f, \"nsPerOpMin\": %.2f}%s\n",
+            res.name.c_str(), res.group.c_str(), res.numIter,
+            res.nsPerOpMedian, res.nsPerOpMin,
+            (k+1 < theResults.size()) ? "," : "");
+    }
+    fprintf(out, "  ]\n");
+    fprintf(out, "}\n");
+}
+
+
+// main routine
+int main(int argc, char **argv)
+{
+    const char *fileName = 0;
+    for (int i=1; i<argc; i++)  {
+        if (i+1 < argc && strcmp(argv[i], "-file") == 0)
+            fileName = argv[++i];
+        else if (i+1 < argc && strcmp(argv[i], "-filter") == 0)
+            nameFilter = argv[++i];
+        else if (i+1 < argc && strcmp(argv[i], "-samples") == 0)
+            numSamples = atoi(argv[++i]);
+        else  {
+            opserr << "usage: benchMicro <-file fileName> <-filter string> "
+                << "<-samples numSamples>\n";
+            return OF_ReturnType_failed;
+        }
+    }
+    if (numSamples < 1)
+        numSamples = 1;
+
+    benchSetups();
+    benchFilters();
+    benchTangentStiffs();
+    benchKernels();
+    benchChannels();
+
+    FILE *out = stdout;
+    if (fileName != 0)  {
+        out = fopen(fileName, "w");
+        if (out == 0)  {
+            opserr << "benchMicro - could not open file " << fileName << endln;
+            return OF_ReturnType_failed;
+        }
+    }
+    writeResults(out);
+    if (out != stdout)
+        fclose(out);
+
+    return 0;
+}
@@ -31,6 +31,7 @@
 // ECGenericTCP class.
 
 #include "ECGenericTCP.h"
+#include <ExpTiming.h>
 
 #include <fstream>
 using std::ifstream;
@@ -482,43 +483,39 @@ int ECGenericTCP::setTrialResponse(const Vector* disp,
     const Vector* force,
     const Vector* time)
 {
-    int i, rValue = 0;
+    int rValue = 0;
     if (disp != 0 && (*sizeCtrl)(OF_Resp_Disp) != 0)  {
         *ctrlDisp = *disp;
-        if (theCtrlFilters[OF_Resp_Disp] != 0)  {
-            for (i=0; i<(*sizeCtrl)(OF_Resp_Disp); i++)
-                (*ctrlDisp)(i) = theCtrlFilters[OF_Resp_Disp]->filtering((*ctrlDisp)(i));
-        }
+        if (theCtrlFilters[OF_Resp_Disp] != 0)
+            theCtrlFilters[OF_Resp_Disp]->filtering(&(*ctrlDisp)(0),
+                &(*ctrlDisp)(0), (*sizeCtrl)(OF_Resp_Disp));
     }
     if (vel != 0 && (*sizeCtrl)(OF_Resp_Vel) != 0)  {
         *ctrlVel = *vel;
-        if (theCtrlFilters[OF_Resp_Vel] != 0)  {
-            for (i=0; i<(*sizeCtrl)(OF_Resp_Vel); i++)
-                (*ctrlVel)(i) = theCtrlFilters[OF_Resp_Vel]->filtering((*ctrlVel)(i));
-        }
+        if (theCtrlFilters[OF_Resp_Vel] != 0)
+            theCtrlFilters[OF_Resp_Vel]->filtering(&(*ctrlVel)(0),
+                &(*ctrlVel)(0), (*sizeCtrl)(OF_Resp_Vel));
     }
     if (accel != 0 && (*sizeCtrl)(OF_Resp_Accel) != 0)  {
         *ctrlAccel = *accel;
-        if (theCtrlFilters[OF_Resp_Accel] != 0)  {
-            for (i=0; i<(*sizeCtrl)(OF_Resp_Accel); i++)
-                (*ctrlAccel)(i) = theCtrlFilters[OF_Resp_Accel]->filtering((*ctrlAccel)(i));
-        }
+        if (theCtrlFilters[OF_Resp_Accel] != 0)
+            theCtrlFilters[OF_Resp_Accel]->filtering(&(*ctrlAccel)(0),
+                &(*ctrlAccel)(0), (*sizeCtrl)(OF_Resp_Accel));
     }
     if (force != 0 && (*sizeCtrl)(OF_Resp_Force) != 0)  {
         *ctrlForce = *force;
-        if (theCtrlFilters[OF_Resp_Force] != 0)  {
-            for (i=0; i<(*sizeCtrl)(OF_Resp_Force); i++)
-                (*ctrlForce)(i) = theCtrlFilters[OF_Resp_Force]->filtering((*ctrlForce)(i));
-        }
+        if (theCtrlFilters[OF_Resp_Force] != 0)
+            theCtrlFilters[OF_Resp_Force]->filtering(&(*ctrlForce)(0),
+                &(*ctrlForce)(0), (*sizeCtrl)(OF_Resp_Force));
     }
     if (time != 0 && (*sizeCtrl)(OF_Resp_Time) != 0)  {
         *ctrlTime = *time;
-        if (theCtrlFilters[OF_Resp_Time] != 0)  {
-            for (i=0; i<(*sizeCtrl)(OF_Resp_Time); i++)
-                (*ctrlTime)(i) = theCtrlFilters[OF_Resp_Time]->filtering((*ctrlTime)(i));
-        }
+        if (theCtrlFilters[OF_Resp_Time] != 0)
+            theCtrlFilters[OF_Resp_Time]->filtering(&(*ctrlTime)(0),
+                &(*ctrlTime)(0), (*sizeCtrl)(OF_Resp_Time));
     }
     
+    this->waitForNextStep();
     rValue = this->control();
     
     return rValue;
@@ -533,40 +530,34 @@ int ECGenericTCP::getDaqResponse(Vector* disp,
 {
     this->acquire();
     
-    int i;
     if (disp != 0 && (*sizeDaq)(OF_Resp_Disp) != 0)  {
-        if (theDaqFilters[OF_Resp_Disp] != 0)  {
-            for (i=0; i<(*sizeDaq)(OF_Resp_Disp); i++)
-                (*daqDisp)(i) = theDaqFilters[OF_Resp_Disp]->filtering((*daqDisp)(i));
-        }
+        if (theDaqFilters[OF_Resp_Disp] != 0)
+            theDaqFilters[OF_Resp_Disp]->filtering(&(*daqDisp)(0),
+                &(*daqDisp)(0), (*sizeDaq)(OF_Resp_Disp));
         *disp = *daqDisp;
     }
     if (vel != 0 && (*sizeDaq)(OF_Resp_Vel) != 0)  {
-        if (theDaqFilters[OF_Resp_Vel] != 0)  {
-            for (i=0; i<(*sizeDaq)(OF_Resp_Vel); i++)
-                (*daqVel)(i) = theDaqFilters[OF_Resp_Vel]->filtering((*daqVel)(i));
-        }
+        if (theDaqFilters[OF_Resp_Vel] != 0)
+            theDaqFilters[OF_Resp_Vel]->filtering(&(*daqVel)(0),
+                &(*daqVel)(0), (*sizeDaq)(OF_Resp_Vel));
         *vel = *daqVel;
     }
     if (accel != 0 && (*sizeDaq)(OF_Resp_Accel) != 0)  {
-        if (theDaqFilters[OF_Resp_Accel] != 0)  {
-            for (i=0; i<(*sizeDaq)(OF_Resp_Accel); i++)
-                (*daqAccel)(i) = theDaqFilters[OF_Resp_Accel]->filtering((*daqAccel)(i));
-        }
+        if (theDaqFilters[OF_Resp_Accel] != 0)
+            theDaqFilters[OF_Resp_Accel]->filtering(&(*daqAccel)(0),
+                &(*daqAccel)(0), (*sizeDaq)(OF_Resp_Accel));
         *accel = *daqAccel;
     }
     if (force != 0 && (*sizeDaq)(OF_Resp_Force) != 0)  {
-        if (theDaqFilters[OF_Resp_Force] != 0)  {
-            for (i=0; i<(*sizeDaq)(OF_Resp_Force); i++)
-                (*daqForce)(i) = theDaqFilters[OF_Resp_Force]->filtering((*daqForce)(i));
-        }
+        if (theDaqFilters[OF_Resp_Force] != 0)
+            theDaqFilters[OF_Resp_Force]->filtering(&(*daqForce)(0),
+                &(*daqForce)(0), (*sizeDaq)(OF_Resp_Force));
         *force = *daqForce;
     }
     if (time != 0 && (*sizeDaq)(OF_Resp_Time) != 0)  {
-        if (theDaqFilters[OF_Resp_Time] != 0)  {
-            for (i=0; i<(*sizeDaq)(OF_Resp_Time); i++)
-                (*daqTime)(i) = theDaqFilters[OF_Resp_Time]->filtering((*daqTime)(i));
-        }
+        if (theDaqFilters[OF_Resp_Time] != 0)
+            theDaqFilters[OF_Resp_Time]->filtering(&(*daqTime)(0),
+                &(*daqTime)(0), (*sizeDaq)(OF_Resp_Time));
         *time = *daqTime;
     }
     
@@ -723,6 +714,10 @@ Response* ECGenericTCP::setResponse(const char **argv, int argc,
         theResponse = new ExpControlResponse(this, 10, *daqTime);
     }
     
+    // pacing jitter
+    if (theResponse == 0)
+        theResponse = this->setPacingResponse(argv, argc, output);
+    
     output.endTag();
     
     return theResponse;
@@ -763,7 +758,7 @@ int ECGenericTCP::getResponse(int responseID, Information &info)
         return info.setVector(*daqTime);
         
     default:
-        return -1;
+        return this->ExperimentalControl::getResponse(responseID, info);
     }
 }
 
@@ -800,6 +795,8 @@ void ECGenericTCP::Print(OPS_Stream &s, int flag)
 
 int ECGenericTCP::control()
 {
+    ExpTimer timer(OF_Timing_Control);
+    
     sData[0] = OF_RemoteTest_setTrialResponse;
     theChannel->sendVector(0, 0, *sendData, 0);
 
@@ -809,6 +806,8 @@ int ECGenericTCP::control()
 
 int ECGenericTCP::acquire()
 {
+    ExpTimer timer(OF_Timing_Acquire);
+    
     sData[0] = OF_RemoteTest_getDaqResponse;
     theChannel->sendVector(0, 0, *sendData, 0);
     theChannel->recvVector(0, 0, *recvData, 0);
@@ -26,6 +26,7 @@
 // Description: This file contains the implementation of the ECLabVIEW class.
 
 #include "ECLabVIEW.h"
+#include <ExpTiming.h>
 #include <ExperimentalCP.h>
 
 #include <Message.h>
@@ -35,12 +36,12 @@
 ECLabVIEW::ECLabVIEW(int tag,
     int nTrialCPs, ExperimentalCP **trialcps,
     int nOutCPs, ExperimentalCP **outcps,
-    char *ipaddress, int ipport)
+    char *ipaddress, int ipport, int tmout)
     : ExperimentalControl(tag),
     numTrialCPs(nTrialCPs), trialCPs(0), numOutCPs(nOutCPs), outCPs(0),
-    ipAddress(ipaddress), ipPort(ipport),
+    ipAddress(ipaddress), ipPort(ipport), timeout(tmout),
     theSocket(0), sData(0), sendData(0), rData(0), recvData(0),
-    ctrlDisp(0), ctrlForce(0), daqDisp(0), daqForce(0)
+    ctrlDisp(0), ctrlForce(0), daqDisp(0), daqForce(0), commTime(0)
 {
     // open log file
     logFile = fopen("ECLabVIEW.log","w");
@@ -66,6 +67,7 @@ ECLabVIEW::ECLabVIEW(int tag,
         delete theSocket;
         exit(OF_ReturnType_failed);
     }
+    theSocket->setRecvTimeout(timeout);
     
     opserr << "****************************************************************\n";
     opserr << "* The TCP/IP socket with address: " << ipAddress << endln;
@@ -81,13 +83,14 @@ ECLabVIEW::ECLabVIEW(int tag,
     // allocate memory for the receive messages
     rData = new char [dataSize];
     recvData = new Message(rData, dataSize);
+    commTime = new Vector(2);
     
     // open a session with LabVIEW
     sprintf(sData,"open-session\tOpenFresco\n");
         fprintf(logFile,"%s",sData);
     delete sendData;  sendData = new Message(sData,(int)strlen(sData));  // needed because of bug in LabVIEW-plugin
     theSocket->sendMsg(0, 0, *sendData, 0);
-    theSocket->recvMsgUnknownSize(0, 0, *recvData, 0);
+    this->recvMessage();
         fprintf(logFile,"%s",rData);
     
     if (strcmp(strtok(rData,"\t"),"OK") != 0)  {
@@ -103,7 +106,7 @@ ECLabVIEW::ECLabVIEW(int tag,
         fprintf(logFile,"%s",sData);
     delete sendData;  sendData = new Message(sData,(int)strlen(sData));  // needed because of bug in LabVIEW-plugin
     theSocket->sendMsg(0, 0, *sendData, 0);
-    theSocket->recvMsgUnknownSize(0, 0, *recvData, 0);
+    this->recvMessage();
         fprintf(logFile,"%s",rData);
     
     if (strcmp(strtok(rData,"\t"),"OK") != 0)  {
@@ -119,7 +122,7 @@ ECLabVIEW::ECLabVIEW(int tag,
 ECLabVIEW::ECLabVIEW(const ECLabVIEW &ec)
     : ExperimentalControl(ec),
     theSocket(0), sData(0), sendData(0), rData(0), recvData(0),
-    ctrlDisp(0), ctrlForce(0), daqDisp(0), daqForce(0)
+    ctrlDisp(0), ctrlForce(0), daqDisp(0), daqForce(0), commTime(0)
 {
     numTrialCPs = ec.numTrialCPs;
     numOutCPs = ec.numOutCPs;
@@ -131,6 +134,7 @@ ECLabVIEW::ECLabVIEW(const ECLabVIEW &ec)
     // use the existing socket which is set up
     ipAddress = ec.ipAddress;
     ipPort = ec.ipPort;
+    timeout = ec.timeout;
     theSocket = ec.theSocket;
     
     // allocate memory for the send messages
@@ -141,6 +145,7 @@ ECLabVIEW::ECLabVIEW(const ECLabVIEW &ec)
     // allocate memory for the receive messages
     rData = new char [dataSize];
     recvData = new Message(rData, dataSize);
+    commTime = new Vector(2);
 }
 
 
@@ -157,6 +162,8 @@ ECLabVIEW::~ECLabVIEW()
         delete daqDisp;
     if (daqForce != 0)
         delete daqForce;
+    if (commTime != 0)
+        delete commTime;
     
     // delete memory of string
     if (ipAddress != 0)
@@ -356,22 +363,21 @@ int ECLabVIEW::setTrialResponse(
     const Vector* force,
     const Vector* time)
 {
-    int i, rValue = 0;
+    int rValue = 0;
     if (disp != 0)  {
         *ctrlDisp = *disp;
-        if (theCtrlFilters[OF_Resp_Disp] != 0)  {
-            for (i=0; i<(*sizeCtrl)(OF_Resp_Disp); i++)
-                (*ctrlDisp)(i) = theCtrlFilters[OF_Resp_Disp]->filtering((*ctrlDisp)(i));
-        }
+        if (theCtrlFilters[OF_Resp_Disp] != 0)
+            theCtrlFilters[OF_Resp_Disp]->filtering(&(*ctrlDisp)(0),
+                &(*ctrlDisp)(0), (*sizeCtrl)(OF_Resp_Disp));
     }
     if (force != 0)  {
         *ctrlForce = *force;
-        if (theCtrlFilters[OF_Resp_Force] != 0)  {
-            for (i=0; i<(*sizeCtrl)(OF_Resp_Force); i++)
-                (*ctrlForce)(i) = theCtrlFilters[OF_Resp_Force]->filtering((*ctrlForce)(i));
-        }
+        if (theCtrlFilters[OF_Resp_Force] != 0)
+            theCtrlFilters[OF_Resp_Force]->filtering(&(*ctrlForce)(0),
+                &(*ctrlForce)(0), (*sizeCtrl)(OF_Resp_Force));
     }
     
+    this->waitForNextStep();
     rValue = this->control();
     
     return rValue;
@@ -387,19 +393,16 @@ int ECLabVIEW::getDaqResponse(
 {
     this->acquire();
     
-    int i;
     if (disp != 0)  {
-        if (theDaqFilters[OF_Resp_Disp] != 0)  {
-            for (i=0; i<(*sizeDaq)(OF_Resp_Disp); i++)
-                (*daqDisp)(i) = theDaqFilters[OF_Resp_Disp]->filtering((*daqDisp)(i));
-        }
+        if (theDaqFilters[OF_Resp_Disp] != 0)
+            theDaqFilters[OF_Resp_Disp]->filtering(&(*daqDisp)(0),
+                &(*daqDisp)(0), (*sizeDaq)(OF_Resp_Disp));
         *disp = *daqDisp;
     }
     if (force != 0)  {
-        if (theDaqFilters[OF_Resp_Force] != 0)  {
-            for (i=0; i<(*sizeDaq)(OF_Resp_Force); i++)
-                (*daqForce)(i) = theDaqFilters[OF_Resp_Force]->filtering((*daqForce)(i));
-        }
+        if (theDaqFilters[OF_Resp_Force] != 0)
+            theDaqFilters[OF_Resp_Force]->filtering(&(*daqForce)(0),
+                &(*daqForce)(0), (*sizeDaq)(OF_Resp_Force));
         *force = *daqForce;
     }
     
@@ -480,6 +483,20 @@ Response* ECLabVIEW::setResponse(const char **argv, int argc,
         theResponse = new ExpControlResponse(this, 4, *daqForce);
     }
     
+    // receive wait and transfer times
+    if (commTime != 0 && (
+        strcmp(argv[0],"commTime") == 0 ||
+        strcmp(argv[0],"commTimes") == 0))
+    {
+        output.tag("ResponseType","recvWaitTime");
+        output.tag("ResponseType","recvTransferTime");
+        theResponse = new ExpControlResponse(this, 5, *commTime);
+    }
+    
+    // pacing jitter
+    if (theResponse == 0)
+        theResponse = this->setPacingResponse(argv, argc, output);
+    
     output.endTag();
     
     return theResponse;
@@ -501,8 +518,11 @@ int ECLabVIEW::getResponse(int responseID, Information &info)
     case 4:  // daq forces
         return info.setVector(*daqForce);
         
+    case 5:  // receive wait and transfer times
+        return info.setVector(*commTime);
+        
     default:
-        return -1;
+        return this->ExperimentalControl::getResponse(responseID, info);
     }
 }
 
@@ -535,12 +555,17 @@ void ECLabVIEW::Print(OPS_Stream &s, int flag)
 
 int ECLabVIEW::control()
 {
+    ExpTimer timer(OF_Timing_Control);
+    
     // get current local time to setup transaction ID
     time(&rawtime);
     ptm = localtime(&rawtime);
     sprintf(OPFTransactionID,"OPFTransaction%4d%02d%02d%02d%02d%02d",
         1900+ptm->tm_year,ptm->tm_mon,ptm->tm_mday,ptm->tm_hour,ptm->tm_min,ptm->tm_sec);
     
+    // start timing of the new transaction
+    commTime->Zero();
+    
     // propose ctrl values
     int dID = 0, fID = 0;
     sprintf(sData,"propose\t%s",OPFTransactionID);
@@ -687,7 +712,7 @@ int ECLabVIEW::control()
         fprintf(logFile,"%s",sData);
     delete sendData;  sendData = new Message(sData,(int)strlen(sData));  // needed because of bug in LabVIEW-plugin
     theSocket->sendMsg(0, 0, *sendData, 0);
-    theSocket->recvMsgUnknownSize(0, 0, *recvData, 0);
+    this->recvMessage();
         fprintf(logFile,"%s",rData);
     if (strcmp(strtok(rData,"\t"),"OK") != 0)  {
         opserr << "ECLabVIEW::control() - "
@@ -701,7 +726,7 @@ int ECLabVIEW::control()
         fprintf(logFile,"%s",sData);
     delete sendData;  sendData = new Message(sData,(int)strlen(sData));  // needed because of bug in LabVIEW-plugin
     theSocket->sendMsg(0, 0, *sendData, 0);
-    theSocket->recvMsgUnknownSize(0, 0, *recvData, 0);
+    this->recvMessage();
         fprintf(logFile,"%s",rData);
     if (strcmp(strtok(rData,"\t"),"OK") != 0)  {
         opserr << "ECLabVIEW::control() - "
@@ -716,6 +741,8 @@ int ECLabVIEW::control()
 
 int ECLabVIEW::acquire()
 {
+    ExpTimer timer(OF_Timing_Acquire);
+    
     char *tokenPtr;
     char cpName[17];
     char GeomType[2];
@@ -739,7 +766,7 @@ int ECLabVIEW::acquire()
     int dID = 0, fID = 0;
     for (int i=0; i<numOutCPs; i++)  {
         // disaggregate received data
-        theSocket->recvMsgUnknownSize(0, 0, *recvData, 0);
+        this->recvMessage();
             fprintf(logFile,"%s",rData);
         if (strcmp(strtok(rData,"\t"),"OK") != 0)  {
             opserr << "ECLabVIEW::acquire() - "
@@ -886,3 +913,20 @@ int ECLabVIEW::acquire()
     
     return OF_ReturnType_completed;
 }
+
+
+int ECLabVIEW::recvMessage()
+{
+    int rValue = theSocket->recvMsgUnknownSize(0, 0, *recvData, 0);
+    if (rValue == -1 || rValue == -2)  {
+        opserr << "ECLabVIEW::recvMessage() - "
+            << "failed to receive message from LabVIEW.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    // accumulate the times over the current transaction
+    (*commTime)(0) += theSocket->getRecvWaitTime();
+    (*commTime)(1) += theSocket->getRecvTransferTime();
+    
+    return rValue;
+}
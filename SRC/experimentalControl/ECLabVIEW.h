@@ -45,7 +45,7 @@ public:
     ECLabVIEW(int tag,
         int nTrialCPs, ExperimentalCP **trialCPs,
         int nOutCPs, ExperimentalCP **outCPs,
-        char *ipAddress, int ipPort = 44000);
+        char *ipAddress, int ipPort = 44000, int timeout = -1);
     ECLabVIEW(const ECLabVIEW &ec);
     
     // destructor
@@ -89,12 +89,15 @@ protected:
     virtual int acquire();
 
 private:
+    int recvMessage();
+    
     int numTrialCPs;            // number of trial control points
     ExperimentalCP **trialCPs;  // trial control points
     int numOutCPs;              // number of output control points
     ExperimentalCP **outCPs;    // output control points
     char *ipAddress;            // ip address
     int ipPort;                 // ip port
+    int timeout;                // receive timeout [msec]
     
     TCP_Socket *theSocket;      // tcp/ip socket
     char *sData;                // send data array
@@ -104,6 +107,7 @@ private:
     
     Vector *ctrlDisp, *ctrlForce;
     Vector *daqDisp, *daqForce;
+    Vector *commTime;           // receive wait and transfer times [sec]
     
     time_t rawtime;
     struct tm *ptm;
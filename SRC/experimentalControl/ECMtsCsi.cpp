@@ -24,6 +24,7 @@
 // Description: This file contains the implementation of the ECMtsCsi class.
 
 #include "ECMtsCsi.h"
+#include <ExpTiming.h>
 #include <ExperimentalCP.h>
 
 
@@ -546,6 +547,8 @@ int ECMtsCsi::setTrialResponse(
     // set flag that relative trial signal has been obtained
     gotRelativeTrial = 1;
     
+    this->waitForNextStep();
+    
     // send control signal array to controller
     k += this->control();
     
@@ -652,6 +655,10 @@ Response* ECMtsCsi::setResponse(const char **argv, int argc,
         theResponse = new ExpControlResponse(this, 2,
             Vector(numDaqSignals));
     }
+    // pacing jitter
+    if (theResponse == 0)
+        theResponse = this->setPacingResponse(argv, argc, output);
+    
     output.endTag();
     
     return theResponse;
@@ -672,7 +679,7 @@ int ECMtsCsi::getResponse(int responseID, Information &info)
         return info.setVector(resp);
         
     default:
-        return OF_ReturnType_failed;
+        return this->ExperimentalControl::getResponse(responseID, info);
     }
 }
 
@@ -714,6 +721,8 @@ void ECMtsCsi::Print(OPS_Stream &s, int flag)
 
 int ECMtsCsi::control()
 {
+    ExpTimer timer(OF_Timing_Control);
+    
     // create a ramp object and set ramp time
     Mts::ICsiRamp* ramp = Mts::CsiFactory::newRamp();
     ramp->setWaitUntilCompletion(true);
@@ -742,6 +751,8 @@ int ECMtsCsi::control()
 
 int ECMtsCsi::acquire()
 {
+    ExpTimer timer(OF_Timing_Acquire);
+    
     // get feedback signals for the previously run ramp
     // order of feedback signals is defined in MTS CSI configuration
     // if rampID = -1 the current feedback is returned
@@ -33,6 +33,7 @@
 // Description: This file contains the implementation of ECNIEseries.
 
 #include "ECNIEseries.h"
+#include <ExpTiming.h>
 
 
 ECNIEseries::ECNIEseries(int tag ,int device)//, bool rtest)
@@ -382,6 +383,7 @@ int ECNIEseries::setTrialResponse(const Vector* disp,
 {	
     *ctrlDisp = *disp;
     //*ctrlVel = *vel;
+    this->waitForNextStep();
     this->control();
 
     return OF_ReturnType_completed;
@@ -471,6 +473,10 @@ Response* ECNIEseries::setResponse(const char **argv, int argc,
             Vector((*sizeDaq)(OF_Resp_Force)));
     }
     
+    // pacing jitter
+    if (theResponse == 0)
+        theResponse = this->setPacingResponse(argv, argc, output);
+    
     output.endTag();
     
     return theResponse;
@@ -490,7 +496,7 @@ int ECNIEseries::getResponse(int responseID, Information &info)
         return info.setVector(*daqForce);
         
     default:
-        return -1;
+        return this->ExperimentalControl::getResponse(responseID, info);
     }
 }
 
@@ -532,6 +538,8 @@ void ECNIEseries::Print(OPS_Stream &s, int flag)
 
 int ECNIEseries::control()
 {
+    ExpTimer timer(OF_Timing_Control);
+    
     int code = 0;
     //double targetDisp = (*ctrlDisp)(1);
 
@@ -675,6 +683,8 @@ int ECNIEseries::control()
 
 int ECNIEseries::acquire()
 {
+    ExpTimer timer(OF_Timing_Acquire);
+    
     i16 iStatus, iRetVal;
 
     for(int i=0; i<3; i++) {
@@ -729,11 +739,3 @@ int ECNIEseries::NIDAQMakeRampBuffer(void* pvBuffer, u32 ulNumPts,
     }
     return (NoError);
 }
-
-
-void ECNIEseries::sleep(const clock_t wait)
-{
-    clock_t goal;
-    goal = wait + clock();
-    while (goal>clock());
-}
@@ -88,8 +88,6 @@ protected:
 private:
     int NIDAQMakeRampBuffer(void* pvBuffer, u32 ulNumPts,
         f64 mm_s, f64 mm_t, f64 u2V);
-    
-    void sleep(const clock_t wait);
 
     Vector *ctrlDisp;
     Vector *daqDisp, *daqForce;
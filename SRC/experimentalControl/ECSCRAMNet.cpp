@@ -26,6 +26,7 @@
 // Description: This file contains the implementation of the ECSCRAMNet class.
 
 #include "ECSCRAMNet.h"
+#include <ExpTiming.h>
 
 extern "C" {
 #include <scrplus.h>
@@ -377,6 +378,7 @@ int ECSCRAMNet::setTrialResponse(
         }
     }
     
+    this->waitForNextStep();
     rValue = this->control();
     
     return rValue;
@@ -603,6 +605,10 @@ Response* ECSCRAMNet::setResponse(const char **argv, int argc,
             Vector((*sizeDaq)(OF_Resp_Time)));
     }
     
+    // pacing jitter
+    if (theResponse == 0)
+        theResponse = this->setPacingResponse(argv, argc, output);
+    
     output.endTag();
     
     return theResponse;
@@ -675,7 +681,7 @@ int ECSCRAMNet::getResponse(int responseID, Information &info)
         return info.setVector(resp);
         
     default:
-        return -1;
+        return this->ExperimentalControl::getResponse(responseID, info);
     }
 }
 
@@ -712,6 +718,8 @@ void ECSCRAMNet::Print(OPS_Stream &s, int flag)
 
 int ECSCRAMNet::control()
 {
+    ExpTimer timer(OF_Timing_Control);
+    
     // set newTarget flag
     newTarget[0] = 1;
     
@@ -738,6 +746,8 @@ int ECSCRAMNet::control()
 
 int ECSCRAMNet::acquire()
 {
+    ExpTimer timer(OF_Timing_Acquire);
+    
     // wait until target is reached
     flag = 0;
     while (flag != 1)  {
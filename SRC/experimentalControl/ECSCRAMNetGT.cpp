@@ -26,6 +26,7 @@
 // Description: This file contains the implementation of the ECSCRAMNetGT class.
 
 #include "ECSCRAMNetGT.h"
+#include <ExpTiming.h>
 
 
 ECSCRAMNetGT::ECSCRAMNetGT(int tag, int memoffset, int numdof,
@@ -392,6 +393,7 @@ int ECSCRAMNetGT::setTrialResponse(
         }
     }
     
+    this->waitForNextStep();
     rValue = this->control();
     
     return rValue;
@@ -618,6 +620,10 @@ Response* ECSCRAMNetGT::setResponse(const char **argv, int argc,
             Vector((*sizeDaq)(OF_Resp_Time)));
     }
     
+    // pacing jitter
+    if (theResponse == 0)
+        theResponse = this->setPacingResponse(argv, argc, output);
+    
     output.endTag();
     
     return theResponse;
@@ -690,7 +696,7 @@ int ECSCRAMNetGT::getResponse(int responseID, Information &info)
         return info.setVector(resp);
         
     default:
-        return -1;
+        return this->ExperimentalControl::getResponse(responseID, info);
     }
 }
 
@@ -727,6 +733,8 @@ void ECSCRAMNetGT::Print(OPS_Stream &s, int flag)
 
 int ECSCRAMNetGT::control()
 {
+    ExpTimer timer(OF_Timing_Control);
+    
     // set newTarget flag
     newTarget[0] = 1;
     
@@ -753,6 +761,8 @@ int ECSCRAMNetGT::control()
 
 int ECSCRAMNetGT::acquire()
 {
+    ExpTimer timer(OF_Timing_Acquire);
+    
     // wait until target is reached
     flag = 0;
     while (flag != 1)  {
@@ -26,6 +26,7 @@
 // Description: This file contains the implementation of ECSimDomain.
 
 #include "ECSimDomain.h"
+#include <ExpTiming.h>
 #include <ExperimentalCP.h>
 
 #include <stdlib.h>
@@ -37,6 +38,8 @@
 
 #include <Domain.h>
 #include <Node.h>
+#include <Element.h>
+#include <ElementIter.h>
 #include <LinearSeries.h>
 #include <LoadPattern.h>
 #include <SP_Constraint.h>
@@ -79,12 +82,16 @@
 
 ECSimDomain::ECSimDomain(int tag,
     int nTrialCPs, ExperimentalCP **trialcps,
-    int nOutCPs, ExperimentalCP **outcps, Domain *thedomain)
+    int nOutCPs, ExperimentalCP **outcps, Domain *thedomain,
+    int nsubsteps)
     : ECSimulation(tag), numTrialCPs(nTrialCPs), numOutCPs(nOutCPs),
     theDomain(0), theModel(0), theTest(0), theAlgorithm(0), theIntegrator(0),
     theHandler(0), theNumberer(0), theSOE(0), theAnalysis(0),
-    theSeries(0), thePattern(0), theSPs(0), theNodes(0), numSPs(0),
-    ctrlDisp(0), ctrlVel(0), ctrlAccel(0), ctrlForce(0),
+    theSeries(0), thePattern(0), theSPs(0), numSPs(0),
+    numSubSteps(nsubsteps), lastCtrl(0), trgtCtrl(0),
+    numOutDOF(0), daqNodes(0), daqDOF(0),
+    numReactEles(0), numReactNodes(0), reactEles(0), reactNodes(0),
+    simTiming(4), ctrlDisp(0), ctrlVel(0), ctrlAccel(0), ctrlForce(0),
     daqDisp(0), daqVel(0), daqAccel(0), daqForce(0)
 {
     // get trial and output control points
@@ -96,6 +103,12 @@ ECSimDomain::ECSimDomain(int tag,
     trialCPs = trialcps;
     outCPs = outcps;
     
+    if (numSubSteps < 1)  {
+        opserr << "ECSimDomain::ECSimDomain() - "
+            << "numSubSteps must be at least 1.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
     // initialize the domain
     theDomain = thedomain;
     if (theDomain->initialize() != 0)  {
@@ -115,14 +128,17 @@ ECSimDomain::ECSimDomain(const ECSimDomain& ec)
     : ECSimulation(ec), trialCPs(0), outCPs(0),
     theDomain(0), theModel(0), theTest(0), theAlgorithm(0), theIntegrator(0),
     theHandler(0), theNumberer(0), theSOE(0), theAnalysis(0),
-    theSeries(0), thePattern(0), theSPs(0), theNodes(0), numSPs(0),
-    ctrlDisp(0), ctrlVel(0), ctrlAccel(0), ctrlForce(0),
+    theSeries(0), thePattern(0), theSPs(0), numSPs(0),
+    lastCtrl(0), trgtCtrl(0), numOutDOF(0), daqNodes(0), daqDOF(0),
+    numReactEles(0), numReactNodes(0), reactEles(0), reactNodes(0),
+    simTiming(4), ctrlDisp(0), ctrlVel(0), ctrlAccel(0), ctrlForce(0),
     daqDisp(0), daqVel(0), daqAccel(0), daqForce(0)
 {
     numTrialCPs = ec.numTrialCPs;
     trialCPs    = ec.trialCPs;
     numOutCPs   = ec.numOutCPs;
     outCPs      = ec.outCPs;
+    numSubSteps = ec.numSubSteps;
     
     // initialize the domain
     theDomain = ec.theDomain;
@@ -167,11 +183,21 @@ ECSimDomain::~ECSimDomain()
     if (theDomain != 0)
         theDomain->clearAll();
     
-    // delete memory of SP constraints and nodes
+    // delete memory of SP constraints, ramp values and cached maps
     if (theSPs != 0)
         delete [] theSPs;
-    if (theNodes != 0)
-        delete [] theNodes;
+    if (lastCtrl != 0)
+        delete [] lastCtrl;
+    if (trgtCtrl != 0)
+        delete [] trgtCtrl;
+    if (daqNodes != 0)
+        delete [] daqNodes;
+    if (daqDOF != 0)
+        delete [] daqDOF;
+    if (reactEles != 0)
+        delete [] reactEles;
+    if (reactNodes != 0)
+        delete [] reactNodes;
     
     // control points are not copies, so do not clean them up here
     //int i;
@@ -304,11 +330,77 @@ int ECSimDomain::setup()
         }
     }
     
-    // create array of output nodes to be used in acquire method
-    theNodes = new Node* [numOutCPs];
+    // create arrays of the SP values at the start and at the end
+    // of a step, which are needed to ramp them over the substeps
+    if (numSubSteps > 1)  {
+        int numCtrl = (*sizeCtrl)(OF_Resp_Disp) + (*sizeCtrl)(OF_Resp_Vel)
+            + (*sizeCtrl)(OF_Resp_Accel);
+        lastCtrl = new double [numCtrl];
+        trgtCtrl = new double [numCtrl];
+        for (int i=0; i<numCtrl; i++)  {
+            lastCtrl[i] = 0.0;
+            trgtCtrl[i] = 0.0;
+        }
+    }
+    
+    // create flat arrays of the output nodes and dofs, so that the
+    // acquire method only needs to gather the responses
+    for (int i=0; i<numOutCPs; i++)
+        numOutDOF += outCPs[i]->getNumDOF();
+    daqNodes = new Node* [numOutDOF];
+    daqDOF = new int [numOutDOF];
+    ID outNodeTags(numOutCPs);
+    int iDOF = 0;
     for (int i=0; i<numOutCPs; i++)  {
         int nodeTag = outCPs[i]->getNodeTag();
-        theNodes[i] = theDomain->getNode(nodeTag);
+        Node *theNode = theDomain->getNode(nodeTag);
+        if (theNode == 0)  {
+            opserr << "ECSimDomain::setup() - "
+                << "node " << nodeTag << " of output control point "
+                << outCPs[i]->getTag() << " not found in domain.\n";
+            exit(OF_ReturnType_failed);
+        }
+        outNodeTags(i) = nodeTag;
+        int numDir = outCPs[i]->getNumDOF();
+        const ID &dir = outCPs[i]->getUniqueDOF();
+        for (int j=0; j<numDir; j++)  {
+            daqNodes[iDOF] = theNode;
+            daqDOF[iDOF] = dir(j);
+            iDOF++;
+        }
+    }
+    
+    // collect the elements connected to the output nodes (in the
+    // same order as the domain) and the nodes of these elements
+    if ((*sizeDaq)(OF_Resp_Force) != 0)  {
+        reactEles = new Element* [theDomain->getNumElements()];
+        ID reactNodeTags(0, 2*numOutCPs);
+        Element *theEle;
+        ElementIter &theEles = theDomain->getElements();
+        while ((theEle = theEles()) != 0)  {
+            if (theEle->isSubdomain() == true)
+                continue;
+            const ID &eleNodes = theEle->getExternalNodes();
+            int numEleNodes = eleNodes.Size();
+            bool connected = false;
+            for (int j=0; j<numEleNodes && !connected; j++)
+                connected = (outNodeTags.getLocation(eleNodes(j)) >= 0);
+            if (connected)  {
+                reactEles[numReactEles++] = theEle;
+                for (int j=0; j<numEleNodes; j++)  {
+                    if (reactNodeTags.getLocation(eleNodes(j)) < 0)
+                        reactNodeTags[reactNodeTags.Size()] = eleNodes(j);
+                }
+            }
+        }
+        for (int i=0; i<numOutCPs; i++)  {
+            if (reactNodeTags.getLocation(outNodeTags(i)) < 0)
+                reactNodeTags[reactNodeTags.Size()] = outNodeTags(i);
+        }
+        numReactNodes = reactNodeTags.Size();
+        reactNodes = new Node* [numReactNodes];
+        for (int i=0; i<numReactNodes; i++)
+            reactNodes[i] = theDomain->getNode(reactNodeTags(i));
     }
     
     theModel = new AnalysisModel();
@@ -321,7 +413,8 @@ int ECSimDomain::setup()
     //theLineSearch = new RegulaFalsiLineSearch(0.8, 10, 0.1, 10.0, 1);
     //theAlgorithm = new NewtonLineSearch(*theTest, theLineSearch);
     
-    theIntegrator = new LoadControl(1.0, 1, 1.0, 1.0);
+    double dLambda = 1.0/numSubSteps;
+    theIntegrator = new LoadControl(dLambda, 1, dLambda, dLambda);
     
     //theHandler = new TransformationConstraintHandler();
     theHandler = new PenaltyConstraintHandler(1.0E12, 1.0E12);
@@ -395,34 +488,35 @@ int ECSimDomain::setTrialResponse(
 {
     int i, rValue = 0;
     if (disp != 0)  {
-        for (i=0; i<(*sizeCtrl)(OF_Resp_Disp); i++)  {
+        for (i=0; i<(*sizeCtrl)(OF_Resp_Disp); i++)
             ctrlDisp[i] = (*disp)(i);
-            if (theCtrlFilters[OF_Resp_Disp] != 0)
-                ctrlDisp[i] = theCtrlFilters[OF_Resp_Disp]->filtering(ctrlDisp[i]);
-        }
+        if (theCtrlFilters[OF_Resp_Disp] != 0)
+            theCtrlFilters[OF_Resp_Disp]->filtering(ctrlDisp, ctrlDisp,
+                (*sizeCtrl)(OF_Resp_Disp));
     }
     if (vel != 0)  {
-        for (i=0; i<(*sizeCtrl)(OF_Resp_Vel); i++)  {
+        for (i=0; i<(*sizeCtrl)(OF_Resp_Vel); i++)
             ctrlVel[i] = (*vel)(i);
-            if (theCtrlFilters[OF_Resp_Vel] != 0)
-                ctrlVel[i] = theCtrlFilters[OF_Resp_Vel]->filtering(ctrlVel[i]);
-        }
+        if (theCtrlFilters[OF_Resp_Vel] != 0)
+            theCtrlFilters[OF_Resp_Vel]->filtering(ctrlVel, ctrlVel,
+                (*sizeCtrl)(OF_Resp_Vel));
     }
     if (accel != 0)  {
-        for (i=0; i<(*sizeCtrl)(OF_Resp_Accel); i++)  {
+        for (i=0; i<(*sizeCtrl)(OF_Resp_Accel); i++)
             ctrlAccel[i] = (*accel)(i);
-            if (theCtrlFilters[OF_Resp_Accel] != 0)
-                ctrlAccel[i] = theCtrlFilters[OF_Resp_Accel]->filtering(ctrlAccel[i]);
-        }
+        if (theCtrlFilters[OF_Resp_Accel] != 0)
+            theCtrlFilters[OF_Resp_Accel]->filtering(ctrlAccel, ctrlAccel,
+                (*sizeCtrl)(OF_Resp_Accel));
     }
     if (force != 0)  {
-        for (i=0; i<(*sizeCtrl)(OF_Resp_Force); i++)  {
+        for (i=0; i<(*sizeCtrl)(OF_Resp_Force); i++)
             ctrlForce[i] = (*force)(i);
-            if (theCtrlFilters[OF_Resp_Force] != 0)
-                ctrlForce[i] = theCtrlFilters[OF_Resp_Force]->filtering(ctrlForce[i]);
-        }
+        if (theCtrlFilters[OF_Resp_Force] != 0)
+            theCtrlFilters[OF_Resp_Force]->filtering(ctrlForce, ctrlForce,
+                (*sizeCtrl)(OF_Resp_Force));
     }
     
+    this->waitForNextStep();
     rValue = this->control();
     
     return rValue;
@@ -440,32 +534,32 @@ int ECSimDomain::getDaqResponse(
     
     int i;
     if (disp != 0)  {
-        for (i=0; i<(*sizeDaq)(OF_Resp_Disp); i++)  {
-            if (theDaqFilters[OF_Resp_Disp] != 0)
-                daqDisp[i] = theDaqFilters[OF_Resp_Disp]->filtering(daqDisp[i]);
+        if (theDaqFilters[OF_Resp_Disp] != 0)
+            theDaqFilters[OF_Resp_Disp]->filtering(daqDisp, daqDisp,
+                (*sizeDaq)(OF_Resp_Disp));
+        for (i=0; i<(*sizeDaq)(OF_Resp_Disp); i++)
             (*disp)(i) = daqDisp[i];
-        }
     }
     if (vel != 0)  {
-        for (i=0; i<(*sizeDaq)(OF_Resp_Vel); i++)  {
-            if (theDaqFilters[OF_Resp_Vel] != 0)
-                daqVel[i] = theDaqFilters[OF_Resp_Vel]->filtering(daqVel[i]);
+        if (theDaqFilters[OF_Resp_Vel] != 0)
+            theDaqFilters[OF_Resp_Vel]->filtering(daqVel, daqVel,
+                (*sizeDaq)(OF_Resp_Vel));
+        for (i=0; i<(*sizeDaq)(OF_Resp_Vel); i++)
             (*vel)(i) = daqVel[i];
-        }
     }
     if (accel != 0)  {
-        for (i=0; i<(*sizeDaq)(OF_Resp_Accel); i++)  {
-            if (theDaqFilters[OF_Resp_Accel] != 0)
-                daqAccel[i] = theDaqFilters[OF_Resp_Accel]->filtering(daqAccel[i]);
+        if (theDaqFilters[OF_Resp_Accel] != 0)
+            theDaqFilters[OF_Resp_Accel]->filtering(daqAccel, daqAccel,
+                (*sizeDaq)(OF_Resp_Accel));
+        for (i=0; i<(*sizeDaq)(OF_Resp_Accel); i++)
             (*accel)(i) = daqAccel[i];
-        }
     }
     if (force != 0)  {
-        for (i=0; i<(*sizeDaq)(OF_Resp_Force); i++)  {
-            if (theDaqFilters[OF_Resp_Force] != 0)
-                daqForce[i] = theDaqFilters[OF_Resp_Force]->filtering(daqForce[i]);
+        if (theDaqFilters[OF_Resp_Force] != 0)
+            theDaqFilters[OF_Resp_Force]->filtering(daqForce, daqForce,
+                (*sizeDaq)(OF_Resp_Force));
+        for (i=0; i<(*sizeDaq)(OF_Resp_Force); i++)
             (*force)(i) = daqForce[i];
-        }
     }
     
     return OF_ReturnType_completed;
@@ -605,6 +699,19 @@ Response* ECSimDomain::setResponse(const char **argv, int argc,
             Vector((*sizeDaq)(OF_Resp_Force)));
     }
     
+    // simulation timing
+    if (strcmp(argv[0],"simTiming") == 0)  {
+        output.tag("ResponseType","numSubSteps");
+        output.tag("ResponseType","numIter");
+        output.tag("ResponseType","controlTime");
+        output.tag("ResponseType","acquireTime");
+        theResponse = new ExpControlResponse(this, 9, simTiming);
+    }
+    
+    // pacing jitter
+    if (theResponse == 0)
+        theResponse = this->setPacingResponse(argv, argc, output);
+    
     output.endTag();
     
     return theResponse;
@@ -648,8 +755,11 @@ int ECSimDomain::getResponse(int responseID, Information &info)
         resp.setData(daqForce,(*sizeDaq)(OF_Resp_Force));
         return info.setVector(resp);
         
+    case 9:  // simulation timing
+        return info.setVector(simTiming);
+        
     default:
-        return -1;
+        return this->ExperimentalControl::getResponse(responseID, info);
     }
 }
 
@@ -665,6 +775,7 @@ void ECSimDomain::Print(OPS_Stream &s, int flag)
     s << "\n*   outCPs:";
     for (int i=0; i<numOutCPs; i++)
         s << " " << outCPs[i]->getTag();
+    s << "\n*   numSubSteps: " << numSubSteps;
     s << "\n*   ctrlFilters:";
     for (int i=0; i<OF_Resp_All; i++)  {
         if (theCtrlFilters[i] != 0)
@@ -685,46 +796,97 @@ void ECSimDomain::Print(OPS_Stream &s, int flag)
 
 int ECSimDomain::control()
 {
-    theAnalysis->analyze(1);
-
+    ExpTimer timer(OF_Timing_Control);
+    
+    double tStart = this->getMonotonicTime();
+    
+    int rValue = 0, numIter = 0;
+    if (numSubSteps == 1)  {
+        rValue = theAnalysis->analyze(1);
+        numIter = theTest->getNumTests();
+    } else  {
+        // save the targets and ramp the SP values from the
+        // last targets to the new ones over the substeps
+        double *ctrl[3] = {ctrlDisp, ctrlVel, ctrlAccel};
+        int i, j, n;
+        for (j=0, n=0; j<3; j++)
+            for (i=0; i<(*sizeCtrl)(j); i++, n++)
+                trgtCtrl[n] = ctrl[j][i];
+        
+        for (int k=1; k<=numSubSteps && rValue == 0; k++)  {
+            double fact = double(k)/numSubSteps;
+            for (j=0, n=0; j<3; j++)  {
+                for (i=0; i<(*sizeCtrl)(j); i++, n++)  {
+                    if (k < numSubSteps)
+                        ctrl[j][i] = lastCtrl[n]
+                            + fact*(trgtCtrl[n] - lastCtrl[n]);
+                    else
+                        ctrl[j][i] = trgtCtrl[n];
+                }
+            }
+            rValue = theAnalysis->analyze(1);
+            numIter += theTest->getNumTests();
+        }
+        
+        // the next step starts from the current targets
+        for (j=0, n=0; j<3; j++)  {
+            for (i=0; i<(*sizeCtrl)(j); i++, n++)  {
+                ctrl[j][i] = trgtCtrl[n];
+                lastCtrl[n] = trgtCtrl[n];
+            }
+        }
+    }
+    if (rValue < 0)  {
+        opserr << "ECSimDomain::control() - "
+            << "analysis of the domain failed.\n";
+    }
+    
+    simTiming(0) = numSubSteps;
+    simTiming(1) = numIter;
+    simTiming(2) = this->getMonotonicTime() - tStart;
+    
     return OF_ReturnType_completed;
 }
 
 
 int ECSimDomain::acquire()
 {
-    // get nodal reactions if forces need to be acquired
-    if ((*sizeDaq)(OF_Resp_Force) != 0)
-        theDomain->calculateNodalReactions(true);
+    ExpTimer timer(OF_Timing_Acquire);
     
-    // loop through all the output control points
-    int iSP = 0;
-    for (int i=0; i<numOutCPs; i++)  {
-        // get output control point parameters
-        int numDir = outCPs[i]->getNumDOF();
-        ID dir = outCPs[i]->getUniqueDOF();
-        
-        // loop through all the directions
-        for (int j=0; j<numDir; j++)  {
-            if ((*sizeDaq)(OF_Resp_Disp) != 0)  {
-                const Vector &d = theNodes[i]->getTrialDisp();
-                daqDisp[iSP] = d(dir(j));
-            }
-            if ((*sizeDaq)(OF_Resp_Vel) != 0)  {
-                const Vector &v = theNodes[i]->getTrialVel();
-                daqVel[iSP] = v(dir(j));
-            }
-            if ((*sizeDaq)(OF_Resp_Accel) != 0)  {
-                const Vector &a = theNodes[i]->getTrialAccel();
-                daqAccel[iSP] = a(dir(j));
-            }
-            if ((*sizeDaq)(OF_Resp_Force) != 0)  {
-                const Vector &f = theNodes[i]->getReaction();
-                daqForce[iSP] = f(dir(j));
-            }
-            iSP++;
-        }
+    double tStart = this->getMonotonicTime();
+    
+    // get nodal reactions if forces need to be acquired, only the
+    // elements connected to the output nodes contribute to them
+    // (the loads of the committed time are still applied to the
+    // nodes from the last analysis step, so unlike in the
+    // Domain::calculateNodalReactions method they are not reapplied)
+    if ((*sizeDaq)(OF_Resp_Force) != 0)  {
+        for (int i=0; i<numReactNodes; i++)
+            reactNodes[i]->resetReactionForce(true);
+        for (int i=0; i<numReactEles; i++)
+            reactEles[i]->addResistingForceToNodalReaction(true);
+    }
+    
+    // gather the responses of all the output dofs
+    int i;
+    if ((*sizeDaq)(OF_Resp_Disp) != 0)  {
+        for (i=0; i<numOutDOF; i++)
+            daqDisp[i] = daqNodes[i]->getTrialDisp()(daqDOF[i]);
     }
+    if ((*sizeDaq)(OF_Resp_Vel) != 0)  {
+        for (i=0; i<numOutDOF; i++)
+            daqVel[i] = daqNodes[i]->getTrialVel()(daqDOF[i]);
+    }
+    if ((*sizeDaq)(OF_Resp_Accel) != 0)  {
+        for (i=0; i<numOutDOF; i++)
+            daqAccel[i] = daqNodes[i]->getTrialAccel()(daqDOF[i]);
+    }
+    if ((*sizeDaq)(OF_Resp_Force) != 0)  {
+        for (i=0; i<numOutDOF; i++)
+            daqForce[i] = daqNodes[i]->getReaction()(daqDOF[i]);
+    }
+    
+    simTiming(3) = this->getMonotonicTime() - tStart;
     
     return OF_ReturnType_completed;
 }
@@ -28,7 +28,9 @@
 //
 // Description: This file contains the class definition for ECSimDomain.
 // ECSimDomain is a controller class for simulating the behavior of a
-// specimen using the OpenSees domain.
+// specimen using the OpenSees domain. Each control step can be split
+// into several analysis substeps, over which the trial values are
+// ramped linearly from the previous targets to the new ones.
 
 #include "ECSimulation.h"
 
@@ -48,13 +50,15 @@ class TimeSeries;
 class LoadPattern;
 class SP_Constraint;
 class Node;
+class Element;
 
 class ECSimDomain : public ECSimulation
 {
 public:
     // constructors
     ECSimDomain(int tag, int nTrialCPs, ExperimentalCP **trialCPs,
-        int nOutCPs, ExperimentalCP **outCPs, Domain *theDomain);
+        int nOutCPs, ExperimentalCP **outCPs, Domain *theDomain,
+        int numSubSteps = 1);
     ECSimDomain(const ECSimDomain& ec);
     
     // destructor
@@ -117,10 +121,27 @@ private:
     TimeSeries    *theSeries;
     LoadPattern   *thePattern;
     SP_Constraint **theSPs;
-    Node          **theNodes;
     
     int numSPs;     // total number of SP constraints
     
+    int numSubSteps;    // number of analysis substeps per control step
+    double *lastCtrl;   // SP values reached at the end of the last step
+    double *trgtCtrl;   // SP values to be reached at the end of this step
+    
+    // output dofs flattened over all output control points
+    int numOutDOF;      // total number of output dofs
+    Node **daqNodes;    // node of each output dof
+    int *daqDOF;        // dof number at the node of each output dof
+    
+    // elements connected to the output nodes and all their nodes,
+    // which are the only ones needed to get the output reactions
+    int numReactEles, numReactNodes;
+    Element **reactEles;
+    Node **reactNodes;
+    
+    // numSubSteps, numIter, control and acquire time of last step
+    Vector simTiming;
+    
     double *ctrlDisp, *ctrlVel, *ctrlAccel, *ctrlForce;
     double *daqDisp, *daqVel, *daqAccel, *daqForce;
 };
@@ -27,6 +27,7 @@
 // ECSimFEAdapter class.
 
 #include "ECSimFEAdapter.h"
+#include <ExpTiming.h>
 #include <ExperimentalCP.h>
 
 #include <Channel.h>
@@ -333,6 +334,8 @@ int ECSimFEAdapter::setTrialResponse(
     // set flag that relative trial signal has been obtained
     gotRelativeTrial = 1;
     
+    this->waitForNextStep();
+    
     // send control signal array to controller
     k += this->control();
     
@@ -433,6 +436,10 @@ Response* ECSimFEAdapter::setResponse(const char **argv, int argc,
         }
         theResponse = new ExpControlResponse(this, 2, *daqSignal);
     }
+    // pacing jitter
+    if (theResponse == 0)
+        theResponse = this->setPacingResponse(argv, argc, output);
+    
     output.endTag();
     
     return theResponse;
@@ -449,7 +456,7 @@ int ECSimFEAdapter::getResponse(int responseID, Information &info)
         return info.setVector(*daqSignal);
         
     default:
-        return OF_ReturnType_failed;
+        return this->ExperimentalControl::getResponse(responseID, info);
     }
 }
 
@@ -490,6 +497,8 @@ void ECSimFEAdapter::Print(OPS_Stream &s, int flag)
 
 int ECSimFEAdapter::control()
 {
+    ExpTimer timer(OF_Timing_Control);
+    
     sData[0] = OF_RemoteTest_setTrialResponse;
     theChannel->sendVector(0, 0, *sendData, 0);
     
@@ -499,6 +508,8 @@ int ECSimFEAdapter::control()
 
 int ECSimFEAdapter::acquire()
 {
+    ExpTimer timer(OF_Timing_Acquire);
+    
     sData[0] = OF_RemoteTest_getForce;
     theChannel->sendVector(0, 0, *sendData, 0);
     theChannel->recvVector(0, 0, *recvData, 0);
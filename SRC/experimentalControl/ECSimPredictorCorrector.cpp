@@ -0,0 +1,998 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of the
+// ECSimPredictorCorrector class.
+
+#include "ECSimPredictorCorrector.h"
+#include <ExpTiming.h>
+
+#include <UniaxialMaterial.h>
+
+#include <math.h>
+#include <new>
+
+// states of the simulated target
+enum EC_PredictorCorrectorState  {
+    EC_statePredicting = 1,
+    EC_stateCorrecting = 2
+};
+
+
+// evaluates the polynomial through the points (xn,yn) at x
+static double lagrange(const double *xn, const double *yn, int n, double x)
+{
+    double y = 0.0;
+    for (int j=0; j<n; j++)  {
+        double l = 1.0;
+        for (int k=0; k<n; k++)  {
+            if (k != j)
+                l *= (x - xn[k])/(xn[j] - xn[k]);
+        }
+        y += l*yn[j];
+    }
+    
+    return y;
+}
+
+
+ECSimPredictorCorrector::ECSimPredictorCorrector(int tag, int numdof,
+    UniaxialMaterial **specimen, double dtint, double samplerate,
+    int ord, double predfact, double servofreq, int numdelay,
+    double timeout)
+    : ECSimulation(tag),
+    numDOF(numdof), theSpecimen(0), dtInt(dtint),
+    sampleRate(samplerate), order(ord), predFact(predfact),
+    servoFreq(servofreq), numDelay(numdelay), timeOut(timeout),
+    N(0), N1(0), memPtrOPF(0),
+    newTarget(0), switchPC(0), atTarget(0),
+    ctrlDisp(0), ctrlVel(0), ctrlAccel(0), ctrlForce(0), ctrlTime(0),
+    daqDisp(0), daqVel(0), daqAccel(0), daqForce(0), daqTime(0),
+    theTarget(0), state(EC_statePredicting), iSample(0), xCorr(0.0),
+    dispHist(0), dispTarget(0), dispCorr(0), dispCmd(0), dispDelay(0),
+    dispMeas(0), velMeas(0), iDelay(0), numSamples(0),
+    numSteps(0), numHolds(0), numOverruns(0), lastError(0.0),
+    maxError(0.0), controlTime(0.0), acquireTime(0.0)
+{
+    if (specimen == 0)  {
+        opserr << "ECSimPredictorCorrector::ECSimPredictorCorrector() - "
+            << "null specimen array passed.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    // check the parameters of the simulated target
+    if (dtInt <= 0.0 || sampleRate <= 0.0)  {
+        opserr << "ECSimPredictorCorrector::ECSimPredictorCorrector() - "
+            << "dtInt and sampleRate must be positive.\n";
+        exit(OF_ReturnType_failed);
+    }
+    if (order < 1 || order > 3)  {
+        opserr << "ECSimPredictorCorrector::ECSimPredictorCorrector() - "
+            << "order must be 1, 2 or 3.\n";
+        exit(OF_ReturnType_failed);
+    }
+    if (predFact <= 0.0 || predFact >= 1.0)  {
+        opserr << "ECSimPredictorCorrector::ECSimPredictorCorrector() - "
+            << "predFact must be between 0 and 1.\n";
+        exit(OF_ReturnType_failed);
+    }
+    if (servoFreq < 0.0 || numDelay < 0 || timeOut <= 0.0)  {
+        opserr << "ECSimPredictorCorrector::ECSimPredictorCorrector() - "
+            << "invalid servoFreq, numDelay or timeOut.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    // number of samples per integration step and to predict
+    N = (int)floor(dtInt*sampleRate + 0.5);
+    if (N < 2)  {
+        opserr << "ECSimPredictorCorrector::ECSimPredictorCorrector() - "
+            << "dtInt*sampleRate must be at least 2 samples.\n";
+        exit(OF_ReturnType_failed);
+    }
+    N1 = (int)floor(predFact*N + 0.5);
+    if (N1 < 1)
+        N1 = 1;
+    if (N1 > N-1)
+        N1 = N-1;
+    
+    // allocate memory for the uniaxial materials
+    theSpecimen = new UniaxialMaterial* [numDOF];
+    if (theSpecimen == 0)  {
+        opserr << "ECSimPredictorCorrector::ECSimPredictorCorrector() - "
+            << "failed to allocate pointers for uniaxial materials.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    // get copies of the uniaxial materials
+    for (int i=0; i<numDOF; i++)  {
+        if (specimen[i] == 0) {
+            opserr << "ECSimPredictorCorrector::ECSimPredictorCorrector() - "
+                "null uniaxial material pointer passed.\n";
+            exit(OF_ReturnType_failed);
+        }
+        theSpecimen[i] = specimen[i]->getCopy();
+        if (theSpecimen[i] == 0) {
+            opserr << "ECSimPredictorCorrector::ECSimPredictorCorrector() - "
+                << "failed to copy uniaxial material.\n";
+            exit(OF_ReturnType_failed);
+        }
+    }
+    
+    this->allocateMemory();
+}
+
+
+ECSimPredictorCorrector::ECSimPredictorCorrector(const ECSimPredictorCorrector& ec)
+    : ECSimulation(ec),
+    numDOF(ec.numDOF), theSpecimen(0), dtInt(ec.dtInt),
+    sampleRate(ec.sampleRate), order(ec.order), predFact(ec.predFact),
+    servoFreq(ec.servoFreq), numDelay(ec.numDelay), timeOut(ec.timeOut),
+    N(ec.N), N1(ec.N1), memPtrOPF(0),
+    newTarget(0), switchPC(0), atTarget(0),
+    ctrlDisp(0), ctrlVel(0), ctrlAccel(0), ctrlForce(0), ctrlTime(0),
+    daqDisp(0), daqVel(0), daqAccel(0), daqForce(0), daqTime(0),
+    theTarget(0), state(EC_statePredicting), iSample(0), xCorr(0.0),
+    dispHist(0), dispTarget(0), dispCorr(0), dispCmd(0), dispDelay(0),
+    dispMeas(0), velMeas(0), iDelay(0), numSamples(0),
+    numSteps(0), numHolds(0), numOverruns(0), lastError(0.0),
+    maxError(0.0), controlTime(0.0), acquireTime(0.0)
+{
+    // allocate memory for the uniaxial materials
+    theSpecimen = new UniaxialMaterial* [numDOF];
+    if (theSpecimen == 0)  {
+        opserr << "ECSimPredictorCorrector::ECSimPredictorCorrector() - "
+            << "failed to allocate pointers for uniaxial materials.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    // get copies of the uniaxial materials
+    for (int i=0; i<numDOF; i++)  {
+        theSpecimen[i] = ec.theSpecimen[i]->getCopy();
+        if (theSpecimen[i] == 0) {
+            opserr << "ECSimPredictorCorrector::ECSimPredictorCorrector() - "
+                << "failed to copy uniaxial material.\n";
+            exit(OF_ReturnType_failed);
+        }
+    }
+    
+    // the copy gets its own memory region and target thread
+    this->allocateMemory();
+}
+
+
+ECSimPredictorCorrector::~ECSimPredictorCorrector()
+{
+    // stop the target thread before the materials are deleted
+    this->stopTarget();
+    
+    // delete memory of materials
+    if (theSpecimen != 0)  {
+        for (int i=0; i<numDOF; i++)
+            if (theSpecimen[i] != 0)
+                delete theSpecimen[i];
+        delete [] theSpecimen;
+    }
+    
+    // delete memory of the target state
+    if (dispHist != 0)
+        delete [] dispHist;
+    if (dispTarget != 0)
+        delete [] dispTarget;
+    if (dispCorr != 0)
+        delete [] dispCorr;
+    if (dispCmd != 0)
+        delete [] dispCmd;
+    if (dispDelay != 0)
+        delete [] dispDelay;
+    if (dispMeas != 0)
+        delete [] dispMeas;
+    if (velMeas != 0)
+        delete [] velMeas;
+    
+    // delete the memory region
+    if (memPtrOPF != 0)
+        delete [] memPtrOPF;
+}
+
+
+int ECSimPredictorCorrector::setup()
+{
+    int rValue = 0;
+    
+    // print experimental control information
+    this->Print(opserr);
+    
+    // start the simulated target, the first target is the origin
+    if (theTarget == 0)
+        this->startTarget();
+    
+    rValue += this->control();
+    rValue += this->acquire();
+    
+    return rValue;
+}
+
+
+int ECSimPredictorCorrector::setSize(ID sizeT, ID sizeO)
+{
+    // check sizeTrial and sizeOut
+    // for ECSimPredictorCorrector object
+    
+    // ECSimPredictorCorrector objects can only use
+    // trial response vectors with size <= numDOF and
+    // output response vectors with size <= numDOF
+    // and need the trial displacements to drive the actuators.
+    // check these are available in sizeT/sizeO.
+    if (sizeT(OF_Resp_Disp) != numDOF || sizeT(OF_Resp_Vel) > numDOF ||
+        sizeT(OF_Resp_Accel) > numDOF || sizeT(OF_Resp_Force) > numDOF ||
+        sizeT(OF_Resp_Time) > numDOF ||
+        sizeO(OF_Resp_Disp) > numDOF || sizeO(OF_Resp_Vel) > numDOF ||
+        sizeO(OF_Resp_Accel) > numDOF || sizeO(OF_Resp_Force) > numDOF ||
+        sizeO(OF_Resp_Time) > numDOF)  {
+        opserr << "ECSimPredictorCorrector::setSize() - wrong sizeTrial/Out\n";
+        opserr << "sizeT(Disp) = " << sizeT(OF_Resp_Disp) << " != " << numDOF << endln;
+        opserr << "see User Manual.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    (*sizeCtrl) = sizeT;
+    (*sizeDaq)  = sizeO;
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ECSimPredictorCorrector::setTrialResponse(const Vector* disp,
+    const Vector* vel,
+    const Vector* accel,
+    const Vector* force,
+    const Vector* time)
+{
+    int i, rValue = 0;
+    
+    if (disp != 0)  {
+        if (theCtrlFilters[OF_Resp_Disp] == 0)  {
+            for (i=0; i<(*sizeCtrl)(OF_Resp_Disp); i++)
+                ctrlDisp[i] = float((*disp)(i));
+        } else  {
+            for (i=0; i<(*sizeCtrl)(OF_Resp_Disp); i++)
+                ctrlDisp[i] = float(theCtrlFilters[OF_Resp_Disp]->filtering((*disp)(i)));
+        }
+    }
+    if (vel != 0)  {
+        if (theCtrlFilters[OF_Resp_Vel] == 0)  {
+            for (i=0; i<(*sizeCtrl)(OF_Resp_Vel); i++)
+                ctrlVel[i] = float((*vel)(i));
+        } else  {
+            for (i=0; i<(*sizeCtrl)(OF_Resp_Vel); i++)
+                ctrlVel[i] = float(theCtrlFilters[OF_Resp_Vel]->filtering((*vel)(i)));
+        }
+    }
+    if (accel != 0)  {
+        if (theCtrlFilters[OF_Resp_Accel] == 0)  {
+            for (i=0; i<(*sizeCtrl)(OF_Resp_Accel); i++)
+                ctrlAccel[i] = float((*accel)(i));
+        } else  {
+            for (i=0; i<(*sizeCtrl)(OF_Resp_Accel); i++)
+                ctrlAccel[i] = float(theCtrlFilters[OF_Resp_Accel]->filtering((*accel)(i)));
+        }
+    }
+    if (force != 0)  {
+        if (theCtrlFilters[OF_Resp_Force] == 0)  {
+            for (i=0; i<(*sizeCtrl)(OF_Resp_Force); i++)
+                ctrlForce[i] = float((*force)(i));
+        } else  {
+            for (i=0; i<(*sizeCtrl)(OF_Resp_Force); i++)
+                ctrlForce[i] = float(theCtrlFilters[OF_Resp_Force]->filtering((*force)(i)));
+        }
+    }
+    if (time != 0)  {
+        if (theCtrlFilters[OF_Resp_Time] == 0)  {
+            for (i=0; i<(*sizeCtrl)(OF_Resp_Time); i++)
+                ctrlTime[i] = float((*time)(i));
+        } else  {
+            for (i=0; i<(*sizeCtrl)(OF_Resp_Time); i++)
+                ctrlTime[i] = float(theCtrlFilters[OF_Resp_Time]->filtering((*time)(i)));
+        }
+    }
+    
+    this->waitForNextStep();
+    rValue = this->control();
+    
+    return rValue;
+}
+
+
+int ECSimPredictorCorrector::getDaqResponse(Vector* disp,
+    Vector* vel,
+    Vector* accel,
+    Vector* force,
+    Vector* time)
+{
+    int i, rValue = 0;
+    
+    rValue = this->acquire();
+    
+    if (disp != 0)  {
+        if (theDaqFilters[OF_Resp_Disp] == 0)  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Disp); i++)
+                (*disp)(i) = daqDisp[i];
+        } else  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Disp); i++)
+                (*disp)(i) = theDaqFilters[OF_Resp_Disp]->filtering(daqDisp[i]);
+        }
+    }
+    if (vel != 0)  {
+        if (theDaqFilters[OF_Resp_Vel] == 0)  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Vel); i++)
+                (*vel)(i) = daqVel[i];
+        } else  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Vel); i++)
+                (*vel)(i) = theDaqFilters[OF_Resp_Vel]->filtering(daqVel[i]);
+        }
+    }
+    if (accel != 0)  {
+        if (theDaqFilters[OF_Resp_Accel] == 0)  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Accel); i++)
+                (*accel)(i) = daqAccel[i];
+        } else  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Accel); i++)
+                (*accel)(i) = theDaqFilters[OF_Resp_Accel]->filtering(daqAccel[i]);
+        }
+    }
+    if (force != 0)  {
+        if (theDaqFilters[OF_Resp_Force] == 0)  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Force); i++)
+                (*force)(i) = daqForce[i];
+        } else  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Force); i++)
+                (*force)(i) = theDaqFilters[OF_Resp_Force]->filtering(daqForce[i]);
+        }
+    }
+    if (time != 0)  {
+        if (theDaqFilters[OF_Resp_Time] == 0)  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Time); i++)
+                (*time)(i) = daqTime[i];
+        } else  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Time); i++)
+                (*time)(i) = theDaqFilters[OF_Resp_Time]->filtering(daqTime[i]);
+        }
+    }
+    
+    return rValue;
+}
+
+
+int ECSimPredictorCorrector::commitState()
+{
+    // the target thread commits the materials at every sample
+    return OF_ReturnType_completed;
+}
+
+
+ExperimentalControl* ECSimPredictorCorrector::getCopy()
+{
+    return new ECSimPredictorCorrector(*this);
+}
+
+
+Response* ECSimPredictorCorrector::setResponse(const char **argv, int argc,
+    OPS_Stream &output)
+{
+    int i;
+    char outputData[15];
+    Response *theResponse = 0;
+    
+    output.tag("ExpControlOutput");
+    output.attr("ctrlType",this->getClassType());
+    output.attr("ctrlTag",this->getTag());
+    
+    // ctrl displacements
+    if (strcmp(argv[0],"ctrlDisp") == 0 ||
+        strcmp(argv[0],"ctrlDisplacement") == 0 ||
+        strcmp(argv[0],"ctrlDisplacements") == 0)
+    {
+        for (i=0; i<(*sizeCtrl)(OF_Resp_Disp); i++)  {
+            sprintf(outputData,"ctrlDisp%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 1,
+            Vector((*sizeCtrl)(OF_Resp_Disp)));
+    }
+    
+    // ctrl velocities
+    else if (strcmp(argv[0],"ctrlVel") == 0 ||
+        strcmp(argv[0],"ctrlVelocity") == 0 ||
+        strcmp(argv[0],"ctrlVelocities") == 0)
+    {
+        for (i=0; i<(*sizeCtrl)(OF_Resp_Vel); i++)  {
+            sprintf(outputData,"ctrlVel%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 2,
+            Vector((*sizeCtrl)(OF_Resp_Vel)));
+    }
+    
+    // ctrl accelerations
+    else if (strcmp(argv[0],"ctrlAccel") == 0 ||
+        strcmp(argv[0],"ctrlAcceleration") == 0 ||
+        strcmp(argv[0],"ctrlAccelerations") == 0)
+    {
+        for (i=0; i<(*sizeCtrl)(OF_Resp_Accel); i++)  {
+            sprintf(outputData,"ctrlAccel%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 3,
+            Vector((*sizeCtrl)(OF_Resp_Accel)));
+    }
+    
+    // ctrl forces
+    else if (strcmp(argv[0],"ctrlForce") == 0 ||
+        strcmp(argv[0],"ctrlForces") == 0)
+    {
+        for (i=0; i<(*sizeCtrl)(OF_Resp_Force); i++)  {
+            sprintf(outputData,"ctrlForce%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 4,
+            Vector((*sizeCtrl)(OF_Resp_Force)));
+    }
+    
+    // ctrl times
+    else if (strcmp(argv[0],"ctrlTime") == 0 ||
+        strcmp(argv[0],"ctrlTimes") == 0)
+    {
+        for (i=0; i<(*sizeCtrl)(OF_Resp_Time); i++)  {
+            sprintf(outputData,"ctrlTime%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 5,
+            Vector((*sizeCtrl)(OF_Resp_Time)));
+    }
+    
+    // daq displacements
+    else if (strcmp(argv[0],"daqDisp") == 0 ||
+        strcmp(argv[0],"daqDisplacement") == 0 ||
+        strcmp(argv[0],"daqDisplacements") == 0)
+    {
+        for (i=0; i<(*sizeDaq)(OF_Resp_Disp); i++)  {
+            sprintf(outputData,"daqDisp%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 6,
+            Vector((*sizeDaq)(OF_Resp_Disp)));
+    }
+    
+    // daq velocities
+    else if (strcmp(argv[0],"daqVel") == 0 ||
+        strcmp(argv[0],"daqVelocity") == 0 ||
+        strcmp(argv[0],"daqVelocities") == 0)
+    {
+        for (i=0; i<(*sizeDaq)(OF_Resp_Vel); i++)  {
+            sprintf(outputData,"daqVel%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 7,
+            Vector((*sizeDaq)(OF_Resp_Vel)));
+    }
+    
+    // daq accelerations
+    else if (strcmp(argv[0],"daqAccel") == 0 ||
+        strcmp(argv[0],"daqAcceleration") == 0 ||
+        strcmp(argv[0],"daqAccelerations") == 0)
+    {
+        for (i=0; i<(*sizeDaq)(OF_Resp_Accel); i++)  {
+            sprintf(outputData,"daqAccel%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 8,
+            Vector((*sizeDaq)(OF_Resp_Accel)));
+    }
+    
+    // daq forces
+    else if (strcmp(argv[0],"daqForce") == 0 ||
+        strcmp(argv[0],"daqForces") == 0)
+    {
+        for (i=0; i<(*sizeDaq)(OF_Resp_Force); i++)  {
+            sprintf(outputData,"daqForce%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 9,
+            Vector((*sizeDaq)(OF_Resp_Force)));
+    }
+    
+    // daq times
+    else if (strcmp(argv[0],"daqTime") == 0 ||
+        strcmp(argv[0],"daqTimes") == 0)
+    {
+        for (i=0; i<(*sizeDaq)(OF_Resp_Time); i++)  {
+            sprintf(outputData,"daqTime%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 10,
+            Vector((*sizeDaq)(OF_Resp_Time)));
+    }
+    
+    // statistics of the simulated target
+    else if (strcmp(argv[0],"targetStats") == 0)
+    {
+        output.tag("ResponseType","numSteps");
+        output.tag("ResponseType","numHolds");
+        output.tag("ResponseType","numOverruns");
+        output.tag("ResponseType","lastError");
+        output.tag("ResponseType","maxError");
+        output.tag("ResponseType","controlTime");
+        output.tag("ResponseType","acquireTime");
+        theResponse = new ExpControlResponse(this, 11, Vector(7));
+    }
+    
+    // pacing jitter
+    if (theResponse == 0)
+        theResponse = this->setPacingResponse(argv, argc, output);
+    
+    output.endTag();
+    
+    return theResponse;
+}
+
+
+int ECSimPredictorCorrector::getResponse(int responseID, Information &info)
+{
+    Vector resp(0);
+    
+    switch (responseID)  {
+    case 1:  // ctrl displacements
+        resp.resize((*sizeCtrl)(OF_Resp_Disp));
+        for (int i=0; i<(*sizeCtrl)(OF_Resp_Disp); i++)
+            resp(i) = ctrlDisp[i];
+        return info.setVector(resp);
+    
+    case 2:  // ctrl velocities
+        resp.resize((*sizeCtrl)(OF_Resp_Vel));
+        for (int i=0; i<(*sizeCtrl)(OF_Resp_Vel); i++)
+            resp(i) = ctrlVel[i];
+        return info.setVector(resp);
+    
+    case 3:  // ctrl accelerations
+        resp.resize((*sizeCtrl)(OF_Resp_Accel));
+        for (int i=0; i<(*sizeCtrl)(OF_Resp_Accel); i++)
+            resp(i) = ctrlAccel[i];
+        return info.setVector(resp);
+    
+    case 4:  // ctrl forces
+        resp.resize((*sizeCtrl)(OF_Resp_Force));
+        for (int i=0; i<(*sizeCtrl)(OF_Resp_Force); i++)
+            resp(i) = ctrlForce[i];
+        return info.setVector(resp);
+    
+    case 5:  // ctrl times
+        resp.resize((*sizeCtrl)(OF_Resp_Time));
+        for (int i=0; i<(*sizeCtrl)(OF_Resp_Time); i++)
+            resp(i) = ctrlTime[i];
+        return info.setVector(resp);
+    
+    case 6:  // daq displacements
+        resp.resize((*sizeDaq)(OF_Resp_Disp));
+        for (int i=0; i<(*sizeDaq)(OF_Resp_Disp); i++)
+            resp(i) = daqDisp[i];
+        return info.setVector(resp);
+    
+    case 7:  // daq velocities
+        resp.resize((*sizeDaq)(OF_Resp_Vel));
+        for (int i=0; i<(*sizeDaq)(OF_Resp_Vel); i++)
+            resp(i) = daqVel[i];
+        return info.setVector(resp);
+    
+    case 8:  // daq accelerations
+        resp.resize((*sizeDaq)(OF_Resp_Accel));
+        for (int i=0; i<(*sizeDaq)(OF_Resp_Accel); i++)
+            resp(i) = daqAccel[i];
+        return info.setVector(resp);
+    
+    case 9:  // daq forces
+        resp.resize((*sizeDaq)(OF_Resp_Force));
+        for (int i=0; i<(*sizeDaq)(OF_Resp_Force); i++)
+            resp(i) = daqForce[i];
+        return info.setVector(resp);
+    
+    case 10:  // daq times
+        resp.resize((*sizeDaq)(OF_Resp_Time));
+        for (int i=0; i<(*sizeDaq)(OF_Resp_Time); i++)
+            resp(i) = daqTime[i];
+        return info.setVector(resp);
+    
+    case 11:  // statistics of the simulated target
+        resp.resize(7);
+        resp(0) = double(numSteps.load());
+        resp(1) = double(numHolds.load());
+        resp(2) = double(numOverruns.load());
+        resp(3) = lastError.load();
+        resp(4) = maxError.load();
+        resp(5) = controlTime.load();
+        resp(6) = acquireTime.load();
+        return info.setVector(resp);
+    
+    default:
+        return this->ExperimentalControl::getResponse(responseID, info);
+    }
+}
+
+
+void ECSimPredictorCorrector::Print(OPS_Stream &s, int flag)
+{
+    s << "****************************************************************\n";
+    s << "* ExperimentalControl: " << this->getTag() << endln;
+    s << "*   type: ECSimPredictorCorrector\n";
+    for (int i=0; i<numDOF; i++)  {
+        s << "*   UniaxialMaterial: " << theSpecimen[i]->getTag() << endln;
+    }
+    s << "*   dtInt: " << dtInt << endln;
+    s << "*   sampleRate: " << sampleRate << endln;
+    s << "*   samples per step: " << N << " (predict " << N1 << ")\n";
+    s << "*   order: " << order << endln;
+    if (servoFreq > 0.0)
+        s << "*   servoFreq: " << servoFreq << endln;
+    else
+        s << "*   servoFreq: ideal\n";
+    s << "*   numDelay: " << numDelay << endln;
+    s << "*   ctrlFilters:";
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (theCtrlFilters[i] != 0)
+            s << " " << theCtrlFilters[i]->getTag();
+        else
+            s << " 0";
+    }
+    s << "\n*   daqFilters:";
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (theDaqFilters[i] != 0)
+            s << " " << theDaqFilters[i]->getTag();
+        else
+            s << " 0";
+    }
+    s << "\n****************************************************************\n\n";
+}
+
+
+int ECSimPredictorCorrector::control()
+{
+    ExpTimer timer(OF_Timing_Control);
+    
+    double tStart = this->getMonotonicTime();
+    
+    // set newTarget flag
+    newTarget->store(1);
+    
+    // wait until switchPC flag has changed as well
+    if (this->waitForFlag(switchPC, 1, "switchPC") < 0)
+        return OF_ReturnType_failed;
+    
+    // reset newTarget flag
+    newTarget->store(0);
+    
+    // wait until switchPC flag has changed as well
+    if (this->waitForFlag(switchPC, 0, "switchPC") < 0)
+        return OF_ReturnType_failed;
+    
+    controlTime.store(this->getMonotonicTime() - tStart);
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ECSimPredictorCorrector::acquire()
+{
+    ExpTimer timer(OF_Timing_Acquire);
+    
+    double tStart = this->getMonotonicTime();
+    
+    // wait until target is reached
+    if (this->waitForFlag(atTarget, 1, "atTarget") < 0)
+        return OF_ReturnType_failed;
+    
+    acquireTime.store(this->getMonotonicTime() - tStart);
+    
+    return OF_ReturnType_completed;
+}
+
+
+void ECSimPredictorCorrector::allocateMemory()
+{
+    // the region has the layout of the SCRAMNet memory,
+    // the flags are constructed in place as atomic integers
+    // which must be lock-free and fit into one float slot
+    static_assert(sizeof(std::atomic<int>) == sizeof(float) &&
+        alignof(std::atomic<int>) <= alignof(float) &&
+        ATOMIC_INT_LOCK_FREE == 2,
+        "atomic<int> flags do not fit into the float memory region");
+    memPtrOPF = new float [3 + 10*numDOF];
+    float *memPtr = memPtrOPF;
+    
+    // setup pointers to newTarget flag
+    newTarget = new (memPtr) std::atomic<int>(0);  memPtr++;
+    
+    // setup pointers to control memory locations
+    ctrlDisp  = memPtr;  memPtr += numDOF;
+    ctrlVel   = memPtr;  memPtr += numDOF;
+    ctrlAccel = memPtr;  memPtr += numDOF;
+    ctrlForce = memPtr;  memPtr += numDOF;
+    ctrlTime  = memPtr;  memPtr += numDOF;
+    
+    // setup pointers to switchPC and atTarget flags
+    switchPC = new (memPtr) std::atomic<int>(0);  memPtr++;
+    atTarget = new (memPtr) std::atomic<int>(0);  memPtr++;
+    
+    // setup pointers to daq memory locations
+    daqDisp  = memPtr;  memPtr += numDOF;
+    daqVel   = memPtr;  memPtr += numDOF;
+    daqAccel = memPtr;  memPtr += numDOF;
+    daqForce = memPtr;  memPtr += numDOF;
+    daqTime  = memPtr;
+    
+    // initialize everything to zero
+    for (int i=0; i<numDOF; i++)  {
+        ctrlDisp[i]  = 0.0;
+        ctrlVel[i]   = 0.0;
+        ctrlAccel[i] = 0.0;
+        ctrlForce[i] = 0.0;
+        ctrlTime[i]  = 0.0;
+        daqDisp[i]  = 0.0;
+        daqVel[i]   = 0.0;
+        daqAccel[i] = 0.0;
+        daqForce[i] = 0.0;
+        daqTime[i]  = 0.0;
+    }
+    
+    // allocate memory for the state of the target
+    dispHist   = new double [numDOF*(order+1)];
+    dispTarget = new double [numDOF];
+    dispCorr   = new double [numDOF];
+    dispCmd    = new double [numDOF];
+    dispDelay  = new double [numDOF*(numDelay+1)];
+    dispMeas   = new double [numDOF];
+    velMeas    = new double [numDOF];
+}
+
+
+void ECSimPredictorCorrector::startTarget()
+{
+    int i;
+    
+    // the target starts at rest at the origin
+    for (i=0; i<numDOF*(order+1); i++)
+        dispHist[i] = 0.0;
+    for (i=0; i<numDOF*(numDelay+1); i++)
+        dispDelay[i] = 0.0;
+    for (i=0; i<numDOF; i++)  {
+        dispTarget[i] = 0.0;
+        dispCorr[i] = 0.0;
+        dispCmd[i] = 0.0;
+        dispMeas[i] = 0.0;
+        velMeas[i] = 0.0;
+    }
+    state = EC_statePredicting;
+    iSample = 0;
+    iDelay = 0;
+    numSamples = 0;
+    
+    newTarget->store(0);
+    switchPC->store(0);
+    atTarget->store(0);
+    
+    theTarget = new std::thread(&ECSimPredictorCorrector::targetLoop, this);
+}
+
+
+void ECSimPredictorCorrector::stopTarget()
+{
+    if (theTarget == 0)
+        return;
+    
+    // same as for the xPC target, a negative newTarget flag
+    // stops the predictor-corrector
+    newTarget->store(-1);
+    
+    theTarget->join();
+    delete theTarget;
+    theTarget = 0;
+}
+
+
+void ECSimPredictorCorrector::targetLoop()
+{
+    double period = 1.0/sampleRate;
+    double deadline = this->getMonotonicTime();
+    
+    while (true)  {
+        // wait for the next sample, samples that are missed
+        // completely are skipped and counted as overruns
+        deadline += period;
+        double now = this->getMonotonicTime();
+        if (now > deadline + period)  {
+            numOverruns++;
+            deadline = now;
+        } else  {
+            this->sleepUntil(deadline);
+        }
+    
+        if (this->targetStep() < 0)
+            return;
+    }
+}
+
+
+int ECSimPredictorCorrector::targetStep()
+{
+    int i, j, n = order+1;
+    double xn[4], yn[4];
+    
+    int flag = newTarget->load();
+    if (flag < 0)
+        return -1;
+    
+    // second half of the handshake
+    if (flag == 0 && switchPC->load() == 1)
+        switchPC->store(0);
+    
+    if (state == EC_statePredicting)  {
+        if (flag == 1 && switchPC->load() == 0)  {
+            // new target: start correcting from the current command
+            xCorr = double(iSample)/N;
+            for (i=0; i<numDOF; i++)
+                dispTarget[i] = ctrlDisp[i];
+            xn[0] = 1.0;
+            for (j=1; j<n; j++)
+                xn[j] = 1.0 - j;
+            for (i=0; i<numDOF; i++)  {
+                yn[0] = dispTarget[i];
+                for (j=1; j<n; j++)
+                    yn[j] = dispHist[i*n+j-1];
+                dispCorr[i] = dispCmd[i] - lagrange(xn, yn, n, xCorr);
+            }
+            state = EC_stateCorrecting;
+            atTarget->store(0);
+            switchPC->store(1);
+        }
+        else if (iSample < N1)  {
+            iSample++;
+        }
+        else  {
+            // the integration step is late, hold the prediction
+            numHolds++;
+        }
+    }
+    
+    bool reached = false;
+    double x = double(iSample)/N;
+    if (state == EC_stateCorrecting)  {
+        iSample++;
+        x = double(iSample)/N;
+        if (iSample >= N)
+            reached = true;
+    }
+    
+    // generate the actuator commands
+    if (state == EC_statePredicting)  {
+        // extrapolate through the last targets
+        for (j=0; j<n; j++)
+            xn[j] = -double(j);
+        for (i=0; i<numDOF; i++)
+            dispCmd[i] = lagrange(xn, &dispHist[i*n], n, x);
+    }
+    else if (reached)  {
+        for (i=0; i<numDOF; i++)
+            dispCmd[i] = dispTarget[i];
+    }
+    else  {
+        // interpolate through the new and the last targets and
+        // blend out the offset at the start of the correction
+        xn[0] = 1.0;
+        for (j=1; j<n; j++)
+            xn[j] = 1.0 - j;
+        double fact = (1.0 - x)/(1.0 - xCorr);
+        for (i=0; i<numDOF; i++)  {
+            yn[0] = dispTarget[i];
+            for (j=1; j<n; j++)
+                yn[j] = dispHist[i*n+j-1];
+            dispCmd[i] = lagrange(xn, yn, n, x) + fact*dispCorr[i];
+        }
+    }
+    
+    // simulated servo-hydraulic plant and specimen
+    double alpha = 1.0;
+    if (servoFreq > 0.0)
+        alpha = 1.0 - exp(-8.0*atan(1.0)*servoFreq/sampleRate);
+    numSamples++;
+    double error = 0.0;
+    for (i=0; i<numDOF; i++)  {
+        double *delay = &dispDelay[i*(numDelay+1)];
+        delay[iDelay] = dispCmd[i];
+        double dispIn = delay[(iDelay+1) % (numDelay+1)];
+    
+        double disp = dispMeas[i] + alpha*(dispIn - dispMeas[i]);
+        double vel = (disp - dispMeas[i])*sampleRate;
+        double accel = (vel - velMeas[i])*sampleRate;
+        dispMeas[i] = disp;
+        velMeas[i] = vel;
+    
+        theSpecimen[i]->setTrialStrain(disp, vel);
+        double force = theSpecimen[i]->getStress();
+        theSpecimen[i]->commitState();
+    
+        if (reached)  {
+            daqDisp[i]  = float(disp);
+            daqVel[i]   = float(vel);
+            daqAccel[i] = float(accel);
+            daqForce[i] = float(force);
+            daqTime[i]  = float(numSamples/sampleRate);
+            if (fabs(dispTarget[i] - disp) > error)
+                error = fabs(dispTarget[i] - disp);
+        }
+    }
+    iDelay = (iDelay+1) % (numDelay+1);
+    
+    if (reached)  {
+        // shift the targets and start predicting the next one
+        for (i=0; i<numDOF; i++)  {
+            for (j=n-1; j>0; j--)
+                dispHist[i*n+j] = dispHist[i*n+j-1];
+            dispHist[i*n] = dispTarget[i];
+        }
+        state = EC_statePredicting;
+        iSample = 0;
+    
+        lastError.store(error);
+        if (error > maxError.load())
+            maxError.store(error);
+        numSteps++;
+    
+        // the daq values are written before the flag is set
+        atTarget->store(1);
+    }
+    
+    return 0;
+}
+
+
+int ECSimPredictorCorrector::waitForFlag(std::atomic<int> *theFlag,
+    int value, const char *flagName)
+{
+    // spin like on the SCRAMNet memory but give up after timeOut
+    // seconds, so that a stalled target does not hang the analysis
+    double deadline = this->getMonotonicTime() + timeOut;
+    while (theFlag->load() != value)  {
+        if (this->getMonotonicTime() > deadline)  {
+            opserr << "ECSimPredictorCorrector::waitForFlag() - "
+                << "timeout waiting for " << flagName << " = "
+                << value << endln;
+            return OF_ReturnType_failed;
+        }
+        std::this_thread::yield();
+    }
+    
+    return OF_ReturnType_completed;
+}
@@ -0,0 +1,154 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef ECSimPredictorCorrector_h
+#define ECSimPredictorCorrector_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ECSimPredictorCorrector. ECSimPredictorCorrector is a controller
+// class for simulating a real-time hybrid test with an xPC-Target
+// predictor-corrector on a plain computer. A background thread takes
+// the place of the real-time target. It runs at a fixed sample rate,
+// generates the actuator commands with a polynomial predictor-
+// corrector and drives a simulated servo-hydraulic plant (a delay and
+// a first-order lag per actuator) that loads the specimen, which is
+// given by uncoupled OpenSees uniaxial material objects. OpenFresco
+// and the thread communicate through a local memory region with the
+// same layout and the same newTarget, switchPC and atTarget flag
+// handshake as ECSCRAMNet, so that the handshake and the timing of
+// the integration steps can be measured without any hardware.
+
+#include "ECSimulation.h"
+
+#include <atomic>
+#include <thread>
+
+class UniaxialMaterial;
+
+class ECSimPredictorCorrector : public ECSimulation
+{
+public:
+    // constructors
+    ECSimPredictorCorrector(int tag, int numDOF,
+        UniaxialMaterial **theSpecimen, double dtInt,
+        double sampleRate = 1024.0, int order = 3,
+        double predFact = 0.6, double servoFreq = 0.0,
+        int numDelay = 0, double timeOut = 1.0);
+    ECSimPredictorCorrector(const ECSimPredictorCorrector& ec);
+    
+    // destructor
+    virtual ~ECSimPredictorCorrector();
+    
+    // method to get class type
+    const char *getClassType() const {return "ECSimPredictorCorrector";};
+    
+    // public methods to set and to get response
+    virtual int setup();
+    virtual int setSize(ID sizeT, ID sizeO);
+    
+    virtual int setTrialResponse(const Vector* disp,
+        const Vector* vel,
+        const Vector* accel,
+        const Vector* force,
+        const Vector* time);
+    virtual int getDaqResponse(Vector* disp,
+        Vector* vel,
+        Vector* accel,
+        Vector* force,
+        Vector* time);
+    
+    virtual int commitState();
+    
+    virtual ExperimentalControl *getCopy();
+    
+    // public methods for experimental control recorder
+    virtual Response *setResponse(const char **argv, int argc,
+        OPS_Stream &output);
+    virtual int getResponse(int responseID, Information &info);
+    
+    // public methods for output
+    void Print(OPS_Stream &s, int flag = 0);
+    
+protected:
+    // protected methods to set and to get response
+    virtual int control();
+    virtual int acquire();
+    
+private:
+    // methods of the simulated real-time target
+    void allocateMemory();
+    void startTarget();
+    void stopTarget();
+    void targetLoop();
+    int targetStep();
+    int waitForFlag(std::atomic<int> *theFlag, int value,
+        const char *flagName);
+    
+    int numDOF;                      // number of actuators
+    UniaxialMaterial **theSpecimen;  // uniaxial materials
+    double dtInt;                    // integration time step
+    double sampleRate;               // sample rate of the target
+    int order;                       // order of the polynomials
+    double predFact;                 // fraction of a step to predict
+    double servoFreq;                // servo bandwidth (0 = ideal)
+    int numDelay;                    // actuator delay in samples
+    double timeOut;                  // timeout of the handshake
+    int N, N1;                       // samples per step and to predict
+    
+    // local memory region with the layout of ECSCRAMNet
+    float *memPtrOPF;
+    std::atomic<int> *newTarget, *switchPC, *atTarget;
+    float *ctrlDisp, *ctrlVel, *ctrlAccel, *ctrlForce, *ctrlTime;
+    float *daqDisp, *daqVel, *daqAccel, *daqForce, *daqTime;
+    
+    // state of the simulated target, only used by the target thread
+    std::thread *theTarget;
+    int state;              // predicting or correcting
+    int iSample;            // sample within the current step
+    double xCorr;           // normalized time the corrector started
+    double *dispHist;       // last order+1 targets of each actuator
+    double *dispTarget;     // new target of each actuator
+    double *dispCorr;       // offset of the command at xCorr
+    double *dispCmd;        // command of each actuator
+    double *dispDelay;      // delay lines of the commands
+    double *dispMeas;       // measured displacements
+    double *velMeas;        // measured velocities
+    int iDelay;             // current position in the delay lines
+    long numSamples;        // samples since the target was started
+    
+    // statistics of the target, read by the calling thread
+    std::atomic<long> numSteps;       // targets reached
+    std::atomic<long> numHolds;       // samples the predictor held
+    std::atomic<long> numOverruns;    // samples the target was late
+    std::atomic<double> lastError;    // last max tracking error
+    std::atomic<double> maxError;     // max tracking error
+    std::atomic<double> controlTime;  // last control() wait
+    std::atomic<double> acquireTime;  // last acquire() wait
+};
+
+#endif
@@ -31,6 +31,7 @@
 // ECSimSimulink class.
 
 #include "ECSimSimulink.h"
+#include <ExpTiming.h>
 
 #include <Channel.h>
 #include <TCP_Socket.h>
@@ -284,29 +285,27 @@ int ECSimSimulink::setTrialResponse(const Vector* disp,
     const Vector* force,
     const Vector* time)
 {
-    int i, rValue = 0;
+    int rValue = 0;
     if (disp != 0)  {
         *ctrlDisp = *disp;
-        if (theCtrlFilters[OF_Resp_Disp] != 0)  {
-            for (i=0; i<(*sizeCtrl)(OF_Resp_Disp); i++)
-                (*ctrlDisp)(i) = theCtrlFilters[OF_Resp_Disp]->filtering((*ctrlDisp)(i));
-        }
+        if (theCtrlFilters[OF_Resp_Disp] != 0)
+            theCtrlFilters[OF_Resp_Disp]->filtering(&(*ctrlDisp)(0),
+                &(*ctrlDisp)(0), (*sizeCtrl)(OF_Resp_Disp));
     }
     if (force != 0)  {
         *ctrlForce = *force;
-        if (theCtrlFilters[OF_Resp_Force] != 0)  {
-            for (i=0; i<(*sizeCtrl)(OF_Resp_Force); i++)
-                (*ctrlForce)(i) = theCtrlFilters[OF_Resp_Force]->filtering((*ctrlForce)(i));
-        }
+        if (theCtrlFilters[OF_Resp_Force] != 0)
+            theCtrlFilters[OF_Resp_Force]->filtering(&(*ctrlForce)(0),
+                &(*ctrlForce)(0), (*sizeCtrl)(OF_Resp_Force));
     }
     if (time != 0)  {
         *ctrlTime = *time;
-        if (theCtrlFilters[OF_Resp_Time] != 0)  {
-            for (i=0; i<(*sizeCtrl)(OF_Resp_Time); i++)
-                (*ctrlTime)(i) = theCtrlFilters[OF_Resp_Time]->filtering((*ctrlTime)(i));
-        }
+        if (theCtrlFilters[OF_Resp_Time] != 0)
+            theCtrlFilters[OF_Resp_Time]->filtering(&(*ctrlTime)(0),
+                &(*ctrlTime)(0), (*sizeCtrl)(OF_Resp_Time));
     }
     
+    this->waitForNextStep();
     rValue = this->control();
     
     return rValue;
@@ -321,26 +320,22 @@ int ECSimSimulink::getDaqResponse(Vector* disp,
 {
     this->acquire();
     
-    int i;
     if (disp != 0)  {
-        if (theDaqFilters[OF_Resp_Disp] != 0)  {
-            for (i=0; i<(*sizeDaq)(OF_Resp_Disp); i++)
-                (*daqDisp)(i) = theDaqFilters[OF_Resp_Disp]->filtering((*daqDisp)(i));
-        }
+        if (theDaqFilters[OF_Resp_Disp] != 0)
+            theDaqFilters[OF_Resp_Disp]->filtering(&(*daqDisp)(0),
+                &(*daqDisp)(0), (*sizeDaq)(OF_Resp_Disp));
         *disp = *daqDisp;
     }
     if (force != 0)  {
-        if (theDaqFilters[OF_Resp_Force] != 0)  {
-            for (i=0; i<(*sizeDaq)(OF_Resp_Force); i++)
-                (*daqForce)(i) = theDaqFilters[OF_Resp_Force]->filtering((*daqForce)(i));
-        }
+        if (theDaqFilters[OF_Resp_Force] != 0)
+            theDaqFilters[OF_Resp_Force]->filtering(&(*daqForce)(0),
+                &(*daqForce)(0), (*sizeDaq)(OF_Resp_Force));
         *force = *daqForce;
     }
     if (time != 0)  {
-        if (theDaqFilters[OF_Resp_Time] != 0)  {
-            for (i=0; i<(*sizeDaq)(OF_Resp_Time); i++)
-                (*daqTime)(i) = theDaqFilters[OF_Resp_Time]->filtering((*daqTime)(i));
-        }
+        if (theDaqFilters[OF_Resp_Time] != 0)
+            theDaqFilters[OF_Resp_Time]->filtering(&(*daqTime)(0),
+                &(*daqTime)(0), (*sizeDaq)(OF_Resp_Time));
         *time = *daqTime;
     }
     
@@ -448,6 +443,10 @@ Response* ECSimSimulink::setResponse(const char **argv, int argc,
         theResponse = new ExpControlResponse(this, 6, *daqTime);
     }
     
+    // pacing jitter
+    if (theResponse == 0)
+        theResponse = this->setPacingResponse(argv, argc, output);
+    
     output.endTag();
     
     return theResponse;
@@ -476,7 +475,7 @@ int ECSimSimulink::getResponse(int responseID, Information &info)
         return info.setVector(*daqTime);
         
     default:
-        return -1;
+        return this->ExperimentalControl::getResponse(responseID, info);
     }
 }
 
@@ -509,6 +508,8 @@ void ECSimSimulink::Print(OPS_Stream &s, int flag)
 
 int ECSimSimulink::control()
 {
+    ExpTimer timer(OF_Timing_Control);
+    
     // send ctrlDisp
     sData[0] = OF_RemoteTest_setTrialResponse;
     theChannel->sendVector(0, 0, *sendData, 0);
@@ -543,6 +544,8 @@ int ECSimSimulink::control()
 
 int ECSimSimulink::acquire()
 {
+    ExpTimer timer(OF_Timing_Acquire);
+    
     // read displacements and resisting forces until target is reached
     rData[0] = 0;  // atTarget flag
     while (rData[0] != 1)  {
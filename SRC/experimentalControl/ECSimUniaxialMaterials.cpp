@@ -31,16 +31,25 @@
 // ECSimUniaxialMaterials class.
 
 #include "ECSimUniaxialMaterials.h"
+#include <ExpTiming.h>
 
 #include <UniaxialMaterial.h>
 
+// jobs of the worker threads
+enum EC_SimUniaxialMaterialsJob  {
+    EC_jobControl = 1,
+    EC_jobAcquire = 2,
+    EC_jobCommit = 3
+};
+
 
 ECSimUniaxialMaterials::ECSimUniaxialMaterials(int tag,
-    int nummats, UniaxialMaterial **specimen)
+    int nummats, UniaxialMaterial **specimen, int nThreads)
     : ECSimulation(tag),
     numMats(nummats), theSpecimen(0),
     ctrlDisp(0), ctrlVel(0),
-    daqDisp(0), daqVel(0), daqForce(0)
+    daqDisp(0), daqVel(0), daqForce(0),
+    numThreads(nThreads), rValueAll(0), thePool(0)
 {
     if (specimen == 0)  {
         opserr << "ECSimUniaxialMaterials::ECSimUniaxialMaterials() - "
@@ -70,6 +79,14 @@ ECSimUniaxialMaterials::ECSimUniaxialMaterials(int tag,
             exit(OF_ReturnType_failed);
         }
     }
+    
+    // each thread updates at least one material
+    if (numThreads < 1)
+        numThreads = 1;
+    if (numThreads > numMats)
+        numThreads = numMats;
+    rValueAll = new int [numThreads];
+    thePool = new WorkerPool(numThreads);
 }
 
 
@@ -77,7 +94,8 @@ ECSimUniaxialMaterials::ECSimUniaxialMaterials(const ECSimUniaxialMaterials& ec)
     : ECSimulation(ec),
     numMats(0), theSpecimen(0),
     ctrlDisp(0), ctrlVel(0),
-    daqDisp(0), daqVel(0), daqForce(0)
+    daqDisp(0), daqVel(0), daqForce(0),
+    numThreads(ec.numThreads), rValueAll(0), thePool(0)
 {
     // allocate memory for the uniaxial materials
     numMats = ec.numMats;
@@ -102,11 +120,20 @@ ECSimUniaxialMaterials::ECSimUniaxialMaterials(const ECSimUniaxialMaterials& ec)
             exit(OF_ReturnType_failed);
         }
     }
+    
+    rValueAll = new int [numThreads];
+    thePool = new WorkerPool(numThreads);
 }
 
 
 ECSimUniaxialMaterials::~ECSimUniaxialMaterials()
 {
+    // stop the worker threads before the materials are deleted
+    if (thePool != 0)
+        delete thePool;
+    if (rValueAll != 0)
+        delete [] rValueAll;
+    
     // delete memory of materials
     if (theSpecimen != 0)  {
         for (int i=0; i<numMats; i++)
@@ -216,22 +243,21 @@ int ECSimUniaxialMaterials::setTrialResponse(const Vector* disp,
     const Vector* force,
     const Vector* time)
 {
-    int i, rValue = 0;
+    int rValue = 0;
     if (disp != 0)  {
         *ctrlDisp = *disp;
-        if (theCtrlFilters[OF_Resp_Disp] != 0)  {
-            for (i=0; i<(*sizeCtrl)(OF_Resp_Disp); i++)
-                (*ctrlDisp)(i) = theCtrlFilters[OF_Resp_Disp]->filtering((*ctrlDisp)(i));
-        }
+        if (theCtrlFilters[OF_Resp_Disp] != 0)
+            theCtrlFilters[OF_Resp_Disp]->filtering(&(*ctrlDisp)(0),
+                &(*ctrlDisp)(0), (*sizeCtrl)(OF_Resp_Disp));
     }
     if (vel != 0)  {
         *ctrlVel = *vel;
-        if (theCtrlFilters[OF_Resp_Vel] != 0)  {
-            for (i=0; i<(*sizeCtrl)(OF_Resp_Vel); i++)
-                (*ctrlVel)(i) = theCtrlFilters[OF_Resp_Vel]->filtering((*ctrlVel)(i));
-        }
+        if (theCtrlFilters[OF_Resp_Vel] != 0)
+            theCtrlFilters[OF_Resp_Vel]->filtering(&(*ctrlVel)(0),
+                &(*ctrlVel)(0), (*sizeCtrl)(OF_Resp_Vel));
     }
     
+    this->waitForNextStep();
     rValue = this->control();
     
     return rValue;
@@ -246,26 +272,22 @@ int ECSimUniaxialMaterials::getDaqResponse(Vector* disp,
 {
     this->acquire();
     
-    int i;
     if (disp != 0)  {
-        if (theDaqFilters[OF_Resp_Disp] != 0)  {
-            for (i=0; i<(*sizeDaq)(OF_Resp_Disp); i++)
-                (*daqDisp)(i) = theDaqFilters[OF_Resp_Disp]->filtering((*daqDisp)(i));
-        }
+        if (theDaqFilters[OF_Resp_Disp] != 0)
+            theDaqFilters[OF_Resp_Disp]->filtering(&(*daqDisp)(0),
+                &(*daqDisp)(0), (*sizeDaq)(OF_Resp_Disp));
         *disp = *daqDisp;
     }
     if (vel != 0)  {
-        if (theDaqFilters[OF_Resp_Vel] != 0)  {
-            for (i=0; i<(*sizeDaq)(OF_Resp_Vel); i++)
-                (*daqVel)(i) = theDaqFilters[OF_Resp_Vel]->filtering((*daqVel)(i));
-        }
+        if (theDaqFilters[OF_Resp_Vel] != 0)
+            theDaqFilters[OF_Resp_Vel]->filtering(&(*daqVel)(0),
+                &(*daqVel)(0), (*sizeDaq)(OF_Resp_Vel));
         *vel = *daqVel;
     }
     if (force != 0)  {
-        if (theDaqFilters[OF_Resp_Force] != 0)  {
-            for (i=0; i<(*sizeDaq)(OF_Resp_Force); i++)
-                (*daqForce)(i) = theDaqFilters[OF_Resp_Force]->filtering((*daqForce)(i));
-        }
+        if (theDaqFilters[OF_Resp_Force] != 0)
+            theDaqFilters[OF_Resp_Force]->filtering(&(*daqForce)(0),
+                &(*daqForce)(0), (*sizeDaq)(OF_Resp_Force));
         *force = *daqForce;
     }
     
@@ -275,13 +297,7 @@ int ECSimUniaxialMaterials::getDaqResponse(Vector* disp,
 
 int ECSimUniaxialMaterials::commitState()
 {
-    int rValue = 0;
-
-    for (int i=0; i<numMats; i++)  {
-        rValue += theSpecimen[i]->commitState();
-    }
-    
-    return rValue;
+    return this->runJob(EC_jobCommit);
 }
 
 
@@ -366,6 +382,10 @@ Response* ECSimUniaxialMaterials::setResponse(const char **argv, int argc,
         theResponse = new ExpControlResponse(this, 5, *daqForce);
     }
     
+    // pacing jitter
+    if (theResponse == 0)
+        theResponse = this->setPacingResponse(argv, argc, output);
+    
     output.endTag();
     
     return theResponse;
@@ -391,7 +411,7 @@ int ECSimUniaxialMaterials::getResponse(int responseID, Information &info)
         return info.setVector(*daqForce);
         
     default:
-        return -1;
+        return this->ExperimentalControl::getResponse(responseID, info);
     }
 }
 
@@ -404,6 +424,8 @@ void ECSimUniaxialMaterials::Print(OPS_Stream &s, int flag)
     for (int i=0; i<numMats; i++)  {
         s << "*   UniaxialMaterial: " << theSpecimen[i]->getTag() << endln;
     }
+    if (numThreads > 1)
+        s << "*   numThreads: " << numThreads << endln;
     s << "*   ctrlFilters:";
     for (int i=0; i<OF_Resp_All; i++)  {
         if (theCtrlFilters[i] != 0)
@@ -426,23 +448,65 @@ void ECSimUniaxialMaterials::Print(OPS_Stream &s, int flag)
 
 int ECSimUniaxialMaterials::control()
 {
-    int rValue = 0;
+    ExpTimer timer(OF_Timing_Control);
     
-    for (int i=0; i<numMats; i++)  {
-        rValue += theSpecimen[i]->setTrialStrain((*ctrlDisp)(i),(*ctrlVel)(i));
-    }
+    return this->runJob(EC_jobControl);
+}
+
+
+int ECSimUniaxialMaterials::acquire()
+{
+    ExpTimer timer(OF_Timing_Acquire);
+    
+    this->runJob(EC_jobAcquire);
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ECSimUniaxialMaterials::runJob(int job)
+{
+    // thread k updates block k and the pool returns when all
+    // threads are done
+    thePool->run([this, job](int k)  {
+        this->runBlock(job, k);
+    });
+    
+    int rValue = 0;
+    for (int k=0; k<numThreads; k++)
+        rValue += rValueAll[k];
     
     return rValue;
 }
 
 
-int ECSimUniaxialMaterials::acquire()
+void ECSimUniaxialMaterials::runBlock(int job, int k)
 {
-    for (int i=0; i<numMats; i++)  {
-        (*daqDisp)(i)  = theSpecimen[i]->getStrain();
-        (*daqVel)(i)   = theSpecimen[i]->getStrainRate();
-        (*daqForce)(i) = theSpecimen[i]->getStress();
+    // thread k owns the contiguous block of materials [iStart,iEnd)
+    int iStart = (int)((long)k*numMats/numThreads);
+    int iEnd = (int)((long)(k+1)*numMats/numThreads);
+    
+    int i, rValue = 0;
+    if (job == EC_jobControl)  {
+        double *disp = &(*ctrlDisp)(0);
+        double *vel = &(*ctrlVel)(0);
+        for (i=iStart; i<iEnd; i++)
+            rValue += theSpecimen[i]->setTrialStrain(disp[i], vel[i]);
+    }
+    else if (job == EC_jobAcquire)  {
+        double *disp = &(*daqDisp)(0);
+        double *vel = &(*daqVel)(0);
+        double *force = &(*daqForce)(0);
+        for (i=iStart; i<iEnd; i++)  {
+            disp[i]  = theSpecimen[i]->getStrain();
+            vel[i]   = theSpecimen[i]->getStrainRate();
+            force[i] = theSpecimen[i]->getStress();
+        }
+    }
+    else if (job == EC_jobCommit)  {
+        for (i=iStart; i<iEnd; i++)
+            rValue += theSpecimen[i]->commitState();
     }
     
-    return OF_ReturnType_completed;
+    rValueAll[k] = rValue;
 }
@@ -34,9 +34,17 @@
 // ECSimUniaxialMaterials. ECSimUniaxialMaterials is a controller
 // class for simulating the behavior of a specimen using any number
 // of OpenSees uniaxial material objects. The materials are uncoupled.
+// For large numbers of materials they are optionally updated in
+// parallel by a WorkerPool. Each thread owns a contiguous
+// block of the materials and of the ctrl and daq arrays, so that every
+// material is updated by the same calls as in the serial case and the
+// response does not depend on the number of threads. Materials that
+// keep data in static variables must not be updated in parallel.
 
 #include "ECSimulation.h"
 
+#include <WorkerPool.h>
+
 class UniaxialMaterial;
 
 class ECSimUniaxialMaterials : public ECSimulation
@@ -44,7 +52,8 @@ class ECSimUniaxialMaterials : public ECSimulation
 public:
     // constructors
     ECSimUniaxialMaterials(int tag, int numMats,
-        UniaxialMaterial **theSpecimen);
+        UniaxialMaterial **theSpecimen,
+        int numThreads = 1);
     ECSimUniaxialMaterials(const ECSimUniaxialMaterials& ec);
     
     // destructor
@@ -86,11 +95,19 @@ protected:
     virtual int acquire();
 
 private:
+    // methods to update the blocks of materials
+    int runJob(int job);
+    void runBlock(int job, int k);
+    
     int numMats;                     // number of uniaxial materials
     UniaxialMaterial **theSpecimen;  // uniaxial materials
     
     Vector *ctrlDisp, *ctrlVel;
     Vector *daqDisp, *daqVel, *daqForce;
+    
+    int numThreads;         // number of threads incl. the calling thread
+    int *rValueAll;         // summed return values of each block
+    WorkerPool *thePool;    // threads that update the blocks
 };
 
 #endif
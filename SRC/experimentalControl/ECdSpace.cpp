@@ -26,6 +26,7 @@
 // Description: This file contains the implementation of the ECdSpace class.
 
 #include "ECdSpace.h"
+#include <ExpTiming.h>
 #include <ExperimentalCP.h>
 
 
@@ -429,6 +430,8 @@ int ECdSpace::setTrialResponse(
         }
     }
     
+    this->waitForNextStep();
+    
     // send control signal array to controller
     k += this->control();
     
@@ -533,6 +536,10 @@ Response* ECdSpace::setResponse(const char **argv, int argc,
         theResponse = new ExpControlResponse(this, 2,
             Vector(numDaqSignals));
     }
+    // pacing jitter
+    if (theResponse == 0)
+        theResponse = this->setPacingResponse(argv, argc, output);
+    
     output.endTag();
     
     return theResponse;
@@ -553,7 +560,7 @@ int ECdSpace::getResponse(int responseID, Information &info)
         return info.setVector(resp);
         
     default:
-        return OF_ReturnType_failed;
+        return this->ExperimentalControl::getResponse(responseID, info);
     }
 }
 
@@ -590,6 +597,8 @@ void ECdSpace::Print(OPS_Stream &s, int flag)
 
 int ECdSpace::control()
 {
+    ExpTimer timer(OF_Timing_Control);
+    
     // send ctrlSignal
     error = DS_write_64(board_index, ctrlSignalId, numCtrlSignals, (UInt64 *)ctrlSignal);
     if (error != DS_NO_ERROR)  {
@@ -649,6 +658,8 @@ int ECdSpace::control()
 
 int ECdSpace::acquire()
 {
+    ExpTimer timer(OF_Timing_Acquire);
+    
     // wait until target is reached
     atTarget = 0;
     while (atTarget != 1)  {
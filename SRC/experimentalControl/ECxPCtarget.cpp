@@ -26,6 +26,7 @@
 // Description: This file contains the implementation of the ECxPCtarget class.
 
 #include "ECxPCtarget.h"
+#include <ExpTiming.h>
 #include <ExperimentalCP.h>
 
 #include <windows.h>
@@ -542,6 +543,8 @@ int ECxPCtarget::setTrialResponse(
         }
     }
     
+    this->waitForNextStep();
+    
     // send control signal array to controller
     k += this->control();
     
@@ -646,6 +649,10 @@ Response* ECxPCtarget::setResponse(const char **argv, int argc,
         theResponse = new ExpControlResponse(this, 2,
             Vector(numDaqSignals));
     }
+    // pacing jitter
+    if (theResponse == 0)
+        theResponse = this->setPacingResponse(argv, argc, output);
+    
     output.endTag();
     
     return theResponse;
@@ -666,7 +673,7 @@ int ECxPCtarget::getResponse(int responseID, Information &info)
         return info.setVector(resp);
         
     default:
-        return OF_ReturnType_failed;
+        return this->ExperimentalControl::getResponse(responseID, info);
     }
 }
 
@@ -705,6 +712,8 @@ void ECxPCtarget::Print(OPS_Stream &s, int flag)
 
 int ECxPCtarget::control()
 {
+    ExpTimer timer(OF_Timing_Control);
+    
     // send ctrlSignal
     xPCSetParam(port, ctrlSignalId, ctrlSignal);
     if (xPCGetLastError())  {
@@ -774,6 +783,8 @@ int ECxPCtarget::control()
 
 int ECxPCtarget::acquire()
 {
+    ExpTimer timer(OF_Timing_Acquire);
+    
     // wait until target is reached
     atTarget = 0;
     while (atTarget != 1)  {
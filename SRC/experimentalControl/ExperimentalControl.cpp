@@ -35,11 +35,16 @@
 
 #include "ExperimentalControl.h"
 
+#include <chrono>
+#include <thread>
+
 
 ExperimentalControl::ExperimentalControl(int tag)
     : TaggedObject(tag),
     sizeCtrl(0), sizeDaq(0),
-    theCtrlFilters(0), theDaqFilters(0)
+    theCtrlFilters(0), theDaqFilters(0),
+    pacingPeriod(0.0), spinTime(0.0), nextDeadline(-1.0),
+    jitterBinWidth(0.0), jitterHist(0), pacingStats(0)
 {
     sizeCtrl = new ID(OF_Resp_All);
     sizeDaq = new ID(OF_Resp_All);
@@ -73,7 +78,9 @@ ExperimentalControl::ExperimentalControl(int tag)
 ExperimentalControl::ExperimentalControl(const ExperimentalControl& ec) 
     : TaggedObject(ec), 
     sizeCtrl(0), sizeDaq(0),
-    theCtrlFilters(0), theDaqFilters(0)
+    theCtrlFilters(0), theDaqFilters(0),
+    pacingPeriod(0.0), spinTime(0.0), nextDeadline(-1.0),
+    jitterBinWidth(0.0), jitterHist(0), pacingStats(0)
 {
     sizeCtrl = new ID(OF_Resp_All);
     sizeDaq = new ID(OF_Resp_All);
@@ -110,6 +117,11 @@ ExperimentalControl::ExperimentalControl(const ExperimentalControl& ec)
         else
             theDaqFilters[i] = 0;
     }
+    
+    // copy the pacing settings but not the recorded jitter
+    if (ec.jitterHist != 0)
+        this->setPacing(ec.pacingPeriod, ec.spinTime,
+            ec.jitterHist->Size(), ec.jitterBinWidth);
 }
 
 
@@ -123,6 +135,10 @@ ExperimentalControl::~ExperimentalControl()
         delete [] theCtrlFilters;
     if (theDaqFilters != 0)
         delete [] theDaqFilters;
+    if (jitterHist != 0)
+        delete jitterHist;
+    if (pacingStats != 0)
+        delete pacingStats;
 }
 
 
@@ -146,7 +162,9 @@ Response* ExperimentalControl::setResponse(const char **argv, int argc,
     output.tag("ExpControlOutput");
     output.attr("ctrlType",this->getClassType());
     output.attr("ctrlTag",this->getTag());
-        
+    
+    theResponse = this->setPacingResponse(argv, argc, output);
+    
     output.endTag();
     
     return theResponse;
@@ -155,8 +173,21 @@ Response* ExperimentalControl::setResponse(const char **argv, int argc,
 
 int ExperimentalControl::getResponse(int responseID, Information &info)
 {
-    // each subclass must implement its own response
-    return -1;
+    // each subclass must implement its own response,
+    // only the pacing responses are handled here
+    switch (responseID)  {
+    case 101:  // last step jitter
+        return info.setDouble((*pacingStats)(2));
+        
+    case 102:  // jitter histogram
+        return info.setVector(*jitterHist);
+        
+    case 103:  // pacing statistics
+        return info.setVector(*pacingStats);
+        
+    default:
+        return -1;
+    }
 }
 
 
@@ -204,6 +235,21 @@ void ExperimentalControl::setDaqFilter(ExperimentalSignalFilter* theFilter,
 }
 
 
+int ExperimentalControl::setFilterSizes()
+{
+    // tell the filters how many channels they process
+    int rValue = 0;
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (theCtrlFilters[i] != 0 && (*sizeCtrl)(i) > 0)
+            rValue += theCtrlFilters[i]->setSize((*sizeCtrl)(i));
+        if (theDaqFilters[i] != 0 && (*sizeDaq)(i) > 0)
+            rValue += theDaqFilters[i]->setSize((*sizeDaq)(i));
+    }
+    
+    return rValue;
+}
+
+
 const ID& ExperimentalControl::getSizeCtrl()
 {
     return *sizeCtrl;
@@ -216,9 +262,143 @@ const ID& ExperimentalControl::getSizeDaq()
 }
 
 
-void ExperimentalControl::sleep(const clock_t wait)
+int ExperimentalControl::setPacing(double period, double spin,
+    int numBins, double binWidth)
+{
+    if (period < 0.0 || spin < 0.0 || numBins < 1 || binWidth <= 0.0)  {
+        opserr << "ExperimentalControl::setPacing() - "
+            << "invalid pacing parameters.\n";
+        return OF_ReturnType_failed;
+    }
+    pacingPeriod = period;
+    spinTime = spin;
+    jitterBinWidth = binWidth;
+    nextDeadline = -1.0;
+    
+    if (jitterHist != 0)
+        delete jitterHist;
+    jitterHist = new Vector(numBins);
+    if (pacingStats == 0)
+        pacingStats = new Vector(5);
+    if (jitterHist == 0 || pacingStats == 0)  {
+        opserr << "ExperimentalControl::setPacing() - "
+            << "failed to create jitter vectors.\n";
+        exit(OF_ReturnType_failed);
+    }
+    pacingStats->Zero();
+    
+    return OF_ReturnType_completed;
+}
+
+
+void ExperimentalControl::sleep(const int wait)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(wait));
+}
+
+
+int ExperimentalControl::waitForNextStep()
+{
+    if (pacingPeriod <= 0.0)
+        return 0;
+    
+    // the first step only sets the time reference
+    double now = this->getMonotonicTime();
+    if (nextDeadline < 0.0)  {
+        nextDeadline = now + pacingPeriod;
+        return 0;
+    }
+    
+    // a step that starts after its deadline is an overrun, in which
+    // case the deadlines are shifted instead of trying to catch up
+    double jitter;
+    if (now > nextDeadline)  {
+        jitter = now - nextDeadline;
+        (*pacingStats)(1) += 1.0;
+        nextDeadline = now + pacingPeriod;
+    } else  {
+        this->sleepUntil(nextDeadline);
+        jitter = this->getMonotonicTime() - nextDeadline;
+        nextDeadline += pacingPeriod;
+    }
+    
+    // record the jitter, the last bin collects all larger values
+    int numBins = jitterHist->Size();
+    int bin = (int)(jitter/jitterBinWidth);
+    if (bin >= numBins)
+        bin = numBins - 1;
+    (*jitterHist)(bin) += 1.0;
+    
+    double numSteps = (*pacingStats)(0) + 1.0;
+    (*pacingStats)(0) = numSteps;
+    (*pacingStats)(2) = jitter;
+    if (jitter > (*pacingStats)(3))
+        (*pacingStats)(3) = jitter;
+    (*pacingStats)(4) += (jitter - (*pacingStats)(4))/numSteps;
+    
+    return 0;
+}
+
+
+void ExperimentalControl::sleepUntil(double deadline)
+{
+    // let the os scheduler do the coarse wait and
+    // only spin for the last part to hit the deadline
+    double wait = deadline - spinTime - this->getMonotonicTime();
+    if (wait > 0.0)
+        std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+    
+    while (this->getMonotonicTime() < deadline);
+}
+
+
+double ExperimentalControl::getMonotonicTime()
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+Response* ExperimentalControl::setPacingResponse(const char **argv,
+    int argc, OPS_Stream &output)
 {
-    clock_t goal;
-    goal = wait + clock();
-    while (goal>clock());
+    int i;
+    char outputData[15];
+    Response *theResponse = 0;
+    
+    if (jitterHist == 0)
+        return theResponse;
+    
+    // last step jitter
+    if (strcmp(argv[0],"jitter") == 0 ||
+        strcmp(argv[0],"stepJitter") == 0)
+    {
+        output.tag("ResponseType","stepJitter");
+        theResponse = new ExpControlResponse(this, 101, 0.0);
+    }
+    
+    // jitter histogram
+    else if (strcmp(argv[0],"jitterHist") == 0 ||
+        strcmp(argv[0],"jitterHistogram") == 0)
+    {
+        for (i=0; i<jitterHist->Size(); i++)  {
+            sprintf(outputData,"jitterBin%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 102, *jitterHist);
+    }
+    
+    // pacing statistics
+    else if (strcmp(argv[0],"pacing") == 0 ||
+        strcmp(argv[0],"pacingStats") == 0)
+    {
+        output.tag("ResponseType","numSteps");
+        output.tag("ResponseType","numOverruns");
+        output.tag("ResponseType","lastJitter");
+        output.tag("ResponseType","maxJitter");
+        output.tag("ResponseType","meanJitter");
+        theResponse = new ExpControlResponse(this, 103, *pacingStats);
+    }
+    
+    return theResponse;
 }
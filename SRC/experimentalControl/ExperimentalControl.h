@@ -90,17 +90,31 @@ public:
         int respType);
     void setDaqFilter(ExperimentalSignalFilter* theFilter,
         int respType);
+    int setFilterSizes();
     
     const ID& getSizeCtrl();
     const ID& getSizeDaq();
     
+    // public method to pace the control steps at a fixed rate
+    int setPacing(double period, double spinTime = 0.0,
+        int numBins = 50, double binWidth = 0.0001);
+    
 protected:
     // protected methods to set and to get response
     virtual int control() = 0;
     virtual int acquire() = 0;
     
     // method to pause for wait msec
-    void sleep(const clock_t wait);
+    void sleep(const int wait);
+    
+    // methods to pace the control steps
+    int waitForNextStep();
+    void sleepUntil(double deadline);
+    double getMonotonicTime();
+    
+    // methods to record the pacing jitter
+    Response *setPacingResponse(const char **argv, int argc,
+        OPS_Stream &output);
     
     // size of ctrl/daq data
     // sizeCtrl/Daq[0]:disp, [1]:vel, [2]:accel, [3]:force, [4]:time
@@ -110,6 +124,15 @@ protected:
     // experimental signal filters
     ExperimentalSignalFilter **theCtrlFilters;
     ExperimentalSignalFilter **theDaqFilters;
+    
+private:
+    // pacing of the control steps (times in sec)
+    double pacingPeriod;    // period between two control steps
+    double spinTime;        // time to spin before each deadline
+    double nextDeadline;    // absolute deadline of the next step
+    double jitterBinWidth;  // bin width of the jitter histogram
+    Vector *jitterHist;     // histogram of the step jitter
+    Vector *pacingStats;    // numSteps, numOverruns, last, max, mean jitter
 };
 
 #endif
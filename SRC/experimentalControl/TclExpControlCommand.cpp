@@ -33,6 +33,7 @@
 #include <elementAPI.h>
 
 #include <ECSimUniaxialMaterials.h>
+#include <ECSimPredictorCorrector.h>
 //#include <ECSimUniaxialMaterialsForce.h>
 #include <ECSimDomain.h>
 #include <ECSimFEAdapter.h>
@@ -154,11 +155,13 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
             opserr << "Want: expControl SimUniaxialMaterials tag matTags "
-                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
+                << "<-parallel numThreads> "
+                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)> "
+                << "<-pacing period <-spin time> <-jitterHist numBins binWidth>>\n";
             return TCL_ERROR;
         }
         
-        int i, matTag, numMats = 0;
+        int i, matTag, numMats = 0, numThreads = 1;
         
         argi = 2;
         if (Tcl_GetInt(interp, argv[argi], &tag) != TCL_OK)  {
@@ -168,8 +171,10 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
         argi++;
         // now read the number of materials
         while (argi+numMats < argc &&
+            strcmp(argv[argi+numMats],"-parallel") != 0 &&
             strcmp(argv[argi+numMats],"-ctrlFilters") != 0 &&
-            strcmp(argv[argi+numMats],"-daqFilters") != 0)  {
+            strcmp(argv[argi+numMats],"-daqFilters") != 0 &&
+            strcmp(argv[argi+numMats],"-pacing") != 0)  {
                 numMats++;
         }
         if (numMats == 0)  {
@@ -200,9 +205,138 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             }
             argi++;
         }
+        // check for optional number of threads
+        if (argi+1 < argc && strcmp(argv[argi],"-parallel") == 0)  {
+            if (Tcl_GetInt(interp, argv[argi+1], &numThreads) != TCL_OK ||
+                numThreads < 1)  {
+                opserr << "WARNING invalid numThreads\n";
+                opserr << "expControl SimUniaxialMaterials " << tag << endln;
+                return TCL_ERROR;
+            }
+            argi += 2;
+        }
         
         // parsing was successful, allocate the control
-        theControl = new ECSimUniaxialMaterials(tag, numMats, theSpecimen);
+        theControl = new ECSimUniaxialMaterials(tag, numMats, theSpecimen,
+            numThreads);
+        
+        // cleanup dynamic memory
+        if (theSpecimen != 0)
+            delete [] theSpecimen;
+    }
+    
+    // ----------------------------------------------------------------------------	
+    else if (strcmp(argv[1],"SimPredictorCorrector") == 0)  {
+        if (argc < 5)  {
+            opserr << "WARNING invalid number of arguments\n";
+            printCommand(argc,argv);
+            opserr << "Want: expControl SimPredictorCorrector tag dtInt matTags "
+                << "<-sampleRate rate> <-order n> <-predFact fact> "
+                << "<-servoFreq freq> <-delay numSamples> <-timeOut time> "
+                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)> "
+                << "<-pacing period <-spin time> <-jitterHist numBins binWidth>>\n";
+            return TCL_ERROR;
+        }
+        
+        int i, matTag, numMats = 0;
+        double dtInt, sampleRate = 1024.0, predFact = 0.6;
+        double servoFreq = 0.0, timeOut = 0.0;
+        int order = 3, numDelay = 0;
+        
+        argi = 2;
+        if (Tcl_GetInt(interp, argv[argi], &tag) != TCL_OK)  {
+            opserr << "WARNING invalid expControl SimPredictorCorrector tag\n";
+            return TCL_ERROR;
+        }
+        argi++;
+        if (Tcl_GetDouble(interp, argv[argi], &dtInt) != TCL_OK ||
+            dtInt <= 0.0)  {
+            opserr << "WARNING invalid dtInt\n";
+            opserr << "expControl SimPredictorCorrector " << tag << endln;
+            return TCL_ERROR;
+        }
+        argi++;
+        // now read the number of materials
+        while (argi+numMats < argc &&
+            strcmp(argv[argi+numMats],"-sampleRate") != 0 &&
+            strcmp(argv[argi+numMats],"-order") != 0 &&
+            strcmp(argv[argi+numMats],"-predFact") != 0 &&
+            strcmp(argv[argi+numMats],"-servoFreq") != 0 &&
+            strcmp(argv[argi+numMats],"-delay") != 0 &&
+            strcmp(argv[argi+numMats],"-timeOut") != 0 &&
+            strcmp(argv[argi+numMats],"-ctrlFilters") != 0 &&
+            strcmp(argv[argi+numMats],"-daqFilters") != 0 &&
+            strcmp(argv[argi+numMats],"-pacing") != 0)  {
+                numMats++;
+        }
+        if (numMats == 0)  {
+            opserr << "WARNING no uniaxial materials specified\n";
+            opserr << "expControl SimPredictorCorrector " << tag << endln;
+            return TCL_ERROR;
+        }
+        // create the array to hold the uniaxial materials
+        UniaxialMaterial **theSpecimen = new UniaxialMaterial* [numMats];
+        if (theSpecimen == 0)  {
+            opserr << "WARNING out of memory\n";
+            opserr << "expControl SimPredictorCorrector " << tag << endln;
+            return TCL_ERROR;
+        }
+        for (i=0; i<numMats; i++)  {
+            theSpecimen[i] = 0;
+            if (Tcl_GetInt(interp, argv[argi], &matTag) != TCL_OK)  {
+                opserr << "WARNING invalid matTag\n";
+                opserr << "expControl SimPredictorCorrector " << tag << endln;
+                delete [] theSpecimen;
+                return TCL_ERROR;
+            }
+            theSpecimen[i] = OPS_GetUniaxialMaterial(matTag);
+            if (theSpecimen[i] == 0)  {
+                opserr << "WARNING uniaxial material not found\n";
+                opserr << "uniaxialMaterial " << matTag << endln;
+                opserr << "expControl SimPredictorCorrector " << tag << endln;
+                delete [] theSpecimen;
+                return TCL_ERROR;
+            }
+            argi++;
+        }
+        // check for optional parameters of the simulated target
+        while (argi+1 < argc &&
+            strcmp(argv[argi],"-ctrlFilters") != 0 &&
+            strcmp(argv[argi],"-daqFilters") != 0 &&
+            strcmp(argv[argi],"-pacing") != 0)  {
+            int rValue = TCL_OK;
+            if (strcmp(argv[argi],"-sampleRate") == 0)
+                rValue = Tcl_GetDouble(interp, argv[argi+1], &sampleRate);
+            else if (strcmp(argv[argi],"-order") == 0)
+                rValue = Tcl_GetInt(interp, argv[argi+1], &order);
+            else if (strcmp(argv[argi],"-predFact") == 0)
+                rValue = Tcl_GetDouble(interp, argv[argi+1], &predFact);
+            else if (strcmp(argv[argi],"-servoFreq") == 0)
+                rValue = Tcl_GetDouble(interp, argv[argi+1], &servoFreq);
+            else if (strcmp(argv[argi],"-delay") == 0)
+                rValue = Tcl_GetInt(interp, argv[argi+1], &numDelay);
+            else if (strcmp(argv[argi],"-timeOut") == 0)
+                rValue = Tcl_GetDouble(interp, argv[argi+1], &timeOut);
+            else
+                break;
+            if (rValue != TCL_OK)  {
+                opserr << "WARNING invalid " << argv[argi]+1 << endln;
+                opserr << "expControl SimPredictorCorrector " << tag << endln;
+                delete [] theSpecimen;
+                return TCL_ERROR;
+            }
+            argi += 2;
+        }
+        // by default allow ten integration steps for the handshake
+        if (timeOut <= 0.0)  {
+            timeOut = 10.0*dtInt;
+            if (timeOut < 1.0)
+                timeOut = 1.0;
+        }
+        
+        // parsing was successful, allocate the control
+        theControl = new ECSimPredictorCorrector(tag, numMats, theSpecimen,
+            dtInt, sampleRate, order, predFact, servoFreq, numDelay, timeOut);
         
         // cleanup dynamic memory
         if (theSpecimen != 0)
@@ -215,7 +349,8 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
             opserr << "Want: expControl SimUniaxialMaterialsForce tag matTags "
-                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
+                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)> "
+                << "<-pacing period <-spin time> <-jitterHist numBins binWidth>>\n";
             return TCL_ERROR;
         }
         
@@ -230,7 +365,8 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
         // now read the number of materials
         while (argi+numMats < argc &&
             strcmp(argv[argi+numMats],"-ctrlFilters") != 0 &&
-            strcmp(argv[argi+numMats],"-daqFilters") != 0)  {
+            strcmp(argv[argi+numMats],"-daqFilters") != 0 &&
+            strcmp(argv[argi+numMats],"-pacing") != 0)  {
                 numMats++;
         }
         if (numMats == 0)  {
@@ -276,12 +412,15 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
             opserr << "Want: expControl SimDomain tag -trialCP cpTags -outCP cpTags "
-                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
+                << "<-subSteps numSubSteps> "
+                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)> "
+                << "<-pacing period <-spin time> <-jitterHist numBins binWidth>>\n";
             return TCL_ERROR;
         }
         
         int i, cpTag;
         int numTrialCPs = 0, numOutCPs = 0;
+        int numSubSteps = 1;
         
         argi = 2;
         if (Tcl_GetInt(interp, argv[argi], &tag) != TCL_OK)  {
@@ -334,8 +473,10 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
         }
         argi++;
         while (argi+numOutCPs < argc &&
+            strcmp(argv[argi+numOutCPs],"-subSteps") != 0 &&
             strcmp(argv[argi+numOutCPs],"-ctrlFilters") != 0 &&
-            strcmp(argv[argi+numOutCPs],"-daqFilters") != 0)  {
+            strcmp(argv[argi+numOutCPs],"-daqFilters") != 0 &&
+            strcmp(argv[argi+numOutCPs],"-pacing") != 0)  {
                 numOutCPs++;
         }
         if (numOutCPs == 0)  {
@@ -366,10 +507,20 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             }
             argi++;
         }
+        // check for optional number of substeps
+        if (argi+1 < argc && strcmp(argv[argi],"-subSteps") == 0)  {
+            if (Tcl_GetInt(interp, argv[argi+1], &numSubSteps) != TCL_OK ||
+                numSubSteps < 1)  {
+                opserr << "WARNING invalid numSubSteps\n";
+                opserr << "expControl SimDomain " << tag << endln;
+                return TCL_ERROR;
+            }
+            argi += 2;
+        }
         
         // parsing was successful, allocate the control
         theControl = new ECSimDomain(tag, numTrialCPs, trialCPs,
-            numOutCPs, outCPs, theDomain);
+            numOutCPs, outCPs, theDomain, numSubSteps);
     }
     
     // ----------------------------------------------------------------------------	
@@ -378,7 +529,8 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
             opserr << "Want: expControl SimFEAdapter tag ipAddr ipPort -trialCP cpTags -outCP cpTags "
-                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
+                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)> "
+                << "<-pacing period <-spin time> <-jitterHist numBins binWidth>>\n";
             return TCL_ERROR;
         }
         
@@ -449,6 +601,7 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
         while (argi+numOutCPs < argc &&
             strcmp(argv[argi+numOutCPs],"-ctrlFilters") != 0 &&
             strcmp(argv[argi+numOutCPs],"-daqFilters") != 0 &&
+            strcmp(argv[argi+numOutCPs],"-pacing") != 0 &&
             strcmp(argv[argi+numOutCPs],"-relTrial") != 0 &&
             strcmp(argv[argi+numOutCPs],"-relativeTrial") != 0 &&
             strcmp(argv[argi+numOutCPs],"-useRelTrial") != 0 &&
@@ -504,7 +657,8 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
             opserr << "Want: expControl SimSimulink tag ipAddr ipPort "
-                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
+                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)> "
+                << "<-pacing period <-spin time> <-jitterHist numBins binWidth>>\n";
             return TCL_ERROR;
         }
         
@@ -537,7 +691,8 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
             opserr << "Want: expControl GenericTCP tag ipAddr ipPort -ctrlModes (5 mode) -daqModes (5 mode) "
-                << "<-initFile fileName> <-ssl> <-udp> <-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
+                << "<-initFile fileName> <-ssl> <-udp> <-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)> "
+                << "<-pacing period <-spin time> <-jitterHist numBins binWidth>>\n";
             return TCL_ERROR;
         }
         
@@ -617,7 +772,8 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
             opserr << "Want: expControl dSpace tag boardName -trialCP cpTags -outCP cpTags "
-                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
+                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)> "
+                << "<-pacing period <-spin time> <-jitterHist numBins binWidth>>\n";
             return TCL_ERROR;
         }
         
@@ -680,7 +836,8 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
         argi++;
         while (argi+numOutCPs < argc &&
             strcmp(argv[argi+numOutCPs],"-ctrlFilters") != 0 &&
-            strcmp(argv[argi+numOutCPs],"-daqFilters") != 0)  {
+            strcmp(argv[argi+numOutCPs],"-daqFilters") != 0 &&
+            strcmp(argv[argi+numOutCPs],"-pacing") != 0)  {
                 numOutCPs++;
         }
         if (numOutCPs == 0)  {
@@ -723,7 +880,8 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
             opserr << "Want: expControl MTSCsi tag configFileName rampTime <-useRelTrial> -trialCP cpTags -outCP cpTags"
-                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
+                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)> "
+                << "<-pacing period <-spin time> <-jitterHist numBins binWidth>>\n";
             return TCL_ERROR;
         }
         
@@ -795,6 +953,7 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
         while (argi+numOutCPs < argc &&
             strcmp(argv[argi+numOutCPs],"-ctrlFilters") != 0 &&
             strcmp(argv[argi+numOutCPs],"-daqFilters") != 0 &&
+            strcmp(argv[argi+numOutCPs],"-pacing") != 0 &&
             strcmp(argv[argi+numOutCPs],"-relTrial") != 0 &&
             strcmp(argv[argi+numOutCPs],"-relativeTrial") != 0 &&
             strcmp(argv[argi+numOutCPs],"-useRelTrial") != 0 &&
@@ -850,7 +1009,8 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
             opserr << "Want: expControl NIEseries tag device "
-                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
+                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)> "
+                << "<-pacing period <-spin time> <-jitterHist numBins binWidth>>\n";
             return TCL_ERROR;
         }
         
@@ -881,7 +1041,8 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
             opserr << "Want: expControl xPCtarget tag ipAddr ipPort appFile -trialCP cpTags -outCP cpTags "
-                << "<-timeOut t> <-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
+                << "<-timeOut t> <-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)> "
+                << "<-pacing period <-spin time> <-jitterHist numBins binWidth>>\n";
             return TCL_ERROR;
         }
         
@@ -950,7 +1111,8 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
         argi++;
         while (argi+numOutCPs < argc &&
             strcmp(argv[argi+numOutCPs],"-ctrlFilters") != 0 &&
-            strcmp(argv[argi+numOutCPs],"-daqFilters") != 0)  {
+            strcmp(argv[argi+numOutCPs],"-daqFilters") != 0 &&
+            strcmp(argv[argi+numOutCPs],"-pacing") != 0)  {
                 numOutCPs++;
         }
         if (numOutCPs == 0)  {
@@ -1002,12 +1164,13 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
             opserr << "Want: expControl LabVIEW tag ipAddr <ipPort> -trialCP cpTags -outCP cpTags "
-                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
+                << "<-timeout msec> <-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)> "
+                << "<-pacing period <-spin time> <-jitterHist numBins binWidth>>\n";
             return TCL_ERROR;
         }
         
         char *ipAddr;
-        int i, cpTag, ipPort = 44000;
+        int i, cpTag, ipPort = 44000, timeout = -1;
         int numTrialCPs = 0, numOutCPs = 0;
         
         argi = 2;
@@ -1035,8 +1198,10 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
         argi++;
         while (argi+numTrialCPs < argc &&
             strcmp(argv[argi+numTrialCPs],"-outCP") != 0 &&
+            strcmp(argv[argi+numTrialCPs],"-timeout") != 0 &&
             strcmp(argv[argi+numTrialCPs],"-ctrlFilters") != 0 &&
-            strcmp(argv[argi+numTrialCPs],"-daqFilters") != 0)  {
+            strcmp(argv[argi+numTrialCPs],"-daqFilters") != 0 &&
+            strcmp(argv[argi+numTrialCPs],"-pacing") != 0)  {
                 numTrialCPs++;
         }
         if (numTrialCPs == 0)  {
@@ -1074,8 +1239,10 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
         }
         argi++;
         while (argi+numOutCPs < argc &&
+            strcmp(argv[argi+numOutCPs],"-timeout") != 0 &&
             strcmp(argv[argi+numOutCPs],"-ctrlFilters") != 0 &&
-            strcmp(argv[argi+numOutCPs],"-daqFilters") != 0)  {
+            strcmp(argv[argi+numOutCPs],"-daqFilters") != 0 &&
+            strcmp(argv[argi+numOutCPs],"-pacing") != 0)  {
                 numOutCPs++;
         }
         if (numOutCPs == 0)  {
@@ -1106,10 +1273,20 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             }
             argi++;
         }
+        // check for receive timeout
+        for (i=argi; i<argc; i++)  {
+            if (strcmp(argv[i], "-timeout") == 0)  {
+                if (i+1 >= argc || Tcl_GetInt(interp, argv[i+1], &timeout) != TCL_OK)  {
+                    opserr << "WARNING invalid timeout\n";
+                    opserr << "expControl LabVIEW " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
+        }
         
         // parsing was successful, allocate the control
         theControl = new ECLabVIEW(tag, numTrialCPs, trialCPs,
-            numOutCPs, outCPs, ipAddr, ipPort);
+            numOutCPs, outCPs, ipAddr, ipPort, timeout);
     }
     
     // ----------------------------------------------------------------------------	
@@ -1118,7 +1295,8 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
             opserr << "Want: expControl SCRAMNet tag memOffset numDOF <-useRelTrial> <-nodeID id>"
-                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
+                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)> "
+                << "<-pacing period <-spin time> <-jitterHist numBins binWidth>>\n";
             return TCL_ERROR;
         }
         
@@ -1176,7 +1354,8 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
             opserr << "Want: expControl SCRAMNetGT tag memOffset numDOF <-useRelTrial> <-nodeID id>"
-                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
+                << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)> "
+                << "<-pacing period <-spin time> <-jitterHist numBins binWidth>>\n";
             return TCL_ERROR;
         }
         
@@ -1291,6 +1470,44 @@ int TclExpControlCommand(ClientData clientData, Tcl_Interp *interp,
         }
     }
     
+    for (i=argi; i<argc; i++)  {
+        if (i+1 < argc && strcmp(argv[i], "-pacing") == 0)  {
+            double period, spinTime = 0.0, binWidth = 0.0001;
+            int numBins = 50;
+            if (Tcl_GetDouble(interp, argv[i+1], &period) != TCL_OK)  {
+                opserr << "WARNING invalid pacing period\n";
+                opserr << "expControl: " << tag << endln;
+                return TCL_ERROR;
+            }
+            for (int j=i+2; j<argc; j++)  {
+                if (j+1 < argc && strcmp(argv[j], "-spin") == 0)  {
+                    if (Tcl_GetDouble(interp, argv[j+1], &spinTime) != TCL_OK)  {
+                        opserr << "WARNING invalid spin time\n";
+                        opserr << "expControl: " << tag << endln;
+                        return TCL_ERROR;
+                    }
+                }
+                else if (j+2 < argc && strcmp(argv[j], "-jitterHist") == 0)  {
+                    if (Tcl_GetInt(interp, argv[j+1], &numBins) != TCL_OK)  {
+                        opserr << "WARNING invalid number of jitter bins\n";
+                        opserr << "expControl: " << tag << endln;
+                        return TCL_ERROR;
+                    }
+                    if (Tcl_GetDouble(interp, argv[j+2], &binWidth) != TCL_OK)  {
+                        opserr << "WARNING invalid jitter bin width\n";
+                        opserr << "expControl: " << tag << endln;
+                        return TCL_ERROR;
+                    }
+                }
+            }
+            if (theControl->setPacing(period, spinTime, numBins, binWidth) < 0)  {
+                opserr << "WARNING could not set pacing\n";
+                opserr << "expControl: " << tag << endln;
+                return TCL_ERROR;
+            }
+        }
+    }
+    
     // now add the control to the modelBuilder
     if (addExperimentalControl(*theControl) < 0)  {
         delete theControl; // invoke the destructor, otherwise mem leak
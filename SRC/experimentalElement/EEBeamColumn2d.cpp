@@ -26,6 +26,7 @@
 // Description: This file contains the implementation of the EEBeamColumn2d class.
 
 #include "EEBeamColumn2d.h"
+#include <ExpTiming.h>
 
 #include <Domain.h>
 #include <Node.h>
@@ -39,6 +40,7 @@
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <SharedMemoryChannel.h>
 
 #include <math.h>
 #include <stdlib.h>
@@ -54,9 +56,9 @@ Vector EEBeamColumn2d::theVector(6);
 // by each object and storing the tags of the end nodes.
 EEBeamColumn2d::EEBeamColumn2d(int tag, int Nd1, int Nd2,
     CrdTransf &coordTransf,
-    ExperimentalSite *site,
+    ExperimentalSite *site, ExperimentalTangentStiff *tang,
     bool iM, int addRay, double r, bool cm)
-    : ExperimentalElement(tag, ELE_TAG_EEBeamColumn2d, site),
+    : ExperimentalElement(tag, ELE_TAG_EEBeamColumn2d, site, tang),
     connectedExternalNodes(2), theCoordTransf(0),
     iMod(iM), addRayleigh(addRay), rho(r), cMass(cm),
     nlGeo(0), L(0.0), theLoad(6), db(0), vb(0), ab(0), t(0),
@@ -145,9 +147,10 @@ EEBeamColumn2d::EEBeamColumn2d(int tag, int Nd1, int Nd2,
 // by each object and storing the tags of the end nodes.
 EEBeamColumn2d::EEBeamColumn2d(int tag, int Nd1, int Nd2,
     CrdTransf &coordTransf,
-    int port, char *machineInetAddr, int ssl, int udp,
-    int dataSize, bool iM, int addRay, double r, bool cm)
-    : ExperimentalElement(tag, ELE_TAG_EEBeamColumn2d),
+    int port, char *machineInetAddr, int ssl, int udp, int shm,
+    int dataSize, ExperimentalTangentStiff *tang,
+    bool iM, int addRay, double r, bool cm)
+    : ExperimentalElement(tag, ELE_TAG_EEBeamColumn2d, NULL, tang),
     connectedExternalNodes(2), theCoordTransf(0),
     iMod(iM), addRayleigh(addRay), rho(r), cMass(cm),
     nlGeo(0), L(0.0), theLoad(6), theChannel(0),
@@ -186,6 +189,12 @@ EEBeamColumn2d::EEBeamColumn2d(int tag, int Nd1, int Nd2,
         else
             theChannel = new UDP_Socket(port, machineInetAddr);
     }
+    else if (shm)  {
+        if (machineInetAddr == 0)
+            theChannel = new SharedMemoryChannel(port, "127.0.0.1");
+        else
+            theChannel = new SharedMemoryChannel(port, machineInetAddr);
+    }
     else  {
         if (machineInetAddr == 0)
             theChannel = new TCP_Socket(port, "127.0.0.1");
@@ -465,7 +474,10 @@ int EEBeamColumn2d::commitState()
 
 int EEBeamColumn2d::update()
 {
+    ExpTimer timer(OF_Timing_Element);
+    
     int rValue = 0;
+    this->startAllocCount();
     
     // get current time
     Domain *theDomain = this->getDomain();
@@ -503,11 +515,10 @@ int EEBeamColumn2d::update()
         (*ab)[2] = -abA(1)+abA(2);
     }
     
-    Vector dbDelta = (*db) - dbLast;
     // do not check time for right now because of transformation constraint
     // handler calling update at beginning of new step when applying load
-    // if (dbDelta.pNorm(0) > DBL_EPSILON || (*t)(0) > tLast)  {
-    if (dbDelta.pNorm(0) > DBL_EPSILON)  {
+    // if (maxAbsDiff(*db, dbLast) > DBL_EPSILON || (*t)(0) > tLast)  {
+    if (maxAbsDiff(*db, dbLast) > DBL_EPSILON)  {
         // set the trial response at the site
         if (theSite != 0)  {
             theSite->setTrialResponse(db, vb, ab, (Vector*)0, t);
@@ -535,6 +546,7 @@ int EEBeamColumn2d::setInitialStiff(const Matrix &kbinit)
         return -1;
     }
     kbInit = kbinit;
+    this->setBasicInitStiff(kbInit);
     
     // transform stiffness from basic sys B to basic sys A
     static Matrix kbAInit(3,3);
@@ -555,7 +567,7 @@ int EEBeamColumn2d::setInitialStiff(const Matrix &kbinit)
 
 const Matrix& EEBeamColumn2d::getTangentStiff()
 {
-    if (firstWarning == true)  {
+    if (firstWarning == true && theTangStiff == 0)  {
         opserr << "\nWARNING EEBeamColumn2d::getTangentStiff() - "
             << "Element: " << this->getTag() << endln
             << "TangentStiff cannot be calculated." << endln
@@ -570,6 +582,11 @@ const Matrix& EEBeamColumn2d::getTangentStiff()
     // get current daq resisting force
     this->getBasicForce();
     
+    // get updated kb matrix (initial stiffness w/o tangent stiffness)
+    if (theTangStiff != 0)
+        this->getBasicDisp();
+    const Matrix &kb = this->getBasicTangentStiff(*dbDaq, *qbDaq);
+    
     // get chord rotation from basic sys A to B
     double alpha = atan2((*db)[1],L+(*db)[0]);
     
@@ -602,15 +619,15 @@ const Matrix& EEBeamColumn2d::getTangentStiff()
         qA(i) += qA0[i];
     
     // transform stiffness from basic sys B to basic sys A
-    static Matrix kbAInit(3,3);
-    kbAInit.Zero();
-    kbAInit(0,0) = kbInit(0,0);
-    kbAInit(1,1) = L*L*kbInit(1,1) + L*(kbInit(1,2)+kbInit(2,1)) + kbInit(2,2);
-    kbAInit(1,2) = -L*kbInit(1,2) - kbInit(2,2);
-    kbAInit(2,1) = -L*kbInit(2,1) - kbInit(2,2);
-    kbAInit(2,2) = kbInit(2,2);
-    
-    return theCoordTransf->getGlobalStiffMatrix(kbAInit, qA);
+    static Matrix kbA(3,3);
+    kbA.Zero();
+    kbA(0,0) = kb(0,0);
+    kbA(1,1) = L*L*kb(1,1) + L*(kb(1,2)+kb(2,1)) + kb(2,2);
+    kbA(1,2) = -L*kb(1,2) - kb(2,2);
+    kbA(2,1) = -L*kb(2,1) - kb(2,2);
+    kbA(2,2) = kb(2,2);
+    
+    return theCoordTransf->getGlobalStiffMatrix(kbA, qA);
 }
 
 
@@ -836,6 +853,8 @@ const Vector& EEBeamColumn2d::getResistingForce()
     // subtract external load
     theVector.addVector(1.0, theLoad, -1.0);
     
+    this->stopAllocCount();
+    
     return theVector;
 }
 
@@ -1022,6 +1041,8 @@ void EEBeamColumn2d::Print(OPS_Stream &s, int flag)
         s << "  CoordTransf: " << theCoordTransf->getTag() << endln;
         if (theSite != 0)
             s << "  ExperimentalSite: " << theSite->getTag() << endln;
+        if (theTangStiff != 0)
+            s << "  ExperimentalTangStiff: " << theTangStiff->getTag() << endln;
         s << "  iMod: " << iMod;
         s << ", addRayleigh: " << addRayleigh << endln;
         s << "  mass per unit length: " << rho;
@@ -1166,6 +1187,14 @@ Response* EEBeamColumn2d::setResponse(const char **argv, int argc,
         theResponse = new ElementResponse(this, 9, Vector(3));
     }
     
+    // tangent stiffness output
+    if (theResponse == 0)
+        theResponse = this->setTangStiffResponse(argv, argc, output);
+    
+    // heap allocations
+    if (theResponse == 0)
+        theResponse = this->setAllocResponse(argv, argc, output);
+    
     output.endTag(); // ElementOutput
     
     return theResponse;
@@ -1228,7 +1257,7 @@ int EEBeamColumn2d::getResponse(int responseID, Information &eleInfo)
         return eleInfo.setVector(this->getBasicAccel());
         
     default:
-        return -1;
+        return this->ExperimentalElement::getResponse(responseID, eleInfo);
     }
 }
 
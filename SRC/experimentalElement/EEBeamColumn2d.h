@@ -49,13 +49,15 @@ public:
     EEBeamColumn2d(int tag, int Nd1, int Nd2,
         CrdTransf &coordTransf,
         ExperimentalSite *site,
+        ExperimentalTangentStiff *tangStiff = 0,
         bool iMod = false, int addRayleigh = 1,
         double rho = 0.0, bool cMass = false);
     EEBeamColumn2d(int tag, int Nd1, int Nd2,
         CrdTransf &coordTransf,
         int port, char *machineInetAddress = 0,
-        int ssl = 0, int udp = 0,
+        int ssl = 0, int udp = 0, int shm = 0,
         int dataSize = OF_Network_dataSize,
+        ExperimentalTangentStiff *tangStiff = 0,
         bool iMod = false, int addRayleigh = 1,
         double rho = 0.0, bool cMass = false);
     
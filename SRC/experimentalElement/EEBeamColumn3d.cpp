@@ -30,6 +30,7 @@
 // Description: This file contains the implementation of the EEBeamColumn3d class.
 
 #include "EEBeamColumn3d.h"
+#include <ExpTiming.h>
 
 #include <Domain.h>
 #include <Node.h>
@@ -43,6 +44,7 @@
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <SharedMemoryChannel.h>
 
 #include <math.h>
 #include <stdlib.h>
@@ -58,9 +60,9 @@ Vector EEBeamColumn3d::theVector(12);
 // by each object and storing the tags of the end nodes.
 EEBeamColumn3d::EEBeamColumn3d(int tag, int Nd1, int Nd2,
     CrdTransf &coordTransf,
-    ExperimentalSite *site,
+    ExperimentalSite *site, ExperimentalTangentStiff *tang,
     bool iM, int addRay, double r, bool cm)
-    : ExperimentalElement(tag, ELE_TAG_EEBeamColumn3d, site),
+    : ExperimentalElement(tag, ELE_TAG_EEBeamColumn3d, site, tang),
     connectedExternalNodes(2), theCoordTransf(0),
     iMod(iM), addRayleigh(addRay), rho(r), cMass(cm),
     nlGeo(0), L(0.0), theLoad(12), db(0), vb(0), ab(0), t(0),
@@ -154,9 +156,10 @@ EEBeamColumn3d::EEBeamColumn3d(int tag, int Nd1, int Nd2,
 // by each object and storing the tags of the end nodes.
 EEBeamColumn3d::EEBeamColumn3d(int tag, int Nd1, int Nd2,
     CrdTransf &coordTransf,
-    int port, char *machineInetAddr, int ssl, int udp,
-    int dataSize, bool iM, int addRay, double r, bool cm)
-    : ExperimentalElement(tag, ELE_TAG_EEBeamColumn3d),
+    int port, char *machineInetAddr, int ssl, int udp, int shm,
+    int dataSize, ExperimentalTangentStiff *tang,
+    bool iM, int addRay, double r, bool cm)
+    : ExperimentalElement(tag, ELE_TAG_EEBeamColumn3d, NULL, tang),
     connectedExternalNodes(2), theCoordTransf(0),
     iMod(iM), addRayleigh(addRay), rho(r), cMass(cm),
     nlGeo(0), L(0.0), theLoad(12), theChannel(0),
@@ -195,6 +198,12 @@ EEBeamColumn3d::EEBeamColumn3d(int tag, int Nd1, int Nd2,
         else
             theChannel = new UDP_Socket(port, machineInetAddr);
     }
+    else if (shm)  {
+        if (machineInetAddr == 0)
+            theChannel = new SharedMemoryChannel(port, "127.0.0.1");
+        else
+            theChannel = new SharedMemoryChannel(port, machineInetAddr);
+    }
     else  {
         if (machineInetAddr == 0)
             theChannel = new TCP_Socket(port, "127.0.0.1");
@@ -477,7 +486,10 @@ int EEBeamColumn3d::commitState()
 
 int EEBeamColumn3d::update()
 {
+    ExpTimer timer(OF_Timing_Element);
+    
     int rValue = 0;
+    this->startAllocCount();
     
     // get current time
     Domain *theDomain = this->getDomain();
@@ -490,7 +502,7 @@ int EEBeamColumn3d::update()
     const Vector &dbA = theCoordTransf->getBasicTrialDisp();
     //const Vector &vbA = theCoordTransf->getBasicTrialVel();    // not implemented yet
     //const Vector &abA = theCoordTransf->getBasicTrialAccel();  // not implemented yet
-    Vector vbA(6), abA(6);
+    static Vector vbA(6), abA(6);
     
     if (nlGeo == 0 || nlGeo == 1)  {
         // transform displacements from basic sys A to basic sys B (linear)
@@ -534,11 +546,10 @@ int EEBeamColumn3d::update()
         (*ab)[5] = */
     }
     
-    Vector dbDelta = (*db) - dbLast;
     // do not check time for right now because of transformation constraint
     // handler calling update at beginning of new step when applying load
-    // if (dbDelta.pNorm(0) > DBL_EPSILON || (*t)(0) > tLast)  {
-    if (dbDelta.pNorm(0) > DBL_EPSILON)  {
+    // if (maxAbsDiff(*db, dbLast) > DBL_EPSILON || (*t)(0) > tLast)  {
+    if (maxAbsDiff(*db, dbLast) > DBL_EPSILON)  {
         // set the trial response at the site
         if (theSite != 0)  {
             theSite->setTrialResponse(db, vb, ab, (Vector*)0, t);
@@ -566,6 +577,7 @@ int EEBeamColumn3d::setInitialStiff(const Matrix& kbinit)
         return -1;
     }
     kbInit = kbinit;
+    this->setBasicInitStiff(kbInit);
     
     // transform stiffness from basic sys B to basic sys A
     static Matrix kbAInit(6,6);
@@ -591,7 +603,7 @@ int EEBeamColumn3d::setInitialStiff(const Matrix& kbinit)
 
 const Matrix& EEBeamColumn3d::getTangentStiff()
 {
-    if (firstWarning == true)  {
+    if (firstWarning == true && theTangStiff == 0)  {
         opserr << "\nWARNING EEBeamColumn3d::getTangentStiff() - "
             << "Element: " << this->getTag() << endln
             << "TangentStiff cannot be calculated." << endln
@@ -606,6 +618,11 @@ const Matrix& EEBeamColumn3d::getTangentStiff()
     // get current daq resisting force
     this->getBasicForce();
     
+    // get updated kb matrix (initial stiffness w/o tangent stiffness)
+    if (theTangStiff != 0)
+        this->getBasicDisp();
+    const Matrix &kb = this->getBasicTangentStiff(*dbDaq, *qbDaq);
+    
     // apply optional initial stiffness modification
     if (iMod == true)
         this->applyIMod();
@@ -641,20 +658,20 @@ const Matrix& EEBeamColumn3d::getTangentStiff()
         qA(i) += qA0[i];
     
     // transform stiffness from basic sys B to basic sys A
-    static Matrix kbAInit(6,6);
-    kbAInit.Zero();
-    kbAInit(0,0) = kbInit(0,0);
-    kbAInit(1,1) = L*L*kbInit(1,1) + L*(kbInit(1,2)+kbInit(2,1)) + kbInit(2,2);
-    kbAInit(1,2) = -L*kbInit(1,2) - kbInit(2,2);
-    kbAInit(2,1) = -L*kbInit(2,1) - kbInit(2,2);
-    kbAInit(2,2) = kbInit(2,2);
-    kbAInit(3,3) = L*L*kbInit(3,3) - L*(kbInit(3,4)+kbInit(4,3)) + kbInit(4,4);
-    kbAInit(3,4) = L*kbInit(3,4) - kbInit(4,4);
-    kbAInit(4,3) = L*kbInit(4,3) - kbInit(4,4);
-    kbAInit(4,4) = kbInit(4,4);
-    kbAInit(5,5) = kbInit(5,5);
-    
-    return theCoordTransf->getGlobalStiffMatrix(kbAInit, qA);
+    static Matrix kbA(6,6);
+    kbA.Zero();
+    kbA(0,0) = kb(0,0);
+    kbA(1,1) = L*L*kb(1,1) + L*(kb(1,2)+kb(2,1)) + kb(2,2);
+    kbA(1,2) = -L*kb(1,2) - kb(2,2);
+    kbA(2,1) = -L*kb(2,1) - kb(2,2);
+    kbA(2,2) = kb(2,2);
+    kbA(3,3) = L*L*kb(3,3) - L*(kb(3,4)+kb(4,3)) + kb(4,4);
+    kbA(3,4) = L*kb(3,4) - kb(4,4);
+    kbA(4,3) = L*kb(4,3) - kb(4,4);
+    kbA(4,4) = kb(4,4);
+    kbA(5,5) = kb(5,5);
+    
+    return theCoordTransf->getGlobalStiffMatrix(kbA, qA);
 }
 
 
@@ -916,6 +933,8 @@ const Vector& EEBeamColumn3d::getResistingForce()
     // subtract external load
     theVector.addVector(1.0, theLoad, -1.0);
     
+    this->stopAllocCount();
+    
     return theVector;
 }
 
@@ -1104,6 +1123,8 @@ void EEBeamColumn3d::Print(OPS_Stream &s, int flag)
         s << "  CoordTransf: " << theCoordTransf->getTag() << endln;
         if (theSite != 0)
             s << "  ExperimentalSite: " << theSite->getTag() << endln;
+        if (theTangStiff != 0)
+            s << "  ExperimentalTangStiff: " << theTangStiff->getTag() << endln;
         s << "  iMod: " << iMod;
         s << ", addRayleigh: " << addRayleigh << endln;
         s << "  mass per unit length: " << rho;
@@ -1281,6 +1302,14 @@ Response* EEBeamColumn3d::setResponse(const char **argv, int argc,
         theResponse = new ElementResponse(this, 9, Vector(6));
     }
     
+    // tangent stiffness output
+    if (theResponse == 0)
+        theResponse = this->setTangStiffResponse(argv, argc, output);
+    
+    // heap allocations
+    if (theResponse == 0)
+        theResponse = this->setAllocResponse(argv, argc, output);
+    
     output.endTag(); // ElementOutput
     
     return theResponse;
@@ -1356,7 +1385,7 @@ int EEBeamColumn3d::getResponse(int responseID, Information &eleInfo)
         return eleInfo.setVector(this->getBasicAccel());
         
     default:
-        return -1;
+        return this->ExperimentalElement::getResponse(responseID, eleInfo);
     }
 }
 
@@ -30,6 +30,7 @@
 // Description: This file contains the implementation of the EEBearing2d class.
 
 #include "EEBearing2d.h"
+#include <ExpTiming.h>
 
 #include <Domain.h>
 #include <Node.h>
@@ -42,6 +43,7 @@
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <SharedMemoryChannel.h>
 
 #include <float.h>
 #include <math.h>
@@ -58,9 +60,10 @@ Vector EEBearing2d::theVector(6);
 // by each object and storing the tags of the end nodes.
 EEBearing2d::EEBearing2d(int tag, int Nd1, int Nd2,
     int pfc, UniaxialMaterial **materials,
-    ExperimentalSite *site, const Vector _y, const Vector _x,
+    ExperimentalSite *site, ExperimentalTangentStiff *tang,
+    const Vector _y, const Vector _x,
     const Vector Mr, double sdI, bool iM, int addRay, double m)
-    : ExperimentalElement(tag, ELE_TAG_EEBearing2d, site),
+    : ExperimentalElement(tag, ELE_TAG_EEBearing2d, site, tang),
     connectedExternalNodes(2), pFrcCtrl(pfc), x(_x), y(_y), Mratio(Mr),
     shearDistI(sdI), iMod(iM), addRayleigh(addRay), mass(m), L(0.0),
     db(0), vb(0), ab(0), qb(0), t(0),
@@ -160,10 +163,10 @@ EEBearing2d::EEBearing2d(int tag, int Nd1, int Nd2,
 // by each object and storing the tags of the end nodes.
 EEBearing2d::EEBearing2d(int tag, int Nd1, int Nd2,
     int pfc, UniaxialMaterial **materials,
-    int port, char *machineInetAddr, int ssl, int udp, int dataSize,
-    const Vector _y, const Vector _x,
+    int port, char *machineInetAddr, int ssl, int udp, int shm, int dataSize,
+    ExperimentalTangentStiff *tang, const Vector _y, const Vector _x,
     const Vector Mr, double sdI, bool iM, int addRay, double m)
-    : ExperimentalElement(tag, ELE_TAG_EEBearing2d),
+    : ExperimentalElement(tag, ELE_TAG_EEBearing2d, NULL, tang),
     connectedExternalNodes(2), pFrcCtrl(pfc), x(_x), y(_y), Mratio(Mr),
     shearDistI(sdI), iMod(iM), addRayleigh(addRay), mass(m), L(0.0),
     theChannel(0), sData(0), sendData(0), rData(0), recvData(0),
@@ -232,6 +235,12 @@ EEBearing2d::EEBearing2d(int tag, int Nd1, int Nd2,
         else
             theChannel = new UDP_Socket(port, machineInetAddr);
     }
+    else if (shm)  {
+        if (machineInetAddr == 0)
+            theChannel = new SharedMemoryChannel(port, "127.0.0.1");
+        else
+            theChannel = new SharedMemoryChannel(port, machineInetAddr);
+    }
     else  {
         if (machineInetAddr == 0)
             theChannel = new TCP_Socket(port, "127.0.0.1");
@@ -471,10 +480,9 @@ int EEBearing2d::commitState()
     
     // update dbLast
     int ndim = 0, i;
-    Vector dgLast(6), dlLast(6);
+    static Vector dgLast(6), dlLast(6);
     for (i=0; i<2; i++)  {
-        Vector disp = theNodes[i]->getTrialDisp();
-        dgLast.Assemble(disp, ndim);
+        dgLast.Assemble(theNodes[i]->getTrialDisp(), ndim);
         ndim += 3;
     }
     dlLast.addMatrixVector(0.0, Tgl, dgLast, 1.0);
@@ -486,7 +494,10 @@ int EEBearing2d::commitState()
 
 int EEBearing2d::update()
 {
+    ExpTimer timer(OF_Timing_Element);
+    
     int rValue = 0;
+    this->startAllocCount();
     
     // get current time
     Domain *theDomain = this->getDomain();
@@ -494,19 +505,16 @@ int EEBearing2d::update()
     
     // get global trial response
     int ndim = 0, i;
-    Vector dg(6), vg(6), ag(6);
+    static Vector dg(6), vg(6), ag(6);
     for (i=0; i<2; i++)  {
-        Vector disp = theNodes[i]->getTrialDisp();
-        Vector vel = theNodes[i]->getTrialVel();
-        Vector accel = theNodes[i]->getTrialAccel();
-        dg.Assemble(disp, ndim);
-        vg.Assemble(vel, ndim);
-        ag.Assemble(accel, ndim);
+        dg.Assemble(theNodes[i]->getTrialDisp(), ndim);
+        vg.Assemble(theNodes[i]->getTrialVel(), ndim);
+        ag.Assemble(theNodes[i]->getTrialAccel(), ndim);
         ndim += 3;
     }
     
     // transform response from the global to the local system
-    Vector vl(6), al(6);
+    static Vector vl(6), al(6);
     dl.addMatrixVector(0.0, Tgl, dg, 1.0);
     vl.addMatrixVector(0.0, Tgl, vg, 1.0);
     al.addMatrixVector(0.0, Tgl, ag, 1.0);
@@ -522,11 +530,10 @@ int EEBearing2d::update()
         (*qb)(0) = theMaterials[0]->getStress();
     
     // 2) set shear deformations in basic y-direction
-    Vector dbDelta = (*db) - dbLast;
     // do not check time for right now because of transformation constraint
     // handler calling update at beginning of new step when applying load
-    // if (dbDelta.pNorm(0) > DBL_EPSILON || (*t)(0) > tLast)  {
-    if (dbDelta.pNorm(0) > DBL_EPSILON)  {
+    // if (maxAbsDiff(*db, dbLast) > DBL_EPSILON || (*t)(0) > tLast)  {
+    if (maxAbsDiff(*db, dbLast) > DBL_EPSILON)  {
         // set the trial response at the site
         if (theSite != 0)  {
             theSite->setTrialResponse(db, vb, ab, qb, t);
@@ -561,6 +568,11 @@ int EEBearing2d::setInitialStiff(const Matrix& kbinit)
     kbInit(1,1) = kbinit(0,0);
     kbInit(2,2) = theMaterials[1]->getInitialTangent();
     
+    // only the shear DOF is used for the tangent stiffness
+    static ID shearDOF(1);
+    shearDOF(0) = 1;
+    this->setBasicInitStiff(kbinit, &shearDOF);
+    
     // zero the global matrix
     theInitStiff.Zero();
     
@@ -577,7 +589,7 @@ int EEBearing2d::setInitialStiff(const Matrix& kbinit)
 
 const Matrix& EEBearing2d::getTangentStiff()
 {
-    if (firstWarning == true)  {
+    if (firstWarning == true && theTangStiff == 0)  {
         opserr << "\nWARNING EEBearing2d::getTangentStiff() - "
             << "Element: " << this->getTag() << endln
             << "TangentStiff cannot be calculated." << endln
@@ -592,11 +604,26 @@ const Matrix& EEBearing2d::getTangentStiff()
     // zero the global matrix
     theMatrix.Zero();
     
+    // get updated shear stiffness in basic system
+    if (theTangStiff != 0)  {
+        // get current daq displacements and resisting forces
+        this->getBasicDisp();
+        if (theSite != 0)  {
+            (*qbDaq) = theSite->getForce();
+        }
+        else  {
+            sData[0] = OF_RemoteTest_getForce;
+            theChannel->sendVector(0, 0, *sendData, 0);
+            theChannel->recvVector(0, 0, *recvData, 0);
+        }
+    }
+    const Matrix &kbShear = this->getBasicTangentStiff(*dbDaq, *qbDaq);
+    
     // get stiffness matrix in basic system
     static Matrix kb(3,3);
     kb.Zero();
     kb(0,0) = theMaterials[0]->getTangent();
-    kb(1,1) = kbInit(1,1);
+    kb(1,1) = kbShear(0,0);
     kb(2,2) = theMaterials[1]->getTangent();
     
     // transform from basic to local system
@@ -771,6 +798,8 @@ const Vector& EEBearing2d::getResistingForce()
     // subtract external load
     theVector.addVector(1.0, theLoad, -1.0);
     
+    this->stopAllocCount();
+    
     return theVector;
 }
 
@@ -932,6 +961,8 @@ void EEBearing2d::Print(OPS_Stream &s, int flag)
         s << "  Material rz: " << theMaterials[1]->getTag() << endln;
         if (theSite != 0)
             s << "  ExperimentalSite: " << theSite->getTag() << endln;
+        if (theTangStiff != 0)
+            s << "  ExperimentalTangStiff: " << theTangStiff->getTag() << endln;
         s << "  Mratio: " << Mratio << "  shearDistI: " << shearDistI << endln;
         s << "  addRayleigh: " << addRayleigh << "  mass: " << mass << endln;
         // determine resisting forces in global system
@@ -1092,6 +1123,14 @@ Response* EEBearing2d::setResponse(const char **argv, int argc,
         }
     }
     
+    // tangent stiffness output
+    if (theResponse == 0)
+        theResponse = this->setTangStiffResponse(argv, argc, output);
+    
+    // heap allocations
+    if (theResponse == 0)
+        theResponse = this->setAllocResponse(argv, argc, output);
+    
     output.endTag(); // ElementOutput
     
     return theResponse;
@@ -1138,7 +1177,7 @@ int EEBearing2d::getResponse(int responseID, Information &eleInfo)
         return eleInfo.setVector(this->getBasicAccel());
         
     default:
-        return 0;
+        return this->ExperimentalElement::getResponse(responseID, eleInfo);
     }
 }
 
@@ -1275,5 +1314,6 @@ void EEBearing2d::applyIMod()
     }
     
     // correct for displacement control errors using I-Modification
-    (*qbDaq) -= kbInit*((*dbDaq) - (*db));
+    qbDaq->addMatrixVector(1.0, kbInit, *dbDaq, -1.0);
+    qbDaq->addMatrixVector(1.0, kbInit, *db, 1.0);
 }
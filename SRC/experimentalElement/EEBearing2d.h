@@ -49,13 +49,15 @@ public:
     EEBearing2d(int tag, int Nd1, int Nd2, 
         int pFrcCtrl, UniaxialMaterial **theMaterials,
         ExperimentalSite *site,
+        ExperimentalTangentStiff *tangStiff = 0,
         const Vector y = 0, const Vector x = 0, const Vector Mratio = 0,
         double shearDistI = 0.5, bool iMod = false,
         int addRayleigh = 0, double mass = 0.0);
     EEBearing2d(int tag, int Nd1, int Nd2,
         int pFrcCtrl, UniaxialMaterial **theMaterials,
         int port, char *machineInetAddress = 0,
-        int ssl = 0, int udp = 0, int dataSize = OF_Network_dataSize,
+        int ssl = 0, int udp = 0, int shm = 0, int dataSize = OF_Network_dataSize,
+        ExperimentalTangentStiff *tangStiff = 0,
         const Vector y = 0, const Vector x = 0, const Vector Mratio = 0,
         double shearDistI = 0.5, bool iMod = false,
         int addRayleigh = 0, double mass = 0.0);
@@ -30,6 +30,7 @@
 // Description: This file contains the implementation of the EEBearing3d class.
 
 #include "EEBearing3d.h"
+#include <ExpTiming.h>
 
 #include <Domain.h>
 #include <Node.h>
@@ -42,6 +43,7 @@
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <SharedMemoryChannel.h>
 
 #include <float.h>
 #include <math.h>
@@ -58,9 +60,10 @@ Vector EEBearing3d::theVector(12);
 // by each object and storing the tags of the end nodes.
 EEBearing3d::EEBearing3d(int tag, int Nd1, int Nd2,
     int pfc, UniaxialMaterial **materials,
-    ExperimentalSite *site, const Vector _y, const Vector _x,
+    ExperimentalSite *site, ExperimentalTangentStiff *tang,
+    const Vector _y, const Vector _x,
     const Vector Mr, double sdI, bool iM, int addRay, double m)
-    : ExperimentalElement(tag, ELE_TAG_EEBearing3d, site),
+    : ExperimentalElement(tag, ELE_TAG_EEBearing3d, site, tang),
     connectedExternalNodes(2), pFrcCtrl(pfc), x(_x), y(_y), Mratio(Mr),
     shearDistI(sdI), iMod(iM), addRayleigh(addRay), mass(m), L(0.0),
     db(0), vb(0), ab(0), qb(0), t(0),
@@ -166,10 +169,10 @@ EEBearing3d::EEBearing3d(int tag, int Nd1, int Nd2,
 // by each object and storing the tags of the end nodes.
 EEBearing3d::EEBearing3d(int tag, int Nd1, int Nd2,
     int pfc, UniaxialMaterial **materials,
-    int port, char *machineInetAddr, int ssl, int udp, int dataSize,
-    const Vector _y, const Vector _x,
+    int port, char *machineInetAddr, int ssl, int udp, int shm, int dataSize,
+    ExperimentalTangentStiff *tang, const Vector _y, const Vector _x,
     const Vector Mr, double sdI, bool iM, int addRay, double m)
-    : ExperimentalElement(tag, ELE_TAG_EEBearing3d),
+    : ExperimentalElement(tag, ELE_TAG_EEBearing3d, NULL, tang),
     connectedExternalNodes(2), pFrcCtrl(pfc), x(_x), y(_y), Mratio(Mr),
     shearDistI(sdI), iMod(iM), addRayleigh(addRay), mass(m), L(0.0),
     theChannel(0), sData(0), sendData(0), rData(0), recvData(0),
@@ -244,6 +247,12 @@ EEBearing3d::EEBearing3d(int tag, int Nd1, int Nd2,
         else
             theChannel = new UDP_Socket(port, machineInetAddr);
     }
+    else if (shm)  {
+        if (machineInetAddr == 0)
+            theChannel = new SharedMemoryChannel(port, "127.0.0.1");
+        else
+            theChannel = new SharedMemoryChannel(port, machineInetAddr);
+    }
     else  {
         if (machineInetAddr == 0)
             theChannel = new TCP_Socket(port, "127.0.0.1");
@@ -483,10 +492,9 @@ int EEBearing3d::commitState()
     
     // update dbLast
     int ndim = 0, i;
-    Vector dgLast(12), dlLast(12);
+    static Vector dgLast(12), dlLast(12);
     for (i=0; i<2; i++)  {
-        Vector disp = theNodes[i]->getTrialDisp();
-        dgLast.Assemble(disp, ndim);
+        dgLast.Assemble(theNodes[i]->getTrialDisp(), ndim);
         ndim += 6;
     }
     dlLast.addMatrixVector(0.0, Tgl, dgLast, 1.0);
@@ -498,7 +506,10 @@ int EEBearing3d::commitState()
 
 int EEBearing3d::update()
 {
+    ExpTimer timer(OF_Timing_Element);
+    
     int rValue = 0;
+    this->startAllocCount();
     
     // get current time
     Domain *theDomain = this->getDomain();
@@ -506,19 +517,16 @@ int EEBearing3d::update()
     
     // get global trial response
     int ndim = 0, i;
-    Vector dg(12), vg(12), ag(12);
+    static Vector dg(12), vg(12), ag(12);
     for (i=0; i<2; i++)  {
-        Vector disp = theNodes[i]->getTrialDisp();
-        Vector vel = theNodes[i]->getTrialVel();
-        Vector accel = theNodes[i]->getTrialAccel();
-        dg.Assemble(disp, ndim);
-        vg.Assemble(vel, ndim);
-        ag.Assemble(accel, ndim);
+        dg.Assemble(theNodes[i]->getTrialDisp(), ndim);
+        vg.Assemble(theNodes[i]->getTrialVel(), ndim);
+        ag.Assemble(theNodes[i]->getTrialAccel(), ndim);
         ndim += 6;
     }
     
     // transform response from the global to the local system
-    Vector vl(12), al(12);
+    static Vector vl(12), al(12);
     dl.addMatrixVector(0.0, Tgl, dg, 1.0);
     vl.addMatrixVector(0.0, Tgl, vg, 1.0);
     al.addMatrixVector(0.0, Tgl, ag, 1.0);
@@ -534,11 +542,10 @@ int EEBearing3d::update()
         (*qb)(0) = theMaterials[0]->getStress();
     
     // 2) set shear deformations in basic y- and z-direction
-    Vector dbDelta = (*db) - dbLast;
     // do not check time for right now because of transformation constraint
     // handler calling update at beginning of new step when applying load
-    // if (dbDelta.pNorm(0) > DBL_EPSILON || (*t)(0) > tLast)  {
-    if (dbDelta.pNorm(0) > DBL_EPSILON)  {
+    // if (maxAbsDiff(*db, dbLast) > DBL_EPSILON || (*t)(0) > tLast)  {
+    if (maxAbsDiff(*db, dbLast) > DBL_EPSILON)  {
         // set the trial response at the site
         if (theSite != 0)  {
             theSite->setTrialResponse(db, vb, ab, qb, t);
@@ -582,6 +589,11 @@ int EEBearing3d::setInitialStiff(const Matrix& kbinit)
     kbInit(4,4) = theMaterials[2]->getInitialTangent();
     kbInit(5,5) = theMaterials[3]->getInitialTangent();
     
+    // only the shear DOF are used for the tangent stiffness
+    static ID shearDOF(2);
+    shearDOF(0) = 1;  shearDOF(1) = 2;
+    this->setBasicInitStiff(kbinit, &shearDOF);
+    
     // zero the global matrix
     theInitStiff.Zero();
     
@@ -598,7 +610,7 @@ int EEBearing3d::setInitialStiff(const Matrix& kbinit)
 
 const Matrix& EEBearing3d::getTangentStiff()
 {
-    if (firstWarning == true)  {
+    if (firstWarning == true && theTangStiff == 0)  {
         opserr << "\nWARNING EEBearing3d::getTangentStiff() - "
             << "Element: " << this->getTag() << endln
             << "TangentStiff cannot be calculated." << endln
@@ -613,12 +625,27 @@ const Matrix& EEBearing3d::getTangentStiff()
     // zero the global matrix
     theMatrix.Zero();
     
+    // get updated shear stiffness in basic system
+    if (theTangStiff != 0)  {
+        // get current daq displacements and resisting forces
+        this->getBasicDisp();
+        if (theSite != 0)  {
+            (*qbDaq) = theSite->getForce();
+        }
+        else  {
+            sData[0] = OF_RemoteTest_getForce;
+            theChannel->sendVector(0, 0, *sendData, 0);
+            theChannel->recvVector(0, 0, *recvData, 0);
+        }
+    }
+    const Matrix &kbShear = this->getBasicTangentStiff(*dbDaq, *qbDaq);
+    
     // get stiffness matrix in basic system
     static Matrix kb(6,6);
     kb.Zero();
     kb(0,0) = theMaterials[0]->getTangent();
-    kb(1,1) = kbInit(1,1);  kb(1,2) = kbInit(1,2);
-    kb(2,1) = kbInit(2,1);  kb(2,2) = kbInit(2,2);
+    kb(1,1) = kbShear(0,0);  kb(1,2) = kbShear(0,1);
+    kb(2,1) = kbShear(1,0);  kb(2,2) = kbShear(1,1);
     kb(3,3) = theMaterials[1]->getTangent();
     kb(4,4) = theMaterials[2]->getTangent();
     kb(5,5) = theMaterials[3]->getTangent();
@@ -805,6 +832,8 @@ const Vector& EEBearing3d::getResistingForce()
     // subtract external load
     theVector.addVector(1.0, theLoad, -1.0);
     
+    this->stopAllocCount();
+    
     return theVector;
 }
 
@@ -968,6 +997,8 @@ void EEBearing3d::Print(OPS_Stream &s, int flag)
         s << "  Material rz: " << theMaterials[3]->getTag() << endln;
         if (theSite != 0)
             s << "  ExperimentalSite: " << theSite->getTag() << endln;
+        if (theTangStiff != 0)
+            s << "  ExperimentalTangStiff: " << theTangStiff->getTag() << endln;
         s << "  Mratio: " << Mratio << "  shearDistI: " << shearDistI << endln;
         s << "  addRayleigh: " << addRayleigh << "  mass: " << mass << endln;
         // determine resisting forces in global system
@@ -1167,6 +1198,14 @@ Response* EEBearing3d::setResponse(const char **argv, int argc,
         }
     }
     
+    // tangent stiffness output
+    if (theResponse == 0)
+        theResponse = this->setTangStiffResponse(argv, argc, output);
+    
+    // heap allocations
+    if (theResponse == 0)
+        theResponse = this->setAllocResponse(argv, argc, output);
+    
     output.endTag(); // ElementOutput
     
     return theResponse;
@@ -1213,7 +1252,7 @@ int EEBearing3d::getResponse(int responseID, Information &eleInfo)
         return eleInfo.setVector(this->getBasicAccel());
         
     default:
-        return 0;
+        return this->ExperimentalElement::getResponse(responseID, eleInfo);
     }
 }
 
@@ -1379,5 +1418,6 @@ void EEBearing3d::applyIMod()
     }
     
     // correct for displacement control errors using I-Modification
-    (*qbDaq) -= kbInit*((*dbDaq) - (*db));
+    qbDaq->addMatrixVector(1.0, kbInit, *dbDaq, -1.0);
+    qbDaq->addMatrixVector(1.0, kbInit, *db, 1.0);
 }
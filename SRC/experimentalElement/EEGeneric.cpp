@@ -30,6 +30,7 @@
 // Description: This file contains the implementation of the EEGeneric class.
 
 #include "EEGeneric.h"
+#include <ExpTiming.h>
 
 #include <Domain.h>
 #include <Node.h>
@@ -41,6 +42,7 @@
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <SharedMemoryChannel.h>
 
 #include <math.h>
 #include <stdlib.h>
@@ -50,17 +52,19 @@
 // responsible for allocating the necessary space needed
 // by each object and storing the tags of the end nodes.
 EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
-    ExperimentalSite *site,
+    ExperimentalSite *site, ExperimentalTangentStiff *tang,
     bool iM, int addRay, const Matrix *m, int checktime)
-    : ExperimentalElement(tag, ELE_TAG_EEGeneric, site),
+    : ExperimentalElement(tag, ELE_TAG_EEGeneric, site, tang),
     connectedExternalNodes(nodes), basicDOF(1),
     numExternalNodes(0), numDOF(0), numBasicDOF(0),
     iMod(iM), addRayleigh(addRay), mass(0),
     checkTime(checktime),
-    theMatrix(1,1), theVector(1), theLoad(1),
+    theMatrix(1,1), theVector(1), theLoad(1), theAccel(1),
+    theChannel(0), protocol(OF_Network_fixed), numSendData(0),
+    daqFlag(false), replyPending(false), sData(0), sendData(0), rData(0), recvData(0),
     db(0), vb(0), ab(0), t(0),
     dbDaq(0), vbDaq(0), abDaq(0), qDaq(0), tDaq(0),
-    dbCtrl(1), vbCtrl(1), abCtrl(1),
+    dbCtrl(1), vbCtrl(1), abCtrl(1), qDaqCorr(1),
     kbInit(1,1), dbLast(1), tLast(0.0) 
 {
     // initialize nodes
@@ -133,6 +137,8 @@ EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
     vbCtrl.Zero();
     abCtrl.resize(numBasicDOF);
     abCtrl.Zero();
+    qDaqCorr.resize(numBasicDOF);
+    qDaqCorr.Zero();
     kbInit.resize(numBasicDOF,numBasicDOF);
     kbInit.Zero();
     dbLast.resize(numBasicDOF);
@@ -143,19 +149,21 @@ EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
 // responsible for allocating the necessary space needed
 // by each object and storing the tags of the end nodes.
 EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
-    int port, char *machineInetAddr, int ssl, int udp,
-    int dataSize, bool iM, int addRay, const Matrix *m,
-    int checktime)
-    : ExperimentalElement(tag, ELE_TAG_EEGeneric),
+    int port, char *machineInetAddr, int ssl, int udp, int shm,
+    int dataSize, ExperimentalTangentStiff *tang,
+    bool iM, int addRay, const Matrix *m,
+    int checktime, int prot)
+    : ExperimentalElement(tag, ELE_TAG_EEGeneric, NULL, tang),
     connectedExternalNodes(nodes), basicDOF(1),
     numExternalNodes(0), numDOF(0), numBasicDOF(0),
     iMod(iM), addRayleigh(addRay), mass(0),
     checkTime(checktime),
-    theMatrix(1,1), theVector(1), theLoad(1),
-    theChannel(0), sData(0), sendData(0), rData(0), recvData(0),
+    theMatrix(1,1), theVector(1), theLoad(1), theAccel(1),
+    theChannel(0), protocol(prot), numSendData(0),
+    daqFlag(false), replyPending(false), sData(0), sendData(0), rData(0), recvData(0),
     db(0), vb(0), ab(0), t(0),
     dbDaq(0), vbDaq(0), abDaq(0), qDaq(0), tDaq(0),
-    dbCtrl(1), vbCtrl(1), abCtrl(1),
+    dbCtrl(1), vbCtrl(1), abCtrl(1), qDaqCorr(1),
     kbInit(1,1), dbLast(1), tLast(0.0)
 {
     // initialize nodes
@@ -202,6 +210,12 @@ EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
         else
             theChannel = new UDP_Socket(port, machineInetAddr);
     }
+    else if (shm)  {
+        if (machineInetAddr == 0)
+            theChannel = new SharedMemoryChannel(port, "127.0.0.1");
+        else
+            theChannel = new SharedMemoryChannel(port, machineInetAddr);
+    }
     else  {
         if (machineInetAddr == 0)
             theChannel = new TCP_Socket(port, "127.0.0.1");
@@ -239,7 +253,13 @@ EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
     (*sizeDaq)[OF_Resp_Time]   = 1;
     
     if (dataSize < 4*numBasicDOF+1) dataSize = 4*numBasicDOF+1;
-    intData[2*OF_Resp_All] = dataSize;
+    numSendData = 3*numBasicDOF+2;
+    
+    // a negative data size requests the framed protocol
+    if (protocol == OF_Network_framed)
+        intData[2*OF_Resp_All] = -dataSize;
+    else
+        intData[2*OF_Resp_All] = dataSize;
     theChannel->sendID(0, 0, idData, 0);
     
     // allocate memory for the send vectors
@@ -255,6 +275,13 @@ EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
     t = new Vector(&sData[id], 1);
     sendData->Zero();
     
+    // send the element tag with the open action, so that a server
+    // for several elements connects this client to the element with
+    // the same tag
+    sData[1] = this->getTag();
+    this->sendAction(OF_RemoteTest_open, 2);
+    sendData->Zero();
+    
     // allocate memory for the receive vectors
     id = 0;
     rData = new double [dataSize];
@@ -279,6 +306,8 @@ EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
     vbCtrl.Zero();
     abCtrl.resize(numBasicDOF);
     abCtrl.Zero();
+    qDaqCorr.resize(numBasicDOF);
+    qDaqCorr.Zero();
     kbInit.resize(numBasicDOF,numBasicDOF);
     kbInit.Zero();
     dbLast.resize(numBasicDOF);
@@ -319,8 +348,7 @@ EEGeneric::~EEGeneric()
         delete tDaq;
     
     if (theSite == 0)  {
-        sData[0] = OF_RemoteTest_DIE;
-        theChannel->sendVector(0, 0, *sendData, 0);
+        this->sendAction(OF_RemoteTest_DIE);
         
         if (sendData != 0)
             delete sendData;
@@ -416,6 +444,8 @@ void EEGeneric::setDomain(Domain *theDomain)
     theVector.Zero();
     theLoad.resize(numDOF);
     theLoad.Zero();
+    theAccel.resize(numDOF);
+    theAccel.Zero();
     
     // call the base class method
     this->DomainComponent::setDomain(theDomain);
@@ -431,20 +461,19 @@ int EEGeneric::commitState()
         rValue += theSite->commitState(t);
     }
     else  {
-        sData[0] = OF_RemoteTest_commitState;
-        rValue += theChannel->sendVector(0, 0, *sendData, 0);
+        rValue += this->sendAction(OF_RemoteTest_commitState, numSendData);
     }
     
     // commit the base class
     rValue += this->Element::commitState();
     
     // update dbLast
-    int ndim = 0, i;
-    dbLast.Zero();
+    int ndim = 0, i, j;
     for (i=0; i<numExternalNodes; i++)  {
-        Vector disp = theNodes[i]->getTrialDisp();
-        dbLast.Assemble(disp(theDOF[i]), ndim);
-        ndim += theDOF[i].Size();
+        const Vector &disp = theNodes[i]->getTrialDisp();
+        const ID &dof = theDOF[i];
+        for (j=0; j<dof.Size(); j++)
+            dbLast(ndim++) = disp(dof(j));
     }
     
     return rValue;
@@ -453,37 +482,48 @@ int EEGeneric::commitState()
 
 int EEGeneric::update()
 {
+    ExpTimer timer(OF_Timing_Element);
+    
     int rValue = 0;
+    this->startAllocCount();
     
     // get current time
     Domain *theDomain = this->getDomain();
     (*t)(0) = theDomain->getCurrentTime();
     
     // assemble response vectors
-    int ndim = 0, i;
-    db->Zero(); vb->Zero(); ab->Zero();
+    int ndim = 0, i, j;
     for (i=0; i<numExternalNodes; i++)  {
-        Vector disp = theNodes[i]->getTrialDisp();
-        Vector vel = theNodes[i]->getTrialVel();
-        Vector accel = theNodes[i]->getTrialAccel();
-        db->Assemble(disp(theDOF[i]), ndim);
-        vb->Assemble(vel(theDOF[i]), ndim);
-        ab->Assemble(accel(theDOF[i]), ndim);
-        ndim += theDOF[i].Size();
+        const Vector &disp = theNodes[i]->getTrialDisp();
+        const Vector &vel = theNodes[i]->getTrialVel();
+        const Vector &accel = theNodes[i]->getTrialAccel();
+        const ID &dof = theDOF[i];
+        for (j=0; j<dof.Size(); j++, ndim++)  {
+            (*db)(ndim) = disp(dof(j));
+            (*vb)(ndim) = vel(dof(j));
+            (*ab)(ndim) = accel(dof(j));
+        }
     }
     
-    Vector dbDelta = (*db) - dbLast;
     // do not check time for right now because of transformation constraint
     // handler calling update at beginning of new step when applying load
-    // if (dbDelta.pNorm(0) > DBL_EPSILON || (*t)(0) > tLast)  {
-    if (dbDelta.pNorm(0) > DBL_EPSILON || (checkTime && (*t)(0) > tLast))  {
+    // if (maxAbsDiff(*db, dbLast) > DBL_EPSILON || (*t)(0) > tLast)  {
+    if (maxAbsDiff(*db, dbLast) > DBL_EPSILON || (checkTime && (*t)(0) > tLast))  {
         // set the trial response at the site
         if (theSite != 0)  {
             theSite->setTrialResponse(db, vb, ab, (Vector*)0, t);
         }
+        else if (protocol == OF_Network_framed)  {
+            // set the trial response and get the daq response
+            // in a single round trip, the daq response is only
+            // received once it is needed, so that the round trips
+            // of all elements overlap while the domain is updated
+            rValue += this->sendAction(OF_RemoteTest_setTrialGetDaqResponse, numSendData);
+            replyPending = true;
+            daqFlag = true;
+        }
         else  {
-            sData[0] = OF_RemoteTest_setTrialResponse;
-            rValue += theChannel->sendVector(0, 0, *sendData, 0);
+            rValue += this->sendAction(OF_RemoteTest_setTrialResponse, numSendData);
         }
     }
     
@@ -504,6 +544,7 @@ int EEGeneric::setInitialStiff(const Matrix &kbinit)
         return -1;
     }
     kbInit = kbinit;
+    this->setBasicInitStiff(kbInit);
     
     theInitStiff.Zero();
     theInitStiff.Assemble(kbInit, basicDOF, basicDOF);
@@ -512,6 +553,38 @@ int EEGeneric::setInitialStiff(const Matrix &kbinit)
 }
 
 
+const Matrix& EEGeneric::getTangentStiff()
+{
+    if (theTangStiff == 0)
+        return this->ExperimentalElement::getTangentStiff();
+    
+    // get daq displacements and resisting forces
+    if (theSite != 0)  {
+        (*dbDaq) = theSite->getDisp();
+        (*qDaq) = theSite->getForce();
+    }
+    else if (daqFlag)  {
+        // the combined step transaction already received them
+        this->recvPending();
+    }
+    else  {
+        this->sendAction(OF_RemoteTest_getDisp);
+        this->recvResponse(*dbDaq);
+        this->sendAction(OF_RemoteTest_getForce);
+        this->recvResponse(*qDaq);
+    }
+    
+    // get updated kb matrix
+    const Matrix &kb = this->getBasicTangentStiff(*dbDaq, *qDaq);
+    
+    // transform stiffness matrix from the basic to the global system
+    theMatrix.Zero();
+    theMatrix.Assemble(kb, basicDOF, basicDOF);
+    
+    return theMatrix;
+}
+
+
 const Matrix& EEGeneric::getDamp()
 {
     // zero the global matrix
@@ -564,18 +637,17 @@ int EEGeneric::addInertiaLoadToUnbalance(const Vector &accel)
     }
     
     int ndim = 0, i;
-    Vector Raccel(numDOF);
     
     // get mass matrix
-    Matrix M = this->getMass();
+    const Matrix &M = this->getMass();
     // assemble Raccel vector
     for (i=0; i<numExternalNodes; i++ )  {
-        Raccel.Assemble(theNodes[i]->getRV(accel), ndim);
+        theAccel.Assemble(theNodes[i]->getRV(accel), ndim);
         ndim += theNodes[i]->getNumberDOF();
     }
     
     // want to add ( - fact * M R * accel ) to unbalance
-    theLoad.addMatrixVector(1.0, M, Raccel, -1.0);
+    theLoad.addMatrixVector(1.0, M, theAccel, -1.0);
     
     return 0;
 }
@@ -586,14 +658,16 @@ const Vector& EEGeneric::getResistingForce()
     // zero the global residual
     theVector.Zero();
     
+    // receive the daq response of the last trial response
+    this->recvPending();
+    
     // get daq resisting forces
     if (theSite != 0)  {
         (*qDaq) = theSite->getForce();
     }
-    else  {
-        sData[0] = OF_RemoteTest_getForce;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+    else if (!daqFlag)  {
+        this->sendAction(OF_RemoteTest_getForce);
+        this->recvResponse(*qDaq);
     }
     
     // apply optional initial stiffness modification
@@ -602,14 +676,20 @@ const Vector& EEGeneric::getResistingForce()
         if (theSite != 0)  {
             (*dbDaq) = theSite->getDisp();
         }
-        else  {
-            sData[0] = OF_RemoteTest_getDisp;
-            theChannel->sendVector(0, 0, *sendData, 0);
-            theChannel->recvVector(0, 0, *recvData, 0);
+        else if (!daqFlag)  {
+            this->sendAction(OF_RemoteTest_getDisp);
+            this->recvResponse(*dbDaq);
         }
         
+    }
+    
+    // the daq forces are kept as received, so that the corrected
+    // forces do not depend on how often this method is called
+    qDaqCorr = (*qDaq);
+    if (iMod == true)  {
         // correct for displacement control errors using I-Modification
-        qDaq->addMatrixVector(1.0, kbInit, (*dbDaq) - (*db), -1.0);
+        qDaqCorr.addMatrixVector(1.0, kbInit, *dbDaq, -1.0);
+        qDaqCorr.addMatrixVector(1.0, kbInit, *db, 1.0);
     }
    
     // save corresponding ctrl displacements for recorder
@@ -618,11 +698,13 @@ const Vector& EEGeneric::getResistingForce()
     abCtrl = (*ab);
     
     // determine resisting forces in global system
-    theVector.Assemble(*qDaq, basicDOF);
+    theVector.Assemble(qDaqCorr, basicDOF);
     
     // subtract external load
     theVector.addVector(1.0, theLoad, -1.0);
     
+    this->stopAllocCount();
+    
     return theVector;
 }
 
@@ -641,17 +723,16 @@ const Vector& EEGeneric::getResistingForceIncInertia()
     // add inertia forces from element mass
     if (mass != 0)  {
         int ndim = 0, i;
-        Vector accel(numDOF);
         
         // get mass matrix
-        Matrix M = this->getMass();
+        const Matrix &M = this->getMass();
         // assemble accel vector
         for (i=0; i<numExternalNodes; i++ )  {
-            accel.Assemble(theNodes[i]->getTrialAccel(), ndim);
+            theAccel.Assemble(theNodes[i]->getTrialAccel(), ndim);
             ndim += theNodes[i]->getNumberDOF();
         }
         
-        theVector.addMatrixVector(1.0, M, accel, 1.0);
+        theVector.addMatrixVector(1.0, M, theAccel, 1.0);
     }
     
     return theVector;
@@ -664,9 +745,8 @@ const Vector& EEGeneric::getTime()
         (*tDaq) = theSite->getTime();
     }
     else  {
-        sData[0] = OF_RemoteTest_getTime;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->sendAction(OF_RemoteTest_getTime);
+        this->recvResponse(*tDaq);
     }
     
     return *tDaq;
@@ -679,9 +759,8 @@ const Vector& EEGeneric::getBasicDisp()
         (*dbDaq) = theSite->getDisp();
     }
     else  {
-        sData[0] = OF_RemoteTest_getDisp;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->sendAction(OF_RemoteTest_getDisp);
+        this->recvResponse(*dbDaq);
     }
     
     return *dbDaq;
@@ -694,9 +773,8 @@ const Vector& EEGeneric::getBasicVel()
         (*vbDaq) = theSite->getVel();
     }
     else  {
-        sData[0] = OF_RemoteTest_getVel;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->sendAction(OF_RemoteTest_getVel);
+        this->recvResponse(*vbDaq);
     }
     
     return *vbDaq;
@@ -709,15 +787,50 @@ const Vector& EEGeneric::getBasicAccel()
         (*abDaq) = theSite->getAccel();
     }
     else  {
-        sData[0] = OF_RemoteTest_getAccel;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->sendAction(OF_RemoteTest_getAccel);
+        this->recvResponse(*abDaq);
     }
     
     return *abDaq;
 }
 
 
+int EEGeneric::sendAction(int action, int numData)
+{
+    // a pending reply is received before the next request
+    this->recvPending();
+    
+    sData[0] = action;
+    if (protocol == OF_Network_framed)
+        return theChannel->sendFramedVector(0, 0, *sendData, numData, 0);
+    
+    return theChannel->sendVector(0, 0, *sendData, 0);
+}
+
+
+int EEGeneric::recvResponse(Vector &theResponse)
+{
+    // the response vectors share their memory with the receive vector,
+    // so the fixed protocol fills them by receiving the whole vector
+    int numData;
+    if (protocol == OF_Network_framed)
+        return theChannel->recvFramedVector(0, 0, theResponse, numData, 0);
+    
+    return theChannel->recvVector(0, 0, *recvData, 0);
+}
+
+
+int EEGeneric::recvPending()
+{
+    if (replyPending == false)
+        return 0;
+    
+    replyPending = false;
+    
+    return this->recvResponse(*recvData);
+}
+
+
 int EEGeneric::sendSelf(int commitTag, Channel &theChannel)
 {
     // has not been implemented yet.....
@@ -805,6 +918,8 @@ void EEGeneric::Print(OPS_Stream &s, int flag)
         s << endln;
         if (theSite != 0)
             s << "  ExperimentalSite: " << theSite->getTag() << endln;
+        if (theTangStiff != 0)
+            s << "  ExperimentalTangStiff: " << theTangStiff->getTag() << endln;
         s << "  addRayleigh: " << addRayleigh;
         s << "  mass matrix: " << mass << endln;
         // determine resisting forces in global system
@@ -945,6 +1060,14 @@ Response* EEGeneric::setResponse(const char **argv, int argc,
         theResponse = new ElementResponse(this, 9, Vector(numBasicDOF));
     }
     
+    // tangent stiffness output
+    if (theResponse == 0)
+        theResponse = this->setTangStiffResponse(argv, argc, output);
+    
+    // heap allocations
+    if (theResponse == 0)
+        theResponse = this->setAllocResponse(argv, argc, output);
+    
     output.endTag(); // ElementOutput
     
     return theResponse;
@@ -961,7 +1084,7 @@ int EEGeneric::getResponse(int responseID, Information &eleInfo)
         return eleInfo.setVector(this->getResistingForce());
         
     case 3:  // basic forces
-        return eleInfo.setVector(*qDaq);
+        return eleInfo.setVector(qDaqCorr);
         
     case 4:  // ctrl basic displacements
         return eleInfo.setVector(dbCtrl);
@@ -982,6 +1105,6 @@ int EEGeneric::getResponse(int responseID, Information &eleInfo)
         return eleInfo.setVector(this->getBasicAccel());
         
     default:
-        return -1;
+        return this->ExperimentalElement::getResponse(responseID, eleInfo);
     }
 }
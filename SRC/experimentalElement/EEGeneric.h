@@ -48,13 +48,15 @@ public:
     // constructors
     EEGeneric(int tag, ID nodes, ID *dof,
         ExperimentalSite *site,
+        ExperimentalTangentStiff *tangStiff = 0,
         bool iMod = false, int addRayleigh = 1, const Matrix *mass = 0,
         int checkTime = 0);
     EEGeneric(int tag, ID nodes, ID *dof,
         int port, char *machineInetAddress = 0,
-        int ssl = 0, int udp = 0, int dataSize = OF_Network_dataSize,
+        int ssl = 0, int udp = 0, int shm = 0, int dataSize = OF_Network_dataSize,
+        ExperimentalTangentStiff *tangStiff = 0,
         bool iMod = false, int addRayleigh = 1, const Matrix *mass = 0,
-        int checkTime = 0);
+        int checkTime = 0, int protocol = OF_Network_fixed);
     
     // destructor
     ~EEGeneric();
@@ -77,6 +79,7 @@ public:
     // public methods to set and to obtain stiffness,
     // and to obtain mass, damping and residual information
     int setInitialStiff(const Matrix& stiff);
+    const Matrix &getTangentStiff();
     const Matrix &getDamp();
     const Matrix &getMass();
     
@@ -109,6 +112,11 @@ public:
 protected:
     
 private:
+    // private methods to communicate with the remote server
+    int sendAction(int action, int numData = 1);
+    int recvResponse(Vector &theResponse);
+    int recvPending();
+    
     // private attributes - a copy for each object of the class
     ID connectedExternalNodes;  // contains the tags of the end nodes
     ID *theDOF;                 // array with the dof of the end nodes
@@ -126,8 +134,13 @@ private:
     Matrix theMatrix;           // objects matrix
     Vector theVector;           // objects vector
     Vector theLoad;             // load vector
+    Vector theAccel;            // accelerations of the end nodes
     
     Channel *theChannel;        // channel
+    int protocol;               // network protocol
+    int numSendData;            // size of trial response messages
+    bool daqFlag;               // daq response received with trial
+    bool replyPending;          // daq response of trial not received yet
     double *sData;              // send data array
     Vector *sendData;           // send vector
     double *rData;              // receive data array
@@ -147,6 +160,7 @@ private:
     Vector dbCtrl;      // ctrl displacements in basic system
     Vector vbCtrl;      // ctrl velocities in basic system
     Vector abCtrl;      // ctrl accelerations in basic system
+    Vector qDaqCorr;    // corrected daq forces in basic system
     
     Matrix kbInit;      // stiffness matrix in basic system
     Vector dbLast;      // displacements in basic system at last update
@@ -30,6 +30,7 @@
 // Description: This file contains the implementation of the EEInvertedVBrace2d class.
 
 #include "EEInvertedVBrace2d.h"
+#include <ExpTiming.h>
 
 #include <Domain.h>
 #include <Node.h>
@@ -41,6 +42,7 @@
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <SharedMemoryChannel.h>
 
 #include <math.h>
 #include <stdlib.h>
@@ -55,13 +57,13 @@ Vector EEInvertedVBrace2d::theVector(9);
 // responsible for allocating the necessary space needed
 // by each object and storing the tags of the end nodes.
 EEInvertedVBrace2d::EEInvertedVBrace2d(int tag, int Nd1, int Nd2, int Nd3,
-    ExperimentalSite *site,
+    ExperimentalSite *site, ExperimentalTangentStiff *tang,
     bool iM, bool nlGeomFlag, int addRay, double r1, double r2)
-    : ExperimentalElement(tag, ELE_TAG_EEInvertedVBrace2d, site),
+    : ExperimentalElement(tag, ELE_TAG_EEInvertedVBrace2d, site, tang),
     connectedExternalNodes(3), iMod(iM), nlGeom(nlGeomFlag),
     addRayleigh(addRay), rho1(r1), rho2(r2), L1(0.0), L2(0.0), theLoad(9),
     db(0), vb(0), ab(0), t(0),
-    dbDaq(0), vbDaq(0), abDaq(0), qDaq(0), tDaq(0),
+    dbDaq(0), vbDaq(0), abDaq(0), qDaq(0), tDaq(0), qbDaq(3),
     dbCtrl(3), vbCtrl(3), abCtrl(3),
     T(3,9), kbInit(3,3), dbLast(3), tLast(0.0)
 {
@@ -124,14 +126,15 @@ EEInvertedVBrace2d::EEInvertedVBrace2d(int tag, int Nd1, int Nd2, int Nd3,
 // responsible for allocating the necessary space needed
 // by each object and storing the tags of the end nodes.
 EEInvertedVBrace2d::EEInvertedVBrace2d(int tag, int Nd1, int Nd2, int Nd3,
-    int port, char *machineInetAddr, int ssl, int udp, int dataSize,
+    int port, char *machineInetAddr, int ssl, int udp, int shm, int dataSize,
+    ExperimentalTangentStiff *tang,
     bool iM, bool nlGeomFlag, int addRay, double r1, double r2)
-    : ExperimentalElement(tag, ELE_TAG_EEInvertedVBrace2d),
+    : ExperimentalElement(tag, ELE_TAG_EEInvertedVBrace2d, NULL, tang),
     connectedExternalNodes(3), iMod(iM), nlGeom(nlGeomFlag),
     addRayleigh(addRay), rho1(r1), rho2(r2), L1(0.0), L2(0.0), theLoad(9),
     theChannel(0), sData(0), sendData(0), rData(0), recvData(0),
     db(0), vb(0), ab(0), t(0),
-    dbDaq(0), vbDaq(0), abDaq(0), qDaq(0), tDaq(0),
+    dbDaq(0), vbDaq(0), abDaq(0), qDaq(0), tDaq(0), qbDaq(3),
     dbCtrl(3), vbCtrl(3), abCtrl(3),
     T(3,9), kbInit(3,3), dbLast(3), tLast(0.0)
 {
@@ -163,6 +166,12 @@ EEInvertedVBrace2d::EEInvertedVBrace2d(int tag, int Nd1, int Nd2, int Nd3,
         else
             theChannel = new UDP_Socket(port, machineInetAddr);
     }
+    else if (shm)  {
+        if (machineInetAddr == 0)
+            theChannel = new SharedMemoryChannel(port, "127.0.0.1");
+        else
+            theChannel = new SharedMemoryChannel(port, machineInetAddr);
+    }
     else  {
         if (machineInetAddr == 0)
             theChannel = new TCP_Socket(port, "127.0.0.1");
@@ -446,6 +455,8 @@ int EEInvertedVBrace2d::commitState()
 
 int EEInvertedVBrace2d::update()
 {
+    ExpTimer timer(OF_Timing_Element);
+    
     int rValue = 0;
     
     // get current time
@@ -513,6 +524,7 @@ int EEInvertedVBrace2d::setInitialStiff(const Matrix& kbinit)
         return -1;
     }
     kbInit = kbinit;
+    this->setBasicInitStiff(kbInit);
     
     // transform stiffness matrix from the basic to the global system
     theInitStiff.Zero();
@@ -522,6 +534,40 @@ int EEInvertedVBrace2d::setInitialStiff(const Matrix& kbinit)
 }
 
 
+const Matrix& EEInvertedVBrace2d::getTangentStiff()
+{
+    if (theTangStiff == 0)
+        return this->ExperimentalElement::getTangentStiff();
+    
+    // get daq displacements and resisting forces
+    this->getBasicDisp();
+    if (theSite != 0)  {
+        (*qDaq) = theSite->getForce();
+    }
+    else  {
+        sData[0] = OF_RemoteTest_getForce;
+        theChannel->sendVector(0, 0, *sendData, 0);
+        theChannel->recvVector(0, 0, *recvData, 0);
+    }
+    
+    // determine daq forces in basic system, which are the forces
+    // at the top node (see getResistingForce)
+    qbDaq(0) = -0.5*((*qDaq)(0) + dx1[0]/dx1[1]*(*qDaq)(1))
+        - 0.5*((*qDaq)(3) + dx2[0]/dx2[1]*(*qDaq)(4));
+    qbDaq(1) = -0.5*(dx1[1]/dx1[0]*(*qDaq)(0) + (*qDaq)(1))
+        - 0.5*(dx2[1]/dx2[0]*(*qDaq)(3) + (*qDaq)(4));
+    qbDaq(2) = 0.0;
+    
+    // get updated kb matrix
+    const Matrix &kb = this->getBasicTangentStiff(*dbDaq, qbDaq);
+    
+    // transform stiffness matrix from the basic to the global system
+    theMatrix.addMatrixTripleProduct(0.0, T, kb, 1.0);
+    
+    return theMatrix;
+}
+
+
 const Matrix& EEInvertedVBrace2d::getDamp()
 {
     // zero the global matrix
@@ -863,6 +909,8 @@ void EEInvertedVBrace2d::Print(OPS_Stream &s, int flag)
             << ", kNode: " << connectedExternalNodes(2) << endln;
         if (theSite != 0)
             s << "  ExperimentalSite: " << theSite->getTag() << endln;
+        if (theTangStiff != 0)
+            s << "  ExperimentalTangStiff: " << theTangStiff->getTag() << endln;
         s << "  addRayleigh: " << addRayleigh << endln;
         s << "  mass per unit length diagonal 1: " << rho1 << endln;
         s << "  mass per unit length diagonal 2: " << rho2 << endln;
@@ -1015,6 +1063,10 @@ Response* EEInvertedVBrace2d::setResponse(const char **argv, int argc,
         theResponse = new ElementResponse(this, 9, Vector(3));
     }
     
+    // tangent stiffness output
+    if (theResponse == 0)
+        theResponse = this->setTangStiffResponse(argv, argc, output);
+    
     output.endTag(); // ElementOutput
     
     return theResponse;
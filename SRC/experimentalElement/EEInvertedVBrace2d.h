@@ -47,11 +47,13 @@ public:
     // constructors
     EEInvertedVBrace2d(int tag, int Nd1, int Nd2, int Nd3,
         ExperimentalSite *site,
+        ExperimentalTangentStiff *tangStiff = 0,
         bool iMod = false, bool nlGeom = false,
         int addRayleigh = 1, double rho1 = 0.0, double rho2 = 0.0);
     EEInvertedVBrace2d(int tag, int Nd1, int Nd2, int Nd3,
         int port, char *machineInetAddress = 0,
-        int ssl = 0, int udp = 0, int dataSize = OF_Network_dataSize,
+        int ssl = 0, int udp = 0, int shm = 0, int dataSize = OF_Network_dataSize,
+        ExperimentalTangentStiff *tangStiff = 0,
         bool iMod = false, bool nlGeom = false, int addRayleigh = 1,
         double rho1 = 0.0, double rho2 = 0.0);
     
@@ -76,6 +78,7 @@ public:
     // public methods to set and to obtain stiffness,
     // and to obtain mass, damping and residual information
     int setInitialStiff(const Matrix& stiff);
+    const Matrix &getTangentStiff();
     const Matrix &getDamp();
     const Matrix &getMass();
     
@@ -137,6 +140,7 @@ private:
     Vector *abDaq;      // daq accelerations in basic system
     Vector *qDaq;       // daq forces in local system
     Vector *tDaq;       // daq time
+    Vector qbDaq;       // daq forces in basic system
     
     Vector dbCtrl;      // ctrl displacements in basic system
     Vector vbCtrl;      // ctrl velocities in basic system
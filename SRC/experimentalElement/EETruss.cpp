@@ -30,6 +30,7 @@
 // Description: This file contains the implementation of the EETruss class.
 
 #include "EETruss.h"
+#include <ExpTiming.h>
 
 #include <Domain.h>
 #include <Node.h>
@@ -41,6 +42,7 @@
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <SharedMemoryChannel.h>
 
 #include <math.h>
 #include <stdlib.h>
@@ -70,8 +72,7 @@ EETruss::EETruss(int tag, int dim, int Nd1, int Nd2,
     db(0), vb(0), ab(0), t(0),
     dbDaq(0), vbDaq(0), abDaq(0), qbDaq(0), tDaq(0),
     dbCtrl(1), vbCtrl(1), abCtrl(1),
-    kb(1,1), kbInit(1,1), kbLast(1,1),
-    dbLast(1), dbDaqLast(1), qbDaqLast(1), tLast(0.0),
+    kb(1,1), kbInit(1,1), dbLast(1), tLast(0.0),
     firstWarning(true)
 {
     // ensure the connectedExternalNode ID is of correct size & set values
@@ -128,15 +129,13 @@ EETruss::EETruss(int tag, int dim, int Nd1, int Nd2,
     vbCtrl.Zero();
     abCtrl.Zero();
     dbLast.Zero();
-    dbDaqLast.Zero();
-    qbDaqLast.Zero();
 }
 
 
 // responsible for allocating the necessary space needed
 // by each object and storing the tags of the end nodes.
 EETruss::EETruss(int tag, int dim, int Nd1, int Nd2,
-    int port, char *machineInetAddr, int ssl, int udp,
+    int port, char *machineInetAddr, int ssl, int udp, int shm,
     int dataSize, ExperimentalTangentStiff *tang,
     bool iM, int addRay, double r, bool cm)
     : ExperimentalElement(tag, ELE_TAG_EETruss, NULL, tang),
@@ -147,8 +146,7 @@ EETruss::EETruss(int tag, int dim, int Nd1, int Nd2,
     db(0), vb(0), ab(0), t(0),
     dbDaq(0), vbDaq(0), abDaq(0), qbDaq(0), tDaq(0),
     dbCtrl(1), vbCtrl(1), abCtrl(1),
-    kb(1,1), kbInit(1,1), kbLast(1,1),
-    dbLast(1), dbDaqLast(1), qbDaqLast(1), tLast(0.0),
+    kb(1,1), kbInit(1,1), dbLast(1), tLast(0.0),
     firstWarning(true)
 {
     // ensure the connectedExternalNode ID is of correct size & set values
@@ -183,6 +181,12 @@ EETruss::EETruss(int tag, int dim, int Nd1, int Nd2,
         else
             theChannel = new UDP_Socket(port, machineInetAddr);
     }
+    else if (shm)  {
+        if (machineInetAddr == 0)
+            theChannel = new SharedMemoryChannel(port, "127.0.0.1");
+        else
+            theChannel = new SharedMemoryChannel(port, machineInetAddr);
+    }
     else  {
         if (machineInetAddr == 0)
             theChannel = new TCP_Socket(port, "127.0.0.1");
@@ -257,8 +261,6 @@ EETruss::EETruss(int tag, int dim, int Nd1, int Nd2,
     vbCtrl.Zero();
     abCtrl.Zero();
     dbLast.Zero();
-    dbDaqLast.Zero();
-    qbDaqLast.Zero();
 }
 
 
@@ -494,14 +496,14 @@ int EETruss::commitState()
 
 int EETruss::update()
 {
+    ExpTimer timer(OF_Timing_Element);
+    
     int rValue = 0;
+    this->startAllocCount();
     
     // save the last response parameters
     tLast = (*t)(0);
     dbLast = (*db);
-    dbDaqLast = (*dbDaq);
-    qbDaqLast = (*qbDaq);
-    kbLast = kb;
     
     // get current time
     Domain *theDomain = this->getDomain();
@@ -522,12 +524,11 @@ int EETruss::update()
         (*ab)(0) += (accel2(i)-accel1(i))*cosX[i];
     }
     
-    // calculate incremental displacement command
-    Vector dbDelta = (*db) - dbLast;
+    // check for a change in the displacement command
     // do not check time for right now because of transformation constraint
     // handler calling update at beginning of new step when applying load
-    // if (dbDelta.pNorm(0) > DBL_EPSILON || (*t)(0) > tLast)  {
-    if (dbDelta.pNorm(0) > DBL_EPSILON)  {
+    // if (maxAbsDiff(*db, dbLast) > DBL_EPSILON || (*t)(0) > tLast)  {
+    if (maxAbsDiff(*db, dbLast) > DBL_EPSILON)  {
         // set the trial response at the site
         if (theSite != 0)  {
             theSite->setTrialResponse(db, vb, ab, (Vector*)0, t);
@@ -550,7 +551,8 @@ int EETruss::setInitialStiff(const Matrix& kbinit)
             << this->getTag() << endln;
         return -1;
     }
-    kb = kbInit = kbLast = kbinit;
+    kb = kbInit = kbinit;
+    this->setBasicInitStiff(kbInit);
     
     // transform the stiffness from the basic to the global system
     theInitStiff.Zero();
@@ -580,13 +582,8 @@ const Matrix& EETruss::getTangentStiff()
         this->getBasicDisp();
         this->getBasicForce();
         
-        // calculate incremental displacement and force vectors
-        Vector dbDaqIncr = (*dbDaq) - dbDaqLast;
-        Vector qbDaqIncr = (*qbDaq) - qbDaqLast;
-        
         // get updated kb matrix
-        kb = theTangStiff->updateTangentStiff(&dbDaqIncr, (Vector*)0,
-            (Vector*)0, &qbDaqIncr, (Vector*)0, &kbInit, &kbLast);
+        kb = this->getBasicTangentStiff(*dbDaq, *qbDaq);
         
         // transform the kb from the basic to the global system
         int numDOF2 = numDOF/2;
@@ -732,7 +729,8 @@ const Vector& EETruss::getResistingForce()
         this->getBasicDisp();
         
         // correct for displacement control errors using I-Modification
-        qbDaq->addMatrixVector(1.0, kbInit, (*dbDaq) - (*db), -1.0);
+        qbDaq->addMatrixVector(1.0, kbInit, *dbDaq, -1.0);
+        qbDaq->addMatrixVector(1.0, kbInit, *db, 1.0);
     }
     
     // save corresponding ctrl values for recorder
@@ -750,6 +748,8 @@ const Vector& EETruss::getResistingForce()
     // subtract external load
     theVector->addVector(1.0, *theLoad, -1.0);
     
+    this->stopAllocCount();
+    
     return *theVector;
 }
 
@@ -1064,16 +1064,12 @@ Response* EETruss::setResponse(const char **argv, int argc,
     }
     
     // tangent stiffness output
-    else if (strcmp(argv[0],"tangStif") == 0 ||
-        strcmp(argv[0],"tangStiff") == 0 ||
-        strcmp(argv[0],"expTangStif") == 0 ||
-        strcmp(argv[0],"expTangStiff") == 0 ||
-        strcmp(argv[0],"expTangentStif") == 0 ||
-        strcmp(argv[0],"expTangentStiff") == 0)  {
-        if (theTangStiff != 0)  {
-            theResponse = theTangStiff->setResponse(&argv[1], argc-1, output);
-        }
-    }
+    if (theResponse == 0)
+        theResponse = this->setTangStiffResponse(argv, argc, output);
+    
+    // heap allocations
+    if (theResponse == 0)
+        theResponse = this->setAllocResponse(argv, argc, output);
     
     output.endTag(); // ElementOutput
     
@@ -1117,6 +1113,6 @@ int EETruss::getResponse(int responseID, Information &eleInfo)
         return eleInfo.setVector(this->getBasicAccel());
         
     default:
-        return 0;
+        return this->ExperimentalElement::getResponse(responseID, eleInfo);
     }
 }
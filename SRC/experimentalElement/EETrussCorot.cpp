@@ -30,6 +30,7 @@
 // Description: This file contains the implementation of the EETrussCorot class.
 
 #include "EETrussCorot.h"
+#include <ExpTiming.h>
 
 #include <Domain.h>
 #include <Node.h>
@@ -41,6 +42,7 @@
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <SharedMemoryChannel.h>
 
 #include <math.h>
 #include <stdlib.h>
@@ -71,8 +73,7 @@ EETrussCorot::EETrussCorot(int tag, int dim, int Nd1, int Nd2,
     db(0), vb(0), ab(0), t(0),
     dbDaq(0), vbDaq(0), abDaq(0), qbDaq(0), tDaq(0),
     dbCtrl(1), vbCtrl(1), abCtrl(1),
-    kb(1,1), kbInit(1,1), kbLast(1,1),
-    dbLast(1), dbDaqLast(1), qbDaqLast(1), tLast(0.0),
+    kb(1,1), kbInit(1,1), dbLast(1), tLast(0.0),
     firstWarning(true)
 {
     // ensure the connectedExternalNode ID is of correct size & set values
@@ -124,15 +125,13 @@ EETrussCorot::EETrussCorot(int tag, int dim, int Nd1, int Nd2,
     vbCtrl.Zero();
     abCtrl.Zero();
     dbLast.Zero();
-    dbDaqLast.Zero();
-    qbDaqLast.Zero();
 }
 
 
 // responsible for allocating the necessary space needed
 // by each object and storing the tags of the end nodes.
 EETrussCorot::EETrussCorot(int tag, int dim, int Nd1, int Nd2,
-    int port, char *machineInetAddr, int ssl, int udp,
+    int port, char *machineInetAddr, int ssl, int udp, int shm,
     int dataSize, ExperimentalTangentStiff *tang,
     bool iM, int addRay, double r, bool cm)
     : ExperimentalElement(tag, ELE_TAG_EETrussCorot, NULL, tang),
@@ -144,8 +143,7 @@ EETrussCorot::EETrussCorot(int tag, int dim, int Nd1, int Nd2,
     db(0), vb(0), ab(0), t(0),
     dbDaq(0), vbDaq(0), abDaq(0), qbDaq(0), tDaq(0),
     dbCtrl(1), vbCtrl(1), abCtrl(1),
-    kb(1,1), kbInit(1,1), kbLast(1,1),
-    dbLast(1), dbDaqLast(1), qbDaqLast(1), tLast(0.0),
+    kb(1,1), kbInit(1,1), dbLast(1), tLast(0.0),
     firstWarning(true)
 {
     // ensure the connectedExternalNode ID is of correct size & set values
@@ -175,6 +173,12 @@ EETrussCorot::EETrussCorot(int tag, int dim, int Nd1, int Nd2,
         else
             theChannel = new UDP_Socket(port, machineInetAddr);
     }
+    else if (shm)  {
+        if (machineInetAddr == 0)
+            theChannel = new SharedMemoryChannel(port, "127.0.0.1");
+        else
+            theChannel = new SharedMemoryChannel(port, machineInetAddr);
+    }
     else  {
         if (machineInetAddr == 0)
             theChannel = new TCP_Socket(port, "127.0.0.1");
@@ -249,8 +253,6 @@ EETrussCorot::EETrussCorot(int tag, int dim, int Nd1, int Nd2,
     vbCtrl.Zero();
     abCtrl.Zero();
     dbLast.Zero();
-    dbDaqLast.Zero();
-    qbDaqLast.Zero();
 }
 
 
@@ -531,14 +533,13 @@ int EETrussCorot::commitState()
 
 int EETrussCorot::update()
 {
+    ExpTimer timer(OF_Timing_Element);
+    
     int rValue = 0;
     
     // save the last response parameters
     tLast = (*t)(0);
     dbLast = (*db);
-    dbDaqLast = (*dbDaq);
-    qbDaqLast = (*qbDaq);
-    kbLast = kb;
     
     // get current time
     Domain *theDomain = this->getDomain();
@@ -610,7 +611,8 @@ int EETrussCorot::setInitialStiff(const Matrix& kbinit)
             << this->getTag() << endln;
         return -1;
     }
-    kb = kbInit = kbLast = kbinit;
+    kb = kbInit = kbinit;
+    this->setBasicInitStiff(kbInit);
     
     // transform the stiffness from the basic to the local system
     static Matrix kl(3,3);
@@ -647,13 +649,8 @@ const Matrix& EETrussCorot::getTangentStiff()
         this->getBasicDisp();
         this->getBasicForce();
         
-        // calculate incremental displacement and force vectors
-        Vector dbDaqIncr = (*dbDaq) - dbDaqLast;
-        Vector qbDaqIncr = (*qbDaq) - qbDaqLast;
-        
         // get updated kb matrix
-        kb = theTangStiff->updateTangentStiff(&dbDaqIncr, (Vector*)0,
-            (Vector*)0, &qbDaqIncr, (Vector*)0, &kbInit, &kbLast);
+        kb = this->getBasicTangentStiff(*dbDaq, *qbDaq);
         
         // apply optional initial stiffness modification
         if (iMod == true)  {
@@ -1177,16 +1174,8 @@ Response* EETrussCorot::setResponse(const char **argv, int argc,
     }
     
     // tangent stiffness output
-    else if (strcmp(argv[0],"tangStif") == 0 ||
-        strcmp(argv[0],"tangStiff") == 0 ||
-        strcmp(argv[0],"expTangStif") == 0 ||
-        strcmp(argv[0],"expTangStiff") == 0 ||
-        strcmp(argv[0],"expTangentStif") == 0 ||
-        strcmp(argv[0],"expTangentStiff") == 0)  {
-        if (theTangStiff != 0)  {
-            theResponse = theTangStiff->setResponse(&argv[1], argc-1, output);
-        }
-    }
+    if (theResponse == 0)
+        theResponse = this->setTangStiffResponse(argv, argc, output);
     
     output.endTag(); // ElementOutput
     
@@ -54,7 +54,7 @@ public:
         double rho = 0.0, bool cMass = false);
     EETrussCorot(int tag, int dimension, int Nd1, int Nd2,
         int port, char *machineInetAddress = 0,
-        int ssl = 0, int udp = 0, int dataSize = OF_Network_dataSize,
+        int ssl = 0, int udp = 0, int shm = 0, int dataSize = OF_Network_dataSize,
         ExperimentalTangentStiff *tangStiff = 0,
         bool iMod = false, int addRayleigh = 1,
         double rho = 0.0, bool cMass = false);
@@ -157,11 +157,8 @@ private:
     
     Matrix kb;          // tangent stiffness matrix in basic system
     Matrix kbInit;      // initial stiffness matrix in basic system
-    Matrix kbLast;      // tangent stiffness matrix in basic system at last update
     
     Vector dbLast;      // displacements in basic system at last update
-    Vector dbDaqLast;   // daq disp in basic system at last update
-    Vector qbDaqLast;   // daq force in basic system at last update
     double tLast;       // time at last update
     
     Node *theNodes[2];  // array of node pointers
@@ -30,6 +30,7 @@
 // Description: This file contains the implementation of the EETwoNodeLink class.
 
 #include "EETwoNodeLink.h"
+#include <ExpTiming.h>
 
 #include <Domain.h>
 #include <Node.h>
@@ -41,6 +42,7 @@
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <SharedMemoryChannel.h>
 
 #include <float.h>
 #include <math.h>
@@ -72,9 +74,9 @@ EETwoNodeLink::EETwoNodeLink(int tag, int dim, int Nd1, int Nd2,
     L(0.0), db(0), vb(0), ab(0), t(0),
     dbDaq(0), vbDaq(0), abDaq(0), qbDaq(0), tDaq(0),
     dbCtrl(numDir), vbCtrl(numDir), abCtrl(numDir),
-    dl(0), Tgl(0,0), Tlb(0,0),
-    kb(numDir,numDir), kbInit(numDir,numDir), kbLast(numDir,numDir),
-    dbLast(numDir), dbDaqLast(numDir), qbDaqLast(numDir), tLast(0.0),
+    dl(0), dg(0), vg(0), ag(0), vl(0), al(0), ql(0), kl(0,0),
+    Tgl(0,0), Tlb(0,0), kb(numDir,numDir), kbInit(numDir,numDir),
+    dbLast(numDir), tLast(0.0),
     theMatrix(0), theVector(0), theLoad(0),
     firstWarning(true)
 {
@@ -192,8 +194,6 @@ EETwoNodeLink::EETwoNodeLink(int tag, int dim, int Nd1, int Nd2,
     vbCtrl.Zero();
     abCtrl.Zero();
     dbLast.Zero();
-    dbDaqLast.Zero();
-    qbDaqLast.Zero();
 }
 
 
@@ -201,7 +201,7 @@ EETwoNodeLink::EETwoNodeLink(int tag, int dim, int Nd1, int Nd2,
 // by each object and storing the tags of the end nodes.
 EETwoNodeLink::EETwoNodeLink(int tag, int dim, int Nd1, int Nd2,
     const ID &direction, int port, char *machineInetAddr,
-    int ssl, int udp, int dataSize, ExperimentalTangentStiff *tang,
+    int ssl, int udp, int shm, int dataSize, ExperimentalTangentStiff *tang,
     const Vector _y, const Vector _x, const Vector Mr,
     const Vector sdI, bool iM, int addRay, double m)
     : ExperimentalElement(tag, ELE_TAG_EETwoNodeLink, NULL, tang),
@@ -213,9 +213,9 @@ EETwoNodeLink::EETwoNodeLink(int tag, int dim, int Nd1, int Nd2,
     db(0), vb(0), ab(0), t(0),
     dbDaq(0), vbDaq(0), abDaq(0), qbDaq(0), tDaq(0),
     dbCtrl(numDir), vbCtrl(numDir), abCtrl(numDir),
-    dl(0), Tgl(0,0), Tlb(0,0),
-    kb(numDir,numDir), kbInit(numDir,numDir), kbLast(numDir,numDir),
-    dbLast(numDir), dbDaqLast(numDir), qbDaqLast(numDir), tLast(0.0),
+    dl(0), dg(0), vg(0), ag(0), vl(0), al(0), ql(0), kl(0,0),
+    Tgl(0,0), Tlb(0,0), kb(numDir,numDir), kbInit(numDir,numDir),
+    dbLast(numDir), tLast(0.0),
     theMatrix(0), theVector(0), theLoad(0),
     firstWarning(true)
 {
@@ -311,6 +311,12 @@ EETwoNodeLink::EETwoNodeLink(int tag, int dim, int Nd1, int Nd2,
         else
             theChannel = new UDP_Socket(port, machineInetAddr);
     }
+    else if (shm)  {
+        if (machineInetAddr == 0)
+            theChannel = new SharedMemoryChannel(port, "127.0.0.1");
+        else
+            theChannel = new SharedMemoryChannel(port, machineInetAddr);
+    }
     else  {
         if (machineInetAddr == 0)
             theChannel = new TCP_Socket(port, "127.0.0.1");
@@ -385,8 +391,6 @@ EETwoNodeLink::EETwoNodeLink(int tag, int dim, int Nd1, int Nd2,
     vbCtrl.Zero();
     abCtrl.Zero();
     dbLast.Zero();
-    dbDaqLast.Zero();
-    qbDaqLast.Zero();
 }
 
 
@@ -563,6 +567,11 @@ void EETwoNodeLink::setDomain(Domain *theDomain)
     dl.resize(numDOF);
     dl.Zero();
     
+    // set the sizes of the work vectors and matrices
+    dg.resize(numDOF); vg.resize(numDOF); ag.resize(numDOF);
+    vl.resize(numDOF); al.resize(numDOF); ql.resize(numDOF);
+    kl.resize(numDOF, numDOF);
+    
     // allocate memory for the load vector
     if (theLoad == 0)
         theLoad = new Vector(numDOF);
@@ -603,16 +612,14 @@ int EETwoNodeLink::commitState()
     // commit the base class
     rValue += this->Element::commitState();
     
-    // update dbLast
+    // update dbLast (vl is used as work vector for the local displacements)
     int ndim = 0, i;
-    Vector dgLast(numDOF), dlLast(numDOF);
     for (i=0; i<2; i++)  {
-        Vector disp = theNodes[i]->getTrialDisp();
-        dgLast.Assemble(disp, ndim);
+        dg.Assemble(theNodes[i]->getTrialDisp(), ndim);
         ndim += numDOF/2;
     }
-    dlLast.addMatrixVector(0.0, Tgl, dgLast, 1.0);
-    dbLast.addMatrixVector(0.0, Tlb, dlLast, 1.0);
+    vl.addMatrixVector(0.0, Tgl, dg, 1.0);
+    dbLast.addMatrixVector(0.0, Tlb, vl, 1.0);
     
     return rValue;
 }
@@ -620,14 +627,14 @@ int EETwoNodeLink::commitState()
 
 int EETwoNodeLink::update()
 {
+    ExpTimer timer(OF_Timing_Element);
+    
     int rValue = 0;
+    this->startAllocCount();
     
     // save the last response parameters
     tLast = (*t)(0);
     dbLast = (*db);
-    dbDaqLast = (*dbDaq);
-    qbDaqLast = (*qbDaq);
-    kbLast = kb;
     
     // get current time
     Domain *theDomain = this->getDomain();
@@ -635,19 +642,14 @@ int EETwoNodeLink::update()
     
     // get global trial response
     int ndim = 0, i;
-    Vector dg(numDOF), vg(numDOF), ag(numDOF);
     for (i=0; i<2; i++)  {
-        Vector disp = theNodes[i]->getTrialDisp();
-        Vector vel = theNodes[i]->getTrialVel();
-        Vector accel = theNodes[i]->getTrialAccel();
-        dg.Assemble(disp, ndim);
-        vg.Assemble(vel, ndim);
-        ag.Assemble(accel, ndim);
+        dg.Assemble(theNodes[i]->getTrialDisp(), ndim);
+        vg.Assemble(theNodes[i]->getTrialVel(), ndim);
+        ag.Assemble(theNodes[i]->getTrialAccel(), ndim);
         ndim += numDOF/2;
     }
     
     // transform response from the global to the local system
-    Vector vl(numDOF), al(numDOF);
     dl.addMatrixVector(0.0, Tgl, dg, 1.0);
     vl.addMatrixVector(0.0, Tgl, vg, 1.0);
     al.addMatrixVector(0.0, Tgl, ag, 1.0);
@@ -657,12 +659,11 @@ int EETwoNodeLink::update()
     vb->addMatrixVector(0.0, Tlb, vl, 1.0);
     ab->addMatrixVector(0.0, Tlb, al, 1.0);
     
-    // calculate incremental displacement command
-    Vector dbDelta = (*db) - dbLast;
+    // check for a change in the displacement command
     // do not check time for right now because of transformation constraint
     // handler calling update at beginning of new step when applying load
-    // if (dbDelta.pNorm(0) > DBL_EPSILON || (*t)(0) > tLast)  {
-    if (dbDelta.pNorm(0) > DBL_EPSILON)  {
+    // if (maxAbsDiff(*db, dbLast) > DBL_EPSILON || (*t)(0) > tLast)  {
+    if (maxAbsDiff(*db, dbLast) > DBL_EPSILON)  {
         // set the trial response at the site
         if (theSite != 0)  {
             theSite->setTrialResponse(db, vb, ab, (Vector*)0, t);
@@ -685,17 +686,17 @@ int EETwoNodeLink::setInitialStiff(const Matrix& kbinit)
             << this->getTag() << endln;
         return -1;
     }
-    kb = kbInit = kbLast = kbinit;
+    kb = kbInit = kbinit;
+    this->setBasicInitStiff(kbInit);
     
     // zero the global matrix
     theInitStiff.Zero();
     
     // transform from basic to local system
-    Matrix klInit(numDOF, numDOF);
-    klInit.addMatrixTripleProduct(0.0, Tlb, kbInit, 1.0);
+    kl.addMatrixTripleProduct(0.0, Tlb, kbInit, 1.0);
     
     // transform from local to global system
-    theInitStiff.addMatrixTripleProduct(0.0, Tgl, klInit, 1.0);
+    theInitStiff.addMatrixTripleProduct(0.0, Tgl, kl, 1.0);
     
     return 0;
 }
@@ -711,18 +712,14 @@ const Matrix& EETwoNodeLink::getTangentStiff()
         this->getBasicDisp();
         this->getBasicForce();
         
-        // calculate incremental displacement and force vectors
-        Vector dbDaqIncr = (*dbDaq) - dbDaqLast;
-        Vector qbDaqIncr = (*qbDaq) - qbDaqLast;
-        
         // get updated kb matrix
-        kb = theTangStiff->updateTangentStiff(&dbDaqIncr, (Vector*)0,
-            (Vector*)0, &qbDaqIncr, (Vector*)0, &kbInit, &kbLast);
+        kb = this->getBasicTangentStiff(*dbDaq, *qbDaq);
         
         // apply optional initial stiffness modification
         if (iMod == true)  {
             // correct for displacement control errors using I-Modification
-            qbDaq->addMatrixVector(1.0, kbInit, (*dbDaq) - (*db), -1.0);
+            qbDaq->addMatrixVector(1.0, kbInit, *dbDaq, -1.0);
+            qbDaq->addMatrixVector(1.0, kbInit, *db, 1.0);
         }
     }
     else  {
@@ -747,7 +744,8 @@ const Matrix& EETwoNodeLink::getTangentStiff()
             this->getBasicDisp();
             
             // correct for displacement control errors using I-Modification
-            qbDaq->addMatrixVector(1.0, kbInit, (*dbDaq) - (*db), -1.0);
+            qbDaq->addMatrixVector(1.0, kbInit, *dbDaq, -1.0);
+            qbDaq->addMatrixVector(1.0, kbInit, *db, 1.0);
         }
     }
     
@@ -758,8 +756,7 @@ const Matrix& EETwoNodeLink::getTangentStiff()
     }
     
     // transform from basic to local system
-    Matrix kl(numDOF, numDOF);
-    kl.addMatrixTripleProduct(0.0, Tlb, kbInit, 1.0);
+    kl.addMatrixTripleProduct(0.0, Tlb, kb, 1.0);
     
     // add geometric stiffness to local stiffness
     if (Mratio.Size() == 4)
@@ -865,7 +862,8 @@ const Vector& EETwoNodeLink::getResistingForce()
         this->getBasicDisp();
         
         // correct for displacement control errors using I-Modification
-        qbDaq->addMatrixVector(1.0, kbInit, (*dbDaq) - (*db), -1.0);
+        qbDaq->addMatrixVector(1.0, kbInit, *dbDaq, -1.0);
+        qbDaq->addMatrixVector(1.0, kbInit, *db, 1.0);
     }
     
     // use elastic force if force from test is zero
@@ -880,7 +878,6 @@ const Vector& EETwoNodeLink::getResistingForce()
     abCtrl = (*ab);
     
     // determine resisting forces in local system
-    Vector ql(numDOF);
     ql.addMatrixTransposeVector(0.0, Tlb, *qbDaq, 1.0);
     
     // add P-Delta effects to local forces
@@ -893,6 +890,8 @@ const Vector& EETwoNodeLink::getResistingForce()
     // subtract external load
     theVector->addVector(1.0, *theLoad, -1.0);
     
+    this->stopAllocCount();
+    
     return *theVector;
 }
 
@@ -1236,16 +1235,12 @@ Response* EETwoNodeLink::setResponse(const char **argv, int argc,
     }
     
     // tangent stiffness output
-    else if (strcmp(argv[0],"tangStif") == 0 ||
-        strcmp(argv[0],"tangStiff") == 0 ||
-        strcmp(argv[0],"expTangStif") == 0 ||
-        strcmp(argv[0],"expTangStiff") == 0 ||
-        strcmp(argv[0],"expTangentStif") == 0 ||
-        strcmp(argv[0],"expTangentStiff") == 0)  {
-        if (theTangStiff != 0)  {
-            theResponse = theTangStiff->setResponse(&argv[1], argc-1, output);
-        }
-    }
+    if (theResponse == 0)
+        theResponse = this->setTangStiffResponse(argv, argc, output);
+    
+    // heap allocations
+    if (theResponse == 0)
+        theResponse = this->setAllocResponse(argv, argc, output);
     
     output.endTag(); // ElementOutput
     
@@ -1303,7 +1298,7 @@ int EETwoNodeLink::getResponse(int responseID, Information &eleInfo)
         return eleInfo.setVector(defoAndForce);
         
     default:
-        return 0;
+        return this->ExperimentalElement::getResponse(responseID, eleInfo);
     }
 }
 
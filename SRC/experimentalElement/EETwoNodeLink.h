@@ -60,7 +60,7 @@ public:
         int addRayleigh = 1, double mass = 0.0);
     EETwoNodeLink(int tag, int dimension, int Nd1, int Nd2,
         const ID &direction, int port, char *machineInetAddress = 0,
-        int ssl = 0, int udp = 0, int dataSize = OF_Network_dataSize,
+        int ssl = 0, int udp = 0, int shm = 0, int dataSize = OF_Network_dataSize,
         ExperimentalTangentStiff *tangStiff = 0,
         const Vector y = 0, const Vector x = 0, const Vector Mratio = 0,
         const Vector shearDistI = 0, bool iMod = false,
@@ -169,16 +169,16 @@ private:
     Vector abCtrl;      // ctrl accelerations in basic system
     
     Vector dl;          // displacements in local system
+    Vector dg, vg, ag;  // work vectors for response in global system
+    Vector vl, al, ql;  // work vectors for response in local system
+    Matrix kl;          // work matrix for stiffness in local system
     Matrix Tgl;         // transformation matrix from global to local system
     Matrix Tlb;         // transformation matrix from local to basic system
     
     Matrix kb;          // tangent stiffness matrix in basic system
     Matrix kbInit;      // initial stiffness matrix in basic system
-    Matrix kbLast;      // tangent stiffness matrix in basic system at last update
     
     Vector dbLast;      // displacements in basic system at last update
-    Vector dbDaqLast;   // daq disp in basic system at last update
-    Vector qbDaqLast;   // daq force in basic system at last update
     double tLast;       // time at last update
     
     Matrix *theMatrix;  // pointer to objects matrix (a class wide Matrix)
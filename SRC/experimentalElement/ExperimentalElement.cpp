@@ -40,6 +40,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+// allocation counter of a test driver (see setAllocCounter)
+static long (*theAllocCounter)() = 0;
+
 
 ExperimentalElement::ExperimentalElement(int tag,
     int classTag,
@@ -49,7 +52,11 @@ ExperimentalElement::ExperimentalElement(int tag,
     theSite(site), theTangStiff(0),
     sizeCtrl(0), sizeDaq(0),
     theInitStiff(1,1),
-    firstWarning(true)
+    firstWarning(true), allocCounting(false),
+    allocStart(0), numAllocations(0),
+    tangDOF(0), kbTang(1,1), kbTangInit(1,1), kbTangLast(1,1),
+    dbTangLast(1), qbTangLast(1), dbTangIncr(1), qbTangIncr(1),
+    tangStarted(false)
 {
     // get copy of experimental tangent stiffness
     if (tang != 0)  {
@@ -75,6 +82,8 @@ ExperimentalElement::~ExperimentalElement()
         delete sizeCtrl;
     if (sizeDaq != 0)
         delete sizeDaq;
+    if (tangDOF != 0)
+        delete tangDOF;
 }
 
 
@@ -137,6 +146,184 @@ const Vector& ExperimentalElement::getTime()
 }
 
 
+int ExperimentalElement::getNumAllocations() const
+{
+    return numAllocations;
+}
+
+
+long ExperimentalElement::getTotalNumAllocations()
+{
+    if (theAllocCounter != 0)
+        return theAllocCounter();
+    
+    return 0;
+}
+
+
+void ExperimentalElement::setAllocCounter(long (*counter)())
+{
+    theAllocCounter = counter;
+}
+
+
+int ExperimentalElement::getResponse(int responseID, Information &eleInfo)
+{
+    switch (responseID)  {
+    case 101:  // heap allocations of last state determination
+        return eleInfo.setDouble(numAllocations);
+        
+    default:
+        return -1;
+    }
+}
+
+
+void ExperimentalElement::startAllocCount()
+{
+    allocStart = getTotalNumAllocations();
+    allocCounting = true;
+}
+
+
+void ExperimentalElement::stopAllocCount()
+{
+    // getResistingForce can be called without a preceding update
+    if (allocCounting)  {
+        numAllocations = (int)(getTotalNumAllocations() - allocStart);
+        allocCounting = false;
+    }
+}
+
+
+Response* ExperimentalElement::setAllocResponse(const char **argv,
+    int argc, OPS_Stream &output)
+{
+    Response *theResponse = 0;
+    
+    if (argc > 0 && (strcmp(argv[0],"numAllocations") == 0 ||
+        strcmp(argv[0],"allocations") == 0))
+    {
+        output.tag("ResponseType","numAllocations");
+        
+        theResponse = new ElementResponse(this, 101, 0.0);
+    }
+    
+    return theResponse;
+}
+
+
+double ExperimentalElement::maxAbsDiff(const Vector &a, const Vector &b)
+{
+    double maxDiff = 0.0;
+    int size = a.Size();
+    for (int i=0; i<size; i++)  {
+        double diff = fabs(a(i) - b(i));
+        if (diff > maxDiff)
+            maxDiff = diff;
+    }
+    
+    return maxDiff;
+}
+
+
+int ExperimentalElement::setBasicInitStiff(const Matrix &kbInit,
+    const ID *dof)
+{
+    int numDOF = kbInit.noRows();
+    if (kbInit.noCols() != numDOF ||
+        (dof != 0 && dof->Size() != numDOF))  {
+        opserr << "ExperimentalElement::setBasicInitStiff() - "
+            << "Element: " << this->getTag() << endln
+            << "initial stiffness and dof ID do not match.\n";
+        return OF_ReturnType_failed;
+    }
+    
+    if (tangDOF != 0)  {
+        delete tangDOF;
+        tangDOF = 0;
+    }
+    if (dof != 0)
+        tangDOF = new ID(*dof);
+    
+    // size the work space once and restart the estimation
+    if (kbTang.noRows() != numDOF)  {
+        kbTang.resize(numDOF, numDOF);
+        kbTangInit.resize(numDOF, numDOF);
+        kbTangLast.resize(numDOF, numDOF);
+        dbTangLast.resize(numDOF);
+        qbTangLast.resize(numDOF);
+        dbTangIncr.resize(numDOF);
+        qbTangIncr.resize(numDOF);
+    }
+    kbTang = kbTangInit = kbTangLast = kbInit;
+    dbTangLast.Zero();
+    qbTangLast.Zero();
+    tangStarted = false;
+    
+    return OF_ReturnType_completed;
+}
+
+
+const Matrix& ExperimentalElement::getBasicTangentStiff(
+    const Vector &dbDaq, const Vector &qbDaq)
+{
+    if (theTangStiff == 0)
+        return kbTangInit;
+    
+    // calculate incremental displacement and force vectors
+    int numDOF = kbTang.noRows();
+    int i, j;
+    for (i=0; i<numDOF; i++)  {
+        j = (tangDOF != 0) ? (*tangDOF)(i) : i;
+        dbTangIncr(i) = dbDaq(j) - dbTangLast(i);
+        qbTangIncr(i) = qbDaq(j) - qbTangLast(i);
+    }
+    
+    // the first call only stores the daq response
+    if (tangStarted == false)  {
+        dbTangLast += dbTangIncr;
+        qbTangLast += qbTangIncr;
+        tangStarted = true;
+        return kbTang;
+    }
+    
+    // keep the last estimate if the specimen has not moved
+    if (dbTangIncr.pNorm(0) == 0.0)
+        return kbTang;
+    
+    dbTangLast += dbTangIncr;
+    qbTangLast += qbTangIncr;
+    
+    // get updated kb matrix
+    kbTangLast = kbTang;
+    kbTang = theTangStiff->updateTangentStiff(&dbTangIncr, (Vector*)0,
+        (Vector*)0, &qbTangIncr, (Vector*)0, &kbTangInit, &kbTangLast);
+    
+    return kbTang;
+}
+
+
+Response* ExperimentalElement::setTangStiffResponse(const char **argv,
+    int argc, OPS_Stream &output)
+{
+    Response *theResponse = 0;
+    
+    if (argc > 0 && (strcmp(argv[0],"tangStif") == 0 ||
+        strcmp(argv[0],"tangStiff") == 0 ||
+        strcmp(argv[0],"expTangStif") == 0 ||
+        strcmp(argv[0],"expTangStiff") == 0 ||
+        strcmp(argv[0],"expTangentStif") == 0 ||
+        strcmp(argv[0],"expTangentStiff") == 0))
+    {
+        if (theTangStiff != 0)
+            theResponse = theTangStiff->setResponse(&argv[1], argc-1, output);
+    }
+    
+    return theResponse;
+}
+
+
 int ExperimentalElement::revertToLastCommit()
 {
     opserr << "ExperimentalElement::revertToLastCommit() - "
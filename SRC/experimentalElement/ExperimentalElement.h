@@ -69,8 +69,42 @@ public:
     virtual const Vector &getVel();
     virtual const Vector &getAccel();
     virtual const Vector &getTime();
+    
+    // public methods to obtain the number of heap allocations, these are
+    // only counted if a test driver has installed an allocation counter
+    // and zero otherwise, the library itself does not replace the global
+    // operator new, the counter should only count the allocations of the
+    // calling thread (e.g. a thread_local count kept by the operator new
+    // of the test driver)
+    int getNumAllocations() const;
+    static long getTotalNumAllocations();
+    static void setAllocCounter(long (*counter)());
+    
+    // public methods for element recorder
+    int getResponse(int responseID, Information &eleInfo);
 
 protected:
+    // methods to count the heap allocations of one state determination,
+    // i.e. from the start of update() to the end of getResistingForce()
+    void startAllocCount();
+    void stopAllocCount();
+    Response *setAllocResponse(const char **argv, int argc,
+        OPS_Stream &output);
+    
+    // method to compare two vectors without creating a temporary
+    static double maxAbsDiff(const Vector &a, const Vector &b);
+    
+    // methods to estimate the tangent stiffness of the experimental DOF
+    // in the basic system with the ExperimentalTangentStiff object from
+    // the daq displacement and force increments between two successive
+    // calls, the optional dof ID selects the components of the daq
+    // vectors that belong to the experimental DOF (default all)
+    int setBasicInitStiff(const Matrix &kbInit, const ID *dof = 0);
+    const Matrix &getBasicTangentStiff(const Vector &dbDaq,
+        const Vector &qbDaq);
+    Response *setTangStiffResponse(const char **argv, int argc,
+        OPS_Stream &output);
+    
     // pointer to ExperimentalSite object
     ExperimentalSite* theSite;
     // pointer to ExperimentalTangentStiff object
@@ -91,6 +125,20 @@ private:
     int revertToStart();
     
     bool firstWarning;
+    
+    bool allocCounting;     // flag if allocations are being counted
+    long allocStart;        // allocation count at start of update
+    int numAllocations;     // allocations of last state determination
+    
+    ID *tangDOF;            // daq components of the experimental DOF
+    Matrix kbTang;          // estimated tangent stiffness in basic system
+    Matrix kbTangInit;      // initial stiffness in basic system
+    Matrix kbTangLast;      // tangent stiffness at last estimation
+    Vector dbTangLast;      // daq displacements at last estimation
+    Vector qbTangLast;      // daq forces at last estimation
+    Vector dbTangIncr;      // daq displacement increments
+    Vector qbTangIncr;      // daq force increments
+    bool tangStarted;       // flag if the daq response has been stored
 };
 
 #endif
@@ -40,6 +40,7 @@
 #include <EEBeamColumn3d.h>
 
 extern ExperimentalSite *getExperimentalSite(int tag);
+extern ExperimentalTangentStiff *getExperimentalTangentStiff(int tag);
 
 
 static void printCommand(int argc, TCL_Char **argv)
@@ -71,17 +72,18 @@ int addEEBeamColumn(ClientData clientData, Tcl_Interp *interp, int argc,
         if ((argc-eleArgStart) < 17)  {
             opserr << "WARNING insufficient arguments\n";
             printCommand(argc, argv);
-            opserr << "Want: expElement beamColumn eleTag iNode jNode transTag -site siteTag -initStif Kij <-iMod> <-noRayleigh> <-rho rho> <-cMass>\n";
-            opserr << "  or: expElement beamColumn eleTag iNode jNode transTag -server ipPort <ipAddr> <-ssl> <-udp> <-dataSize size> -initStif Kij <-iMod> <-noRayleigh> <-rho rho> <-cMass>\n";
+            opserr << "Want: expElement beamColumn eleTag iNode jNode transTag -site siteTag -initStif Kij <-tangStif tangStifTag> <-iMod> <-noRayleigh> <-rho rho> <-cMass>\n";
+            opserr << "  or: expElement beamColumn eleTag iNode jNode transTag -server ipPort <ipAddr> <-ssl> <-udp> <-shm> <-dataSize size> -initStif Kij <-tangStif tangStifTag> <-iMod> <-noRayleigh> <-rho rho> <-cMass>\n";
             return TCL_ERROR;
         }
         
         // get the id and end nodes
-        int iNode, jNode, transId, siteTag, ipPort, i, j, k;
+        int iNode, jNode, transId, siteTag, tangStifTag, ipPort, i, j, k;
         CrdTransf *theTrans = 0;
         ExperimentalSite *theSite = 0;
+        ExperimentalTangentStiff *theTangStif = 0;
         char *ipAddr = 0;
-        int ssl = 0, udp = 0;
+        int ssl = 0, udp = 0, shm = 0;
         int dataSize = OF_Network_dataSize;
         bool iMod = false;
         int doRayleigh = 1;
@@ -136,6 +138,7 @@ int addEEBeamColumn(ClientData clientData, Tcl_Interp *interp, int argc,
             if (strcmp(argv[7+eleArgStart], "-initStif") != 0  &&
                 strcmp(argv[7+eleArgStart], "-ssl") != 0  &&
                 strcmp(argv[7+eleArgStart], "-udp") != 0  &&
+                strcmp(argv[7+eleArgStart], "-shm") != 0  &&
                 strcmp(argv[7+eleArgStart], "-dataSize") != 0)  {
                     ipAddr = new char [strlen(argv[7+eleArgStart])+1];
                     strcpy(ipAddr,argv[7+eleArgStart]);
@@ -149,6 +152,8 @@ int addEEBeamColumn(ClientData clientData, Tcl_Interp *interp, int argc,
                     ssl = 1;
                 else if (strcmp(argv[i], "-udp") == 0)
                     udp = 1;
+                else if (strcmp(argv[i], "-shm") == 0)
+                    shm = 1;
                 else if (strcmp(argv[i], "-dataSize") == 0)  {
                     if (Tcl_GetInt(interp, argv[i+1], &dataSize) != TCL_OK)  {
                         opserr << "WARNING invalid dataSize\n";
@@ -164,6 +169,22 @@ int addEEBeamColumn(ClientData clientData, Tcl_Interp *interp, int argc,
             opserr << "expElement beamColumn element: " << tag << endln;
             return TCL_ERROR;
         }
+        for (i = 7+eleArgStart; i < argc; i++)  {
+            if (strcmp(argv[i], "-tangStif") == 0)  {
+                if (Tcl_GetInt(interp, argv[i+1], &tangStifTag) != TCL_OK)  {
+                    opserr << "WARNING invalid tangStifTag\n";
+                    opserr << "expElement beamColumn element: " << tag << endln;
+                    return TCL_ERROR;
+                }
+                theTangStif = getExperimentalTangentStiff(tangStifTag);
+                if (theTangStif == 0)  {
+                    opserr << "WARNING experimental tangent stiff not found\n";
+                    opserr << "expTangStiff: " << tangStifTag << endln;
+                    opserr << "expElement beamColumn element: " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
+        }
         for (i = 7+eleArgStart; i < argc; i++)  {
             if (strcmp(argv[i], "-iMod") == 0)  {
                 iMod = true;
@@ -194,10 +215,10 @@ int addEEBeamColumn(ClientData clientData, Tcl_Interp *interp, int argc,
         // now create the EEBeamColumn
         if (theSite != 0)  {
             theExpElement = new EEBeamColumn2d(tag, iNode, jNode, *theTrans,
-                theSite, iMod, doRayleigh, rho, cMass);
+                theSite, theTangStif, iMod, doRayleigh, rho, cMass);
         } else  {
             theExpElement = new EEBeamColumn2d(tag, iNode, jNode, *theTrans,
-                ipPort, ipAddr, ssl, udp, dataSize, iMod, doRayleigh, rho, cMass);
+                ipPort, ipAddr, ssl, udp, shm, dataSize, theTangStif, iMod, doRayleigh, rho, cMass);
         }
         
         if (theExpElement == 0) {
@@ -257,17 +278,18 @@ int addEEBeamColumn(ClientData clientData, Tcl_Interp *interp, int argc,
         if ((argc-eleArgStart) < 44)  {
             opserr << "WARNING insufficient arguments\n";
             printCommand(argc, argv);
-            opserr << "Want: expElement beamColumn eleTag iNode jNode transTag -site siteTag -initStif Kij <-iMod> <-noRayleigh> <-rho rho> <-cMass>\n";
-            opserr << "  or: expElement beamColumn eleTag iNode jNode transTag -server ipPort <ipAddr> <-ssl> <-udp> <-dataSize size> -initStif Kij <-iMod> <-noRayleigh> <-rho rho> <-cMass>\n";
+            opserr << "Want: expElement beamColumn eleTag iNode jNode transTag -site siteTag -initStif Kij <-tangStif tangStifTag> <-iMod> <-noRayleigh> <-rho rho> <-cMass>\n";
+            opserr << "  or: expElement beamColumn eleTag iNode jNode transTag -server ipPort <ipAddr> <-ssl> <-udp> <-shm> <-dataSize size> -initStif Kij <-tangStif tangStifTag> <-iMod> <-noRayleigh> <-rho rho> <-cMass>\n";
             return TCL_ERROR;
         }
         
         // get the id and end nodes
-        int iNode, jNode, transId, siteTag, ipPort, i, j, k;
+        int iNode, jNode, transId, siteTag, tangStifTag, ipPort, i, j, k;
         CrdTransf *theTrans = 0;
         ExperimentalSite *theSite = 0;
+        ExperimentalTangentStiff *theTangStif = 0;
         char *ipAddr = 0;
-        int ssl = 0, udp = 0;
+        int ssl = 0, udp = 0, shm = 0;
         int dataSize = OF_Network_dataSize;
         bool iMod = false;
         int doRayleigh = 1;
@@ -322,6 +344,7 @@ int addEEBeamColumn(ClientData clientData, Tcl_Interp *interp, int argc,
             if (strcmp(argv[7+eleArgStart], "-initStif") != 0 &&
                 strcmp(argv[7+eleArgStart], "-ssl") != 0 &&
                 strcmp(argv[7+eleArgStart], "-udp") != 0 &&
+                strcmp(argv[7+eleArgStart], "-shm") != 0 &&
                 strcmp(argv[7+eleArgStart], "-dataSize") != 0)  {
                     ipAddr = new char [strlen(argv[7+eleArgStart])+1];
                     strcpy(ipAddr,argv[7+eleArgStart]);
@@ -335,6 +358,8 @@ int addEEBeamColumn(ClientData clientData, Tcl_Interp *interp, int argc,
                     ssl = 1;
                 else if (strcmp(argv[i], "-udp") == 0)
                     udp = 1;
+                else if (strcmp(argv[i], "-shm") == 0)
+                    shm = 1;
                 else if (strcmp(argv[i], "-dataSize") == 0)  {
                     if (Tcl_GetInt(interp, argv[i+1], &dataSize) != TCL_OK)  {
                         opserr << "WARNING invalid dataSize\n";
@@ -350,6 +375,22 @@ int addEEBeamColumn(ClientData clientData, Tcl_Interp *interp, int argc,
             opserr << "expElement beamColumn element: " << tag << endln;
             return TCL_ERROR;
         }
+        for (i = 7+eleArgStart; i < argc; i++)  {
+            if (strcmp(argv[i], "-tangStif") == 0)  {
+                if (Tcl_GetInt(interp, argv[i+1], &tangStifTag) != TCL_OK)  {
+                    opserr << "WARNING invalid tangStifTag\n";
+                    opserr << "expElement beamColumn element: " << tag << endln;
+                    return TCL_ERROR;
+                }
+                theTangStif = getExperimentalTangentStiff(tangStifTag);
+                if (theTangStif == 0)  {
+                    opserr << "WARNING experimental tangent stiff not found\n";
+                    opserr << "expTangStiff: " << tangStifTag << endln;
+                    opserr << "expElement beamColumn element: " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
+        }
         for (i = 7+eleArgStart; i < argc; i++)  {
             if (strcmp(argv[i], "-iMod") == 0)  {
                 iMod = true;
@@ -380,10 +421,10 @@ int addEEBeamColumn(ClientData clientData, Tcl_Interp *interp, int argc,
         // now create the EEBeamColumn
         if (theSite != 0)  {
             theExpElement = new EEBeamColumn3d(tag, iNode, jNode, *theTrans,
-                theSite, iMod, doRayleigh, rho, cMass);
+                theSite, theTangStif, iMod, doRayleigh, rho, cMass);
         } else  {
             theExpElement = new EEBeamColumn3d(tag, iNode, jNode, *theTrans,
-                ipPort, ipAddr, ssl, udp, dataSize, iMod, doRayleigh, rho, cMass);
+                ipPort, ipAddr, ssl, udp, shm, dataSize, theTangStif, iMod, doRayleigh, rho, cMass);
         }
         
         if (theExpElement == 0) {
@@ -40,6 +40,7 @@
 #include <EEBearing3d.h>
 
 extern ExperimentalSite *getExperimentalSite(int tag);
+extern ExperimentalTangentStiff *getExperimentalTangentStiff(int tag);
 
 
 static void printCommand(int argc, TCL_Char **argv)
@@ -71,17 +72,18 @@ int addEEBearing(ClientData clientData, Tcl_Interp *interp, int argc,
 		if ((argc-eleArgStart) < 13)  {
 			opserr << "WARNING insufficient arguments\n";
 			printCommand(argc, argv);
-			opserr << "Want: expElement bearing eleTag iNode jNode pFrcCtrl -P matTag -Mz matTag -site siteTag -initStif Kij <-orient x1 x2 x3 y1 y2 y3> <-pDelta Mratios> <-shearDist sDratio> <-iMod> <-doRayleigh> <-mass m>\n";
-			opserr << "  or: expElement bearing eleTag iNode jNode pFrcCtrl -P matTag -Mz matTag -server ipPort <ipAddr> <-ssl> <-udp> <-dataSize size> -initStif Kij <-orient x1 x2 x3 y1 y2 y3> <-pDelta Mratios> <-shearDist sDratio> <-iMod> <-doRayleigh> <-mass m>\n";
+			opserr << "Want: expElement bearing eleTag iNode jNode pFrcCtrl -P matTag -Mz matTag -site siteTag -initStif Kij <-orient x1 x2 x3 y1 y2 y3> <-pDelta Mratios> <-shearDist sDratio> <-tangStif tangStifTag> <-iMod> <-doRayleigh> <-mass m>\n";
+			opserr << "  or: expElement bearing eleTag iNode jNode pFrcCtrl -P matTag -Mz matTag -server ipPort <ipAddr> <-ssl> <-udp> <-shm> <-dataSize size> -initStif Kij <-orient x1 x2 x3 y1 y2 y3> <-pDelta Mratios> <-shearDist sDratio> <-tangStif tangStifTag> <-iMod> <-doRayleigh> <-mass m>\n";
 			return TCL_ERROR;
 		}
 		
 		// get the id and end nodes
-		int iNode, jNode, pFrcCtrl, matTag, siteTag, ipPort, i, j, k;
+		int iNode, jNode, pFrcCtrl, matTag, siteTag, tangStifTag, ipPort, i, j, k;
         UniaxialMaterial *theMaterials[2];
         ExperimentalSite *theSite = 0;
+        ExperimentalTangentStiff *theTangStif = 0;
         char *ipAddr = 0;
-        int ssl = 0, udp = 0;
+        int ssl = 0, udp = 0, shm = 0;
         int dataSize = OF_Network_dataSize;
         Vector Mratio(0);
         double shearDistI = 0.5;
@@ -159,6 +161,7 @@ int addEEBearing(ClientData clientData, Tcl_Interp *interp, int argc,
             if (strcmp(argv[11+eleArgStart], "-initStif") != 0  &&
                 strcmp(argv[11+eleArgStart], "-ssl") != 0  &&
                 strcmp(argv[11+eleArgStart], "-udp") != 0  &&
+                strcmp(argv[11+eleArgStart], "-shm") != 0  &&
                 strcmp(argv[11+eleArgStart], "-dataSize") != 0)  {
                 ipAddr = new char [strlen(argv[11+eleArgStart])+1];
                 strcpy(ipAddr,argv[11+eleArgStart]);
@@ -172,6 +175,8 @@ int addEEBearing(ClientData clientData, Tcl_Interp *interp, int argc,
                     ssl = 1;
                 else if (strcmp(argv[i], "-udp") == 0)
                     udp = 1;
+                else if (strcmp(argv[i], "-shm") == 0)
+                    shm = 1;
                 else if (strcmp(argv[i], "-dataSize") == 0)  {
                     if (Tcl_GetInt(interp, argv[i+1], &dataSize) != TCL_OK)  {
 		                opserr << "WARNING invalid dataSize\n";
@@ -256,6 +261,22 @@ int addEEBearing(ClientData clientData, Tcl_Interp *interp, int argc,
                     return TCL_ERROR;
                 }
             }
+        }
+        for (i = 11+eleArgStart; i < argc; i++)  {
+            if (strcmp(argv[i], "-tangStif") == 0)  {
+                if (Tcl_GetInt(interp, argv[i+1], &tangStifTag) != TCL_OK)  {
+                    opserr << "WARNING invalid tangStifTag\n";
+                    opserr << "expElement bearing element: " << tag << endln;
+                    return TCL_ERROR;
+                }
+                theTangStif = getExperimentalTangentStiff(tangStifTag);
+                if (theTangStif == 0)  {
+                    opserr << "WARNING experimental tangent stiff not found\n";
+                    opserr << "expTangStiff: " << tangStifTag << endln;
+                    opserr << "expElement bearing element: " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
         }
 		for (i = 11+eleArgStart; i < argc; i++)  {
 			if (strcmp(argv[i], "-iMod") == 0)  {
@@ -282,10 +303,10 @@ int addEEBearing(ClientData clientData, Tcl_Interp *interp, int argc,
 		// now create the EEBearing
         if (theSite != 0)  {
 		    theExpElement = new EEBearing2d(tag, iNode, jNode, pFrcCtrl, theMaterials,
-                theSite, y, x, Mratio, shearDistI, iMod, doRayleigh, mass);
+                theSite, theTangStif, y, x, Mratio, shearDistI, iMod, doRayleigh, mass);
         } else  {
 		    theExpElement = new EEBearing2d(tag, iNode, jNode, pFrcCtrl, theMaterials,
-                ipPort, ipAddr, ssl, udp, dataSize, y, x, Mratio, shearDistI,
+                ipPort, ipAddr, ssl, udp, shm, dataSize, theTangStif, y, x, Mratio, shearDistI,
                 iMod, doRayleigh, mass);
         }
 		
@@ -346,17 +367,18 @@ int addEEBearing(ClientData clientData, Tcl_Interp *interp, int argc,
 		if ((argc-eleArgStart) < 20)  {
 			opserr << "WARNING insufficient arguments\n";
 			printCommand(argc, argv);
-			opserr << "Want: expElement bearing eleTag iNode jNode pFrcCtrl -P matTag -T matTag -My matTag -Mz matTag -site siteTag -initStif Kij <-orient <x1 x2 x3> y1 y2 y3> <-pDelta Mratios> <-shearDist sDratio> <-iMod> <-doRayleigh> <-mass m>\n";
-			opserr << "  or: expElement bearing eleTag iNode jNode pFrcCtrl -P matTag -T matTag -My matTag -Mz matTag -server ipPort <ipAddr> <-ssl> <-udp> <-dataSize size> -initStif Kij <-orient <x1 x2 x3> y1 y2 y3> <-pDelta Mratios> <-shearDist sDratio> <-iMod> <-doRayleigh> <-mass m>\n";
+			opserr << "Want: expElement bearing eleTag iNode jNode pFrcCtrl -P matTag -T matTag -My matTag -Mz matTag -site siteTag -initStif Kij <-orient <x1 x2 x3> y1 y2 y3> <-pDelta Mratios> <-shearDist sDratio> <-tangStif tangStifTag> <-iMod> <-doRayleigh> <-mass m>\n";
+			opserr << "  or: expElement bearing eleTag iNode jNode pFrcCtrl -P matTag -T matTag -My matTag -Mz matTag -server ipPort <ipAddr> <-ssl> <-udp> <-shm> <-dataSize size> -initStif Kij <-orient <x1 x2 x3> y1 y2 y3> <-pDelta Mratios> <-shearDist sDratio> <-tangStif tangStifTag> <-iMod> <-doRayleigh> <-mass m>\n";
 			return TCL_ERROR;
 		}
 		
 		// get the id and end nodes
-		int iNode, jNode, pFrcCtrl, matTag, siteTag, ipPort, i, j, k;
+		int iNode, jNode, pFrcCtrl, matTag, siteTag, tangStifTag, ipPort, i, j, k;
         UniaxialMaterial *theMaterials[4];
         ExperimentalSite *theSite = 0;
+        ExperimentalTangentStiff *theTangStif = 0;
         char *ipAddr = 0;
-        int ssl = 0, udp = 0;
+        int ssl = 0, udp = 0, shm = 0;
         int dataSize = OF_Network_dataSize;
         Vector Mratio(0);
         double shearDistI = 0.5;
@@ -462,6 +484,7 @@ int addEEBearing(ClientData clientData, Tcl_Interp *interp, int argc,
             if (strcmp(argv[15+eleArgStart], "-initStif") != 0  &&
                 strcmp(argv[15+eleArgStart], "-ssl") != 0  &&
                 strcmp(argv[15+eleArgStart], "-udp") != 0  &&
+                strcmp(argv[15+eleArgStart], "-shm") != 0  &&
                 strcmp(argv[15+eleArgStart], "-dataSize") != 0)  {
                 ipAddr = new char [strlen(argv[15+eleArgStart])+1];
                 strcpy(ipAddr,argv[15+eleArgStart]);
@@ -475,6 +498,8 @@ int addEEBearing(ClientData clientData, Tcl_Interp *interp, int argc,
                     ssl = 1;
                 else if (strcmp(argv[i], "-udp") == 0)
                     udp = 1;
+                else if (strcmp(argv[i], "-shm") == 0)
+                    shm = 1;
                 else if (strcmp(argv[i], "-dataSize") == 0)  {
                     if (Tcl_GetInt(interp, argv[i+1], &dataSize) != TCL_OK)  {
 		                opserr << "WARNING invalid dataSize\n";
@@ -571,6 +596,22 @@ int addEEBearing(ClientData clientData, Tcl_Interp *interp, int argc,
                     return TCL_ERROR;
                 }
             }
+        }
+        for (i = 15+eleArgStart; i < argc; i++)  {
+            if (strcmp(argv[i], "-tangStif") == 0)  {
+                if (Tcl_GetInt(interp, argv[i+1], &tangStifTag) != TCL_OK)  {
+                    opserr << "WARNING invalid tangStifTag\n";
+                    opserr << "expElement bearing element: " << tag << endln;
+                    return TCL_ERROR;
+                }
+                theTangStif = getExperimentalTangentStiff(tangStifTag);
+                if (theTangStif == 0)  {
+                    opserr << "WARNING experimental tangent stiff not found\n";
+                    opserr << "expTangStiff: " << tangStifTag << endln;
+                    opserr << "expElement bearing element: " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
         }
 		for (i = 15+eleArgStart; i < argc; i++)  {
 			if (strcmp(argv[i], "-iMod") == 0)  {
@@ -597,10 +638,10 @@ int addEEBearing(ClientData clientData, Tcl_Interp *interp, int argc,
 		// now create the EEBearing
         if (theSite != 0)  {
 		    theExpElement = new EEBearing3d(tag, iNode, jNode, pFrcCtrl, theMaterials,
-                theSite, y, x, Mratio, shearDistI, iMod, doRayleigh, mass);
+                theSite, theTangStif, y, x, Mratio, shearDistI, iMod, doRayleigh, mass);
         } else  {
 		    theExpElement = new EEBearing3d(tag, iNode, jNode, pFrcCtrl, theMaterials,
-                ipPort, ipAddr, ssl, udp, dataSize, y, x, Mratio, shearDistI,
+                ipPort, ipAddr, ssl, udp, shm, dataSize, theTangStif, y, x, Mratio, shearDistI,
                 iMod, doRayleigh, mass);
         }
 		
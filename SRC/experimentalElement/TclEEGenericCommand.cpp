@@ -38,6 +38,7 @@
 #include <EEGeneric.h>
 
 extern ExperimentalSite *getExperimentalSite(int tag);
+extern ExperimentalTangentStiff *getExperimentalTangentStiff(int tag);
 
 
 static void printCommand(int argc, TCL_Char **argv)
@@ -58,18 +59,20 @@ int addEEGeneric(ClientData clientData, Tcl_Interp *interp,  int argc,
     if ((argc-eleArgStart) < 10)  {
         opserr << "WARNING insufficient arguments\n";
         printCommand(argc, argv);
-        opserr << "Want: expElement generic eleTag -node Ndi -dof dofNdi -dof dofNdj ... -site siteTag -initStif Kij <-iMod> <-noRayleigh> <-mass Mij> <-checkTime>\n";
-        opserr << "  or: expElement generic eleTag -node Ndi -dof dofNdi -dof dofNdj ... -server ipPort <ipAddr> <-ssl> <-udp> <-dataSize size> -initStif Kij <-iMod> <-noRayleigh> <-mass Mij> <-checkTime>\n";
+        opserr << "Want: expElement generic eleTag -node Ndi -dof dofNdi -dof dofNdj ... -site siteTag -initStif Kij <-tangStif tangStifTag> <-iMod> <-noRayleigh> <-mass Mij> <-checkTime>\n";
+        opserr << "  or: expElement generic eleTag -node Ndi -dof dofNdi -dof dofNdj ... -server ipPort <ipAddr> <-ssl> <-udp> <-shm> <-dataSize size> <-protocol fixed/framed> -initStif Kij <-tangStif tangStifTag> <-iMod> <-noRayleigh> <-mass Mij> <-checkTime>\n";
         return TCL_ERROR;
     }    
     
     // get the id and end nodes     
-    int tag, siteTag, node, dof, ipPort, argi, i, j, k;
+    int tag, siteTag, tangStifTag, node, dof, ipPort, argi, i, j, k;
     int numNodes = 0, numDOFj = 0, numDOF = 0;
     ExperimentalSite *theSite = 0;
+    ExperimentalTangentStiff *theTangStif = 0;
     char *ipAddr = 0;
-    int ssl = 0, udp = 0;
+    int ssl = 0, udp = 0, shm = 0;
     int dataSize = OF_Network_dataSize;
+    int protocol = OF_Network_fixed;
     bool iMod = false;
     int doRayleigh = 1;
     Matrix *mass = 0;
@@ -172,7 +175,9 @@ int addEEGeneric(ClientData clientData, Tcl_Interp *interp,  int argc,
         if (strcmp(argv[argi], "-initStif") != 0 &&
             strcmp(argv[argi], "-ssl") != 0 &&
             strcmp(argv[argi], "-udp") != 0 &&
-            strcmp(argv[argi], "-dataSize") != 0)  {
+            strcmp(argv[argi], "-shm") != 0 &&
+            strcmp(argv[argi], "-dataSize") != 0 &&
+            strcmp(argv[argi], "-protocol") != 0)  {
                 ipAddr = new char [strlen(argv[argi])+1];
                 strcpy(ipAddr,argv[argi]);
                 argi++;
@@ -186,6 +191,8 @@ int addEEGeneric(ClientData clientData, Tcl_Interp *interp,  int argc,
                 ssl = 1;
             else if (strcmp(argv[i], "-udp") == 0)
                 udp = 1;
+            else if (strcmp(argv[i], "-shm") == 0)
+                shm = 1;
             else if (strcmp(argv[i], "-dataSize") == 0)  {
                 if (Tcl_GetInt(interp, argv[i+1], &dataSize) != TCL_OK)  {
                     opserr << "WARNING invalid dataSize\n";
@@ -193,6 +200,17 @@ int addEEGeneric(ClientData clientData, Tcl_Interp *interp,  int argc,
                     return TCL_ERROR;
                 }
             }
+            else if (strcmp(argv[i], "-protocol") == 0 && i+1 < argc)  {
+                if (strcmp(argv[i+1], "fixed") == 0)
+                    protocol = OF_Network_fixed;
+                else if (strcmp(argv[i+1], "framed") == 0)
+                    protocol = OF_Network_framed;
+                else  {
+                    opserr << "WARNING invalid protocol\n";
+                    opserr << "expElement generic element: " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
         }
     }
     else  {
@@ -201,6 +219,22 @@ int addEEGeneric(ClientData clientData, Tcl_Interp *interp,  int argc,
         opserr << "expElement generic element: " << tag << endln;
         return TCL_ERROR;
     }
+    for (i=argi; i<argc; i++)  {
+        if (strcmp(argv[i], "-tangStif") == 0)  {
+            if (Tcl_GetInt(interp, argv[i+1], &tangStifTag) != TCL_OK)  {
+                opserr << "WARNING invalid tangStifTag\n";
+                opserr << "expElement generic element: " << tag << endln;
+                return TCL_ERROR;
+            }
+            theTangStif = getExperimentalTangentStiff(tangStifTag);
+            if (theTangStif == 0)  {
+                opserr << "WARNING experimental tangent stiff not found\n";
+                opserr << "expTangStiff: " << tangStifTag << endln;
+                opserr << "expElement generic element: " << tag << endln;
+                return TCL_ERROR;
+            }
+        }
+    }
     for (i=argi; i<argc; i++)  {
         if (strcmp(argv[i], "-iMod") == 0)  {
             iMod = true;
@@ -243,11 +277,11 @@ int addEEGeneric(ClientData clientData, Tcl_Interp *interp,  int argc,
     // now create the EEGeneric
     if (theSite != 0)  {
         theExpElement = new EEGeneric(tag, nodes, dofs, theSite,
-            iMod, doRayleigh, mass, checkTime);
+            theTangStif, iMod, doRayleigh, mass, checkTime);
     } else  {
         theExpElement = new EEGeneric(tag, nodes, dofs, ipPort,
-            ipAddr, ssl, udp, dataSize, iMod, doRayleigh, mass,
-            checkTime);
+            ipAddr, ssl, udp, shm, dataSize, theTangStif, iMod, doRayleigh, mass,
+            checkTime, protocol);
     }
     
     // cleanup dynamic memory
@@ -39,6 +39,7 @@
 #include <EEInvertedVBrace2d.h>
 
 extern ExperimentalSite *getExperimentalSite(int tag);
+extern ExperimentalTangentStiff *getExperimentalTangentStiff(int tag);
 
 
 static void printCommand(int argc, TCL_Char **argv)
@@ -70,16 +71,17 @@ int addEEInvertedVBrace(ClientData clientData, Tcl_Interp *interp, int argc,
 		if ((argc-eleArgStart) < 17)  {
 			opserr << "WARNING insufficient arguments\n";
 			printCommand(argc, argv);
-			opserr << "Want: expElement invertedVBrace eleTag iNode jNode kNode -site siteTag -initStif Kij <-iMod> <-nlGeom> <-noRayleigh> <-rho1 rho1> <-rho2 rho2>\n";
-			opserr << "  or: expElement invertedVBrace eleTag iNode jNode kNode -server ipPort <ipAddr> <-ssl> <-udp> <-dataSize size> -initStif Kij <-iMod> <-nlGeom> <-noRayleigh> <-rho1 rho1> <-rho2 rho2>\n";
+			opserr << "Want: expElement invertedVBrace eleTag iNode jNode kNode -site siteTag -initStif Kij <-tangStif tangStifTag> <-iMod> <-nlGeom> <-noRayleigh> <-rho1 rho1> <-rho2 rho2>\n";
+			opserr << "  or: expElement invertedVBrace eleTag iNode jNode kNode -server ipPort <ipAddr> <-ssl> <-udp> <-shm> <-dataSize size> -initStif Kij <-tangStif tangStifTag> <-iMod> <-nlGeom> <-noRayleigh> <-rho1 rho1> <-rho2 rho2>\n";
 			return TCL_ERROR;
 		}    
 		
 		// get the id and end nodes
-		int iNode, jNode, kNode, siteTag, ipPort, i, j, k;
+		int iNode, jNode, kNode, siteTag, tangStifTag, ipPort, i, j, k;
         ExperimentalSite *theSite = 0;
+        ExperimentalTangentStiff *theTangStif = 0;
         char *ipAddr = 0;
-        int ssl = 0, udp = 0;
+        int ssl = 0, udp = 0, shm = 0;
         int dataSize = OF_Network_dataSize;
         bool iMod = false;
         bool nlGeom = false;
@@ -129,6 +131,7 @@ int addEEInvertedVBrace(ClientData clientData, Tcl_Interp *interp, int argc,
             if (strcmp(argv[7+eleArgStart], "-initStif") != 0 &&
                 strcmp(argv[7+eleArgStart], "-ssl") != 0 &&
                 strcmp(argv[7+eleArgStart], "-udp") != 0 &&
+                strcmp(argv[7+eleArgStart], "-shm") != 0 &&
                 strcmp(argv[7+eleArgStart], "-dataSize") != 0)  {
                 ipAddr = new char [strlen(argv[7+eleArgStart])+1];
                 strcpy(ipAddr,argv[7+eleArgStart]);
@@ -142,6 +145,8 @@ int addEEInvertedVBrace(ClientData clientData, Tcl_Interp *interp, int argc,
                     ssl = 1;
                 else if (strcmp(argv[i], "-udp") == 0)
                     udp = 1;
+                else if (strcmp(argv[i], "-shm") == 0)
+                    shm = 1;
                 else if (strcmp(argv[i], "-dataSize") == 0)  {
                     if (Tcl_GetInt(interp, argv[i+1], &dataSize) != TCL_OK)  {
 		                opserr << "WARNING invalid dataSize\n";
@@ -157,6 +162,22 @@ int addEEInvertedVBrace(ClientData clientData, Tcl_Interp *interp, int argc,
 		    opserr << "expElement invertedVBrace element: " << tag << endln;
             return TCL_ERROR;
         }
+        for (i = 7+eleArgStart; i < argc; i++)  {
+            if (strcmp(argv[i], "-tangStif") == 0)  {
+                if (Tcl_GetInt(interp, argv[i+1], &tangStifTag) != TCL_OK)  {
+                    opserr << "WARNING invalid tangStifTag\n";
+                    opserr << "expElement invertedVBrace element: " << tag << endln;
+                    return TCL_ERROR;
+                }
+                theTangStif = getExperimentalTangentStiff(tangStifTag);
+                if (theTangStif == 0)  {
+                    opserr << "WARNING experimental tangent stiff not found\n";
+                    opserr << "expTangStiff: " << tangStifTag << endln;
+                    opserr << "expElement invertedVBrace element: " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
+        }
         for (i = 7+eleArgStart; i < argc; i++)  {
 			if (strcmp(argv[i], "-iMod") == 0)  {
                 iMod = true;
@@ -194,10 +215,10 @@ int addEEInvertedVBrace(ClientData clientData, Tcl_Interp *interp, int argc,
 		// now create the EEInvertedVBrace and add it to the Domain
         if (theSite != 0)  {
 		    theExpElement = new EEInvertedVBrace2d(tag, iNode, jNode, kNode,
-                theSite, iMod, nlGeom, doRayleigh, rho1, rho2);
+                theSite, theTangStif, iMod, nlGeom, doRayleigh, rho1, rho2);
         } else  {
 		    theExpElement = new EEInvertedVBrace2d(tag, iNode, jNode, kNode,
-                ipPort, ipAddr, ssl, udp, dataSize, iMod, nlGeom, doRayleigh,
+                ipPort, ipAddr, ssl, udp, shm, dataSize, theTangStif, iMod, nlGeom, doRayleigh,
                 rho1, rho2);
         }
 		
@@ -63,7 +63,7 @@ int addEETruss(ClientData clientData, Tcl_Interp *interp,  int argc,
         opserr << "WARNING insufficient arguments\n";
         printCommand(argc, argv);
         opserr << "Want: expElement truss eleTag iNode jNode -site siteTag -initStif Kij <-tangStif tangStifTag> <-iMod> <-noRayleigh> <-rho rho> <-cMass>\n";
-        opserr << "  or: expElement truss eleTag iNode jNode -server ipPort <ipAddr> <-ssl> <-udp> <-dataSize size> -initStif Kij <-tangStif tangStifTag> <-iMod> <-noRayleigh> <-rho rho> <-cMass>\n";
+        opserr << "  or: expElement truss eleTag iNode jNode -server ipPort <ipAddr> <-ssl> <-udp> <-shm> <-dataSize size> -initStif Kij <-tangStif tangStifTag> <-iMod> <-noRayleigh> <-rho rho> <-cMass>\n";
         return TCL_ERROR;
     }
     
@@ -72,7 +72,7 @@ int addEETruss(ClientData clientData, Tcl_Interp *interp,  int argc,
     ExperimentalSite *theSite = 0;
     ExperimentalTangentStiff *theTangStif = 0;
     char *ipAddr = 0;
-    int ssl = 0, udp = 0;
+    int ssl = 0, udp = 0, shm = 0;
     int dataSize = OF_Network_dataSize;
     bool iMod = false;
     int doRayleigh = 1;
@@ -116,6 +116,7 @@ int addEETruss(ClientData clientData, Tcl_Interp *interp,  int argc,
         if (strcmp(argv[6+eleArgStart], "-initStif") != 0  &&
             strcmp(argv[6+eleArgStart], "-ssl") != 0  &&
             strcmp(argv[6+eleArgStart], "-udp") != 0  &&
+            strcmp(argv[6+eleArgStart], "-shm") != 0  &&
             strcmp(argv[6+eleArgStart], "-dataSize") != 0)  {
                 ipAddr = new char [strlen(argv[6+eleArgStart])+1];
                 strcpy(ipAddr,argv[6+eleArgStart]);
@@ -129,6 +130,8 @@ int addEETruss(ClientData clientData, Tcl_Interp *interp,  int argc,
                 ssl = 1;
             else if (strcmp(argv[i], "-udp") == 0)
                 udp = 1;
+            else if (strcmp(argv[i], "-shm") == 0)
+                shm = 1;
             else if (strcmp(argv[i], "-dataSize") == 0)  {
                 if (Tcl_GetInt(interp, argv[i+1], &dataSize) != TCL_OK)  {
                     opserr << "WARNING invalid dataSize\n";
@@ -194,7 +197,7 @@ int addEETruss(ClientData clientData, Tcl_Interp *interp,  int argc,
                 theSite, theTangStif, iMod, doRayleigh, rho, cMass);
         } else  {
             theExpElement = new EETruss(tag, ndm, iNode, jNode,
-                ipPort, ipAddr, ssl, udp, dataSize, theTangStif,
+                ipPort, ipAddr, ssl, udp, shm, dataSize, theTangStif,
                 iMod, doRayleigh, rho, cMass);
         }
     } else if (strcmp(argv[eleArgStart], "corotTruss") == 0)  {
@@ -203,7 +206,7 @@ int addEETruss(ClientData clientData, Tcl_Interp *interp,  int argc,
                 theSite, theTangStif, iMod, doRayleigh, rho, cMass);
         } else  {
             theExpElement = new EETrussCorot(tag, ndm, iNode, jNode,
-                ipPort, ipAddr, ssl, udp, dataSize, theTangStif,
+                ipPort, ipAddr, ssl, udp, shm, dataSize, theTangStif,
                 iMod, doRayleigh, rho, cMass);
         }
     }
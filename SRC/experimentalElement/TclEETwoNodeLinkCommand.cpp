@@ -65,7 +65,7 @@ int addEETwoNodeLink(ClientData clientData, Tcl_Interp *interp, int argc,
         opserr << "WARNING insufficient arguments\n";
         printCommand(argc, argv);
         opserr << "Want: expElement twoNodeLink eleTag iNode jNode -dir dirs -site siteTag -initStif Kij <-tangStif tangStifTag> <-orient <x1 x2 x3> y1 y2 y3> <-pDelta Mratios> <-shearDist sDratios> <-iMod> <-noRayleigh> <-mass m>\n";
-        opserr << "  or: expElement twoNodeLink eleTag iNode jNode -dir dirs -server ipPort <ipAddr> <-ssl> <-udp> <-dataSize size> -initStif Kij <-tangStif tangStifTag> <-orient <x1 x2 x3> y1 y2 y3> <-pDelta Mratios> <-shearDist sDratios> <-iMod> <-noRayleigh> <-mass m>\n";
+        opserr << "  or: expElement twoNodeLink eleTag iNode jNode -dir dirs -server ipPort <ipAddr> <-ssl> <-udp> <-shm> <-dataSize size> -initStif Kij <-tangStif tangStifTag> <-orient <x1 x2 x3> y1 y2 y3> <-pDelta Mratios> <-shearDist sDratios> <-iMod> <-noRayleigh> <-mass m>\n";
         return TCL_ERROR;
     }
     
@@ -74,7 +74,7 @@ int addEETwoNodeLink(ClientData clientData, Tcl_Interp *interp, int argc,
     ExperimentalSite *theSite = 0;
     ExperimentalTangentStiff *theTangStif = 0;
     char *ipAddr = 0;
-    int ssl = 0, udp = 0;
+    int ssl = 0, udp = 0, shm = 0;
     int dataSize = OF_Network_dataSize;
     Vector Mratio(0), shearDistI(0);
     bool iMod = false;
@@ -160,6 +160,7 @@ int addEETwoNodeLink(ClientData clientData, Tcl_Interp *interp, int argc,
         if (strcmp(argv[argi], "-initStif") != 0 &&
             strcmp(argv[argi], "-ssl") != 0 &&
             strcmp(argv[argi], "-udp") != 0 &&
+            strcmp(argv[argi], "-shm") != 0 &&
             strcmp(argv[argi], "-dataSize") != 0)  {
                 ipAddr = new char [strlen(argv[argi])+1];
                 strcpy(ipAddr,argv[argi]);
@@ -174,6 +175,8 @@ int addEETwoNodeLink(ClientData clientData, Tcl_Interp *interp, int argc,
                 ssl = 1;
             else if (strcmp(argv[i], "-udp") == 0)
                 udp = 1;
+            else if (strcmp(argv[i], "-shm") == 0)
+                shm = 1;
             else if (strcmp(argv[i], "-dataSize") == 0)  {
                 if (Tcl_GetInt(interp, argv[i+1], &dataSize) != TCL_OK)  {
                     opserr << "WARNING invalid dataSize\n";
@@ -346,7 +349,7 @@ int addEETwoNodeLink(ClientData clientData, Tcl_Interp *interp, int argc,
             mass);
     } else  {
         theExpElement = new EETwoNodeLink(tag, ndm, iNode, jNode, theDirIDs,
-            ipPort, ipAddr, ssl, udp, dataSize, theTangStif, y, x, Mratio,
+            ipPort, ipAddr, ssl, udp, shm, dataSize, theTangStif, y, x, Mratio,
             shearDistI, iMod, doRayleigh, mass);
     }
     
@@ -0,0 +1,246 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, Yoshikazu Takahashi, Kyoto University          **
+** All rights reserved.                                               **
+**                                                                    **
+** Licensed under the modified BSD License (the "License");           **
+** you may not use this file except in compliance with the License.   **
+** You may obtain a copy of the License in main directory.            **
+** Unless required by applicable law or agreed to in writing,         **
+** software distributed under the License is distributed on an        **
+** "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,       **
+** either express or implied. See the License for the specific        **
+** language governing permissions and limitations under the License.  **
+**                                                                    **
+** Developed by:                                                      **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $Source: $
+
+// Created: 10/26
+// Revision: A
+//
+// Purpose: This file is the C++ sample standalone program for
+// ExperimentalElement objects.  It installs a counting operator new
+// and checks that the state determination (update followed by
+// getResistingForce) of each element does not allocate any memory
+// once the element has been set up.
+
+// standard C++ includes
+#include <stdlib.h>
+#include <math.h>
+#include <new>
+#include <iostream>
+using namespace std;
+
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+// includes the domain classes
+#include <Domain.h>
+#include <Node.h>
+#include <ElasticMaterial.h>
+#include <LinearCrdTransf2d.h>
+#include <LinearCrdTransf3d.h>
+
+// includes OpenFresco classes
+#include <FrescoGlobals.h>
+#include <ECSimUniaxialMaterials.h>
+#include <ESNoTransformation.h>
+#include <LocalExpSite.h>
+#include <EEGeneric.h>
+#include <EETwoNodeLink.h>
+#include <EEBearing2d.h>
+#include <EEBearing3d.h>
+#include <EEBeamColumn2d.h>
+#include <EEBeamColumn3d.h>
+#include <EETruss.h>
+
+// init the global variabled defined in OPS_Globals.h
+StandardStream sserr;
+OPS_Stream opserr = &sserr;
+
+// number of heap allocations made by the calling thread, the
+// worker threads of the controllers keep their own count
+static thread_local long numNew = 0;
+
+void* operator new(size_t size)
+{
+    numNew++;
+    void *ptr = malloc(size > 0 ? size : 1);
+    if (ptr == 0)
+        throw bad_alloc();
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+static long countNew()
+{
+    return numNew;
+}
+
+
+// creates a local experimental site with an elastic dummy
+// specimen for each of the numDOF basic degrees of freedom
+static ExperimentalSite* createSite(int tag, int numDOF)
+{
+    UniaxialMaterial **theSpecimen = new UniaxialMaterial* [numDOF];
+    ID DOF(numDOF);
+    for (int i=0; i<numDOF; i++)  {
+        theSpecimen[i] = new ElasticMaterial(i+1, 10.0*(i+1));
+        DOF(i) = i;
+    }
+    ExperimentalControl *theControl =
+        new ECSimUniaxialMaterials(tag, numDOF, theSpecimen);
+    ExperimentalSetup *theSetup =
+        new ESNoTransformation(tag, DOF, numDOF, numDOF, theControl);
+    for (int i=0; i<numDOF; i++)
+        delete theSpecimen[i];
+    delete [] theSpecimen;
+
+    return new LocalExpSite(tag, theSetup);
+}
+
+
+// runs numSteps state determinations of the element with harmonic
+// trial displacements of its nodes and checks that none of them
+// allocates memory after the first numWarmUp steps
+static int allocTest(ExperimentalElement *theElement,
+    int numSteps, int numWarmUp)
+{
+    int numNodes = theElement->getNumExternalNodes();
+    Node **theNodes = theElement->getNodePtrs();
+    int maxAlloc = 0;
+
+    for (int n=0; n<numSteps; n++)  {
+        for (int i=0; i<numNodes; i++)  {
+            int numDOF = theNodes[i]->getNumberDOF();
+            for (int j=0; j<numDOF; j++)
+                theNodes[i]->setTrialDisp(0.01*(i+1)*
+                    sin(2.0*3.141592*(n+j)/50.0), j);
+        }
+        theElement->update();
+        theElement->getResistingForce();
+        if (n >= numWarmUp && theElement->getNumAllocations() > maxAlloc)
+            maxAlloc = theElement->getNumAllocations();
+        theElement->commitState();
+    }
+
+    opserr << theElement->getClassType() << " " << theElement->getTag()
+        << ": " << numSteps << " steps, at most " << maxAlloc
+        << " allocations per state determination\n";
+
+    if (maxAlloc > 0)  {
+        opserr << "FAILED: state determination allocated memory\n";
+        return -1;
+    }
+
+    return 0;
+}
+
+
+// main routine
+int main(int argc, char **argv)
+{
+    ExperimentalElement::setAllocCounter(countNew);
+
+    Domain *theDomain = new Domain();
+
+    // nodes of the 2d elements (ndf = 3) and the 3d elements (ndf = 6)
+    theDomain->addNode(new Node(1, 3, 0.0, 0.0));
+    theDomain->addNode(new Node(2, 3, 0.0, 1.0));
+    theDomain->addNode(new Node(3, 6, 0.0, 0.0, 0.0));
+    theDomain->addNode(new Node(4, 6, 0.0, 0.0, 1.0));
+    theDomain->addNode(new Node(5, 2, 0.0, 0.0));
+    theDomain->addNode(new Node(6, 2, 1.0, 0.0));
+
+    UniaxialMaterial *theMaterials[4];
+    for (int i=0; i<4; i++)
+        theMaterials[i] = new ElasticMaterial(i+1, 100.0);
+
+    LinearCrdTransf2d theTrans2d(1);
+    Vector vecxz(3);
+    vecxz(0) = 1.0;
+    LinearCrdTransf3d theTrans3d(2, vecxz);
+
+    int numEle = 7;
+    ExperimentalElement *theElements[7];
+
+    ID nodes(2);
+    nodes(0) = 1;
+    nodes(1) = 2;
+    ID dof[2];
+    for (int i=0; i<2; i++)  {
+        dof[i] = ID(2);
+        dof[i](0) = 0;
+        dof[i](1) = 1;
+    }
+    theElements[0] = new EEGeneric(1, nodes, dof, createSite(1, 4));
+
+    ID direction(2);
+    direction(0) = 0;
+    direction(1) = 1;
+    theElements[1] = new EETwoNodeLink(2, 2, 1, 2, direction,
+        createSite(2, 2));
+
+    theElements[2] = new EEBearing2d(3, 1, 2, 0, theMaterials,
+        createSite(3, 3));
+    Vector x(0), y(3);
+    y(1) = 1.0;
+    theElements[3] = new EEBearing3d(4, 3, 4, 0, theMaterials,
+        createSite(4, 6), 0, y, x);
+    theElements[4] = new EEBeamColumn2d(5, 1, 2, theTrans2d,
+        createSite(5, 3));
+    theElements[5] = new EEBeamColumn3d(6, 3, 4, theTrans3d,
+        createSite(6, 6));
+    theElements[6] = new EETruss(7, 2, 5, 6, createSite(7, 1));
+
+    // adding the elements to the domain sets their node pointers
+    for (int i=0; i<numEle; i++)
+        theDomain->addElement(theElements[i]);
+
+    int result = 0;
+    for (int i=0; i<numEle; i++)  {
+        if (allocTest(theElements[i], 200, 10) < 0)
+            result = 1;
+    }
+
+    for (int i=0; i<4; i++)
+        delete theMaterials[i];
+    delete theDomain;
+
+    return result;
+}
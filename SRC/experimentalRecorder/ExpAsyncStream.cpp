@@ -0,0 +1,653 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of ExpAsyncStream.
+//
+// The record slots form a single-producer/single-consumer ring in which
+// every slot carries a sequence number that states who owns it. Record
+// n goes into slot n % numSlots. The slot is free for the control loop
+// (producer) if its sequence number is n, holds the published record if
+// it is n+1 and is being copied by the writer thread (consumer) if it is
+// -1. The producer copies a record into a free slot and publishes it by
+// storing n+1. The writer claims a published slot by a compare-and-swap
+// from n+1 to -1, copies the record into its own line buffer and frees
+// the slot for record n+numSlots. In drop-oldest mode the producer takes
+// a published slot back by a compare-and-swap from n+1-numSlots to n,
+// so exactly one of the two threads owns the slot data at any time and
+// the writer skips slots whose sequence number has moved past n+1.
+// The mutex is only used to sleep and wake up the threads, and the
+// other thread is only notified if it actually sleeps.
+
+#include <ExpAsyncStream.h>
+#include <FrescoGlobals.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+
+ExpAsyncStream::ExpAsyncStream(OPS_Stream *thestream, int numslots,
+    asyncBackPressure mod)
+    : OPS_Stream(OPS_STREAM_TAGS_ExpAsyncStream),
+    theStream(thestream), numSlots(numslots), mode(mod),
+    slotSize(0), slots(0), slotSeq(0), head(0),
+    overflow(0), numOverflow(0), overflowHead(0), overflowTail(0),
+    numRecords(0), numWritten(0), numDropped(0), numLate(0),
+    done(false), writerWaiting(false), producerWaiting(false)
+{
+    if (theStream == 0)  {
+        opserr << "ExpAsyncStream::ExpAsyncStream() - "
+            << "null output stream passed\n";
+        exit(OF_ReturnType_failed);
+    }
+    if (numSlots < 2)  {
+        opserr << "ExpAsyncStream::ExpAsyncStream() - "
+            << "at least two record slots are required\n";
+        numSlots = 2;
+    }
+}
+
+
+ExpAsyncStream::~ExpAsyncStream()
+{
+    this->stopWriter();
+
+    if (numDropped > 0 || numLate > 0)  {
+        opserr << "ExpAsyncStream::~ExpAsyncStream() - "
+            << (int)numDropped << " of " << (int)numRecords
+            << " records dropped, " << (int)numLate << " records late\n";
+    }
+
+    if (theStream != 0)
+        delete theStream;
+}
+
+
+int ExpAsyncStream::setFile(const char *fileName, openMode mode, bool echo)
+{
+    this->flush();
+    return theStream->setFile(fileName, mode, echo);
+}
+
+
+int ExpAsyncStream::setPrecision(int prec)
+{
+    this->flush();
+    return theStream->setPrecision(prec);
+}
+
+
+int ExpAsyncStream::setFloatField(floatField field)
+{
+    this->flush();
+    return theStream->setFloatField(field);
+}
+
+
+int ExpAsyncStream::precision(int prec)
+{
+    this->flush();
+    return theStream->precision(prec);
+}
+
+
+int ExpAsyncStream::width(int w)
+{
+    this->flush();
+    return theStream->width(w);
+}
+
+
+int ExpAsyncStream::tag(const char *tagName)
+{
+    this->flush();
+    return theStream->tag(tagName);
+}
+
+
+int ExpAsyncStream::tag(const char *tagName, const char *value)
+{
+    this->flush();
+    return theStream->tag(tagName, value);
+}
+
+
+int ExpAsyncStream::endTag()
+{
+    this->flush();
+    return theStream->endTag();
+}
+
+
+int ExpAsyncStream::attr(const char *name, int value)
+{
+    this->flush();
+    return theStream->attr(name, value);
+}
+
+
+int ExpAsyncStream::attr(const char *name, double value)
+{
+    this->flush();
+    return theStream->attr(name, value);
+}
+
+
+int ExpAsyncStream::attr(const char *name, const char *value)
+{
+    this->flush();
+    return theStream->attr(name, value);
+}
+
+
+int ExpAsyncStream::write(Vector &data)
+{
+    int size = data.Size();
+    if (size == 0)  {
+        this->flush();
+        return theStream->write(data);
+    }
+
+    // (re)start the writer thread with slots large enough for the data
+    if (slots == 0 || size > slotSize)  {
+        this->stopWriter();
+        this->startWriter(size);
+    }
+
+    return this->push(data, size);
+}
+
+
+OPS_Stream& ExpAsyncStream::write(const char *s, int n)
+{
+    this->flush();
+    theStream->write(s, n);
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::write(const unsigned char *s, int n)
+{
+    this->flush();
+    theStream->write(s, n);
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::write(const signed char *s, int n)
+{
+    this->flush();
+    theStream->write(s, n);
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::write(const void *s, int n)
+{
+    this->flush();
+    theStream->write(s, n);
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::write(const double *s, int n)
+{
+    this->flush();
+    theStream->write(s, n);
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::operator<<(char c)
+{
+    this->flush();
+    (*theStream) << c;
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::operator<<(unsigned char c)
+{
+    this->flush();
+    (*theStream) << c;
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::operator<<(signed char c)
+{
+    this->flush();
+    (*theStream) << c;
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::operator<<(const char *s)
+{
+    this->flush();
+    (*theStream) << s;
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::operator<<(const unsigned char *s)
+{
+    this->flush();
+    (*theStream) << s;
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::operator<<(const signed char *s)
+{
+    this->flush();
+    (*theStream) << s;
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::operator<<(const void *p)
+{
+    this->flush();
+    (*theStream) << p;
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::operator<<(int n)
+{
+    this->flush();
+    (*theStream) << n;
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::operator<<(unsigned int n)
+{
+    this->flush();
+    (*theStream) << n;
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::operator<<(long n)
+{
+    this->flush();
+    (*theStream) << n;
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::operator<<(unsigned long n)
+{
+    this->flush();
+    (*theStream) << n;
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::operator<<(short n)
+{
+    this->flush();
+    (*theStream) << n;
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::operator<<(unsigned short n)
+{
+    this->flush();
+    (*theStream) << n;
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::operator<<(bool b)
+{
+    this->flush();
+    (*theStream) << b;
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::operator<<(double n)
+{
+    this->flush();
+    (*theStream) << n;
+    return *this;
+}
+
+
+OPS_Stream& ExpAsyncStream::operator<<(float n)
+{
+    this->flush();
+    (*theStream) << n;
+    return *this;
+}
+
+
+void ExpAsyncStream::setAddCommon(int flag)
+{
+    this->flush();
+    theStream->setAddCommon(flag);
+}
+
+
+int ExpAsyncStream::setOrder(const ID &order)
+{
+    this->flush();
+    return theStream->setOrder(order);
+}
+
+
+int ExpAsyncStream::sendSelf(int commitTag, Channel &theChannel)
+{
+    this->flush();
+    return theStream->sendSelf(commitTag, theChannel);
+}
+
+
+int ExpAsyncStream::recvSelf(int commitTag, Channel &theChannel,
+    FEM_ObjectBroker &theBroker)
+{
+    this->flush();
+    return theStream->recvSelf(commitTag, theChannel, theBroker);
+}
+
+
+int ExpAsyncStream::flush()
+{
+    if (slots == 0)
+        return 0;
+
+    // move the overflow records into the ring as slots become free
+    while (overflowTail < overflowHead)  {
+        this->drainOverflow();
+        if (overflowTail < overflowHead)  {
+            std::atomic<long> *seq = &slotSeq[head % numSlots];
+            std::unique_lock<std::mutex> lock(theMutex);
+            producerWaiting = true;
+            slotFreed.wait(lock, [this, seq] {
+                return seq->load() == head; });
+            producerWaiting = false;
+        }
+    }
+
+    // wait until the writer thread has processed all records
+    std::unique_lock<std::mutex> lock(theMutex);
+    producerWaiting = true;
+    slotFreed.wait(lock, [this] {
+        return numWritten.load() + numDropped.load() == numRecords; });
+    producerWaiting = false;
+
+    return 0;
+}
+
+
+long ExpAsyncStream::getNumRecords() const
+{
+    return numRecords;
+}
+
+
+long ExpAsyncStream::getNumDropped() const
+{
+    return numDropped.load();
+}
+
+
+long ExpAsyncStream::getNumLate() const
+{
+    return numLate;
+}
+
+
+void ExpAsyncStream::startWriter(int size)
+{
+    // each slot holds the record size followed by the record data
+    slotSize = size;
+    slots = new double [numSlots*(slotSize+1)];
+    slotSeq = new std::atomic<long> [numSlots];
+    if (slots == 0 || slotSeq == 0)  {
+        opserr << "ExpAsyncStream::startWriter() - "
+            << "failed to create record slots\n";
+        exit(OF_ReturnType_failed);
+    }
+    for (int i=0; i<numSlots; i++)
+        slotSeq[i] = i;
+    head = 0;
+
+    // the overflow slots are allocated up front as well, so that the
+    // control loop only allocates if the overflow runs full
+    if (mode == ASYNC_GROW)  {
+        numOverflow = 4*numSlots;
+        overflow = new double [numOverflow*(slotSize+1)];
+        if (overflow == 0)  {
+            opserr << "ExpAsyncStream::startWriter() - "
+                << "failed to create overflow slots\n";
+            exit(OF_ReturnType_failed);
+        }
+    }
+    overflowHead = 0;
+    overflowTail = 0;
+
+    done = false;
+    writer = std::thread(&ExpAsyncStream::writerLoop, this);
+}
+
+
+void ExpAsyncStream::stopWriter()
+{
+    if (slots == 0)
+        return;
+
+    this->flush();
+    {
+        std::lock_guard<std::mutex> lock(theMutex);
+        done = true;
+    }
+    dataReady.notify_one();
+    writer.join();
+
+    delete [] slots;
+    delete [] slotSeq;
+    slots = 0;
+    slotSeq = 0;
+    slotSize = 0;
+    if (overflow != 0)
+        delete [] overflow;
+    overflow = 0;
+    numOverflow = 0;
+}
+
+
+void ExpAsyncStream::writerLoop()
+{
+    double *line = new double [slotSize+1];
+    long t = 0;
+
+    while (true)  {
+        std::atomic<long> *seq = &slotSeq[t % numSlots];
+        long s = seq->load();
+
+        // record t was dropped by the control loop
+        if (s > t+1)  {
+            t++;
+            continue;
+        }
+
+        // the ring is empty, sleep until record t is published
+        if (s == t)  {
+            std::unique_lock<std::mutex> lock(theMutex);
+            writerWaiting = true;
+            dataReady.wait(lock, [this, seq, t] {
+                return seq->load() != t || done.load(); });
+            writerWaiting = false;
+            if (seq->load() == t)
+                break;
+            continue;
+        }
+
+        // claim record t, fails if the control loop dropped it
+        if (!seq->compare_exchange_strong(s, -1))
+            continue;
+        double *slot = &slots[(t % numSlots)*(slotSize+1)];
+        memcpy(line, slot, ((int)slot[0]+1)*sizeof(double));
+        seq->store(t+numSlots);
+        t++;
+
+        Vector data(&line[1], (int)line[0]);
+        theStream->write(data);
+        numWritten++;
+
+        // only wake up the control loop if it waits for the writer
+        if (producerWaiting.load())  {
+            {
+                std::lock_guard<std::mutex> lock(theMutex);
+            }
+            slotFreed.notify_one();
+        }
+    }
+
+    delete [] line;
+}
+
+
+int ExpAsyncStream::push(Vector &data, int size)
+{
+    numRecords++;
+
+    // keep the record order if earlier records are still waiting
+    if (overflowTail < overflowHead)  {
+        this->drainOverflow();
+        if (overflowTail < overflowHead)  {
+            this->pushOverflow(data, size);
+            return 0;
+        }
+    }
+
+    std::atomic<long> *seq = &slotSeq[head % numSlots];
+    long h = head;
+    long s = seq->load();
+    bool late = false;
+    while (s != h)  {
+        if (s == -1)  {
+            // the writer is copying the oldest record out of the slot
+            std::this_thread::yield();
+        }
+        else if (mode == ASYNC_DROP_OLDEST)  {
+            // take the slot of the oldest record back from the writer
+            if (seq->compare_exchange_strong(s, h))  {
+                numDropped++;
+                break;
+            }
+            continue;
+        }
+        else if (mode == ASYNC_GROW)  {
+            this->pushOverflow(data, size);
+            return 0;
+        }
+        else  {
+            late = true;
+            std::unique_lock<std::mutex> lock(theMutex);
+            producerWaiting = true;
+            slotFreed.wait(lock, [seq, s] {
+                return seq->load() != s; });
+            producerWaiting = false;
+        }
+        s = seq->load();
+    }
+    if (late)
+        numLate++;
+
+    // copy the record into the free slot and publish it
+    double *slot = &slots[(h % numSlots)*(slotSize+1)];
+    slot[0] = size;
+    memcpy(&slot[1], &data(0), size*sizeof(double));
+    seq->store(h+1);
+    head = h+1;
+
+    // only wake up the writer if it sleeps on an empty ring
+    if (writerWaiting.load())  {
+        {
+            std::lock_guard<std::mutex> lock(theMutex);
+        }
+        dataReady.notify_one();
+    }
+
+    return 0;
+}
+
+
+void ExpAsyncStream::pushOverflow(Vector &data, int size)
+{
+    // double the overflow slots if they are all in use
+    if (overflowHead - overflowTail >= numOverflow)  {
+        double *newOverflow = new double [2*numOverflow*(slotSize+1)];
+        for (long i=overflowTail; i<overflowHead; i++)
+            memcpy(&newOverflow[(i-overflowTail)*(slotSize+1)],
+                &overflow[(i % numOverflow)*(slotSize+1)],
+                (slotSize+1)*sizeof(double));
+        delete [] overflow;
+        overflow = newOverflow;
+        overflowHead -= overflowTail;
+        overflowTail = 0;
+        numOverflow *= 2;
+    }
+
+    double *record = &overflow[(overflowHead % numOverflow)*(slotSize+1)];
+    record[0] = size;
+    memcpy(&record[1], &data(0), size*sizeof(double));
+    overflowHead++;
+    numLate++;
+}
+
+
+void ExpAsyncStream::drainOverflow()
+{
+    bool moved = false;
+    while (overflowTail < overflowHead)  {
+        std::atomic<long> *seq = &slotSeq[head % numSlots];
+        if (seq->load() != head)
+            break;
+
+        double *record = &overflow[(overflowTail % numOverflow)*(slotSize+1)];
+        double *slot = &slots[(head % numSlots)*(slotSize+1)];
+        memcpy(slot, record, ((int)record[0]+1)*sizeof(double));
+        seq->store(head+1);
+        head++;
+        overflowTail++;
+        moved = true;
+    }
+
+    if (moved && writerWaiting.load())  {
+        {
+            std::lock_guard<std::mutex> lock(theMutex);
+        }
+        dataReady.notify_one();
+    }
+}
@@ -0,0 +1,160 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef ExpAsyncStream_h
+#define ExpAsyncStream_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ExpAsyncStream. An ExpAsyncStream wraps the output stream of an
+// experimental recorder and hands the recorded data vectors over to
+// a background writer thread through a ring of pre-sized record
+// slots, so that formatting and file I/O do not delay the control
+// loop. All other stream operations are passed on to the wrapped
+// stream after the pending records have been written.
+
+#include <OPS_Stream.h>
+#include <Vector.h>
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#define OPS_STREAM_TAGS_ExpAsyncStream 100
+
+// back-pressure modes if all record slots are in use
+enum asyncBackPressure  {
+    ASYNC_BLOCK,        // wait for the writer thread to free a slot
+    ASYNC_DROP_OLDEST,  // discard the oldest record not yet written
+    ASYNC_GROW          // queue the record in a growing overflow ring
+};
+
+class ExpAsyncStream : public OPS_Stream
+{
+public:
+    // constructors
+    ExpAsyncStream(OPS_Stream *theStream, int numSlots = 64,
+        asyncBackPressure mode = ASYNC_BLOCK);
+
+    // destructor
+    ~ExpAsyncStream();
+
+    // output format
+    int setFile(const char *fileName, openMode mode = OVERWRITE, bool echo = false);
+    int setPrecision(int precision);
+    int setFloatField(floatField);
+    int precision(int precision);
+    int width(int width);
+
+    // xml stuff
+    int tag(const char *);
+    int tag(const char *, const char *);
+    int endTag();
+    int attr(const char *name, int value);
+    int attr(const char *name, double value);
+    int attr(const char *name, const char *value);
+    int write(Vector &data);
+
+    // regular stuff
+    OPS_Stream& write(const char *s, int n);
+    OPS_Stream& write(const unsigned char *s, int n);
+    OPS_Stream& write(const signed char *s, int n);
+    OPS_Stream& write(const void *s, int n);
+    OPS_Stream& write(const double *s, int n);
+
+    OPS_Stream& operator<<(char c);
+    OPS_Stream& operator<<(unsigned char c);
+    OPS_Stream& operator<<(signed char c);
+    OPS_Stream& operator<<(const char *s);
+    OPS_Stream& operator<<(const unsigned char *s);
+    OPS_Stream& operator<<(const signed char *s);
+    OPS_Stream& operator<<(const void *p);
+    OPS_Stream& operator<<(int n);
+    OPS_Stream& operator<<(unsigned int n);
+    OPS_Stream& operator<<(long n);
+    OPS_Stream& operator<<(unsigned long n);
+    OPS_Stream& operator<<(short n);
+    OPS_Stream& operator<<(unsigned short n);
+    OPS_Stream& operator<<(bool b);
+    OPS_Stream& operator<<(double n);
+    OPS_Stream& operator<<(float n);
+
+    // parallel stuff
+    void setAddCommon(int);
+    int setOrder(const ID &order);
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+        FEM_ObjectBroker &theBroker);
+
+    // wait until all pending records have been written
+    int flush();
+
+    // statistics
+    long getNumRecords() const;
+    long getNumDropped() const;
+    long getNumLate() const;
+
+private:
+    void startWriter(int size);
+    void stopWriter();
+    void writerLoop();
+    int push(Vector &data, int size);
+    void pushOverflow(Vector &data, int size);
+    void drainOverflow();
+
+    OPS_Stream *theStream;      // wrapped output stream
+    int numSlots;               // number of record slots in the ring
+    asyncBackPressure mode;     // back-pressure mode
+
+    int slotSize;               // size of the largest record
+    double *slots;              // numSlots*(slotSize+1) record data
+    std::atomic<long> *slotSeq; // sequence number of each slot
+    long head;                  // next record written by the control loop
+
+    // records waiting for a free slot (grow mode), only used by the
+    // control loop and preallocated with the record slots
+    double *overflow;           // numOverflow*(slotSize+1) record data
+    long numOverflow;           // number of overflow slots
+    long overflowHead;          // next overflow slot written
+    long overflowTail;          // next overflow slot moved into the ring
+
+    long numRecords;            // records handed to the stream
+    std::atomic<long> numWritten;   // records written by the writer
+    std::atomic<long> numDropped;   // records discarded (drop oldest)
+    long numLate;               // records that waited for a free slot
+
+    std::thread writer;         // background writer thread
+    std::atomic<bool> done;     // flag to stop the writer thread
+    std::atomic<bool> writerWaiting;    // writer sleeps on dataReady
+    std::atomic<bool> producerWaiting;  // control loop sleeps on slotFreed
+    std::mutex theMutex;        // protects the waits below only
+    std::condition_variable dataReady;  // signaled by the control loop
+    std::condition_variable slotFreed;  // signaled by the writer thread
+};
+
+#endif
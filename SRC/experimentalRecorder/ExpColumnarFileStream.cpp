@@ -0,0 +1,317 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// ExpColumnarFileStream.
+
+#include <ExpColumnarFileStream.h>
+#include <Vector.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <limits>
+
+
+ExpColumnarFileStream::ExpColumnarFileStream(const char *file,
+    openMode mode)
+    : OPS_Stream(OPS_STREAM_TAGS_ExpColumnarFileStream),
+    fileOpen(false), theOpenMode(mode), depth(0), headerWritten(false),
+    row(0), numColumns(0), swapBytes(false), sizeWarned(false)
+{
+    // rows are stored little endian independent of the host
+    const int one = 1;
+    swapBytes = (*(const char*)&one == 0);
+
+    this->setFile(file, mode);
+}
+
+
+ExpColumnarFileStream::~ExpColumnarFileStream()
+{
+    // make sure a file without records still gets its header
+    if (!headerWritten)
+        this->writeHeader(0);
+
+    this->close();
+
+    if (row != 0)
+        delete [] row;
+}
+
+
+int ExpColumnarFileStream::setFile(const char *file, openMode mode,
+    bool echo)
+{
+    if (file == 0)  {
+        opserr << "ExpColumnarFileStream::setFile() - no file name specified\n";
+        return -1;
+    }
+
+    this->close();
+    fileName = file;
+    theOpenMode = mode;
+
+    return 0;
+}
+
+
+int ExpColumnarFileStream::open()
+{
+    if (fileOpen)
+        return 0;
+
+    if (fileName.empty())  {
+        opserr << "ExpColumnarFileStream::open() - no file name has been set\n";
+        return -1;
+    }
+
+    if (theOpenMode == OVERWRITE)
+        theFile.open(fileName.c_str(), std::ios::out | std::ios::binary);
+    else
+        theFile.open(fileName.c_str(), std::ios::out | std::ios::app | std::ios::binary);
+    theOpenMode = APPEND;
+
+    if (theFile.bad() || !theFile.is_open())  {
+        opserr << "WARNING ExpColumnarFileStream::open() - could not open file "
+            << fileName.c_str() << endln;
+        return -1;
+    }
+    fileOpen = true;
+
+    return 0;
+}
+
+
+int ExpColumnarFileStream::close()
+{
+    if (fileOpen)
+        theFile.close();
+    fileOpen = false;
+
+    return 0;
+}
+
+
+int ExpColumnarFileStream::tag(const char *tagName)
+{
+    depth++;
+
+    // the children of the root element describe the recorded objects
+    if (depth == 2 && strcmp(tagName,"Data") != 0)  {
+        Group theGroup;
+        theGroup.element = tagName;
+        theGroup.type = "-";
+        theGroup.tag = -1;
+        theGroup.firstColumn = (int)columns.size();
+        theGroup.numColumns = 0;
+        groups.push_back(theGroup);
+    }
+
+    return 0;
+}
+
+
+int ExpColumnarFileStream::tag(const char *tagName, const char *value)
+{
+    if (strcmp(tagName,"ResponseType") != 0)
+        return 0;
+
+    // response types outside of an object get their own group
+    if (depth < 2 || groups.empty())  {
+        Group theGroup;
+        theGroup.element = "Output";
+        theGroup.type = "-";
+        theGroup.tag = -1;
+        theGroup.firstColumn = (int)columns.size();
+        theGroup.numColumns = 0;
+        groups.push_back(theGroup);
+    }
+    columns.push_back(value);
+    groups.back().numColumns++;
+
+    return 0;
+}
+
+
+int ExpColumnarFileStream::endTag()
+{
+    if (depth > 0)
+        depth--;
+
+    return 0;
+}
+
+
+int ExpColumnarFileStream::attr(const char *name, int value)
+{
+    // object tags are reported as siteTag, setupTag, ctrlTag, ...
+    int len = (int)strlen(name);
+    if (depth == 2 && !groups.empty() && len > 3 &&
+        strcmp(&name[len-3],"Tag") == 0)
+        groups.back().tag = value;
+
+    return 0;
+}
+
+
+int ExpColumnarFileStream::attr(const char *name, double value)
+{
+    return 0;
+}
+
+
+int ExpColumnarFileStream::attr(const char *name, const char *value)
+{
+    // object types are reported as siteType, setupType, ctrlType, ...
+    int len = (int)strlen(name);
+    if (depth == 2 && !groups.empty() && len > 4 &&
+        strcmp(&name[len-4],"Type") == 0 && value != 0 && value[0] != '\0')
+        groups.back().type = value;
+
+    return 0;
+}
+
+
+int ExpColumnarFileStream::write(Vector &data)
+{
+    int numData = data.Size();
+    if (!headerWritten)  {
+        if (this->writeHeader(numData) < 0)
+            return -1;
+    }
+    if (numColumns == 0)
+        return 0;
+
+    if (numData != numColumns && !sizeWarned)  {
+        opserr << "WARNING ExpColumnarFileStream::write() - record of size "
+            << numData << " does not match " << numColumns
+            << " columns in file " << fileName.c_str() << endln;
+        sizeWarned = true;
+    }
+
+    // missing entries are recorded as NaN
+    int i;
+    for (i=0; i<numColumns; i++)
+        row[i] = (i < numData) ? data(i) : std::numeric_limits<double>::quiet_NaN();
+
+    if (swapBytes)  {
+        for (i=0; i<numColumns; i++)  {
+            char *b = (char*)&row[i];
+            for (int j=0; j<4; j++)  {
+                char tmp = b[j];
+                b[j] = b[7-j];
+                b[7-j] = tmp;
+            }
+        }
+    }
+
+    theFile.write((const char*)row, numColumns*sizeof(double));
+
+    return 0;
+}
+
+
+int ExpColumnarFileStream::sendSelf(int commitTag, Channel &theChannel)
+{
+    return 0;
+}
+
+
+int ExpColumnarFileStream::recvSelf(int commitTag, Channel &theChannel,
+    FEM_ObjectBroker &theBroker)
+{
+    return 0;
+}
+
+
+int ExpColumnarFileStream::writeHeader(int numData)
+{
+    if (this->open() < 0)
+        return -1;
+
+    // without column descriptions fall back on the record size
+    char buffer[256];
+    if (columns.empty())  {
+        for (int i=0; i<numData; i++)  {
+            sprintf(buffer, "column%d", i+1);
+            columns.push_back(buffer);
+        }
+        if (numData > 0)  {
+            Group theGroup;
+            theGroup.element = "Output";
+            theGroup.type = "-";
+            theGroup.tag = -1;
+            theGroup.firstColumn = 0;
+            theGroup.numColumns = numData;
+            groups.push_back(theGroup);
+        }
+    }
+    numColumns = (int)columns.size();
+
+    std::string header("OpenFrescoColumnar 1\n");
+    header += "byteOrder littleEndian\n";
+    sprintf(buffer, "numColumns %d\n", numColumns);
+    header += buffer;
+
+    int i, numGroups = 0;
+    for (i=0; i<(int)groups.size(); i++)
+        if (groups[i].numColumns > 0)
+            numGroups++;
+    sprintf(buffer, "numGroups %d\n", numGroups);
+    header += buffer;
+    for (i=0; i<(int)groups.size(); i++)  {
+        const Group &theGroup = groups[i];
+        if (theGroup.numColumns == 0)
+            continue;
+        header += "group " + theGroup.element + " " + theGroup.type;
+        sprintf(buffer, " %d %d %d\n", theGroup.tag,
+            theGroup.firstColumn, theGroup.numColumns);
+        header += buffer;
+    }
+    for (i=0; i<numColumns; i++)
+        header += "column " + columns[i] + "\n";
+
+    // pad the last line so that the data is aligned to 8 bytes
+    header += "endHeader";
+    while ((header.size()+1) % 8 != 0)
+        header += " ";
+    header += "\n";
+
+    theFile.write(header.c_str(), header.size());
+    headerWritten = true;
+
+    if (numColumns > 0)  {
+        row = new double [numColumns];
+        if (row == 0)  {
+            opserr << "ExpColumnarFileStream::writeHeader() - out of memory\n";
+            return -1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef ExpColumnarFileStream_h
+#define ExpColumnarFileStream_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ExpColumnarFileStream. An ExpColumnarFileStream collects the
+// object and response descriptions that the experimental recorders
+// emit as xml tags and writes them as a self-describing text header,
+// followed by one row of raw little-endian doubles per record. The
+// header has the form
+//
+//   OpenFrescoColumnar 1
+//   byteOrder littleEndian
+//   numColumns <n>
+//   numGroups <m>
+//   group <element> <type> <tag> <firstColumn> <numColumns>   (m lines)
+//   column <name>                                             (n lines)
+//   endHeader <padding>
+//
+// and is padded so that the data starts at a multiple of 8 bytes.
+// The files can be read with ExpColumnarReader.
+
+#include <OPS_Stream.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#define OPS_STREAM_TAGS_ExpColumnarFileStream 101
+
+class ExpColumnarFileStream : public OPS_Stream
+{
+public:
+    // constructors
+    ExpColumnarFileStream(const char *fileName, openMode mode = OVERWRITE);
+
+    // destructor
+    ~ExpColumnarFileStream();
+
+    int setFile(const char *fileName, openMode mode = OVERWRITE, bool echo = false);
+    int open();
+    int close();
+
+    // xml stuff
+    int tag(const char *);
+    int tag(const char *, const char *);
+    int endTag();
+    int attr(const char *name, int value);
+    int attr(const char *name, double value);
+    int attr(const char *name, const char *value);
+    int write(Vector &data);
+
+    // parallel stuff
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+        FEM_ObjectBroker &theBroker);
+
+private:
+    int writeHeader(int numData);
+
+    struct Group  {
+        std::string element;    // xml element, e.g. ExpSiteOutput
+        std::string type;       // class type of the object
+        int tag;                // tag of the object
+        int firstColumn;        // first column of the group
+        int numColumns;         // number of columns of the group
+    };
+
+    std::ofstream theFile;
+    bool fileOpen;
+    openMode theOpenMode;
+    std::string fileName;
+
+    int depth;                  // current xml nesting depth
+    bool headerWritten;         // flag if header has been written
+    std::vector<Group> groups;  // objects that contribute columns
+    std::vector<std::string> columns;   // column names
+
+    double *row;                // row buffer (byte swapped if needed)
+    int numColumns;             // number of columns in each row
+    bool swapBytes;             // flag if host is big endian
+    bool sizeWarned;            // flag if size mismatch was reported
+};
+
+#endif
@@ -0,0 +1,340 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// ExpColumnarReader.
+
+#include <ExpColumnarReader.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+static double swapDouble(double value)
+{
+    char *b = (char*)&value;
+    for (int j=0; j<4; j++)  {
+        char tmp = b[j];
+        b[j] = b[7-j];
+        b[7-j] = tmp;
+    }
+    return value;
+}
+
+
+ExpColumnarReader::ExpColumnarReader(const char *fileName)
+    : theMap(0), mapSize(0),
+#ifdef _WIN32
+    fileHandle(INVALID_HANDLE_VALUE), mapHandle(0),
+#else
+    fileDescriptor(-1),
+#endif
+    valid(false), data(0), numRows(0), numColumns(0), swapBytes(false)
+{
+    const int one = 1;
+    swapBytes = (*(const char*)&one == 0);
+
+#ifdef _WIN32
+    fileHandle = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ,
+        NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (fileHandle == INVALID_HANDLE_VALUE)  {
+        fprintf(stderr, "ExpColumnarReader::ExpColumnarReader() - "
+            "could not open file %s\n", fileName);
+        return;
+    }
+    LARGE_INTEGER size;
+    GetFileSizeEx(fileHandle, &size);
+    mapSize = (long)size.QuadPart;
+    if (mapSize > 0)  {
+        mapHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapHandle != 0)
+            theMap = MapViewOfFile(mapHandle, FILE_MAP_READ, 0, 0, 0);
+    }
+#else
+    fileDescriptor = open(fileName, O_RDONLY);
+    if (fileDescriptor < 0)  {
+        fprintf(stderr, "ExpColumnarReader::ExpColumnarReader() - "
+            "could not open file %s\n", fileName);
+        return;
+    }
+    struct stat fileStat;
+    fstat(fileDescriptor, &fileStat);
+    mapSize = (long)fileStat.st_size;
+    if (mapSize > 0)  {
+        theMap = mmap(0, mapSize, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+        if (theMap == MAP_FAILED)
+            theMap = 0;
+    }
+#endif
+    if (theMap == 0)  {
+        fprintf(stderr, "ExpColumnarReader::ExpColumnarReader() - "
+            "could not map file %s\n", fileName);
+        return;
+    }
+
+    if (this->parseHeader((const char*)theMap, mapSize) < 0)  {
+        fprintf(stderr, "ExpColumnarReader::ExpColumnarReader() - "
+            "%s is not a valid OpenFresco columnar file\n", fileName);
+        data = 0;
+        numRows = 0;
+        numColumns = 0;
+        return;
+    }
+    valid = true;
+}
+
+
+ExpColumnarReader::~ExpColumnarReader()
+{
+#ifdef _WIN32
+    if (theMap != 0)
+        UnmapViewOfFile(theMap);
+    if (mapHandle != 0)
+        CloseHandle(mapHandle);
+    if (fileHandle != INVALID_HANDLE_VALUE)
+        CloseHandle(fileHandle);
+#else
+    if (theMap != 0)
+        munmap(theMap, mapSize);
+    if (fileDescriptor >= 0)
+        close(fileDescriptor);
+#endif
+}
+
+
+bool ExpColumnarReader::isOpen() const
+{
+    return valid;
+}
+
+
+int ExpColumnarReader::getNumRows() const
+{
+    return numRows;
+}
+
+
+int ExpColumnarReader::getNumColumns() const
+{
+    return numColumns;
+}
+
+
+const char *ExpColumnarReader::getColumnName(int col) const
+{
+    if (col < 0 || col >= numColumns)
+        return 0;
+
+    return columns[col].c_str();
+}
+
+
+int ExpColumnarReader::getColumnIndex(const char *name, int groupTag) const
+{
+    // search all groups or only the ones with the given object tag
+    for (int i=0; i<(int)groups.size(); i++)  {
+        const Group &theGroup = groups[i];
+        if (groupTag >= 0 && theGroup.tag != groupTag)
+            continue;
+        for (int j=0; j<theGroup.numColumns; j++)  {
+            int col = theGroup.firstColumn + j;
+            if (columns[col] == name)
+                return col;
+        }
+    }
+
+    return -1;
+}
+
+
+int ExpColumnarReader::getNumGroups() const
+{
+    return (int)groups.size();
+}
+
+
+const char *ExpColumnarReader::getGroupElement(int group) const
+{
+    if (group < 0 || group >= (int)groups.size())
+        return 0;
+
+    return groups[group].element.c_str();
+}
+
+
+const char *ExpColumnarReader::getGroupType(int group) const
+{
+    if (group < 0 || group >= (int)groups.size())
+        return 0;
+
+    return groups[group].type.c_str();
+}
+
+
+int ExpColumnarReader::getGroupTag(int group) const
+{
+    if (group < 0 || group >= (int)groups.size())
+        return -1;
+
+    return groups[group].tag;
+}
+
+
+int ExpColumnarReader::getGroupFirstColumn(int group) const
+{
+    if (group < 0 || group >= (int)groups.size())
+        return -1;
+
+    return groups[group].firstColumn;
+}
+
+
+int ExpColumnarReader::getGroupNumColumns(int group) const
+{
+    if (group < 0 || group >= (int)groups.size())
+        return 0;
+
+    return groups[group].numColumns;
+}
+
+
+double ExpColumnarReader::operator()(int row, int col) const
+{
+    double value = data[(long)row*numColumns + col];
+    if (swapBytes)
+        return swapDouble(value);
+
+    return value;
+}
+
+
+const double *ExpColumnarReader::getRow(int row) const
+{
+    // the returned values are in little endian byte order
+    if (row < 0 || row >= numRows)
+        return 0;
+
+    return &data[(long)row*numColumns];
+}
+
+
+int ExpColumnarReader::getColumn(int col, double *values) const
+{
+    if (col < 0 || col >= numColumns)
+        return -1;
+
+    const double *value = &data[col];
+    for (int i=0; i<numRows; i++)  {
+        values[i] = swapBytes ? swapDouble(*value) : *value;
+        value += numColumns;
+    }
+
+    return numRows;
+}
+
+
+int ExpColumnarReader::parseHeader(const char *header, long size)
+{
+    // find the end of the header
+    const char *end = 0;
+    long pos = 0;
+    while (pos < size)  {
+        const char *line = &header[pos];
+        const char *eol = (const char*)memchr(line, '\n', size-pos);
+        if (eol == 0)
+            return -1;
+        if (strncmp(line, "endHeader", 9) == 0)  {
+            end = eol + 1;
+            break;
+        }
+        pos = (long)(eol - header) + 1;
+    }
+    if (end == 0 || strncmp(header, "OpenFrescoColumnar 1\n", 21) != 0)
+        return -1;
+
+    // parse the header lines
+    std::string text(header, end - header);
+    char word[256], element[256], type[256];
+    int numGroups = -1, tag, firstColumn, numCols;
+    pos = 0;
+    while (pos < (long)text.size())  {
+        long eol = (long)text.find('\n', pos);
+        std::string line = text.substr(pos, eol-pos);
+        pos = eol + 1;
+        if (sscanf(line.c_str(), "%255s", word) != 1)
+            continue;
+        if (strcmp(word, "numColumns") == 0)  {
+            sscanf(line.c_str(), "%*s %d", &numColumns);
+        }
+        else if (strcmp(word, "numGroups") == 0)  {
+            sscanf(line.c_str(), "%*s %d", &numGroups);
+        }
+        else if (strcmp(word, "group") == 0)  {
+            if (sscanf(line.c_str(), "%*s %255s %255s %d %d %d",
+                element, type, &tag, &firstColumn, &numCols) != 5)
+                return -1;
+            Group theGroup;
+            theGroup.element = element;
+            theGroup.type = type;
+            theGroup.tag = tag;
+            theGroup.firstColumn = firstColumn;
+            theGroup.numColumns = numCols;
+            groups.push_back(theGroup);
+        }
+        else if (strcmp(word, "column") == 0)  {
+            columns.push_back(line.substr(7));
+        }
+    }
+    if (numColumns != (int)columns.size() ||
+        (numGroups >= 0 && numGroups != (int)groups.size()))
+        return -1;
+    for (int i=0; i<(int)groups.size(); i++)  {
+        if (groups[i].firstColumn < 0 ||
+            groups[i].firstColumn + groups[i].numColumns > numColumns)
+            return -1;
+    }
+
+    // an incomplete last row (e.g. after a crash) is ignored
+    long dataOffset = (long)(end - header);
+    if (numColumns > 0)  {
+        data = (const double*)end;
+        numRows = (int)((size - dataOffset)/(numColumns*(long)sizeof(double)));
+    }
+
+    return 0;
+}
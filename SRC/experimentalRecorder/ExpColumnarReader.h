@@ -0,0 +1,101 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef ExpColumnarReader_h
+#define ExpColumnarReader_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ExpColumnarReader. An ExpColumnarReader memory-maps a file written
+// by an ExpColumnarFileStream, parses the text header once and then
+// gives direct access to the recorded doubles without copying or
+// converting them. The class does not depend on the rest of the
+// framework so that it can be used by post-processing tools.
+
+#include <string>
+#include <vector>
+
+class ExpColumnarReader
+{
+public:
+    // constructors
+    ExpColumnarReader(const char *fileName);
+
+    // destructor
+    ~ExpColumnarReader();
+
+    // method to check if the file was mapped successfully
+    bool isOpen() const;
+
+    // methods to query the header
+    int getNumRows() const;
+    int getNumColumns() const;
+    const char *getColumnName(int col) const;
+    int getColumnIndex(const char *name, int groupTag = -1) const;
+
+    int getNumGroups() const;
+    const char *getGroupElement(int group) const;
+    const char *getGroupType(int group) const;
+    int getGroupTag(int group) const;
+    int getGroupFirstColumn(int group) const;
+    int getGroupNumColumns(int group) const;
+
+    // methods to access the data
+    double operator()(int row, int col) const;
+    const double *getRow(int row) const;
+    int getColumn(int col, double *values) const;
+
+private:
+    int parseHeader(const char *header, long size);
+
+    struct Group  {
+        std::string element;
+        std::string type;
+        int tag;
+        int firstColumn;
+        int numColumns;
+    };
+
+    void *theMap;               // start of the mapped file
+    long mapSize;               // size of the mapped file
+#ifdef _WIN32
+    void *fileHandle;
+    void *mapHandle;
+#else
+    int fileDescriptor;
+#endif
+
+    bool valid;                 // flag if the header is valid
+    const double *data;         // first row of data
+    int numRows;
+    int numColumns;
+    bool swapBytes;             // flag if host is big endian
+    std::vector<Group> groups;
+    std::vector<std::string> columns;
+};
+
+#endif
@@ -0,0 +1,232 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of ExpTiming.
+//
+// The counters of each stage are only ever incremented (or raised for
+// the maximum) with relaxed atomic operations, so a report that is
+// taken while the stages are timed can be slightly inconsistent
+// between the counters, but never blocks or slows down the timed
+// threads. Durations are kept in nanoseconds. Bin 0 of the histogram
+// counts durations below 1 usec and bin k>0 the durations in
+// [2^(k-1), 2^k) usec, the last bin also holds all longer durations.
+
+#include <ExpTiming.h>
+
+#include <Vector.h>
+#include <OPS_Stream.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+
+#define EXP_TIMING_NUM_BINS 28
+
+struct ExpTimingStage  {
+    std::atomic<unsigned long long> count;
+    std::atomic<unsigned long long> last;
+    std::atomic<unsigned long long> total;
+    std::atomic<unsigned long long> max;
+    std::atomic<unsigned long long> hist[EXP_TIMING_NUM_BINS];
+};
+
+static ExpTimingStage theStages[OF_Timing_All];
+static std::atomic<bool> timingEnabled(false);
+
+static const char *stageNames[OF_Timing_All] = {
+    "element", "siteTrial", "siteDaq", "setupTrial", "setupDaq",
+    "filter", "control", "acquire", "send", "recv", "record"
+};
+
+
+void ExpTiming::enable(bool flag)
+{
+    timingEnabled.store(flag, std::memory_order_relaxed);
+}
+
+
+bool ExpTiming::isEnabled()
+{
+    return timingEnabled.load(std::memory_order_relaxed);
+}
+
+
+void ExpTiming::reset()
+{
+    for (int i=0; i<OF_Timing_All; i++)  {
+        theStages[i].count.store(0, std::memory_order_relaxed);
+        theStages[i].last.store(0, std::memory_order_relaxed);
+        theStages[i].total.store(0, std::memory_order_relaxed);
+        theStages[i].max.store(0, std::memory_order_relaxed);
+        for (int j=0; j<EXP_TIMING_NUM_BINS; j++)
+            theStages[i].hist[j].store(0, std::memory_order_relaxed);
+    }
+}
+
+
+long long ExpTiming::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+void ExpTiming::add(int stage, long long tStart)
+{
+    if (stage < 0 || stage >= OF_Timing_All)
+        return;
+    
+    long long dt = ExpTiming::now() - tStart;
+    unsigned long long ns = (dt > 0) ? (unsigned long long)dt : 0;
+    ExpTimingStage &theStage = theStages[stage];
+    
+    theStage.count.fetch_add(1, std::memory_order_relaxed);
+    theStage.last.store(ns, std::memory_order_relaxed);
+    theStage.total.fetch_add(ns, std::memory_order_relaxed);
+    unsigned long long oldMax = theStage.max.load(std::memory_order_relaxed);
+    while (ns > oldMax && !theStage.max.compare_exchange_weak(oldMax, ns,
+        std::memory_order_relaxed));
+    
+    // the bin is the number of bits of the duration in usec
+    int bin = 0;
+    for (unsigned long long us = ns/1000; us > 0 &&
+        bin < EXP_TIMING_NUM_BINS-1; us >>= 1)
+        bin++;
+    theStage.hist[bin].fetch_add(1, std::memory_order_relaxed);
+}
+
+
+const char* ExpTiming::getStageName(int stage)
+{
+    if (stage < 0 || stage >= OF_Timing_All)
+        return "unknown";
+    
+    return stageNames[stage];
+}
+
+
+int ExpTiming::getStage(const char *name)
+{
+    for (int i=0; i<OF_Timing_All; i++)
+        if (strcmp(name, stageNames[i]) == 0)
+            return i;
+    
+    return -1;
+}
+
+
+int ExpTiming::getNumBins()
+{
+    return EXP_TIMING_NUM_BINS;
+}
+
+
+double ExpTiming::getBinEdge(int bin)
+{
+    // upper edge [sec] of the bin
+    double edge = 1.0E-6;
+    for (int i=0; i<bin; i++)
+        edge *= 2.0;
+    
+    return edge;
+}
+
+
+void ExpTiming::getStats(int stage, Vector &stats)
+{
+    stats.resize(6);
+    stats.Zero();
+    if (stage < 0 || stage >= OF_Timing_All)
+        return;
+    
+    ExpTimingStage &theStage = theStages[stage];
+    unsigned long long count = theStage.count.load(std::memory_order_relaxed);
+    stats(0) = (double)count;
+    stats(1) = 1.0E-9*theStage.last.load(std::memory_order_relaxed);
+    if (count > 0)
+        stats(2) = 1.0E-9*theStage.total.load(std::memory_order_relaxed)/count;
+    stats(3) = 1.0E-9*theStage.max.load(std::memory_order_relaxed);
+    
+    // percentiles from the histogram
+    unsigned long long numHist = 0, cum = 0;
+    unsigned long long hist[EXP_TIMING_NUM_BINS];
+    for (int j=0; j<EXP_TIMING_NUM_BINS; j++)  {
+        hist[j] = theStage.hist[j].load(std::memory_order_relaxed);
+        numHist += hist[j];
+    }
+    bool p50 = false;
+    for (int j=0; j<EXP_TIMING_NUM_BINS && numHist > 0; j++)  {
+        cum += hist[j];
+        if (!p50 && 2*cum >= numHist)  {
+            stats(4) = ExpTiming::getBinEdge(j);
+            p50 = true;
+        }
+        if (100*cum >= 99*numHist)  {
+            stats(5) = ExpTiming::getBinEdge(j);
+            break;
+        }
+    }
+}
+
+
+void ExpTiming::getHist(int stage, Vector &hist)
+{
+    hist.resize(EXP_TIMING_NUM_BINS);
+    hist.Zero();
+    if (stage < 0 || stage >= OF_Timing_All)
+        return;
+    
+    for (int j=0; j<EXP_TIMING_NUM_BINS; j++)
+        hist(j) = (double)theStages[stage].hist[j].load(
+            std::memory_order_relaxed);
+}
+
+
+void ExpTiming::Print(OPS_Stream &s)
+{
+    char buffer[128];
+    Vector stats(6);
+    
+    s << "****************************************************************\n";
+    s << "* ExpTiming: " << (ExpTiming::isEnabled() ? "enabled" : "disabled");
+    s << "\n*   times in msec, p50/p99 are upper bounds of histogram bins";
+    sprintf(buffer, "\n*   %-10s %10s %10s %10s %10s %10s %10s",
+        "stage", "count", "last", "mean", "max", "p50", "p99");
+    s << buffer;
+    for (int i=0; i<OF_Timing_All; i++)  {
+        ExpTiming::getStats(i, stats);
+        if (stats(0) == 0.0)
+            continue;
+        sprintf(buffer, "\n*   %-10s %10.0f %10.4f %10.4f %10.4f %10.4f %10.4f",
+            stageNames[i], stats(0), 1.0E3*stats(1), 1.0E3*stats(2),
+            1.0E3*stats(3), 1.0E3*stats(4), 1.0E3*stats(5));
+        s << buffer;
+    }
+    s << "\n****************************************************************\n\n";
+}
@@ -0,0 +1,107 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef ExpTiming_h
+#define ExpTiming_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for ExpTiming.
+// ExpTiming collects the wall-clock time spent in each stage of a
+// hybrid simulation step (element update, site, setup transformations,
+// signal filters, control and acquire, channel send and receive, and
+// recorders). For every stage it keeps the number of calls, the last,
+// total and maximum duration and a histogram with logarithmic bins in
+// atomic counters, so that the stages can be timed from any thread
+// without locking. The time of a stage includes all the stages that
+// are nested in it. Timing is disabled by default and then only costs
+// one atomic load per stage. An ExpTimer object times the scope it is
+// declared in.
+
+#include <FrescoGlobals.h>
+
+class Vector;
+class OPS_Stream;
+
+// Timed Stages
+static const int OF_Timing_Element    = 0;  // experimental element update
+static const int OF_Timing_SiteTrial  = 1;  // site setTrialResponse
+static const int OF_Timing_SiteDaq    = 2;  // site checkDaqResponse
+static const int OF_Timing_SetupTrial = 3;  // setup trial transformation
+static const int OF_Timing_SetupDaq   = 4;  // setup daq transformation
+static const int OF_Timing_Filter     = 5;  // signal filtering
+static const int OF_Timing_Control    = 6;  // control control()
+static const int OF_Timing_Acquire    = 7;  // control acquire()
+static const int OF_Timing_Send       = 8;  // channel send
+static const int OF_Timing_Recv       = 9;  // channel receive
+static const int OF_Timing_Record     = 10; // experimental recorders
+static const int OF_Timing_All        = 11;
+
+class ExpTiming
+{
+public:
+    // methods to switch the timing on and off and to clear it
+    static void enable(bool flag);
+    static bool isEnabled();
+    static void reset();
+    
+    // monotonic time [nsec] and method to add the duration
+    // of a stage that started at time tStart [nsec]
+    static long long now();
+    static void add(int stage, long long tStart);
+    
+    // methods to look up the stages by name
+    static const char *getStageName(int stage);
+    static int getStage(const char *name);
+    
+    // methods to get the statistics [sec] of a stage
+    // stats: count, last, mean, max, p50, p99 (p50 and p99 are
+    // the upper bounds of the histogram bins they fall into)
+    static int getNumBins();
+    static double getBinEdge(int bin);
+    static void getStats(int stage, Vector &stats);
+    static void getHist(int stage, Vector &hist);
+    
+    // method to print a report of all stages
+    static void Print(OPS_Stream &s);
+};
+
+
+class ExpTimer
+{
+public:
+    ExpTimer(int stage)
+        : theStage(stage),
+        tStart(ExpTiming::isEnabled() ? ExpTiming::now() : -1) {};
+    ~ExpTimer()
+        {if (tStart >= 0) ExpTiming::add(theStage, tStart);};
+
+private:
+    int theStage;
+    long long tStart;
+};
+
+#endif
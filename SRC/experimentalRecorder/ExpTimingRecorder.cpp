@@ -0,0 +1,217 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementatation of ExpTimingRecorder.
+
+#include <ExpTimingRecorder.h>
+#include <ExpTiming.h>
+
+#include <ID.h>
+#include <Vector.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// response types, stats: count, last, mean, max, p50, p99
+enum {TIMING_STATS, TIMING_LAST, TIMING_MEAN, TIMING_MAX,
+    TIMING_COUNT, TIMING_HIST};
+
+
+ExpTimingRecorder::ExpTimingRecorder(const char** argv, int argc,
+    bool echotime, OPS_Stream &theoutputstream, double deltat)
+    : Recorder(RECORDER_TAGS_ExpTimingRecorder),
+    theStages(0), respType(TIMING_STATS), echoTime(echotime),
+    theOutputStream(&theoutputstream), deltaT(deltat),
+    stageData(0), data(0), nextTimeStampToRecord(0.0)
+{
+    // the last argument is the response type,
+    // the ones before are the stage names
+    int numStageArgs = argc;
+    if (argc > 0)  {
+        numStageArgs = argc-1;
+        if (strcmp(argv[argc-1],"stats") == 0)
+            respType = TIMING_STATS;
+        else if (strcmp(argv[argc-1],"last") == 0)
+            respType = TIMING_LAST;
+        else if (strcmp(argv[argc-1],"mean") == 0)
+            respType = TIMING_MEAN;
+        else if (strcmp(argv[argc-1],"max") == 0)
+            respType = TIMING_MAX;
+        else if (strcmp(argv[argc-1],"count") == 0)
+            respType = TIMING_COUNT;
+        else if (strcmp(argv[argc-1],"hist") == 0 ||
+            strcmp(argv[argc-1],"histogram") == 0)
+            respType = TIMING_HIST;
+        else
+            numStageArgs = argc;
+    }
+    
+    // get the stages, all of them if none are given
+    theStages = new ID(0, OF_Timing_All);
+    if (numStageArgs == 0 ||
+        (numStageArgs == 1 && strcmp(argv[0],"all") == 0))  {
+        for (int i=0; i<OF_Timing_All; i++)
+            (*theStages)[i] = i;
+    } else  {
+        for (int i=0; i<numStageArgs; i++)  {
+            int stage = ExpTiming::getStage(argv[i]);
+            if (stage < 0)  {
+                opserr << "ExpTimingRecorder::ExpTimingRecorder() - "
+                    << "unknown stage " << argv[i] << endln;
+                continue;
+            }
+            (*theStages)[theStages->Size()] = stage;
+        }
+    }
+    int numStages = theStages->Size();
+    
+    theOutputStream->tag("OpenFrescoOutput");
+    
+    int numDbColumns = 0;
+    if (echoTime == true) {
+        theOutputStream->tag("TimeOutput");
+        theOutputStream->tag("ResponseType","time");
+        theOutputStream->endTag();
+        numDbColumns += 1;
+    }
+    
+    // set the response types of each stage
+    char outputData[32];
+    for (int i=0; i<numStages; i++)  {
+        const char *name = ExpTiming::getStageName((*theStages)(i));
+        theOutputStream->tag("ExpTimingOutput");
+        theOutputStream->attr("stage",name);
+        if (respType == TIMING_STATS)  {
+            const char *statNames[6] = {"count", "last", "mean",
+                "max", "p50", "p99"};
+            for (int j=0; j<6; j++)
+                theOutputStream->tag("ResponseType",statNames[j]);
+            numDbColumns += 6;
+        } else if (respType == TIMING_HIST)  {
+            for (int j=0; j<ExpTiming::getNumBins(); j++)  {
+                sprintf(outputData,"bin%d",j+1);
+                theOutputStream->tag("ResponseType",outputData);
+            }
+            numDbColumns += ExpTiming::getNumBins();
+        } else  {
+            theOutputStream->tag("ResponseType",argv[argc-1]);
+            numDbColumns += 1;
+        }
+        theOutputStream->endTag();
+    }
+    
+    // create the vectors to hold the data
+    stageData = new Vector(6);
+    data = new Vector(numDbColumns);
+    if (theStages == 0 || stageData == 0 || data == 0)  {
+        opserr << "ExpTimingRecorder::ExpTimingRecorder() - out of memory\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    // record the stages from now on
+    ExpTiming::enable(true);
+    
+    theOutputStream->tag("Data");
+    
+    // record once at zero
+    this->record(0, 0.0);
+}
+
+
+ExpTimingRecorder::~ExpTimingRecorder()
+{
+    theOutputStream->endTag(); // Data
+    theOutputStream->endTag(); // OpenFrescoOutput
+    
+    if (theOutputStream != 0)
+        delete theOutputStream;
+    if (theStages != 0)
+        delete theStages;
+    if (stageData != 0)
+        delete stageData;
+    if (data != 0)
+        delete data;
+}
+
+
+int ExpTimingRecorder::record(int commitTag, double timeStamp)
+{
+    if (deltaT == 0.0 || timeStamp >= nextTimeStampToRecord)  {
+        
+        if (deltaT != 0.0) 
+            nextTimeStampToRecord = timeStamp + deltaT;
+        
+        int loc = 0;
+        if (echoTime == true) 
+            (*data)(loc++) = timeStamp;
+        
+        // put the timing of each stage in the response vector
+        for (int i=0; i<theStages->Size(); i++)  {
+            if (respType == TIMING_HIST)  {
+                ExpTiming::getHist((*theStages)(i), *stageData);
+                for (int j=0; j<stageData->Size(); j++)
+                    (*data)(loc++) = (*stageData)(j);
+            } else  {
+                ExpTiming::getStats((*theStages)(i), *stageData);
+                switch (respType)  {
+                case TIMING_LAST:
+                    (*data)(loc++) = (*stageData)(1);
+                    break;
+                case TIMING_MEAN:
+                    (*data)(loc++) = (*stageData)(2);
+                    break;
+                case TIMING_MAX:
+                    (*data)(loc++) = (*stageData)(3);
+                    break;
+                case TIMING_COUNT:
+                    (*data)(loc++) = (*stageData)(0);
+                    break;
+                default:
+                    for (int j=0; j<6; j++)
+                        (*data)(loc++) = (*stageData)(j);
+                }
+            }
+        }
+        
+        // send the response vector to the output handler for o/p
+        theOutputStream->write(*data);
+    }
+    
+    // succesfull completion - return 0
+    return 0;
+}
+
+
+int ExpTimingRecorder::restart()
+{
+    if (data != 0)
+        data->Zero();
+    
+    return 0;
+}
@@ -0,0 +1,71 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef ExpTimingRecorder_h
+#define ExpTimingRecorder_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ExpTimingRecorder. An ExpTimingRecorder records the timing
+// statistics that ExpTiming collects for the stages of the hybrid
+// simulation steps.
+
+#include <Recorder.h>
+
+class Vector;
+class ID;
+
+#define RECORDER_TAGS_ExpTimingRecorder 105
+
+class ExpTimingRecorder: public Recorder
+{
+public:
+    // constructors
+    ExpTimingRecorder(const char** argv, int argc, bool echoTime,
+        OPS_Stream &theOutputStream, double deltaT = 0.0);
+    
+    // destructor
+    ~ExpTimingRecorder();
+    
+    int record(int commitTag, double timeStamp);
+    int restart();
+    
+protected:
+
+private:
+    ID *theStages;
+    int respType;
+    bool echoTime;
+    OPS_Stream *theOutputStream;
+    double deltaT;
+    
+    Vector *stageData;
+    Vector *data;
+    double nextTimeStampToRecord;
+};
+
+#endif
@@ -43,6 +43,8 @@
 #include <ExpControlRecorder.h>
 #include <ExpSignalFilterRecorder.h>
 #include <ExpTangentStiffRecorder.h>
+#include <ExpTimingRecorder.h>
+#include <ExpTiming.h>
 
 // output streams
 #include <StandardStream.h>
@@ -51,8 +53,10 @@
 #include <BinaryFileStream.h>
 #include <TCP_Stream.h>
 #include <DatabaseStream.h>
+#include <ExpAsyncStream.h>
+#include <ExpColumnarFileStream.h>
 
-enum outputMode {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BINARY_STREAM, DATA_STREAM_CSV, TCP_STREAM};
+enum outputMode {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BINARY_STREAM, DATA_STREAM_CSV, TCP_STREAM, COLUMNAR_STREAM};
 
 extern SimulationInformation *theSimulationInfo;
 extern ExperimentalSite *getExperimentalSite(int tag);
@@ -90,6 +94,9 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
         int precision = 6;
         bool doScientific = false;
         bool closeOnWrite = false;
+        bool async = false;
+        int numSlots = 64;
+        asyncBackPressure backPressure = ASYNC_BLOCK;
         const char *inetAddr = 0;
         int inetPort;
         int i, j, argi = 2;
@@ -188,6 +195,36 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
                 argi++;
             }
             
+            else if (strcmp(argv[argi],"-async") == 0)  {
+                async = true;
+                argi++;
+            }
+            
+            else if (strcmp(argv[argi],"-bufferSize") == 0)  {
+                argi++;
+                if (Tcl_GetInt(interp, argv[argi], &numSlots) != TCL_OK)
+                    return TCL_ERROR;
+                async = true;
+                argi++;
+            }
+            
+            else if (strcmp(argv[argi],"-backPressure") == 0)  {
+                argi++;
+                if (strcmp(argv[argi],"block") == 0)
+                    backPressure = ASYNC_BLOCK;
+                else if (strcmp(argv[argi],"dropOldest") == 0)
+                    backPressure = ASYNC_DROP_OLDEST;
+                else if (strcmp(argv[argi],"grow") == 0)
+                    backPressure = ASYNC_GROW;
+                else  {
+                    opserr << "WARNING expRecorder Site -backPressure mode - invalid mode " << argv[argi] << endln;
+                    opserr << "Want: block, dropOldest or grow\n";
+                    return TCL_ERROR;
+                }
+                async = true;
+                argi++;
+            }
+            
             else if (strcmp(argv[argi],"-file") == 0)  {
                 fileName = argv[argi+1];
                 const char *pwd = OPS_GetInterpPWD();
@@ -220,6 +257,14 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
                 argi += 2;
             }
             
+            else if ((strcmp(argv[argi],"-columnar") == 0))  {
+                fileName = argv[argi+1];
+                const char *pwd = OPS_GetInterpPWD();
+                theSimulationInfo->addOutputFile(fileName,pwd);
+                eMode = COLUMNAR_STREAM;
+                argi += 2;
+            }
+            
             else if ((strcmp(argv[argi],"-tcp") == 0) || (strcmp(argv[argi],"-TCP") == 0))  {
                 inetAddr = argv[argi+1];
                 if (Tcl_GetInt(interp, argv[argi+2], &inetPort) != TCL_OK)
@@ -265,6 +310,8 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
             theOutputStream = new XmlFileStream(fileName);
         } else if (eMode == BINARY_STREAM && fileName != 0)  {
             theOutputStream = new BinaryFileStream(fileName);
+        } else if (eMode == COLUMNAR_STREAM && fileName != 0)  {
+            theOutputStream = new ExpColumnarFileStream(fileName);
         } else if (eMode == TCP_STREAM && inetAddr != 0)  {
             theOutputStream = new TCP_Stream(inetPort, inetAddr);
         } else if (eMode == DATABASE_STREAM && tableName != 0)  {
@@ -275,6 +322,10 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
         // set precision for stream
         theOutputStream->setPrecision(precision);
         
+        // write the output from a background thread
+        if (async == true)
+            theOutputStream = new ExpAsyncStream(theOutputStream, numSlots, backPressure);
+        
         // construct array of experimental sites
         theSites = new ExperimentalSite* [numSites];
         if (theSites == 0)  {
@@ -310,6 +361,9 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
         int precision = 6;
         bool doScientific = false;
         bool closeOnWrite = false;
+        bool async = false;
+        int numSlots = 64;
+        asyncBackPressure backPressure = ASYNC_BLOCK;
         const char *inetAddr = 0;
         int inetPort;
         int i, j, argi = 2;
@@ -408,6 +462,36 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
                 argi++;
             }
             
+            else if (strcmp(argv[argi],"-async") == 0)  {
+                async = true;
+                argi++;
+            }
+            
+            else if (strcmp(argv[argi],"-bufferSize") == 0)  {
+                argi++;
+                if (Tcl_GetInt(interp, argv[argi], &numSlots) != TCL_OK)
+                    return TCL_ERROR;
+                async = true;
+                argi++;
+            }
+            
+            else if (strcmp(argv[argi],"-backPressure") == 0)  {
+                argi++;
+                if (strcmp(argv[argi],"block") == 0)
+                    backPressure = ASYNC_BLOCK;
+                else if (strcmp(argv[argi],"dropOldest") == 0)
+                    backPressure = ASYNC_DROP_OLDEST;
+                else if (strcmp(argv[argi],"grow") == 0)
+                    backPressure = ASYNC_GROW;
+                else  {
+                    opserr << "WARNING expRecorder Setup -backPressure mode - invalid mode " << argv[argi] << endln;
+                    opserr << "Want: block, dropOldest or grow\n";
+                    return TCL_ERROR;
+                }
+                async = true;
+                argi++;
+            }
+            
             else if (strcmp(argv[argi],"-file") == 0)  {
                 fileName = argv[argi+1];
                 const char *pwd = OPS_GetInterpPWD();
@@ -440,6 +524,14 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
                 argi += 2;
             }
             
+            else if ((strcmp(argv[argi],"-columnar") == 0))  {
+                fileName = argv[argi+1];
+                const char *pwd = OPS_GetInterpPWD();
+                theSimulationInfo->addOutputFile(fileName,pwd);
+                eMode = COLUMNAR_STREAM;
+                argi += 2;
+            }
+            
             else if ((strcmp(argv[argi],"-tcp") == 0) || (strcmp(argv[argi],"-TCP") == 0))  {
                 inetAddr = argv[argi+1];
                 if (Tcl_GetInt(interp, argv[argi+2], &inetPort) != TCL_OK)
@@ -485,6 +577,8 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
             theOutputStream = new XmlFileStream(fileName);
         } else if (eMode == BINARY_STREAM && fileName != 0)  {
             theOutputStream = new BinaryFileStream(fileName);
+        } else if (eMode == COLUMNAR_STREAM && fileName != 0)  {
+            theOutputStream = new ExpColumnarFileStream(fileName);
         } else if (eMode == TCP_STREAM && inetAddr != 0)  {
             theOutputStream = new TCP_Stream(inetPort, inetAddr);
         } else if (eMode == DATABASE_STREAM && tableName != 0)  {
@@ -495,6 +589,10 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
         // set precision for stream
         theOutputStream->setPrecision(precision);
         
+        // write the output from a background thread
+        if (async == true)
+            theOutputStream = new ExpAsyncStream(theOutputStream, numSlots, backPressure);
+        
         // construct array of experimental setups
         theSetups = new ExperimentalSetup* [numSetups];
         if (theSetups == 0)  {
@@ -530,6 +628,9 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
         int precision = 6;
         bool doScientific = false;
         bool closeOnWrite = false;
+        bool async = false;
+        int numSlots = 64;
+        asyncBackPressure backPressure = ASYNC_BLOCK;
         const char *inetAddr = 0;
         int inetPort;
         int i, j, argi = 2;
@@ -628,6 +729,36 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
                 argi++;
             }
             
+            else if (strcmp(argv[argi],"-async") == 0)  {
+                async = true;
+                argi++;
+            }
+            
+            else if (strcmp(argv[argi],"-bufferSize") == 0)  {
+                argi++;
+                if (Tcl_GetInt(interp, argv[argi], &numSlots) != TCL_OK)
+                    return TCL_ERROR;
+                async = true;
+                argi++;
+            }
+            
+            else if (strcmp(argv[argi],"-backPressure") == 0)  {
+                argi++;
+                if (strcmp(argv[argi],"block") == 0)
+                    backPressure = ASYNC_BLOCK;
+                else if (strcmp(argv[argi],"dropOldest") == 0)
+                    backPressure = ASYNC_DROP_OLDEST;
+                else if (strcmp(argv[argi],"grow") == 0)
+                    backPressure = ASYNC_GROW;
+                else  {
+                    opserr << "WARNING expRecorder Control -backPressure mode - invalid mode " << argv[argi] << endln;
+                    opserr << "Want: block, dropOldest or grow\n";
+                    return TCL_ERROR;
+                }
+                async = true;
+                argi++;
+            }
+            
             else if (strcmp(argv[argi],"-file") == 0)  {
                 fileName = argv[argi+1];
                 const char *pwd = OPS_GetInterpPWD();
@@ -660,6 +791,14 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
                 argi += 2;
             }
             
+            else if ((strcmp(argv[argi],"-columnar") == 0))  {
+                fileName = argv[argi+1];
+                const char *pwd = OPS_GetInterpPWD();
+                theSimulationInfo->addOutputFile(fileName,pwd);
+                eMode = COLUMNAR_STREAM;
+                argi += 2;
+            }
+            
             else if ((strcmp(argv[argi],"-tcp") == 0) || (strcmp(argv[argi],"-TCP") == 0))  {
                 inetAddr = argv[argi+1];
                 if (Tcl_GetInt(interp, argv[argi+2], &inetPort) != TCL_OK)
@@ -705,6 +844,8 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
             theOutputStream = new XmlFileStream(fileName);
         } else if (eMode == BINARY_STREAM && fileName != 0)  {
             theOutputStream = new BinaryFileStream(fileName);
+        } else if (eMode == COLUMNAR_STREAM && fileName != 0)  {
+            theOutputStream = new ExpColumnarFileStream(fileName);
         } else if (eMode == TCP_STREAM && inetAddr != 0)  {
             theOutputStream = new TCP_Stream(inetPort, inetAddr);
         } else if (eMode == DATABASE_STREAM && tableName != 0)  {
@@ -715,6 +856,10 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
         // set precision for stream
         theOutputStream->setPrecision(precision);
         
+        // write the output from a background thread
+        if (async == true)
+            theOutputStream = new ExpAsyncStream(theOutputStream, numSlots, backPressure);
+        
         // construct array of experimental controls
         theControls = new ExperimentalControl* [numControls];
         if (theControls == 0)  {
@@ -739,6 +884,191 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
         if (data != 0)
             delete [] data;
     }
+    // ----------------------------------------------------------------------------
+    else if (strcmp(argv[1],"Timing") == 0)  {
+        bool echoTime = false;
+        outputMode eMode = STANDARD_STREAM;
+        double deltaT = 0.0;
+        int precision = 6;
+        bool doScientific = false;
+        bool closeOnWrite = false;
+        bool async = false;
+        int numSlots = 64;
+        asyncBackPressure backPressure = ASYNC_BLOCK;
+        const char *inetAddr = 0;
+        int inetPort;
+        int i, j, argi = 2;
+        int flags = 0;
+        int sizeData = 0;
+        
+        while (flags == 0 && argi < argc)  {
+            
+            if ((strcmp(argv[argi],"-time") == 0) || (strcmp(argv[argi],"-load") == 0))  {
+                echoTime = true;
+                argi++;
+            }
+            
+            else if ((strcmp(argv[argi],"-dT") == 0) || (strcmp(argv[argi],"-dt") == 0))  {
+                argi++;
+                if (Tcl_GetDouble(interp, argv[argi], &deltaT) != TCL_OK)
+                    return TCL_ERROR;
+                argi++;
+            }
+            
+            else if (strcmp(argv[argi],"-precision") == 0)  {
+                argi++;
+                if (Tcl_GetInt(interp, argv[argi], &precision) != TCL_OK)
+                    return TCL_ERROR;
+                argi++;
+            }
+            
+            else if (strcmp(argv[argi],"-scientific") == 0)  {
+                doScientific = true;
+                argi++;
+            }
+            
+            else if (strcmp(argv[argi],"-closeOnWrite") == 0)  {
+                closeOnWrite = true;
+                argi++;
+            }
+            
+            else if (strcmp(argv[argi],"-async") == 0)  {
+                async = true;
+                argi++;
+            }
+            
+            else if (strcmp(argv[argi],"-bufferSize") == 0)  {
+                argi++;
+                if (Tcl_GetInt(interp, argv[argi], &numSlots) != TCL_OK)
+                    return TCL_ERROR;
+                async = true;
+                argi++;
+            }
+            
+            else if (strcmp(argv[argi],"-backPressure") == 0)  {
+                argi++;
+                if (strcmp(argv[argi],"block") == 0)
+                    backPressure = ASYNC_BLOCK;
+                else if (strcmp(argv[argi],"dropOldest") == 0)
+                    backPressure = ASYNC_DROP_OLDEST;
+                else if (strcmp(argv[argi],"grow") == 0)
+                    backPressure = ASYNC_GROW;
+                else  {
+                    opserr << "WARNING expRecorder Timing -backPressure mode - invalid mode " << argv[argi] << endln;
+                    opserr << "Want: block, dropOldest or grow\n";
+                    return TCL_ERROR;
+                }
+                async = true;
+                argi++;
+            }
+            
+            else if (strcmp(argv[argi],"-file") == 0)  {
+                fileName = argv[argi+1];
+                const char *pwd = OPS_GetInterpPWD();
+                theSimulationInfo->addOutputFile(fileName,pwd);
+                eMode = DATA_STREAM;
+                argi += 2;
+            }
+            
+            else if ((strcmp(argv[argi],"-csv") == 0) || (strcmp(argv[argi],"-fileCSV") == 0))  {
+                fileName = argv[argi+1];
+                const char *pwd = OPS_GetInterpPWD();
+                theSimulationInfo->addOutputFile(fileName,pwd);
+                eMode = DATA_STREAM_CSV;
+                argi += 2;
+            }
+            
+            else if ((strcmp(argv[argi],"-xml") == 0) || (strcmp(argv[argi],"-nees") == 0))  {
+                fileName = argv[argi+1];
+                const char *pwd = OPS_GetInterpPWD();
+                theSimulationInfo->addOutputFile(fileName,pwd);
+                eMode = XML_STREAM;
+                argi += 2;
+            }
+            
+            else if ((strcmp(argv[argi],"-binary") == 0))  {
+                fileName = argv[argi+1];
+                const char *pwd = OPS_GetInterpPWD();
+                theSimulationInfo->addOutputFile(fileName,pwd);
+                eMode = BINARY_STREAM;
+                argi += 2;
+            }
+            
+            else if ((strcmp(argv[argi],"-columnar") == 0))  {
+                fileName = argv[argi+1];
+                const char *pwd = OPS_GetInterpPWD();
+                theSimulationInfo->addOutputFile(fileName,pwd);
+                eMode = COLUMNAR_STREAM;
+                argi += 2;
+            }
+            
+            else if ((strcmp(argv[argi],"-tcp") == 0) || (strcmp(argv[argi],"-TCP") == 0))  {
+                inetAddr = argv[argi+1];
+                if (Tcl_GetInt(interp, argv[argi+2], &inetPort) != TCL_OK)
+                    return TCL_ERROR;
+                eMode = TCP_STREAM;
+                argi += 3;
+            }
+            
+            else if (strcmp(argv[argi],"-database") == 0)  {
+                theRecorderDatabase = OPS_GetFEDatastore();
+                if (theRecorderDatabase != 0)  {
+                    tableName = argv[argi+1];
+                    eMode = DATABASE_STREAM;
+                } else {
+                    opserr << "WARNING expRecorder Timing .. -database &lt;fileName&gt; - NO CURRENT DATABASE, results to File instead\n";
+                    fileName = argv[argi+1];
+                }
+                argi += 2;
+            }
+            
+            else  {
+                // first unknown string then is assumed to start
+                // the stages and the timing response request
+                sizeData = argc-argi;
+                flags = 1;
+            }
+        }
+        
+        // without response request all stages are recorded
+        
+        const char **data = new const char *[sizeData];
+        
+        for (i=argi, j=0; i<argc; i++, j++)
+            data[j] = argv[i];
+        
+        // construct theOutputStream
+        if (eMode == DATA_STREAM && fileName != 0)  {
+            theOutputStream = new DataFileStream(fileName, OVERWRITE, 2, 0, closeOnWrite, precision, doScientific);
+        } else if (eMode == DATA_STREAM_CSV && fileName != 0)  {
+            theOutputStream = new DataFileStream(fileName, OVERWRITE, 2, 1, closeOnWrite, precision, doScientific);
+        } else if (eMode == XML_STREAM && fileName != 0)  {
+            theOutputStream = new XmlFileStream(fileName);
+        } else if (eMode == BINARY_STREAM && fileName != 0)  {
+            theOutputStream = new BinaryFileStream(fileName);
+        } else if (eMode == COLUMNAR_STREAM && fileName != 0)  {
+            theOutputStream = new ExpColumnarFileStream(fileName);
+        } else if (eMode == TCP_STREAM && inetAddr != 0)  {
+            theOutputStream = new TCP_Stream(inetPort, inetAddr);
+        } else if (eMode == DATABASE_STREAM && tableName != 0)  {
+            theOutputStream = new DatabaseStream(OPS_GetFEDatastore(), tableName);
+        } else
+            theOutputStream = new StandardStream();
+        
+        // set precision for stream
+        theOutputStream->setPrecision(precision);
+        
+        // write the output from a background thread
+        if (async == true)
+            theOutputStream = new ExpAsyncStream(theOutputStream, numSlots, backPressure);
+        
+        // now create the ExpTimingRecorder
+        (*theRecorder) = new ExpTimingRecorder(data, sizeData, echoTime, *theOutputStream, deltaT);
+        
+        // cleanup dynamic memory
+        if (data != 0)
+            delete [] data;
+    }
     // ----------------------------------------------------------------------------	
     else if (strcmp(argv[1],"SignalFilter") == 0)  {
         int numFilters = 0;
@@ -750,6 +1080,9 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
         int precision = 6;
         bool doScientific = false;
         bool closeOnWrite = false;
+        bool async = false;
+        int numSlots = 64;
+        asyncBackPressure backPressure = ASYNC_BLOCK;
         const char *inetAddr = 0;
         int inetPort;
         int i, j, argi = 2;
@@ -848,6 +1181,36 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
                 argi++;
             }
             
+            else if (strcmp(argv[argi],"-async") == 0)  {
+                async = true;
+                argi++;
+            }
+            
+            else if (strcmp(argv[argi],"-bufferSize") == 0)  {
+                argi++;
+                if (Tcl_GetInt(interp, argv[argi], &numSlots) != TCL_OK)
+                    return TCL_ERROR;
+                async = true;
+                argi++;
+            }
+            
+            else if (strcmp(argv[argi],"-backPressure") == 0)  {
+                argi++;
+                if (strcmp(argv[argi],"block") == 0)
+                    backPressure = ASYNC_BLOCK;
+                else if (strcmp(argv[argi],"dropOldest") == 0)
+                    backPressure = ASYNC_DROP_OLDEST;
+                else if (strcmp(argv[argi],"grow") == 0)
+                    backPressure = ASYNC_GROW;
+                else  {
+                    opserr << "WARNING expRecorder SignalFilter -backPressure mode - invalid mode " << argv[argi] << endln;
+                    opserr << "Want: block, dropOldest or grow\n";
+                    return TCL_ERROR;
+                }
+                async = true;
+                argi++;
+            }
+            
             else if (strcmp(argv[argi],"-file") == 0)  {
                 fileName = argv[argi+1];
                 const char *pwd = OPS_GetInterpPWD();
@@ -880,6 +1243,14 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
                 argi += 2;
             }
             
+            else if ((strcmp(argv[argi],"-columnar") == 0))  {
+                fileName = argv[argi+1];
+                const char *pwd = OPS_GetInterpPWD();
+                theSimulationInfo->addOutputFile(fileName,pwd);
+                eMode = COLUMNAR_STREAM;
+                argi += 2;
+            }
+            
             else if ((strcmp(argv[argi],"-tcp") == 0) || (strcmp(argv[argi],"-TCP") == 0))  {
                 inetAddr = argv[argi+1];
                 if (Tcl_GetInt(interp, argv[argi+2], &inetPort) != TCL_OK)
@@ -925,6 +1296,8 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
             theOutputStream = new XmlFileStream(fileName);
         } else if (eMode == BINARY_STREAM && fileName != 0)  {
             theOutputStream = new BinaryFileStream(fileName);
+        } else if (eMode == COLUMNAR_STREAM && fileName != 0)  {
+            theOutputStream = new ExpColumnarFileStream(fileName);
         } else if (eMode == TCP_STREAM && inetAddr != 0)  {
             theOutputStream = new TCP_Stream(inetPort, inetAddr);
         } else if (eMode == DATABASE_STREAM && tableName != 0)  {
@@ -935,6 +1308,10 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
         // set precision for stream
         theOutputStream->setPrecision(precision);
         
+        // write the output from a background thread
+        if (async == true)
+            theOutputStream = new ExpAsyncStream(theOutputStream, numSlots, backPressure);
+        
         // construct array of experimental signal filters
         theFilters = new ExperimentalSignalFilter* [numFilters];
         if (theFilters == 0)  {
@@ -970,6 +1347,9 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
         int precision = 6;
         bool doScientific = false;
         bool closeOnWrite = false;
+        bool async = false;
+        int numSlots = 64;
+        asyncBackPressure backPressure = ASYNC_BLOCK;
         const char *inetAddr = 0;
         int inetPort;
         int i, j, argi = 2;
@@ -1068,6 +1448,36 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
                 argi++;
             }
             
+            else if (strcmp(argv[argi],"-async") == 0)  {
+                async = true;
+                argi++;
+            }
+            
+            else if (strcmp(argv[argi],"-bufferSize") == 0)  {
+                argi++;
+                if (Tcl_GetInt(interp, argv[argi], &numSlots) != TCL_OK)
+                    return TCL_ERROR;
+                async = true;
+                argi++;
+            }
+            
+            else if (strcmp(argv[argi],"-backPressure") == 0)  {
+                argi++;
+                if (strcmp(argv[argi],"block") == 0)
+                    backPressure = ASYNC_BLOCK;
+                else if (strcmp(argv[argi],"dropOldest") == 0)
+                    backPressure = ASYNC_DROP_OLDEST;
+                else if (strcmp(argv[argi],"grow") == 0)
+                    backPressure = ASYNC_GROW;
+                else  {
+                    opserr << "WARNING expRecorder TangentStiff -backPressure mode - invalid mode " << argv[argi] << endln;
+                    opserr << "Want: block, dropOldest or grow\n";
+                    return TCL_ERROR;
+                }
+                async = true;
+                argi++;
+            }
+            
             else if (strcmp(argv[argi],"-file") == 0)  {
                 fileName = argv[argi+1];
                 const char *pwd = OPS_GetInterpPWD();
@@ -1100,6 +1510,14 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
                 argi += 2;
             }
             
+            else if ((strcmp(argv[argi],"-columnar") == 0))  {
+                fileName = argv[argi+1];
+                const char *pwd = OPS_GetInterpPWD();
+                theSimulationInfo->addOutputFile(fileName,pwd);
+                eMode = COLUMNAR_STREAM;
+                argi += 2;
+            }
+            
             else if ((strcmp(argv[argi],"-tcp") == 0) || (strcmp(argv[argi],"-TCP") == 0))  {
                 inetAddr = argv[argi+1];
                 if (Tcl_GetInt(interp, argv[argi+2], &inetPort) != TCL_OK)
@@ -1145,6 +1563,8 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
             theOutputStream = new XmlFileStream(fileName);
         } else if (eMode == BINARY_STREAM && fileName != 0)  {
             theOutputStream = new BinaryFileStream(fileName);
+        } else if (eMode == COLUMNAR_STREAM && fileName != 0)  {
+            theOutputStream = new ExpColumnarFileStream(fileName);
         } else if (eMode == TCP_STREAM && inetAddr != 0)  {
             theOutputStream = new TCP_Stream(inetPort, inetAddr);
         } else if (eMode == DATABASE_STREAM && tableName != 0)  {
@@ -1155,6 +1575,10 @@ int TclCreateExpRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
         // set precision for stream
         theOutputStream->setPrecision(precision);
         
+        // write the output from a background thread
+        if (async == true)
+            theOutputStream = new ExpAsyncStream(theOutputStream, numSlots, backPressure);
+        
         // construct array of experimental tangent stiffnesses
         theTangStiffs = new ExperimentalTangentStiff* [numTangStif];
         if (theTangStiffs == 0)  {
@@ -1286,3 +1710,71 @@ int TclExpRecord(ClientData clientData, Tcl_Interp *interp,
     
     return TCL_OK;
 }
+
+
+int TclExpTimingReport(ClientData clientData, Tcl_Interp *interp,
+    int argc, TCL_Char **argv)
+{
+    TCL_Char *fileName = 0;
+    bool report = true;
+    
+    int argi = 1;
+    while (argi < argc)  {
+        if (strcmp(argv[argi],"-enable") == 0)  {
+            ExpTiming::enable(true);
+            report = false;
+            argi++;
+        }
+        else if (strcmp(argv[argi],"-disable") == 0)  {
+            ExpTiming::enable(false);
+            report = false;
+            argi++;
+        }
+        else if (strcmp(argv[argi],"-reset") == 0)  {
+            ExpTiming::reset();
+            report = false;
+            argi++;
+        }
+        else if (strcmp(argv[argi],"-file") == 0 && argi+1 < argc)  {
+            fileName = argv[argi+1];
+            report = true;
+            argi += 2;
+        }
+        else  {
+            opserr << "WARNING invalid expTimingReport option " << argv[argi] << endln;
+            opserr << "Want: expTimingReport <-enable> <-disable> <-reset> <-file fileName>\n";
+            return TCL_ERROR;
+        }
+    }
+    if (report == false)
+        return TCL_OK;
+    
+    // print the report to the screen or to a file
+    if (fileName != 0)  {
+        StandardStream theFile;
+        if (theFile.setFile(fileName, OVERWRITE, false) < 0)  {
+            opserr << "WARNING expTimingReport - could not open file " << fileName << endln;
+            return TCL_ERROR;
+        }
+        ExpTiming::Print(theFile);
+    } else  {
+        ExpTiming::Print(opserr);
+    }
+    
+    // return the statistics of the timed stages as
+    // a list of {stage count last mean max p50 p99}
+    char buffer[256];
+    Vector stats(6);
+    Tcl_ResetResult(interp);
+    for (int i=0; i<OF_Timing_All; i++)  {
+        ExpTiming::getStats(i, stats);
+        if (stats(0) == 0.0)
+            continue;
+        sprintf(buffer, "%s %.0f %.6e %.6e %.6e %.6e %.6e",
+            ExpTiming::getStageName(i), stats(0), stats(1), stats(2),
+            stats(3), stats(4), stats(5));
+        Tcl_AppendElement(interp, buffer);
+    }
+    
+    return TCL_OK;
+}
@@ -0,0 +1,405 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// ActuatorKinematics2d.
+
+#include "ActuatorKinematics2d.h"
+
+#include <OPS_Globals.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+ActuatorKinematics2d::ActuatorKinematics2d(int nAct, int nlgeom)
+    : numAct(nAct), nlGeom(nlgeom),
+    rx(0), ry(0), nx(0), ny(0), La(0), valid(false),
+    Rrx(0), Rry(0), ux(0), uy(0), len(0), J(nAct,3),
+    maxIter(15), tol(1.0E-12), solved(false), dIter(3), solverInfo(2)
+{
+    if (numAct < 1)  {
+        opserr << "ActuatorKinematics2d::ActuatorKinematics2d() - "
+            << "invalid number of actuators: " << numAct << endln;
+        exit(OF_ReturnType_failed);
+    }
+    
+    // allocate the geometry and the kinematics of all actuators
+    this->allocate();
+    for (int i=0; i<10*numAct; i++)
+        rx[i] = 0.0;
+    
+    for (int i=0; i<3; i++)  {
+        dLast[i] = 0.0;
+        dActSol[i] = 0.0;
+        dSol[i] = 0.0;
+    }
+}
+
+
+ActuatorKinematics2d::ActuatorKinematics2d(const ActuatorKinematics2d& ak)
+    : numAct(ak.numAct), nlGeom(ak.nlGeom),
+    rx(0), ry(0), nx(0), ny(0), La(0), valid(false),
+    Rrx(0), Rry(0), ux(0), uy(0), len(0), J(ak.numAct,3),
+    maxIter(ak.maxIter), tol(ak.tol), solved(false),
+    dIter(3), solverInfo(2)
+{
+    this->allocate();
+    for (int i=0; i<10*numAct; i++)
+        rx[i] = ak.rx[i];
+    
+    for (int i=0; i<3; i++)  {
+        dLast[i] = 0.0;
+        dActSol[i] = 0.0;
+        dSol[i] = 0.0;
+    }
+}
+
+
+ActuatorKinematics2d::~ActuatorKinematics2d()
+{
+    if (rx != 0)
+        delete [] rx;
+}
+
+
+int ActuatorKinematics2d::getGeometry(int nlGeom, const char *posAct)
+{
+    if (posAct == 0 || (nlGeom != 0 && nlGeom != 1))
+        return -1;
+    
+    if (strcmp(posAct,"left") == 0)
+        return (nlGeom == 0) ? ES_linearLeft : ES_nonlinearLeft;
+    else if (strcmp(posAct,"right") == 0)
+        return (nlGeom == 0) ? ES_linearRight : ES_nonlinearRight;
+    
+    return -1;
+}
+
+
+int ActuatorKinematics2d::setActuator(int i, double rX, double rY,
+    double nX, double nY, double la)
+{
+    if (i < 0 || i >= numAct)  {
+        opserr << "ActuatorKinematics2d::setActuator() - "
+            << "actuator " << i << " out of bound\n";
+        return OF_ReturnType_failed;
+    }
+    
+    rx[i] = rX;
+    ry[i] = rY;
+    nx[i] = nX;
+    ny[i] = nY;
+    La[i] = la;
+    valid = false;
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ActuatorKinematics2d::getNumActuators() const
+{
+    return numAct;
+}
+
+
+int ActuatorKinematics2d::transfDisp(const Vector &d, Vector &dAct)
+{
+    // linear geometry
+    if (nlGeom == 0)  {
+        const Matrix &J0 = this->getJacobian(d);
+        dAct.addMatrixVector(0.0, J0, d, 1.0);
+        return OF_ReturnType_completed;
+    }
+    
+    // nonlinear geometry
+    this->update(d);
+    for (int i=0; i<numAct; i++)
+        dAct(i) = this->getActDisp(i, d);
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ActuatorKinematics2d::transfDispInv(const Vector &dAct, Vector &d)
+{
+    if (numAct != 2 && numAct != 3)  {
+        opserr << "ActuatorKinematics2d::transfDispInv() - "
+            << "only implemented for two or three actuators\n";
+        return OF_ReturnType_failed;
+    }
+    
+    // the control point displacements of the last solution
+    // are reused if the actuator displacements did not change
+    int i, j, k;
+    bool changed = !solved;
+    for (i=0; i<numAct; i++)
+        changed = changed || (dAct(i) != dActSol[i]);
+    if (!changed)  {
+        for (i=0; i<3; i++)
+            d(i) = dSol[i];
+        this->update(d);
+        return OF_ReturnType_completed;
+    }
+    
+    // controlled directions (ux, uy, rz) or (ux, rz)
+    int dof[3] = {0, 1, 2};
+    if (numAct == 2)
+        dof[1] = 2;
+    
+    // start Newton's method from the last solution
+    for (i=0; i<3; i++)
+        dIter(i) = dSol[i];
+    
+    double A[3][3], r[3], dx[3], norm;
+    int iter = 0;
+    while (true)  {
+        // residual and Jacobian w.r.t. the controlled directions
+        this->update(dIter);
+        norm = 0.0;
+        for (i=0; i<numAct; i++)  {
+            r[i] = this->getActDisp(i, dIter) - dAct(i);
+            norm += r[i]*r[i];
+            for (j=0; j<numAct; j++)
+                A[i][j] = J(i,dof[j]);
+        }
+        norm = sqrt(norm);
+        if (norm < tol || iter == maxIter)
+            break;
+        
+        // solve A*dx = r with Gaussian elimination and partial pivoting
+        for (k=0; k<numAct; k++)  {
+            int p = k;
+            for (i=k+1; i<numAct; i++)
+                if (fabs(A[i][k]) > fabs(A[p][k]))
+                    p = i;
+            if (A[p][k] == 0.0)  {
+                opserr << "ActuatorKinematics2d::transfDispInv() - "
+                    << "singular Jacobian\n";
+                solverInfo(1) += 1.0;
+                return OF_ReturnType_failed;
+            }
+            if (p != k)  {
+                for (j=k; j<numAct; j++)  {
+                    double tmp = A[k][j];
+                    A[k][j] = A[p][j];
+                    A[p][j] = tmp;
+                }
+                double tmp = r[k];
+                r[k] = r[p];
+                r[p] = tmp;
+            }
+            for (i=k+1; i<numAct; i++)  {
+                double fact = A[i][k]/A[k][k];
+                for (j=k+1; j<numAct; j++)
+                    A[i][j] -= fact*A[k][j];
+                r[i] -= fact*r[k];
+            }
+        }
+        for (k=numAct-1; k>=0; k--)  {
+            dx[k] = r[k];
+            for (j=k+1; j<numAct; j++)
+                dx[k] -= A[k][j]*dx[j];
+            dx[k] /= A[k][k];
+        }
+        
+        // update the control point displacements
+        for (i=0; i<numAct; i++)
+            dIter(dof[i]) -= dx[i];
+        iter++;
+    }
+    
+    // issue warning if iteration did not converge
+    solverInfo(0) = iter;
+    if (norm >= tol)  {
+        opserr << "WARNING ActuatorKinematics2d::transfDispInv() - "
+            << "did not converge after " << iter
+            << " iterations and norm: " << norm << endln;
+        solverInfo(1) += 1.0;
+    }
+    
+    // save the solution, the kinematics are already up to date
+    for (i=0; i<numAct; i++)
+        dActSol[i] = dAct(i);
+    for (i=0; i<3; i++)  {
+        dSol[i] = dIter(i);
+        d(i) = dIter(i);
+    }
+    solved = true;
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ActuatorKinematics2d::transfVel(const Vector &d, const Vector &v,
+    Vector &vAct)
+{
+    // the actuator velocities are the Jacobian times the velocities
+    const Matrix &Jd = this->getJacobian(d);
+    vAct.addMatrixVector(0.0, Jd, v, 1.0);
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ActuatorKinematics2d::transfAccel(const Vector &d, const Vector &v,
+    const Vector &a, Vector &aAct)
+{
+    // linear geometry
+    if (nlGeom == 0)  {
+        const Matrix &J0 = this->getJacobian(d);
+        aAct.addMatrixVector(0.0, J0, a, 1.0);
+        return OF_ReturnType_completed;
+    }
+    
+    // nonlinear geometry
+    this->update(d);
+    double v2sq = v(2)*v(2);
+    for (int i=0; i<numAct; i++)  {
+        // velocity and acceleration of the actuator joint
+        double vx = v(0) - Rry[i]*v(2);
+        double vy = v(1) + Rrx[i]*v(2);
+        double ax = a(0) - Rry[i]*a(2) - Rrx[i]*v2sq;
+        double ay = a(1) + Rrx[i]*a(2) - Rry[i]*v2sq;
+    
+        if (La[i] > 0.0)  {
+            // second derivative of the actuator length
+            double vl = ux[i]*vx + uy[i]*vy;
+            aAct(i) = ux[i]*ax + uy[i]*ay + (vx*vx + vy*vy - vl*vl)/len[i];
+        }
+        else  {
+            aAct(i) = nx[i]*ax + ny[i]*ay;
+        }
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ActuatorKinematics2d::transfForce(const Vector &d, const Vector &qAct,
+    Vector &q)
+{
+    const Matrix &Jd = this->getJacobian(d);
+    q.addMatrixTransposeVector(0.0, Jd, qAct, 1.0);
+    
+    return OF_ReturnType_completed;
+}
+
+
+const Matrix& ActuatorKinematics2d::getJacobian(const Vector &d)
+{
+    this->update(d);
+    
+    return J;
+}
+
+
+const Vector& ActuatorKinematics2d::getSolverInfo() const
+{
+    return solverInfo;
+}
+
+
+void ActuatorKinematics2d::allocate()
+{
+    // all arrays share one block of memory
+    rx  = new double [10*numAct];
+    ry  = &rx[numAct];
+    nx  = &rx[2*numAct];
+    ny  = &rx[3*numAct];
+    La  = &rx[4*numAct];
+    Rrx = &rx[5*numAct];
+    Rry = &rx[6*numAct];
+    ux  = &rx[7*numAct];
+    uy  = &rx[8*numAct];
+    len = &rx[9*numAct];
+}
+
+
+double ActuatorKinematics2d::getActDisp(int i, const Vector &d) const
+{
+    // displacement of actuator i, requires the kinematics at d
+    if (nlGeom == 0)
+        return J(i,0)*d(0) + J(i,1)*d(1) + J(i,2)*d(2);
+    else if (La[i] > 0.0)
+        return len[i] - La[i];
+    
+    return nx[i]*(d(0)+Rrx[i]-rx[i]) + ny[i]*(d(1)+Rry[i]-ry[i]);
+}
+
+
+void ActuatorKinematics2d::update(const Vector &d)
+{
+    // linear geometry has a constant Jacobian
+    if (nlGeom == 0)  {
+        if (!valid)  {
+            for (int i=0; i<numAct; i++)  {
+                J(i,0) = nx[i];
+                J(i,1) = ny[i];
+                J(i,2) = -nx[i]*ry[i] + ny[i]*rx[i];
+            }
+            valid = true;
+        }
+        return;
+    }
+    
+    // nonlinear geometry only changes with the displacements
+    if (valid && d(0) == dLast[0] && d(1) == dLast[1] && d(2) == dLast[2])
+        return;
+    
+    double c = cos(d(2));
+    double s = sin(d(2));
+    for (int i=0; i<numAct; i++)  {
+        // rotated joint offset, its derivative w.r.t. rz is (-Rry,Rrx)
+        Rrx[i] = c*rx[i] - s*ry[i];
+        Rry[i] = s*rx[i] + c*ry[i];
+    
+        if (La[i] > 0.0)  {
+            // actuator vector from the base to the joint
+            double lx = d(0) + Rrx[i] - rx[i] + La[i]*nx[i];
+            double ly = d(1) + Rry[i] - ry[i] + La[i]*ny[i];
+            len[i] = sqrt(lx*lx + ly*ly);
+            ux[i] = lx/len[i];
+            uy[i] = ly/len[i];
+        }
+        else  {
+            len[i] = 0.0;
+            ux[i] = nx[i];
+            uy[i] = ny[i];
+        }
+        J(i,0) = ux[i];
+        J(i,1) = uy[i];
+        J(i,2) = -ux[i]*Rry[i] + uy[i]*Rrx[i];
+    }
+    
+    dLast[0] = d(0);
+    dLast[1] = d(1);
+    dLast[2] = d(2);
+    valid = true;
+}
@@ -0,0 +1,136 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef ActuatorKinematics2d_h
+#define ActuatorKinematics2d_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ActuatorKinematics2d. ActuatorKinematics2d transforms the response
+// of the control point of a rigid loading beam (ux, uy, rz) into the
+// response of the actuators that are attached to it in a plane. Each
+// actuator is defined by the offset of its joint on the beam from
+// the control point, the direction from its base to the joint and
+// its initial length. The actuator lengths, unit vectors and the
+// Jacobian only depend on the displacements and are therefore
+// evaluated once and reused as long as the displacements do not
+// change, i.e. for the disp, vel, accel and force transformations
+// of one step. The inverse transformation of the displacements is
+// solved with Newton's method, which is started from the solution of
+// the previous step and therefore converges in one or two iterations.
+
+#include <FrescoGlobals.h>
+#include <Vector.h>
+#include <Matrix.h>
+
+// geometry of the setups with actuators in a plane, resolved from
+// the nlGeom flag and the position of the horizontal actuator(s)
+enum ES_Geometry2d  {
+    ES_linearLeft = 0,
+    ES_linearRight = 1,
+    ES_nonlinearLeft = 2,
+    ES_nonlinearRight = 3
+};
+
+class ActuatorKinematics2d
+{
+public:
+    // constructors
+    ActuatorKinematics2d(int numAct, int nlGeom = 0);
+    ActuatorKinematics2d(const ActuatorKinematics2d& ak);
+    
+    // destructor
+    ~ActuatorKinematics2d();
+    
+    // method to resolve the geometry from the nlGeom flag and the
+    // position of the horizontal actuator(s) (left, right), returns
+    // -1 if the position is unknown
+    static int getGeometry(int nlGeom, const char *posAct);
+    
+    // method to define actuator i with the joint offset (rx,ry) from
+    // the control point, the unit vector (nx,ny) from the base to the
+    // joint and the initial length La, an actuator with La = 0 stays
+    // aligned with (nx,ny) (e.g. guided by a rigid linkage)
+    int setActuator(int i, double rx, double ry,
+        double nx, double ny, double La);
+    
+    int getNumActuators() const;
+    
+    // methods to transform the control point response (ux,uy,rz)
+    // into the actuator response
+    int transfDisp(const Vector &d, Vector &dAct);
+    int transfVel(const Vector &d, const Vector &v, Vector &vAct);
+    int transfAccel(const Vector &d, const Vector &v, const Vector &a,
+        Vector &aAct);
+    
+    // method to transform the actuator forces into the control
+    // point forces (transpose of the Jacobian)
+    int transfForce(const Vector &d, const Vector &qAct, Vector &q);
+    
+    // method to get the Jacobian of the actuator displacements
+    const Matrix &getJacobian(const Vector &d);
+    
+    // method to transform the actuator displacements into the control
+    // point displacements, with two actuators the vertical displacement
+    // uy is not controlled and set to zero
+    int transfDispInv(const Vector &dAct, Vector &d);
+    
+    // method to get the number of iterations of the last inverse
+    // transformation and the number of failed inverse transformations
+    const Vector &getSolverInfo() const;
+    
+private:
+    void allocate();
+    void update(const Vector &d);
+    double getActDisp(int i, const Vector &d) const;
+    
+    int numAct;         // number of actuators
+    int nlGeom;         // non-linear geometry (0: linear, 1: nonlinear)
+    
+    double *rx, *ry;    // joint offsets from the control point
+    double *nx, *ny;    // initial unit vectors from base to joint
+    double *La;         // initial actuator lengths
+    
+    // kinematics at the displacements dLast
+    bool valid;         // flag if the kinematics are up to date
+    double dLast[3];    // displacements of the last evaluation
+    double *Rrx, *Rry;  // rotated joint offsets
+    double *ux, *uy;    // actuator unit vectors
+    double *len;        // actuator lengths
+    Matrix J;           // Jacobian of the actuator displacements
+    
+    // Newton's method for the inverse transformation
+    int maxIter;        // maximum number of iterations
+    double tol;         // tolerance for the displacement residual
+    bool solved;        // flag if a solution is available
+    double dActSol[3];  // actuator displacements of the last solution
+    double dSol[3];     // control point displacements of the last solution
+    Vector dIter;       // control point displacements of the iteration
+    Vector solverInfo;  // iterations of last solution, number of failures
+};
+
+#endif
@@ -31,12 +31,26 @@
 
 #include "ESAggregator.h"
 
+#include <chrono>
+
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+// jobs of the worker threads
+enum ES_AggregatorJob  {
+    ES_jobTrial = 1,
+    ES_jobDaq = 2
+};
+
 
 ESAggregator::ESAggregator(int tag, int nSetups,
 	ExperimentalSetup** setups,
-    ExperimentalControl* control)
+    ExperimentalControl* control,
+    int nThreads)
 	: ExperimentalSetup(tag, control),
     numSetups(nSetups), theSetups(0),
+    numThreads(nThreads), rValueAll(0), timeAll(0), parallelInfo(5),
+    thePool(0),
     sizeTrialAll(0), sizeOutAll(0), sizeCtrlAll(0), sizeDaqAll(0), 
     tDispAll(0), tVelAll(0), tAccelAll(0), tForceAll(0), tTimeAll(0),
     oDispAll(0), oVelAll(0), oAccelAll(0), oForceAll(0), oTimeAll(0),
@@ -49,6 +63,12 @@ ESAggregator::ESAggregator(int tag, int nSetups,
         exit(OF_ReturnType_failed);
     }
     
+    // no more threads than setups
+    if (numThreads < 1)
+        numThreads = 1;
+    if (numThreads > numSetups)
+        numThreads = numSetups;
+    
     // allocate memory for the experimental setups
     theSetups = new ExperimentalSetup* [numSetups];
     if (theSetups == 0)  {
@@ -88,6 +108,21 @@ ESAggregator::ESAggregator(int tag, int nSetups,
         exit(OF_ReturnType_failed);
     }
     
+    // allocate memory for the results of the setup transformations
+    rValueAll = new int [numSetups];
+    timeAll = new double [numSetups];
+    if (!rValueAll || !timeAll)  {
+        opserr << "ESAggregator::ESAggregator() - "
+            << "failed to create result arrays\n";
+        exit(OF_ReturnType_failed);
+    }
+    for (int i=0; i<numSetups; i++)  {
+        rValueAll[i] = 0;
+        timeAll[i] = 0.0;
+    }
+    parallelInfo(0) = numThreads;
+    thePool = new WorkerPool(numThreads);
+    
     // allocate memory for the vectors
     tDispAll = new Vector* [numSetups];
     tVelAll = new Vector* [numSetups];
@@ -225,6 +260,8 @@ ESAggregator::ESAggregator(int tag, int nSetups,
 
 ESAggregator::ESAggregator(const ESAggregator& es)
 	: ExperimentalSetup(es), theSetups(0),
+    numThreads(es.numThreads), rValueAll(0), timeAll(0), parallelInfo(5),
+    thePool(0),
     sizeTrialAll(0), sizeOutAll(0), sizeCtrlAll(0), sizeDaqAll(0), 
     tDispAll(0), tVelAll(0), tAccelAll(0), tForceAll(0), tTimeAll(0),
     oDispAll(0), oVelAll(0), oAccelAll(0), oForceAll(0), oTimeAll(0),
@@ -271,6 +308,21 @@ ESAggregator::ESAggregator(const ESAggregator& es)
         exit(OF_ReturnType_failed);
     }
     
+    // allocate memory for the results of the setup transformations
+    rValueAll = new int [numSetups];
+    timeAll = new double [numSetups];
+    if (!rValueAll || !timeAll)  {
+        opserr << "ESAggregator::ESAggregator() - "
+            << "failed to create result arrays\n";
+        exit(OF_ReturnType_failed);
+    }
+    for (int i=0; i<numSetups; i++)  {
+        rValueAll[i] = 0;
+        timeAll[i] = 0.0;
+    }
+    parallelInfo(0) = numThreads;
+    thePool = new WorkerPool(numThreads);
+    
     // allocate memory for the vectors
     tDispAll = new Vector* [numSetups];
     tVelAll = new Vector* [numSetups];
@@ -408,6 +460,10 @@ ESAggregator::ESAggregator(const ESAggregator& es)
 
 ESAggregator::~ESAggregator()
 {
+    // stop the worker threads before the setups are deleted
+    if (thePool != 0)
+        delete thePool;
+    
     // invoke the destructor on any objects created by the object
     // that the object still holds a pointer to
     int i;
@@ -426,6 +482,11 @@ ESAggregator::~ESAggregator()
         delete [] sizeCtrlAll;
     if (sizeDaqAll != 0)
         delete [] sizeDaqAll;
+    
+    if (rValueAll != 0)
+        delete [] rValueAll;
+    if (timeAll != 0)
+        delete [] timeAll;
 
     if (tDispAll != 0)  {
         for (i=0; i<numSetups; i++)
@@ -599,7 +660,6 @@ int ESAggregator::transfTrialResponse(const Vector* disp,
     const Vector* force,
     const Vector* time)
 {
-    int rValue = 0;
     int tDispID = 0, tVelID = 0, tAccelID = 0, tForceID = 0;
     int cDispID = 0, cVelID = 0, cAccelID = 0, cForceID = 0;
     
@@ -650,21 +710,20 @@ int ESAggregator::transfTrialResponse(const Vector* disp,
         if (time != 0 && sizeTrialAll[i](OF_Resp_Time) != 0)  {
             *tTimeAll[i] = *tTime;
         }
-        
-        // transform trial response of individual setup
-        rValue = theSetups[i]->transfTrialResponse(tDispAll[i],
-            tVelAll[i], tAccelAll[i], tForceAll[i], tTimeAll[i]);
-        if (rValue != OF_ReturnType_completed)  {
+    }
+    
+    // transform trial response of individual setups and get their
+    // control responses (in parallel if there are several threads)
+    this->transfSetups(ES_jobTrial);
+    
+    for (int i=0; i<numSetups; i++)  {
+        if (rValueAll[i] == 1)  {
             opserr << "ESAggregator::transfTrialResponse() - "
                 << "fail to transform trial response of setup "
                 << theSetups[i]->getTag() << endln;
             return OF_ReturnType_failed;
         }
-        
-        // get control response from individual setup
-        rValue = theSetups[i]->getTrialResponse(cDispAll[i],
-            cVelAll[i], cAccelAll[i], cForceAll[i], cTimeAll[i]);
-        if (rValue != OF_ReturnType_completed)  {
+        else if (rValueAll[i] == 2)  {
             opserr << "ESAggregator::transfTrialResponse() - "
                 << "fail to get trial response from setup "
                 << theSetups[i]->getTag() << endln;
@@ -724,7 +783,6 @@ int ESAggregator::transfDaqResponse(Vector* disp,
     Vector* force,
     Vector* time)
 {
-    int rValue = 0;
     int dDispID = 0, dVelID = 0, dAccelID = 0, dForceID = 0;
     int oDispID = 0, oVelID = 0, oAccelID = 0, oForceID = 0;
 
@@ -775,27 +833,26 @@ int ESAggregator::transfDaqResponse(Vector* disp,
         if (time != 0 && sizeDaqAll[i](OF_Resp_Time) != 0)  {
             *dTimeAll[i] = *dTime;
         }
-        
-        // set daq response in individual setup
-        rValue = theSetups[i]->setDaqResponse(dDispAll[i],
-            dVelAll[i], dAccelAll[i], dForceAll[i], dTimeAll[i]);
-        if (rValue != OF_ReturnType_completed)  {
+    }
+    
+    // set daq response in individual setups and transform it
+    // (in parallel if there are several threads)
+    this->transfSetups(ES_jobDaq);
+    
+    for (int i=0; i<numSetups; i++)  {
+        if (rValueAll[i] == 1)  {
             opserr << "ESAggregator::transfDaqResponse() - "
                 << "fail to set daq response in setup "
                 << theSetups[i]->getTag() << endln;
             return OF_ReturnType_failed;
         }
-        
-        // transform daq response of individual setup
-        rValue = theSetups[i]->transfDaqResponse(oDispAll[i],
-            oVelAll[i], oAccelAll[i], oForceAll[i], oTimeAll[i]);
-        if (rValue != OF_ReturnType_completed)  {
+        else if (rValueAll[i] == 2)  {
             opserr << "ESAggregator::transfDaqResponse() - "
                 << "fail to transform daq response of setup "
                 << theSetups[i]->getTag() << endln;
             return OF_ReturnType_failed;
         }
-
+        
         // assemble output response of aggregated setup
         if (disp != 0 && sizeOutAll[i](OF_Resp_Disp) != 0) {
             oDisp->Assemble(*oDispAll[i], oDispID);
@@ -874,6 +931,9 @@ void ESAggregator::Print(OPS_Stream &s, int flag)
     for (int i=0; i<numSetups; i++)
         s << theSetups[i]->getTag() << ", ";
     s << endln;
+	if (numThreads > 1) {
+		s << " numThreads: " << numThreads << endln;
+	}
 	if (theControl != 0) {
 		s << "\tExperimentalControl tag: " << theControl->getTag();
 		s << *theControl;
@@ -949,3 +1009,65 @@ int ESAggregator::transfDaqTime(Vector* time)
     // does nothing
 	return OF_ReturnType_completed;
 }
+
+
+const Vector* ESAggregator::getParallelInfo()
+{
+    return &parallelInfo;
+}
+
+
+void ESAggregator::transfSetups(int job)
+{
+    steady_clock::time_point start = steady_clock::now();
+    
+    // thread k transforms the setups k, k+numThreads, ... and the
+    // pool returns when all threads are done
+    thePool->run([this, job](int k)  {
+        for (int i=k; i<numSetups; i+=numThreads)
+            this->transfSetup(job, i);
+    });
+    
+    // record the wall time and the sum of the setup times, the
+    // difference to the serial transformation is the overhead
+    double setupTime = 0.0;
+    for (int i=0; i<numSetups; i++)
+        setupTime += timeAll[i];
+    int j = (job == ES_jobTrial) ? 1 : 3;
+    parallelInfo(j) = duration<double>(steady_clock::now() - start).count();
+    parallelInfo(j+1) = setupTime;
+}
+
+
+void ESAggregator::transfSetup(int job, int i)
+{
+    steady_clock::time_point start = steady_clock::now();
+    
+    // the results are only stored here and checked by the calling
+    // thread, because the setups are transformed concurrently
+    rValueAll[i] = 0;
+    if (job == ES_jobTrial)  {
+        // transform trial response of individual setup
+        if (theSetups[i]->transfTrialResponse(tDispAll[i], tVelAll[i],
+            tAccelAll[i], tForceAll[i], tTimeAll[i]) != OF_ReturnType_completed)
+            rValueAll[i] = 1;
+        
+        // get control response from individual setup
+        else if (theSetups[i]->getTrialResponse(cDispAll[i], cVelAll[i],
+            cAccelAll[i], cForceAll[i], cTimeAll[i]) != OF_ReturnType_completed)
+            rValueAll[i] = 2;
+    }
+    else if (job == ES_jobDaq)  {
+        // set daq response in individual setup
+        if (theSetups[i]->setDaqResponse(dDispAll[i], dVelAll[i],
+            dAccelAll[i], dForceAll[i], dTimeAll[i]) != OF_ReturnType_completed)
+            rValueAll[i] = 1;
+        
+        // transform daq response of individual setup
+        else if (theSetups[i]->transfDaqResponse(oDispAll[i], oVelAll[i],
+            oAccelAll[i], oForceAll[i], oTimeAll[i]) != OF_ReturnType_completed)
+            rValueAll[i] = 2;
+    }
+    
+    timeAll[i] = duration<double>(steady_clock::now() - start).count();
+}
@@ -32,17 +32,26 @@
 //
 // Description: This file contains the class definition for 
 // ESAggregator. ESAggregator combines differnt experimental
-// setups into one.
+// setups into one. Optionally the setups are transformed in parallel
+// by a WorkerPool whose threads are started once and then wait for
+// the trial and daq transformations of each step. The setups are
+// assigned to the threads in a fixed order (setup i is transformed by
+// thread i modulo numThreads) and the results are assembled by the
+// calling thread in the order of the setups, so that the aggregated
+// response does not depend on the number of threads.
 
 #include "ExperimentalSetup.h"
 
+#include <WorkerPool.h>
+
 class ESAggregator : public ExperimentalSetup
 {
 public:
     // constructors
     ESAggregator(int tag, int nSetups,
         ExperimentalSetup** setups,
-        ExperimentalControl* control = 0);
+        ExperimentalControl* control = 0,
+        int numThreads = 1);
     ESAggregator(const ESAggregator& es);
     
     // destructor
@@ -85,10 +94,22 @@ protected:
     virtual int transfDaqForce(Vector* force);
     virtual int transfDaqTime(Vector* time);
     
+    virtual const Vector *getParallelInfo();
+    
 private:
+    // methods to transform the individual setups
+    void transfSetups(int job);
+    void transfSetup(int job, int i);
+    
     int numSetups;                  // number of setups to aggregate
     ExperimentalSetup **theSetups;  // setups to aggregate
     
+    int numThreads;         // number of threads incl. the calling thread
+    int *rValueAll;         // failed stage of the setup transformations
+    double *timeAll;        // times of the setup transformations
+    Vector parallelInfo;    // numThreads, trial and daq wall/setup times
+    WorkerPool *thePool;    // threads that transform the setups
+    
     ID *sizeTrialAll;       // sum of all setup trial responses
     ID *sizeOutAll;         // sum of all setup output responses
     ID *sizeCtrlAll;        // sum of all setup control responses
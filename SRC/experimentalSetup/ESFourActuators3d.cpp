@@ -71,7 +71,7 @@ ESFourActuators3d::ESFourActuators3d(int tag,
     // call setup method
     this->setup();
     
-    for (int i=0; i<3; i++)
+    for (int i=0; i<8; i++)
         firstWarning[i] = true;
 }
 
@@ -121,7 +121,7 @@ ESFourActuators3d::ESFourActuators3d(const ESFourActuators3d& es)
     // call setup method
     this->setup();
     
-    for (int i=0; i<3; i++)
+    for (int i=0; i<8; i++)
         firstWarning[i] = true;
 }
 
@@ -158,12 +158,15 @@ int ESFourActuators3d::setup()
     this->setCtrlDaqSize();
     
     // initialize rotation matrix
+    pi = acos(-1.0);
+    phiRad = phiLocX/180.0*pi;
+    cosPhi = cos(phiRad);
+    sinPhi = sin(phiRad);
     rotLocX.Zero();
-    double pi = acos(-1.0);
-    rotLocX(0,0) =  cos(phiLocX/180.0*pi); rotLocX(0,1) = sin(phiLocX/180.0*pi);
-    rotLocX(1,0) = -sin(phiLocX/180.0*pi); rotLocX(1,1) = cos(phiLocX/180.0*pi);
-	rotLocX(2,2) =  cos(phiLocX/180.0*pi); rotLocX(2,3) = sin(phiLocX/180.0*pi);
-    rotLocX(3,2) = -sin(phiLocX/180.0*pi); rotLocX(3,3) = cos(phiLocX/180.0*pi);
+    rotLocX(0,0) =  cosPhi; rotLocX(0,1) = sinPhi;
+    rotLocX(1,0) = -sinPhi; rotLocX(1,1) = cosPhi;
+	rotLocX(2,2) =  cosPhi; rotLocX(2,3) = sinPhi;
+    rotLocX(3,2) = -sinPhi; rotLocX(3,3) = cosPhi;
     
 	D.Zero();
 	d.Zero();
@@ -238,10 +241,17 @@ int ESFourActuators3d::transfTrialDisp(const Vector* disp)
 	D(3) = -(*disp)(2) + off4;
 	
     // transform displacements (ux, uy, phix, phiy) to local coordinate system
-    d = rotLocX*D;
+    d.addMatrixVector(0.0, rotLocX, D, 1.0);
+    
+    // the linear and the nonlinear geometry cases are the same
+    if (nlGeom == 0 && firstWarning[0] == true)  {
+        opserr << "WARNING ESFourActuators3d::transfTrialDisp() - " 
+            << "Linear geometry case is not implemented yet."
+            << "Using nonlinear geometry instead.\n\n";
+        firstWarning[0] = false;
+    }
 	
 	// rigid body displacements due to vector d
-	double pi = acos(-1.0);
 	double alpha = 0.0;
 	double beta = 0.0;
 	
@@ -251,156 +261,105 @@ int ESFourActuators3d::transfTrialDisp(const Vector* disp)
 	}
 	else {
 		alpha = atan(d(3)/d(2));
-		beta = -(d(2)/fabs(d(2)))*sqrt(pow(d(2),2.0)+pow(d(3),2.0));
+		beta = -(d(2)/fabs(d(2)))*sqrt(d(2)*d(2)+d(3)*d(3));
 	}
-    double gamma = -alpha;
-    Matrix A(3,3), B(3,3), C(3,3), V(3,4), V1(3,1), V2(3,1);
-    A.Zero();
-    A(0,0) =  cos(gamma); A(0,1) = sin(gamma);
-    A(1,0) = -sin(gamma); A(1,1) = cos(gamma);
-    A(2,2) =  1.0;
-    
-    B.Zero();
-    B(0,0) =  1.0;
-    B(1,1) =  cos(beta); B(1,2) = sin(beta);
-    B(2,1) = -sin(beta); B(2,2) = cos(beta);
-    
-    C.Zero();
-    C(0,0) =  cos(alpha); C(0,1) = sin(alpha);
-    C(1,0) = -sin(alpha); C(1,1) = cos(alpha);
-    C(2,2) =  1.0;
-    
-    V.Zero();
-    V(0,0) = -a1; V(0,2) = -a3; 
-    V(1,1) = -a2; V(1,3) = -a4;
-    V(2,2) =  h;  V(2,3) =  h;
-    V1.Zero();
-    V1(2,0) = h1;
-    V2.Zero();
-    V2(2,0) = h2;
-    
-	Matrix R(3,3), Vr(3,4), Vr1(3,1), Vr2(3,1);
-	R.Zero(); Vr.Zero(); Vr1.Zero(); Vr2.Zero();
-	R = A*B*C;
-	Vr = R*V;
-	Vr1 = R*V1;
-	Vr2 = R*V2;
-    
-	uxbeam = D(0)+Vr1(0,0)*cos(phiLocX/180.0*pi)-Vr1(1,0)*sin(phiLocX/180.0*pi);
-	uybeam = D(1)+Vr2(0,0)*sin(phiLocX/180.0*pi)+Vr2(1,0)*cos(phiLocX/180.0*pi);
-	upN    = uybeam-sin(-D(2))*arlN;
-	upS    = uybeam-sin(-D(2))*arlS;
     
-	ha3 = Vr(2,2);
-    ha4 = Vr(2,3);
-    ax3 = Vr(0,2)*cos(phiLocX/180.0*pi)-Vr(1,2)*sin(phiLocX/180.0*pi)-D(0);
-    ay3 = Vr(0,2)*sin(phiLocX/180.0*pi)+Vr(1,2)*cos(phiLocX/180.0*pi)-D(1);
-    ax4 = Vr(0,3)*cos(phiLocX/180.0*pi)-Vr(1,3)*sin(phiLocX/180.0*pi)-D(0);
-    ay4 = Vr(0,3)*sin(phiLocX/180.0*pi)+Vr(1,3)*cos(phiLocX/180.0*pi)-D(1);
-    
-    // linear geometry
-    if (nlGeom == 0)  {
-        if (firstWarning[0] == true)  {
-		    opserr << "WARNING ESFourActuators3d::transfTrialDisp() - " 
-	            << "Linear geometry case is not implemented yet."
-                << "Using nonlinear geometry instead.\n\n";
-            firstWarning[0] = false;
+    // rotation R = A*B*C with A = Rz(-alpha), B = Rx(beta), C = Rz(alpha),
+    // evaluated on the stack since this is called every step
+    double ca = cos(alpha), sa = sin(alpha);
+    double cb = cos(beta),  sb = sin(beta);
+    double A[3][3] = {{ca, -sa, 0.0}, {sa, ca, 0.0}, {0.0, 0.0, 1.0}};
+    double B[3][3] = {{1.0, 0.0, 0.0}, {0.0, cb, sb}, {0.0, -sb, cb}};
+    double C[3][3] = {{ca, sa, 0.0}, {-sa, ca, 0.0}, {0.0, 0.0, 1.0}};
+    double V[3][4] = {{-a1, 0.0, -a3, 0.0}, {0.0, -a2, 0.0, -a4}, {0.0, 0.0, h, h}};
+    double AB[3][3], R[3][3], Vr[3][4];
+    int i, j, k;
+    for (i=0; i<3; i++)  {
+        for (j=0; j<3; j++)  {
+            AB[i][j] = 0.0;
+            for (k=0; k<3; k++)
+                AB[i][j] += A[i][k]*B[k][j];
         }
-		// actuator displacements: experiment starts from step=s; offset is ui(s); i=1,2,3,4
-		//at s=0
-		double off_u1 = 0.0;
-		double off_u2 = 0.0;
-		double off_u3 = 0.0;
-		double off_u4 = 0.0;
-		// at s=574
-		//double off_u1 = -0.219054540850067;
-		//double off_u2 = -0.104074893045748;
-		//double off_u3 = -0.295721108038151;
-		//double off_u4 = -0.130830156667088;
-		// at s=3775
-		//double off_u1 =  0.136511926047248;
-		//double off_u2 = -0.033762397285614;
-		//double off_u3 =  0.181755536616677;
-		//double off_u4 = -0.044892820188551;
-        
-        // actuator 1
-		double u11 = L1+d(0)+a1+Vr(0,0);
-		double u12 = d(1)+Vr(1,0);
-		double u13 = Vr(2,0);
-        (*cDisp)(0) = sqrt(pow(u11,2.0)+pow(u12,2.0)+pow(u13,2.0))-L1-off_u1;
-		theta1  = phiLocX*pi/180.0+atan(u12/u11);
-		theta11 = atan(u13/sqrt(pow(u11,2.0)+pow(u12,2.0))); 
-        // actuator 2
-		double u21 = d(0)+Vr(0,1);
-		double u22 = L2+d(1)+a2+Vr(1,1);
-		double u23 = Vr(2,1);
-        (*cDisp)(1) = sqrt(pow(u21,2.0)+pow(u22,2.0)+pow(u23,2.0))-L2-off_u2;
-		theta2  = (pi/2.0-phiLocX*pi/180.0)+atan(u21/u22);
-		theta22 = atan(u23/sqrt(pow(u21,2.0)+pow(u22,2.0))); 
-        // actuator 3
-		double u31 = L3+d(0)+a3+Vr(0,2);
-		double u32 = d(1)+Vr(1,2);
-		double u33 = Vr(2,2)-h;
-        (*cDisp)(2) = sqrt(pow(u31,2.0)+pow(u32,2.0)+pow(u33,2.0))-L3-off_u3;
-		theta3  = phiLocX*pi/180.0+atan(u32/u31);
-		theta33 = atan(u33/sqrt(pow(u31,2.0)+pow(u32,2.0))); 
-        // actuator 4
-		double u41 = d(0)+Vr(0,3);
-		double u42 = L4+d(1)+a4+Vr(1,3);
-		double u43 = Vr(2,3)-h;
-        (*cDisp)(3) = sqrt(pow(u41,2.0)+pow(u42,2.0)+pow(u43,2.0))-L4-off_u4;
-		theta4  = (pi/2.0-phiLocX*pi/180.0)+atan(u41/u42);
-		theta44 = atan(u43/sqrt(pow(u41,2.0)+pow(u42,2.0)));
     }
-    
-    // nonlinear geometry
-    else if (nlGeom == 1)  {
-		// actuator displacements: experiment starts from step=s; offset is ui(s); i=1,2,3,4
-		//at s=0
-		double off_u1 = 0.0;
-		double off_u2 = 0.0;
-		double off_u3 = 0.0;
-		double off_u4 = 0.0;
-		// at s=574
-		//double off_u1 = -0.219054540850067;
-		//double off_u2 = -0.104074893045748;
-		//double off_u3 = -0.295721108038151;
-		//double off_u4 = -0.130830156667088;
-		// at s=3775
-		//double off_u1 =  0.136511926047248;
-		//double off_u2 = -0.033762397285614;
-		//double off_u3 =  0.181755536616677;
-		//double off_u4 = -0.044892820188551;
-        
-        // actuator 1
-		double u11 = L1+d(0)+a1+Vr(0,0);
-		double u12 = d(1)+Vr(1,0);
-		double u13 = Vr(2,0);
-        (*cDisp)(0) = sqrt(pow(u11,2.0)+pow(u12,2.0)+pow(u13,2.0))-L1-off_u1;
-		theta1  = phiLocX*pi/180.0+atan(u12/u11);
-		theta11 = atan(u13/sqrt(pow(u11,2.0)+pow(u12,2.0))); 
-        // actuator 2
-		double u21 = d(0)+Vr(0,1);
-		double u22 = L2+d(1)+a2+Vr(1,1);
-		double u23 = Vr(2,1);
-        (*cDisp)(1) = sqrt(pow(u21,2.0)+pow(u22,2.0)+pow(u23,2.0))-L2-off_u2;
-		theta2  = (pi/2.0-phiLocX*pi/180.0)+atan(u21/u22);
-		theta22 = atan(u23/sqrt(pow(u21,2.0)+pow(u22,2.0))); 
-        // actuator 3
-		double u31 = L3+d(0)+a3+Vr(0,2);
-		double u32 = d(1)+Vr(1,2);
-		double u33 = Vr(2,2)-h;
-        (*cDisp)(2) = sqrt(pow(u31,2.0)+pow(u32,2.0)+pow(u33,2.0))-L3-off_u3;
-		theta3  = phiLocX*pi/180.0+atan(u32/u31);
-		theta33 = atan(u33/sqrt(pow(u31,2.0)+pow(u32,2.0))); 
-        // actuator 4
-		double u41 = d(0)+Vr(0,3);
-		double u42 = L4+d(1)+a4+Vr(1,3);
-		double u43 = Vr(2,3)-h;
-        (*cDisp)(3) = sqrt(pow(u41,2.0)+pow(u42,2.0)+pow(u43,2.0))-L4-off_u4;
-		theta4  = (pi/2.0-phiLocX*pi/180.0)+atan(u41/u42);
-		theta44 = atan(u43/sqrt(pow(u41,2.0)+pow(u42,2.0)));
+    for (i=0; i<3; i++)  {
+        for (j=0; j<3; j++)  {
+            R[i][j] = 0.0;
+            for (k=0; k<3; k++)
+                R[i][j] += AB[i][k]*C[k][j];
+        }
     }
+    for (i=0; i<3; i++)  {
+        for (j=0; j<4; j++)  {
+            Vr[i][j] = 0.0;
+            for (k=0; k<3; k++)
+                Vr[i][j] += R[i][k]*V[k][j];
+        }
+    }
+    // pin offsets V1 = (0,0,h1) and V2 = (0,0,h2)
+    double Vr1x = R[0][2]*h1, Vr1y = R[1][2]*h1;
+    double Vr2x = R[0][2]*h2, Vr2y = R[1][2]*h2;
+    
+	uxbeam = D(0)+Vr1x*cosPhi-Vr1y*sinPhi;
+	uybeam = D(1)+Vr2x*sinPhi+Vr2y*cosPhi;
+	upN    = uybeam-sin(-D(2))*arlN;
+	upS    = uybeam-sin(-D(2))*arlS;
+    
+	ha3 = Vr[2][2];
+    ha4 = Vr[2][3];
+    ax3 = Vr[0][2]*cosPhi-Vr[1][2]*sinPhi-D(0);
+    ay3 = Vr[0][2]*sinPhi+Vr[1][2]*cosPhi-D(1);
+    ax4 = Vr[0][3]*cosPhi-Vr[1][3]*sinPhi-D(0);
+    ay4 = Vr[0][3]*sinPhi+Vr[1][3]*cosPhi-D(1);
+    
+	// actuator displacements: experiment starts from step=s; offset is ui(s); i=1,2,3,4
+	//at s=0
+	double off_u1 = 0.0;
+	double off_u2 = 0.0;
+	double off_u3 = 0.0;
+	double off_u4 = 0.0;
+	// at s=574
+	//double off_u1 = -0.219054540850067;
+	//double off_u2 = -0.104074893045748;
+	//double off_u3 = -0.295721108038151;
+	//double off_u4 = -0.130830156667088;
+	// at s=3775
+	//double off_u1 =  0.136511926047248;
+	//double off_u2 = -0.033762397285614;
+	//double off_u3 =  0.181755536616677;
+	//double off_u4 = -0.044892820188551;
+    
+    // actuator 1
+	double u11 = L1+d(0)+a1+Vr[0][0];
+	double u12 = d(1)+Vr[1][0];
+	double u13 = Vr[2][0];
+	double u1h = sqrt(u11*u11+u12*u12);
+    (*cDisp)(0) = sqrt(u1h*u1h+u13*u13)-L1-off_u1;
+	theta1  = phiRad+atan(u12/u11);
+	theta11 = atan(u13/u1h);
+    // actuator 2
+	double u21 = d(0)+Vr[0][1];
+	double u22 = L2+d(1)+a2+Vr[1][1];
+	double u23 = Vr[2][1];
+	double u2h = sqrt(u21*u21+u22*u22);
+    (*cDisp)(1) = sqrt(u2h*u2h+u23*u23)-L2-off_u2;
+	theta2  = (pi/2.0-phiRad)+atan(u21/u22);
+	theta22 = atan(u23/u2h);
+    // actuator 3
+	double u31 = L3+d(0)+a3+Vr[0][2];
+	double u32 = d(1)+Vr[1][2];
+	double u33 = Vr[2][2]-h;
+	double u3h = sqrt(u31*u31+u32*u32);
+    (*cDisp)(2) = sqrt(u3h*u3h+u33*u33)-L3-off_u3;
+	theta3  = phiRad+atan(u32/u31);
+	theta33 = atan(u33/u3h);
+    // actuator 4
+	double u41 = d(0)+Vr[0][3];
+	double u42 = L4+d(1)+a4+Vr[1][3];
+	double u43 = Vr[2][3]-h;
+	double u4h = sqrt(u41*u41+u42*u42);
+    (*cDisp)(3) = sqrt(u4h*u4h+u43*u43)-L4-off_u4;
+	theta4  = (pi/2.0-phiRad)+atan(u41/u42);
+	theta44 = atan(u43/u4h);
     
     return OF_ReturnType_completed;
 }
@@ -489,111 +448,64 @@ int ESFourActuators3d::transfDaqAccel(Vector* accel)
 
 int ESFourActuators3d::transfDaqForce(Vector* force)
 {
-    // linear geometry
-    if (nlGeom == 0)  {
-        if (firstWarning[7] == true)  {
-		    opserr << "WARNING ESFourActuators3d::transfDaqForce() - " 
-	            << "Linear geometry case is not implemented yet."
-                << "Using nonlinear geometry instead.\n\n";
-            firstWarning[7] = false;
-        }
-		// lateral forces that come from the rods
-		double deltaFxN = -(uxbeam/LrodN)*(-1.0)*(*dForce)(0)*cos(D(2));
-		double deltaFxS = -(uxbeam/LrodS)*(-1.0)*(*dForce)(1)*cos(D(2));
-		double deltaFx  = deltaFxN+deltaFxS;
-        
-		double deltaFyN = (-1.0)*(*dForce)(0)*sin(D(2));
-		double deltaFyS = (-1.0)*(*dForce)(1)*sin(D(2));
-		double deltaFy  = deltaFyN+deltaFyS;
-		
-		// moments that come from the rods
-		double FzN = (*dForce)(0)*cos(-D(2));
-		double FzS = (*dForce)(1)*cos(-D(2));
-		double Fz  = FzN+FzS;
-		double MyV = -Fz*(uxbeam-D(0));
-		double MyR = MyV+deltaFx*h1;
-		double MxR = Fz*(uybeam+0.5*Hbeam*sin(-D(2))-D(1))-deltaFy*(h2+0.5*Hbeam);
-        
-		// lateral forces that come from actuators
-		double F1x = (*dForce)(2)*cos(theta1)*cos(theta11);
-		double F1y = (*dForce)(2)*sin(theta1)*cos(theta11);
-		double F2x = -(*dForce)(3)*cos(theta2)*cos(theta22);
-		double F2y = (*dForce)(3)*sin(theta2)*cos(theta22);
-		double F3x = (*dForce)(4)*cos(theta3)*cos(theta33);
-		double F3y = (*dForce)(4)*sin(theta3)*cos(theta33);
-		double F3z = (*dForce)(4)*sin(theta33);
-		double F4x = -(*dForce)(5)*cos(theta4)*cos(theta44);
-		double F4y = (*dForce)(5)*sin(theta4)*cos(theta44);
-		double F4z = (*dForce)(5)*sin(theta44);
-        
-		// moments that come from actuators
-		double MxA = -(F3y*ha3+F4y*ha4)+F3z*ay3+F4z*ay4;
-		double MyA = (F3x*ha3+F4x*ha4)-(F3z*ax3+F4z*ax4);
-        
-		// total lateral forces and moments
-		double Fx = F1x+F2x+F3x+F4x+deltaFx;
-		double Fy = F1y+F2y+F3y+F4y+deltaFy;
-		double Mx = MxA+MxR;
-		double My = MyA+MyR;
-        
-        // assign forces and moments
-        (*force)(0) = 0;
-        (*force)(1) = -Fx;
-		(*force)(2) = -My;
-        (*force)(3) = -Fy;
-        (*force)(4) = -Mx;
-		(*force)(5) = 0;
-    }
-    // nonlinear geometry
-    else if (nlGeom == 1)  {
-		// lateral forces that come from the rods
-		double deltaFxN = -(uxbeam/LrodN)*(-1.0)*(*dForce)(0)*cos(D(2));
-		double deltaFxS = -(uxbeam/LrodS)*(-1.0)*(*dForce)(1)*cos(D(2));
-		double deltaFx  = deltaFxN+deltaFxS;
-        
-		double deltaFyN = (-1.0)*(*dForce)(0)*sin(D(2));
-		double deltaFyS = (-1.0)*(*dForce)(1)*sin(D(2));
-		double deltaFy  = deltaFyN+deltaFyS;
-		
-		// moments that come from the rods
-		double FzN = (*dForce)(0)*cos(-D(2));
-		double FzS = (*dForce)(1)*cos(-D(2));
-		double Fz  = FzN+FzS;
-		double MyV = -Fz*(uxbeam-D(0));
-		double MyR = MyV+deltaFx*h1;
-		double MxR = Fz*(uybeam+0.5*Hbeam*sin(-D(2))-D(1))-deltaFy*(h2+0.5*Hbeam);
-        
-		// lateral forces that come from actuators
-		double F1x = (*dForce)(2)*cos(theta1)*cos(theta11);
-		double F1y = (*dForce)(2)*sin(theta1)*cos(theta11);
-		double F2x = -(*dForce)(3)*cos(theta2)*cos(theta22);
-		double F2y = (*dForce)(3)*sin(theta2)*cos(theta22);
-		double F3x = (*dForce)(4)*cos(theta3)*cos(theta33);
-		double F3y = (*dForce)(4)*sin(theta3)*cos(theta33);
-		double F3z = (*dForce)(4)*sin(theta33);
-		double F4x = -(*dForce)(5)*cos(theta4)*cos(theta44);
-		double F4y = (*dForce)(5)*sin(theta4)*cos(theta44);
-		double F4z = (*dForce)(5)*sin(theta44);
-        
-		// moments that come from actuators
-		double MxA = -(F3y*ha3+F4y*ha4)+F3z*ay3+F4z*ay4;
-		double MyA = (F3x*ha3+F4x*ha4)-(F3z*ax3+F4z*ax4);
-        
-		// total lateral forces and moments
-		double Fx = F1x+F2x+F3x+F4x+deltaFx;
-		double Fy = F1y+F2y+F3y+F4y+deltaFy;
-		double Mx = MxA+MxR;
-		double My = MyA+MyR;
-        
-        // assign forces and moments
-        (*force)(0) = 0;
-        (*force)(1) = -Fx;
-		(*force)(2) = -My;
-        (*force)(3) = -Fy;
-        (*force)(4) = -Mx;
-		(*force)(5) = 0;
+    // the linear and the nonlinear geometry cases are the same
+    if (nlGeom == 0 && firstWarning[7] == true)  {
+        opserr << "WARNING ESFourActuators3d::transfDaqForce() - " 
+            << "Linear geometry case is not implemented yet."
+            << "Using nonlinear geometry instead.\n\n";
+        firstWarning[7] = false;
     }
     
+    double cosD2 = cos(D(2));
+    double sinD2 = sin(D(2));
+    
+	// lateral forces that come from the rods
+	double deltaFxN = -(uxbeam/LrodN)*(-1.0)*(*dForce)(0)*cosD2;
+	double deltaFxS = -(uxbeam/LrodS)*(-1.0)*(*dForce)(1)*cosD2;
+	double deltaFx  = deltaFxN+deltaFxS;
+    
+	double deltaFyN = (-1.0)*(*dForce)(0)*sinD2;
+	double deltaFyS = (-1.0)*(*dForce)(1)*sinD2;
+	double deltaFy  = deltaFyN+deltaFyS;
+	
+	// moments that come from the rods
+	double FzN = (*dForce)(0)*cosD2;
+	double FzS = (*dForce)(1)*cosD2;
+	double Fz  = FzN+FzS;
+	double MyV = -Fz*(uxbeam-D(0));
+	double MyR = MyV+deltaFx*h1;
+	double MxR = Fz*(uybeam+0.5*Hbeam*(-sinD2)-D(1))-deltaFy*(h2+0.5*Hbeam);
+    
+	// lateral forces that come from actuators
+	double F1x = (*dForce)(2)*cos(theta1)*cos(theta11);
+	double F1y = (*dForce)(2)*sin(theta1)*cos(theta11);
+	double F2x = -(*dForce)(3)*cos(theta2)*cos(theta22);
+	double F2y = (*dForce)(3)*sin(theta2)*cos(theta22);
+	double F3x = (*dForce)(4)*cos(theta3)*cos(theta33);
+	double F3y = (*dForce)(4)*sin(theta3)*cos(theta33);
+	double F3z = (*dForce)(4)*sin(theta33);
+	double F4x = -(*dForce)(5)*cos(theta4)*cos(theta44);
+	double F4y = (*dForce)(5)*sin(theta4)*cos(theta44);
+	double F4z = (*dForce)(5)*sin(theta44);
+    
+	// moments that come from actuators
+	double MxA = -(F3y*ha3+F4y*ha4)+F3z*ay3+F4z*ay4;
+	double MyA = (F3x*ha3+F4x*ha4)-(F3z*ax3+F4z*ax4);
+    
+	// total lateral forces and moments
+	double Fx = F1x+F2x+F3x+F4x+deltaFx;
+	double Fy = F1y+F2y+F3y+F4y+deltaFy;
+	double Mx = MxA+MxR;
+	double My = MyA+MyR;
+    
+    // assign forces and moments
+    (*force)(0) = 0;
+    (*force)(1) = -Fx;
+	(*force)(2) = -My;
+    (*force)(3) = -Fy;
+    (*force)(4) = -Mx;
+	(*force)(5) = 0;
+    
     return OF_ReturnType_completed;
 }
 
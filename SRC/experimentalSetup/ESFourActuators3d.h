@@ -100,6 +100,10 @@ private:
 	double Hbeam;       // spreader beam height
     int nlGeom;         // non-linear geometry (0: linear, 1: nonlinear)
 	double phiLocX;     // angle of actuator 1 w.r.t reaction wall [deg]
+    double pi;          // = 3.141592....
+    double phiRad;      // phiLocX in radians
+    double cosPhi;      // cosine of phiLocX
+    double sinPhi;      // sine of phiLocX
     
 	double uxbeam;
 	double uybeam;
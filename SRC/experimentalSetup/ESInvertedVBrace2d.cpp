@@ -43,10 +43,20 @@ ESInvertedVBrace2d::ESInvertedVBrace2d(int tag,
     : ExperimentalSetup(tag, control),
     La0(actLength0), La1(actLength1), La2(actLength2),
     L0(rigidLength0), L1(rigidLength1),
-    nlGeom(nlgeom), phiLocX(philocx), rotLocX(3,3)
+    nlGeom(nlgeom), phiLocX(philocx), rotLocX(3,3),
+    theKinematics(3, nlgeom)
 {
     strcpy(posAct0,posact0);
 
+    // resolve the geometry once, so that the transformations
+    // do not have to compare strings
+    geometry = ActuatorKinematics2d::getGeometry(nlGeom, posAct0);
+    if (geometry < 0)  {
+        opserr << "ESInvertedVBrace2d::ESInvertedVBrace2d()"
+            << " - invalid nlGeom or posAct0\n";
+        exit(OF_ReturnType_failed);
+    }
+
     // call setup method
     this->setup();
 
@@ -57,7 +67,7 @@ ESInvertedVBrace2d::ESInvertedVBrace2d(int tag,
 
 ESInvertedVBrace2d::ESInvertedVBrace2d(const ESInvertedVBrace2d& es)
     : ExperimentalSetup(es),
-    rotLocX(3,3)
+    rotLocX(3,3), theKinematics(es.theKinematics)
 {
     La0     = es.La0;
     La1     = es.La1;
@@ -67,6 +77,7 @@ ESInvertedVBrace2d::ESInvertedVBrace2d(const ESInvertedVBrace2d& es)
     nlGeom  = es.nlGeom;
     phiLocX = es.phiLocX;
     strcpy(posAct0,es.posAct0);
+    geometry = es.geometry;
 
     // call setup method
     this->setup();
@@ -119,6 +130,15 @@ int ESInvertedVBrace2d::setup()
     rotLocX(1,0) = sin(phiLocX/180.0*pi); rotLocX(1,1) =  cos(phiLocX/180.0*pi);
     rotLocX(2,2) = 1.0;
     
+    // setup the actuator kinematics with the joint offsets from the
+    // control point and the directions from the bases to the joints
+    if (geometry == ES_linearLeft || geometry == ES_nonlinearLeft)
+        theKinematics.setActuator(0, -L0, 0.0, 1.0, 0.0, La0);
+    else
+        theKinematics.setActuator(0, L1, 0.0, -1.0, 0.0, La0);
+    theKinematics.setActuator(1, -L0, 0.0, 0.0, 1.0, La1);
+    theKinematics.setActuator(2, L1, 0.0, 0.0, 1.0, La2);
+    
     return OF_ReturnType_completed;
 }
 
@@ -198,47 +218,13 @@ void ESInvertedVBrace2d::Print(OPS_Stream &s, int flag)
 
 
 int ESInvertedVBrace2d::transfTrialDisp(const Vector* disp)
-{  
+{
     // rotate direction
-    static Vector d(3);
-    d = rotLocX*(*disp);
-
-    // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
-        // actuator 0
-        (*cDisp)(0) = d(0);
-        // actuator 1
-        (*cDisp)(1) = d(1) - L0*d(2);
-        // actuator 2
-        (*cDisp)(2) = d(1) + L1*d(2);
-    }
-    // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
-        // actuator 0
-        (*cDisp)(0) = -d(0);
-        // actuator 1
-        (*cDisp)(1) = d(1) - L0*d(2);
-        // actuator 2
-        (*cDisp)(2) = d(1) + L1*d(2);
-    }
-    // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
-        // actuator 0
-        (*cDisp)(0) = pow(pow(d(0)+L0*(1.0-cos(d(2)))+La0,2.0)+pow(d(1)-L0*sin(d(2)),2.0),0.5)-La0;
-        // actuator 1
-        (*cDisp)(1) = pow(pow(d(0)+L0*(1.0-cos(d(2))),2.0)+pow(d(1)-L0*sin(d(2))+La1,2.0),0.5)-La1;
-        // actuator 2
-        (*cDisp)(2) = pow(pow(d(0)-L1*(1.0-cos(d(2))),2.0)+pow(d(1)+L1*sin(d(2))+La2,2.0),0.5)-La2;
-    }
-    // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
-        // actuator 0
-        (*cDisp)(0) = pow(pow(d(0)-L1*(1.0-cos(d(2)))-La0,2.0)+pow(d(1)+L1*sin(d(2)),2.0),0.5)-La0;
-        // actuator 1
-        (*cDisp)(1) = pow(pow(d(0)+L0*(1.0-cos(d(2))),2.0)+pow(d(1)-L0*sin(d(2))+La1,2.0),0.5)-La1;
-        // actuator 2
-        (*cDisp)(2) = pow(pow(d(0)-L1*(1.0-cos(d(2))),2.0)+pow(d(1)+L1*sin(d(2))+La2,2.0),0.5)-La2;        
-    }
+    static thread_local Vector d(3);
+    d.addMatrixVector(0.0, rotLocX, *disp, 1.0);
+    
+    // actuator displacements from the kinematics
+    theKinematics.transfDisp(d, *cDisp);
     
     return OF_ReturnType_completed;
 }
@@ -252,48 +238,15 @@ int ESInvertedVBrace2d::transfTrialVel(const Vector* vel)
 
 int ESInvertedVBrace2d::transfTrialVel(const Vector* disp,
     const Vector* vel)
-{  
+{
     // rotate direction
-    static Vector d(3), v(3);
-    d = rotLocX*(*disp);
-    v = rotLocX*(*vel);
-
-    // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
-        // actuator 0
-        (*cVel)(0) = v(0);
-        // actuator 1
-        (*cVel)(1) = v(1) - L0*v(2);
-        // actuator 2
-        (*cVel)(2) = v(1) + L1*v(2);
-    }
-    // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
-        // actuator 0
-        (*cVel)(0) = -v(0);
-        // actuator 1
-        (*cVel)(1) = v(1) - L0*v(2);
-        // actuator 2
-        (*cVel)(2) = v(1) + L1*v(2);
-    }
-    // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
-        // actuator 0
-        (*cVel)(0) = 0.5*(2.0*(d(0)+L0*(1.0-cos(d(2)))+La0)*(v(0)+L0*sin(d(2))*v(2))+2.0*(d(1)-L0*sin(d(2)))*(v(1)-L0*cos(d(2))*v(2)))/pow(pow(d(0)+L0*(1.0-cos(d(2)))+La0,2.0)+pow(d(1)-L0*sin(d(2)),2.0),0.5);
-        // actuator 1
-        (*cVel)(1) = 0.5*(2.0*(d(0)+L0*(1.0-cos(d(2))))*(v(0)+L0*sin(d(2))*v(2))+2.0*(d(1)-L0*sin(d(2))+La1)*(v(1)-L0*cos(d(2))*v(2)))/pow(pow(d(0)+L0*(1.0-cos(d(2))),2.0)+pow(d(1)-L0*sin(d(2))+La1,2.0),0.5);
-        // actuator 2
-        (*cVel)(2) = 0.5*(2.0*(d(0)-L1*(1.0-cos(d(2))))*(v(0)-L1*sin(d(2))*v(2))+2.0*(d(1)+L1*sin(d(2))+La2)*(v(1)+L1*cos(d(2))*v(2)))/pow(pow(d(0)-L1*(1.0-cos(d(2))),2.0)+pow(d(1)+L1*sin(d(2))+La2,2.0),0.5);
-    }
-    // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
-        // actuator 0
-        (*cVel)(0) = 0.5*(2.0*(d(0)-L1*(1.0-cos(d(2)))-La0)*(v(0)-L1*sin(d(2))*v(2))+2.0*(d(1)+L1*sin(d(2)))*(v(1)+L1*cos(d(2))*v(2)))/pow(pow(d(0)-L1*(1.0-cos(d(2)))-La0,2.0)+pow(d(1)+L1*sin(d(2)),2.0),0.5);
-        // actuator 1
-        (*cVel)(1) = 0.5*(2*(d(0)+L0*(1.0-cos(d(2))))*(v(0)+L0*sin(d(2))*v(2))+2*(d(1)-L0*sin(d(2))+La1)*(v(1)-L0*cos(d(2))*v(2)))/pow(pow(d(0)+L0*(1.0-cos(d(2))),2)+pow(d(1)-L0*sin(d(2))+La1,2),0.5);
-        // actuator 2
-        (*cVel)(2) = 0.5*(2.0*(d(0)-L1*(1.0-cos(d(2))))*(v(0)-L1*sin(d(2))*v(2))+2.0*(d(1)+L1*sin(d(2))+La2)*(v(1)+L1*cos(d(2))*v(2)))/pow(pow(d(0)-L1*(1.0-cos(d(2))),2.0)+pow(d(1)+L1*sin(d(2))+La2,2.0),0.5);
-    }
+    static thread_local Vector d(3), v(3);
+    d.addMatrixVector(0.0, rotLocX, *disp, 1.0);
+    v.addMatrixVector(0.0, rotLocX, *vel, 1.0);
+    
+    // actuator velocities from the kinematics, which are
+    // reused from transfTrialDisp for the same displacements
+    theKinematics.transfVel(d, v, *cVel);
     
     return OF_ReturnType_completed;
 }
@@ -308,49 +261,16 @@ int ESInvertedVBrace2d::transfTrialAccel(const Vector* accel)
 int ESInvertedVBrace2d::transfTrialAccel(const Vector* disp,
     const Vector* vel,
     const Vector* accel)
-{  
+{
     // rotate direction
-    static Vector d(3), v(3), a(3);
-    d = rotLocX*(*disp);
-    v = rotLocX*(*vel);
-    a = rotLocX*(*accel);
-
-    // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
-        // actuator 0
-        (*cAccel)(0) = a(0);
-        // actuator 1
-        (*cAccel)(1) = a(1) - L0*a(2);
-        // actuator 2
-        (*cAccel)(2) = a(1) + L1*a(2);
-    }
-    // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
-        // actuator 0
-        (*cAccel)(0) = -a(0);
-        // actuator 1
-        (*cAccel)(1) = a(1) - L0*a(2);
-        // actuator 2
-        (*cAccel)(2) = a(1) + L1*a(2);
-    }
-    // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
-        // actuator 0
-        (*cAccel)(0) = -0.25*pow(2.0*(d(0)+L0*(1.0-cos(d(2)))+La0)*(v(0)+L0*sin(d(2))*v(2))+2.0*(d(1)-L0*sin(d(2)))*(v(1)-L0*cos(d(2))*v(2)),2.0)/pow(pow(d(0)+L0*(1.0-cos(d(2)))+La0,2.0)+pow(d(1)-L0*sin(d(2)),2.0),1.5)+0.5*(2.0*pow(v(0)+L0*sin(d(2))*v(2),2.0)+2.0*(d(0)+L0*(1.0-cos(d(2)))+La0)*(a(0)+L0*cos(d(2))*pow(v(2),2.0)+L0*sin(d(2))*a(2))+2.0*pow(v(1)-L0*cos(d(2))*v(2),2.0)+2.0*(d(1)-L0*sin(d(2)))*(a(1)+L0*sin(d(2))*pow(v(2),2.0)-L0*cos(d(2))*a(2)))/pow(pow(d(0)+L0*(1.0-cos(d(2)))+La0,2.0)+pow(d(1)-L0*sin(d(2)),2.0),0.5);
-        // actuator 1
-        (*cAccel)(1) = -0.25*pow(2.0*(d(0)+L0*(1.0-cos(d(2))))*(v(0)+L0*sin(d(2))*v(2))+2.0*(d(1)-L0*sin(d(2))+La1)*(v(1)-L0*cos(d(2))*v(2)),2.0)/pow(pow(d(0)+L0*(1.0-cos(d(2))),2.0)+pow(d(1)-L0*sin(d(2))+La1,2.0),1.5)+0.5*(2.0*pow(v(0)+L0*sin(d(2))*v(2),2.0)+2.0*(d(0)+L0*(1.0-cos(d(2))))*(a(0)+L0*cos(d(2))*pow(v(2),2.0)+L0*sin(d(2))*a(2))+2.0*pow(v(1)-L0*cos(d(2))*v(2),2.0)+2.0*(d(1)-L0*sin(d(2))+La1)*(a(1)+L0*sin(d(2))*pow(v(2),2.0)-L0*cos(d(2))*a(2)))/pow(pow(d(0)+L0*(1.0-cos(d(2))),2.0)+pow(d(1)-L0*sin(d(2))+La1,2.0),0.5);
-        // actuator 2
-        (*cAccel)(2) = -0.25*pow(2.0*(d(0)-L1*(1.0-cos(d(2))))*(v(0)-L1*sin(d(2))*v(2))+2.0*(d(1)+L1*sin(d(2))+La2)*(v(1)+L1*cos(d(2))*v(2)),2.0)/pow(pow(d(0)-L1*(1.0-cos(d(2))),2.0)+pow(d(1)+L1*sin(d(2))+La2,2.0),1.5)+0.5*(2.0*pow(v(0)-L1*sin(d(2))*v(2),2.0)+2.0*(d(0)-L1*(1.0-cos(d(2))))*(a(0)-L1*cos(d(2))*pow(v(2),2.0)-L1*sin(d(2))*a(2))+2.0*pow(v(1)+L1*cos(d(2))*v(2),2.0)+2.0*(d(1)+L1*sin(d(2))+La2)*(a(1)-L1*sin(d(2))*pow(v(2),2.0)+L1*cos(d(2))*a(2)))/pow(pow(d(0)-L1*(1.0-cos(d(2))),2.0)+pow(d(1)+L1*sin(d(2))+La2,2.0),0.5);
-    }
-    // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
-        // actuator 0
-        (*cAccel)(0) = -0.25*pow(2.0*(d(0)-L1*(1.0-cos(d(2)))-La0)*(v(0)-L1*sin(d(2))*v(2))+2.0*(d(1)+L1*sin(d(2)))*(v(1)+L1*cos(d(2))*v(2)),2.0)/pow(pow(d(0)-L1*(1.0-cos(d(2)))-La0,2.0)+pow(d(1)+L1*sin(d(2)),2.0),1.5)+0.5*(2.0*pow(v(0)-L1*sin(d(2))*v(2),2.0)+2.0*(d(0)-L1*(1.0-cos(d(2)))-La0)*(a(0)-L1*cos(d(2))*pow(v(2),2.0)-L1*sin(d(2))*a(2))+2.0*pow(v(1)+L1*cos(d(2))*v(2),2.0)+2.0*(d(1)+L1*sin(d(2)))*(a(1)-L1*sin(d(2))*pow(v(2),2.0)+L1*cos(d(2))*a(2)))/pow(pow(d(0)-L1*(1.0-cos(d(2)))-La0,2.0)+pow(d(1)+L1*sin(d(2)),2.0),0.5);
-        // actuator 1
-        (*cAccel)(1) = -0.25*pow(2.0*(d(0)+L0*(1.0-cos(d(2))))*(v(0)+L0*sin(d(2))*v(2))+2.0*(d(1)-L0*sin(d(2))+La1)*(v(1)-L0*cos(d(2))*v(2)),2.0)/pow(pow(d(0)+L0*(1.0-cos(d(2))),2.0)+pow(d(1)-L0*sin(d(2))+La1,2.0),1.5)+0.5*(2.0*pow(v(0)+L0*sin(d(2))*v(2),2.0)+2.0*(d(0)+L0*(1.0-cos(d(2))))*(a(0)+L0*cos(d(2))*pow(v(2),2.0)+L0*sin(d(2))*a(2))+2.0*pow(v(1)-L0*cos(d(2))*v(2),2.0)+2.0*(d(1)-L0*sin(d(2))+La1)*(a(1)+L0*sin(d(2))*pow(v(2),2.0)-L0*cos(d(2))*a(2)))/pow(pow(d(0)+L0*(1.0-cos(d(2))),2.0)+pow(d(1)-L0*sin(d(2))+La1,2.0),0.5);
-        // actuator 2
-        (*cAccel)(2) = -0.25*pow(2.0*(d(0)-L1*(1.0-cos(d(2))))*(v(0)-L1*sin(d(2))*v(2))+2.0*(d(1)+L1*sin(d(2))+La2)*(v(1)+L1*cos(d(2))*v(2)),2.0)/pow(pow(d(0)-L1*(1.0-cos(d(2))),2.0)+pow(d(1)+L1*sin(d(2))+La2,2.0),1.5)+0.5*(2.0*pow(v(0)-L1*sin(d(2))*v(2),2.0)+2.0*(d(0)-L1*(1.0-cos(d(2))))*(a(0)-L1*cos(d(2))*pow(v(2),2.0)-L1*sin(d(2))*a(2))+2.0*pow(v(1)+L1*cos(d(2))*v(2),2.0)+2.0*(d(1)+L1*sin(d(2))+La2)*(a(1)-L1*sin(d(2))*pow(v(2),2.0)+L1*cos(d(2))*a(2)))/pow(pow(d(0)-L1*(1.0-cos(d(2))),2.0)+pow(d(1)+L1*sin(d(2))+La2,2.0),0.5);
-    }
+    static thread_local Vector d(3), v(3), a(3);
+    d.addMatrixVector(0.0, rotLocX, *disp, 1.0);
+    v.addMatrixVector(0.0, rotLocX, *vel, 1.0);
+    a.addMatrixVector(0.0, rotLocX, *accel, 1.0);
+    
+    // actuator accelerations from the kinematics, which are
+    // reused from transfTrialDisp for the same displacements
+    theKinematics.transfAccel(d, v, a, *cAccel);
     
     return OF_ReturnType_completed;
 }
@@ -359,11 +279,11 @@ int ESInvertedVBrace2d::transfTrialAccel(const Vector* disp,
 int ESInvertedVBrace2d::transfTrialForce(const Vector* force)
 {  
     // rotate direction
-    static Vector f(3);
-    f = rotLocX*(*force);
+    static thread_local Vector f(3);
+    f.addMatrixVector(0.0, rotLocX, *force, 1.0);
 
     // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
+    if (geometry == ES_linearLeft)  {
         // actuator 0
         (*cForce)(0) = f(0);
         // actuator 1
@@ -372,7 +292,7 @@ int ESInvertedVBrace2d::transfTrialForce(const Vector* force)
         (*cForce)(2) = 1.0/(L0+L1)*(L0*f(1) + f(2));
     }
     // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_linearRight)  {
         // actuator 0
         (*cForce)(0) = -f(0);
         // actuator 1
@@ -381,7 +301,7 @@ int ESInvertedVBrace2d::transfTrialForce(const Vector* force)
         (*cForce)(2) = 1.0/(L0+L1)*(L0*f(1) + f(2));
     }
     // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
+    else if (geometry == ES_nonlinearLeft)  {
         if (firstWarning[0] == true)  {
             opserr << "WARNING ESInvertedVBrace2d::transfTrialForce() - "
                 << "nonlinear geometry with horizontal actuator left "
@@ -396,7 +316,7 @@ int ESInvertedVBrace2d::transfTrialForce(const Vector* force)
         (*cForce)(2) = 1.0/(L0+L1)*(L0*f(1) + f(2));
     }
     // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_nonlinearRight)  {
         if (firstWarning[0] == true)  {
             opserr << "WARNING ESInvertedVBrace2d::transfTrialForce() - "
                 << "nonlinear geometry with horizontal actuator right "
@@ -426,98 +346,21 @@ int ESInvertedVBrace2d::transfTrialTime(const Vector* time)
 int ESInvertedVBrace2d::transfDaqDisp(Vector* disp)
 {
     // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
+    if (geometry == ES_linearLeft)  {
         (*disp)(0) = (*dDisp)(0);
         (*disp)(1) = 1.0/(L0+L1)*(L1*(*dDisp)(1) + L0*(*dDisp)(2));
         (*disp)(2) = 1.0/(L0+L1)*(-(*dDisp)(1) + (*dDisp)(2));
     }
     // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_linearRight)  {
         (*disp)(0) = -(*dDisp)(0);
         (*disp)(1) = 1.0/(L0+L1)*(L1*(*dDisp)(1) + L0*(*dDisp)(2));
         (*disp)(2) = 1.0/(L0+L1)*(-(*dDisp)(1) + (*dDisp)(2));
     }
-    // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
-        Vector F(2), theta(2), dTheta(2);
-        Matrix DF(2,2);
-        int iter = 0;
-        int maxIter = 15;
-        double tol = 1E-9;
-        
-        double d0 = La0 + (*dDisp)(0);
-        double d1 = La1 + (*dDisp)(1);
-        double d2 = La2 + (*dDisp)(2);
-        
-        theta(0) = (*dDisp)(0)/La1;
-        theta(1) = (*dDisp)(0)/La2;
-        
-        do  {
-            F(0) = pow(d0,2.0) - pow(d1*sin(theta(0))+La0,2.0) - pow(d1*cos(theta(0))-La1,2.0);
-            F(1) = pow(L0+L1,2.0) - pow(d2*sin(theta(1))+L0+L1-d1*sin(theta(0)),2.0) - pow(d2*cos(theta(1))+La1-La2-d1*cos(theta(0)),2.0);
-            
-            DF(0,0) = 2.0*d1*(-La0*cos(theta(0))-La1*sin(theta(0)));
-            DF(0,1) = 0.0;
-            DF(1,0) = 2.0*d1*((L0+L1)*cos(theta(0))-d2*sin(theta(0)-theta(1))-(La1-La2)*sin(theta(0)));
-            DF(1,1) = 2.0*d2*(-(L0+L1)*cos(theta(1))+d1*sin(theta(0)-theta(1))+(La1-La2)*sin(theta(1)));
-            
-            // Newton's method
-            dTheta = F/DF;
-            theta -= dTheta;
-            iter++;
-        }  while ((dTheta.Norm() >= tol) && (iter <= maxIter));
-        
-        // issue warning if iteration did not converge
-        if (iter >= maxIter)   {
-            opserr << "WARNING ESInvertedVBrace2d::transfDaqDisp() - "
-                << "did not find the angle theta after "
-                << iter << " iterations and norm: " << dTheta.Norm() << endln;
-        }
-
-        (*disp)(2) = atan2(d2*cos(theta(1))+La1-La2-d1*cos(theta(0)),d2*sin(theta(1))+L0+L1-d1*sin(theta(0)));
-        (*disp)(0) = d1*sin(theta(0))+L0*cos((*disp)(2))-L0;
-        (*disp)(1) = d1*cos(theta(0))+L0*sin((*disp)(2))-La1;
-    }
-    // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
-        Vector F(2), theta(2), dTheta(2);
-        Matrix DF(2,2);
-        int iter = 0;
-        int maxIter = 15;
-        double tol = 1E-9;
-        
-        double d0 = La0 + (*dDisp)(0);
-        double d1 = La1 + (*dDisp)(1);
-        double d2 = La2 + (*dDisp)(2);
-        
-        theta(0) = (*dDisp)(0)/La1;
-        theta(1) = (*dDisp)(0)/La2;
-        
-        do  {
-            F(0) = pow(L0+L1,2.0) - pow(-d2*sin(theta(1))+L0+L1+d1*sin(theta(0)),2.0) - pow(d2*cos(theta(1))+La1-La2-d1*cos(theta(0)),2.0);
-            F(1) = pow(d0,2.0) - pow(-d2*sin(theta(1))-La0,2.0) - pow(d2*cos(theta(1))-La2,2.0);
-            
-            DF(0,0) = 2.0*d1*(-(L0+L1)*cos(theta(0))-d2*sin(theta(0)-theta(1))-(La1-La2)*sin(theta(0)));
-            DF(0,1) = 2.0*d2*((L0+L1)*cos(theta(1))+d1*sin(theta(0)-theta(1))+(La1-La2)*sin(theta(1)));
-            DF(1,0) = 0.0;
-            DF(1,1) = 2.0*d2*(-La0*cos(theta(1))-La2*sin(theta(1)));
-            
-            // Newtons method
-            dTheta = F/DF;
-            theta -= dTheta;
-            iter++;
-        }  while ((dTheta.Norm() >= tol) && (iter <= maxIter));
-        
-        // issue warning if iteration did not converge
-        if (iter >= maxIter)   {
-            opserr << "WARNING ESInvertedVBrace2d::transfDaqDisp() - "
-                << "did not find the angle theta after "
-                << iter << " iterations and norm: " << dTheta.Norm() << endln;
-        }
-
-        (*disp)(2) = atan2(d2*cos(theta(1))+La1-La2-d1*cos(theta(0)),-d2*sin(theta(1))+L0+L1+d1*sin(theta(0)));
-        (*disp)(0) = -d1*sin(theta(0))+L0*cos((*disp)(2))-L0;
-        (*disp)(1) = d1*cos(theta(0))+L0*sin((*disp)(2))-La1;
+    // nonlinear geometry, solved with Newton's method that is started
+    // from the solution of the last step
+    else  {
+        theKinematics.transfDispInv(*dDisp, *disp);
     }
     
     // rotate direction if necessary
@@ -532,19 +375,19 @@ int ESInvertedVBrace2d::transfDaqDisp(Vector* disp)
 int ESInvertedVBrace2d::transfDaqVel(Vector* vel)
 {
     // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
+    if (geometry == ES_linearLeft)  {
         (*vel)(0) = (*dVel)(0);
         (*vel)(1) = 1.0/(L0+L1)*(L1*(*dVel)(1) + L0*(*dVel)(2));
         (*vel)(2) = 1.0/(L0+L1)*(-(*dVel)(1) + (*dVel)(2));
     }
     // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_linearRight)  {
         (*vel)(0) = -(*dVel)(0);
         (*vel)(1) = 1.0/(L0+L1)*(L1*(*dVel)(1) + L0*(*dVel)(2));
         (*vel)(2) = 1.0/(L0+L1)*(-(*dVel)(1) + (*dVel)(2));
     }
     // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
+    else if (geometry == ES_nonlinearLeft)  {
         if (firstWarning[1] == true)  {
             opserr << "WARNING ESInvertedVBrace2d::transfDaqVel() - "
                 << "nonlinear geometry with horizontal actuator left "
@@ -556,7 +399,7 @@ int ESInvertedVBrace2d::transfDaqVel(Vector* vel)
         (*vel)(2) = 1.0/(L0+L1)*(-(*dVel)(1) + (*dVel)(2));
     }
     // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_nonlinearRight)  {
         if (firstWarning[1] == true)  {
             opserr << "WARNING ESInvertedVBrace2d::transfDaqVel() - "
                 << "nonlinear geometry with horizontal actuator right "
@@ -580,19 +423,19 @@ int ESInvertedVBrace2d::transfDaqVel(Vector* vel)
 int ESInvertedVBrace2d::transfDaqAccel(Vector* accel)
 {
     // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
+    if (geometry == ES_linearLeft)  {
         (*accel)(0) = (*dAccel)(0);
         (*accel)(1) = 1.0/(L0+L1)*(L1*(*dAccel)(1) + L0*(*dAccel)(2));
         (*accel)(2) = 1.0/(L0+L1)*(-(*dAccel)(1) + (*dAccel)(2));
     }
     // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_linearRight)  {
         (*accel)(0) = -(*dAccel)(0);
         (*accel)(1) = 1.0/(L0+L1)*(L1*(*dAccel)(1) + L0*(*dAccel)(2));
         (*accel)(2) = 1.0/(L0+L1)*(-(*dAccel)(1) + (*dAccel)(2));
     }
     // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
+    else if (geometry == ES_nonlinearLeft)  {
         if (firstWarning[2] == true)  {
             opserr << "WARNING ESInvertedVBrace2d::transfDaqAccel() - "
                 << "nonlinear geometry with horizontal actuator left "
@@ -604,7 +447,7 @@ int ESInvertedVBrace2d::transfDaqAccel(Vector* accel)
         (*accel)(2) = 1.0/(L0+L1)*(-(*dAccel)(1) + (*dAccel)(2));
     }
     // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_nonlinearRight)  {
         if (firstWarning[2] == true)  {
             opserr << "WARNING ESInvertedVBrace2d::transfDaqAccel() - "
                 << "nonlinear geometry with horizontal actuator right "
@@ -633,6 +476,12 @@ int ESInvertedVBrace2d::transfDaqForce(Vector* force)
 }
 
 
+const Vector* ESInvertedVBrace2d::getDaqSolverInfo()
+{
+    return &theKinematics.getSolverInfo();
+}
+
+
 int ESInvertedVBrace2d::transfDaqTime(Vector* time)
 {  
     *time = *dTime;
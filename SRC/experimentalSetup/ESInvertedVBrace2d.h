@@ -37,6 +37,7 @@
 // reactions (resisting forces).
 
 #include "ExperimentalSetup.h"
+#include "ActuatorKinematics2d.h"
 
 #include <Matrix.h>
 
@@ -84,6 +85,8 @@ protected:
     virtual int transfDaqForce(Vector* force);
     virtual int transfDaqTime(Vector* time);
     
+    virtual const Vector *getDaqSolverInfo();
+    
 private:
     // private tranformation methods
     virtual int transfTrialVel(const Vector* disp,
@@ -99,10 +102,13 @@ private:
     double L1;          // rigid link length 1
     int nlGeom;         // non-linear geometry (0: linear, 1: nonlinear)
     char posAct0[6];    // position of actuator 0 (left, right)
+    int geometry;       // geometry resolved from nlGeom and posAct0
     double phiLocX;     // angle of local x axis w.r.t rigid link [deg]
     
     Matrix rotLocX;     // rotation matrix
     
+    ActuatorKinematics2d theKinematics;  // actuator kinematics
+    
     bool firstWarning[3];
 };
 
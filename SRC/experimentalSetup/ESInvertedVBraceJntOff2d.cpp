@@ -45,10 +45,20 @@ ESInvertedVBraceJntOff2d::ESInvertedVBraceJntOff2d(int tag,
     La0(actLength0), La1(actLength1), La2(actLength2),
     L0(rigidLength0), L1(rigidLength1), L2(rigidLength2),
     L3(rigidLength3), L4(rigidLength4), L5(rigidLength5),
-    nlGeom(nlgeom), phiLocX(philocx), rotLocX(3,3)
+    nlGeom(nlgeom), phiLocX(philocx), rotLocX(3,3),
+    theKinematics(3, nlgeom)
 {
     strcpy(posAct0,posact0);
 
+    // resolve the geometry once, so that the transformations
+    // do not have to compare strings
+    geometry = ActuatorKinematics2d::getGeometry(nlGeom, posAct0);
+    if (geometry < 0)  {
+        opserr << "ESInvertedVBraceJntOff2d::ESInvertedVBraceJntOff2d()"
+            << " - invalid nlGeom or posAct0\n";
+        exit(OF_ReturnType_failed);
+    }
+
     // call setup method
     this->setup();
 
@@ -59,7 +69,7 @@ ESInvertedVBraceJntOff2d::ESInvertedVBraceJntOff2d(int tag,
 
 ESInvertedVBraceJntOff2d::ESInvertedVBraceJntOff2d(const ESInvertedVBraceJntOff2d& es)
     : ExperimentalSetup(es),
-    rotLocX(3,3)
+    rotLocX(3,3), theKinematics(es.theKinematics)
 {
     La0     = es.La0;
     La1     = es.La1;
@@ -73,6 +83,7 @@ ESInvertedVBraceJntOff2d::ESInvertedVBraceJntOff2d(const ESInvertedVBraceJntOff2
     nlGeom  = es.nlGeom;
     phiLocX = es.phiLocX;
     strcpy(posAct0,es.posAct0);
+    geometry = es.geometry;
 
     // call setup method
     this->setup();
@@ -125,6 +136,15 @@ int ESInvertedVBraceJntOff2d::setup()
     rotLocX(1,0) = sin(phiLocX/180.0*pi); rotLocX(1,1) =  cos(phiLocX/180.0*pi);
     rotLocX(2,2) = 1.0;
     
+    // setup the actuator kinematics with the joint offsets from the
+    // control point and the directions from the bases to the joints
+    if (geometry == ES_linearLeft || geometry == ES_nonlinearLeft)
+        theKinematics.setActuator(0, -(L0+L1), 0.0, 1.0, 0.0, La0);
+    else
+        theKinematics.setActuator(0, L2+L3, 0.0, -1.0, 0.0, La0);
+    theKinematics.setActuator(1, -L1, -L4, 0.0, 1.0, La1);
+    theKinematics.setActuator(2, L2, -L5, 0.0, 1.0, La2);
+    
     return OF_ReturnType_completed;
 }
 
@@ -207,57 +227,13 @@ void ESInvertedVBraceJntOff2d::Print(OPS_Stream &s, int flag)
 
 
 int ESInvertedVBraceJntOff2d::transfTrialDisp(const Vector* disp)
-{  
+{
     // rotate direction
-    static Vector d(3);
-    d = rotLocX*(*disp);
-
-    // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
-        // actuator 0
-        (*cDisp)(0) = d(0);
-        // actuator 1
-        (*cDisp)(1) = d(1) - L1*d(2);
-        // actuator 2
-        (*cDisp)(2) = d(1) + L2*d(2);
-    }
-    // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
-        // actuator 0
-        (*cDisp)(0) = -d(0);
-        // actuator 1
-        (*cDisp)(1) = d(1) - L1*d(2);
-        // actuator 2
-        (*cDisp)(2) = d(1) + L2*d(2);
-    }
-    // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
-        double R0 = sqrt(L1*L1 + L4*L4);
-        double R1 = sqrt(L2*L2 + L5*L5);
-        double alpha0 = atan2(L4,L1);
-        double alpha1 = atan2(L5,L2);
-        
-        // actuator 0
-        (*cDisp)(0) = pow(pow(d(0)-(L0+L1)*cos(d(2))+L0+L1+La0,2.0)+pow(d(1)-(L0+L1)*sin(d(2)),2.0),0.5)-La0;
-        // actuator 1
-        (*cDisp)(1) = pow(pow(d(0)-R0*cos(alpha0+d(2))+L1,2.0)+pow(d(1)-R0*sin(alpha0+d(2))+La1+L4,2.0),0.5)-La1;
-        // actuator 2
-        (*cDisp)(2) = pow(pow(d(0)+R1*cos(-alpha1+d(2))-L2,2.0)+pow(d(1)+R1*sin(-alpha1+d(2))+La2+L5,2.0),0.5)-La2;
-    }
-    // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
-        double R0 = sqrt(L1*L1 + L4*L4);
-        double R1 = sqrt(L2*L2 + L5*L5);
-        double alpha0 = atan2(L4,L1);        
-        double alpha1 = atan2(L5,L2);
-        
-        // actuator 0
-        (*cDisp)(0) = pow(pow(d(0)+(L2+L3)*cos(d(2))-L2-L3-La0,2.0)+pow(d(1)+(L2+L3)*sin(d(2)),2.0),0.5)-La0;
-        // actuator 1
-        (*cDisp)(1) = pow(pow(d(0)-R0*cos(alpha0+d(2))+L1,2.0)+pow(d(1)-R0*sin(alpha0+d(2))+La1+L4,2.0),0.5)-La1;
-        // actuator 2
-        (*cDisp)(2) = pow(pow(d(0)+R1*cos(-alpha1+d(2))-L2,2.0)+pow(d(1)+R1*sin(-alpha1+d(2))+La2+L5,2.0),0.5)-La2;
-    }
+    static thread_local Vector d(3);
+    d.addMatrixVector(0.0, rotLocX, *disp, 1.0);
+    
+    // actuator displacements from the kinematics
+    theKinematics.transfDisp(d, *cDisp);
     
     return OF_ReturnType_completed;
 }
@@ -271,58 +247,15 @@ int ESInvertedVBraceJntOff2d::transfTrialVel(const Vector* vel)
 
 int ESInvertedVBraceJntOff2d::transfTrialVel(const Vector* disp,
     const Vector* vel)
-{  
+{
     // rotate direction
-    static Vector d(3), v(3);
-    d = rotLocX*(*disp);
-    v = rotLocX*(*vel);
-
-    // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
-        // actuator 0
-        (*cVel)(0) = v(0);
-        // actuator 1
-        (*cVel)(1) = v(1) - L1*v(2);
-        // actuator 2
-        (*cVel)(2) = v(1) + L2*v(2);
-    }
-    // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
-        // actuator 0
-        (*cVel)(0) = -v(0);
-        // actuator 1
-        (*cVel)(1) = v(1) - L1*v(2);
-        // actuator 2
-        (*cVel)(2) = v(1) + L2*v(2);
-    }
-    // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
-        double R0 = sqrt(L1*L1 + L4*L4);
-        double R1 = sqrt(L2*L2 + L5*L5);
-        double alpha0 = atan2(L4,L1);
-        double alpha1 = atan2(L5,L2);
-        
-        // actuator 0
-        (*cVel)(0) = 0.5*(2.0*(d(0)-(L0+L1)*cos(d(2))+L0+L1+La0)*(v(0)+(L0+L1)*sin(d(2))*v(2))+2.0*(d(1)-(L0+L1)*sin(d(2)))*(v(1)-(L0+L1)*cos(d(2))*v(2)))/pow(pow(d(0)-(L0+L1)*cos(d(2))+L0+L1+La0,2.0)+pow(d(1)-(L0+L1)*sin(d(2)),2.0),0.5);
-        // actuator 1
-        (*cVel)(1) = 0.5*(2.0*(d(0)-R0*cos(alpha0+d(2))+L1)*(v(0)+R0*sin(alpha0+d(2))*v(2))+2.0*(d(1)-R0*sin(alpha0+d(2))+La1+L4)*(v(1)-R0*cos(alpha0+d(2))*v(2)))/pow(pow(d(0)-R0*cos(alpha0+d(2))+L1,2.0)+pow(d(1)-R0*sin(alpha0+d(2))+La1+L4,2.0),0.5);
-        // actuator 2
-        (*cVel)(2) = 0.5*(2.0*(d(0)+R1*cos(-alpha1+d(2))-L2)*(v(0)-R1*sin(-alpha1+d(2))*v(2))+2.0*(d(1)+R1*sin(-alpha1+d(2))+La2+L5)*(v(1)+R1*cos(-alpha1+d(2))*v(2)))/pow(pow(d(0)+R1*cos(-alpha1+d(2))-L2,2.0)+pow(d(1)+R1*sin(-alpha1+d(2))+La2+L5,2.0),0.5);
-    }
-    // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
-        double R0 = sqrt(L1*L1 + L4*L4);
-        double R1 = sqrt(L2*L2 + L5*L5);
-        double alpha0 = atan2(L4,L1);        
-        double alpha1 = atan2(L5,L2);
-        
-        // actuator 0
-        (*cVel)(0) = 0.5*(2.0*(d(0)+(L2+L3)*cos(d(2))-L2-L3-La0)*(v(0)-(L2+L3)*sin(d(2))*v(2))+2.0*(d(1)+(L2+L3)*sin(d(2)))*(v(1)+(L2+L3)*cos(d(2))*v(2)))/pow(pow(d(0)+(L2+L3)*cos(d(2))-L2-L3-La0,2.0)+pow(d(1)+(L2+L3)*sin(d(2)),2.0),0.5);
-        // actuator 1
-        (*cVel)(1) = 0.5*(2.0*(d(0)-R0*cos(alpha0+d(2))+L1)*(v(0)+R0*sin(alpha0+d(2))*v(2))+2.0*(d(1)-R0*sin(alpha0+d(2))+La1+L4)*(v(1)-R0*cos(alpha0+d(2))*v(2)))/pow(pow(d(0)-R0*cos(alpha0+d(2))+L1,2.0)+pow(d(1)-R0*sin(alpha0+d(2))+La1+L4,2.0),0.5);
-        // actuator 2
-        (*cVel)(2) = 0.5*(2.0*(d(0)+R1*cos(-alpha1+d(2))-L2)*(v(0)-R1*sin(-alpha1+d(2))*v(2))+2.0*(d(1)+R1*sin(-alpha1+d(2))+La2+L5)*(v(1)+R1*cos(-alpha1+d(2))*v(2)))/pow(pow(d(0)+R1*cos(-alpha1+d(2))-L2,2.0)+pow(d(1)+R1*sin(-alpha1+d(2))+La2+L5,2.0),0.5);
-    }
+    static thread_local Vector d(3), v(3);
+    d.addMatrixVector(0.0, rotLocX, *disp, 1.0);
+    v.addMatrixVector(0.0, rotLocX, *vel, 1.0);
+    
+    // actuator velocities from the kinematics, which are
+    // reused from transfTrialDisp for the same displacements
+    theKinematics.transfVel(d, v, *cVel);
     
     return OF_ReturnType_completed;
 }
@@ -337,59 +270,16 @@ int ESInvertedVBraceJntOff2d::transfTrialAccel(const Vector* accel)
 int ESInvertedVBraceJntOff2d::transfTrialAccel(const Vector* disp,
     const Vector* vel,
     const Vector* accel)
-{  
+{
     // rotate direction
-    static Vector d(3), v(3), a(3);
-    d = rotLocX*(*disp);
-    v = rotLocX*(*vel);
-    a = rotLocX*(*accel);
-
-    // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
-        // actuator 0
-        (*cAccel)(0) = a(0);
-        // actuator 1
-        (*cAccel)(1) = a(1) - L1*a(2);
-        // actuator 2
-        (*cAccel)(2) = a(1) + L2*a(2);
-    }
-    // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
-        // actuator 0
-        (*cAccel)(0) = -a(0);
-        // actuator 1
-        (*cAccel)(1) = a(1) - L1*a(2);
-        // actuator 2
-        (*cAccel)(2) = a(1) + L2*a(2);
-    }
-    // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
-        double R0 = sqrt(L1*L1 + L4*L4);
-        double R1 = sqrt(L2*L2 + L5*L5);
-        double alpha0 = atan2(L4,L1);
-        double alpha1 = atan2(L5,L2);
-        
-        // actuator 0
-        (*cAccel)(0) = -0.25*pow(2.0*(d(0)-(L0+L1)*cos(d(2))+L0+L1+La0)*(v(0)+(L0+L1)*sin(d(2))*v(2))+2.0*(d(1)-(L0+L1)*sin(d(2)))*(v(1)-(L0+L1)*cos(d(2))*v(2)),2.0)/pow(pow(d(0)-(L0+L1)*cos(d(2))+L0+L1+La0,2.0)+pow(d(1)-(L0+L1)*sin(d(2)),2.0),1.5)+0.5*(2.0*pow(v(0)+(L0+L1)*sin(d(2))*v(2),2.0)+2.0*(d(0)-(L0+L1)*cos(d(2))+L0+L1+La0)*(a(0)+(L0+L1)*cos(d(2))*pow(v(2),2.0)+(L0+L1)*sin(d(2))*a(2))+2.0*pow(v(1)-(L0+L1)*cos(d(2))*v(2),2.0)+2.0*(d(1)-(L0+L1)*sin(d(2)))*(a(1)+(L0+L1)*sin(d(2))*pow(v(2),2.0)-(L0+L1)*cos(d(2))*a(2)))/pow(pow(d(0)-(L0+L1)*cos(d(2))+L0+L1+La0,2.0)+pow(d(1)-(L0+L1)*sin(d(2)),2.0),0.5);
-        // actuator 1
-        (*cAccel)(1) = -0.25*pow(2.0*(d(0)-R0*cos(alpha0+d(2))+L1)*(v(0)+R0*sin(alpha0+d(2))*v(2))+2.0*(d(1)-R0*sin(alpha0+d(2))+La1+L4)*(v(1)-R0*cos(alpha0+d(2))*v(2)),2.0)/pow(pow(d(0)-R0*cos(alpha0+d(2))+L1,2.0)+pow(d(1)-R0*sin(alpha0+d(2))+La1+L4,2.0),1.5)+0.5*(2.0*pow(v(0)+R0*sin(alpha0+d(2))*v(2),2.0)+2.0*(d(0)-R0*cos(alpha0+d(2))+L1)*(a(0)+R0*cos(alpha0+d(2))*pow(v(2),2.0)+R0*sin(alpha0+d(2))*a(2))+2.0*pow(v(1)-R0*cos(alpha0+d(2))*v(2),2.0)+2.0*(d(1)-R0*sin(alpha0+d(2))+La1+L4)*(a(1)+R0*sin(alpha0+d(2))*pow(v(2),2.0)-R0*cos(alpha0+d(2))*a(2)))/pow(pow(d(0)-R0*cos(alpha0+d(2))+L1,2.0)+pow(d(1)-R0*sin(alpha0+d(2))+La1+L4,2.0),0.5);
-        // actuator 2
-        (*cAccel)(2) = -0.25*pow(2.0*(d(0)+R1*cos(-alpha1+d(2))-L2)*(v(0)-R1*sin(-alpha1+d(2))*v(2))+2.0*(d(1)+R1*sin(-alpha1+d(2))+La2+L5)*(v(1)+R1*cos(-alpha1+d(2))*v(2)),2.0)/pow(pow(d(0)+R1*cos(-alpha1+d(2))-L2,2.0)+pow(d(1)+R1*sin(-alpha1+d(2))+La2+L5,2.0),1.5)+0.5*(2.0*pow(v(0)-R1*sin(-alpha1+d(2))*v(2),2.0)+2.0*(d(0)+R1*cos(-alpha1+d(2))-L2)*(a(0)-R1*cos(-alpha1+d(2))*pow(v(2),2.0)-R1*sin(-alpha1+d(2))*a(2))+2.0*pow(v(1)+R1*cos(-alpha1+d(2))*v(2),2.0)+2.0*(d(1)+R1*sin(-alpha1+d(2))+La2+L5)*(a(1)-R1*sin(-alpha1+d(2))*pow(v(2),2.0)+R1*cos(-alpha1+d(2))*a(2)))/pow(pow(d(0)+R1*cos(-alpha1+d(2))-L2,2.0)+pow(d(1)+R1*sin(-alpha1+d(2))+La2+L5,2.0),0.5);
-    }
-    // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
-        double R0 = sqrt(L1*L1 + L4*L4);
-        double R1 = sqrt(L2*L2 + L5*L5);
-        double alpha0 = atan2(L4,L1);        
-        double alpha1 = atan2(L5,L2);
-        
-        // actuator 0
-        (*cAccel)(0) = -0.25*pow(2.0*(d(0)+(L2+L3)*cos(d(2))-L2-L3-La0)*(v(0)-(L2+L3)*sin(d(2))*v(2))+2.0*(d(1)+(L2+L3)*sin(d(2)))*(v(1)+(L2+L3)*cos(d(2))*v(2)),2.0)/pow(pow(d(0)+(L2+L3)*cos(d(2))-L2-L3-La0,2.0)+pow(d(1)+(L2+L3)*sin(d(2)),2.0),1.5)+0.5*(2.0*pow(v(0)-(L2+L3)*sin(d(2))*v(2),2.0)+2.0*(d(0)+(L2+L3)*cos(d(2))-L2-L3-La0)*(a(0)-(L2+L3)*cos(d(2))*pow(v(2),2.0)-(L2+L3)*sin(d(2))*a(2))+2.0*pow(v(1)+(L2+L3)*cos(d(2))*v(2),2.0)+2.0*(d(1)+(L2+L3)*sin(d(2)))*(a(1)-(L2+L3)*sin(d(2))*pow(v(2),2.0)+(L2+L3)*cos(d(2))*a(2)))/pow(pow(d(0)+(L2+L3)*cos(d(2))-L2-L3-La0,2.0)+pow(d(1)+(L2+L3)*sin(d(2)),2.0),0.5);
-        // actuator 1
-        (*cAccel)(1) = -0.25*pow(2.0*(d(0)-R0*cos(alpha0+d(2))+L1)*(v(0)+R0*sin(alpha0+d(2))*v(2))+2.0*(d(1)-R0*sin(alpha0+d(2))+La1+L4)*(v(1)-R0*cos(alpha0+d(2))*v(2)),2.0)/pow(pow(d(0)-R0*cos(alpha0+d(2))+L1,2.0)+pow(d(1)-R0*sin(alpha0+d(2))+La1+L4,2.0),1.5)+0.5*(2.0*pow(v(0)+R0*sin(alpha0+d(2))*v(2),2.0)+2.0*(d(0)-R0*cos(alpha0+d(2))+L1)*(a(0)+R0*cos(alpha0+d(2))*pow(v(2),2.0)+R0*sin(alpha0+d(2))*a(2))+2.0*pow(v(1)-R0*cos(alpha0+d(2))*v(2),2.0)+2.0*(d(1)-R0*sin(alpha0+d(2))+La1+L4)*(a(1)+R0*sin(alpha0+d(2))*pow(v(2),2.0)-R0*cos(alpha0+d(2))*a(2)))/pow(pow(d(0)-R0*cos(alpha0+d(2))+L1,2.0)+pow(d(1)-R0*sin(alpha0+d(2))+La1+L4,2.0),0.5);
-        // actuator 2
-        (*cAccel)(2) = -0.25*pow(2.0*(d(0)+R1*cos(-alpha1+d(2))-L2)*(v(0)-R1*sin(-alpha1+d(2))*v(2))+2.0*(d(1)+R1*sin(-alpha1+d(2))+La2+L5)*(v(1)+R1*cos(-alpha1+d(2))*v(2)),2.0)/pow(pow(d(0)+R1*cos(-alpha1+d(2))-L2,2.0)+pow(d(1)+R1*sin(-alpha1+d(2))+La2+L5,2.0),1.5)+0.5*(2.0*pow(v(0)-R1*sin(-alpha1+d(2))*v(2),2.0)+2.0*(d(0)+R1*cos(-alpha1+d(2))-L2)*(a(0)-R1*cos(-alpha1+d(2))*pow(v(2),2.0)-R1*sin(-alpha1+d(2))*a(2))+2.0*pow(v(1)+R1*cos(-alpha1+d(2))*v(2),2.0)+2.0*(d(1)+R1*sin(-alpha1+d(2))+La2+L5)*(a(1)-R1*sin(-alpha1+d(2))*pow(v(2),2.0)+R1*cos(-alpha1+d(2))*a(2)))/pow(pow(d(0)+R1*cos(-alpha1+d(2))-L2,2.0)+pow(d(1)+R1*sin(-alpha1+d(2))+La2+L5,2.0),0.5);
-    }
+    static thread_local Vector d(3), v(3), a(3);
+    d.addMatrixVector(0.0, rotLocX, *disp, 1.0);
+    v.addMatrixVector(0.0, rotLocX, *vel, 1.0);
+    a.addMatrixVector(0.0, rotLocX, *accel, 1.0);
+    
+    // actuator accelerations from the kinematics, which are
+    // reused from transfTrialDisp for the same displacements
+    theKinematics.transfAccel(d, v, a, *cAccel);
     
     return OF_ReturnType_completed;
 }
@@ -398,11 +288,11 @@ int ESInvertedVBraceJntOff2d::transfTrialAccel(const Vector* disp,
 int ESInvertedVBraceJntOff2d::transfTrialForce(const Vector* force)
 {  
     // rotate direction
-    static Vector f(3);
-    f = rotLocX*(*force);
+    static thread_local Vector f(3);
+    f.addMatrixVector(0.0, rotLocX, *force, 1.0);
 
     // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
+    if (geometry == ES_linearLeft)  {
         // actuator 0
         (*cForce)(0) = f(0);
         // actuator 1
@@ -411,7 +301,7 @@ int ESInvertedVBraceJntOff2d::transfTrialForce(const Vector* force)
         (*cForce)(2) = 1.0/(L1+L2)*(L1*f(1) + f(2));
     }
     // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_linearRight)  {
         // actuator 0
         (*cForce)(0) = -f(0);
         // actuator 1
@@ -420,7 +310,7 @@ int ESInvertedVBraceJntOff2d::transfTrialForce(const Vector* force)
         (*cForce)(2) = 1.0/(L1+L2)*(L1*f(1) + f(2));
     }
     // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
+    else if (geometry == ES_nonlinearLeft)  {
         if (firstWarning[0] == true)  {
             opserr << "WARNING ESInvertedVBraceJntOff2d::transfTrialForce() - "
                 << "nonlinear geometry with horizontal actuator left "
@@ -435,7 +325,7 @@ int ESInvertedVBraceJntOff2d::transfTrialForce(const Vector* force)
         (*cForce)(2) = 1.0/(L1+L2)*(L1*f(1) + f(2));
     }
     // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_nonlinearRight)  {
         if (firstWarning[0] == true)  {
             opserr << "WARNING ESInvertedVBraceJntOff2d::transfTrialForce() - "
                 << "nonlinear geometry with horizontal actuator right "
@@ -464,116 +354,21 @@ int ESInvertedVBraceJntOff2d::transfTrialTime(const Vector* time)
 int ESInvertedVBraceJntOff2d::transfDaqDisp(Vector* disp)
 { 
     // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
+    if (geometry == ES_linearLeft)  {
         (*disp)(0) = (*dDisp)(0);
         (*disp)(1) = 1.0/(L1+L2)*(L2*(*dDisp)(1) + L1*(*dDisp)(2));
         (*disp)(2) = 1.0/(L1+L2)*(-(*dDisp)(1) + (*dDisp)(2));
     }
     // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_linearRight)  {
         (*disp)(0) = -(*dDisp)(0);
         (*disp)(1) = 1.0/(L1+L2)*(L2*(*dDisp)(1) + L1*(*dDisp)(2));
         (*disp)(2) = 1.0/(L1+L2)*(-(*dDisp)(1) + (*dDisp)(2));
     }
-    // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
-        Vector F(3), theta(3), dTheta(3);
-        Matrix DF(3,3);
-        int iter = 0;
-        int maxIter = 15;
-        double tol = 1E-9;
-        
-        double d0 = La0 + (*dDisp)(0);
-        double d1 = La1 + (*dDisp)(1);
-        double d2 = La2 + (*dDisp)(2);
-        
-        theta(0) = (*dDisp)(1)/La0;
-        theta(1) = (*dDisp)(0)/La1;
-        theta(2) = (*dDisp)(0)/La2;
-        
-        do  {
-            F(0) = L0*L0 + L4*L4 - pow(d0*cos(theta(0))-La0-L0-d1*sin(theta(1)),2.0) - pow(d0*sin(theta(0))+La1+L4-d1*cos(theta(1)),2.0);
-            F(1) = pow(L1+L2,2.0) + pow(L4-L5,2.0) - pow(d2*sin(theta(2))+L1+L2-d1*sin(theta(1)),2.0) - pow(d2*cos(theta(2))+La1+L4-L5-La2-d1*cos(theta(1)),2.0);
-            F(2) = pow(L0+L1+L2,2.0) + L5*L5 - pow(d0*cos(theta(0))-La0-L0-d2*sin(theta(2))-L1-L2,2.0) - pow(d0*sin(theta(0))+La2+L5-d2*cos(theta(2)),2.0);
-            
-            DF(0,0) = 2.0*d0*(-(L4+La1)*cos(theta(0))+d1*cos(theta(1)+theta(0))-(L0+La0)*sin(theta(0)));
-            DF(0,1) = 2.0*d1*(-(L0+La0)*cos(theta(1))+d0*cos(theta(1)+theta(0))-(L4+La1)*sin(theta(1)));
-            DF(0,2) = 0.0;
-            DF(1,0) = 0.0;
-            DF(1,1) = 2.0*d1*((L1+L2)*cos(theta(1))-d2*sin(theta(1)-theta(2))-(L4-L5+La1-La2)*sin(theta(1)));
-            DF(1,2) = 2.0*d2*(-(L1+L2)*cos(theta(2))+d1*sin(theta(1)-theta(2))+(L4-L5+La1-La2)*sin(theta(2)));
-            DF(2,0) = 2.0*d0*(-(L5+La2)*cos(theta(0))+d2*cos(theta(2)+theta(0))-(L0+L1+L2+La0)*sin(theta(0)));
-            DF(2,1) = 0.0;
-            DF(2,2) = 2.0*d2*(-(L0+L1+L2+La0)*cos(theta(2))+d0*cos(theta(2)+theta(0))-(L5+La2)*sin(theta(2)));
-            
-            // Newtons method
-            dTheta = F/DF;
-            theta -= dTheta;
-            iter++;
-        }  while ((dTheta.Norm() >= tol) && (iter <= maxIter));
-        
-        // issue warning if iteration did not converge
-        if (iter >= maxIter)   {
-            opserr << "WARNING ESInvertedVBraceJntOff2d::transfDaqDisp() - "
-                << "did not find the angle theta after "
-                << iter << " iterations and norm: " << dTheta.Norm() << endln;
-        }
-
-        (*disp)(2) = atan2(d2*cos(theta(2))+La1+L4-L5-La2-d1*cos(theta(1)),d2*sin(theta(2))+L1+L2-d1*sin(theta(1))) - atan2(L4-L5,L1+L2);
-        double R0 = sqrt(L1*L1 + L4*L4);
-        double beta0 = atan2(L4,L1) + (*disp)(2);
-        (*disp)(0) = d1*sin(theta(1)) + R0*cos(beta0) - L1;
-        (*disp)(1) = d1*cos(theta(1)) + R0*sin(beta0) - La1 - L4;
-    }
-    // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
-        Vector F(3), theta(3), dTheta(3);
-        Matrix DF(3,3);
-        int iter = 0;
-        int maxIter = 15;
-        double tol = 1E-9;
-        
-        double d0 = La0 + (*dDisp)(0);
-        double d1 = La1 + (*dDisp)(1);
-        double d2 = La2 + (*dDisp)(2);
-        
-        theta(0) = (*dDisp)(2)/La0;
-        theta(1) = (*dDisp)(0)/La1;
-        theta(2) = (*dDisp)(0)/La2;
-        
-        do  {
-            F(0) = pow(L1+L2+L3,2.0) + L4*L4 - pow(-d0*cos(theta(0))+La0+L1+L2+L3+d1*sin(theta(1)),2.0) - pow(d0*sin(theta(0))+La1+L4-d1*cos(theta(1)),2.0);
-            F(1) = pow(L1+L2,2.0) + pow(L4-L5,2.0) - pow(-d2*sin(theta(2))+L1+L2+d1*sin(theta(1)),2.0) - pow(d2*cos(theta(2))+La1+L4-L5-La2-d1*cos(theta(1)),2.0);
-            F(2) = L3*L3 + L5*L5 - pow(-d0*cos(theta(0))+La0+L3+d2*sin(theta(2)),2.0) - pow(d0*sin(theta(0))+La2+L5-d2*cos(theta(2)),2.0);
-            
-            DF(0,0) = 2.0*d0*(-(L4+La1)*cos(theta(0))+d1*cos(theta(1)+theta(0))-(L1+L2+L3+La0)*sin(theta(0)));
-            DF(0,1) = 2.0*d1*(-(L1+L2+L3+La0)*cos(theta(1))+d0*cos(theta(1)+theta(0))-(L4+La1)*sin(theta(1)));
-            DF(0,2) = 0.0;
-            DF(1,0) = 0.0;
-            DF(1,1) = 2.0*d1*(-(L1+L2)*cos(theta(1))-d2*sin(theta(1)-theta(2))-(L4-L5+La1-La2)*sin(theta(1)));
-            DF(1,2) = 2.0*d2*((L1+L2)*cos(theta(2))+d1*sin(theta(1)-theta(2))+(L4-L5+La1-La2)*sin(theta(2)));
-            DF(2,0) = 2.0*d0*(-(L5+La2)*cos(theta(0))+d2*cos(theta(2)+theta(0))-(L3+La0)*sin(theta(0)));
-            DF(2,1) = 0.0;
-            DF(2,2) = 2.0*d2*(-(L3+La0)*cos(theta(2))+d0*cos(theta(2)+theta(0))-(L5+La2)*sin(theta(2)));
-            
-            // Newtons method
-            dTheta = F/DF;
-            theta -= dTheta;
-            iter++;
-        }  while ((dTheta.Norm() >= tol) && (iter <= maxIter));
-        
-        // issue warning if iteration did not converge
-        if (iter >= maxIter)   {
-            opserr << "WARNING ESInvertedVBraceJntOff2d::transfDaqDisp() - "
-                << "did not find the angle theta after "
-                << iter << " iterations and norm: " << dTheta.Norm() << endln;
-        }
-
-        (*disp)(2) = atan2(d2*cos(theta(2))+La1+L4-L5-La2-d1*cos(theta(1)),-d2*sin(theta(2))+L1+L2+d1*sin(theta(1))) - atan2(L4-L5,L1+L2);
-        double R0 = sqrt(L1*L1 + L4*L4);
-        double beta0 = atan2(L4,L1) + (*disp)(2);
-        (*disp)(0) = -d1*sin(theta(1)) + R0*cos(beta0) - L1;
-        (*disp)(1) = d1*cos(theta(1)) + R0*sin(beta0) - La1 - L4;
+    // nonlinear geometry, solved with Newton's method that is started
+    // from the solution of the last step
+    else  {
+        theKinematics.transfDispInv(*dDisp, *disp);
     }
         
     // rotate direction if necessary
@@ -588,19 +383,19 @@ int ESInvertedVBraceJntOff2d::transfDaqDisp(Vector* disp)
 int ESInvertedVBraceJntOff2d::transfDaqVel(Vector* vel)
 {
     // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
+    if (geometry == ES_linearLeft)  {
         (*vel)(0) = (*dVel)(0);
         (*vel)(1) = 1.0/(L1+L2)*(L2*(*dVel)(1) + L1*(*dVel)(2));
         (*vel)(2) = 1.0/(L1+L2)*(-(*dVel)(1) + (*dVel)(2));
     }
     // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_linearRight)  {
         (*vel)(0) = -(*dVel)(0);
         (*vel)(1) = 1.0/(L1+L2)*(L2*(*dVel)(1) + L1*(*dVel)(2));
         (*vel)(2) = 1.0/(L1+L2)*(-(*dVel)(1) + (*dVel)(2));
     }
     // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
+    else if (geometry == ES_nonlinearLeft)  {
         if (firstWarning[1] == true)  {
             opserr << "WARNING ESInvertedVBraceJntOff2d::transfDaqVel() - "
                 << "nonlinear geometry with horizontal actuator left "
@@ -612,7 +407,7 @@ int ESInvertedVBraceJntOff2d::transfDaqVel(Vector* vel)
         (*vel)(2) = 1.0/(L1+L2)*(-(*dVel)(1) + (*dVel)(2));
     }
     // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_nonlinearRight)  {
         if (firstWarning[1] == true)  {
             opserr << "WARNING ESInvertedVBraceJntOff2d::transfDaqVel() - "
                 << "nonlinear geometry with horizontal actuator right "
@@ -636,19 +431,19 @@ int ESInvertedVBraceJntOff2d::transfDaqVel(Vector* vel)
 int ESInvertedVBraceJntOff2d::transfDaqAccel(Vector* accel)
 {
     // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
+    if (geometry == ES_linearLeft)  {
         (*accel)(0) = (*dAccel)(0);
         (*accel)(1) = 1.0/(L1+L2)*(L2*(*dAccel)(1) + L1*(*dAccel)(2));
         (*accel)(2) = 1.0/(L1+L2)*(-(*dAccel)(1) + (*dAccel)(2));
     }
     // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_linearRight)  {
         (*accel)(0) = -(*dAccel)(0);
         (*accel)(1) = 1.0/(L1+L2) * (L2*(*dAccel)(1) + L1*(*dAccel)(2));
         (*accel)(2) = 1.0/(L1+L2) * (-(*dAccel)(1) + (*dAccel)(2));
     }
     // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
+    else if (geometry == ES_nonlinearLeft)  {
         if (firstWarning[2] == true)  {
             opserr << "WARNING ESInvertedVBraceJntOff2d::transfDaqAccel() - "
                 << "nonlinear geometry with horizontal actuator left "
@@ -660,7 +455,7 @@ int ESInvertedVBraceJntOff2d::transfDaqAccel(Vector* accel)
         (*accel)(2) = 1.0/(L1+L2)*(-(*dAccel)(1) + (*dAccel)(2));
     }
     // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_nonlinearRight)  {
         if (firstWarning[2] == true)  {
             opserr << "WARNING ESInvertedVBraceJntOff2d::transfDaqAccel() - "
                 << "nonlinear geometry with horizontal actuator right "
@@ -689,6 +484,12 @@ int ESInvertedVBraceJntOff2d::transfDaqForce(Vector* force)
 }
 
 
+const Vector* ESInvertedVBraceJntOff2d::getDaqSolverInfo()
+{
+    return &theKinematics.getSolverInfo();
+}
+
+
 int ESInvertedVBraceJntOff2d::transfDaqTime(Vector* time)
 {  
     *time = *dTime;
@@ -41,7 +41,8 @@ ESThreeActuators::ESThreeActuators(int tag,
     : ExperimentalSetup(tag, control),
     DOF(dof), sizeT(sizet), sizeO(sizeo),
     La0(actLength0), La1(actLength1), La2(actLength2),
-    L0(rigidLength0), L1(rigidLength1), nlGeom(nlgeom)
+    L0(rigidLength0), L1(rigidLength1), nlGeom(nlgeom),
+    theKinematics(3, nlgeom)
 {
     // check if DOF array has correct size
     if (DOF.Size() != numDOF)  {
@@ -63,6 +64,15 @@ ESThreeActuators::ESThreeActuators(int tag,
     
     strcpy(posAct0, posact0);
     
+    // resolve the geometry once, so that the transformations
+    // do not have to compare strings
+    geometry = ActuatorKinematics2d::getGeometry(nlGeom, posAct0);
+    if (geometry < 0)  {
+        opserr << "ESThreeActuators::ESThreeActuators()"
+            << " - invalid nlGeom or posAct0\n";
+        exit(OF_ReturnType_failed);
+    }
+    
     // call setup method
     this->setup();
     
@@ -72,7 +82,8 @@ ESThreeActuators::ESThreeActuators(int tag,
 
 
 ESThreeActuators::ESThreeActuators(const ESThreeActuators& es)
-    : ExperimentalSetup(es)
+    : ExperimentalSetup(es),
+    theKinematics(es.theKinematics)
 {
     DOF =   es.DOF;
     sizeT = es.sizeT;
@@ -84,6 +95,7 @@ ESThreeActuators::ESThreeActuators(const ESThreeActuators& es)
     L1      = es.L1;
     nlGeom  = es.nlGeom;
     strcpy(posAct0,es.posAct0);
+    geometry = es.geometry;
     
     // call setup method
     this->setup();
@@ -126,6 +138,15 @@ int ESThreeActuators::setup()
     
     this->setCtrlDaqSize();
     
+    // setup the actuator kinematics with the joint offsets from the
+    // control point and the directions from the bases to the joints
+    if (geometry == ES_linearLeft || geometry == ES_nonlinearLeft)
+        theKinematics.setActuator(0, -L0, 0.0, 1.0, 0.0, La0);
+    else
+        theKinematics.setActuator(0, L1, 0.0, -1.0, 0.0, La0);
+    theKinematics.setActuator(1, -L0, 0.0, 0.0, 1.0, La1);
+    theKinematics.setActuator(2, L1, 0.0, 0.0, 1.0, La2);
+    
     return OF_ReturnType_completed;
 }
 
@@ -207,47 +228,13 @@ void ESThreeActuators::Print(OPS_Stream &s, int flag)
 int ESThreeActuators::transfTrialDisp(const Vector* disp)
 {
     // extract directions
-    static Vector d(numDOF);
+    static thread_local Vector d(numDOF);
     for (int i=0; i<numDOF; i++)  {
         d(i) = (*disp)(DOF(i));
     }
     
-    // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
-        // actuator 0
-        (*cDisp)(0) = d(0);
-        // actuator 1
-        (*cDisp)(1) = d(1) - L0*d(2);
-        // actuator 2
-        (*cDisp)(2) = d(1) + L1*d(2);
-    }
-    // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
-        // actuator 0
-        (*cDisp)(0) = -d(0);
-        // actuator 1
-        (*cDisp)(1) = d(1) - L0*d(2);
-        // actuator 2
-        (*cDisp)(2) = d(1) + L1*d(2);
-    }
-    // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
-        // actuator 0
-        (*cDisp)(0) = pow(pow(d(0)+L0*(1.0-cos(d(2)))+La0,2.0)+pow(d(1)-L0*sin(d(2)),2.0),0.5)-La0;
-        // actuator 1
-        (*cDisp)(1) = pow(pow(d(0)+L0*(1.0-cos(d(2))),2.0)+pow(d(1)-L0*sin(d(2))+La1,2.0),0.5)-La1;
-        // actuator 2
-        (*cDisp)(2) = pow(pow(d(0)-L1*(1.0-cos(d(2))),2.0)+pow(d(1)+L1*sin(d(2))+La2,2.0),0.5)-La2;
-    }
-    // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
-        // actuator 0
-        (*cDisp)(0) = pow(pow(d(0)-L1*(1.0-cos(d(2)))-La0,2.0)+pow(d(1)+L1*sin(d(2)),2.0),0.5)-La0;
-        // actuator 1
-        (*cDisp)(1) = pow(pow(d(0)+L0*(1.0-cos(d(2))),2.0)+pow(d(1)-L0*sin(d(2))+La1,2.0),0.5)-La1;
-        // actuator 2
-        (*cDisp)(2) = pow(pow(d(0)-L1*(1.0-cos(d(2))),2.0)+pow(d(1)+L1*sin(d(2))+La2,2.0),0.5)-La2;
-    }
+    // actuator displacements from the kinematics
+    theKinematics.transfDisp(d, *cDisp);
     
     return OF_ReturnType_completed;
 }
@@ -263,48 +250,15 @@ int ESThreeActuators::transfTrialVel(const Vector* disp,
     const Vector* vel)
 {
     // extract directions
-    static Vector d(numDOF), v(numDOF);
+    static thread_local Vector d(numDOF), v(numDOF);
     for (int i=0; i<numDOF; i++)  {
         d(i) = (*disp)(DOF(i));
         v(i) = (*vel)(DOF(i));
     }
     
-    // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
-        // actuator 0
-        (*cVel)(0) = v(0);
-        // actuator 1
-        (*cVel)(1) = v(1) - L0*v(2);
-        // actuator 2
-        (*cVel)(2) = v(1) + L1*v(2);
-    }
-    // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
-        // actuator 0
-        (*cVel)(0) = -v(0);
-        // actuator 1
-        (*cVel)(1) = v(1) - L0*v(2);
-        // actuator 2
-        (*cVel)(2) = v(1) + L1*v(2);
-    }
-    // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
-        // actuator 0
-        (*cVel)(0) = 0.5*(2.0*(d(0)+L0*(1.0-cos(d(2)))+La0)*(v(0)+L0*sin(d(2))*v(2))+2.0*(d(1)-L0*sin(d(2)))*(v(1)-L0*cos(d(2))*v(2)))/pow(pow(d(0)+L0*(1.0-cos(d(2)))+La0,2.0)+pow(d(1)-L0*sin(d(2)),2.0),0.5);
-        // actuator 1
-        (*cVel)(1) = 0.5*(2.0*(d(0)+L0*(1.0-cos(d(2))))*(v(0)+L0*sin(d(2))*v(2))+2.0*(d(1)-L0*sin(d(2))+La1)*(v(1)-L0*cos(d(2))*v(2)))/pow(pow(d(0)+L0*(1.0-cos(d(2))),2.0)+pow(d(1)-L0*sin(d(2))+La1,2.0),0.5);
-        // actuator 2
-        (*cVel)(2) = 0.5*(2.0*(d(0)-L1*(1.0-cos(d(2))))*(v(0)-L1*sin(d(2))*v(2))+2.0*(d(1)+L1*sin(d(2))+La2)*(v(1)+L1*cos(d(2))*v(2)))/pow(pow(d(0)-L1*(1.0-cos(d(2))),2.0)+pow(d(1)+L1*sin(d(2))+La2,2.0),0.5);
-    }
-    // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
-        // actuator 0
-        (*cVel)(0) = 0.5*(2.0*(d(0)-L1*(1.0-cos(d(2)))-La0)*(v(0)-L1*sin(d(2))*v(2))+2.0*(d(1)+L1*sin(d(2)))*(v(1)+L1*cos(d(2))*v(2)))/pow(pow(d(0)-L1*(1.0-cos(d(2)))-La0,2.0)+pow(d(1)+L1*sin(d(2)),2.0),0.5);
-        // actuator 1
-        (*cVel)(1) = 0.5*(2*(d(0)+L0*(1.0-cos(d(2))))*(v(0)+L0*sin(d(2))*v(2))+2*(d(1)-L0*sin(d(2))+La1)*(v(1)-L0*cos(d(2))*v(2)))/pow(pow(d(0)+L0*(1.0-cos(d(2))),2)+pow(d(1)-L0*sin(d(2))+La1,2),0.5);
-        // actuator 2
-        (*cVel)(2) = 0.5*(2.0*(d(0)-L1*(1.0-cos(d(2))))*(v(0)-L1*sin(d(2))*v(2))+2.0*(d(1)+L1*sin(d(2))+La2)*(v(1)+L1*cos(d(2))*v(2)))/pow(pow(d(0)-L1*(1.0-cos(d(2))),2.0)+pow(d(1)+L1*sin(d(2))+La2,2.0),0.5);
-    }
+    // actuator velocities from the kinematics, which are
+    // reused from transfTrialDisp for the same displacements
+    theKinematics.transfVel(d, v, *cVel);
     
     return OF_ReturnType_completed;
 }
@@ -321,49 +275,16 @@ int ESThreeActuators::transfTrialAccel(const Vector* disp,
     const Vector* accel)
 {
     // extract directions
-    static Vector d(numDOF), v(numDOF), a(numDOF);
+    static thread_local Vector d(numDOF), v(numDOF), a(numDOF);
     for (int i=0; i<numDOF; i++)  {
         d(i) = (*disp)(DOF(i));
         v(i) = (*vel)(DOF(i));
         a(i) = (*accel)(DOF(i));
     }
     
-    // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
-        // actuator 0
-        (*cAccel)(0) = a(0);
-        // actuator 1
-        (*cAccel)(1) = a(1) - L0*a(2);
-        // actuator 2
-        (*cAccel)(2) = a(1) + L1*a(2);
-    }
-    // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
-        // actuator 0
-        (*cAccel)(0) = -a(0);
-        // actuator 1
-        (*cAccel)(1) = a(1) - L0*a(2);
-        // actuator 2
-        (*cAccel)(2) = a(1) + L1*a(2);
-    }
-    // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
-        // actuator 0
-        (*cAccel)(0) = -0.25*pow(2.0*(d(0)+L0*(1.0-cos(d(2)))+La0)*(v(0)+L0*sin(d(2))*v(2))+2.0*(d(1)-L0*sin(d(2)))*(v(1)-L0*cos(d(2))*v(2)),2.0)/pow(pow(d(0)+L0*(1.0-cos(d(2)))+La0,2.0)+pow(d(1)-L0*sin(d(2)),2.0),1.5)+0.5*(2.0*pow(v(0)+L0*sin(d(2))*v(2),2.0)+2.0*(d(0)+L0*(1.0-cos(d(2)))+La0)*(a(0)+L0*cos(d(2))*pow(v(2),2.0)+L0*sin(d(2))*a(2))+2.0*pow(v(1)-L0*cos(d(2))*v(2),2.0)+2.0*(d(1)-L0*sin(d(2)))*(a(1)+L0*sin(d(2))*pow(v(2),2.0)-L0*cos(d(2))*a(2)))/pow(pow(d(0)+L0*(1.0-cos(d(2)))+La0,2.0)+pow(d(1)-L0*sin(d(2)),2.0),0.5);
-        // actuator 1
-        (*cAccel)(1) = -0.25*pow(2.0*(d(0)+L0*(1.0-cos(d(2))))*(v(0)+L0*sin(d(2))*v(2))+2.0*(d(1)-L0*sin(d(2))+La1)*(v(1)-L0*cos(d(2))*v(2)),2.0)/pow(pow(d(0)+L0*(1.0-cos(d(2))),2.0)+pow(d(1)-L0*sin(d(2))+La1,2.0),1.5)+0.5*(2.0*pow(v(0)+L0*sin(d(2))*v(2),2.0)+2.0*(d(0)+L0*(1.0-cos(d(2))))*(a(0)+L0*cos(d(2))*pow(v(2),2.0)+L0*sin(d(2))*a(2))+2.0*pow(v(1)-L0*cos(d(2))*v(2),2.0)+2.0*(d(1)-L0*sin(d(2))+La1)*(a(1)+L0*sin(d(2))*pow(v(2),2.0)-L0*cos(d(2))*a(2)))/pow(pow(d(0)+L0*(1.0-cos(d(2))),2.0)+pow(d(1)-L0*sin(d(2))+La1,2.0),0.5);
-        // actuator 2
-        (*cAccel)(2) = -0.25*pow(2.0*(d(0)-L1*(1.0-cos(d(2))))*(v(0)-L1*sin(d(2))*v(2))+2.0*(d(1)+L1*sin(d(2))+La2)*(v(1)+L1*cos(d(2))*v(2)),2.0)/pow(pow(d(0)-L1*(1.0-cos(d(2))),2.0)+pow(d(1)+L1*sin(d(2))+La2,2.0),1.5)+0.5*(2.0*pow(v(0)-L1*sin(d(2))*v(2),2.0)+2.0*(d(0)-L1*(1.0-cos(d(2))))*(a(0)-L1*cos(d(2))*pow(v(2),2.0)-L1*sin(d(2))*a(2))+2.0*pow(v(1)+L1*cos(d(2))*v(2),2.0)+2.0*(d(1)+L1*sin(d(2))+La2)*(a(1)-L1*sin(d(2))*pow(v(2),2.0)+L1*cos(d(2))*a(2)))/pow(pow(d(0)-L1*(1.0-cos(d(2))),2.0)+pow(d(1)+L1*sin(d(2))+La2,2.0),0.5);
-    }
-    // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
-        // actuator 0
-        (*cAccel)(0) = -0.25*pow(2.0*(d(0)-L1*(1.0-cos(d(2)))-La0)*(v(0)-L1*sin(d(2))*v(2))+2.0*(d(1)+L1*sin(d(2)))*(v(1)+L1*cos(d(2))*v(2)),2.0)/pow(pow(d(0)-L1*(1.0-cos(d(2)))-La0,2.0)+pow(d(1)+L1*sin(d(2)),2.0),1.5)+0.5*(2.0*pow(v(0)-L1*sin(d(2))*v(2),2.0)+2.0*(d(0)-L1*(1.0-cos(d(2)))-La0)*(a(0)-L1*cos(d(2))*pow(v(2),2.0)-L1*sin(d(2))*a(2))+2.0*pow(v(1)+L1*cos(d(2))*v(2),2.0)+2.0*(d(1)+L1*sin(d(2)))*(a(1)-L1*sin(d(2))*pow(v(2),2.0)+L1*cos(d(2))*a(2)))/pow(pow(d(0)-L1*(1.0-cos(d(2)))-La0,2.0)+pow(d(1)+L1*sin(d(2)),2.0),0.5);
-        // actuator 1
-        (*cAccel)(1) = -0.25*pow(2.0*(d(0)+L0*(1.0-cos(d(2))))*(v(0)+L0*sin(d(2))*v(2))+2.0*(d(1)-L0*sin(d(2))+La1)*(v(1)-L0*cos(d(2))*v(2)),2.0)/pow(pow(d(0)+L0*(1.0-cos(d(2))),2.0)+pow(d(1)-L0*sin(d(2))+La1,2.0),1.5)+0.5*(2.0*pow(v(0)+L0*sin(d(2))*v(2),2.0)+2.0*(d(0)+L0*(1.0-cos(d(2))))*(a(0)+L0*cos(d(2))*pow(v(2),2.0)+L0*sin(d(2))*a(2))+2.0*pow(v(1)-L0*cos(d(2))*v(2),2.0)+2.0*(d(1)-L0*sin(d(2))+La1)*(a(1)+L0*sin(d(2))*pow(v(2),2.0)-L0*cos(d(2))*a(2)))/pow(pow(d(0)+L0*(1.0-cos(d(2))),2.0)+pow(d(1)-L0*sin(d(2))+La1,2.0),0.5);
-        // actuator 2
-        (*cAccel)(2) = -0.25*pow(2.0*(d(0)-L1*(1.0-cos(d(2))))*(v(0)-L1*sin(d(2))*v(2))+2.0*(d(1)+L1*sin(d(2))+La2)*(v(1)+L1*cos(d(2))*v(2)),2.0)/pow(pow(d(0)-L1*(1.0-cos(d(2))),2.0)+pow(d(1)+L1*sin(d(2))+La2,2.0),1.5)+0.5*(2.0*pow(v(0)-L1*sin(d(2))*v(2),2.0)+2.0*(d(0)-L1*(1.0-cos(d(2))))*(a(0)-L1*cos(d(2))*pow(v(2),2.0)-L1*sin(d(2))*a(2))+2.0*pow(v(1)+L1*cos(d(2))*v(2),2.0)+2.0*(d(1)+L1*sin(d(2))+La2)*(a(1)-L1*sin(d(2))*pow(v(2),2.0)+L1*cos(d(2))*a(2)))/pow(pow(d(0)-L1*(1.0-cos(d(2))),2.0)+pow(d(1)+L1*sin(d(2))+La2,2.0),0.5);
-    }
+    // actuator accelerations from the kinematics, which are
+    // reused from transfTrialDisp for the same displacements
+    theKinematics.transfAccel(d, v, a, *cAccel);
     
     return OF_ReturnType_completed;
 }
@@ -372,13 +293,13 @@ int ESThreeActuators::transfTrialAccel(const Vector* disp,
 int ESThreeActuators::transfTrialForce(const Vector* force)
 {
     // extract directions
-    static Vector f(numDOF);
+    static thread_local Vector f(numDOF);
     for (int i=0; i<numDOF; i++)  {
         f(i) = (*force)(DOF(i));
     }
     
     // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
+    if (geometry == ES_linearLeft)  {
         // actuator 0
         (*cForce)(0) = f(0);
         // actuator 1
@@ -387,7 +308,7 @@ int ESThreeActuators::transfTrialForce(const Vector* force)
         (*cForce)(2) = 1.0/(L0+L1)*(L0*f(1) + f(2));
     }
     // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_linearRight)  {
         // actuator 0
         (*cForce)(0) = -f(0);
         // actuator 1
@@ -396,7 +317,7 @@ int ESThreeActuators::transfTrialForce(const Vector* force)
         (*cForce)(2) = 1.0/(L0+L1)*(L0*f(1) + f(2));
     }
     // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
+    else if (geometry == ES_nonlinearLeft)  {
         if (firstWarning[0] == true)  {
             opserr << "WARNING ESThreeActuators::transfTrialForce() - "
                 << "nonlinear geometry with horizontal actuator left "
@@ -411,7 +332,7 @@ int ESThreeActuators::transfTrialForce(const Vector* force)
         (*cForce)(2) = 1.0/(L0+L1)*(L0*f(1) + f(2));
     }
     // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_nonlinearRight)  {
         if (firstWarning[0] == true)  {
             opserr << "WARNING ESThreeActuators::transfTrialForce() - "
                 << "nonlinear geometry with horizontal actuator right "
@@ -440,101 +361,24 @@ int ESThreeActuators::transfTrialTime(const Vector* time)
 
 int ESThreeActuators::transfDaqDisp(Vector* disp)
 {
-    static Vector d(numDOF);
+    static thread_local Vector d(numDOF);
     
     // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
+    if (geometry == ES_linearLeft)  {
         d(0) = (*dDisp)(0);
         d(1) = 1.0/(L0+L1)*(L1*(*dDisp)(1) + L0*(*dDisp)(2));
         d(2) = 1.0/(L0+L1)*(-(*dDisp)(1) + (*dDisp)(2));
     }
     // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_linearRight)  {
         d(0) = -(*dDisp)(0);
         d(1) = 1.0/(L0+L1)*(L1*(*dDisp)(1) + L0*(*dDisp)(2));
         d(2) = 1.0/(L0+L1)*(-(*dDisp)(1) + (*dDisp)(2));
     }
-    // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
-        Vector F(2), theta(2), dTheta(2);
-        Matrix DF(2,2);
-        int iter = 0;
-        int maxIter = 15;
-        double tol = 1E-9;
-        
-        double d0 = La0 + (*dDisp)(0);
-        double d1 = La1 + (*dDisp)(1);
-        double d2 = La2 + (*dDisp)(2);
-        
-        theta(0) = (*dDisp)(0)/La1;
-        theta(1) = (*dDisp)(0)/La2;
-        
-        do  {
-            F(0) = pow(d0,2.0) - pow(d1*sin(theta(0))+La0,2.0) - pow(d1*cos(theta(0))-La1,2.0);
-            F(1) = pow(L0+L1,2.0) - pow(d2*sin(theta(1))+L0+L1-d1*sin(theta(0)),2.0) - pow(d2*cos(theta(1))+La1-La2-d1*cos(theta(0)),2.0);
-            
-            DF(0,0) = 2.0*d1*(-La0*cos(theta(0))-La1*sin(theta(0)));
-            DF(0,1) = 0.0;
-            DF(1,0) = 2.0*d1*((L0+L1)*cos(theta(0))-d2*sin(theta(0)-theta(1))-(La1-La2)*sin(theta(0)));
-            DF(1,1) = 2.0*d2*(-(L0+L1)*cos(theta(1))+d1*sin(theta(0)-theta(1))+(La1-La2)*sin(theta(1)));
-            
-            // Newton's method
-            dTheta = F/DF;
-            theta -= dTheta;
-            iter++;
-        }  while ((dTheta.Norm() >= tol) && (iter <= maxIter));
-        
-        // issue warning if iteration did not converge
-        if (iter >= maxIter)   {
-            opserr << "WARNING ESThreeActuators::transfDaqDisp() - "
-                << "did not find the angle theta after "
-                << iter << " iterations and norm: " << dTheta.Norm() << endln;
-        }
-        
-        d(2) = atan2(d2*cos(theta(1))+La1-La2-d1*cos(theta(0)),d2*sin(theta(1))+L0+L1-d1*sin(theta(0)));
-        d(0) = d1*sin(theta(0))+L0*cos(d(2))-L0;
-        d(1) = d1*cos(theta(0))+L0*sin(d(2))-La1;
-    }
-    // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
-        Vector F(2), theta(2), dTheta(2);
-        Matrix DF(2,2);
-        int iter = 0;
-        int maxIter = 15;
-        double tol = 1E-9;
-        
-        double d0 = La0 + (*dDisp)(0);
-        double d1 = La1 + (*dDisp)(1);
-        double d2 = La2 + (*dDisp)(2);
-        
-        theta(0) = (*dDisp)(0)/La1;
-        theta(1) = (*dDisp)(0)/La2;
-        
-        do  {
-            F(0) = pow(L0+L1,2.0) - pow(-d2*sin(theta(1))+L0+L1+d1*sin(theta(0)),2.0) - pow(d2*cos(theta(1))+La1-La2-d1*cos(theta(0)),2.0);
-            F(1) = pow(d0,2.0) - pow(-d2*sin(theta(1))-La0,2.0) - pow(d2*cos(theta(1))-La2,2.0);
-            
-            DF(0,0) = 2.0*d1*(-(L0+L1)*cos(theta(0))-d2*sin(theta(0)-theta(1))-(La1-La2)*sin(theta(0)));
-            DF(0,1) = 2.0*d2*((L0+L1)*cos(theta(1))+d1*sin(theta(0)-theta(1))+(La1-La2)*sin(theta(1)));
-            DF(1,0) = 0.0;
-            DF(1,1) = 2.0*d2*(-La0*cos(theta(1))-La2*sin(theta(1)));
-            
-            // Newtons method
-            dTheta = F/DF;
-            theta -= dTheta;
-            iter++;
-        }  while ((dTheta.Norm() >= tol) && (iter <= maxIter));
-        
-        // issue warning if iteration did not converge
-        if (iter >= maxIter)   {
-            opserr << "WARNING ESThreeActuators::transfDaqDisp() - "
-                << "did not find the angle theta after "
-                << iter << " iterations and norm: " << dTheta.Norm() << endln;
-        }
-        
-        d(2) = atan2(d2*cos(theta(1))+La1-La2-d1*cos(theta(0)),-d2*sin(theta(1))+L0+L1+d1*sin(theta(0)));
-        d(0) = -d1*sin(theta(0))+L0*cos(d(2))-L0;
-        d(1) = d1*cos(theta(0))+L0*sin(d(2))-La1;
+    // nonlinear geometry, solved with Newton's method that is started
+    // from the solution of the last step
+    else  {
+        theKinematics.transfDispInv(*dDisp, d);
     }
     
     // assemble directions
@@ -548,22 +392,22 @@ int ESThreeActuators::transfDaqDisp(Vector* disp)
 
 int ESThreeActuators::transfDaqVel(Vector* vel)
 {
-    static Vector v(numDOF);
+    static thread_local Vector v(numDOF);
     
     // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
+    if (geometry == ES_linearLeft)  {
         v(0) = (*dVel)(0);
         v(1) = 1.0/(L0+L1)*(L1*(*dVel)(1) + L0*(*dVel)(2));
         v(2) = 1.0/(L0+L1)*(-(*dVel)(1) + (*dVel)(2));
     }
     // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_linearRight)  {
         v(0) = -(*dVel)(0);
         v(1) = 1.0/(L0+L1)*(L1*(*dVel)(1) + L0*(*dVel)(2));
         v(2) = 1.0/(L0+L1)*(-(*dVel)(1) + (*dVel)(2));
     }
     // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
+    else if (geometry == ES_nonlinearLeft)  {
         if (firstWarning[1] == true)  {
             opserr << "WARNING ESThreeActuators::transfDaqVel() - "
                 << "nonlinear geometry with horizontal actuator left "
@@ -575,7 +419,7 @@ int ESThreeActuators::transfDaqVel(Vector* vel)
         v(2) = 1.0/(L0+L1)*(-(*dVel)(1) + (*dVel)(2));
     }
     // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_nonlinearRight)  {
         if (firstWarning[1] == true)  {
             opserr << "WARNING ESThreeActuators::transfDaqVel() - "
                 << "nonlinear geometry with horizontal actuator right "
@@ -598,22 +442,22 @@ int ESThreeActuators::transfDaqVel(Vector* vel)
 
 int ESThreeActuators::transfDaqAccel(Vector* accel)
 {
-    static Vector a(numDOF);
+    static thread_local Vector a(numDOF);
     
     // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
+    if (geometry == ES_linearLeft)  {
         a(0) = (*dAccel)(0);
         a(1) = 1.0/(L0+L1)*(L1*(*dAccel)(1) + L0*(*dAccel)(2));
         a(2) = 1.0/(L0+L1)*(-(*dAccel)(1) + (*dAccel)(2));
     }
     // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_linearRight)  {
         a(0) = -(*dAccel)(0);
         a(1) = 1.0/(L0+L1)*(L1*(*dAccel)(1) + L0*(*dAccel)(2));
         a(2) = 1.0/(L0+L1)*(-(*dAccel)(1) + (*dAccel)(2));
     }
     // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
+    else if (geometry == ES_nonlinearLeft)  {
         if (firstWarning[2] == true)  {
             opserr << "WARNING ESThreeActuators::transfDaqAccel() - "
                 << "nonlinear geometry with horizontal actuator left "
@@ -625,7 +469,7 @@ int ESThreeActuators::transfDaqAccel(Vector* accel)
         a(2) = 1.0/(L0+L1)*(-(*dAccel)(1) + (*dAccel)(2));
     }
     // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_nonlinearRight)  {
         if (firstWarning[2] == true)  {
             opserr << "WARNING ESThreeActuators::transfDaqAccel() - "
                 << "nonlinear geometry with horizontal actuator right "
@@ -648,121 +492,26 @@ int ESThreeActuators::transfDaqAccel(Vector* accel)
 
 int ESThreeActuators::transfDaqForce(Vector* force)
 {
-    static Vector f(numDOF);
+    static thread_local Vector f(numDOF);
     
     // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
+    if (geometry == ES_linearLeft)  {
         f(0) = (*dForce)(0);
         f(1) = (*dForce)(1) + (*dForce)(2);
         f(2) = -L0*(*dForce)(1) + L1*(*dForce)(2);
     }
     // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0,"right") == 0)  {
+    else if (geometry == ES_linearRight)  {
         f(0) = -(*dForce)(0);
         f(1) = (*dForce)(1) + (*dForce)(2);
         f(2) = -L0*(*dForce)(1) + L1*(*dForce)(2);
     }
-    // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0,"left") == 0)  {
-        Vector F(2), theta(2), dTheta(2);
-        Matrix DF(2,2);
-        int iter = 0;
-        int maxIter = 15;
-        double tol = 1E-9;
-        
-        double d0 = La0 + (*dDisp)(0);
-        double d1 = La1 + (*dDisp)(1);
-        double d2 = La2 + (*dDisp)(2);
-        
-        theta(0) = (*dDisp)(0)/La1;
-        theta(1) = (*dDisp)(0)/La2;
-        
-        do  {
-            F(0) = pow(d0,2.0) - pow(d1*sin(theta(0))+La0,2.0) - pow(d1*cos(theta(0))-La1,2.0);
-            F(1) = pow(L0+L1,2.0) - pow(d2*sin(theta(1))+L0+L1-d1*sin(theta(0)),2.0) - pow(d2*cos(theta(1))+La1-La2-d1*cos(theta(0)),2.0);
-            
-            DF(0,0) = 2.0*d1*(-La0*cos(theta(0))-La1*sin(theta(0)));
-            DF(0,1) = 0.0;
-            DF(1,0) = 2.0*d1*((L0+L1)*cos(theta(0))-d2*sin(theta(0)-theta(1))-(La1-La2)*sin(theta(0)));
-            DF(1,1) = 2.0*d2*(-(L0+L1)*cos(theta(1))+d1*sin(theta(0)-theta(1))+(La1-La2)*sin(theta(1)));
-            
-            // Newton's method
-            dTheta = F/DF;
-            theta -= dTheta;
-            iter++;
-        }  while ((dTheta.Norm() >= tol) && (iter <= maxIter));
-        
-        // issue warning if iteration did not converge
-        if (iter >= maxIter)   {
-            opserr << "WARNING ESThreeActuators::transfDaqForce() - "
-                << "did not find the angle theta after "
-                << iter << " iterations and norm: " << dTheta.Norm() << endln;
-        }
-        
-        double disp2 = atan2(d2*cos(theta(1))+La1-La2-d1*cos(theta(0)),d2*sin(theta(1))+L0+L1-d1*sin(theta(0)));
-        
-        static Vector fx(3), fy(3);
-        fx(0) = (*dForce)(0)*(d1*sin(theta(0))+La0)/d0;
-        fx(1) = (*dForce)(1)*sin(theta(0));
-        fx(2) = (*dForce)(2)*sin(theta(1));
-        fy(0) = (*dForce)(0)*(d1*cos(theta(0))-La1)/d0;
-        fy(1) = (*dForce)(1)*cos(theta(0));
-        fy(2) = (*dForce)(2)*cos(theta(1));
-        
-        f(0) = fx(0) + fx(1) + fx(2);
-        f(1) = fy(0) + fy(1) + fy(2);
-        f(2) = ((fx(0)+fx(1))*L0 - fx(2)*L1)*sin(disp2) - ((fy(0)+fy(1))*L0 - fy(2)*L1)*cos(disp2);
-    }
-    // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0,"right") == 0)  {
-        Vector F(2), theta(2), dTheta(2);
-        Matrix DF(2,2);
-        int iter = 0;
-        int maxIter = 15;
-        double tol = 1E-9;
-        
-        double d0 = La0 + (*dDisp)(0);
-        double d1 = La1 + (*dDisp)(1);
-        double d2 = La2 + (*dDisp)(2);
-        
-        theta(0) = (*dDisp)(0)/La1;
-        theta(1) = (*dDisp)(0)/La2;
-        
-        do  {
-            F(0) = pow(L0+L1,2.0) - pow(-d2*sin(theta(1))+L0+L1+d1*sin(theta(0)),2.0) - pow(d2*cos(theta(1))+La1-La2-d1*cos(theta(0)),2.0);
-            F(1) = pow(d0,2.0) - pow(-d2*sin(theta(1))-La0,2.0) - pow(d2*cos(theta(1))-La2,2.0);
-            
-            DF(0,0) = 2.0*d1*(-(L0+L1)*cos(theta(0))-d2*sin(theta(0)-theta(1))-(La1-La2)*sin(theta(0)));
-            DF(0,1) = 2.0*d2*((L0+L1)*cos(theta(1))+d1*sin(theta(0)-theta(1))+(La1-La2)*sin(theta(1)));
-            DF(1,0) = 0.0;
-            DF(1,1) = 2.0*d2*(-La0*cos(theta(1))-La2*sin(theta(1)));
-            
-            // Newtons method
-            dTheta = F/DF;
-            theta -= dTheta;
-            iter++;
-        }  while ((dTheta.Norm() >= tol) && (iter <= maxIter));
-        
-        // issue warning if iteration did not converge
-        if (iter >= maxIter)   {
-            opserr << "WARNING ESThreeActuators::transfDaqForce() - "
-                << "did not find the angle theta after "
-                << iter << " iterations and norm: " << dTheta.Norm() << endln;
-        }
-        
-        double disp2 = atan2(d2*cos(theta(1))+La1-La2-d1*cos(theta(0)),-d2*sin(theta(1))+L0+L1+d1*sin(theta(0)));
-        
-        static Vector fx(3), fy(3);
-        fx(0) = (*dForce)(0)*(d2*sin(theta(1))+La0)/d0;
-        fx(1) = (*dForce)(1)*sin(theta(0));
-        fx(2) = (*dForce)(2)*sin(theta(1));
-        fy(0) = (*dForce)(0)*(d2*cos(theta(1))-La1)/d0;
-        fy(1) = (*dForce)(1)*cos(theta(0));
-        fy(2) = (*dForce)(2)*cos(theta(1));
-        
-        f(0) = -fx(0) - fx(1) - fx(2);
-        f(1) = fy(0) + fy(1) + fy(2);
-        f(2) = ((fx(0)+fx(2))*L1 - fx(1)*L0)*sin(disp2) + ((fy(0)+fy(2))*L1 - fy(1)*L0)*cos(disp2);
+    // nonlinear geometry, the actuator forces are transformed with
+    // the Jacobian at the daq displacements
+    else  {
+        static thread_local Vector d(numDOF);
+        theKinematics.transfDispInv(*dDisp, d);
+        theKinematics.transfForce(d, *dForce, f);
     }
     
     // assemble directions
@@ -774,6 +523,12 @@ int ESThreeActuators::transfDaqForce(Vector* force)
 }
 
 
+const Vector* ESThreeActuators::getDaqSolverInfo()
+{
+    return &theKinematics.getSolverInfo();
+}
+
+
 int ESThreeActuators::transfDaqTime(Vector* time)
 {  
     *time = *dTime;
@@ -44,7 +44,8 @@ ESThreeActuatorsJntOff::ESThreeActuatorsJntOff(int tag,
     La0(actLength0), La1(actLength1), La2(actLength2),
     L0(rigidLength0), L1(rigidLength1), L2(rigidLength2),
     L3(rigidLength3), L4(rigidLength4), L5(rigidLength5),
-    nlGeom(nlgeom)
+    nlGeom(nlgeom),
+    theKinematics(3, nlgeom)
 {
     // check if DOF array has correct size
     if (DOF.Size() != numDOF)  {
@@ -66,6 +67,15 @@ ESThreeActuatorsJntOff::ESThreeActuatorsJntOff(int tag,
     
     strcpy(posAct0, posact0);
     
+    // resolve the geometry once, so that the transformations
+    // do not have to compare strings
+    geometry = ActuatorKinematics2d::getGeometry(nlGeom, posAct0);
+    if (geometry < 0)  {
+        opserr << "ESThreeActuatorsJntOff::ESThreeActuatorsJntOff()"
+            << " - invalid nlGeom or posAct0\n";
+        exit(OF_ReturnType_failed);
+    }
+    
     // call setup method
     this->setup();
     
@@ -75,7 +85,8 @@ ESThreeActuatorsJntOff::ESThreeActuatorsJntOff(int tag,
 
 
 ESThreeActuatorsJntOff::ESThreeActuatorsJntOff(const ESThreeActuatorsJntOff& es)
-    : ExperimentalSetup(es)
+    : ExperimentalSetup(es),
+    theKinematics(es.theKinematics)
 {
     DOF =   es.DOF;
     sizeT = es.sizeT;
@@ -91,6 +102,7 @@ ESThreeActuatorsJntOff::ESThreeActuatorsJntOff(const ESThreeActuatorsJntOff& es)
     L5      = es.L5;
     nlGeom  = es.nlGeom;
     strcpy(posAct0,es.posAct0);
+    geometry = es.geometry;
     
     // call setup method
     this->setup();
@@ -133,6 +145,15 @@ int ESThreeActuatorsJntOff::setup()
     
     this->setCtrlDaqSize();
     
+    // setup the actuator kinematics with the joint offsets from the
+    // control point and the directions from the bases to the joints
+    if (geometry == ES_linearLeft || geometry == ES_nonlinearLeft)
+        theKinematics.setActuator(0, -(L0+L1), 0.0, 1.0, 0.0, La0);
+    else
+        theKinematics.setActuator(0, L2+L3, 0.0, -1.0, 0.0, La0);
+    theKinematics.setActuator(1, -L1, -L4, 0.0, 1.0, La1);
+    theKinematics.setActuator(2, L2, -L5, 0.0, 1.0, La2);
+    
     return OF_ReturnType_completed;
 }
 
@@ -218,57 +239,13 @@ void ESThreeActuatorsJntOff::Print(OPS_Stream &s, int flag)
 int ESThreeActuatorsJntOff::transfTrialDisp(const Vector* disp)
 {
     // extract directions
-    static Vector d(numDOF);
+    static thread_local Vector d(numDOF);
     for (int i=0; i<numDOF; i++)  {
         d(i) = (*disp)(DOF(i));
     }
     
-    // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0, "left") == 0) {
-        // actuator 0
-        (*cDisp)(0) = d(0);
-        // actuator 1
-        (*cDisp)(1) = d(1) - L1 * d(2);
-        // actuator 2
-        (*cDisp)(2) = d(1) + L2 * d(2);
-    }
-    // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0, "right") == 0) {
-        // actuator 0
-        (*cDisp)(0) = -d(0);
-        // actuator 1
-        (*cDisp)(1) = d(1) - L1 * d(2);
-        // actuator 2
-        (*cDisp)(2) = d(1) + L2 * d(2);
-    }
-    // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0, "left") == 0) {
-        double R0 = sqrt(L1*L1 + L4 * L4);
-        double R1 = sqrt(L2*L2 + L5 * L5);
-        double alpha0 = atan2(L4, L1);
-        double alpha1 = atan2(L5, L2);
-
-        // actuator 0
-        (*cDisp)(0) = pow(pow(d(0) - (L0 + L1)*cos(d(2)) + L0 + L1 + La0, 2.0) + pow(d(1) - (L0 + L1)*sin(d(2)), 2.0), 0.5) - La0;
-        // actuator 1
-        (*cDisp)(1) = pow(pow(d(0) - R0 * cos(alpha0 + d(2)) + L1, 2.0) + pow(d(1) - R0 * sin(alpha0 + d(2)) + La1 + L4, 2.0), 0.5) - La1;
-        // actuator 2
-        (*cDisp)(2) = pow(pow(d(0) + R1 * cos(-alpha1 + d(2)) - L2, 2.0) + pow(d(1) + R1 * sin(-alpha1 + d(2)) + La2 + L5, 2.0), 0.5) - La2;
-    }
-    // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0, "right") == 0) {
-        double R0 = sqrt(L1*L1 + L4 * L4);
-        double R1 = sqrt(L2*L2 + L5 * L5);
-        double alpha0 = atan2(L4, L1);
-        double alpha1 = atan2(L5, L2);
-
-        // actuator 0
-        (*cDisp)(0) = pow(pow(d(0) + (L2 + L3)*cos(d(2)) - L2 - L3 - La0, 2.0) + pow(d(1) + (L2 + L3)*sin(d(2)), 2.0), 0.5) - La0;
-        // actuator 1
-        (*cDisp)(1) = pow(pow(d(0) - R0 * cos(alpha0 + d(2)) + L1, 2.0) + pow(d(1) - R0 * sin(alpha0 + d(2)) + La1 + L4, 2.0), 0.5) - La1;
-        // actuator 2
-        (*cDisp)(2) = pow(pow(d(0) + R1 * cos(-alpha1 + d(2)) - L2, 2.0) + pow(d(1) + R1 * sin(-alpha1 + d(2)) + La2 + L5, 2.0), 0.5) - La2;
-    }
+    // actuator displacements from the kinematics
+    theKinematics.transfDisp(d, *cDisp);
     
     return OF_ReturnType_completed;
 }
@@ -284,58 +261,15 @@ int ESThreeActuatorsJntOff::transfTrialVel(const Vector* disp,
     const Vector* vel)
 {
     // extract directions
-    static Vector d(numDOF), v(numDOF);
+    static thread_local Vector d(numDOF), v(numDOF);
     for (int i=0; i<numDOF; i++)  {
         d(i) = (*disp)(DOF(i));
         v(i) = (*vel)(DOF(i));
     }
     
-    // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0, "left") == 0) {
-        // actuator 0
-        (*cVel)(0) = v(0);
-        // actuator 1
-        (*cVel)(1) = v(1) - L1 * v(2);
-        // actuator 2
-        (*cVel)(2) = v(1) + L2 * v(2);
-    }
-    // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0, "right") == 0) {
-        // actuator 0
-        (*cVel)(0) = -v(0);
-        // actuator 1
-        (*cVel)(1) = v(1) - L1 * v(2);
-        // actuator 2
-        (*cVel)(2) = v(1) + L2 * v(2);
-    }
-    // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0, "left") == 0) {
-        double R0 = sqrt(L1*L1 + L4 * L4);
-        double R1 = sqrt(L2*L2 + L5 * L5);
-        double alpha0 = atan2(L4, L1);
-        double alpha1 = atan2(L5, L2);
-
-        // actuator 0
-        (*cVel)(0) = 0.5*(2.0*(d(0) - (L0 + L1)*cos(d(2)) + L0 + L1 + La0)*(v(0) + (L0 + L1)*sin(d(2))*v(2)) + 2.0*(d(1) - (L0 + L1)*sin(d(2)))*(v(1) - (L0 + L1)*cos(d(2))*v(2))) / pow(pow(d(0) - (L0 + L1)*cos(d(2)) + L0 + L1 + La0, 2.0) + pow(d(1) - (L0 + L1)*sin(d(2)), 2.0), 0.5);
-        // actuator 1
-        (*cVel)(1) = 0.5*(2.0*(d(0) - R0 * cos(alpha0 + d(2)) + L1)*(v(0) + R0 * sin(alpha0 + d(2))*v(2)) + 2.0*(d(1) - R0 * sin(alpha0 + d(2)) + La1 + L4)*(v(1) - R0 * cos(alpha0 + d(2))*v(2))) / pow(pow(d(0) - R0 * cos(alpha0 + d(2)) + L1, 2.0) + pow(d(1) - R0 * sin(alpha0 + d(2)) + La1 + L4, 2.0), 0.5);
-        // actuator 2
-        (*cVel)(2) = 0.5*(2.0*(d(0) + R1 * cos(-alpha1 + d(2)) - L2)*(v(0) - R1 * sin(-alpha1 + d(2))*v(2)) + 2.0*(d(1) + R1 * sin(-alpha1 + d(2)) + La2 + L5)*(v(1) + R1 * cos(-alpha1 + d(2))*v(2))) / pow(pow(d(0) + R1 * cos(-alpha1 + d(2)) - L2, 2.0) + pow(d(1) + R1 * sin(-alpha1 + d(2)) + La2 + L5, 2.0), 0.5);
-    }
-    // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0, "right") == 0) {
-        double R0 = sqrt(L1*L1 + L4 * L4);
-        double R1 = sqrt(L2*L2 + L5 * L5);
-        double alpha0 = atan2(L4, L1);
-        double alpha1 = atan2(L5, L2);
-
-        // actuator 0
-        (*cVel)(0) = 0.5*(2.0*(d(0) + (L2 + L3)*cos(d(2)) - L2 - L3 - La0)*(v(0) - (L2 + L3)*sin(d(2))*v(2)) + 2.0*(d(1) + (L2 + L3)*sin(d(2)))*(v(1) + (L2 + L3)*cos(d(2))*v(2))) / pow(pow(d(0) + (L2 + L3)*cos(d(2)) - L2 - L3 - La0, 2.0) + pow(d(1) + (L2 + L3)*sin(d(2)), 2.0), 0.5);
-        // actuator 1
-        (*cVel)(1) = 0.5*(2.0*(d(0) - R0 * cos(alpha0 + d(2)) + L1)*(v(0) + R0 * sin(alpha0 + d(2))*v(2)) + 2.0*(d(1) - R0 * sin(alpha0 + d(2)) + La1 + L4)*(v(1) - R0 * cos(alpha0 + d(2))*v(2))) / pow(pow(d(0) - R0 * cos(alpha0 + d(2)) + L1, 2.0) + pow(d(1) - R0 * sin(alpha0 + d(2)) + La1 + L4, 2.0), 0.5);
-        // actuator 2
-        (*cVel)(2) = 0.5*(2.0*(d(0) + R1 * cos(-alpha1 + d(2)) - L2)*(v(0) - R1 * sin(-alpha1 + d(2))*v(2)) + 2.0*(d(1) + R1 * sin(-alpha1 + d(2)) + La2 + L5)*(v(1) + R1 * cos(-alpha1 + d(2))*v(2))) / pow(pow(d(0) + R1 * cos(-alpha1 + d(2)) - L2, 2.0) + pow(d(1) + R1 * sin(-alpha1 + d(2)) + La2 + L5, 2.0), 0.5);
-    }
+    // actuator velocities from the kinematics, which are
+    // reused from transfTrialDisp for the same displacements
+    theKinematics.transfVel(d, v, *cVel);
     
     return OF_ReturnType_completed;
 }
@@ -352,59 +286,16 @@ int ESThreeActuatorsJntOff::transfTrialAccel(const Vector* disp,
     const Vector* accel)
 {
     // extract directions
-    static Vector d(numDOF), v(numDOF), a(numDOF);
+    static thread_local Vector d(numDOF), v(numDOF), a(numDOF);
     for (int i=0; i<numDOF; i++)  {
         d(i) = (*disp)(DOF(i));
         v(i) = (*vel)(DOF(i));
         a(i) = (*accel)(DOF(i));
     }
     
-    // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0, "left") == 0) {
-        // actuator 0
-        (*cAccel)(0) = a(0);
-        // actuator 1
-        (*cAccel)(1) = a(1) - L1 * a(2);
-        // actuator 2
-        (*cAccel)(2) = a(1) + L2 * a(2);
-    }
-    // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0, "right") == 0) {
-        // actuator 0
-        (*cAccel)(0) = -a(0);
-        // actuator 1
-        (*cAccel)(1) = a(1) - L1 * a(2);
-        // actuator 2
-        (*cAccel)(2) = a(1) + L2 * a(2);
-    }
-    // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0, "left") == 0) {
-        double R0 = sqrt(L1*L1 + L4 * L4);
-        double R1 = sqrt(L2*L2 + L5 * L5);
-        double alpha0 = atan2(L4, L1);
-        double alpha1 = atan2(L5, L2);
-
-        // actuator 0
-        (*cAccel)(0) = -0.25*pow(2.0*(d(0) - (L0 + L1)*cos(d(2)) + L0 + L1 + La0)*(v(0) + (L0 + L1)*sin(d(2))*v(2)) + 2.0*(d(1) - (L0 + L1)*sin(d(2)))*(v(1) - (L0 + L1)*cos(d(2))*v(2)), 2.0) / pow(pow(d(0) - (L0 + L1)*cos(d(2)) + L0 + L1 + La0, 2.0) + pow(d(1) - (L0 + L1)*sin(d(2)), 2.0), 1.5) + 0.5*(2.0*pow(v(0) + (L0 + L1)*sin(d(2))*v(2), 2.0) + 2.0*(d(0) - (L0 + L1)*cos(d(2)) + L0 + L1 + La0)*(a(0) + (L0 + L1)*cos(d(2))*pow(v(2), 2.0) + (L0 + L1)*sin(d(2))*a(2)) + 2.0*pow(v(1) - (L0 + L1)*cos(d(2))*v(2), 2.0) + 2.0*(d(1) - (L0 + L1)*sin(d(2)))*(a(1) + (L0 + L1)*sin(d(2))*pow(v(2), 2.0) - (L0 + L1)*cos(d(2))*a(2))) / pow(pow(d(0) - (L0 + L1)*cos(d(2)) + L0 + L1 + La0, 2.0) + pow(d(1) - (L0 + L1)*sin(d(2)), 2.0), 0.5);
-        // actuator 1
-        (*cAccel)(1) = -0.25*pow(2.0*(d(0) - R0 * cos(alpha0 + d(2)) + L1)*(v(0) + R0 * sin(alpha0 + d(2))*v(2)) + 2.0*(d(1) - R0 * sin(alpha0 + d(2)) + La1 + L4)*(v(1) - R0 * cos(alpha0 + d(2))*v(2)), 2.0) / pow(pow(d(0) - R0 * cos(alpha0 + d(2)) + L1, 2.0) + pow(d(1) - R0 * sin(alpha0 + d(2)) + La1 + L4, 2.0), 1.5) + 0.5*(2.0*pow(v(0) + R0 * sin(alpha0 + d(2))*v(2), 2.0) + 2.0*(d(0) - R0 * cos(alpha0 + d(2)) + L1)*(a(0) + R0 * cos(alpha0 + d(2))*pow(v(2), 2.0) + R0 * sin(alpha0 + d(2))*a(2)) + 2.0*pow(v(1) - R0 * cos(alpha0 + d(2))*v(2), 2.0) + 2.0*(d(1) - R0 * sin(alpha0 + d(2)) + La1 + L4)*(a(1) + R0 * sin(alpha0 + d(2))*pow(v(2), 2.0) - R0 * cos(alpha0 + d(2))*a(2))) / pow(pow(d(0) - R0 * cos(alpha0 + d(2)) + L1, 2.0) + pow(d(1) - R0 * sin(alpha0 + d(2)) + La1 + L4, 2.0), 0.5);
-        // actuator 2
-        (*cAccel)(2) = -0.25*pow(2.0*(d(0) + R1 * cos(-alpha1 + d(2)) - L2)*(v(0) - R1 * sin(-alpha1 + d(2))*v(2)) + 2.0*(d(1) + R1 * sin(-alpha1 + d(2)) + La2 + L5)*(v(1) + R1 * cos(-alpha1 + d(2))*v(2)), 2.0) / pow(pow(d(0) + R1 * cos(-alpha1 + d(2)) - L2, 2.0) + pow(d(1) + R1 * sin(-alpha1 + d(2)) + La2 + L5, 2.0), 1.5) + 0.5*(2.0*pow(v(0) - R1 * sin(-alpha1 + d(2))*v(2), 2.0) + 2.0*(d(0) + R1 * cos(-alpha1 + d(2)) - L2)*(a(0) - R1 * cos(-alpha1 + d(2))*pow(v(2), 2.0) - R1 * sin(-alpha1 + d(2))*a(2)) + 2.0*pow(v(1) + R1 * cos(-alpha1 + d(2))*v(2), 2.0) + 2.0*(d(1) + R1 * sin(-alpha1 + d(2)) + La2 + L5)*(a(1) - R1 * sin(-alpha1 + d(2))*pow(v(2), 2.0) + R1 * cos(-alpha1 + d(2))*a(2))) / pow(pow(d(0) + R1 * cos(-alpha1 + d(2)) - L2, 2.0) + pow(d(1) + R1 * sin(-alpha1 + d(2)) + La2 + L5, 2.0), 0.5);
-    }
-    // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0, "right") == 0) {
-        double R0 = sqrt(L1*L1 + L4 * L4);
-        double R1 = sqrt(L2*L2 + L5 * L5);
-        double alpha0 = atan2(L4, L1);
-        double alpha1 = atan2(L5, L2);
-
-        // actuator 0
-        (*cAccel)(0) = -0.25*pow(2.0*(d(0) + (L2 + L3)*cos(d(2)) - L2 - L3 - La0)*(v(0) - (L2 + L3)*sin(d(2))*v(2)) + 2.0*(d(1) + (L2 + L3)*sin(d(2)))*(v(1) + (L2 + L3)*cos(d(2))*v(2)), 2.0) / pow(pow(d(0) + (L2 + L3)*cos(d(2)) - L2 - L3 - La0, 2.0) + pow(d(1) + (L2 + L3)*sin(d(2)), 2.0), 1.5) + 0.5*(2.0*pow(v(0) - (L2 + L3)*sin(d(2))*v(2), 2.0) + 2.0*(d(0) + (L2 + L3)*cos(d(2)) - L2 - L3 - La0)*(a(0) - (L2 + L3)*cos(d(2))*pow(v(2), 2.0) - (L2 + L3)*sin(d(2))*a(2)) + 2.0*pow(v(1) + (L2 + L3)*cos(d(2))*v(2), 2.0) + 2.0*(d(1) + (L2 + L3)*sin(d(2)))*(a(1) - (L2 + L3)*sin(d(2))*pow(v(2), 2.0) + (L2 + L3)*cos(d(2))*a(2))) / pow(pow(d(0) + (L2 + L3)*cos(d(2)) - L2 - L3 - La0, 2.0) + pow(d(1) + (L2 + L3)*sin(d(2)), 2.0), 0.5);
-        // actuator 1
-        (*cAccel)(1) = -0.25*pow(2.0*(d(0) - R0 * cos(alpha0 + d(2)) + L1)*(v(0) + R0 * sin(alpha0 + d(2))*v(2)) + 2.0*(d(1) - R0 * sin(alpha0 + d(2)) + La1 + L4)*(v(1) - R0 * cos(alpha0 + d(2))*v(2)), 2.0) / pow(pow(d(0) - R0 * cos(alpha0 + d(2)) + L1, 2.0) + pow(d(1) - R0 * sin(alpha0 + d(2)) + La1 + L4, 2.0), 1.5) + 0.5*(2.0*pow(v(0) + R0 * sin(alpha0 + d(2))*v(2), 2.0) + 2.0*(d(0) - R0 * cos(alpha0 + d(2)) + L1)*(a(0) + R0 * cos(alpha0 + d(2))*pow(v(2), 2.0) + R0 * sin(alpha0 + d(2))*a(2)) + 2.0*pow(v(1) - R0 * cos(alpha0 + d(2))*v(2), 2.0) + 2.0*(d(1) - R0 * sin(alpha0 + d(2)) + La1 + L4)*(a(1) + R0 * sin(alpha0 + d(2))*pow(v(2), 2.0) - R0 * cos(alpha0 + d(2))*a(2))) / pow(pow(d(0) - R0 * cos(alpha0 + d(2)) + L1, 2.0) + pow(d(1) - R0 * sin(alpha0 + d(2)) + La1 + L4, 2.0), 0.5);
-        // actuator 2
-        (*cAccel)(2) = -0.25*pow(2.0*(d(0) + R1 * cos(-alpha1 + d(2)) - L2)*(v(0) - R1 * sin(-alpha1 + d(2))*v(2)) + 2.0*(d(1) + R1 * sin(-alpha1 + d(2)) + La2 + L5)*(v(1) + R1 * cos(-alpha1 + d(2))*v(2)), 2.0) / pow(pow(d(0) + R1 * cos(-alpha1 + d(2)) - L2, 2.0) + pow(d(1) + R1 * sin(-alpha1 + d(2)) + La2 + L5, 2.0), 1.5) + 0.5*(2.0*pow(v(0) - R1 * sin(-alpha1 + d(2))*v(2), 2.0) + 2.0*(d(0) + R1 * cos(-alpha1 + d(2)) - L2)*(a(0) - R1 * cos(-alpha1 + d(2))*pow(v(2), 2.0) - R1 * sin(-alpha1 + d(2))*a(2)) + 2.0*pow(v(1) + R1 * cos(-alpha1 + d(2))*v(2), 2.0) + 2.0*(d(1) + R1 * sin(-alpha1 + d(2)) + La2 + L5)*(a(1) - R1 * sin(-alpha1 + d(2))*pow(v(2), 2.0) + R1 * cos(-alpha1 + d(2))*a(2))) / pow(pow(d(0) + R1 * cos(-alpha1 + d(2)) - L2, 2.0) + pow(d(1) + R1 * sin(-alpha1 + d(2)) + La2 + L5, 2.0), 0.5);
-    }
+    // actuator accelerations from the kinematics, which are
+    // reused from transfTrialDisp for the same displacements
+    theKinematics.transfAccel(d, v, a, *cAccel);
     
     return OF_ReturnType_completed;
 }
@@ -413,13 +304,13 @@ int ESThreeActuatorsJntOff::transfTrialAccel(const Vector* disp,
 int ESThreeActuatorsJntOff::transfTrialForce(const Vector* force)
 {
     // extract directions
-    static Vector f(numDOF);
+    static thread_local Vector f(numDOF);
     for (int i=0; i<numDOF; i++)  {
         f(i) = (*force)(DOF(i));
     }
     
     // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0, "left") == 0) {
+    if (geometry == ES_linearLeft) {
         // actuator 0
         (*cForce)(0) = f(0);
         // actuator 1
@@ -428,7 +319,7 @@ int ESThreeActuatorsJntOff::transfTrialForce(const Vector* force)
         (*cForce)(2) = 1.0 / (L1 + L2)*(L1*f(1) + f(2));
     }
     // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0, "right") == 0) {
+    else if (geometry == ES_linearRight) {
         // actuator 0
         (*cForce)(0) = -f(0);
         // actuator 1
@@ -437,7 +328,7 @@ int ESThreeActuatorsJntOff::transfTrialForce(const Vector* force)
         (*cForce)(2) = 1.0 / (L1 + L2)*(L1*f(1) + f(2));
     }
     // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0, "left") == 0) {
+    else if (geometry == ES_nonlinearLeft) {
         if (firstWarning[0] == true) {
             opserr << "WARNING ESThreeActuatorsJntOff::transfTrialForce() - "
                 << "nonlinear geometry with horizontal actuator left "
@@ -452,7 +343,7 @@ int ESThreeActuatorsJntOff::transfTrialForce(const Vector* force)
         (*cForce)(2) = 1.0 / (L1 + L2)*(L1*f(1) + f(2));
     }
     // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0, "right") == 0) {
+    else if (geometry == ES_nonlinearRight) {
         if (firstWarning[0] == true) {
             opserr << "WARNING ESThreeActuatorsJntOff::transfTrialForce() - "
                 << "nonlinear geometry with horizontal actuator right "
@@ -481,119 +372,24 @@ int ESThreeActuatorsJntOff::transfTrialTime(const Vector* time)
 
 int ESThreeActuatorsJntOff::transfDaqDisp(Vector* disp)
 {
-    static Vector d(numDOF);
+    static thread_local Vector d(numDOF);
     
     // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0, "left") == 0) {
+    if (geometry == ES_linearLeft) {
         d(0) = (*dDisp)(0);
         d(1) = 1.0 / (L1 + L2)*(L2*(*dDisp)(1) + L1 * (*dDisp)(2));
         d(2) = 1.0 / (L1 + L2)*(-(*dDisp)(1) + (*dDisp)(2));
     }
     // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0, "right") == 0) {
+    else if (geometry == ES_linearRight) {
         d(0) = -(*dDisp)(0);
         d(1) = 1.0 / (L1 + L2)*(L2*(*dDisp)(1) + L1 * (*dDisp)(2));
         d(2) = 1.0 / (L1 + L2)*(-(*dDisp)(1) + (*dDisp)(2));
     }
-    // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0, "left") == 0) {
-        Vector F(3), theta(3), dTheta(3);
-        Matrix DF(3, 3);
-        int iter = 0;
-        int maxIter = 15;
-        double tol = 1E-9;
-
-        double d0 = La0 + (*dDisp)(0);
-        double d1 = La1 + (*dDisp)(1);
-        double d2 = La2 + (*dDisp)(2);
-
-        theta(0) = (*dDisp)(1) / La0;
-        theta(1) = (*dDisp)(0) / La1;
-        theta(2) = (*dDisp)(0) / La2;
-
-        do {
-            F(0) = L0 * L0 + L4 * L4 - pow(d0*cos(theta(0)) - La0 - L0 - d1 * sin(theta(1)), 2.0) - pow(d0*sin(theta(0)) + La1 + L4 - d1 * cos(theta(1)), 2.0);
-            F(1) = pow(L1 + L2, 2.0) + pow(L4 - L5, 2.0) - pow(d2*sin(theta(2)) + L1 + L2 - d1 * sin(theta(1)), 2.0) - pow(d2*cos(theta(2)) + La1 + L4 - L5 - La2 - d1 * cos(theta(1)), 2.0);
-            F(2) = pow(L0 + L1 + L2, 2.0) + L5 * L5 - pow(d0*cos(theta(0)) - La0 - L0 - d2 * sin(theta(2)) - L1 - L2, 2.0) - pow(d0*sin(theta(0)) + La2 + L5 - d2 * cos(theta(2)), 2.0);
-
-            DF(0, 0) = 2.0*d0*(-(L4 + La1)*cos(theta(0)) + d1 * cos(theta(1) + theta(0)) - (L0 + La0)*sin(theta(0)));
-            DF(0, 1) = 2.0*d1*(-(L0 + La0)*cos(theta(1)) + d0 * cos(theta(1) + theta(0)) - (L4 + La1)*sin(theta(1)));
-            DF(0, 2) = 0.0;
-            DF(1, 0) = 0.0;
-            DF(1, 1) = 2.0*d1*((L1 + L2)*cos(theta(1)) - d2 * sin(theta(1) - theta(2)) - (L4 - L5 + La1 - La2)*sin(theta(1)));
-            DF(1, 2) = 2.0*d2*(-(L1 + L2)*cos(theta(2)) + d1 * sin(theta(1) - theta(2)) + (L4 - L5 + La1 - La2)*sin(theta(2)));
-            DF(2, 0) = 2.0*d0*(-(L5 + La2)*cos(theta(0)) + d2 * cos(theta(2) + theta(0)) - (L0 + L1 + L2 + La0)*sin(theta(0)));
-            DF(2, 1) = 0.0;
-            DF(2, 2) = 2.0*d2*(-(L0 + L1 + L2 + La0)*cos(theta(2)) + d0 * cos(theta(2) + theta(0)) - (L5 + La2)*sin(theta(2)));
-
-            // Newtons method
-            dTheta = F / DF;
-            theta -= dTheta;
-            iter++;
-        } while ((dTheta.Norm() >= tol) && (iter <= maxIter));
-
-        // issue warning if iteration did not converge
-        if (iter >= maxIter) {
-            opserr << "WARNING ESThreeActuatorsJntOff::transfDaqDisp() - "
-                << "did not find the angle theta after "
-                << iter << " iterations and norm: " << dTheta.Norm() << endln;
-        }
-
-        d(2) = atan2(d2*cos(theta(2)) + La1 + L4 - L5 - La2 - d1 * cos(theta(1)), d2*sin(theta(2)) + L1 + L2 - d1 * sin(theta(1))) - atan2(L4 - L5, L1 + L2);
-        double R0 = sqrt(L1*L1 + L4 * L4);
-        double beta0 = atan2(L4, L1) + d(2);
-        d(0) = d1 * sin(theta(1)) + R0 * cos(beta0) - L1;
-        d(1) = d1 * cos(theta(1)) + R0 * sin(beta0) - La1 - L4;
-    }
-    // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0, "right") == 0) {
-        Vector F(3), theta(3), dTheta(3);
-        Matrix DF(3, 3);
-        int iter = 0;
-        int maxIter = 15;
-        double tol = 1E-9;
-
-        double d0 = La0 + (*dDisp)(0);
-        double d1 = La1 + (*dDisp)(1);
-        double d2 = La2 + (*dDisp)(2);
-
-        theta(0) = (*dDisp)(2) / La0;
-        theta(1) = (*dDisp)(0) / La1;
-        theta(2) = (*dDisp)(0) / La2;
-
-        do {
-            F(0) = pow(L1 + L2 + L3, 2.0) + L4 * L4 - pow(-d0 * cos(theta(0)) + La0 + L1 + L2 + L3 + d1 * sin(theta(1)), 2.0) - pow(d0*sin(theta(0)) + La1 + L4 - d1 * cos(theta(1)), 2.0);
-            F(1) = pow(L1 + L2, 2.0) + pow(L4 - L5, 2.0) - pow(-d2 * sin(theta(2)) + L1 + L2 + d1 * sin(theta(1)), 2.0) - pow(d2*cos(theta(2)) + La1 + L4 - L5 - La2 - d1 * cos(theta(1)), 2.0);
-            F(2) = L3 * L3 + L5 * L5 - pow(-d0 * cos(theta(0)) + La0 + L3 + d2 * sin(theta(2)), 2.0) - pow(d0*sin(theta(0)) + La2 + L5 - d2 * cos(theta(2)), 2.0);
-
-            DF(0, 0) = 2.0*d0*(-(L4 + La1)*cos(theta(0)) + d1 * cos(theta(1) + theta(0)) - (L1 + L2 + L3 + La0)*sin(theta(0)));
-            DF(0, 1) = 2.0*d1*(-(L1 + L2 + L3 + La0)*cos(theta(1)) + d0 * cos(theta(1) + theta(0)) - (L4 + La1)*sin(theta(1)));
-            DF(0, 2) = 0.0;
-            DF(1, 0) = 0.0;
-            DF(1, 1) = 2.0*d1*(-(L1 + L2)*cos(theta(1)) - d2 * sin(theta(1) - theta(2)) - (L4 - L5 + La1 - La2)*sin(theta(1)));
-            DF(1, 2) = 2.0*d2*((L1 + L2)*cos(theta(2)) + d1 * sin(theta(1) - theta(2)) + (L4 - L5 + La1 - La2)*sin(theta(2)));
-            DF(2, 0) = 2.0*d0*(-(L5 + La2)*cos(theta(0)) + d2 * cos(theta(2) + theta(0)) - (L3 + La0)*sin(theta(0)));
-            DF(2, 1) = 0.0;
-            DF(2, 2) = 2.0*d2*(-(L3 + La0)*cos(theta(2)) + d0 * cos(theta(2) + theta(0)) - (L5 + La2)*sin(theta(2)));
-
-            // Newtons method
-            dTheta = F / DF;
-            theta -= dTheta;
-            iter++;
-        } while ((dTheta.Norm() >= tol) && (iter <= maxIter));
-
-        // issue warning if iteration did not converge
-        if (iter >= maxIter) {
-            opserr << "WARNING ESThreeActuatorsJntOff::transfDaqDisp() - "
-                << "did not find the angle theta after "
-                << iter << " iterations and norm: " << dTheta.Norm() << endln;
-        }
-
-        d(2) = atan2(d2*cos(theta(2)) + La1 + L4 - L5 - La2 - d1 * cos(theta(1)), -d2 * sin(theta(2)) + L1 + L2 + d1 * sin(theta(1))) - atan2(L4 - L5, L1 + L2);
-        double R0 = sqrt(L1*L1 + L4 * L4);
-        double beta0 = atan2(L4, L1) + d(2);
-        d(0) = -d1 * sin(theta(1)) + R0 * cos(beta0) - L1;
-        d(1) = d1 * cos(theta(1)) + R0 * sin(beta0) - La1 - L4;
+    // nonlinear geometry, solved with Newton's method that is started
+    // from the solution of the last step
+    else  {
+        theKinematics.transfDispInv(*dDisp, d);
     }
     
     // assemble directions
@@ -607,22 +403,22 @@ int ESThreeActuatorsJntOff::transfDaqDisp(Vector* disp)
 
 int ESThreeActuatorsJntOff::transfDaqVel(Vector* vel)
 {
-    static Vector v(numDOF);
+    static thread_local Vector v(numDOF);
     
     // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0, "left") == 0) {
+    if (geometry == ES_linearLeft) {
         v(0) = (*dVel)(0);
         v(1) = 1.0 / (L1 + L2)*(L2*(*dVel)(1) + L1 * (*dVel)(2));
         v(2) = 1.0 / (L1 + L2)*(-(*dVel)(1) + (*dVel)(2));
     }
     // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0, "right") == 0) {
+    else if (geometry == ES_linearRight) {
         v(0) = -(*dVel)(0);
         v(1) = 1.0 / (L1 + L2)*(L2*(*dVel)(1) + L1 * (*dVel)(2));
         v(2) = 1.0 / (L1 + L2)*(-(*dVel)(1) + (*dVel)(2));
     }
     // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0, "left") == 0) {
+    else if (geometry == ES_nonlinearLeft) {
         if (firstWarning[1] == true) {
             opserr << "WARNING ESThreeActuatorsJntOff::transfDaqVel() - "
                 << "nonlinear geometry with horizontal actuator left "
@@ -634,7 +430,7 @@ int ESThreeActuatorsJntOff::transfDaqVel(Vector* vel)
         v(2) = 1.0 / (L1 + L2)*(-(*dVel)(1) + (*dVel)(2));
     }
     // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0, "right") == 0) {
+    else if (geometry == ES_nonlinearRight) {
         if (firstWarning[1] == true) {
             opserr << "WARNING ESThreeActuatorsJntOff::transfDaqVel() - "
                 << "nonlinear geometry with horizontal actuator right "
@@ -657,22 +453,22 @@ int ESThreeActuatorsJntOff::transfDaqVel(Vector* vel)
 
 int ESThreeActuatorsJntOff::transfDaqAccel(Vector* accel)
 {
-    static Vector a(numDOF);
+    static thread_local Vector a(numDOF);
     
     // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0, "left") == 0) {
+    if (geometry == ES_linearLeft) {
         a(0) = (*dAccel)(0);
         a(1) = 1.0 / (L1 + L2)*(L2*(*dAccel)(1) + L1 * (*dAccel)(2));
         a(2) = 1.0 / (L1 + L2)*(-(*dAccel)(1) + (*dAccel)(2));
     }
     // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0, "right") == 0) {
+    else if (geometry == ES_linearRight) {
         a(0) = -(*dAccel)(0);
         a(1) = 1.0 / (L1 + L2) * (L2*(*dAccel)(1) + L1 * (*dAccel)(2));
         a(2) = 1.0 / (L1 + L2) * (-(*dAccel)(1) + (*dAccel)(2));
     }
     // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0, "left") == 0) {
+    else if (geometry == ES_nonlinearLeft) {
         if (firstWarning[2] == true) {
             opserr << "WARNING ESThreeActuatorsJntOff::transfDaqAccel() - "
                 << "nonlinear geometry with horizontal actuator left "
@@ -684,7 +480,7 @@ int ESThreeActuatorsJntOff::transfDaqAccel(Vector* accel)
         a(2) = 1.0 / (L1 + L2)*(-(*dAccel)(1) + (*dAccel)(2));
     }
     // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0, "right") == 0) {
+    else if (geometry == ES_nonlinearRight) {
         if (firstWarning[2] == true) {
             opserr << "WARNING ESThreeActuatorsJntOff::transfDaqAccel() - "
                 << "nonlinear geometry with horizontal actuator right "
@@ -707,143 +503,26 @@ int ESThreeActuatorsJntOff::transfDaqAccel(Vector* accel)
 
 int ESThreeActuatorsJntOff::transfDaqForce(Vector* force)
 {
-    static Vector f(numDOF);
+    static thread_local Vector f(numDOF);
     
     // linear geometry, horizontal actuator left
-    if (nlGeom == 0 && strcmp(posAct0, "left") == 0) {
+    if (geometry == ES_linearLeft) {
         f(0) = (*dForce)(0);
         f(1) = (*dForce)(1) + (*dForce)(2);
         f(2) = -L1 * (*dForce)(1) + L2 * (*dForce)(2);
     }
     // linear geometry, horizontal actuator right
-    else if (nlGeom == 0 && strcmp(posAct0, "right") == 0) {
+    else if (geometry == ES_linearRight) {
         f(0) = -(*dForce)(0);
         f(1) = (*dForce)(1) + (*dForce)(2);
         f(2) = -L1 * (*dForce)(1) + L2 * (*dForce)(2);
     }
-    // nonlinear geometry, horizontal actuator left
-    else if (nlGeom == 1 && strcmp(posAct0, "left") == 0) {
-        Vector F(3), theta(3), dTheta(3);
-        Matrix DF(3, 3);
-        int iter = 0;
-        int maxIter = 15;
-        double tol = 1E-9;
-
-        double d0 = La0 + (*dDisp)(0);
-        double d1 = La1 + (*dDisp)(1);
-        double d2 = La2 + (*dDisp)(2);
-
-        theta(0) = (*dDisp)(1) / La0;
-        theta(1) = (*dDisp)(0) / La1;
-        theta(2) = (*dDisp)(0) / La2;
-
-        do {
-            F(0) = L0 * L0 + L4 * L4 - pow(d0*cos(theta(0)) - La0 - L0 - d1 * sin(theta(1)), 2.0) - pow(d0*sin(theta(0)) + La1 + L4 - d1 * cos(theta(1)), 2.0);
-            F(1) = pow(L1 + L2, 2.0) + pow(L4 - L5, 2.0) - pow(d2*sin(theta(2)) + L1 + L2 - d1 * sin(theta(1)), 2.0) - pow(d2*cos(theta(2)) + La1 + L4 - L5 - La2 - d1 * cos(theta(1)), 2.0);
-            F(2) = pow(L0 + L1 + L2, 2.0) + L5 * L5 - pow(d0*cos(theta(0)) - La0 - L0 - d2 * sin(theta(2)) - L1 - L2, 2.0) - pow(d0*sin(theta(0)) + La2 + L5 - d2 * cos(theta(2)), 2.0);
-
-            DF(0, 0) = 2.0*d0*(-(L4 + La1)*cos(theta(0)) + d1 * cos(theta(1) + theta(0)) - (L0 + La0)*sin(theta(0)));
-            DF(0, 1) = 2.0*d1*(-(L0 + La0)*cos(theta(1)) + d0 * cos(theta(1) + theta(0)) - (L4 + La1)*sin(theta(1)));
-            DF(0, 2) = 0.0;
-            DF(1, 0) = 0.0;
-            DF(1, 1) = 2.0*d1*((L1 + L2)*cos(theta(1)) - d2 * sin(theta(1) - theta(2)) - (L4 - L5 + La1 - La2)*sin(theta(1)));
-            DF(1, 2) = 2.0*d2*(-(L1 + L2)*cos(theta(2)) + d1 * sin(theta(1) - theta(2)) + (L4 - L5 + La1 - La2)*sin(theta(2)));
-            DF(2, 0) = 2.0*d0*(-(L5 + La2)*cos(theta(0)) + d2 * cos(theta(2) + theta(0)) - (L0 + L1 + L2 + La0)*sin(theta(0)));
-            DF(2, 1) = 0.0;
-            DF(2, 2) = 2.0*d2*(-(L0 + L1 + L2 + La0)*cos(theta(2)) + d0 * cos(theta(2) + theta(0)) - (L5 + La2)*sin(theta(2)));
-
-            // Newtons method
-            dTheta = F / DF;
-            theta -= dTheta;
-            iter++;
-        } while ((dTheta.Norm() >= tol) && (iter <= maxIter));
-
-        // issue warning if iteration did not converge
-        if (iter >= maxIter) {
-            opserr << "WARNING ESThreeActuatorsJntOff::transfDaqForce() - "
-                << "did not find the angle theta after "
-                << iter << " iterations and norm: " << dTheta.Norm() << endln;
-        }
-
-        double disp2 = atan2(d2*cos(theta(2)) + La1 + L4 - L5 - La2 - d1 * cos(theta(1)), d2*sin(theta(2)) + L1 + L2 - d1 * sin(theta(1))) - atan2(L4 - L5, L1 + L2);
-        double R0 = sqrt(L1*L1 + L4 * L4);
-        double R1 = sqrt(L2*L2 + L5 * L5);
-        double beta0 = atan2(L4, L1) + disp2;
-        double beta1 = atan2(L5, L2) - disp2;
-
-        static Vector fx(3), fy(3);
-        fx(0) = (*dForce)(0)*cos(theta(0));
-        fx(1) = (*dForce)(1)*sin(theta(1));
-        fx(2) = (*dForce)(2)*sin(theta(2));
-        fy(0) = (*dForce)(0)*sin(theta(0));
-        fy(1) = (*dForce)(1)*cos(theta(1));
-        fy(2) = (*dForce)(2)*cos(theta(2));
-
-        f(0) = fx(0) + fx(1) + fx(2);
-        f(1) = fy(0) + fy(1) + fy(2);
-        f(2) = fx(0)*(L0 + L1)*sin(disp2) + fx(1)*R0*sin(beta0) + fx(2)*R1*sin(beta1) - fy(0)*(L0 + L1)*cos(disp2) - fy(1)*R0*cos(beta0) + fy(2)*R1*cos(beta1);
-    }
-    // nonlinear geometry, horizontal actuator right
-    else if (nlGeom == 1 && strcmp(posAct0, "right") == 0) {
-        Vector F(3), theta(3), dTheta(3);
-        Matrix DF(3, 3);
-        int iter = 0;
-        int maxIter = 15;
-        double tol = 1E-9;
-
-        double d0 = La0 + (*dDisp)(0);
-        double d1 = La1 + (*dDisp)(1);
-        double d2 = La2 + (*dDisp)(2);
-
-        theta(0) = (*dDisp)(2) / La0;
-        theta(1) = (*dDisp)(0) / La1;
-        theta(2) = (*dDisp)(0) / La2;
-
-        do {
-            F(0) = pow(L1 + L2 + L3, 2.0) + L4 * L4 - pow(-d0 * cos(theta(0)) + La0 + L1 + L2 + L3 + d1 * sin(theta(1)), 2.0) - pow(d0*sin(theta(0)) + La1 + L4 - d1 * cos(theta(1)), 2.0);
-            F(1) = pow(L1 + L2, 2.0) + pow(L4 - L5, 2.0) - pow(-d2 * sin(theta(2)) + L1 + L2 + d1 * sin(theta(1)), 2.0) - pow(d2*cos(theta(2)) + La1 + L4 - L5 - La2 - d1 * cos(theta(1)), 2.0);
-            F(2) = L3 * L3 + L5 * L5 - pow(-d0 * cos(theta(0)) + La0 + L3 + d2 * sin(theta(2)), 2.0) - pow(d0*sin(theta(0)) + La2 + L5 - d2 * cos(theta(2)), 2.0);
-
-            DF(0, 0) = 2.0*d0*(-(L4 + La1)*cos(theta(0)) + d1 * cos(theta(1) + theta(0)) - (L1 + L2 + L3 + La0)*sin(theta(0)));
-            DF(0, 1) = 2.0*d1*(-(L1 + L2 + L3 + La0)*cos(theta(1)) + d0 * cos(theta(1) + theta(0)) - (L4 + La1)*sin(theta(1)));
-            DF(0, 2) = 0.0;
-            DF(1, 0) = 0.0;
-            DF(1, 1) = 2.0*d1*(-(L1 + L2)*cos(theta(1)) - d2 * sin(theta(1) - theta(2)) - (L4 - L5 + La1 - La2)*sin(theta(1)));
-            DF(1, 2) = 2.0*d2*((L1 + L2)*cos(theta(2)) + d1 * sin(theta(1) - theta(2)) + (L4 - L5 + La1 - La2)*sin(theta(2)));
-            DF(2, 0) = 2.0*d0*(-(L5 + La2)*cos(theta(0)) + d2 * cos(theta(2) + theta(0)) - (L3 + La0)*sin(theta(0)));
-            DF(2, 1) = 0.0;
-            DF(2, 2) = 2.0*d2*(-(L3 + La0)*cos(theta(2)) + d0 * cos(theta(2) + theta(0)) - (L5 + La2)*sin(theta(2)));
-
-            // Newtons method
-            dTheta = F / DF;
-            theta -= dTheta;
-            iter++;
-        } while ((dTheta.Norm() >= tol) && (iter <= maxIter));
-
-        // issue warning if iteration did not converge
-        if (iter >= maxIter) {
-            opserr << "WARNING ESThreeActuatorsJntOff::transfDaqForce() - "
-                << "did not find the angle theta after "
-                << iter << " iterations and norm: " << dTheta.Norm() << endln;
-        }
-
-        double disp2 = atan2(d2*cos(theta(2)) + La1 + L4 - L5 - La2 - d1 * cos(theta(1)), -d2 * sin(theta(2)) + L1 + L2 + d1 * sin(theta(1))) - atan2(L4 - L5, L1 + L2);
-        double R0 = sqrt(L1*L1 + L4 * L4);
-        double R1 = sqrt(L2*L2 + L5 * L5);
-        double beta0 = atan2(L4, L1) + disp2;
-        double beta1 = atan2(L5, L2) - disp2;
-
-        static Vector fx(3), fy(3);
-        fx(0) = (*dForce)(0)*cos(theta(0));
-        fx(1) = (*dForce)(1)*sin(theta(1));
-        fx(2) = (*dForce)(2)*sin(theta(2));
-        fy(0) = (*dForce)(0)*sin(theta(0));
-        fy(1) = (*dForce)(1)*cos(theta(1));
-        fy(2) = (*dForce)(2)*cos(theta(2));
-
-        f(0) = -fx(0) - fx(1) - fx(2);
-        f(1) = fy(0) + fy(1) + fy(2);
-        f(2) = fx(0)*(L2 + L3)*sin(disp2) - fx(1)*R0*sin(beta0) - fx(2)*R1*sin(beta1) + fy(0)*(L2 + L3)*cos(disp2) - fy(1)*R0*cos(beta0) + fy(2)*R1*cos(beta1);
+    // nonlinear geometry, the actuator forces are transformed with
+    // the Jacobian at the daq displacements
+    else  {
+        static thread_local Vector d(numDOF);
+        theKinematics.transfDispInv(*dDisp, d);
+        theKinematics.transfForce(d, *dForce, f);
     }
     
     // assemble directions
@@ -855,6 +534,12 @@ int ESThreeActuatorsJntOff::transfDaqForce(Vector* force)
 }
 
 
+const Vector* ESThreeActuatorsJntOff::getDaqSolverInfo()
+{
+    return &theKinematics.getSolverInfo();
+}
+
+
 int ESThreeActuatorsJntOff::transfDaqTime(Vector* time)
 {  
     *time = *dTime;
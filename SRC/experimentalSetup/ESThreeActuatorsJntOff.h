@@ -32,6 +32,7 @@
 // and one rotational degree of freedom of a specimen.
 
 #include "ExperimentalSetup.h"
+#include "ActuatorKinematics2d.h"
 
 #include <Matrix.h>
 
@@ -81,6 +82,8 @@ protected:
     virtual int transfDaqForce(Vector* force);
     virtual int transfDaqTime(Vector* time);
     
+    virtual const Vector *getDaqSolverInfo();
+    
 private:
     // private tranformation methods
     virtual int transfTrialVel(const Vector* disp,
@@ -103,6 +106,9 @@ private:
     double L5;          // rigid link length 5
     int nlGeom;         // non-linear geometry (0: linear, 1: nonlinear)
     char posAct0[6];    // position of actuator 0 (left, right)
+    int geometry;       // geometry resolved from nlGeom and posAct0
+    
+    ActuatorKinematics2d theKinematics;  // actuator kinematics
     
     bool firstWarning[3];
 };
@@ -42,10 +42,20 @@ ESTwoActuators2d::ESTwoActuators2d(int tag,
     int nlgeom, char *posact, double philocx)
     : ExperimentalSetup(tag, control),
     La0(actLength0), La1(actLength1), L(rigidLength),
-    nlGeom(nlgeom), phiLocX(philocx), rotLocX(3,3)
+    nlGeom(nlgeom), phiLocX(philocx), rotLocX(3,3),
+    theKinematics(2, nlgeom)
 {
     strcpy(posAct,posact);
 
+    // resolve the geometry once, so that the transformations
+    // do not have to compare strings
+    geometry = ActuatorKinematics2d::getGeometry(nlGeom, posAct);
+    if (geometry < 0)  {
+        opserr << "ESTwoActuators2d::ESTwoActuators2d()"
+            << " - invalid nlGeom or posAct\n";
+        exit(OF_ReturnType_failed);
+    }
+
     // call setup method
     this->setup();
 }
@@ -53,7 +63,7 @@ ESTwoActuators2d::ESTwoActuators2d(int tag,
 
 ESTwoActuators2d::ESTwoActuators2d(const ESTwoActuators2d& es)
     : ExperimentalSetup(es),
-    rotLocX(3,3)
+    rotLocX(3,3), theKinematics(es.theKinematics)
 {
     La0     = es.La0;
     La1     = es.La1;
@@ -61,6 +71,7 @@ ESTwoActuators2d::ESTwoActuators2d(const ESTwoActuators2d& es)
     nlGeom  = es.nlGeom;
     phiLocX = es.phiLocX;
     strcpy(posAct,es.posAct);
+    geometry = es.geometry;
 
     // call setup method
     this->setup();
@@ -106,6 +117,15 @@ int ESTwoActuators2d::setup()
     rotLocX(1,0) = sin(phiLocX/180.0*pi); rotLocX(1,1) =  cos(phiLocX/180.0*pi);
     rotLocX(2,2) = 1.0;
     
+    // setup the actuator kinematics with the joint offsets from the
+    // control point and the directions from the bases to the joints,
+    // actuator 0 stays aligned with the rigid link guide
+    double nx = 1.0;
+    if (geometry == ES_linearRight || geometry == ES_nonlinearRight)
+        nx = -1.0;
+    theKinematics.setActuator(0, 0.0, 0.0, nx, 0.0, 0.0);
+    theKinematics.setActuator(1, 0.0, L, nx, 0.0, La1);
+    
     return OF_ReturnType_completed;
 }
 
@@ -183,39 +203,16 @@ void ESTwoActuators2d::Print(OPS_Stream &s, int flag)
 
 
 int ESTwoActuators2d::transfTrialDisp(const Vector* disp)
-{  
+{
     // rotate direction
-    static Vector d(3);
-    d = rotLocX*(*disp);
-
-    // linear geometry, actuators left
-    if (nlGeom == 0 && strcmp(posAct,"left") == 0)  {
-        // actuator 0
-        (*cDisp)(0) = d(0);
-        // actuator 1
-        (*cDisp)(1) = d(0) - L*d(2);
-    }
-    // linear geometry, actuators right
-    else if (nlGeom == 0 && strcmp(posAct,"right") == 0)  {
-        // actuator 0
-        (*cDisp)(0) = -d(0);
-        // actuator 1
-        (*cDisp)(1) = -d(0) + L*d(2);
-    }
-    // nonlinear geometry, actuators left
-    else if (nlGeom == 1 && strcmp(posAct,"left") == 0)  {
-        // actuator 0
-        (*cDisp)(0) = d(0);
-        // actuator 1
-        (*cDisp)(1) = pow(pow(d(0)-L*sin(d(2))+La1,2.0)+pow(L*cos(d(2))-L,2.0),0.5)-La1;
-    }
-    // nonlinear geometry, actuators right
-    else if (nlGeom == 1 && strcmp(posAct,"right") == 0)  {
-        // actuator 0
-        (*cDisp)(0) = -d(0);
-        // actuator 1
-        (*cDisp)(1) = pow(pow(-d(0)+L*sin(d(2))+La1,2.0)+pow(L*cos(d(2))-L,2.0),0.5)-La1;
-    }
+    static thread_local Vector d(3);
+    d.addMatrixVector(0.0, rotLocX, *disp, 1.0);
+    
+    // vertical direction is not controlled
+    d(1) = 0.0;
+    
+    // actuator displacements from the kinematics
+    theKinematics.transfDisp(d, *cDisp);
     
     return OF_ReturnType_completed;
 }
@@ -229,40 +226,19 @@ int ESTwoActuators2d::transfTrialVel(const Vector* vel)
 
 int ESTwoActuators2d::transfTrialVel(const Vector* disp,
     const Vector* vel)
-{  
+{
     // rotate direction
-    static Vector d(3), v(3);
-    d = rotLocX*(*disp);
-    v = rotLocX*(*vel);
-
-    // linear geometry, actuators left
-    if (nlGeom == 0 && strcmp(posAct,"left") == 0)  {
-        // actuator 0
-        (*cVel)(0) = v(0);
-        // actuator 1
-        (*cVel)(1) = v(0) - L*v(2);
-    }
-    // linear geometry, actuators right
-    else if (nlGeom == 0 && strcmp(posAct,"right") == 0)  {
-        // actuator 0
-        (*cVel)(0) = -v(0);
-        // actuator 1
-        (*cVel)(1) = -v(0) + L*v(2);
-    }
-    // nonlinear geometry, actuators left
-    else if (nlGeom == 1 && strcmp(posAct,"left") == 0)  {
-        // actuator 0
-        (*cVel)(0) = v(0);
-        // actuator 1
-        (*cVel)(1) = 0.5*(2.0*(d(0)-L*sin(d(2))+La1)*(v(0)-L*cos(d(2))*v(2))-2.0*(L*cos(d(2))-L)*L*sin(d(2))*v(2))/pow(pow(d(0)-L*sin(d(2))+La1,2.0)+pow(L*cos(d(2))-L,2.0),0.5);
-    }
-    // nonlinear geometry, actuators right
-    else if (nlGeom == 1 && strcmp(posAct,"right") == 0)  {
-        // actuator 0
-        (*cVel)(0) = -v(0);
-        // actuator 1
-        (*cVel)(1) = 0.5*(2.0*(-d(0)+L*sin(d(2))+La1)*(-v(0)+L*cos(d(2))*v(2))-2.0*(L*cos(d(2))-L)*L*sin(d(2))*v(2))/pow(pow(-d(0)+L*sin(d(2))+La1,2.0)+pow(L*cos(d(2))-L,2.0),0.5);
-    }
+    static thread_local Vector d(3), v(3);
+    d.addMatrixVector(0.0, rotLocX, *disp, 1.0);
+    v.addMatrixVector(0.0, rotLocX, *vel, 1.0);
+    
+    // vertical direction is not controlled
+    d(1) = 0.0;
+    v(1) = 0.0;
+    
+    // actuator velocities from the kinematics, which are
+    // reused from transfTrialDisp for the same displacements
+    theKinematics.transfVel(d, v, *cVel);
     
     return OF_ReturnType_completed;
 }
@@ -277,41 +253,21 @@ int ESTwoActuators2d::transfTrialAccel(const Vector* accel)
 int ESTwoActuators2d::transfTrialAccel(const Vector* disp,
     const Vector* vel,
     const Vector* accel)
-{  
+{
     // rotate direction
-    static Vector d(3), v(3), a(3);
-    d = rotLocX*(*disp);
-    v = rotLocX*(*vel);
-    a = rotLocX*(*accel);
-
-    // linear geometry, actuators left
-    if (nlGeom == 0 && strcmp(posAct,"left") == 0)  {
-        // actuator 0
-        (*cAccel)(0) = a(0);
-        // actuator 1
-        (*cAccel)(1) = a(0) - L*a(2);
-    }
-    // linear geometry, actuators right
-    else if (nlGeom == 0 && strcmp(posAct,"right") == 0)  {
-        // actuator 0
-        (*cAccel)(0) = -a(0);
-        // actuator 1
-        (*cAccel)(1) = -a(0) + L*a(2);
-    }
-    // nonlinear geometry, actuators left
-    else if (nlGeom == 1 && strcmp(posAct,"left") == 0)  {
-        // actuator 0
-        (*cAccel)(0) = a(0);
-        // actuator 1
-        (*cAccel)(1) = -0.25*pow(2.0*(d(0)-L*sin(d(2))+La1)*(v(0)-L*cos(d(2))*v(2))-2.0*(L*cos(d(2))-L)*L*sin(d(2))*v(2),2.0)/pow(pow(d(0)-L*sin(d(2))+La1,2.0)+pow(L*cos(d(2))-L,2.0),1.5)+0.5*(2.0*pow(v(0)-L*cos(d(2))*v(2),2.0)+2.0*(d(0)-L*sin(d(2))+La1)*(a(0)+L*sin(d(2))*pow(v(2),2.0)-L*cos(d(2))*a(2))+2.0*pow(L*sin(d(2))*v(2),2.0)-2.0*(L*cos(d(2))-L)*L*cos(d(2))*pow(v(2),2.0)-2.0*(L*cos(d(2))-L)*L*sin(d(2))*a(2))/pow(pow(d(0)-L*sin(d(2))+La1,2.0)+pow(L*cos(d(2))-L,2.0),0.5);
-    }
-    // nonlinear geometry, actuators right
-    else if (nlGeom == 1 && strcmp(posAct,"right") == 0)  {
-        // actuator 0
-        (*cAccel)(0) = -a(0);
-        // actuator 1
-        (*cAccel)(1) = -0.25*pow(2.0*(-d(0)+L*sin(d(2))+La1)*(-v(0)+L*cos(d(2))*v(2))-2.0*(L*cos(d(2))-L)*L*sin(d(2))*v(2),2.0)/pow(pow(-d(0)+L*sin(d(2))+La1,2.0)+pow(L*cos(d(2))-L,2.0),1.5)+0.5*(2.0*pow(-v(0)+L*cos(d(2))*v(2),2.0)+2.0*(-d(0)+L*sin(d(2))+La1)*(-a(0)-L*sin(d(2))*pow(v(2),2.0)+L*cos(d(2))*a(2))+2.0*pow(L*sin(d(2))*v(2),2.0)-2.0*(L*cos(d(2))-L)*L*cos(d(2))*pow(v(2),2.0)-2.0*(L*cos(d(2))-L)*L*sin(d(2))*a(2))/pow(pow(-d(0)+L*sin(d(2))+La1,2.0)+pow(L*cos(d(2))-L,2.0),0.5);
-    }
+    static thread_local Vector d(3), v(3), a(3);
+    d.addMatrixVector(0.0, rotLocX, *disp, 1.0);
+    v.addMatrixVector(0.0, rotLocX, *vel, 1.0);
+    a.addMatrixVector(0.0, rotLocX, *accel, 1.0);
+    
+    // vertical direction is not controlled
+    d(1) = 0.0;
+    v(1) = 0.0;
+    a(1) = 0.0;
+    
+    // actuator accelerations from the kinematics, which are
+    // reused from transfTrialDisp for the same displacements
+    theKinematics.transfAccel(d, v, a, *cAccel);
     
     return OF_ReturnType_completed;
 }
@@ -320,25 +276,25 @@ int ESTwoActuators2d::transfTrialAccel(const Vector* disp,
 int ESTwoActuators2d::transfTrialForce(const Vector* force)
 {  
     // rotate direction
-    static Vector f(3);
-    f = rotLocX*(*force);
+    static thread_local Vector f(3);
+    f.addMatrixVector(0.0, rotLocX, *force, 1.0);
 
     // linear geometry, actuators left
-    if (nlGeom == 0 && strcmp(posAct,"left") == 0)  {
+    if (geometry == ES_linearLeft)  {
         // actuator 0
         (*cForce)(0) = f(0) + 1.0/L*f(2);
         // actuator 1
         (*cForce)(1) = -1.0/L*f(2);
     }
     // linear geometry, actuators right
-    else if (nlGeom == 0 && strcmp(posAct,"right") == 0)  {
+    else if (geometry == ES_linearRight)  {
         // actuator 0
         (*cForce)(0) = -f(0) - 1.0/L*f(2);
         // actuator 1
         (*cForce)(1) = 1.0/L*f(2);
     }
     // nonlinear geometry, actuators left
-    else if (nlGeom == 1 && strcmp(posAct,"left") == 0)  {
+    else if (geometry == ES_nonlinearLeft)  {
         if (firstWarning[0] == true)  {
             opserr << "ESTwoActuators2d::transfTrialForce() - "
                 << "nonlinear geometry with actuators left not "
@@ -351,7 +307,7 @@ int ESTwoActuators2d::transfTrialForce(const Vector* force)
         (*cForce)(1) = -1.0/L*f(2);
     }
     // nonlinear geometry, actuators right
-    else if (nlGeom == 1 && strcmp(posAct,"right") == 0)  {
+    else if (geometry == ES_nonlinearRight)  {
         if (firstWarning[0] == true)  {
             opserr << "ESTwoActuators2d::transfTrialForce() - "
                 << "nonlinear geometry with actuators right not "
@@ -379,19 +335,19 @@ int ESTwoActuators2d::transfTrialTime(const Vector* time)
 int ESTwoActuators2d::transfDaqDisp(Vector* disp)
 {
     // linear geometry, actuators left
-    if (nlGeom == 0 && strcmp(posAct,"left") == 0)  {
+    if (geometry == ES_linearLeft)  {
         (*disp)(0) = (*dDisp)(0);
         (*disp)(1) = 0.0;
         (*disp)(2) = 1.0/L*((*dDisp)(0) - (*dDisp)(1));
     }
     // linear geometry, actuators right
-    else if (nlGeom == 0 && strcmp(posAct,"right") == 0)  {
+    else if (geometry == ES_linearRight)  {
         (*disp)(0) = -(*dDisp)(0);
         (*disp)(1) = 0.0;
         (*disp)(2) = 1.0/L*(-(*dDisp)(0) + (*dDisp)(1));
     }
     // nonlinear geometry, actuators left
-    else if (nlGeom == 1 && strcmp(posAct,"left") == 0)  {
+    else if (geometry == ES_nonlinearLeft)  {
         double d0 = La1 + (*dDisp)(0);
         double d1 = La1 + (*dDisp)(1);
 
@@ -400,7 +356,7 @@ int ESTwoActuators2d::transfDaqDisp(Vector* disp)
         (*disp)(2) = atan2(d0,L) - acos((d1*d1-2*L*L-d0*d0)/(-2*L*pow(L*L+d0*d0,0.5)));
     }
     // nonlinear geometry, actuators right
-    else if (nlGeom == 1 && strcmp(posAct,"right") == 0)  {
+    else if (geometry == ES_nonlinearRight)  {
         double d0 = La1 + (*dDisp)(0);
         double d1 = La1 + (*dDisp)(1);
 
@@ -421,19 +377,19 @@ int ESTwoActuators2d::transfDaqDisp(Vector* disp)
 int ESTwoActuators2d::transfDaqVel(Vector* vel)
 {
     // linear geometry, actuators left
-    if (nlGeom == 0 && strcmp(posAct,"left") == 0)  {
+    if (geometry == ES_linearLeft)  {
         (*vel)(0) = (*dVel)(0);
         (*vel)(1) = 0.0;
         (*vel)(2) = 1.0/L*((*dVel)(0) - (*dVel)(1));
     }
     // linear geometry, actuators right
-    else if (nlGeom == 0 && strcmp(posAct,"right") == 0)  {
+    else if (geometry == ES_linearRight)  {
         (*vel)(0) = -(*dVel)(0);
         (*vel)(1) = 0.0;
         (*vel)(2) = 1.0/L*(-(*dVel)(0) + (*dVel)(1));
     }
     // nonlinear geometry, actuators left
-    else if (nlGeom == 1 && strcmp(posAct,"left") == 0)  {
+    else if (geometry == ES_nonlinearLeft)  {
         if (firstWarning[1] == true)  {
             opserr << "ESTwoActuators2d::transfDaqVel() - "
                 << "nonlinear geometry with actuator left not "
@@ -445,7 +401,7 @@ int ESTwoActuators2d::transfDaqVel(Vector* vel)
         (*vel)(2) = 1.0/L*((*dVel)(0) - (*dVel)(1));
     }
     // nonlinear geometry, actuators right
-    else if (nlGeom == 1 && strcmp(posAct,"right") == 0)  {
+    else if (geometry == ES_nonlinearRight)  {
         if (firstWarning[1] == true)  {
             opserr << "ESTwoActuators2d::transfDaqVel() - "
                 << "nonlinear geometry with actuator right not "
@@ -469,19 +425,19 @@ int ESTwoActuators2d::transfDaqVel(Vector* vel)
 int ESTwoActuators2d::transfDaqAccel(Vector* accel)
 {
     // linear geometry, actuators left
-    if (nlGeom == 0 && strcmp(posAct,"left") == 0)  {
+    if (geometry == ES_linearLeft)  {
         (*accel)(0) = (*dAccel)(0);
         (*accel)(1) = 0.0;
         (*accel)(2) = 1.0/L*((*dAccel)(0) - (*dAccel)(1));
     }
     // linear geometry, actuators right
-    else if (nlGeom == 0 && strcmp(posAct,"right") == 0)  {
+    else if (geometry == ES_linearRight)  {
         (*accel)(0) = -(*dAccel)(0);
         (*accel)(1) = 0.0;
         (*accel)(2) = 1.0/L*(-(*dAccel)(0) + (*dAccel)(1));
     }
     // nonlinear geometry, actuators left
-    else if (nlGeom == 1 && strcmp(posAct,"left") == 0)  {
+    else if (geometry == ES_nonlinearLeft)  {
         if (firstWarning[2] == true)  {
             opserr << "ESTwoActuators2d::transfDaqAccel() - "
                 << "nonlinear geometry with actuator left not "
@@ -493,7 +449,7 @@ int ESTwoActuators2d::transfDaqAccel(Vector* accel)
         (*accel)(2) = 1.0/L*((*dAccel)(0) - (*dAccel)(1));
     }
     // nonlinear geometry, actuators right
-    else if (nlGeom == 1 && strcmp(posAct,"right") == 0)  {
+    else if (geometry == ES_nonlinearRight)  {
         if (firstWarning[2] == true)  {
             opserr << "ESTwoActuators2d::transfDaqAccel() - "
                 << "nonlinear geometry with actuator right not "
@@ -517,19 +473,19 @@ int ESTwoActuators2d::transfDaqAccel(Vector* accel)
 int ESTwoActuators2d::transfDaqForce(Vector* force)
 {
     // linear geometry, actuators left
-    if (nlGeom == 0 && strcmp(posAct,"left") == 0)  {
+    if (geometry == ES_linearLeft)  {
         (*force)(0) = (*dForce)(0) + (*dForce)(1);
         (*force)(1) = 0.0;
         (*force)(2) = -L*(*dForce)(1);
     }
     // linear geometry, actuators right
-    else if (nlGeom == 0 && strcmp(posAct,"right") == 0)  {
+    else if (geometry == ES_linearRight)  {
         (*force)(0) = -(*dForce)(0) - (*dForce)(1);
         (*force)(1) = 0.0;
         (*force)(2) = L*(*dForce)(1);
     }
     // nonlinear geometry, actuators left
-    else if (nlGeom == 1 && strcmp(posAct,"left") == 0)  {
+    else if (geometry == ES_nonlinearLeft)  {
         double d0 = La1 + (*dDisp)(0);
         double d1 = La1 + (*dDisp)(1);
 
@@ -544,7 +500,7 @@ int ESTwoActuators2d::transfDaqForce(Vector* force)
         (*force)(2) = -fx1*L*cos(disp2) - fy1*L*sin(disp2);
     }
     // nonlinear geometry, actuators right
-    else if (nlGeom == 1 && strcmp(posAct,"right") == 0)  {
+    else if (geometry == ES_nonlinearRight)  {
         double d0 = La1 + (*dDisp)(0);
         double d1 = La1 + (*dDisp)(1);
 
@@ -36,6 +36,7 @@
 // the rotational degree of freedom of a specimen.
 
 #include "ExperimentalSetup.h"
+#include "ActuatorKinematics2d.h"
 
 #include <Matrix.h>
 
@@ -96,10 +97,13 @@ private:
     double L;           // rigid link length
     int nlGeom;         // non-linear geometry (0: linear, 1: nonlinear)
     char posAct[6];     // position of actuators (left, right)
+    int geometry;       // geometry resolved from nlGeom and posAct
     double phiLocX;     // angle of local x axis w.r.t actuator 0 [deg]
     
     Matrix rotLocX;     // rotation matrix
     
+    ActuatorKinematics2d theKinematics;  // actuator kinematics
+    
     bool firstWarning[3];
 };
 
@@ -29,6 +29,7 @@
 // Description: This file contains the implementation of ExperimentalSetup.
 
 #include "ExperimentalSetup.h"
+#include <ExpTiming.h>
 
 
 ExperimentalSetup::ExperimentalSetup(int tag,
@@ -283,6 +284,7 @@ int ExperimentalSetup::setCtrlDaqSize()
     
     if (theControl != 0)  {
         theControl->setSize(*sizeCtrl, *sizeDaq);
+        theControl->setFilterSizes();
         theControl->setup();
     }
     
@@ -439,7 +441,10 @@ int ExperimentalSetup::setTrialResponse(const Vector* disp,
     const Vector* time)
 {
     // transform data
-    this->transfTrialResponse(disp, vel, accel, force, time);
+    {
+        ExpTimer timer(OF_Timing_SetupTrial);
+        this->transfTrialResponse(disp, vel, accel, force, time);
+    }
     
     if (theControl != 0)  {
         int rValue;
@@ -516,6 +521,7 @@ int ExperimentalSetup::getDaqResponse(Vector* disp,
     }
     
     // transform data
+    ExpTimer timer(OF_Timing_SetupDaq);
     this->transfDaqResponse(disp, vel, accel, force, time);
     
     return OF_ReturnType_completed;
@@ -895,6 +901,33 @@ Response* ExperimentalSetup::setResponse(const char **argv, int argc,
         theResponse = new ExpSetupResponse(this, 20, *dTime);
     }
     
+    // iterations of the daq transformations
+    else if (strcmp(argv[0],"daqIter") == 0 ||
+        strcmp(argv[0],"daqIterations") == 0)
+    {
+        const Vector *solverInfo = this->getDaqSolverInfo();
+        if (solverInfo != 0)  {
+            output.tag("ResponseType","daqIter");
+            output.tag("ResponseType","daqNumFailed");
+            theResponse = new ExpSetupResponse(this, 21, *solverInfo);
+        }
+    }
+    
+    // parallel timing
+    else if (strcmp(argv[0],"parallel") == 0 ||
+        strcmp(argv[0],"parallelTime") == 0)
+    {
+        const Vector *parallelInfo = this->getParallelInfo();
+        if (parallelInfo != 0)  {
+            output.tag("ResponseType","numThreads");
+            output.tag("ResponseType","trialWallTime");
+            output.tag("ResponseType","trialSetupTime");
+            output.tag("ResponseType","daqWallTime");
+            output.tag("ResponseType","daqSetupTime");
+            theResponse = new ExpSetupResponse(this, 22, *parallelInfo);
+        }
+    }
+    
     output.endTag();
     
     return theResponse;
@@ -964,6 +997,12 @@ int ExperimentalSetup::getResponse(int responseID, Information &info)
     case 20:  // daq times
         return info.setVector(*dTime);
         
+    case 21:  // iterations of the daq transformations
+        return info.setVector(*this->getDaqSolverInfo());
+        
+    case 22:  // timing of the transformations of aggregated setups
+        return info.setVector(*this->getParallelInfo());
+        
     default:
         return -1;
     }
@@ -1704,3 +1743,17 @@ void ExperimentalSetup::setDaq()
         }
     }
 }
+
+
+const Vector* ExperimentalSetup::getDaqSolverInfo()
+{
+    // setups with closed-form daq transformations have no solver
+    return 0;
+}
+
+
+const Vector* ExperimentalSetup::getParallelInfo()
+{
+    // only aggregated setups transform other setups
+    return 0;
+}
@@ -225,6 +225,15 @@ protected:
     virtual void setOut();
     virtual void setCtrl();
     virtual void setDaq();
+    
+    // method to get the solver information of the daq transformations
+    // (iterations of the last step, number of failed steps), if any
+    virtual const Vector *getDaqSolverInfo();
+    
+    // method to get the timing of the transformations of aggregated
+    // setups (number of threads, wall and setup times of the last
+    // trial and daq transformations), if any
+    virtual const Vector *getParallelInfo();
 };
 
 #endif
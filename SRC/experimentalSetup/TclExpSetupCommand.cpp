@@ -1125,11 +1125,12 @@ int TclExpSetupCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc, argv);
             opserr << "Want: expSetup Aggregator tag <-control ctrlTag> "
-                << "-setup setupTagi ...\n";
+                << "-setup setupTagi ... <-parallel numThreads>\n";
             return TCL_ERROR;
         }
         
         int ctrlTag, numSetups = 0, setupTag, i;
+        int numThreads = 1;
         
         argi = 2;
         if (Tcl_GetInt(interp, argv[argi], &tag) != TCL_OK)  {
@@ -1161,7 +1162,8 @@ int TclExpSetupCommand(ClientData clientData, Tcl_Interp *interp,
         }
         argi++;
         while (argi+numSetups < argc &&
-            strcmp(argv[argi+numSetups],"-sizeTrialOut") != 0)  {
+            strcmp(argv[argi+numSetups],"-sizeTrialOut") != 0 &&
+            strcmp(argv[argi+numSetups],"-parallel") != 0)  {
             numSetups++;
         }
         if (numSetups == 0)  {
@@ -1192,9 +1194,22 @@ int TclExpSetupCommand(ClientData clientData, Tcl_Interp *interp,
             }
             argi++;
         }
+        // read the number of threads
+        for (i = argi; i < argc; i++)  {
+            if (strcmp(argv[i], "-parallel") == 0)  {
+                if (i+1 >= argc ||
+                    Tcl_GetInt(interp, argv[i+1], &numThreads) != TCL_OK ||
+                    numThreads < 1)  {
+                    opserr << "WARNING invalid numThreads\n";
+                    opserr << "expSetup Aggregator " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
+        }
         
         // parsing was successful, allocate the setup
-        theSetup = new ESAggregator(tag, numSetups, expSetups, theControl);
+        theSetup = new ESAggregator(tag, numSetups, expSetups, theControl,
+            numThreads);
         
         // cleanup dynamic memory
         if (expSetups != 0)  {
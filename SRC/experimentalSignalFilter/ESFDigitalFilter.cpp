@@ -0,0 +1,160 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// ESFDigitalFilter.
+
+#include "ESFDigitalFilter.h"
+
+
+ESFDigitalFilter::ESFDigitalFilter(int tag)
+    : ExperimentalSignalFilter(tag),
+    numChannels(0), channel(0), started(false)
+{
+    // does nothing
+}
+
+
+ESFDigitalFilter::ESFDigitalFilter(const ESFDigitalFilter& esf)
+    : ExperimentalSignalFilter(esf),
+    numChannels(0), channel(0), started(false)
+{
+    // the subclasses copy the state
+}
+
+
+ESFDigitalFilter::~ESFDigitalFilter()
+{
+    // does nothing
+}
+
+
+double ESFDigitalFilter::filtering(double data)
+{
+    // the channels are filtered in turn
+    int c = channel;
+    if (++channel == numChannels)
+        channel = 0;
+    
+    if (!started)  {
+        this->initState(c, data);
+        if (channel == 0)
+            started = true;
+    }
+    
+    return this->filterChannel(c, data);
+}
+
+
+Vector& ESFDigitalFilter::converting(Vector* td)
+{
+    opserr << "\nWARNING ESFDigitalFilter::converting(Vector* td) - " << endln
+    << "No conversion performed. The input vector is returned instead." << endln;
+    return *td;
+}
+
+
+Vector& ESFDigitalFilter::converting(Vector* td, Vector* tf)
+{
+    opserr << "\nWARNING ESFDigitalFilter::converting(Vector* td, const Vector* tf) - " << endln
+    << "No conversion performed. The input vector is returned instead." << endln;
+    return *tf;
+}
+
+
+int ESFDigitalFilter::setSize(const int sz)
+{
+    if (sz < 1)  {
+        opserr << "ESFDigitalFilter::setSize() - "
+            << "number of channels must be positive.\n";
+        return OF_ReturnType_failed;
+    }
+    if (sz == numChannels)
+        return OF_ReturnType_completed;
+    
+    numChannels = sz;
+    channel = 0;
+    started = false;
+    
+    return this->allocateState();
+}
+
+
+void ESFDigitalFilter::update()
+{
+    // does nothing
+}
+
+
+Response* ESFDigitalFilter::setResponse(const char **argv,
+    int argc, OPS_Stream &output)
+{
+    Response *theResponse = 0;
+    
+    output.tag("ExpSignalFilterOutput");
+    output.attr("signalFilterType",this->getClassType());
+    output.attr("signalFilterTag",this->getTag());
+    
+    // group delay
+    if (strcmp(argv[0],"groupDelay") == 0)  {
+        output.tag("ResponseType","groupDelay");
+        theResponse = new ExpSignalFilterResponse(this, 1, 0.0);
+    }
+    
+    output.endTag();
+    
+    return theResponse;
+}
+
+
+int ESFDigitalFilter::getResponse(int responseID, Information &info)
+{
+    switch (responseID)  {
+    case 1:  // group delay
+        return info.setDouble(this->getGroupDelay());
+        
+    default:
+        return -1;
+    }
+}
+
+
+int ESFDigitalFilter::prepareStep(const double *in, int nChannels)
+{
+    if (nChannels != numChannels)  {
+        if (this->setSize(nChannels) < 0)
+            return OF_ReturnType_failed;
+    }
+    if (!started)  {
+        for (int c=0; c<numChannels; c++)
+            this->initState(c, in[c]);
+        started = true;
+    }
+    channel = 0;
+    
+    return OF_ReturnType_completed;
+}
@@ -0,0 +1,89 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+#ifndef ESFDigitalFilter_h
+#define ESFDigitalFilter_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ESFDigitalFilter. ESFDigitalFilter is the abstract base class for
+// linear time-invariant digital filters that are applied to the
+// ctrl or daq signals. Each channel has its own filter state, where
+// the number of channels is set through setSize(). The state of a
+// channel is initialized to the steady state of its first sample so
+// that signals with an offset (e.g. load cells) do not start with a
+// transient. The group delay at zero frequency is reported in number
+// of steps so that it can be compensated for.
+
+#include "ExperimentalSignalFilter.h"
+
+class ESFDigitalFilter : public ExperimentalSignalFilter
+{
+public:
+    // constructors
+    ESFDigitalFilter(int tag);
+    ESFDigitalFilter(const ESFDigitalFilter& esf);
+    
+    // destructor
+    virtual ~ESFDigitalFilter();
+    
+    // method to get class type
+    const char *getClassType() const {return "ESFDigitalFilter";};
+    
+    virtual double filtering(double data);
+    virtual int filtering(const double *in, double *out, int nChannels) = 0;
+    virtual Vector& converting(Vector* td);
+    virtual Vector& converting(Vector* td, Vector* tf);
+    virtual int setSize(const int sz);
+    virtual void update();
+    
+    virtual ExperimentalSignalFilter *getCopy() = 0;
+    
+    // method to get the group delay at zero frequency in number of steps
+    virtual double getGroupDelay() = 0;
+    
+    // public methods for experimental signal filter recorder
+    virtual Response *setResponse(const char **argv, int argc,
+        OPS_Stream &output);
+    virtual int getResponse(int responseID, Information &info);
+    
+protected:
+    // methods to allocate the state of all the channels, to set the
+    // state of one channel to the steady state of a constant input
+    // and to filter one sample of one channel
+    virtual int allocateState() = 0;
+    virtual void initState(int c, double x) = 0;
+    virtual double filterChannel(int c, double x) = 0;
+    
+    // method to make sure the state fits nChannels and is initialized
+    int prepareStep(const double *in, int nChannels);
+    
+    int numChannels;    // number of channels
+    int channel;        // channel of the next call to scalar filtering
+    bool started;       // flag if the state has been initialized
+};
+
+#endif
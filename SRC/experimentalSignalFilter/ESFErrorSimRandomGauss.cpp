@@ -34,6 +34,7 @@
 // ESFErrorSimRandomGauss.
 
 #include "ESFErrorSimRandomGauss.h"
+#include <ExpTiming.h>
 
 #include <stdlib.h>
 #include <math.h>
@@ -45,7 +46,7 @@ ESFErrorSimRandomGauss::ESFErrorSimRandomGauss(int tag, double ave, double std)
     mean(ave), sigma(std), idseed(0),
     Pi(atan(1.0)*4.0), sw(0), inext(0), inextp(0),
     MBIG(1000000000), MSEED(161803398), MZ(0), FAC(1.0/MBIG), ma(0),
-    amp(0.0), theta(0.0)
+    amp(0.0), theta(0.0), numChannels(0), noise(0)
 {
     idseed = ((unsigned)time(NULL)) % MBIG;
     ma = new int [56];
@@ -60,7 +61,7 @@ ESFErrorSimRandomGauss::ESFErrorSimRandomGauss(int tag, double ave, double std)
 
 
 ESFErrorSimRandomGauss::ESFErrorSimRandomGauss(const ESFErrorSimRandomGauss& esf)
-    : ESFErrorSimulation(esf)
+    : ESFErrorSimulation(esf), numChannels(0), noise(0)
 {
     data = esf.data;
     mean = esf.mean;
@@ -80,6 +81,9 @@ ESFErrorSimRandomGauss::ESFErrorSimRandomGauss(const ESFErrorSimRandomGauss& esf
     srand(idseed);
     for (int i=0; i<100; i++)
         filtering(0.0);
+    
+    if (esf.numChannels > 0)
+        this->setSize(esf.numChannels);
 }
 
 
@@ -87,6 +91,8 @@ ESFErrorSimRandomGauss::~ESFErrorSimRandomGauss()
 {
     if (ma != 0)
         delete [] ma;
+    if (noise != 0)
+        delete [] noise;
 }
 
 
@@ -99,6 +105,61 @@ double ESFErrorSimRandomGauss::filtering(double d)
 }
 
 
+int ESFErrorSimRandomGauss::filtering(const double *in, double *out,
+    int nChannels)
+{
+    ExpTimer timer(OF_Timing_Filter);
+    
+    if (nChannels > numChannels)  {
+        if (this->setSize(nChannels) < 0)
+            return OF_ReturnType_failed;
+    }
+    
+    // each pair of uniform deviates gives two normal deviates
+    int c;
+    for (c=0; c+1<nChannels; c+=2)  {
+        amp = sqrt(-2 * log(rand3()));
+        theta = 2 * Pi * rand3();
+        noise[c] = amp*cos(theta);
+        noise[c+1] = amp*sin(theta);
+    }
+    if (c < nChannels)  {
+        amp = sqrt(-2 * log(rand3()));
+        theta = 2 * Pi * rand3();
+        noise[c] = amp*cos(theta);
+    }
+    
+    for (c=0; c<nChannels; c++)
+        out[c] = in[c] + mean + sigma*noise[c];
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ESFErrorSimRandomGauss::setSize(const int sz)
+{
+    if (sz < 1)  {
+        opserr << "ESFErrorSimRandomGauss::setSize() - "
+            << "number of channels must be positive.\n";
+        return OF_ReturnType_failed;
+    }
+    if (sz == numChannels)
+        return OF_ReturnType_completed;
+    
+    if (noise != 0)
+        delete [] noise;
+    numChannels = sz;
+    noise = new double [numChannels];
+    if (noise == 0)  {
+        opserr << "ESFErrorSimRandomGauss::setSize() - "
+            << "failed to create noise buffer.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
 void ESFErrorSimRandomGauss::update()
 {
     // does nothing
@@ -55,6 +55,8 @@ public:
     const char *getClassType() const {return "ESFErrorSimRandomGauss";};
     
     virtual double filtering(double data);
+    virtual int filtering(const double *in, double *out, int nChannels);
+    virtual int setSize(const int sz);
     virtual void update();
     
     virtual ExperimentalSignalFilter *getCopy();
@@ -88,6 +90,9 @@ private:
     double FAC;     // = 1/MBIG
     int *ma;        // array ma[56]. The value 56 is special and shouldn't modified.
     double amp, theta;
+    
+    int numChannels;    // size of the noise buffer
+    double *noise;      // standard normal deviates for one step
 };
 
 #endif
@@ -30,45 +30,161 @@
 // ESFErrorSimTimeDelay.
 
 #include "ESFErrorSimTimeDelay.h"
+#include <ExpTiming.h>
 
 #include <math.h>
 
 
-ESFErrorSimTimeDelay::ESFErrorSimTimeDelay(int tag, double error)
+ESFErrorSimTimeDelay::ESFErrorSimTimeDelay(int tag, double d)
     : ESFErrorSimulation(tag),
-    delay(error), data(0.0), predata(0.0)
+    delay(d), numSteps(0), frac(0.0), capacity(0),
+    numChannels(0), channel(0), delayLine(0), head(0), filled(false)
 {
-    // does nothing
+    if (delay < 0.0)  {
+        opserr << "ESFErrorSimTimeDelay::ESFErrorSimTimeDelay() - "
+            << "time delay must be positive.\n";
+        exit(OF_ReturnType_failed);
+    }
+    numSteps = (int)floor(delay);
+    frac = delay - numSteps;
+    capacity = numSteps + 2;
+    
+    // use a single channel until the size is set
+    this->setSize(1);
 }
 
 
 ESFErrorSimTimeDelay::ESFErrorSimTimeDelay(const ESFErrorSimTimeDelay& esf)
-    : ESFErrorSimulation(esf)
+    : ESFErrorSimulation(esf),
+    numChannels(0), channel(0), delayLine(0), head(0), filled(false)
 {
     delay = esf.delay;
-    data = esf.data;
-    predata = esf.predata;
+    numSteps = esf.numSteps;
+    frac = esf.frac;
+    capacity = esf.capacity;
+    
+    this->setSize(esf.numChannels);
+    channel = esf.channel;
+    head = esf.head;
+    filled = esf.filled;
+    for (int i=0; i<capacity*numChannels; i++)
+        delayLine[i] = esf.delayLine[i];
 }
 
 
 ESFErrorSimTimeDelay::~ESFErrorSimTimeDelay()
 {
-    // does nothing
+    if (delayLine != 0)
+        delete [] delayLine;
 }
 
 
 double ESFErrorSimTimeDelay::filtering(double d)
 {
-    data = d;
-    if (d > predata)
-        data -= undershoot;
-    else if (d < predata)
-        data += undershoot;
-    if (fabs(d) < 1.0e-6)
-        data += undershoot;
-    predata = d;
+    // the channels are filtered in turn, a new step starts with
+    // the first channel
+    int c = channel;
+    if (c == 0 && filled)  {
+        if (++head == capacity)
+            head = 0;
+    }
+    if (++channel == numChannels)
+        channel = 0;
+    
+    // the first sample fills the whole line so
+    // that the output does not jump at the start
+    if (!filled)  {
+        for (int i=0; i<capacity; i++)
+            delayLine[i*numChannels+c] = d;
+        if (channel == 0)
+            filled = true;
+    } else  {
+        delayLine[head*numChannels+c] = d;
+    }
+    
+    // interpolate between the samples delayed by numSteps and numSteps+1
+    int i0 = head - numSteps;
+    if (i0 < 0)
+        i0 += capacity;
+    int i1 = (i0 == 0) ? capacity-1 : i0-1;
+    
+    return (1.0-frac)*delayLine[i0*numChannels+c] +
+        frac*delayLine[i1*numChannels+c];
+}
+
+
+int ESFErrorSimTimeDelay::filtering(const double *in, double *out,
+    int nChannels)
+{
+    ExpTimer timer(OF_Timing_Filter);
+    
+    if (nChannels != numChannels)  {
+        if (this->setSize(nChannels) < 0)
+            return OF_ReturnType_failed;
+    }
+    
+    // store the new step
+    int i, c;
+    if (!filled)  {
+        for (i=0; i<capacity; i++)  {
+            double *line = &delayLine[i*numChannels];
+            for (c=0; c<numChannels; c++)
+                line[c] = in[c];
+        }
+        filled = true;
+    } else  {
+        if (++head == capacity)
+            head = 0;
+        double *line = &delayLine[head*numChannels];
+        for (c=0; c<numChannels; c++)
+            line[c] = in[c];
+    }
+    channel = 0;
+    
+    // interpolate between the steps delayed by numSteps and numSteps+1
+    int i0 = head - numSteps;
+    if (i0 < 0)
+        i0 += capacity;
+    int i1 = (i0 == 0) ? capacity-1 : i0-1;
+    const double *line0 = &delayLine[i0*numChannels];
+    const double *line1 = &delayLine[i1*numChannels];
+    const double w0 = 1.0 - frac, w1 = frac;
+    for (c=0; c<numChannels; c++)
+        out[c] = w0*line0[c] + w1*line1[c];
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ESFErrorSimTimeDelay::setSize(const int sz)
+{
+    if (sz < 1)  {
+        opserr << "ESFErrorSimTimeDelay::setSize() - "
+            << "number of channels must be positive.\n";
+        return OF_ReturnType_failed;
+    }
+    if (sz == numChannels)
+        return OF_ReturnType_completed;
+    
+    if (delayLine != 0)
+        delete [] delayLine;
+    
+    numChannels = sz;
+    delayLine = new double [capacity*numChannels];
+    if (delayLine == 0)  {
+        opserr << "ESFErrorSimTimeDelay::setSize() - "
+            << "failed to create delay lines.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    // empty delay lines
+    for (int i=0; i<capacity*numChannels; i++)
+        delayLine[i] = 0.0;
+    channel = 0;
+    head = 0;
+    filled = false;
     
-    return data;
+    return OF_ReturnType_completed;
 }
 
 
@@ -88,5 +204,6 @@ void ESFErrorSimTimeDelay::Print(OPS_Stream &s, int flag)
 {
     s << "Filter: " << this->getTag(); 
     s << "  type: ESFErrorSimTimeDelay\n";
-    s << "  time delay error: " << delay << endln;
+    s << "  time delay: " << delay << " steps\n";
+    s << "  number of channels: " << numChannels << endln;
 }
@@ -30,7 +30,15 @@
 // Revision: A
 //
 // Purpose: This file contains the class definition for 
-// ESFErrorSimTimeDelay.
+// ESFErrorSimTimeDelay. An ESFErrorSimTimeDelay delays each channel
+// of a signal by a fixed number of steps. The integer part of the
+// delay is taken from a circular buffer of fixed capacity and the
+// fractional part is linearly interpolated between the two adjacent
+// samples. Each channel has its own delay line, where the number of
+// channels is set through setSize(). The lines are stored by step so
+// that all the channels of one step are contiguous in memory. The
+// scalar filtering() expects the channels in the same order at each
+// step, the batch filtering() processes one whole step.
 
 #include "ESFErrorSimulation.h"
 
@@ -38,7 +46,7 @@ class ESFErrorSimTimeDelay : public ESFErrorSimulation
 {
 public:
     // constructors
-    ESFErrorSimTimeDelay(int tag, double error);
+    ESFErrorSimTimeDelay(int tag, double delay);
     ESFErrorSimTimeDelay(const ESFErrorSimTimeDelay& esf);
     
     // destructor
@@ -48,6 +56,8 @@ public:
     const char *getClassType() const {return "ESFErrorSimTimeDelay";};
     
     virtual double filtering(double data);
+    virtual int filtering(const double *in, double *out, int nChannels);
+    virtual int setSize(const int sz);
     virtual void update();
     
     virtual ExperimentalSignalFilter *getCopy();
@@ -56,9 +66,16 @@ public:
     void Print(OPS_Stream &s, int flag = 0);
     
 private:
-    double undershoot;
-    double data;
-    double predata;
+    double delay;       // time delay in number of steps
+    int numSteps;       // integer part of the delay
+    double frac;        // fractional part of the delay
+    int capacity;       // length of each delay line
+    
+    int numChannels;    // number of channels
+    int channel;        // channel of the next call to filtering
+    double *delayLine;  // delay lines, capacity x numChannels
+    int head;           // step of the newest samples
+    bool filled;        // flag if the lines hold a first sample
 };
 
 #endif
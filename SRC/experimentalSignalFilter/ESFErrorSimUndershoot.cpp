@@ -34,48 +34,113 @@
 // ESFErrorSimUndershoot.
 
 #include "ESFErrorSimUndershoot.h"
+#include <ExpTiming.h>
 
 #include <math.h>
 
 
 ESFErrorSimUndershoot::ESFErrorSimUndershoot(int tag, double error)
     : ESFErrorSimulation(tag),
-    undershoot(error), data(0.0), predata(0.0)
+    undershoot(error), numChannels(0), channel(0), predata(0)
 {
-    // does nothing
+    // use a single channel until the size is set
+    this->setSize(1);
 }
 
 
 ESFErrorSimUndershoot::ESFErrorSimUndershoot(const ESFErrorSimUndershoot& esf)
-    : ESFErrorSimulation(esf)
+    : ESFErrorSimulation(esf),
+    numChannels(0), channel(0), predata(0)
 {
     undershoot = esf.undershoot;
-    data = esf.data;
-    predata = esf.predata;
+    
+    this->setSize(esf.numChannels);
+    channel = esf.channel;
+    for (int i=0; i<numChannels; i++)
+        predata[i] = esf.predata[i];
 }
 
 
 ESFErrorSimUndershoot::~ESFErrorSimUndershoot()
 {
-    // does nothing
+    if (predata != 0)
+        delete [] predata;
 }
 
 
 double ESFErrorSimUndershoot::filtering(double d)
 {
-    data = d;
-    if (d > predata)
+    // the channels are filtered in turn
+    double &p = predata[channel];
+    if (++channel == numChannels)
+        channel = 0;
+    
+    double data = d;
+    if (d > p)
         data -= undershoot;
-    else if (d < predata)
+    else if (d < p)
         data += undershoot;
     if (fabs(d) < 1.0e-6)
         data += undershoot;
-    predata = d;
+    p = d;
     
     return data;
 }
 
 
+int ESFErrorSimUndershoot::filtering(const double *in, double *out,
+    int nChannels)
+{
+    ExpTimer timer(OF_Timing_Filter);
+    
+    if (nChannels != numChannels)  {
+        if (this->setSize(nChannels) < 0)
+            return OF_ReturnType_failed;
+    }
+    
+    // branch free form of the scalar version
+    for (int c=0; c<numChannels; c++)  {
+        const double d = in[c];
+        const double p = predata[c];
+        double err = (d > p) ? -undershoot : 0.0;
+        err += (d < p) ? undershoot : 0.0;
+        err += (fabs(d) < 1.0e-6) ? undershoot : 0.0;
+        predata[c] = d;
+        out[c] = d + err;
+    }
+    channel = 0;
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ESFErrorSimUndershoot::setSize(const int sz)
+{
+    if (sz < 1)  {
+        opserr << "ESFErrorSimUndershoot::setSize() - "
+            << "number of channels must be positive.\n";
+        return OF_ReturnType_failed;
+    }
+    if (sz == numChannels)
+        return OF_ReturnType_completed;
+    
+    if (predata != 0)
+        delete [] predata;
+    numChannels = sz;
+    predata = new double [numChannels];
+    if (predata == 0)  {
+        opserr << "ESFErrorSimUndershoot::setSize() - "
+            << "failed to create previous data array.\n";
+        exit(OF_ReturnType_failed);
+    }
+    for (int i=0; i<numChannels; i++)
+        predata[i] = 0.0;
+    channel = 0;
+    
+    return OF_ReturnType_completed;
+}
+
+
 void ESFErrorSimUndershoot::update()
 {
     // does nothing
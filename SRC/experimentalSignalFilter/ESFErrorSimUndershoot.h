@@ -34,7 +34,9 @@
 // Revision: A
 //
 // Purpose: This file contains the class definition for 
-// ESFErrorSimUndershoot.
+// ESFErrorSimUndershoot. The previous value of each channel is kept
+// in a separate entry, where the number of channels is set through
+// setSize().
 
 #include "ESFErrorSimulation.h"
 
@@ -52,6 +54,8 @@ public:
     const char *getClassType() const {return "ESFErrorSimUndershoot";};
     
     virtual double filtering(double data);
+    virtual int filtering(const double *in, double *out, int nChannels);
+    virtual int setSize(const int sz);
     virtual void update();
     
     virtual ExperimentalSignalFilter *getCopy();
@@ -61,8 +65,10 @@ public:
     
 private:
     double undershoot;
-    double data;
-    double predata;
+    
+    int numChannels;    // number of channels
+    int channel;        // channel of the next call to filtering
+    double *predata;    // previous value of each channel
 };
 
 #endif
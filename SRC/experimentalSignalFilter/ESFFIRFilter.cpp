@@ -0,0 +1,232 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// ESFFIRFilter.
+
+#include "ESFFIRFilter.h"
+#include <ExpTiming.h>
+
+#include <math.h>
+
+
+ESFFIRFilter::ESFFIRFilter(int tag, const Vector &coefficients)
+    : ESFDigitalFilter(tag),
+    numTaps(0), coeffs(0), history(0), head(0)
+{
+    numTaps = coefficients.Size();
+    if (numTaps == 0)  {
+        opserr << "ESFFIRFilter::ESFFIRFilter() - "
+            << "no filter coefficients specified.\n";
+        exit(OF_ReturnType_failed);
+    }
+    coeffs = new double [numTaps];
+    if (coeffs == 0)  {
+        opserr << "ESFFIRFilter::ESFFIRFilter() - "
+            << "failed to create coefficient array.\n";
+        exit(OF_ReturnType_failed);
+    }
+    for (int i=0; i<numTaps; i++)
+        coeffs[i] = coefficients(i);
+    
+    // use a single channel until the size is set
+    this->setSize(1);
+}
+
+
+ESFFIRFilter::ESFFIRFilter(int tag, int numPoints)
+    : ESFDigitalFilter(tag),
+    numTaps(numPoints), coeffs(0), history(0), head(0)
+{
+    if (numTaps < 1)  {
+        opserr << "ESFFIRFilter::ESFFIRFilter() - "
+            << "number of points must be positive.\n";
+        exit(OF_ReturnType_failed);
+    }
+    coeffs = new double [numTaps];
+    if (coeffs == 0)  {
+        opserr << "ESFFIRFilter::ESFFIRFilter() - "
+            << "failed to create coefficient array.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    // moving average
+    for (int i=0; i<numTaps; i++)
+        coeffs[i] = 1.0/numTaps;
+    
+    // use a single channel until the size is set
+    this->setSize(1);
+}
+
+
+ESFFIRFilter::ESFFIRFilter(const ESFFIRFilter& esf)
+    : ESFDigitalFilter(esf),
+    numTaps(0), coeffs(0), history(0), head(0)
+{
+    int i;
+    numTaps = esf.numTaps;
+    coeffs = new double [numTaps];
+    if (coeffs == 0)  {
+        opserr << "ESFFIRFilter::ESFFIRFilter() - "
+            << "failed to create coefficient array.\n";
+        exit(OF_ReturnType_failed);
+    }
+    for (i=0; i<numTaps; i++)
+        coeffs[i] = esf.coeffs[i];
+    
+    this->setSize(esf.numChannels);
+    channel = esf.channel;
+    started = esf.started;
+    head = esf.head;
+    for (i=0; i<numTaps*numChannels; i++)
+        history[i] = esf.history[i];
+}
+
+
+ESFFIRFilter::~ESFFIRFilter()
+{
+    if (coeffs != 0)
+        delete [] coeffs;
+    if (history != 0)
+        delete [] history;
+}
+
+
+double ESFFIRFilter::filtering(double data)
+{
+    return this->ESFDigitalFilter::filtering(data);
+}
+
+
+int ESFFIRFilter::filtering(const double *in, double *out, int nChannels)
+{
+    ExpTimer timer(OF_Timing_Filter);
+    
+    if (this->prepareStep(in, nChannels) < 0)
+        return OF_ReturnType_failed;
+    
+    // store the new step before out is overwritten
+    int c;
+    if (++head == numTaps)
+        head = 0;
+    double *row = &history[head*numChannels];
+    for (c=0; c<numChannels; c++)
+        row[c] = in[c];
+    
+    // accumulate one tap for all the channels at a time
+    for (c=0; c<numChannels; c++)
+        out[c] = 0.0;
+    int step = head;
+    for (int k=0; k<numTaps; k++)  {
+        const double h = coeffs[k];
+        row = &history[step*numChannels];
+        for (c=0; c<numChannels; c++)
+            out[c] += h*row[c];
+        if (--step < 0)
+            step = numTaps-1;
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+ExperimentalSignalFilter* ESFFIRFilter::getCopy()
+{
+    return new ESFFIRFilter(*this);
+}
+
+
+double ESFFIRFilter::getGroupDelay()
+{
+    // group delay at zero frequency, (numTaps-1)/2
+    // for filters with symmetric coefficients
+    double sumH = 0.0, sumKH = 0.0;
+    for (int k=0; k<numTaps; k++)  {
+        sumH += coeffs[k];
+        sumKH += k*coeffs[k];
+    }
+    if (fabs(sumH) < 1.0e-12)
+        return 0.0;
+    
+    return sumKH/sumH;
+}
+
+
+void ESFFIRFilter::Print(OPS_Stream &s, int flag)
+{
+    s << "Filter: " << this->getTag(); 
+    s << "  type: ESFFIRFilter\n";
+    s << "  number of taps: " << numTaps << endln;
+    s << "  group delay: " << this->getGroupDelay() << " steps\n";
+    s << "  number of channels: " << numChannels << endln;
+}
+
+
+int ESFFIRFilter::allocateState()
+{
+    if (history != 0)
+        delete [] history;
+    
+    history = new double [numTaps*numChannels];
+    if (history == 0)  {
+        opserr << "ESFFIRFilter::allocateState() - "
+            << "failed to create history array.\n";
+        exit(OF_ReturnType_failed);
+    }
+    for (int i=0; i<numTaps*numChannels; i++)
+        history[i] = 0.0;
+    head = 0;
+    
+    return OF_ReturnType_completed;
+}
+
+
+void ESFFIRFilter::initState(int c, double x)
+{
+    // a constant input fills the whole history
+    for (int k=0; k<numTaps; k++)
+        history[k*numChannels+c] = x;
+}
+
+
+double ESFFIRFilter::filterChannel(int c, double x)
+{
+    // a new step starts with the first channel
+    if (c == 0 && ++head == numTaps)
+        head = 0;
+    history[head*numChannels+c] = x;
+    
+    double y = 0.0;
+    int step = head;
+    for (int k=0; k<numTaps; k++)  {
+        y += coeffs[k]*history[step*numChannels+c];
+        if (--step < 0)
+            step = numTaps-1;
+    }
+    
+    return y;
+}
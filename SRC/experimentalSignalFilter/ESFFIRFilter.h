@@ -0,0 +1,76 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+#ifndef ESFFIRFilter_h
+#define ESFFIRFilter_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ESFFIRFilter. An ESFFIRFilter convolves each channel with a finite
+// impulse response h_0 ... h_{n-1}. The input history is stored by
+// step so that all the channels of one step are contiguous in memory
+// and the batch filtering accumulates one tap for all the channels
+// at a time. A moving average is a FIR filter with n equal taps 1/n.
+
+#include "ESFDigitalFilter.h"
+
+class ESFFIRFilter : public ESFDigitalFilter
+{
+public:
+    // constructors
+    ESFFIRFilter(int tag, const Vector &coefficients);
+    ESFFIRFilter(int tag, int numPoints);
+    ESFFIRFilter(const ESFFIRFilter& esf);
+    
+    // destructor
+    virtual ~ESFFIRFilter();
+    
+    // method to get class type
+    const char *getClassType() const {return "ESFFIRFilter";};
+    
+    virtual double filtering(double data);
+    virtual int filtering(const double *in, double *out, int nChannels);
+    
+    virtual ExperimentalSignalFilter *getCopy();
+    
+    virtual double getGroupDelay();
+    
+    // public methods for output
+    void Print(OPS_Stream &s, int flag = 0);
+    
+protected:
+    virtual int allocateState();
+    virtual void initState(int c, double x);
+    virtual double filterChannel(int c, double x);
+    
+private:
+    int numTaps;        // number of coefficients
+    double *coeffs;     // impulse response
+    double *history;    // input history, numTaps x numChannels
+    int head;           // step of the newest input
+};
+
+#endif
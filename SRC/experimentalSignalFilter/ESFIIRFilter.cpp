@@ -0,0 +1,285 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// ESFIIRFilter.
+
+#include "ESFIIRFilter.h"
+#include <ExpTiming.h>
+
+#include <math.h>
+
+
+ESFIIRFilter::ESFIIRFilter(int tag, const Vector &coefficients)
+    : ESFDigitalFilter(tag),
+    numSections(0), coeffs(0), z1(0), z2(0)
+{
+    if (coefficients.Size() == 0 || coefficients.Size()%5 != 0)  {
+        opserr << "ESFIIRFilter::ESFIIRFilter() - "
+            << "need 5 coefficients (b0 b1 b2 a1 a2) per section.\n";
+        exit(OF_ReturnType_failed);
+    }
+    numSections = coefficients.Size()/5;
+    coeffs = new double [5*numSections];
+    if (coeffs == 0)  {
+        opserr << "ESFIIRFilter::ESFIIRFilter() - "
+            << "failed to create coefficient array.\n";
+        exit(OF_ReturnType_failed);
+    }
+    for (int i=0; i<5*numSections; i++)
+        coeffs[i] = coefficients(i);
+    
+    // use a single channel until the size is set
+    this->setSize(1);
+}
+
+
+ESFIIRFilter::ESFIIRFilter(const ESFIIRFilter& esf)
+    : ESFDigitalFilter(esf),
+    numSections(0), coeffs(0), z1(0), z2(0)
+{
+    int i;
+    numSections = esf.numSections;
+    coeffs = new double [5*numSections];
+    if (coeffs == 0)  {
+        opserr << "ESFIIRFilter::ESFIIRFilter() - "
+            << "failed to create coefficient array.\n";
+        exit(OF_ReturnType_failed);
+    }
+    for (i=0; i<5*numSections; i++)
+        coeffs[i] = esf.coeffs[i];
+    
+    this->setSize(esf.numChannels);
+    channel = esf.channel;
+    started = esf.started;
+    for (i=0; i<numSections*numChannels; i++)  {
+        z1[i] = esf.z1[i];
+        z2[i] = esf.z2[i];
+    }
+}
+
+
+ESFIIRFilter::~ESFIIRFilter()
+{
+    if (coeffs != 0)
+        delete [] coeffs;
+    if (z1 != 0)
+        delete [] z1;
+    if (z2 != 0)
+        delete [] z2;
+}
+
+
+double ESFIIRFilter::filtering(double data)
+{
+    return this->ESFDigitalFilter::filtering(data);
+}
+
+
+int ESFIIRFilter::filtering(const double *in, double *out, int nChannels)
+{
+    ExpTimer timer(OF_Timing_Filter);
+    
+    if (this->prepareStep(in, nChannels) < 0)
+        return OF_ReturnType_failed;
+    
+    int c;
+    if (out != in)  {
+        for (c=0; c<numChannels; c++)
+            out[c] = in[c];
+    }
+    
+    // one pass over all the channels per section
+    for (int s=0; s<numSections; s++)  {
+        const double b0 = coeffs[5*s],   b1 = coeffs[5*s+1];
+        const double b2 = coeffs[5*s+2], a1 = coeffs[5*s+3];
+        const double a2 = coeffs[5*s+4];
+        double *w1 = &z1[s*numChannels];
+        double *w2 = &z2[s*numChannels];
+        for (c=0; c<numChannels; c++)  {
+            const double x = out[c];
+            const double y = b0*x + w1[c];
+            w1[c] = b1*x - a1*y + w2[c];
+            w2[c] = b2*x - a2*y;
+            out[c] = y;
+        }
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+ExperimentalSignalFilter* ESFIIRFilter::getCopy()
+{
+    return new ESFIIRFilter(*this);
+}
+
+
+double ESFIIRFilter::getGroupDelay()
+{
+    // the group delay of b(z)/a(z) at zero frequency is
+    // sum(k*b_k)/sum(b_k) - sum(k*a_k)/sum(a_k), sections
+    // without gain at zero frequency are not included
+    double delay = 0.0;
+    for (int s=0; s<numSections; s++)  {
+        const double *b = &coeffs[5*s];
+        double sumB = b[0] + b[1] + b[2];
+        double sumA = 1.0 + b[3] + b[4];
+        if (fabs(sumB) > 1.0e-12 && fabs(sumA) > 1.0e-12)
+            delay += (b[1] + 2.0*b[2])/sumB - (b[3] + 2.0*b[4])/sumA;
+    }
+    
+    return delay;
+}
+
+
+Vector ESFIIRFilter::designButterworthLowPass(int order,
+    double cutoffFreq, double samplingFreq)
+{
+    const double pi = 4.0*atan(1.0);
+    int numBiquads = order/2;
+    int numSect = numBiquads + order%2;
+    Vector coefficients(5*numSect);
+    
+    double w0 = 2.0*pi*cutoffFreq/samplingFreq;
+    double cw = cos(w0), sw = sin(w0);
+    
+    // second order sections with the quality factors of the poles
+    int s;
+    for (s=0; s<numBiquads; s++)  {
+        double Q = 1.0/(2.0*sin(pi*(2*s+1)/(2.0*order)));
+        double alpha = sw/(2.0*Q);
+        double a0 = 1.0 + alpha;
+        coefficients(5*s)   = 0.5*(1.0-cw)/a0;
+        coefficients(5*s+1) = (1.0-cw)/a0;
+        coefficients(5*s+2) = 0.5*(1.0-cw)/a0;
+        coefficients(5*s+3) = -2.0*cw/a0;
+        coefficients(5*s+4) = (1.0-alpha)/a0;
+    }
+    
+    // first order section for odd orders
+    if (order%2 == 1)  {
+        double K = tan(0.5*w0);
+        coefficients(5*s)   = K/(1.0+K);
+        coefficients(5*s+1) = K/(1.0+K);
+        coefficients(5*s+2) = 0.0;
+        coefficients(5*s+3) = (K-1.0)/(K+1.0);
+        coefficients(5*s+4) = 0.0;
+    }
+    
+    return coefficients;
+}
+
+
+Vector ESFIIRFilter::designNotch(double notchFreq, double Q,
+    double samplingFreq)
+{
+    const double pi = 4.0*atan(1.0);
+    Vector coefficients(5);
+    
+    double w0 = 2.0*pi*notchFreq/samplingFreq;
+    double cw = cos(w0);
+    double alpha = sin(w0)/(2.0*Q);
+    double a0 = 1.0 + alpha;
+    coefficients(0) = 1.0/a0;
+    coefficients(1) = -2.0*cw/a0;
+    coefficients(2) = 1.0/a0;
+    coefficients(3) = -2.0*cw/a0;
+    coefficients(4) = (1.0-alpha)/a0;
+    
+    return coefficients;
+}
+
+
+void ESFIIRFilter::Print(OPS_Stream &s, int flag)
+{
+    s << "Filter: " << this->getTag(); 
+    s << "  type: ESFIIRFilter\n";
+    s << "  number of sections: " << numSections << endln;
+    for (int i=0; i<numSections; i++)  {
+        s << "  section " << i+1 << ": b = " << coeffs[5*i] << " "
+            << coeffs[5*i+1] << " " << coeffs[5*i+2] << ", a = 1 "
+            << coeffs[5*i+3] << " " << coeffs[5*i+4] << endln;
+    }
+    s << "  group delay: " << this->getGroupDelay() << " steps\n";
+    s << "  number of channels: " << numChannels << endln;
+}
+
+
+int ESFIIRFilter::allocateState()
+{
+    if (z1 != 0)
+        delete [] z1;
+    if (z2 != 0)
+        delete [] z2;
+    
+    z1 = new double [numSections*numChannels];
+    z2 = new double [numSections*numChannels];
+    if (z1 == 0 || z2 == 0)  {
+        opserr << "ESFIIRFilter::allocateState() - "
+            << "failed to create state arrays.\n";
+        exit(OF_ReturnType_failed);
+    }
+    for (int i=0; i<numSections*numChannels; i++)  {
+        z1[i] = 0.0;
+        z2[i] = 0.0;
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+void ESFIIRFilter::initState(int c, double x)
+{
+    // steady state of each section for the constant input x
+    for (int s=0; s<numSections; s++)  {
+        const double *b = &coeffs[5*s];
+        double sumA = 1.0 + b[3] + b[4];
+        double y = 0.0;
+        if (fabs(sumA) > 1.0e-12)
+            y = (b[0] + b[1] + b[2])/sumA*x;
+        z1[s*numChannels+c] = y - b[0]*x;
+        z2[s*numChannels+c] = b[2]*x - b[4]*y;
+        x = y;
+    }
+}
+
+
+double ESFIIRFilter::filterChannel(int c, double x)
+{
+    for (int s=0; s<numSections; s++)  {
+        const double *b = &coeffs[5*s];
+        double &w1 = z1[s*numChannels+c];
+        double &w2 = z2[s*numChannels+c];
+        const double y = b[0]*x + w1;
+        w1 = b[1]*x - b[3]*y + w2;
+        w2 = b[2]*x - b[4]*y;
+        x = y;
+    }
+    
+    return x;
+}
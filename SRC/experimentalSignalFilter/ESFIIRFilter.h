@@ -0,0 +1,87 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+#ifndef ESFIIRFilter_h
+#define ESFIIRFilter_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ESFIIRFilter. An ESFIIRFilter is a cascade of second order sections
+// (biquads), each given by the five coefficients b0 b1 b2 a1 a2 of
+//
+//          b0 + b1*z^-1 + b2*z^-2
+//   H(z) = ----------------------
+//           1 + a1*z^-1 + a2*z^-2
+//
+// The sections are evaluated in transposed direct form II. The two
+// state variables of each section are stored for all the channels
+// next to each other so that the batch filtering runs one tight loop
+// over the channels per section. Static methods design Butterworth
+// low-pass and notch filters with the bilinear transform.
+
+#include "ESFDigitalFilter.h"
+
+class ESFIIRFilter : public ESFDigitalFilter
+{
+public:
+    // constructors
+    ESFIIRFilter(int tag, const Vector &coefficients);
+    ESFIIRFilter(const ESFIIRFilter& esf);
+    
+    // destructor
+    virtual ~ESFIIRFilter();
+    
+    // method to get class type
+    const char *getClassType() const {return "ESFIIRFilter";};
+    
+    virtual double filtering(double data);
+    virtual int filtering(const double *in, double *out, int nChannels);
+    
+    virtual ExperimentalSignalFilter *getCopy();
+    
+    virtual double getGroupDelay();
+    
+    // methods to design the sections of common filters
+    static Vector designButterworthLowPass(int order, double cutoffFreq,
+        double samplingFreq);
+    static Vector designNotch(double notchFreq, double Q,
+        double samplingFreq);
+    
+    // public methods for output
+    void Print(OPS_Stream &s, int flag = 0);
+    
+protected:
+    virtual int allocateState();
+    virtual void initState(int c, double x);
+    virtual double filterChannel(int c, double x);
+    
+private:
+    int numSections;    // number of second order sections
+    double *coeffs;     // b0 b1 b2 a1 a2 of each section
+    double *z1, *z2;    // states, numSections x numChannels
+};
+
+#endif
@@ -35,21 +35,32 @@
 
 #include "ESFKrylovForceConverter.h"
 
+#include <math.h>
+#include <stdlib.h>
+
 
 ESFKrylovForceConverter::ESFKrylovForceConverter(int tag, 
     int ss, Matrix& initStif)
     : ExperimentalSignalFilter(tag), firstWarning(true),
     size(0), szSubspace(ss), dispPast(0), forcePast(0), convertFrc(0), incrDisp(0), 
-    incrForce(0), cn(0), kInit(initStif), iDMatrix(0,0), iFMatrix(0,0)
+    incrForce(0), cn(0), kInit(initStif), iDMatrix(0,0), iFMatrix(0,0),
+    numCols(0), head(0), numDropped(0), qMatrix(0,0), rMatrix(0,0),
+    ddtMatrix(0,0), fdtMatrix(0,0), lMatrix(0,0), work(0)
 {
-    // does nothing
+    if (szSubspace < 1)  {
+        opserr << "ESFKrylovForceConverter::ESFKrylovForceConverter() - "
+            << "the number of subspace vectors must be at least one\n";
+        exit(OF_ReturnType_failed);
+    }
 }
 
 
 ESFKrylovForceConverter::ESFKrylovForceConverter(const ESFKrylovForceConverter& esf)
     : ExperimentalSignalFilter(esf), firstWarning(0), size(0), szSubspace(0), 
     dispPast(0), forcePast(0), convertFrc(0), incrDisp(0), incrForce(0), cn(0), kInit(0,0), 
-    iDMatrix(0,0), iFMatrix(0,0)
+    iDMatrix(0,0), iFMatrix(0,0), numCols(0), head(0), numDropped(0),
+    qMatrix(0,0), rMatrix(0,0), ddtMatrix(0,0), fdtMatrix(0,0),
+    lMatrix(0,0), work(0)
 {
     szSubspace = esf.szSubspace;
     firstWarning = esf.firstWarning;
@@ -72,6 +83,29 @@ int ESFKrylovForceConverter::setSize(const int sz)
     forcePast.resize(size);
     incrDisp.resize(size);
     incrForce.resize(size);
+    work.resize(size);
+    convertFrc.Zero();
+    dispPast.Zero();
+    forcePast.Zero();
+    
+    // allocate the window and its factorizations
+    iDMatrix.resize(size, szSubspace);
+    iFMatrix.resize(size, szSubspace);
+    int szQR = (szSubspace < size) ? szSubspace : size;
+    qMatrix.resize(size, szQR);
+    rMatrix.resize(szQR, szQR);
+    rMatrix.Zero();
+    cn.resize(szSubspace);
+    if (szSubspace > size)  {
+        ddtMatrix.resize(size, size);
+        fdtMatrix.resize(size, size);
+        lMatrix.resize(size, size);
+        ddtMatrix.Zero();
+        fdtMatrix.Zero();
+    }
+    numCols = 0;
+    head = 0;
+    numDropped = 0;
     
     // check stiffness matrix size
     this->setInitialStiff();
@@ -109,55 +143,38 @@ double ESFKrylovForceConverter::filtering(double data)
 
 Vector& ESFKrylovForceConverter::converting(Vector* trialDisp)
 {
-    int szCn = cn.Size();
-    Matrix iDMatrixT;
-    Vector v(size), incrV(size), incrP(size), incrQ(size);
-    
-    int i;
+    int i, j;
     for (i=0; i<size; i++)
         incrDisp(i) = (*trialDisp)(i) - dispPast(i);
-    if (szCn == 0) {
+    
+    if (numCols == 0)  {
         // initial condition
         convertFrc.addMatrixVector(0.0, kInit, incrDisp, 1.0);
-    } else if (szCn <= size) {
+    } else if (numCols <= size)  {
         // least squares for over-determined system
-        Matrix tempDTD(szCn, szCn);
-        Vector incrDT(szCn);
+        this->solveQR(incrDisp);
         
-        this->matTranspose(&iDMatrixT, &iDMatrix);
-        tempDTD.addMatrixProduct(0.0, iDMatrixT, iDMatrix, 1.0);
-        incrDT.addMatrixVector(0.0, iDMatrixT, incrDisp, 1.0);
-        tempDTD.Solve(incrDT, cn);
-        
-        incrV.addMatrixVector(0.0, iDMatrix, cn, 1.0);
-        for (i=0; i<size; i++)
-            v(i) = incrDisp(i) - incrV(i);
-        incrQ.addMatrixVector(0.0, kInit, v, 1.0);
-        incrP.addMatrixVector(0.0, iFMatrix, cn, 1.0);
-        
-        for (i=0; i<size; i++)
-            convertFrc(i) = forcePast(i) + incrP(i) + incrQ(i);
-    } else {
-        // Lagrange multiplier to find the min sol for under-determined system
-        Matrix tempDDT(size, size);
-        Vector incrDT(size);
-        int i;
-        for (i=0; i<size; i++)
-            incrDisp(i) = (*trialDisp)(i) - dispPast(i);
-        
-        this->matTranspose(&iDMatrixT, &iDMatrix);
-        tempDDT.addMatrixProduct(0.0, iDMatrix, iDMatrixT, 1.0);
-        tempDDT.Solve(incrDisp, incrDT);
-        cn.addMatrixVector(0.0, iDMatrix, incrDT, 1.0);
-        
-        incrV.addMatrixVector(0.0, iDMatrix, cn, 1.0);
-        for (i=0; i<size; i++)
-            v(i) = incrDisp(i) - incrV(i);
-        incrQ.addMatrixVector(0.0, kInit, v, 1.0);
-        incrP.addMatrixVector(0.0, iFMatrix, cn, 1.0);
+        // the part of the increment outside of the subspace
+        // is converted with the initial stiffness
+        convertFrc = forcePast;
+        for (j=0; j<numCols; j++)  {
+            int col = (head + j) % szSubspace;
+            double c = cn(j);
+            for (i=0; i<size; i++)  {
+                incrDisp(i) -= c*iDMatrix(i,col);
+                convertFrc(i) += c*iFMatrix(i,col);
+            }
+        }
+        convertFrc.addMatrixVector(1.0, kInit, incrDisp, 1.0);
+    } else  {
+        // minimum norm solution for under-determined system
+        // cn = D^T*y with (D*D^T)*y = incrDisp
+        this->solveGram(incrDisp, work);
         
-        for (i=0; i<size; i++)
-            convertFrc(i) = forcePast(i) + incrP(i) + incrQ(i);
+        incrDisp.addMatrixVector(1.0, ddtMatrix, work, -1.0);
+        convertFrc = forcePast;
+        convertFrc.addMatrixVector(1.0, fdtMatrix, work, 1.0);
+        convertFrc.addMatrixVector(1.0, kInit, incrDisp, 1.0);
     }
     
     return convertFrc;
@@ -166,7 +183,7 @@ Vector& ESFKrylovForceConverter::converting(Vector* trialDisp)
 
 Vector& ESFKrylovForceConverter::converting(Vector* daqDisp, Vector* daqForce)
 {	
-    convertFrc = this->converting(daqDisp);
+    this->converting(daqDisp);
     
     this->updateIncrMat(daqDisp, daqForce);
     
@@ -191,6 +208,7 @@ void ESFKrylovForceConverter::Print(OPS_Stream &s, int flag)
 {
     s << "Experimental Signal Filter: " << this->getTag(); 
     s << "  type: ESFKrylovForceConverter\n";
+    s << "  numSubspace: " << szSubspace << endln;
 }
 
 
@@ -203,70 +221,263 @@ void ESFKrylovForceConverter::update()
 int ESFKrylovForceConverter::updateIncrMat(const Vector* daqDisp, const Vector* daqForce)
 {
     // calculate the incremental values
-    int i, j;
+    int i;
     for (i=0; i<size; i++) {
         incrDisp(i) = (*daqDisp)(i) - dispPast(i);
         incrForce(i) = (*daqForce)(i) - forcePast(i);
     }
     
-    // using incremental disp and force
-    int dimCiDM = iDMatrix.noCols();
+    // drop the oldest column if the window is full
+    if (numCols == szSubspace)  {
+        if (szSubspace <= size)
+            this->dropQR();
+        else
+            this->updateGram(head, -1.0);
+        head = (head + 1) % szSubspace;
+        numCols--;
+        numDropped++;
+    }
     
-    Matrix tempDM(size, dimCiDM);
-    Matrix tempFM(size, dimCiDM);
-    // FIX ME add size check
+    // append the incremental vectors to the window
+    int col = (head + numCols) % szSubspace;
+    for (i=0; i<size; i++) {
+        iDMatrix(i,col) = incrDisp(i);
+        iFMatrix(i,col) = incrForce(i);
+    }
+    if (numCols < size)
+        this->appendQR(col);
+    numCols++;
     
-    // append the incremental vectors to matrices
-    if (dimCiDM < szSubspace) {
-        // copy all entries from the existing matrices
-        for (i=0; i<size; i++) {
-            for (j=0; j<dimCiDM; j++) {
-                tempDM(i,j) = iDMatrix(i,j);
-                tempFM(i,j) = iFMatrix(i,j);
-            }
+    if (szSubspace > size)  {
+        // rebuild D*D^T and F*D^T from time to time to
+        // get rid of the round-off errors of the downdates
+        if (numDropped >= szSubspace)  {
+            this->rebuildGram();
+            numDropped = 0;
         }
-        iDMatrix.resize(size, dimCiDM +1);
-        iFMatrix.resize(size, dimCiDM +1);
-        cn.resize(dimCiDM+1);
-        for (i=0; i<size; i++) {
-            for (j=0; j<dimCiDM; j++) {
-                iDMatrix(i,j) = tempDM(i,j);
-                iFMatrix(i,j) = tempFM(i,j);
-            }
+        else  {
+            this->updateGram(col, 1.0);
         }
-        for (i=0; i<size; i++) {
-            iDMatrix(i, dimCiDM) = incrDisp(i);
-            iFMatrix(i, dimCiDM) = incrForce(i);
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+void ESFKrylovForceConverter::appendQR(int col)
+{
+    // orthogonalize the new column against Q twice
+    // (modified Gram-Schmidt with reorthogonalization)
+    int k = numCols;
+    int i, j, pass;
+    double h, dNorm = 0.0, rNorm = 0.0;
+    for (i=0; i<size; i++)  {
+        qMatrix(i,k) = iDMatrix(i,col);
+        dNorm += qMatrix(i,k)*qMatrix(i,k);
+    }
+    dNorm = sqrt(dNorm);
+    for (j=0; j<k; j++)
+        rMatrix(j,k) = 0.0;
+    for (pass=0; pass<2; pass++)  {
+        for (j=0; j<k; j++)  {
+            h = 0.0;
+            for (i=0; i<size; i++)
+                h += qMatrix(i,j)*qMatrix(i,k);
+            rMatrix(j,k) += h;
+            for (i=0; i<size; i++)
+                qMatrix(i,k) -= h*qMatrix(i,j);
         }
-    } else if (dimCiDM == szSubspace) {
-        for (i=0; i<size; i++) {
-            for (j=0; j<(dimCiDM-1); j++) {
-                iDMatrix(i,j) = iDMatrix(i,j+1);
-                iFMatrix(i,j) = iFMatrix(i,j+1);
-            }
+    }
+    for (i=0; i<size; i++)
+        rNorm += qMatrix(i,k)*qMatrix(i,k);
+    rNorm = sqrt(rNorm);
+    
+    if (rNorm > 1.0E-12*dNorm && rNorm > 0.0)  {
+        rMatrix(k,k) = rNorm;
+        for (i=0; i<size; i++)
+            qMatrix(i,k) /= rNorm;
+        return;
+    }
+    
+    // the new column is linearly dependent on the window, so
+    // complete Q with the unit vector that is farthest from it
+    rMatrix(k,k) = 0.0;
+    int iMin = 0;
+    double rowNorm, minRowNorm = 2.0;
+    for (i=0; i<size; i++)  {
+        rowNorm = 0.0;
+        for (j=0; j<k; j++)
+            rowNorm += qMatrix(i,j)*qMatrix(i,j);
+        if (rowNorm < minRowNorm)  {
+            minRowNorm = rowNorm;
+            iMin = i;
         }
-        for (i=0; i<size; i++) {
-            iDMatrix(i, dimCiDM-1) = incrDisp(i);
-            iFMatrix(i, dimCiDM-1) = incrForce(i);
+    }
+    for (i=0; i<size; i++)
+        qMatrix(i,k) = 0.0;
+    qMatrix(iMin,k) = 1.0;
+    for (pass=0; pass<2; pass++)  {
+        for (j=0; j<k; j++)  {
+            h = 0.0;
+            for (i=0; i<size; i++)
+                h += qMatrix(i,j)*qMatrix(i,k);
+            for (i=0; i<size; i++)
+                qMatrix(i,k) -= h*qMatrix(i,j);
         }
     }
+    rNorm = 0.0;
+    for (i=0; i<size; i++)
+        rNorm += qMatrix(i,k)*qMatrix(i,k);
+    rNorm = sqrt(rNorm);
+    for (i=0; i<size; i++)
+        qMatrix(i,k) /= rNorm;
+}
+
+
+void ESFKrylovForceConverter::dropQR()
+{
+    // removing the first column of R leaves an upper Hessenberg matrix
+    int k = numCols;
+    int i, j, l;
+    for (j=0; j<k-1; j++)  {
+        for (i=0; i<=j+1; i++)
+            rMatrix(i,j) = rMatrix(i,j+1);
+    }
+    for (i=0; i<k; i++)
+        rMatrix(i,k-1) = 0.0;
+    
+    // restore the triangular form with Givens rotations,
+    // which are also applied to the columns of Q
+    double a, b, r, c, s, x, y;
+    for (j=0; j<k-1; j++)  {
+        a = rMatrix(j,j);
+        b = rMatrix(j+1,j);
+        r = sqrt(a*a + b*b);
+        if (r == 0.0)
+            continue;
+        c = a/r;
+        s = b/r;
+        for (l=j; l<k-1; l++)  {
+            x = rMatrix(j,l);
+            y = rMatrix(j+1,l);
+            rMatrix(j,l) = c*x + s*y;
+            rMatrix(j+1,l) = -s*x + c*y;
+        }
+        rMatrix(j+1,j) = 0.0;
+        for (i=0; i<size; i++)  {
+            x = qMatrix(i,j);
+            y = qMatrix(i,j+1);
+            qMatrix(i,j) = c*x + s*y;
+            qMatrix(i,j+1) = -s*x + c*y;
+        }
+    }
+}
+
+
+void ESFKrylovForceConverter::updateGram(int col, double fact)
+{
+    // add fact*d*d^T to D*D^T and fact*f*d^T to F*D^T
+    int i, j;
+    double d;
+    for (j=0; j<size; j++)  {
+        d = fact*iDMatrix(j,col);
+        for (i=0; i<size; i++)  {
+            ddtMatrix(i,j) += iDMatrix(i,col)*d;
+            fdtMatrix(i,j) += iFMatrix(i,col)*d;
+        }
+    }
+}
+
+
+void ESFKrylovForceConverter::rebuildGram()
+{
+    ddtMatrix.Zero();
+    fdtMatrix.Zero();
+    for (int j=0; j<numCols; j++)
+        this->updateGram((head + j) % szSubspace, 1.0);
+}
+
+
+int ESFKrylovForceConverter::solveQR(const Vector &b)
+{
+    // solve R*cn = Q^T*b by back substitution, columns
+    // with a negligible diagonal term are not used
+    int k = numCols;
+    int i, j;
+    double maxDiag = 0.0;
+    for (j=0; j<k; j++)  {
+        double z = 0.0;
+        for (i=0; i<size; i++)
+            z += qMatrix(i,j)*b(i);
+        cn(j) = z;
+        if (fabs(rMatrix(j,j)) > maxDiag)
+            maxDiag = fabs(rMatrix(j,j));
+    }
+    double tol = 1.0E-12*maxDiag;
+    for (j=k-1; j>=0; j--)  {
+        if (fabs(rMatrix(j,j)) <= tol)  {
+            cn(j) = 0.0;
+            continue;
+        }
+        double sum = cn(j);
+        for (i=j+1; i<k; i++)
+            sum -= rMatrix(j,i)*cn(i);
+        cn(j) = sum/rMatrix(j,j);
+    }
     
     return OF_ReturnType_completed;
 }
 
 
-int ESFKrylovForceConverter::matTranspose(Matrix* kT, const Matrix* k)
+int ESFKrylovForceConverter::solveGram(const Vector &b, Vector &x)
 {
-    int dimR = k->noRows();
-    int dimC = k->noCols();
-    kT->resize(dimC,dimR);
+    // Cholesky factorization of D*D^T, pivots that are negligible
+    // compared to the largest diagonal term are set to zero
+    int i, j, l;
+    double sum, maxDiag = 0.0;
+    for (j=0; j<size; j++)  {
+        if (ddtMatrix(j,j) > maxDiag)
+            maxDiag = ddtMatrix(j,j);
+    }
+    double tol = 1.0E-12*maxDiag;
+    for (j=0; j<size; j++)  {
+        sum = ddtMatrix(j,j);
+        for (l=0; l<j; l++)
+            sum -= lMatrix(j,l)*lMatrix(j,l);
+        if (sum <= tol)  {
+            for (i=j; i<size; i++)
+                lMatrix(i,j) = 0.0;
+            continue;
+        }
+        lMatrix(j,j) = sqrt(sum);
+        for (i=j+1; i<size; i++)  {
+            sum = ddtMatrix(i,j);
+            for (l=0; l<j; l++)
+                sum -= lMatrix(i,l)*lMatrix(j,l);
+            lMatrix(i,j) = sum/lMatrix(j,j);
+        }
+    }
     
-    int i, j;
-    //transpose matrix
-    for (i=0; i<dimC; i++) {
-        for (j=0; j<dimR; j++) {
-            (*kT)(i,j) = (*k)(j,i);
+    // forward and back substitution
+    for (j=0; j<size; j++)  {
+        if (lMatrix(j,j) == 0.0)  {
+            x(j) = 0.0;
+            continue;
+        }
+        sum = b(j);
+        for (l=0; l<j; l++)
+            sum -= lMatrix(j,l)*x(l);
+        x(j) = sum/lMatrix(j,j);
+    }
+    for (j=size-1; j>=0; j--)  {
+        if (lMatrix(j,j) == 0.0)  {
+            x(j) = 0.0;
+            continue;
         }
+        sum = x(j);
+        for (l=j+1; l<size; l++)
+            sum -= lMatrix(l,j)*x(l);
+        x(j) = sum/lMatrix(j,j);
     }
     
     return OF_ReturnType_completed;
@@ -35,6 +35,16 @@
 // to trial forces and measured displacements to measured forces using 
 // the Krylov subspaces.  It used the converting method and does nothing 
 // with the filtering method. 
+//
+// The incremental displacements and forces of the last szSubspace steps
+// are kept in a sliding window. As long as the window does not hold
+// more columns than there are DOF, the least squares problems are solved
+// with a thin QR factorization of the displacement window, which is
+// updated when a column is appended (Gram-Schmidt with reorthogonalization)
+// or dropped (Givens rotations). Otherwise the minimum norm problems are
+// solved with the Cholesky factorization of D*D^T, where D*D^T and F*D^T
+// are updated with the appended and dropped columns and periodically
+// rebuilt from the window. No memory is allocated after setSize.
 
 #include "ExperimentalSignalFilter.h"
 #include "ExperimentalTangentStiff.h"
@@ -70,12 +80,27 @@ private:
     int szSubspace;		// number of spaces vectors to use
     Vector dispPast, forcePast, convertFrc, incrDisp, incrForce, cn;
     Matrix kInit;	    // tangent stiffness matrix
-    Matrix iDMatrix;	// the incremental displacement Matrix
-    Matrix iFMatrix;	// the incremental force Matrix
+    Matrix iDMatrix;	// the incremental displacement Matrix (circular)
+    Matrix iFMatrix;	// the incremental force Matrix (circular)
+    int numCols;        // number of columns in the window
+    int head;           // column of the oldest entry in the window
+    int numDropped;     // dropped columns since last rebuild
+    
+    Matrix qMatrix;     // orthonormal factor of the window, D = Q*R
+    Matrix rMatrix;     // upper triangular factor of the window
+    Matrix ddtMatrix;   // D*D^T for the minimum norm solution
+    Matrix fdtMatrix;   // F*D^T for the minimum norm solution
+    Matrix lMatrix;     // Cholesky factor of D*D^T
+    Vector work;        // work vector of size
     
     int setInitialStiff();
     int updateIncrMat(const Vector* daqDisp, const Vector* daqForce);
-    int matTranspose(Matrix* kT, const Matrix* k);
+    void appendQR(int col);
+    void dropQR();
+    void updateGram(int col, double fact);
+    void rebuildGram();
+    int solveQR(const Vector &b);
+    int solveGram(const Vector &b, Vector &x);
 };
 
 #endif
@@ -34,6 +34,7 @@
 // ExperimentalSignalFilter.
 
 #include "ExperimentalSignalFilter.h"
+#include <ExpTiming.h>
 
 
 ExperimentalSignalFilter::ExperimentalSignalFilter(int tag)
@@ -63,6 +64,20 @@ const char* ExperimentalSignalFilter::getClassType() const
 }
 
 
+int ExperimentalSignalFilter::filtering(const double *in, double *out,
+    int nChannels)
+{
+    ExpTimer timer(OF_Timing_Filter);
+    
+    // filters without a batch implementation
+    // process the channels one at a time
+    for (int i=0; i<nChannels; i++)
+        out[i] = this->filtering(in[i]);
+    
+    return OF_ReturnType_completed;
+}
+
+
 Response* ExperimentalSignalFilter::setResponse(const char **argv,
     int argc, OPS_Stream &output)
 {
@@ -59,6 +59,7 @@ public:
     virtual ~ExperimentalSignalFilter();
     
     virtual double filtering(double data) = 0;
+    virtual int filtering(const double *in, double *out, int nChannels);
     virtual Vector& converting(Vector* td) = 0;
     virtual Vector& converting(Vector* dd, Vector* df) = 0;
     virtual int setSize(const int sz) = 0;
@@ -28,10 +28,15 @@
 
 #include <string.h>
 #include <tcl.h>
+#include <fstream>
+#include <vector>
 #include <ArrayOfTaggedObjects.h>
 
 #include <ESFErrorSimRandomGauss.h>
+#include <ESFErrorSimTimeDelay.h>
 #include <ESFErrorSimUndershoot.h>
+#include <ESFFIRFilter.h>
+#include <ESFIIRFilter.h>
 #include <ESFKrylovForceConverter.h>
 #include <ESFTangForceConverter.h>
 
@@ -184,13 +189,40 @@ int TclExpSignalFilterCommand(ClientData clientData, Tcl_Interp *interp,
         theFilter = new ESFErrorSimUndershoot(tag, error);
     }
     
+    // ----------------------------------------------------------------------------	
+    else if (strcmp(argv[1],"ErrorSimTimeDelay") == 0)  {
+        if (argc != 4)  {
+            opserr << "WARNING invalid number of arguments\n";
+            printCommand(argc,argv);
+            opserr << "Want: expSignalFilter ErrorSimTimeDelay tag delay\n";
+            return TCL_ERROR;
+        }
+        
+        int tag;
+        double delay;
+        
+        if (Tcl_GetInt(interp, argv[2], &tag) != TCL_OK)  {
+            opserr << "WARNING invalid ErrorSimTimeDelay tag\n";
+            return TCL_ERROR;
+        }
+        if (Tcl_GetDouble(interp, argv[3], &delay) != TCL_OK || delay < 0.0)  {
+            opserr << "WARNING invalid delay\n";
+            opserr << "expSignalFilter ErrorSimTimeDelay " << tag << endln;
+            return TCL_ERROR;
+        }
+        
+        // parsing was successful, allocate the signal filter
+        theFilter = new ESFErrorSimTimeDelay(tag, delay);
+    }
+    
     // ----------------------------------------------------------------------------	
     else if (strcmp(argv[1],"KrylovForceConverter") == 0)  {
         if (argc < 6)  {
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
-            opserr << "Want: expSignalFilter KrylovForceConverter"
-                << "tag numSubspace -initStif Kij\n";
+            opserr << "Want: expSignalFilter KrylovForceConverter "
+                << "tag numSubspace -initStif Kij\n"
+                << "  numSubspace: length of the window of past increments\n";
             return TCL_ERROR;
         }
         
@@ -201,7 +233,7 @@ int TclExpSignalFilterCommand(ClientData clientData, Tcl_Interp *interp,
             return TCL_ERROR;
         }
         argi++;
-        if (Tcl_GetInt(interp, argv[argi], &ss) != TCL_OK)  {
+        if (Tcl_GetInt(interp, argv[argi], &ss) != TCL_OK || ss < 1)  {
             opserr << "WARNING invalid numSubspace\n";
             opserr << "expSignalFilter KrylovForceConverter " << tag << endln;
             return TCL_ERROR;
@@ -217,7 +249,7 @@ int TclExpSignalFilterCommand(ClientData clientData, Tcl_Interp *interp,
         // check size of stiffness matrix
         double numArg, dDim;
         int dim, iDim;
-        numArg = argc - argi - 1;
+        numArg = argc - argi;
         dDim = sqrt(numArg);
         iDim = (int)dDim;
         if (iDim == dDim) {
@@ -319,6 +351,193 @@ int TclExpSignalFilterCommand(ClientData clientData, Tcl_Interp *interp,
         theFilter = new ESFTangForceConverter(tag, theInitStif, theTangStif);
     }
     
+    // ----------------------------------------------------------------------------	
+    else if (strcmp(argv[1],"Biquad") == 0)  {
+        if (argc < 8 || (argc-3)%5 != 0)  {
+            opserr << "WARNING invalid number of arguments\n";
+            printCommand(argc,argv);
+            opserr << "Want: expSignalFilter Biquad tag b0 b1 b2 a1 a2 "
+                << "<b0 b1 b2 a1 a2 ...>\n";
+            return TCL_ERROR;
+        }
+        
+        int tag;
+        
+        if (Tcl_GetInt(interp, argv[2], &tag) != TCL_OK)  {
+            opserr << "WARNING invalid Biquad tag\n";
+            return TCL_ERROR;
+        }
+        Vector coeffs(argc-3);
+        for (int i=0; i<argc-3; i++)  {
+            if (Tcl_GetDouble(interp, argv[3+i], &coeffs(i)) != TCL_OK)  {
+                opserr << "WARNING invalid coefficient\n";
+                opserr << "expSignalFilter Biquad " << tag << endln;
+                return TCL_ERROR;
+            }
+        }
+        
+        // parsing was successful, allocate the signal filter
+        theFilter = new ESFIIRFilter(tag, coeffs);
+    }
+    
+    // ----------------------------------------------------------------------------	
+    else if (strcmp(argv[1],"ButterworthLowPass") == 0)  {
+        if (argc != 6)  {
+            opserr << "WARNING invalid number of arguments\n";
+            printCommand(argc,argv);
+            opserr << "Want: expSignalFilter ButterworthLowPass tag "
+                << "order cutoffFreq samplingFreq\n";
+            return TCL_ERROR;
+        }
+        
+        int tag, order;
+        double fc, fs;
+        
+        if (Tcl_GetInt(interp, argv[2], &tag) != TCL_OK)  {
+            opserr << "WARNING invalid ButterworthLowPass tag\n";
+            return TCL_ERROR;
+        }
+        if (Tcl_GetInt(interp, argv[3], &order) != TCL_OK || order < 1)  {
+            opserr << "WARNING invalid order\n";
+            opserr << "expSignalFilter ButterworthLowPass " << tag << endln;
+            return TCL_ERROR;
+        }
+        if (Tcl_GetDouble(interp, argv[4], &fc) != TCL_OK || fc <= 0.0)  {
+            opserr << "WARNING invalid cutoffFreq\n";
+            opserr << "expSignalFilter ButterworthLowPass " << tag << endln;
+            return TCL_ERROR;
+        }
+        if (Tcl_GetDouble(interp, argv[5], &fs) != TCL_OK || fs <= 2.0*fc)  {
+            opserr << "WARNING invalid samplingFreq, must be larger than 2*cutoffFreq\n";
+            opserr << "expSignalFilter ButterworthLowPass " << tag << endln;
+            return TCL_ERROR;
+        }
+        
+        // parsing was successful, allocate the signal filter
+        theFilter = new ESFIIRFilter(tag,
+            ESFIIRFilter::designButterworthLowPass(order, fc, fs));
+    }
+    
+    // ----------------------------------------------------------------------------	
+    else if (strcmp(argv[1],"Notch") == 0)  {
+        if (argc != 6)  {
+            opserr << "WARNING invalid number of arguments\n";
+            printCommand(argc,argv);
+            opserr << "Want: expSignalFilter Notch tag notchFreq Q samplingFreq\n";
+            return TCL_ERROR;
+        }
+        
+        int tag;
+        double f0, Q, fs;
+        
+        if (Tcl_GetInt(interp, argv[2], &tag) != TCL_OK)  {
+            opserr << "WARNING invalid Notch tag\n";
+            return TCL_ERROR;
+        }
+        if (Tcl_GetDouble(interp, argv[3], &f0) != TCL_OK || f0 <= 0.0)  {
+            opserr << "WARNING invalid notchFreq\n";
+            opserr << "expSignalFilter Notch " << tag << endln;
+            return TCL_ERROR;
+        }
+        if (Tcl_GetDouble(interp, argv[4], &Q) != TCL_OK || Q <= 0.0)  {
+            opserr << "WARNING invalid Q\n";
+            opserr << "expSignalFilter Notch " << tag << endln;
+            return TCL_ERROR;
+        }
+        if (Tcl_GetDouble(interp, argv[5], &fs) != TCL_OK || fs <= 2.0*f0)  {
+            opserr << "WARNING invalid samplingFreq, must be larger than 2*notchFreq\n";
+            opserr << "expSignalFilter Notch " << tag << endln;
+            return TCL_ERROR;
+        }
+        
+        // parsing was successful, allocate the signal filter
+        theFilter = new ESFIIRFilter(tag, ESFIIRFilter::designNotch(f0, Q, fs));
+    }
+    
+    // ----------------------------------------------------------------------------	
+    else if (strcmp(argv[1],"MovingAverage") == 0)  {
+        if (argc != 4)  {
+            opserr << "WARNING invalid number of arguments\n";
+            printCommand(argc,argv);
+            opserr << "Want: expSignalFilter MovingAverage tag numPoints\n";
+            return TCL_ERROR;
+        }
+        
+        int tag, numPoints;
+        
+        if (Tcl_GetInt(interp, argv[2], &tag) != TCL_OK)  {
+            opserr << "WARNING invalid MovingAverage tag\n";
+            return TCL_ERROR;
+        }
+        if (Tcl_GetInt(interp, argv[3], &numPoints) != TCL_OK || numPoints < 1)  {
+            opserr << "WARNING invalid numPoints\n";
+            opserr << "expSignalFilter MovingAverage " << tag << endln;
+            return TCL_ERROR;
+        }
+        
+        // parsing was successful, allocate the signal filter
+        theFilter = new ESFFIRFilter(tag, numPoints);
+    }
+    
+    // ----------------------------------------------------------------------------	
+    else if (strcmp(argv[1],"FIR") == 0)  {
+        if (argc < 4 || (strcmp(argv[3],"-file") == 0 && argc != 5))  {
+            opserr << "WARNING invalid number of arguments\n";
+            printCommand(argc,argv);
+            opserr << "Want: expSignalFilter FIR tag h0 <h1 ...>\n"
+                << "  or: expSignalFilter FIR tag -file fileName\n";
+            return TCL_ERROR;
+        }
+        
+        int tag;
+        std::vector<double> h;
+        
+        if (Tcl_GetInt(interp, argv[2], &tag) != TCL_OK)  {
+            opserr << "WARNING invalid FIR tag\n";
+            return TCL_ERROR;
+        }
+        if (strcmp(argv[3],"-file") == 0)  {
+            // read the coefficients separated by white space
+            std::ifstream coeffFile;
+            coeffFile.open(argv[4], std::ios::in);
+            if (coeffFile.bad() || !coeffFile.is_open())  {
+                opserr << "WARNING could not open coefficient file "
+                    << argv[4] << endln;
+                opserr << "expSignalFilter FIR " << tag << endln;
+                return TCL_ERROR;
+            }
+            double value;
+            while (coeffFile >> value)
+                h.push_back(value);
+            if (!coeffFile.eof())  {
+                opserr << "WARNING invalid coefficient in file "
+                    << argv[4] << endln;
+                opserr << "expSignalFilter FIR " << tag << endln;
+                return TCL_ERROR;
+            }
+            coeffFile.close();
+        } else  {
+            double value;
+            for (int i=3; i<argc; i++)  {
+                if (Tcl_GetDouble(interp, argv[i], &value) != TCL_OK)  {
+                    opserr << "WARNING invalid coefficient\n";
+                    opserr << "expSignalFilter FIR " << tag << endln;
+                    return TCL_ERROR;
+                }
+                h.push_back(value);
+            }
+        }
+        if (h.empty())  {
+            opserr << "WARNING no coefficients specified\n";
+            opserr << "expSignalFilter FIR " << tag << endln;
+            return TCL_ERROR;
+        }
+        Vector coeffs(&h[0], (int)h.size());
+        
+        // parsing was successful, allocate the signal filter
+        theFilter = new ESFFIRFilter(tag, coeffs);
+    }
+    
     // ----------------------------------------------------------------------------	
     else  {
         // experimental signal filter type not recognized
@@ -33,6 +33,7 @@
 // Description: This file contains the implementation of ActorExpSite.
 
 #include "ActorExpSite.h"
+#include <ExpTiming.h>
 
 
 ActorExpSite::ActorExpSite(int tag, 
@@ -41,8 +42,9 @@ ActorExpSite::ActorExpSite(int tag,
     FEM_ObjectBroker *theObjectBroker)
     : ExperimentalSite(tag, setup), 
     Actor(theChannel, *theObjectBroker, 0),
-    theControl(0), dataSize(0),
-    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize)
+    theControl(0), dataSize(0), numSendData(0), numRecvData(0),
+    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
+    batchLead(0), batchIndex(0), batchSites(0), numBatchSites(0)
 { 
     if (theSetup == 0)  {
         opserr << "ActorExpSite::ActorExpSite() - "
@@ -59,8 +61,9 @@ ActorExpSite::ActorExpSite(int tag,
     FEM_ObjectBroker *theObjectBroker)
     : ExperimentalSite(tag, (ExperimentalSetup*)0), 
     Actor(theChannel, *theObjectBroker, 0),
-    theControl(control), dataSize(0),
-    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize)
+    theControl(control), dataSize(0), numSendData(0), numRecvData(0),
+    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
+    batchLead(0), batchIndex(0), batchSites(0), numBatchSites(0)
 { 
     if (theControl == 0)  {
         opserr << "ActorExpSite::ActorExpSite() - "
@@ -71,10 +74,49 @@ ActorExpSite::ActorExpSite(int tag,
 }
 
 
+ActorExpSite::ActorExpSite(int tag, 
+    ExperimentalSetup *setup,
+    ActorExpSite &batchSite)
+    : ExperimentalSite(tag, setup), Actor(batchSite),
+    theControl(0), dataSize(0), numSendData(0), numRecvData(0),
+    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
+    batchLead(0), batchIndex(0), batchSites(0), numBatchSites(0)
+{ 
+    if (theSetup == 0)  {
+        opserr << "ActorExpSite::ActorExpSite() - "
+            << "if you want to use it without an ExperimentalSetup, "
+            << "use another constructor.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    this->joinBatch(batchSite);
+}
+
+
+ActorExpSite::ActorExpSite(int tag, 
+    ExperimentalControl *control,
+    ActorExpSite &batchSite)
+    : ExperimentalSite(tag, (ExperimentalSetup*)0), Actor(batchSite),
+    theControl(control), dataSize(0), numSendData(0), numRecvData(0),
+    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
+    batchLead(0), batchIndex(0), batchSites(0), numBatchSites(0)
+{ 
+    if (theControl == 0)  {
+        opserr << "ActorExpSite::ActorExpSite() - "
+            << "if you want to use it without an ExperimentalControl, "
+            << "use another constructor.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    this->joinBatch(batchSite);
+}
+
+
 ActorExpSite::ActorExpSite(const ActorExpSite& es)
     : ExperimentalSite(es), Actor(es), 
-    theControl(0), dataSize(0),
-    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize)
+    theControl(0), dataSize(0), numSendData(0), numRecvData(0),
+    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
+    batchLead(0), batchIndex(0), batchSites(0), numBatchSites(0)
 {  
     if (es.theControl != 0)  {
         theControl = (es.theControl)->getCopy();
@@ -87,6 +129,8 @@ ActorExpSite::ActorExpSite(const ActorExpSite& es)
     }
     
     dataSize = es.dataSize;    
+    numSendData = es.numSendData;
+    numRecvData = es.numRecvData;
     sendV.resize(dataSize);
     recvV.resize(dataSize);
 }
@@ -96,6 +140,16 @@ ActorExpSite::~ActorExpSite()
 {
     if (theControl != 0) 
         delete theControl;
+    
+    // sites of a batch leave the batch
+    if (batchIndex > 0 && batchLead != 0)
+        batchLead->batchSites[batchIndex] = 0;
+    if (batchSites != 0)  {
+        for (int i=1; i<numBatchSites; i++)
+            if (batchSites[i] != 0)
+                batchSites[i]->batchLead = 0;
+        delete [] batchSites;
+    }
 }
 
 
@@ -110,99 +164,141 @@ int ActorExpSite::run()
 int ActorExpSite::runTill(int exitWhen)
 {
     bool exitYet = false;
-    int ndim;
     while (exitYet == false)  {
-        this->recvVector(recvV);
+        if (this->recvVector(recvV) < 0)  {
+            opserr << "ActorExpSite::runTill() - "
+                << "connection to ShadowExpSite lost\n";
+            return OF_ReturnType_failed;
+        }
         int action = (int)recvV(0);
         
-        switch (action)  {
-        case OF_RemoteTest_open:
-            opserr << "\nConnected to ShadowExpSite "
-                << recvV(1) << endln;
-            sendV(0) = OF_ReturnType_completed;
-            sendV(1) = this->getTag();
-            sendV(2) = atof(OPF_VERSION);
-            this->sendVector(sendV);
-            if (recvV(2) != atof(OPF_VERSION))  {
-                opserr << "ActorExpSite::run() - OpenFresco Version "
-                    << "mismatch:\nActorExpSite Version " << atof(OPF_VERSION)
-                    << " != ShadowExpSite Version " << recvV(2) << endln;
-                exit(OF_ReturnType_failed);
-            }
-            if (exitWhen == action)
-                exitYet = true;
-            break;
-        case OF_RemoteTest_setup:
-            dataSize = (int)recvV(1);
-            this->setup();
-            if (exitWhen == action)
-                exitYet = true;
-            break;
-        case OF_RemoteTest_setTrialResponse:
-            ndim = 1;
-            if (tDisp != 0)  {
-                tDisp->Extract(recvV, ndim);
-                ndim += getTrialSize(OF_Resp_Disp);
+        // the next message is addressed to another site of the batch
+        if (action == OF_RemoteTest_selectSite)  {
+            int i = (int)recvV(1);
+            if (i < 1 || i >= numBatchSites || batchSites[i] == 0)  {
+                opserr << "ActorExpSite::runTill() - invalid site "
+                    << i << " of batch selected\n";
+                return OF_ReturnType_failed;
             }
-            if (tVel != 0)  {
-                tVel->Extract(recvV, ndim);
-                ndim += getTrialSize(OF_Resp_Vel);
+            ActorExpSite *theSite = batchSites[i];
+            if (theSite->recvVector(theSite->recvV) < 0)  {
+                opserr << "ActorExpSite::runTill() - "
+                    << "connection to ShadowExpSite lost\n";
+                return OF_ReturnType_failed;
             }
-            if (tAccel != 0)  {
-                tAccel->Extract(recvV, ndim);
-                ndim += getTrialSize(OF_Resp_Accel);
-            }
-            if (tForce != 0)  {
-                tForce->Extract(recvV, ndim);
-                ndim += getTrialSize(OF_Resp_Force);
-            }
-            if (tTime != 0)  {
-                tTime->Extract(recvV, ndim);
-            }            
-            this->setTrialResponse(tDisp, tVel, tAccel, tForce, tTime);
-            if (exitWhen == action)
-                exitYet = true;
-            break;
-        case OF_RemoteTest_commitState:
-            if (tTime != 0)  {
-                ndim = 1
-                    + getTrialSize(OF_Resp_Disp)
-                    + getTrialSize(OF_Resp_Vel)
-                    + getTrialSize(OF_Resp_Accel)
-                    + getTrialSize(OF_Resp_Force);
-                tTime->Extract(recvV, ndim);
-            }
-            this->commitState();
-            if (exitWhen == action)
-                exitYet = true;
-            break;
-        case OF_RemoteTest_getDaqResponse:
-            this->checkDaqResponse();
-            this->setSendDaqResponse();
-            this->sendVector(sendV);
-            if (exitWhen == action)
-                exitYet = true;
-            break;
-        case OF_RemoteTest_DIE:
-            opserr << "\nDisconnected from ShadowExpSite "
-                << recvV(1) << endln << endln;
-            sendV(0) = OF_ReturnType_received;
-            sendV(1) = this->getTag();
-            this->sendVector(sendV);
-            if (exitWhen == action)
-                exitYet = true;
-            break;
-        default:
-            opserr << "ActorExpSite::run() - invalid action "
-                << action << " received" << endln;
-            recvV(0) = OF_ReturnType_failed;
+            theSite->serveAction((int)theSite->recvV(0), 0);
+            continue;
         }
+        
+        exitYet = this->serveAction(action, exitWhen);
     }
     
     return OF_ReturnType_completed;
 }
 
 
+bool ActorExpSite::serveAction(int action, int exitWhen)
+{
+    bool exitYet = false;
+    int ndim;
+    
+    switch (action)  {
+    case OF_RemoteTest_open:
+        opserr << "\nConnected to ShadowExpSite "
+            << recvV(1) << endln;
+        sendV(0) = OF_ReturnType_completed;
+        sendV(1) = this->getTag();
+        sendV(2) = atof(OPF_VERSION);
+        // accept the framed protocol if requested, legacy
+        // ShadowExpSites send zero (fixed protocol)
+        sendV(3) = (recvV(3) == OF_Network_framed) ?
+            OF_Network_framed : OF_Network_fixed;
+        // announce support of the combined step transaction
+        sendV(4) = OF_RemoteTest_setTrialGetDaqResponse;
+        // announce support of batches of sites
+        sendV(5) = OF_RemoteTest_setTrialGetDaqBatch;
+        this->sendVector(sendV);
+        if (recvV(2) != atof(OPF_VERSION))  {
+            opserr << "ActorExpSite::run() - OpenFresco Version "
+                << "mismatch:\nActorExpSite Version " << atof(OPF_VERSION)
+                << " != ShadowExpSite Version " << recvV(2) << endln;
+            exit(OF_ReturnType_failed);
+        }
+        this->setFramedMode(sendV(3) == OF_Network_framed);
+        for (int i=1; i<numBatchSites; i++)
+            if (batchSites[i] != 0)
+                batchSites[i]->setFramedMode(sendV(3) == OF_Network_framed);
+        if (exitWhen == action)
+            exitYet = true;
+        break;
+    case OF_RemoteTest_setup:
+        dataSize = (int)recvV(1);
+        this->setup();
+        if (exitWhen == action)
+            exitYet = true;
+        break;
+    case OF_RemoteTest_setTrialResponse:
+        this->setRecvTrialResponse();
+        this->setTrialResponse(tDisp, tVel, tAccel, tForce, tTime);
+        if (exitWhen == action)
+            exitYet = true;
+        break;
+    case OF_RemoteTest_setTrialGetDaqResponse:
+        this->setRecvTrialResponse();
+        this->setTrialResponse(tDisp, tVel, tAccel, tForce, tTime);
+        this->setSendDaqResponse();
+        this->sendVector(sendV, numSendData);
+        if (exitWhen == action ||
+            exitWhen == OF_RemoteTest_setTrialResponse ||
+            exitWhen == OF_RemoteTest_getDaqResponse)
+            exitYet = true;
+        break;
+    case OF_RemoteTest_setTrialGetDaqBatch:
+        this->serveBatch();
+        if (exitWhen == action ||
+            exitWhen == OF_RemoteTest_setTrialResponse ||
+            exitWhen == OF_RemoteTest_getDaqResponse)
+            exitYet = true;
+        break;
+    case OF_RemoteTest_commitState:
+        if (tTime != 0)  {
+            ndim = 1
+                + getTrialSize(OF_Resp_Disp)
+                + getTrialSize(OF_Resp_Vel)
+                + getTrialSize(OF_Resp_Accel)
+                + getTrialSize(OF_Resp_Force);
+            tTime->Extract(recvV, ndim);
+        }
+        this->commitState();
+        if (exitWhen == action)
+            exitYet = true;
+        break;
+    case OF_RemoteTest_getDaqResponse:
+        this->checkDaqResponse();
+        this->setSendDaqResponse();
+        this->sendVector(sendV, numSendData);
+        if (exitWhen == action)
+            exitYet = true;
+        break;
+    case OF_RemoteTest_DIE:
+        opserr << "\nDisconnected from ShadowExpSite "
+            << recvV(1) << endln << endln;
+        sendV(0) = OF_ReturnType_received;
+        sendV(1) = this->getTag();
+        this->sendVector(sendV, 2);
+        if (exitWhen == action)
+            exitYet = true;
+        break;
+    default:
+        opserr << "ActorExpSite::run() - invalid action "
+            << action << " received" << endln;
+        recvV(0) = OF_ReturnType_failed;
+    }
+    
+    return exitYet;
+}
+
+
 int ActorExpSite::setup()
 {
     this->recvID(*sizeTrial);
@@ -223,6 +319,7 @@ int ActorExpSite::setSize(ID sizeT, ID sizeO)
         theSetup->checkSize(sizeT, sizeO);
     } else if (theControl != 0)  {
         theControl->setSize(sizeT, sizeO);
+        theControl->setFilterSizes();
         theControl->setup();
     }
     
@@ -231,10 +328,14 @@ int ActorExpSite::setSize(ID sizeT, ID sizeO)
         nTrial += sizeT(i);
         nOutput += sizeO(i);
     }
+    numSendData = nOutput;
+    numRecvData = 1+nTrial;
     
     // resize channel Vectors
     sendV.resize(dataSize);
     recvV.resize(dataSize);
+    if (batchIndex > 0 || numBatchSites > 0)
+        this->resizeBatch();
     
     return OF_ReturnType_completed;
 }
@@ -246,6 +347,8 @@ int ActorExpSite::setTrialResponse(const Vector* disp,
     const Vector* force,
     const Vector* time)
 {
+    ExpTimer timer(OF_Timing_SiteTrial);
+    
     // save data in basic sys
     this->ExperimentalSite::setTrialResponse(disp, vel, accel, force, time);
     
@@ -300,6 +403,8 @@ int ActorExpSite::setTrialResponse(const Vector* disp,
 
 int ActorExpSite::checkDaqResponse()
 {
+    ExpTimer timer(OF_Timing_SiteDaq);
+    
     if (daqFlag == false)  {
         int rValue;
         // get daq response from the setup
@@ -332,6 +437,33 @@ int ActorExpSite::checkDaqResponse()
 }
 
 
+int ActorExpSite::setRecvTrialResponse()
+{
+    int ndim = 1;
+    if (tDisp != 0)  {
+        tDisp->Extract(recvV, ndim);
+        ndim += getTrialSize(OF_Resp_Disp);
+    }
+    if (tVel != 0)  {
+        tVel->Extract(recvV, ndim);
+        ndim += getTrialSize(OF_Resp_Vel);
+    }
+    if (tAccel != 0)  {
+        tAccel->Extract(recvV, ndim);
+        ndim += getTrialSize(OF_Resp_Accel);
+    }
+    if (tForce != 0)  {
+        tForce->Extract(recvV, ndim);
+        ndim += getTrialSize(OF_Resp_Force);
+    }
+    if (tTime != 0)  {
+        tTime->Extract(recvV, ndim);
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
 int ActorExpSite::setSendDaqResponse()
 {
     int ndim = 0, size;
@@ -390,6 +522,82 @@ int ActorExpSite::commitState(Vector* time)
 }
 
 
+void ActorExpSite::joinBatch(ActorExpSite &batchSite)
+{
+    // the first site of the batch owns the connection
+    batchLead = &batchSite;
+    if (batchSite.batchLead != 0)
+        batchLead = batchSite.batchLead;
+    
+    // add this site to the batch
+    if (batchLead->numBatchSites == 0)  {
+        batchLead->batchSites = new ActorExpSite* [1];
+        batchLead->batchSites[0] = batchLead;
+        batchLead->numBatchSites = 1;
+    }
+    batchIndex = batchLead->numBatchSites;
+    ActorExpSite **newSites = new ActorExpSite* [batchIndex+1];
+    for (int i=0; i<batchIndex; i++)
+        newSites[i] = batchLead->batchSites[i];
+    newSites[batchIndex] = this;
+    delete [] batchLead->batchSites;
+    batchLead->batchSites = newSites;
+    batchLead->numBatchSites++;
+    this->resizeBatch();
+    
+    opserr << "\nActorExpSite " << this->getTag() << " added to batch of "
+        << "ActorExpSite " << batchLead->getTag() << endln;
+}
+
+
+int ActorExpSite::serveBatch()
+{
+    // set the trial responses and assemble the daq responses
+    // of the sites in the order they were received
+    int numSites = (int)recvV(1);
+    int i, j, k, ndim = 2, numSend = 0;
+    for (k=0; k<numSites; k++)  {
+        i = (int)recvV(ndim++);
+        if (i < 0 || i >= numBatchSites || batchSites[i] == 0)  {
+            opserr << "ActorExpSite::serveBatch() - invalid site "
+                << i << " of batch received\n";
+            exit(OF_ReturnType_failed);
+        }
+        ActorExpSite *theSite = batchSites[i];
+        for (j=1; j<theSite->numRecvData; j++)
+            theSite->recvV(j) = recvV(ndim++);
+        theSite->setRecvTrialResponse();
+        theSite->setTrialResponse(theSite->tDisp, theSite->tVel,
+            theSite->tAccel, theSite->tForce, theSite->tTime);
+        theSite->setSendDaqResponse();
+        for (j=0; j<theSite->numSendData; j++)
+            batchSendV(numSend++) = theSite->sendV(j);
+    }
+    this->sendVector(batchSendV, numSend);
+    
+    return OF_ReturnType_completed;
+}
+
+
+void ActorExpSite::resizeBatch()
+{
+    ActorExpSite *theLead = (batchLead != 0) ? batchLead : this;
+    
+    // the first site receives the whole batch message
+    int sizeRecv = 2, sizeSend = 1;
+    for (int i=0; i<theLead->numBatchSites; i++)  {
+        ActorExpSite *theSite = theLead->batchSites[i];
+        if (theSite != 0)  {
+            sizeRecv += theSite->numRecvData;
+            sizeSend += theSite->numSendData;
+        }
+    }
+    if (theLead->recvV.Size() < sizeRecv)
+        theLead->recvV.resize(sizeRecv);
+    theLead->batchSendV.resize(sizeSend);
+}
+
+
 ExperimentalSite* ActorExpSite::getCopy()
 {
     ActorExpSite *theCopy = new ActorExpSite(*this);
@@ -55,6 +55,14 @@ public:
         ExperimentalControl *control,
         Channel &theChannel,
         FEM_ObjectBroker *theObjectBroker = 0);
+    // constructors for a site that shares the connection of batchSite
+    // and is served together with it in one batch transaction
+    ActorExpSite(int tag, 
+        ExperimentalSetup *setup,
+        ActorExpSite &batchSite);
+    ActorExpSite(int tag, 
+        ExperimentalControl *control,
+        ActorExpSite &batchSite);
     ActorExpSite(const ActorExpSite& es);
     
     // destructor
@@ -78,6 +86,7 @@ public:
         const Vector* time);
     
     virtual int checkDaqResponse();
+    virtual int setRecvTrialResponse();
     virtual int setSendDaqResponse();
     
     virtual int commitState(Vector *time = 0);
@@ -88,15 +97,35 @@ public:
     void Print(OPS_Stream &s, int flag = 0);
     
 protected:
+    // serve the action received in recvV, returns true if
+    // the server loop is to be left
+    bool serveAction(int action, int exitWhen);
+    
+    // methods for sites of a batch
+    void joinBatch(ActorExpSite &batchSite);
+    int serveBatch();
+    void resizeBatch();
+    
     // pointer of ExperimentalControl
     ExperimentalControl* theControl;
     
     // data size of vectors in Channel
     int dataSize;
     
+    // number of data in daq and trial messages (framed protocol)
+    int numSendData;
+    int numRecvData;
+    
     // vectors in Channel
     Vector sendV;
     Vector recvV;
+    
+    // batch of sites sharing the connection of the first site
+    ActorExpSite *batchLead;    // first site of the batch (0 if this one)
+    int batchIndex;             // index of this site in the batch
+    ActorExpSite **batchSites;  // sites of the batch (first site only)
+    int numBatchSites;          // number of sites of the batch
+    Vector batchSendV;          // batch daq reply
 };
 
 #endif
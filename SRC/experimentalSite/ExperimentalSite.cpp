@@ -30,6 +30,7 @@
 // ExperimentalSite.
 
 #include "ExperimentalSite.h"
+#include <ExpTiming.h>
 
 #include <Recorder.h>
 
@@ -300,6 +301,7 @@ int ExperimentalSite::commitState(Vector* time)
     }
     
     // invoke record on all recorders
+    ExpTimer timer(OF_Timing_Record);
     if (tTime != 0)  {
         for (int i=0; i<numRecorders; i++)
             if (theRecorders[i] != 0)
@@ -558,6 +560,7 @@ int ExperimentalSite::record()
     commitTag++;
     
     // invoke record on all recorders
+    ExpTimer timer(OF_Timing_Record);
     if (tTime != 0)  {
         for (int i=0; i<numRecorders; i++)
             if (theRecorders[i] != 0)
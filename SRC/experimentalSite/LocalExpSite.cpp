@@ -34,6 +34,7 @@
 // LocalExpSite.
 
 #include "LocalExpSite.h"
+#include <ExpTiming.h>
 
 
 LocalExpSite::LocalExpSite(int tag, 
@@ -85,6 +86,8 @@ int LocalExpSite::setTrialResponse(const Vector* disp,
     const Vector* force,
     const Vector* time)
 {
+    ExpTimer timer(OF_Timing_SiteTrial);
+    
     // save data in basic sys
     this->ExperimentalSite::setTrialResponse(disp, vel, accel, force, time);
     
@@ -106,6 +109,8 @@ int LocalExpSite::setTrialResponse(const Vector* disp,
 
 int LocalExpSite::checkDaqResponse()
 {
+    ExpTimer timer(OF_Timing_SiteDaq);
+    
     if (daqFlag == false)  {
         int rValue;
         // get daq response from the setup
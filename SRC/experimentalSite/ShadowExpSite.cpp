@@ -33,44 +33,37 @@
 // Description: This file contains the implementation of ShadowExpSite.
 
 #include "ShadowExpSite.h"
+#include <ExpTiming.h>
 
 
 ShadowExpSite::ShadowExpSite(int tag,
     Channel& theChannel, int datasize,
-    FEM_ObjectBroker *theObjectBroker)
+    FEM_ObjectBroker *theObjectBroker, int protocol)
     : ExperimentalSite(tag, (ExperimentalSetup*)0),
     Shadow(theChannel, *theObjectBroker), dataSize(datasize),
+    numSendData(1), numRecvData(0), stepMode(false),
     sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
     bDisp(0), bVel(0), bAccel(0), bForce(0), bTime(0),
-    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0)
+    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0),
+    batchLead(0), batchIndex(0), batchSites(0), numBatchSites(0),
+    batchMode(false), trialPending(false), replyPending(false)
 {
-    sendV(0) = OF_RemoteTest_open;
-    sendV(1) = tag;
-    sendV(2) = atof(OPF_VERSION);
-    this->sendVector(sendV);
-    this->recvVector(recvV);
-    
-    if (recvV(2) != atof(OPF_VERSION))  {
-        opserr << "ShadowExpSite::ShadowExpSite() - OpenFresco Version "
-            << "mismatch:\nShadowExpSite Version " << atof(OPF_VERSION)
-            << " != ActorExpSite Version " << recvV(2) << endln;
-        exit(OF_ReturnType_failed);
-    }
-    
-    opserr << "\nConnected to ActorExpSite "
-        << recvV(1) << endln;
+    this->openConnection(protocol);
 }
 
 
 ShadowExpSite::ShadowExpSite(int tag, 
     ExperimentalSetup *setup,
     Channel &theChannel, int datasize,
-    FEM_ObjectBroker *theObjectBroker)
+    FEM_ObjectBroker *theObjectBroker, int protocol)
     : ExperimentalSite(tag, setup),
     Shadow(theChannel, *theObjectBroker), dataSize(datasize),
+    numSendData(1), numRecvData(0), stepMode(false),
     sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
     bDisp(0), bVel(0), bAccel(0), bForce(0), bTime(0),
-    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0)
+    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0),
+    batchLead(0), batchIndex(0), batchSites(0), numBatchSites(0),
+    batchMode(false), trialPending(false), replyPending(false)
 {
     if (theSetup == 0)  {
         opserr << "ShadowExpSite::ShadowExpSite() - "
@@ -79,31 +72,68 @@ ShadowExpSite::ShadowExpSite(int tag,
         exit(OF_ReturnType_failed);
     }
     
-    sendV(0) = OF_RemoteTest_open;
-    sendV(1) = tag;
-    sendV(2) = atof(OPF_VERSION);
-    this->sendVector(sendV);
-    this->recvVector(recvV);
-    
-    if (recvV(2) != atof(OPF_VERSION))  {
-        opserr << "ShadowExpSite::ShadowExpSite() - OpenFresco Version "
-            << "mismatch:\nShadowExpSite Version " << atof(OPF_VERSION)
-            << " != ActorExpSite Version " << recvV(2) << endln;
+    this->openConnection(protocol);
+}
+
+
+ShadowExpSite::ShadowExpSite(int tag, 
+    ExperimentalSetup *setup,
+    ShadowExpSite &batchSite, int datasize)
+    : ExperimentalSite(tag, setup),
+    Shadow(batchSite), dataSize(datasize),
+    numSendData(1), numRecvData(0), stepMode(true),
+    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
+    bDisp(0), bVel(0), bAccel(0), bForce(0), bTime(0),
+    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0),
+    batchLead(0), batchIndex(0), batchSites(0), numBatchSites(0),
+    batchMode(false), trialPending(false), replyPending(false)
+{
+    // the first site of the batch owns the connection
+    batchLead = &batchSite;
+    if (batchSite.batchLead != 0)
+        batchLead = batchSite.batchLead;
+    if (batchLead->batchMode == false)  {
+        opserr << "ShadowExpSite::ShadowExpSite() - "
+            << "ActorExpSite of ShadowExpSite " << batchLead->getTag()
+            << " does not support batches of sites "
+            << "(requires the framed protocol).\n";
         exit(OF_ReturnType_failed);
     }
     
-    opserr << "\nConnected to ActorExpSite "
-        << recvV(1) << endln;
+    // add this site to the batch
+    if (batchLead->numBatchSites == 0)  {
+        batchLead->batchSites = new ShadowExpSite* [1];
+        batchLead->batchSites[0] = batchLead;
+        batchLead->numBatchSites = 1;
+    }
+    batchIndex = batchLead->numBatchSites;
+    ShadowExpSite **newSites = new ShadowExpSite* [batchIndex+1];
+    for (int i=0; i<batchIndex; i++)
+        newSites[i] = batchLead->batchSites[i];
+    newSites[batchIndex] = this;
+    delete [] batchLead->batchSites;
+    batchLead->batchSites = newSites;
+    batchLead->numBatchSites++;
+    this->resizeBatch();
+    
+    opserr << "\nShadowExpSite " << tag << " added to batch of "
+        << "ShadowExpSite " << batchLead->getTag() << endln;
 }
 
 
 ShadowExpSite::ShadowExpSite(const ShadowExpSite& es)
     : ExperimentalSite(es), Shadow(es), dataSize(0),
+    numSendData(1), numRecvData(0), stepMode(false),
     sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
     bDisp(0), bVel(0), bAccel(0), bForce(0), bTime(0),
-    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0)
+    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0),
+    batchLead(0), batchIndex(0), batchSites(0), numBatchSites(0),
+    batchMode(false), trialPending(false), replyPending(false)
 {
     dataSize = es.dataSize;
+    numSendData = es.numSendData;
+    numRecvData = es.numRecvData;
+    stepMode = es.stepMode;
     sendV.resize(dataSize);
     recvV.resize(dataSize);
 }
@@ -132,9 +162,25 @@ ShadowExpSite::~ShadowExpSite()
     if (rTime != 0)
         delete rTime;
     
+    // sites of a batch only leave the batch, the connection
+    // is closed by the first site
+    if (batchIndex > 0)  {
+        if (batchLead != 0)
+            batchLead->batchSites[batchIndex] = 0;
+        return;
+    }
+    if (batchSites != 0)  {
+        for (int i=1; i<numBatchSites; i++)
+            if (batchSites[i] != 0)
+                batchSites[i]->batchLead = 0;
+        delete [] batchSites;
+    }
+    
+    this->recvPending();
+    
     sendV(0) = OF_RemoteTest_DIE;
     sendV(1) = this->getTag();
-    this->sendVector(sendV);
+    this->sendVector(sendV, 2);
     this->recvVector(recvV);
     
     opserr << "\nDisconnected from ActorExpSite "
@@ -144,9 +190,12 @@ ShadowExpSite::~ShadowExpSite()
 
 int ShadowExpSite::setup()
 {    
+    this->recvPending();
+    this->selectSite();
+    
     sendV(0) = OF_RemoteTest_setup;
     sendV(1) = dataSize;
-    this->sendVector(sendV);
+    this->sendVector(sendV, 2);
     
     if (theSetup != 0)  {
         // send sizeCtrl
@@ -180,6 +229,8 @@ int ShadowExpSite::setSize(ID sizeT, ID sizeO)
         }
         if (dataSize < 1+nCtrl) dataSize = 1+nCtrl;
         if (dataSize < nDaq)    dataSize = nDaq;
+        numSendData = 1+nCtrl;
+        numRecvData = nDaq;
     } else  {
         int nInput = 0, nOutput = 0;
         for (int i=0; i<OF_Resp_All; i++)  {
@@ -188,6 +239,8 @@ int ShadowExpSite::setSize(ID sizeT, ID sizeO)
         }
         if (dataSize < 1+nInput) dataSize = 1+nInput;
         if (dataSize < nOutput)  dataSize = nOutput;
+        numSendData = 1+nInput;
+        numRecvData = nOutput;
     }
     
     // warning message if user-provided dataSize was too small
@@ -202,6 +255,8 @@ int ShadowExpSite::setSize(ID sizeT, ID sizeO)
     // resize channel Vectors
     sendV.resize(dataSize);
     recvV.resize(dataSize);
+    if (batchIndex > 0 || numBatchSites > 0)
+        this->resizeBatch();
     
     return OF_ReturnType_completed;
 }
@@ -213,16 +268,30 @@ int ShadowExpSite::setTrialResponse(const Vector* disp,
     const Vector* force,
     const Vector* time)
 {
+    ExpTimer timer(OF_Timing_SiteTrial);
+    
+    // the reply to the previous trial response is received first
+    this->recvPending();
+    
     // save data in basic sys
     this->ExperimentalSite::setTrialResponse(disp, vel, accel, force, time);
     
     // set daq flag
     daqFlag = false;
     
+    // a trial response of a batch that was not sent yet
+    // is sent before it is overwritten
+    ShadowExpSite *theLead = (batchLead != 0) ? batchLead : this;
+    if (trialPending == true)
+        theLead->sendBatch();
+    
     int rValue;
     if (theSetup != 0)  {
         // transform trial response
-        rValue = theSetup->transfTrialResponse(tDisp, tVel, tAccel, tForce, tTime);
+        {
+            ExpTimer transfTimer(OF_Timing_SetupTrial);
+            rValue = theSetup->transfTrialResponse(tDisp, tVel, tAccel, tForce, tTime);
+        }
         if (rValue != OF_ReturnType_completed)  {
             opserr << "ShadowExpSite::setTrialResponse() - "
                 << "failed to set trial response at the setup.\n";
@@ -305,9 +374,26 @@ int ShadowExpSite::setTrialResponse(const Vector* disp,
         }
     }
     
+    // defer the trial response to the batch transaction, which
+    // is sent when the first daq response of the batch is needed
+    if (theLead->numBatchSites > 1)  {
+        trialPending = true;
+        return OF_ReturnType_completed;
+    }
+    
+    // set trial response and get daq response in one transaction,
+    // the daq response is only received once it is needed, so that
+    // the round trips of all sites overlap while the domain is updated
+    if (stepMode == true)  {
+        sendV(0) = OF_RemoteTest_setTrialGetDaqResponse;
+        this->sendVector(sendV, numSendData);
+        replyPending = true;
+        return OF_ReturnType_completed;
+    }
+    
     // set trial response
     sendV(0) = OF_RemoteTest_setTrialResponse;
-    this->sendVector(sendV);
+    this->sendVector(sendV, numSendData);
     
     return OF_ReturnType_completed;
 }
@@ -315,69 +401,108 @@ int ShadowExpSite::setTrialResponse(const Vector* disp,
 
 int ShadowExpSite::checkDaqResponse()
 {
+    ExpTimer timer(OF_Timing_SiteDaq);
+    
     if (daqFlag == false)  {
-        sendV(0) = OF_RemoteTest_getDaqResponse;
-        this->sendVector(sendV);
-        
-        if (rDisp == 0)  {
-            if (getDaqSize(OF_Resp_Disp) != 0)
-                rDisp = new Vector(getDaqSize(OF_Resp_Disp));
-            if (getDaqSize(OF_Resp_Vel) != 0)
-                rVel = new Vector(getDaqSize(OF_Resp_Vel));
-            if (getDaqSize(OF_Resp_Accel) != 0)
-                rAccel = new Vector(getDaqSize(OF_Resp_Accel));
-            if (getDaqSize(OF_Resp_Force) != 0)
-                rForce = new Vector(getDaqSize(OF_Resp_Force));
-            if (getDaqSize(OF_Resp_Time) != 0)
-                rTime = new Vector(getDaqSize(OF_Resp_Time));
-        }
-        this->recvVector(recvV);
+        // get daq response of the trial response that was sent last
+        if (replyPending == true)
+            return this->recvPending();
         
-        int ndim = 0;
-        if (rDisp != 0)  {
-            rDisp->Extract(recvV, 0);
-            ndim += getDaqSize(OF_Resp_Disp);
+        // get daq responses of all pending sites of the batch
+        if (trialPending == true)  {
+            ShadowExpSite *theLead = (batchLead != 0) ? batchLead : this;
+            return theLead->sendBatch();
         }
-        if (rVel != 0)  {
-            rVel->Extract(recvV, ndim);
-            ndim += getDaqSize(OF_Resp_Vel);
-        }
-        if (rAccel != 0)  {
-            rAccel->Extract(recvV, ndim);
-            ndim += getDaqSize(OF_Resp_Accel);
-        }
-        if (rForce != 0)  {
-            rForce->Extract(recvV, ndim);
-            ndim += getDaqSize(OF_Resp_Force);
-        }
-        if (rTime != 0)  {
-            rTime->Extract(recvV, ndim);
-        }
-        
-        if (theSetup != 0)  {
-            // set daq response at the setup
-            theSetup->setDaqResponse(rDisp, rVel, rAccel, rForce, rTime);
-            // transform daq response
-            theSetup->transfDaqResponse(oDisp, oVel, oAccel, oForce, oTime);
-        } else  {
-            if (oDisp != 0) 
-                *oDisp = *rDisp;
-            if (oVel != 0) 
-                *oVel = *rVel;
-            if (oAccel != 0) 
-                *oAccel = *rAccel;
-            if (oForce != 0) 
-                *oForce = *rForce;
-            if (oTime != 0) 
-                *oTime = *rTime;
-        }
-        
-        // save data in basic sys
-        this->ExperimentalSite::setDaqResponse(oDisp, oVel, oAccel, oForce, oTime); 
         
-        // set daq flag
-        daqFlag = true;
+        this->selectSite();
+        sendV(0) = OF_RemoteTest_getDaqResponse;
+        this->sendVector(sendV, 1);
+        this->recvDaqResponse();
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ShadowExpSite::recvDaqResponse()
+{
+    this->recvVector(recvV);
+    
+    return this->transfRecvDaqResponse();
+}
+
+
+int ShadowExpSite::recvPending()
+{
+    if (replyPending == false)
+        return OF_ReturnType_completed;
+    
+    replyPending = false;
+    
+    return this->recvDaqResponse();
+}
+
+
+int ShadowExpSite::transfRecvDaqResponse()
+{
+    if (rDisp == 0)  {
+        if (getDaqSize(OF_Resp_Disp) != 0)
+            rDisp = new Vector(getDaqSize(OF_Resp_Disp));
+        if (getDaqSize(OF_Resp_Vel) != 0)
+            rVel = new Vector(getDaqSize(OF_Resp_Vel));
+        if (getDaqSize(OF_Resp_Accel) != 0)
+            rAccel = new Vector(getDaqSize(OF_Resp_Accel));
+        if (getDaqSize(OF_Resp_Force) != 0)
+            rForce = new Vector(getDaqSize(OF_Resp_Force));
+        if (getDaqSize(OF_Resp_Time) != 0)
+            rTime = new Vector(getDaqSize(OF_Resp_Time));
+    }
+    
+    int ndim = 0;
+    if (rDisp != 0)  {
+        rDisp->Extract(recvV, 0);
+        ndim += getDaqSize(OF_Resp_Disp);
     }
+    if (rVel != 0)  {
+        rVel->Extract(recvV, ndim);
+        ndim += getDaqSize(OF_Resp_Vel);
+    }
+    if (rAccel != 0)  {
+        rAccel->Extract(recvV, ndim);
+        ndim += getDaqSize(OF_Resp_Accel);
+    }
+    if (rForce != 0)  {
+        rForce->Extract(recvV, ndim);
+        ndim += getDaqSize(OF_Resp_Force);
+    }
+    if (rTime != 0)  {
+        rTime->Extract(recvV, ndim);
+    }
+    
+    if (theSetup != 0)  {
+        // set daq response at the setup
+        theSetup->setDaqResponse(rDisp, rVel, rAccel, rForce, rTime);
+        // transform daq response
+        ExpTimer transfTimer(OF_Timing_SetupDaq);
+        theSetup->transfDaqResponse(oDisp, oVel, oAccel, oForce, oTime);
+    } else  {
+        if (oDisp != 0) 
+            *oDisp = *rDisp;
+        if (oVel != 0) 
+            *oVel = *rVel;
+        if (oAccel != 0) 
+            *oAccel = *rAccel;
+        if (oForce != 0) 
+            *oForce = *rForce;
+        if (oTime != 0) 
+            *oTime = *rTime;
+    }
+    
+    // save data in basic sys
+    this->ExperimentalSite::setDaqResponse(oDisp, oVel, oAccel, oForce, oTime); 
+    
+    // set daq flag
+    daqFlag = true;
     
     return OF_ReturnType_completed;
 }
@@ -387,6 +512,9 @@ int ShadowExpSite::commitState(Vector* time)
 {
     int rValue = 0;
     
+    this->recvPending();
+    this->selectSite();
+    
     // update the trial time vector
     if (time != 0 && tTime != 0)  {
         *tTime = *time;
@@ -400,7 +528,7 @@ int ShadowExpSite::commitState(Vector* time)
     
     // first commit the ActorExpSite
     sendV(0) = OF_RemoteTest_commitState;
-    this->sendVector(sendV);
+    this->sendVector(sendV, numSendData);
     
     // then commit base class
     rValue += this->ExperimentalSite::commitState();
@@ -409,6 +537,125 @@ int ShadowExpSite::commitState(Vector* time)
 }
 
 
+void ShadowExpSite::openConnection(int protocol)
+{
+    // the open message is always sent with the fixed data size
+    // so that ActorExpSites without framed protocol can reply
+    sendV(0) = OF_RemoteTest_open;
+    sendV(1) = this->getTag();
+    sendV(2) = atof(OPF_VERSION);
+    sendV(3) = protocol;
+    sendV(4) = OF_RemoteTest_setTrialGetDaqResponse;
+    this->sendVector(sendV);
+    this->recvVector(recvV);
+    
+    if (recvV(2) != atof(OPF_VERSION))  {
+        opserr << "ShadowExpSite::ShadowExpSite() - OpenFresco Version "
+            << "mismatch:\nShadowExpSite Version " << atof(OPF_VERSION)
+            << " != ActorExpSite Version " << recvV(2) << endln;
+        exit(OF_ReturnType_failed);
+    }
+    
+    // legacy ActorExpSites reply with zero (fixed protocol)
+    if (protocol == OF_Network_framed && recvV(3) == OF_Network_framed)
+        this->setFramedMode(true);
+    
+    // use the combined step transaction if the ActorExpSite supports it
+    stepMode = (recvV(4) == OF_RemoteTest_setTrialGetDaqResponse);
+    
+    // other sites can share this connection if the ActorExpSite
+    // supports batches, which are only sent with the framed protocol
+    batchMode = (this->getFramedMode() == true && stepMode == true &&
+        recvV(5) == OF_RemoteTest_setTrialGetDaqBatch);
+    
+    opserr << "\nConnected to ActorExpSite "
+        << recvV(1) << endln;
+}
+
+
+int ShadowExpSite::selectSite()
+{
+    ShadowExpSite *theLead = (batchLead != 0) ? batchLead : this;
+    if (theLead->numBatchSites < 2)
+        return OF_ReturnType_completed;
+    
+    // the pending trial responses are sent first to keep the order
+    theLead->sendBatch();
+    
+    // the next message is addressed to this site
+    if (batchIndex > 0)  {
+        double data[2];
+        Vector selectV(data, 2);
+        data[0] = OF_RemoteTest_selectSite;
+        data[1] = batchIndex;
+        this->sendVector(selectV, 2);
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ShadowExpSite::sendBatch()
+{
+    // assemble the trial responses of the pending sites
+    int i, j, numSites = 0, numSend = 2, numRecv = 0;
+    for (i=0; i<numBatchSites; i++)  {
+        ShadowExpSite *theSite = batchSites[i];
+        if (theSite != 0 && theSite->trialPending == true)  {
+            batchSendV(numSend++) = i;
+            for (j=1; j<theSite->numSendData; j++)
+                batchSendV(numSend++) = theSite->sendV(j);
+            numRecv += theSite->numRecvData;
+            numSites++;
+        }
+    }
+    if (numSites == 0)
+        return OF_ReturnType_completed;
+    
+    // set trial responses and get daq responses in one transaction
+    batchSendV(0) = OF_RemoteTest_setTrialGetDaqBatch;
+    batchSendV(1) = numSites;
+    this->sendVector(batchSendV, numSend);
+    int numData = 0;
+    if (this->recvVector(batchRecvV, numData) < 0 || numData != numRecv)  {
+        opserr << "ShadowExpSite::sendBatch() - "
+            << "failed to receive daq response of batch.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    // transform the daq responses of the pending sites
+    numRecv = 0;
+    for (i=0; i<numBatchSites; i++)  {
+        ShadowExpSite *theSite = batchSites[i];
+        if (theSite != 0 && theSite->trialPending == true)  {
+            for (j=0; j<theSite->numRecvData; j++)
+                theSite->recvV(j) = batchRecvV(numRecv++);
+            theSite->trialPending = false;
+            theSite->transfRecvDaqResponse();
+        }
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+void ShadowExpSite::resizeBatch()
+{
+    ShadowExpSite *theLead = (batchLead != 0) ? batchLead : this;
+    
+    int sizeSend = 2, sizeRecv = 1;
+    for (int i=0; i<theLead->numBatchSites; i++)  {
+        ShadowExpSite *theSite = theLead->batchSites[i];
+        if (theSite != 0)  {
+            sizeSend += theSite->numSendData;
+            sizeRecv += theSite->numRecvData;
+        }
+    }
+    theLead->batchSendV.resize(sizeSend);
+    theLead->batchRecvV.resize(sizeRecv);
+}
+
+
 ExperimentalSite* ShadowExpSite::getCopy()
 {
     ShadowExpSite *theCopy = new ShadowExpSite(*this);
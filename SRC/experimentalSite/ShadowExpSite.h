@@ -48,12 +48,20 @@ public:
     ShadowExpSite(int tag, 
         Channel &theChannel,
         int dataSize = OF_Network_dataSize,
-        FEM_ObjectBroker *theObjectBroker = 0);
+        FEM_ObjectBroker *theObjectBroker = 0,
+        int protocol = OF_Network_framed);
     ShadowExpSite(int tag, 
         ExperimentalSetup *setup,
         Channel &theChannel,
         int dataSize = OF_Network_dataSize,
-        FEM_ObjectBroker *theObjectBroker = 0);
+        FEM_ObjectBroker *theObjectBroker = 0,
+        int protocol = OF_Network_framed);
+    // constructor for a site that shares the connection of batchSite
+    // and is stepped together with it in one batch transaction
+    ShadowExpSite(int tag, 
+        ExperimentalSetup *setup,
+        ShadowExpSite &batchSite,
+        int dataSize = OF_Network_dataSize);
     ShadowExpSite(const ShadowExpSite& es);
     
     // destructor
@@ -82,15 +90,52 @@ public:
     void Print(OPS_Stream &s, int flag = 0);
     
 protected:
+    // connect to ActorExpSite and negotiate the protocol
+    void openConnection(int protocol);
+    
+    // receive and transform the daq response
+    int recvDaqResponse();
+    int transfRecvDaqResponse();
+    
+    // receive the daq response of a trial response that was sent
+    // but whose reply was not received yet
+    int recvPending();
+    
+    // methods for sites of a batch, selectSite sends the pending
+    // batch and addresses the next message to this site, sendBatch
+    // sends the trial responses of all pending sites in one message
+    // and receives their daq responses in one reply
+    int selectSite();
+    int sendBatch();
+    void resizeBatch();
+    
     // data size of vectors in Channel
     int dataSize;
     
+    // number of data in trial and daq messages (framed protocol)
+    int numSendData;
+    int numRecvData;
+    
+    // flag if ActorExpSite replies to trial response with daq response
+    bool stepMode;
+    
     // vectors in Channel
     Vector sendV;
     Vector recvV;
     
     Vector *bDisp, *bVel, *bAccel, *bForce, *bTime;
     Vector *rDisp, *rVel, *rAccel, *rForce, *rTime;
+    
+    // batch of sites sharing the connection of the first site
+    ShadowExpSite *batchLead;   // first site of the batch (0 if this one)
+    int batchIndex;             // index of this site in the batch
+    ShadowExpSite **batchSites; // sites of the batch (first site only)
+    int numBatchSites;          // number of sites of the batch
+    bool batchMode;             // flag if ActorExpSite supports batches
+    bool trialPending;          // flag if trial response is not sent yet
+    bool replyPending;          // flag if daq response is not received yet
+    Vector batchSendV;          // batch trial message
+    Vector batchRecvV;          // batch daq reply
 };
 
 #endif
@@ -33,6 +33,7 @@
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <SharedMemoryChannel.h>
 
 #include <LocalExpSite.h>
 #include <ShadowExpSite.h>
@@ -198,15 +199,17 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
         if (5 > argc && argc > 9)  {
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
-            opserr << "Want: expSite ShadowSite tag <-setup setupTag> ipAddr ipPort <-udp> <-ssl> <-dataSize size>\n";
+            opserr << "Want: expSite ShadowSite tag <-setup setupTag> ipAddr ipPort <-udp> <-ssl> <-shm> <-dataSize size> <-protocol fixed/framed>\n"
+                << "  or: expSite ShadowSite tag <-setup setupTag> -batch siteTag <-dataSize size>\n";
             return TCL_ERROR;
         }
         
         int tag, setupTag, ipPort, argi;
         char *ipAddr;
-        int ssl = 0, udp = 0;
+        int ssl = 0, udp = 0, shm = 0;
         int noDelay = 0;
         int dataSize = OF_Network_dataSize;
+        int protocol = OF_Network_framed;
         ExperimentalSetup *theSetup = 0;
         Channel *theChannel = 0;
         ShadowExpSite *theSite = 0;
@@ -233,6 +236,52 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
             }
             argi++;
         }
+        // share the connection of another ShadowSite if provided,
+        // so that all sites are stepped in one batch transaction
+        if (strcmp(argv[argi], "-batch") == 0)  {
+            int batchTag;
+            argi++;
+            if (argi >= argc || Tcl_GetInt(interp, argv[argi], &batchTag) != TCL_OK)  {
+                opserr << "WARNING invalid batch siteTag\n";
+                opserr << "expSite ShadowSite " << tag << endln;
+                return TCL_ERROR;
+            }
+            ShadowExpSite *batchSite =
+                dynamic_cast <ShadowExpSite*> (getExperimentalSite(batchTag));
+            if (batchSite == 0)  {
+                opserr << "WARNING shadow experimental site not found\n";
+                opserr << "expSite: " << batchTag << endln;
+                opserr << "expSite ShadowSite " << tag << endln;
+                return TCL_ERROR;
+            }
+            argi++;
+            // check for optional arguments
+            for (int i = argi; i < argc; i++)  {
+                if (strcmp(argv[i], "-dataSize") == 0 && i+1 < argc)  {
+                    if (Tcl_GetInt(interp, argv[i+1], &dataSize) != TCL_OK)  {
+                        opserr << "WARNING invalid ShadowSite dataSize\n";
+                        opserr << "expSite ShadowSite " << tag << endln;
+                        return TCL_ERROR;
+                    }
+                }
+            }
+            
+            // parsing was successful, allocate the site
+            theSite = new ShadowExpSite(tag, theSetup, *batchSite, dataSize);
+            
+            if (theSite == 0)  {
+                opserr << "WARNING could not create experimental site " << argv[1] << endln;
+                return TCL_ERROR;
+            }
+            
+            // now add the site to the modelBuilder
+            if (addExperimentalSite(*theSite) < 0)  {
+                delete theSite; // invoke the destructor, otherwise mem leak
+                return TCL_ERROR;
+            }
+            
+            return TCL_OK;
+        }
         // get ip-address and ip-port
         ipAddr = new char [strlen(argv[argi])+1];
         strcpy(ipAddr,argv[argi]);
@@ -245,12 +294,15 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
         argi++;
         // check for optional arguments
         for (int i = argi; i < argc; i++)  {
-            if (strcmp(argv[i], "-ssl") == 0 && udp == 0)  {
+            if (strcmp(argv[i], "-ssl") == 0 && udp == 0 && shm == 0)  {
                 ssl = 1;
             }
-            else if (strcmp(argv[i], "-udp") == 0 && ssl == 0)  {
+            else if (strcmp(argv[i], "-udp") == 0 && ssl == 0 && shm == 0)  {
                 udp = 1;
             }
+            else if (strcmp(argv[i], "-shm") == 0 && ssl == 0 && udp == 0)  {
+                shm = 1;
+            }
             else if (strcmp(argv[i], "-noDelay") == 0)  {
                 noDelay = 1;
             }
@@ -261,6 +313,17 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
                     return TCL_ERROR;
                 }
             }
+            else if (strcmp(argv[i], "-protocol") == 0 && i+1 < argc)  {
+                if (strcmp(argv[i+1], "fixed") == 0)
+                    protocol = OF_Network_fixed;
+                else if (strcmp(argv[i+1], "framed") == 0)
+                    protocol = OF_Network_framed;
+                else  {
+                    opserr << "WARNING invalid ShadowSite protocol\n";
+                    opserr << "expSite ShadowSite " << tag << endln;
+                    return TCL_ERROR;
+                }
+            }
         }
         
         // setup the connection
@@ -280,6 +343,14 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
                 return TCL_ERROR;
             }
         }
+        else if (shm)  {
+            theChannel = new SharedMemoryChannel(ipPort,ipAddr);
+            if (!theChannel)  {
+                opserr << "WARNING could not create shared memory channel\n";
+                opserr << "expSite ShadowSite " << tag << endln;
+                return TCL_ERROR;
+            }
+        }
         else  {
             theChannel = new TCP_Socket(ipPort,ipAddr,true,noDelay);
             if (!theChannel)  {
@@ -291,9 +362,9 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
         
         // parsing was successful, allocate the site
         if (theSetup == 0)
-            theSite = new ShadowExpSite(tag, *theChannel, dataSize);
+            theSite = new ShadowExpSite(tag, *theChannel, dataSize, 0, protocol);
         else
-            theSite = new ShadowExpSite(tag, theSetup, *theChannel, dataSize);
+            theSite = new ShadowExpSite(tag, theSetup, *theChannel, dataSize, 0, protocol);
         
         if (theSite == 0)  {
             opserr << "WARNING could not create experimental site " << argv[1] << endln;
@@ -316,13 +387,15 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
         if (6 > argc || argc > 8)  {
             opserr << "WARNING invalid number of arguments\n";
             printCommand(argc,argv);
-            opserr << "Want: expSite ActorSite tag -setup setupTag ipPort <-udp> <-ssl>\n"
-                << "  or: expSite ActorSite tag -control ctrlTag ipPort <-udp> <-ssl>\n";
+            opserr << "Want: expSite ActorSite tag -setup setupTag ipPort <-udp> <-ssl> <-shm>\n"
+                << "  or: expSite ActorSite tag -control ctrlTag ipPort <-udp> <-ssl> <-shm>\n"
+                << "  or: expSite ActorSite tag -setup setupTag -batch siteTag\n"
+                << "  or: expSite ActorSite tag -control ctrlTag -batch siteTag\n";
             return TCL_ERROR;
         }
         
         int tag, setupTag, ctrlTag, ipPort, argi;
-        int ssl = 0, udp = 0;
+        int ssl = 0, udp = 0, shm = 0;
         int noDelay = 0;
         ExperimentalSetup *theSetup = 0;
         ExperimentalControl *theControl = 0;
@@ -366,6 +439,44 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
             }
             argi++;
         }
+        // share the connection of another ActorSite if provided,
+        // so that all sites are served in one batch transaction
+        if (strcmp(argv[argi], "-batch") == 0)  {
+            int batchTag;
+            argi++;
+            if (argi >= argc || Tcl_GetInt(interp, argv[argi], &batchTag) != TCL_OK)  {
+                opserr << "WARNING invalid batch siteTag\n";
+                opserr << "expSite ActorSite " << tag << endln;
+                return TCL_ERROR;
+            }
+            ActorExpSite *batchSite =
+                dynamic_cast <ActorExpSite*> (getExperimentalSite(batchTag));
+            if (batchSite == 0)  {
+                opserr << "WARNING actor experimental site not found\n";
+                opserr << "expSite: " << batchTag << endln;
+                opserr << "expSite ActorSite " << tag << endln;
+                return TCL_ERROR;
+            }
+            
+            // parsing was successful, allocate the site
+            if (theControl == 0)
+                theSite = new ActorExpSite(tag, theSetup, *batchSite);
+            else if (theSetup == 0)
+                theSite = new ActorExpSite(tag, theControl, *batchSite);
+            
+            if (theSite == 0)  {
+                opserr << "WARNING could not create experimental site " << argv[1] << endln;
+                return TCL_ERROR;
+            }
+            
+            // now add the site to the modelBuilder
+            if (addExperimentalSite(*theSite) < 0)  {
+                delete theSite; // invoke the destructor, otherwise mem leak
+                return TCL_ERROR;
+            }
+            
+            return TCL_OK;
+        }
         if (Tcl_GetInt(interp, argv[argi], &ipPort) != TCL_OK)  {
             opserr << "WARNING invalid ActorSite ipPort\n";
             opserr << "expSite ActorSite " << tag << endln;
@@ -374,12 +485,15 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
         argi++;
         // check for optional arguments
         for (int i = argi; i < argc; i++)  {
-            if (strcmp(argv[i], "-ssl") == 0 && udp == 0)  {
+            if (strcmp(argv[i], "-ssl") == 0 && udp == 0 && shm == 0)  {
                 ssl = 1;
             }
-            else if (strcmp(argv[i], "-udp") == 0 && ssl == 0)  {
+            else if (strcmp(argv[i], "-udp") == 0 && ssl == 0 && shm == 0)  {
                 udp = 1;
             }
+            else if (strcmp(argv[i], "-shm") == 0 && ssl == 0 && udp == 0)  {
+                shm = 1;
+            }
             else if (strcmp(argv[i], "-noDelay") == 0)  {
                 noDelay = 1;
             }
@@ -408,6 +522,17 @@ int TclExpSiteCommand(ClientData clientData, Tcl_Interp *interp,
                 return TCL_ERROR;
             }
         }
+        else if (shm)  {
+            theChannel = new SharedMemoryChannel(ipPort);
+            if (theChannel != 0) {
+                opserr << "\nShared Memory Channel successfully created: "
+                    << "Waiting for ShadowExpSite...\n";
+            } else {
+                opserr << "WARNING could not create shared memory channel\n";
+                opserr << "expSite ActorSite " << tag << endln;
+                return TCL_ERROR;
+            }
+        }
         else  {
             theChannel = new TCP_Socket(ipPort,true,noDelay);
             if (theChannel != 0) {
@@ -37,14 +37,16 @@
 
 
 ETBfgs::ETBfgs(int tag , double e)
-    : ExperimentalTangentStiff(tag), eps(e), theStiff(0)
+    : ExperimentalTangentStiff(tag), eps(e), theStiff(0),
+    tempDK1(0), tempDK2(0), tempKD(0), tempDK(0)
 {
     // does nothing
 }
 
 
 ETBfgs::ETBfgs(const ETBfgs& ets)
-    : ExperimentalTangentStiff(ets), theStiff(0)
+    : ExperimentalTangentStiff(ets), theStiff(0),
+    tempDK1(0), tempDK2(0), tempKD(0), tempDK(0)
 {
     eps = ets.eps;
 }
@@ -56,6 +58,14 @@ ETBfgs::~ETBfgs()
     // that the object still holds a pointer to
     if (theStiff != 0)
         delete theStiff;
+    if (tempDK1 != 0)
+        delete tempDK1;
+    if (tempDK2 != 0)
+        delete tempDK2;
+    if (tempKD != 0)
+        delete tempKD;
+    if (tempDK != 0)
+        delete tempDK;
 }
 
 
@@ -70,19 +80,26 @@ Matrix& ETBfgs::updateTangentStiff(
 {
     // using incremental disp and force
     int dimR = kPrev->noRows();
-    int dimC = kPrev->noCols();
     int szD	 = incrDisp->Size();
     
-    // FIX ME add size check
-    theStiff = new Matrix(dimR, dimC);
-    theStiff->Zero();
+    // the work space is only allocated if the size changes
+    if (theStiff == 0 || theStiff->noRows() != dimR)
+        this->setup(dimR);
+    
+    if (kPrev->noCols() != dimR || szD != dimR ||
+        incrForce->Size() != dimR || kInit->noRows() != dimR ||
+        kInit->noCols() != dimR)  {
+        opserr << "ETBfgs::updateTangentStiff() - "
+            << "wrong sizes of vectors or matrices passed\n";
+        theStiff->addMatrix(0.0, (*kPrev), 1.0);
+        return *theStiff;
+    }
     
     double normD = incrDisp->Norm();
     double normF = incrForce->Norm();
     double eFactor = eps*normD*normF;
     double fD = 0.0;
     double fNDK1, fNDK2;
-    Matrix tempDK1(dimR, dimC), tempDK2(dimR, dimC);
     
     // dot product between vectors
     int i;
@@ -93,18 +110,18 @@ Matrix& ETBfgs::updateTangentStiff(
     if (eFactor >= fD) {
         theStiff->addMatrix(0.0, (*kPrev), 1.0);
     } else {
-        this->calculateDeltaK(fD, incrDisp, incrForce, kInit, &tempDK1);
-        this->calculateDeltaK(fD, incrDisp, incrForce, kPrev, &tempDK2);
+        this->calculateDeltaK(fD, incrDisp, incrForce, kInit, tempDK1);
+        this->calculateDeltaK(fD, incrDisp, incrForce, kPrev, tempDK2);
         
-        fNDK1 = this->fNorm(&tempDK1);
-        fNDK2 = this->fNorm(&tempDK2);
+        fNDK1 = this->fNorm(tempDK1);
+        fNDK2 = this->fNorm(tempDK2);
         
         if (fNDK1 <= fNDK2) {
             theStiff->addMatrix(0.0, (*kInit), 1.0);
-            theStiff->addMatrix(1.0, tempDK1, 1.0);
+            theStiff->addMatrix(1.0, (*tempDK1), 1.0);
         } else {
             theStiff->addMatrix(0.0, (*kPrev), 1.0);
-            theStiff->addMatrix(1.0, tempDK2, 1.0);
+            theStiff->addMatrix(1.0, (*tempDK2), 1.0);
         }
     }
     
@@ -162,6 +179,31 @@ int ETBfgs::getResponse(int responseID,
 }
 
 
+int ETBfgs::setup(int numDOF)
+{
+    // delete the old work space
+    if (theStiff != 0)
+        delete theStiff;
+    if (tempDK1 != 0)
+        delete tempDK1;
+    if (tempDK2 != 0)
+        delete tempDK2;
+    if (tempKD != 0)
+        delete tempKD;
+    if (tempDK != 0)
+        delete tempDK;
+    
+    // allocate the new work space
+    theStiff = new Matrix(numDOF, numDOF);
+    tempDK1 = new Matrix(numDOF, numDOF);
+    tempDK2 = new Matrix(numDOF, numDOF);
+    tempKD = new Vector(numDOF);
+    tempDK = new Vector(numDOF);
+    
+    return OF_ReturnType_completed;
+}
+
+
 int ETBfgs::calculateDeltaK(double fD,
     const Vector* incrDisp,
     const Vector* incrForce,
@@ -171,32 +213,34 @@ int ETBfgs::calculateDeltaK(double fD,
     int numDOF = incrDisp->Size();
     double kFactor =  0.0;
     double invFD = 1.0/fD;
-    Vector tempKD(numDOF);
-    Matrix tempFD(numDOF, numDOF);
-    Matrix tempDF(numDOF, numDOF);
     
-    tempKD.Zero();
-    tempKD.addMatrixVector(0.0, (*k), (*incrDisp), 1.0);
-    dK->Zero();
+    // K*d and d'*K
+    int i, j;
+    tempKD->addMatrixVector(0.0, (*k), (*incrDisp), 1.0);
+    for (j=0; j<numDOF; j++) {
+        double sum = 0.0;
+        for (i=0; i<numDOF; i++)
+            sum += (*incrDisp)(i) * (*k)(i,j);
+        (*tempDK)(j) = sum;
+    }
     
     // dot product between vectors
-    int i, j;
     for (i=0; i<numDOF; i++) {
-        kFactor += (*incrDisp)(i) * tempKD(i);
+        kFactor += (*incrDisp)(i) * (*tempKD)(i);
     }
     kFactor = (1.0 + invFD*kFactor) * invFD;
     
-    for (i=0; i<numDOF; i++) {
-        for (j=0; j<numDOF; j++) {
-            (*dK)(i,j) = kFactor * (*incrForce)(i) * (*incrForce)(j);
-            tempFD(i,j) = invFD * (*incrForce)(i) * (*incrDisp)(j);
-            tempDF(i,j) = invFD * (*incrDisp)(i) * (*incrForce)(j);
+    // dK = kFactor*f*f' - (f*d')*K/fD - K*(d*f')/fD
+    // assembled from the outer products without forming f*d' or d*f'
+    for (j=0; j<numDOF; j++) {
+        double fj = (*incrForce)(j);
+        double dKj = invFD * (*tempDK)(j);
+        for (i=0; i<numDOF; i++) {
+            double fi = (*incrForce)(i);
+            (*dK)(i,j) = kFactor*fi*fj - fi*dKj - invFD*(*tempKD)(i)*fj;
         }
     }
     
-    dK->addMatrixProduct(1.0, tempFD, (*k), -1.0);
-    dK->addMatrixProduct(1.0, (*k), tempDF, -1.0);
-    
     return OF_ReturnType_completed;
 }
 
@@ -207,9 +251,9 @@ double ETBfgs::fNorm(const Matrix* dK)
     int i, j;
     double fN = 0.0;
     
-    for (i=0; i<numDOF; i++) {
-        for (j=0; j<numDOF; j++) {
-            fN += abs((*dK)(i,j) * (*dK)(i,j));
+    for (j=0; j<numDOF; j++) {
+        for (i=0; i<numDOF; i++) {
+            fN += (*dK)(i,j) * (*dK)(i,j);
         }
     }
     fN = sqrt(fN);
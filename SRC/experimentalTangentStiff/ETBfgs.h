@@ -73,6 +73,9 @@ public:
     int getResponse(int responseID, Information &info);
 
 private:
+    // utility method for sizing the work space
+    int setup(int numDOF);
+    
     // utility method for calculating the change in stiffness
     int calculateDeltaK(double fD,
         const Vector* incrDisp,
@@ -85,6 +88,12 @@ private:
     
     double eps;         // the user-defined factor for updating
     Matrix *theStiff;   // the tangent stiffness Matrix
+    
+    // work space allocated once in setup
+    Matrix *tempDK1;    // change in stiffness w.r.t. initial stiffness
+    Matrix *tempDK2;    // change in stiffness w.r.t. previous stiffness
+    Vector *tempKD;     // stiffness times incremental displacement
+    Vector *tempDK;     // incremental displacement times stiffness
 };
 
 #endif
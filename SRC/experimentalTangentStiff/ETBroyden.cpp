@@ -34,14 +34,14 @@
 
 
 ETBroyden::ETBroyden(int tag)
-    : ExperimentalTangentStiff(tag), theStiff(0)
+    : ExperimentalTangentStiff(tag), theStiff(0), tempV(0)
 {
     // does nothing
 }
 
 
 ETBroyden::ETBroyden(const ETBroyden& ets)
-    : ExperimentalTangentStiff(ets), theStiff(0)
+    : ExperimentalTangentStiff(ets), theStiff(0), tempV(0)
 {
     // does nothing
 }
@@ -53,6 +53,8 @@ ETBroyden::~ETBroyden()
     // that the object still holds a pointer to
     if (theStiff != 0)
         delete theStiff;
+    if (tempV != 0)
+        delete tempV;
 }
 
 
@@ -68,27 +70,34 @@ Matrix& ETBroyden::updateTangentStiff(
     // using incremental disp and force
     int dimR = kPrev->noRows();
     int dimC = kPrev->noCols();
-    int szD	 = incrDisp->Size();
     
-    // FIX ME add size check
-    theStiff = new Matrix(dimR, dimC);
-    theStiff->Zero();
+    // the work space is only allocated if the size changes
+    if (theStiff == 0 || theStiff->noRows() != dimR ||
+        theStiff->noCols() != dimC)
+        this->setup(dimR, dimC);
+    
+    if (incrDisp->Size() != dimC || incrForce->Size() != dimR)  {
+        opserr << "ETBroyden::updateTangentStiff() - "
+            << "wrong sizes of vectors or matrices passed\n";
+        theStiff->addMatrix(0.0, (*kPrev), 1.0);
+        return *theStiff;
+    }
     
     double normD = incrDisp->Norm();
     if (normD == 0.0) {
-        *theStiff = *kPrev;
+        theStiff->addMatrix(0.0, (*kPrev), 1.0);
     } else {
         double factor = 1.0/(normD*normD);
-        Vector tempV(szD);
-        tempV.Zero();
         
-        // perform rank 1 update
-        tempV.addMatrixVector(0.0, (*kPrev), (*incrDisp), 1.0);
-        tempV.addVector(-1.0, (*incrForce), 1.0);
+        // perform rank 1 update in place (kPrev is allowed to be
+        // the Matrix returned by the previous call)
+        tempV->addMatrixVector(0.0, (*kPrev), (*incrDisp), 1.0);
+        tempV->addVector(-1.0, (*incrForce), 1.0);
         
-        for (int i = 0; i < dimR; i++) {
-            for (int j = 0; j < dimC; j++) {
-                (*theStiff)(i,j) = (*kPrev)(i,j) + factor*tempV(i)*(*incrDisp)(j);
+        for (int j = 0; j < dimC; j++) {
+            double dj = factor*(*incrDisp)(j);
+            for (int i = 0; i < dimR; i++) {
+                (*theStiff)(i,j) = (*kPrev)(i,j) + (*tempV)(i)*dj;
             }
         }
     }
@@ -144,3 +153,19 @@ int ETBroyden::getResponse(int responseID,
         return OF_ReturnType_failed;
     }
 }
+
+
+int ETBroyden::setup(int numRows, int numCols)
+{
+    // delete the old work space
+    if (theStiff != 0)
+        delete theStiff;
+    if (tempV != 0)
+        delete tempV;
+    
+    // allocate the new work space
+    theStiff = new Matrix(numRows, numCols);
+    tempV = new Vector(numRows);
+    
+    return OF_ReturnType_completed;
+}
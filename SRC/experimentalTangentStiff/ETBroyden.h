@@ -70,7 +70,11 @@ public:
     int getResponse(int responseID, Information &info);
 
 private:
+    // utility method for sizing the work space
+    int setup(int numRows, int numCols);
+    
     Matrix *theStiff;  // the tangent stiffness Matrix
+    Vector *tempV;     // work space for the rank one update
 };
 
 #endif
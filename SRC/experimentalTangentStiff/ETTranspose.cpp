@@ -37,15 +37,18 @@
 
 
 ETTranspose::ETTranspose(int tag , int nC)
-    : ExperimentalTangentStiff(tag), numCol(nC),
-    theStiff(0), iDMatrix(0,0), iFMatrix(0,0)
+    : ExperimentalTangentStiff(tag), numCol(nC), theStiff(0),
+    iDMatrix(0), iFMatrix(0), numIncr(0), nextIncr(0),
+    tempDDT(0), tempDFT(0), theStiffT(0)
 {
     // does nothing
 }
 
 
 ETTranspose::ETTranspose(const ETTranspose& ets)
-    : ExperimentalTangentStiff(ets), theStiff(0)
+    : ExperimentalTangentStiff(ets), theStiff(0),
+    iDMatrix(0), iFMatrix(0), numIncr(0), nextIncr(0),
+    tempDDT(0), tempDFT(0), theStiffT(0)
 {
     numCol = ets.numCol;
 }
@@ -57,6 +60,16 @@ ETTranspose::~ETTranspose()
     // that the object still holds a pointer to
     if (theStiff != 0)
         delete theStiff;
+    if (iDMatrix != 0)
+        delete iDMatrix;
+    if (iFMatrix != 0)
+        delete iFMatrix;
+    if (tempDDT != 0)
+        delete tempDDT;
+    if (tempDFT != 0)
+        delete tempDFT;
+    if (theStiffT != 0)
+        delete theStiffT;
 }
 
 
@@ -71,66 +84,71 @@ Matrix& ETTranspose::updateTangentStiff(
 {
     // using incremental disp and force
     int dimR = kPrev->noRows();
-    int dimC = kPrev->noCols();
-    int szD	 = incrDisp->Size();
-    int dimCiDM = iDMatrix.noCols();
-    int i, j;
+    int i, j, k;
     
-    Matrix tempDM(dimR, dimCiDM);
-    Matrix tempFM(dimR, dimCiDM);
-    Matrix iDMatrixT, iFMatrixT, tempDDT(dimC, dimR), tempDFT(dimC, dimR), theStiffT(dimC, dimR);
-    // FIX ME add size check
-    theStiff = new Matrix(dimR, dimC);
-    theStiff->Zero();
-    theStiffT.Zero();
+    // the work space is only allocated if the size changes
+    if (theStiff == 0 || theStiff->noRows() != dimR)
+        this->setup(dimR);
     
-    // append the incremental vectors to matrices
-    if (dimCiDM < numCol) {
-        // copy all entries from the existing matrices
-        for (i=0; i<dimR; i++) {
-            for (j=0; j<dimCiDM; j++) {
-                tempDM(i,j) = iDMatrix(i,j);
-                tempFM(i,j) = iFMatrix(i,j);
-            }
-        }
-        iDMatrix.resize(dimR, dimCiDM +1);
-        iFMatrix.resize(dimR, dimCiDM +1);
-        for (i=0; i<dimR; i++) {
-            for (j=0; j<dimCiDM; j++) {
-                iDMatrix(i,j) = tempDM(i,j);
-                iFMatrix(i,j) = tempFM(i,j);
+    if (kPrev->noCols() != dimR || incrDisp->Size() != dimR ||
+        incrForce->Size() != dimR || kInit->noRows() != dimR ||
+        kInit->noCols() != dimR)  {
+        opserr << "ETTranspose::updateTangentStiff() - "
+            << "wrong sizes of vectors or matrices passed\n";
+        theStiff->addMatrix(0.0, (*kPrev), 1.0);
+        return *theStiff;
+    }
+    
+    // store the incremental vectors, replacing the oldest ones
+    // once numCol increments have been stored
+    for (j=0; j<dimR; j++) {
+        (*iDMatrix)(nextIncr,j) = (*incrDisp)(j);
+        (*iFMatrix)(nextIncr,j) = (*incrForce)(j);
+    }
+    nextIncr = (nextIncr+1) % numCol;
+    if (numIncr < numCol)
+        numIncr++;
+    
+    // check how many increments are stored
+    if (numIncr < dimR) {
+        theStiff->addMatrix(0.0, (*kInit), 1.0);
+        return *theStiff;
+    } else if (numIncr == dimR) {
+        // solve D'*K' = F'
+        for (j=0; j<dimR; j++) {
+            for (i=0; i<dimR; i++) {
+                (*tempDDT)(i,j) = (*iDMatrix)(i,j);
+                (*tempDFT)(i,j) = (*iFMatrix)(i,j);
             }
         }
-        for (i=0; i<dimC; i++) {
-            iDMatrix(i, dimCiDM) = (*incrDisp)(i);
-            iFMatrix(i, dimCiDM) = (*incrForce)(i);
-        }
-    } else if (dimCiDM == numCol) {
-        for (i=0; i<dimR; i++) {
-            for (j=0; j<(dimCiDM-1); j++) {
-                iDMatrix(i,j) = iDMatrix(i,j+1);
-                iFMatrix(i,j) = iFMatrix(i,j+1);
+    } else {
+        // solve (D*D')*K' = D*F' in the least squares sense
+        tempDDT->Zero();
+        tempDFT->Zero();
+        for (k=0; k<numIncr; k++) {
+            for (j=0; j<dimR; j++) {
+                double dkj = (*iDMatrix)(k,j);
+                double fkj = (*iFMatrix)(k,j);
+                for (i=0; i<dimR; i++) {
+                    double dki = (*iDMatrix)(k,i);
+                    (*tempDDT)(i,j) += dki*dkj;
+                    (*tempDFT)(i,j) += dki*fkj;
+                }
             }
         }
-        for (i=0; i<dimR; i++) {
-            iDMatrix(i, dimCiDM-1) = (*incrDisp)(i);
-            iFMatrix(i, dimCiDM-1) = (*incrForce)(i);
-        }
     }
-    this->MatTranspose(&iDMatrixT, &iDMatrix);
-    this->MatTranspose(&iFMatrixT, &iFMatrix);
     
-    // check how many columns are in iDMatrix
-    if ((dimCiDM+1) < dimC) {
-        theStiff->addMatrix(0.0, (*kInit), 1.0);
-    } else if ((dimCiDM+1) == dimC) {
-        iDMatrixT.Solve(iFMatrixT, theStiffT);
-        this->MatTranspose(theStiff, &theStiffT);
-    } else {
-        tempDDT.addMatrixProduct(0.0, iDMatrix, iDMatrixT, 1.0);
-        tempDFT.addMatrixProduct(0.0, iDMatrix, iFMatrixT, 1.0);
-        tempDDT.Solve(tempDFT, theStiffT);
-        this->MatTranspose(theStiff, &theStiffT);
+    // keep the previous stiffness if the increments are dependent
+    if (tempDDT->Solve(*tempDFT, *theStiffT) < 0) {
+        theStiff->addMatrix(0.0, (*kPrev), 1.0);
+        return *theStiff;
+    }
+    
+    // transpose the solution
+    for (j=0; j<dimR; j++) {
+        for (i=0; i<dimR; i++) {
+            (*theStiff)(i,j) = (*theStiffT)(j,i);
+        }
     }
     
     return *theStiff;
@@ -187,19 +205,33 @@ int ETTranspose::getResponse(int responseID,
 }
 
 
-int ETTranspose::MatTranspose(Matrix* kT, const Matrix* k)
+int ETTranspose::setup(int numDOF)
 {
-    int dimR = k->noRows();
-    int dimC = k->noCols();
-    kT->resize(dimC,dimR);
+    // delete the old work space
+    if (theStiff != 0)
+        delete theStiff;
+    if (iDMatrix != 0)
+        delete iDMatrix;
+    if (iFMatrix != 0)
+        delete iFMatrix;
+    if (tempDDT != 0)
+        delete tempDDT;
+    if (tempDFT != 0)
+        delete tempDFT;
+    if (theStiffT != 0)
+        delete theStiffT;
     
-    int i, j;
-    //transpose matrix
-    for (i=0; i<dimC; i++) {
-        for (j=0; j<dimR; j++) {
-            (*kT)(i,j) = (*k)(j,i);
-        }
-    }
+    // allocate the new work space
+    theStiff = new Matrix(numDOF, numDOF);
+    iDMatrix = new Matrix(numCol, numDOF);
+    iFMatrix = new Matrix(numCol, numDOF);
+    tempDDT = new Matrix(numDOF, numDOF);
+    tempDFT = new Matrix(numDOF, numDOF);
+    theStiffT = new Matrix(numDOF, numDOF);
+    
+    // the stored increments are no longer valid
+    numIncr = 0;
+    nextIncr = 0;
     
     return OF_ReturnType_completed;
 }
@@ -73,11 +73,23 @@ public:
     int getResponse(int responseID, Information &info);
 
 private:
+    // utility method for sizing the work space
+    int setup(int numDOF);
+    
     int numCol;         // number of cols to be used
     Matrix *theStiff;   // the tangent stiffness Matrix
-    Matrix iDMatrix;    // the incremental displacement Matrix
-    Matrix iFMatrix;    // the incremental force Matrix
-    int MatTranspose(Matrix* kT, const Matrix* k);  // transpose method
+    
+    // the last numCol increments are stored as rows of the
+    // following matrices, overwriting the oldest one when full
+    Matrix *iDMatrix;   // the incremental displacement Matrix (transposed)
+    Matrix *iFMatrix;   // the incremental force Matrix (transposed)
+    int numIncr;        // number of increments stored
+    int nextIncr;       // row the next increment is stored in
+    
+    // work space allocated once in setup
+    Matrix *tempDDT;    // coefficient Matrix of the transposed system
+    Matrix *tempDFT;    // right hand side of the transposed system
+    Matrix *theStiffT;  // the transposed tangent stiffness Matrix
 };
 
 #endif
@@ -194,7 +194,7 @@ int TclExpTangentStiffCommand(ClientData clientData, Tcl_Interp *interp,
             opserr << "WARNING invalid expTangentStiff tag\n";
             return TCL_ERROR;
         }
-        if (Tcl_GetInt(interp, argv[3], &numCols) != TCL_OK)  {
+        if (Tcl_GetInt(interp, argv[3], &numCols) != TCL_OK || numCols < 1)  {
             opserr << "WARNING invalid number of columns value\n";
             opserr << "expTangentStiff Transpose " << tag << endln;
             return TCL_ERROR;
@@ -32,7 +32,9 @@
 //
 // Purpose: This file is the C++ sample standalone program for 
 // testing experimental tangent object.  The test is done against
-// the results produced in matlab
+// the results produced in matlab.  Afterwards a stress test runs
+// a million updates of each tangent stiffness type and checks that
+// the resident memory stays constant.
 
 // standard C++ includes
 #include <stdlib.h>
@@ -40,6 +42,13 @@
 #include <fstream>
 using namespace std;
 
+#if defined(__linux__)
+#include <stdio.h>
+#include <unistd.h>
+#elif !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
 #include <OPS_Globals.h>
 #include <StandardStream.h>
 
@@ -53,6 +62,80 @@ using namespace std;
 StandardStream sserr;
 OPS_Stream opserr = &sserr;
 
+// returns the resident memory in kB (0 if not available)
+static long getResidentMemory()
+{
+#if defined(__linux__)
+	long size = 0, resident = 0;
+	FILE *statm = fopen("/proc/self/statm", "r");
+	if (statm == 0)
+		return 0;
+	if (fscanf(statm, "%ld %ld", &size, &resident) != 2)
+		resident = 0;
+	fclose(statm);
+	return resident*(sysconf(_SC_PAGESIZE)/1024);
+#elif !defined(_WIN32)
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+#else
+	return 0;
+#endif
+}
+
+
+// runs numUpdates updates with increments of a linear specimen plus
+// noise and checks that the resident memory stays constant
+static int stressTest(ExperimentalTangentStiff *theTangentStiff,
+	int numDOF, int numUpdates)
+{
+	Vector Ddisp(numDOF), Dforce(numDOF);
+	Matrix KInit(numDOF,numDOF), KTrue(numDOF,numDOF);
+	int i, j, n;
+	
+	for (i=0; i<numDOF; i++) {
+		for (j=0; j<numDOF; j++) {
+			KTrue(i,j) = (i == j) ? 10.0*(i+2) : -1.0;
+			KInit(i,j) = 1.2*KTrue(i,j);
+		}
+	}
+	
+	unsigned int seed = 12345;
+	const Matrix *K = &KInit;
+	long rssStart = 0;
+	for (n=0; n<numUpdates; n++) {
+		if (n == 1000)
+			rssStart = getResidentMemory();
+		
+		for (i=0; i<numDOF; i++) {
+			seed = 1664525*seed + 1013904223;
+			Ddisp(i) = (double)(seed >> 8)/(1 << 24) - 0.5;
+		}
+		Dforce.addMatrixVector(0.0, KTrue, Ddisp, 1.0);
+		for (i=0; i<numDOF; i++) {
+			seed = 1664525*seed + 1013904223;
+			Dforce(i) += 0.01*((double)(seed >> 8)/(1 << 24) - 0.5);
+		}
+		
+		// the returned stiffness is passed back as previous stiffness
+		K = &theTangentStiff->updateTangentStiff(&Ddisp, (Vector*)0,
+			(Vector*)0, &Dforce, (Vector*)0, &KInit, K);
+	}
+	long rssEnd = getResidentMemory();
+	
+	opserr << theTangentStiff->getClassType() << ": " << numUpdates
+		<< " updates, resident memory " << (int)rssStart << " kB -> "
+		<< (int)rssEnd << " kB, K(0,0) = " << (*K)(0,0) << endln;
+	
+	if (rssEnd > rssStart + 64) {
+		opserr << "FAILED: resident memory grew during the updates\n";
+		return -1;
+	}
+	
+	return 0;
+}
+
+
 // main routine
 int main(int argc, char **argv)
 {
@@ -193,6 +276,21 @@ int main(int argc, char **argv)
 		}
 		opserr << endln;
 	}
-  return 0;
+	delete theTangentStiff;
+	
+	// run the stress tests
+	int numUpdates = 1000000;
+	int result = 0;
+	ExperimentalTangentStiff *theStressTangentStiff[3];
+	theStressTangentStiff[0] = new ETBroyden(2);
+	theStressTangentStiff[1] = new ETBfgs(3);
+	theStressTangentStiff[2] = new ETTranspose(4, 12);
+	for (i=0; i<3; i++) {
+		if (stressTest(theStressTangentStiff[i], 6, numUpdates) < 0)
+			result = 1;
+		delete theStressTangentStiff[i];
+	}
+	
+  return result;
 }	
 	
@@ -37,9 +37,12 @@
 #include <Message.h>
 #include <MovableObject.h>
 #include <FEM_ObjectBroker.h>
+#include <Vector.h>
 int Channel::numChannel = 0;
 
 Channel::Channel ()
+  :sendSeqNum(0), recvSeqNum(0), framedMode(false),
+   frameData(0), frameSize(0)
 {
 	numChannel++;
 	tag = numChannel;
@@ -47,7 +50,8 @@ Channel::Channel ()
 
 Channel::~Channel()
 {
-    
+  if (frameData != 0)
+    delete [] frameData;
 }    
 
 int
@@ -67,3 +71,88 @@ Channel::getTag(void)
 {
 		return tag;
 }
+
+int
+Channel::sendFramedVector(int dbTag, int commitTag,
+			  const Vector &theVector, int numData,
+			  ChannelAddress *theAddress)
+{
+  if (numData < 1 || numData > theVector.Size()) {
+    opserr << "Channel::sendFramedVector() - invalid number of data "
+	   << numData << endln;
+    return -1;
+  }
+
+  if (!framedMode) {
+    framedMode = true;
+    this->setNoDelay(1);
+  }
+
+  // the header and the payload are sent as one message, so that a
+  // stream socket does not hold back the payload (Nagle algorithm)
+  if (numData+2 > frameSize) {
+    if (frameData != 0)
+      delete [] frameData;
+    frameSize = numData+2;
+    frameData = new double [frameSize];
+  }
+
+  // the header carries the first entry (the action for requests),
+  // the payload length and the sequence number
+  frameData[0] = theVector(0);
+  frameData[1] = numData - 1;
+  frameData[2] = ++sendSeqNum;
+  for (int i=1; i<numData; i++)
+    frameData[i+2] = theVector(i);
+
+  Vector theFrame(frameData, numData+2);
+  return this->sendVector(dbTag, commitTag, theFrame, theAddress);
+}
+
+int
+Channel::recvFramedVector(int dbTag, int commitTag,
+			  Vector &theVector, int &numData,
+			  ChannelAddress *theAddress)
+{
+  if (!framedMode) {
+    framedMode = true;
+    this->setNoDelay(1);
+  }
+
+  // stream channels receive the header and the payload of the
+  // frame with two reads
+  double header[3];
+  Vector theHeader(header, 3);
+
+  int res = this->recvVector(dbTag, commitTag, theHeader, theAddress);
+  if (res < 0)
+    return res;
+
+  numData = 1 + (int)header[1];
+  if (numData > theVector.Size()) {
+    opserr << "Channel::recvFramedVector() - payload of size " << numData
+	   << " does not fit into vector of size " << theVector.Size() << endln;
+    return -2;
+  }
+
+  // a gap in the sequence numbers means messages were lost (UDP)
+  recvSeqNum++;
+  if ((int)header[2] != recvSeqNum) {
+    opserr << "Channel::recvFramedVector() - WARNING expected message "
+	   << recvSeqNum << " but received " << (int)header[2] << endln;
+    recvSeqNum = (int)header[2];
+  }
+
+  theVector(0) = header[0];
+  if (numData == 1)
+    return res;
+
+  Vector thePayload(&theVector(1), numData-1);
+  return this->recvVector(dbTag, commitTag, thePayload, theAddress);
+}
+
+int
+Channel::setNoDelay(int noDelay)
+{
+  return 0;
+}
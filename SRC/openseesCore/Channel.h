@@ -109,7 +109,30 @@ class Channel
 		    ID &theID, 
 		    ChannelAddress *theAddress =0) =0;      
 
+    // methods to send/receive vectors with a small header
+    // (first entry, payload length, sequence number) followed
+    // by a payload of exactly numData-1 entries
+    virtual int sendFramedVector(int dbTag, int commitTag, 
+			const Vector &theVector, int numData,
+			ChannelAddress *theAddress =0);  
+
+    virtual int recvFramedVector(int dbTag, int commitTag, 
+			Vector &theVector, int &numData,
+			ChannelAddress *theAddress =0);  
+
+    // method to switch off the Nagle algorithm on stream sockets,
+    // called when the first framed vector is sent or received
+    virtual int setNoDelay(int noDelay);
+
   protected:
+    int sendSeqNum;
+    int recvSeqNum;
+    bool framedMode;        // framed vectors have been sent/received
+    
+    // contiguous buffer for the header and the payload of framed
+    // vectors, only grows if a larger frame is sent
+    double *frameData;
+    int frameSize;
     
   private:
     static int numChannel;
@@ -160,6 +160,7 @@ class Matrix
     friend class Message;
     friend class UDP_Socket;
     friend class TCP_Socket;
+    friend class SharedMemoryChannel;
     friend class TCP_SocketSSL;
     friend class TCP_SocketNoDelay;
     friend class MPI_Channel;
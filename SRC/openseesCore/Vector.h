@@ -136,6 +136,7 @@ class Vector
     friend class Matrix;
     friend class UDP_Socket;
     friend class TCP_Socket;
+    friend class SharedMemoryChannel;
     friend class TCP_SocketSSL;
     friend class TCP_SocketNoDelay;    
     friend class MPI_Channel;
@@ -50,7 +50,7 @@ Actor::Actor(Channel &theChan,
 	     int numActorMethods)
 :theBroker(&myBroker), theChannel(&theChan),
  numMethods(0), maxNumMethods(numActorMethods), actorMethods(0), 
- theRemoteShadowsAddress(0), commitTag(0)
+ theRemoteShadowsAddress(0), commitTag(0), framedMode(false)
 {
     // call setUpActor on the channel and get shadows address
     if (theChannel->setUpConnection() != 0)  {
@@ -216,19 +216,37 @@ Actor::recvMatrix(Matrix &theMatrix, ChannelAddress *theAddress )
 int
 Actor::sendVector(const Vector &theVector, ChannelAddress *theAddress )
 {
-    if (theAddress == 0)
-	return theChannel->sendVector(0, commitTag, theVector,theRemoteShadowsAddress);
-    else
-	return theChannel->sendVector(0, commitTag, theVector,theAddress);	
+    return this->sendVector(theVector, theVector.Size(), theAddress);
 }
 
 int
 Actor::recvVector(Vector &theVector, ChannelAddress *theAddress )
+{
+    int numData;
+    return this->recvVector(theVector, numData, theAddress);
+}
+
+int
+Actor::sendVector(const Vector &theVector, int numData,
+		  ChannelAddress *theAddress )
 {
     if (theAddress == 0)
-	return theChannel->recvVector(0, commitTag, theVector,theRemoteShadowsAddress);
-    else
-	return theChannel->recvVector(0, commitTag, theVector,theAddress);	
+	theAddress = theRemoteShadowsAddress;
+    if (framedMode)
+	return theChannel->sendFramedVector(0, commitTag, theVector, numData, theAddress);
+    return theChannel->sendVector(0, commitTag, theVector, theAddress);
+}
+
+int
+Actor::recvVector(Vector &theVector, int &numData,
+		  ChannelAddress *theAddress )
+{
+    if (theAddress == 0)
+	theAddress = theRemoteShadowsAddress;
+    if (framedMode)
+	return theChannel->recvFramedVector(0, commitTag, theVector, numData, theAddress);
+    numData = theVector.Size();
+    return theChannel->recvVector(0, commitTag, theVector, theAddress);
 }
 
 int
@@ -257,6 +275,20 @@ Actor::setCommitTag(int tag)
 }
 
 
+void
+Actor::setFramedMode(bool framed)
+{
+  framedMode = framed;
+}
+
+
+bool
+Actor::getFramedMode(void) const
+{
+  return framedMode;
+}
+
+
 Channel *
 Actor::getChannelPtr(void) const
 {
@@ -99,6 +99,14 @@ class Actor
     virtual int barrierCheck(int result);
     void setCommitTag(int commitTag);
 
+    // methods for the variable-length framed protocol
+    virtual int sendVector(const Vector &theVector, int numData,
+			   ChannelAddress *theAddress =0);   
+    virtual int recvVector(Vector &theVector, int &numData,
+			   ChannelAddress *theAddress =0);  
+    void setFramedMode(bool framed);
+    bool getFramedMode(void) const;
+
   protected:
     FEM_ObjectBroker *theBroker; 
     Channel *theChannel;    
@@ -109,6 +117,7 @@ class Actor
     ChannelAddress *theRemoteShadowsAddress;
 
     int commitTag;
+    bool framedMode;
 };
 
 #endif
@@ -45,7 +45,7 @@
 Shadow::Shadow(Channel &theChan, 
 	       FEM_ObjectBroker &myBroker)
   :theChannel(&theChan), theObjectBroker(&myBroker), theMachineBroker(0),
-   theRemoteActorsAddress(0), commitTag(0)
+   theRemoteActorsAddress(0), commitTag(0), framedMode(false)
 {
   if (theChannel->setUpConnection() != 0)  {
     opserr << "Shadow::Shadow() "
@@ -59,7 +59,7 @@ Shadow::Shadow(Channel &theChan,
 	       FEM_ObjectBroker &myBroker,
 	       ChannelAddress &theAddress)
   :theChannel(&theChan), theObjectBroker(&myBroker), theMachineBroker(0),
-   theRemoteActorsAddress(&theAddress), commitTag(0)
+   theRemoteActorsAddress(&theAddress), commitTag(0), framedMode(false)
 {
   if (theChannel->setUpConnection() != 0)  {
     opserr << "Shadow::Shadow() "
@@ -73,7 +73,7 @@ Shadow::Shadow(int actorType,
 	       MachineBroker &theMachineBrokr,
 	       int compDemand)
   :theObjectBroker(&myBroker), theMachineBroker(&theMachineBrokr), 
-   theRemoteActorsAddress(0), commitTag(0)
+   theRemoteActorsAddress(0), commitTag(0), framedMode(false)
 {
     // start the remote actor process running
   theChannel = theMachineBroker->startActor(actorType, compDemand);
@@ -138,12 +138,32 @@ Shadow::recvMatrix(Matrix &theMatrix)
 int
 Shadow::sendVector(const Vector &theVector)
 {
-    return theChannel->sendVector(0, commitTag, theVector, theRemoteActorsAddress);
+    return this->sendVector(theVector, theVector.Size());
 }
 
 int
 Shadow::recvVector(Vector &theVector)
 {
+    int numData;
+    return this->recvVector(theVector, numData);
+}
+
+int
+Shadow::sendVector(const Vector &theVector, int numData)
+{
+    if (framedMode)
+	return theChannel->sendFramedVector(0, commitTag, theVector,
+	    numData, theRemoteActorsAddress);
+    return theChannel->sendVector(0, commitTag, theVector, theRemoteActorsAddress);
+}
+
+int
+Shadow::recvVector(Vector &theVector, int &numData)
+{
+    if (framedMode)
+	return theChannel->recvFramedVector(0, commitTag, theVector,
+	    numData, theRemoteActorsAddress);
+    numData = theVector.Size();
     return theChannel->recvVector(0, commitTag, theVector, theRemoteActorsAddress);
 }
 
@@ -167,6 +187,20 @@ Shadow::setCommitTag(int tag)
 }
 
 
+void
+Shadow::setFramedMode(bool framed)
+{
+  framedMode = framed;
+}
+
+
+bool
+Shadow::getFramedMode(void) const
+{
+  return framedMode;
+}
+
+
 Channel *
 Shadow::getChannelPtr(void) const
 {
@@ -77,6 +77,12 @@ class Shadow
     virtual int recvID(ID &theID);      
     void setCommitTag(int commitTag);
 
+    // methods for the variable-length framed protocol
+    virtual int sendVector(const Vector &theVector, int numData);  
+    virtual int recvVector(Vector &theVector, int &numData);      
+    void setFramedMode(bool framed);
+    bool getFramedMode(void) const;
+
     Channel 		  *getChannelPtr(void) const;
     FEM_ObjectBroker 	  *getObjectBrokerPtr(void) const;        
     ChannelAddress        *getActorAddressPtr(void) const;
@@ -89,6 +95,7 @@ class Shadow
   private:
     ChannelAddress 	  *theRemoteActorsAddress;    
     int commitTag;
+    bool framedMode;
 };
 
 #endif
@@ -0,0 +1,642 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of the
+// SharedMemoryChannel class.
+
+#include "SharedMemoryChannel.h"
+
+#include <Matrix.h>
+#include <Vector.h>
+#include <ExpTiming.h>
+#include <ID.h>
+#include <Message.h>
+#include <MovableObject.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <errno.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+using std::chrono::steady_clock;
+using std::chrono::duration;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+// size of the ring of each direction [bytes], must be a power of two
+// so that the byte counters can wrap around
+static const unsigned int SHM_ringSize = 1 << 18;
+
+// time [sec] a waiting process polls the ring before it blocks
+static const double SHM_spinTime = 50.0e-6;
+
+// connection state of the shared memory region
+enum SHM_State  {
+    SHM_created = 0,
+    SHM_listening = 1,
+    SHM_connected = 2,
+    SHM_closed = 3
+};
+
+// one direction of the connection, head and tail count the bytes
+// that were written and read (modulo 2^32), the wait flags are set
+// by a process that is blocked on the head or the tail
+struct SHM_Ring
+{
+    alignas(64) std::atomic<unsigned int> head;
+    std::atomic<unsigned int> headWait;
+    alignas(64) std::atomic<unsigned int> tail;
+    std::atomic<unsigned int> tailWait;
+    alignas(64) char data[SHM_ringSize];
+};
+
+// ring[0] is written by the connecting process and ring[1] by the
+// process that created the region
+struct SharedMemoryRegion
+{
+    alignas(64) std::atomic<unsigned int> state;
+    std::atomic<int> pid[2];
+    SHM_Ring ring[2];
+};
+
+
+// block until word differs from value or the timeout [msec] expires
+static void shmBlock(std::atomic<unsigned int> &word,
+    unsigned int value, int timeout)
+{
+#if defined(__linux__)
+    struct timespec ts;
+    ts.tv_sec = timeout/1000;
+    ts.tv_nsec = (timeout%1000)*1000000L;
+    syscall(SYS_futex, (unsigned int *)&word, FUTEX_WAIT, value, &ts, 0, 0);
+#else
+    // no cross-process wait on the word, sleep shortly instead
+    if (word.load() == value)
+        std::this_thread::sleep_for(microseconds(50));
+#endif
+}
+
+
+// wake a process blocked on word
+static void shmWake(std::atomic<unsigned int> &word,
+    std::atomic<unsigned int> &waitFlag)
+{
+    if (waitFlag.load() != 0)  {
+#if defined(__linux__)
+        syscall(SYS_futex, (unsigned int *)&word, FUTEX_WAKE, 1, 0, 0, 0);
+#endif
+    }
+}
+
+
+// check if the peer process still exists
+static bool shmPeerAlive(int pid)
+{
+#ifdef _WIN32
+    return true;
+#else
+    return (pid <= 0 || kill(pid, 0) == 0 || errno != ESRCH);
+#endif
+}
+
+
+// wait until word differs from value, the ring is first polled for
+// SHM_spinTime and then the process blocks, returns false if the
+// peer closed the connection (or died) before word changed
+static bool shmWait(SharedMemoryRegion *region, int peerPid,
+    std::atomic<unsigned int> &word,
+    std::atomic<unsigned int> &waitFlag, unsigned int value)
+{
+    // poll the ring, which is fastest if the peer responds quickly
+    steady_clock::time_point tStart = steady_clock::now();
+    int i = 0;
+    while (word.load(std::memory_order_acquire) == value)  {
+        if (region->state.load() == SHM_closed)
+            return (word.load() != value);
+        if (++i % 64 == 0)  {
+            if (duration<double>(steady_clock::now()-tStart).count() > SHM_spinTime)
+                break;
+            std::this_thread::yield();
+        }
+    }
+
+    // then block until the peer wakes this process up, the flag is
+    // set before the word is checked again so that no wake up is lost
+    while (word.load(std::memory_order_acquire) == value)  {
+        waitFlag.store(1);
+        if (word.load() == value)
+            shmBlock(word, value, 100);
+        waitFlag.store(0);
+        if (word.load() == value &&
+            (region->state.load() == SHM_closed || !shmPeerAlive(peerPid)))
+            return false;
+    }
+
+    return true;
+}
+
+
+// SharedMemoryChannel(unsigned int port):
+//	constructor for the process that creates the region and waits
+//	for the other process to connect.
+SharedMemoryChannel::SharedMemoryChannel(unsigned int port)
+    : myPort(port), connectType(0), theRegion(0),
+    sendRing(1), recvRing(0), peerPid(0)
+{
+#ifdef _WIN32
+    hMapping = 0;
+    sprintf(name, "Local\\OpenFresco_%u", port);
+#else
+    fd = -1;
+    sprintf(name, "/OpenFresco_%u", port);
+#endif
+}
+
+
+// SharedMemoryChannel(unsigned int other_Port, char *other_InetAddr):
+//	constructor for the process that connects to the region created
+//	by the other process, the address must be the local machine.
+SharedMemoryChannel::SharedMemoryChannel(unsigned int other_Port,
+    const char *other_InetAddr)
+    : myPort(other_Port), connectType(1), theRegion(0),
+    sendRing(0), recvRing(1), peerPid(0)
+{
+#ifdef _WIN32
+    hMapping = 0;
+    sprintf(name, "Local\\OpenFresco_%u", other_Port);
+#else
+    fd = -1;
+    sprintf(name, "/OpenFresco_%u", other_Port);
+#endif
+    if (other_InetAddr != 0 && strcmp(other_InetAddr, "127.0.0.1") != 0 &&
+        strcmp(other_InetAddr, "localhost") != 0)  {
+        opserr << "SharedMemoryChannel::SharedMemoryChannel() - WARNING "
+            << "address " << other_InetAddr << " is assumed to be the "
+            << "local machine\n";
+    }
+}
+
+
+// ~SharedMemoryChannel():
+//	destructor
+SharedMemoryChannel::~SharedMemoryChannel()
+{
+    if (theRegion != 0)  {
+        // wake the peer so that it sees the closed connection
+        theRegion->state.store(SHM_closed);
+        for (int i=0; i<2; i++)  {
+            shmWake(theRegion->ring[i].head, theRegion->ring[i].headWait);
+            shmWake(theRegion->ring[i].tail, theRegion->ring[i].tailWait);
+        }
+#ifdef _WIN32
+        UnmapViewOfFile(theRegion);
+#else
+        munmap(theRegion, sizeof(SharedMemoryRegion));
+#endif
+    }
+#ifdef _WIN32
+    if (hMapping != 0)
+        CloseHandle((HANDLE)hMapping);
+#else
+    if (fd >= 0)
+        close(fd);
+    // remove the name if no process connected
+    if (connectType == 0)
+        shm_unlink(name);
+#endif
+}
+
+
+int
+SharedMemoryChannel::setUpConnection()
+{
+    if (connectType == 0)  {
+        // create the region
+#ifdef _WIN32
+        hMapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL,
+            PAGE_READWRITE, 0, sizeof(SharedMemoryRegion), name);
+        if (hMapping == 0 || GetLastError() == ERROR_ALREADY_EXISTS)  {
+            opserr << "SharedMemoryChannel::setUpConnection() - "
+                << "could not create shared memory region " << name << endln;
+            return -1;
+        }
+        theRegion = (SharedMemoryRegion *)MapViewOfFile((HANDLE)hMapping,
+            FILE_MAP_ALL_ACCESS, 0, 0, sizeof(SharedMemoryRegion));
+        if (theRegion == 0)  {
+#else
+        // a region left over by a crashed process is removed first
+        shm_unlink(name);
+        fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0 || ftruncate(fd, sizeof(SharedMemoryRegion)) != 0)  {
+            opserr << "SharedMemoryChannel::setUpConnection() - "
+                << "could not create shared memory region " << name << endln;
+            return -1;
+        }
+        void *addr = mmap(0, sizeof(SharedMemoryRegion),
+            PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        theRegion = (addr != MAP_FAILED) ? (SharedMemoryRegion *)addr : 0;
+        if (theRegion == 0)  {
+#endif
+            opserr << "SharedMemoryChannel::setUpConnection() - "
+                << "could not map shared memory region " << name << endln;
+            return -1;
+        }
+
+        // the new region is zero, i.e. both rings are empty
+#ifdef _WIN32
+        theRegion->pid[1].store((int)GetCurrentProcessId());
+#else
+        theRegion->pid[1].store((int)getpid());
+#endif
+        theRegion->state.store(SHM_listening);
+
+        // wait for the other process to connect
+        while (theRegion->state.load() == SHM_listening)
+            std::this_thread::sleep_for(milliseconds(1));
+        peerPid = theRegion->pid[0].load();
+
+#ifndef _WIN32
+        // the name is not needed anymore once connected
+        shm_unlink(name);
+#endif
+    }
+    else  {
+        // connect to the region created by the other process
+#ifdef _WIN32
+        hMapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name);
+        if (hMapping == 0)  {
+            opserr << "SharedMemoryChannel::setUpConnection() - could not connect\n";
+            return -1;
+        }
+        theRegion = (SharedMemoryRegion *)MapViewOfFile((HANDLE)hMapping,
+            FILE_MAP_ALL_ACCESS, 0, 0, sizeof(SharedMemoryRegion));
+        if (theRegion == 0)  {
+#else
+        fd = shm_open(name, O_RDWR, 0600);
+        if (fd < 0)  {
+            opserr << "SharedMemoryChannel::setUpConnection() - could not connect\n";
+            return -1;
+        }
+        // wait until the creating process has sized the region
+        struct stat st;
+        int numTry = 0;
+        while (fstat(fd, &st) == 0 &&
+            st.st_size < (off_t)sizeof(SharedMemoryRegion) && numTry++ < 1000)
+            std::this_thread::sleep_for(milliseconds(1));
+        void *addr = mmap(0, sizeof(SharedMemoryRegion),
+            PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        theRegion = (addr != MAP_FAILED) ? (SharedMemoryRegion *)addr : 0;
+        if (theRegion == 0)  {
+#endif
+            opserr << "SharedMemoryChannel::setUpConnection() - "
+                << "could not map shared memory region " << name << endln;
+            return -1;
+        }
+
+#ifdef _WIN32
+        theRegion->pid[0].store((int)GetCurrentProcessId());
+#else
+        theRegion->pid[0].store((int)getpid());
+#endif
+
+        // only one process can connect to the region
+        unsigned int state = SHM_listening;
+        numTry = 0;
+        while (theRegion->state.compare_exchange_strong(state,
+            SHM_connected) == false)  {
+            if (state != SHM_created || numTry++ > 1000)  {
+                opserr << "SharedMemoryChannel::setUpConnection() - "
+                    << "shared memory region " << name << " is in use\n";
+                return -1;
+            }
+            state = SHM_listening;
+            std::this_thread::sleep_for(milliseconds(1));
+        }
+        peerPid = theRegion->pid[1].load();
+    }
+
+    return 0;
+}
+
+
+int
+SharedMemoryChannel::sendBytes(const char *buffer, int numBytes)
+{
+    if (theRegion == 0 || theRegion->state.load() == SHM_closed)
+        return -1;
+
+    SHM_Ring &theRing = theRegion->ring[sendRing];
+    unsigned int head = theRing.head.load(std::memory_order_relaxed);
+    while (numBytes > 0)  {
+        unsigned int tail = theRing.tail.load(std::memory_order_acquire);
+        unsigned int space = SHM_ringSize - (head - tail);
+        if (space == 0)  {
+            // wait for the peer to make room in the ring
+            if (shmWait(theRegion, peerPid, theRing.tail,
+                theRing.tailWait, tail) == false)
+                return -1;
+            continue;
+        }
+
+        // copy up to the end of the ring
+        unsigned int pos = head & (SHM_ringSize-1);
+        unsigned int num = SHM_ringSize - pos;
+        if (num > space)
+            num = space;
+        if (num > (unsigned int)numBytes)
+            num = numBytes;
+        memcpy(&theRing.data[pos], buffer, num);
+
+        head += num;
+        buffer += num;
+        numBytes -= num;
+        theRing.head.store(head);
+        shmWake(theRing.head, theRing.headWait);
+    }
+
+    return 0;
+}
+
+
+int
+SharedMemoryChannel::recvBytes(char *buffer, int numBytes)
+{
+    if (theRegion == 0)
+        return -1;
+
+    SHM_Ring &theRing = theRegion->ring[recvRing];
+    unsigned int tail = theRing.tail.load(std::memory_order_relaxed);
+    while (numBytes > 0)  {
+        unsigned int head = theRing.head.load(std::memory_order_acquire);
+        unsigned int avail = head - tail;
+        if (avail == 0)  {
+            // wait for the peer to write to the ring
+            if (shmWait(theRegion, peerPid, theRing.head,
+                theRing.headWait, head) == false)
+                return -1;
+            continue;
+        }
+
+        // copy up to the end of the ring
+        unsigned int pos = tail & (SHM_ringSize-1);
+        unsigned int num = SHM_ringSize - pos;
+        if (num > avail)
+            num = avail;
+        if (num > (unsigned int)numBytes)
+            num = numBytes;
+        memcpy(buffer, &theRing.data[pos], num);
+
+        tail += num;
+        buffer += num;
+        numBytes -= num;
+        theRing.tail.store(tail);
+        shmWake(theRing.tail, theRing.tailWait);
+    }
+
+    return 0;
+}
+
+
+int
+SharedMemoryChannel::setNextAddress(const ChannelAddress &theAddress)
+{
+    opserr << "SharedMemoryChannel::setNextAddress() - a SharedMemoryChannel "
+        << "can only communicate with one other SharedMemoryChannel\n";
+
+    return -1;
+}
+
+
+int
+SharedMemoryChannel::sendObj(int commitTag,
+    MovableObject &theObject, ChannelAddress *theAddress)
+{
+    return theObject.sendSelf(commitTag, *this);
+}
+
+
+int
+SharedMemoryChannel::recvObj(int commitTag,
+    MovableObject &theObject, FEM_ObjectBroker &theBroker,
+    ChannelAddress *theAddress)
+{
+    return theObject.recvSelf(commitTag, *this, theBroker);
+}
+
+
+int
+SharedMemoryChannel::recvMsg(int dbTag, int commitTag,
+    Message &msg, ChannelAddress *theAddress)
+{
+    ExpTimer timer(OF_Timing_Recv);
+
+    if (this->recvBytes(msg.data, msg.length) < 0)  {
+        opserr << "SharedMemoryChannel::recvMsg() - "
+            << "connection closed by peer\n";
+        return -1;
+    }
+
+    return 0;
+}
+
+
+int
+SharedMemoryChannel::recvMsgUnknownSize(int dbTag, int commitTag,
+    Message &msg, ChannelAddress *theAddress)
+{
+    ExpTimer timer(OF_Timing_Recv);
+
+    // receive up to and including a terminator ('\0' or '\n')
+    int i = 0;
+    char c = 0;
+    while (i < msg.length-1)  {
+        if (this->recvBytes(&c, 1) < 0)  {
+            opserr << "SharedMemoryChannel::recvMsgUnknownSize() - "
+                << "connection closed by peer\n";
+            return -1;
+        }
+        msg.data[i++] = c;
+        if (c == '\0' || c == '\n')
+            break;
+    }
+    msg.data[i] = '\0';
+
+    if (c != '\0' && c != '\n')  {
+        opserr << "SharedMemoryChannel::recvMsgUnknownSize() - message "
+            << "truncated to " << msg.length-1 << endln;
+        return -3;
+    }
+
+    return 0;
+}
+
+
+int
+SharedMemoryChannel::sendMsg(int dbTag, int commitTag,
+    const Message &msg, ChannelAddress *theAddress)
+{
+    ExpTimer timer(OF_Timing_Send);
+
+    if (this->sendBytes(msg.data, msg.length) < 0)  {
+        opserr << "SharedMemoryChannel::sendMsg() - "
+            << "connection closed by peer\n";
+        return -1;
+    }
+
+    return 0;
+}
+
+
+int
+SharedMemoryChannel::recvMatrix(int dbTag, int commitTag,
+    Matrix &theMatrix, ChannelAddress *theAddress)
+{
+    ExpTimer timer(OF_Timing_Recv);
+
+    if (this->recvBytes((char *)theMatrix.data,
+        theMatrix.dataSize * sizeof(double)) < 0)  {
+        opserr << "SharedMemoryChannel::recvMatrix() - "
+            << "connection closed by peer\n";
+        return -1;
+    }
+
+    return 0;
+}
+
+
+int
+SharedMemoryChannel::sendMatrix(int dbTag, int commitTag,
+    const Matrix &theMatrix, ChannelAddress *theAddress)
+{
+    ExpTimer timer(OF_Timing_Send);
+
+    if (this->sendBytes((const char *)theMatrix.data,
+        theMatrix.dataSize * sizeof(double)) < 0)  {
+        opserr << "SharedMemoryChannel::sendMatrix() - "
+            << "connection closed by peer\n";
+        return -1;
+    }
+
+    return 0;
+}
+
+
+int
+SharedMemoryChannel::recvVector(int dbTag, int commitTag,
+    Vector &theVector, ChannelAddress *theAddress)
+{
+    ExpTimer timer(OF_Timing_Recv);
+
+    if (this->recvBytes((char *)theVector.theData,
+        theVector.sz * sizeof(double)) < 0)  {
+        opserr << "SharedMemoryChannel::recvVector() - "
+            << "connection closed by peer\n";
+        return -1;
+    }
+
+    return 0;
+}
+
+
+int
+SharedMemoryChannel::sendVector(int dbTag, int commitTag,
+    const Vector &theVector, ChannelAddress *theAddress)
+{
+    ExpTimer timer(OF_Timing_Send);
+
+    if (this->sendBytes((const char *)theVector.theData,
+        theVector.sz * sizeof(double)) < 0)  {
+        opserr << "SharedMemoryChannel::sendVector() - "
+            << "connection closed by peer\n";
+        return -1;
+    }
+
+    return 0;
+}
+
+
+int
+SharedMemoryChannel::recvID(int dbTag, int commitTag,
+    ID &theID, ChannelAddress *theAddress)
+{
+    ExpTimer timer(OF_Timing_Recv);
+
+    if (this->recvBytes((char *)theID.data,
+        theID.sz * sizeof(int)) < 0)  {
+        opserr << "SharedMemoryChannel::recvID() - "
+            << "connection closed by peer\n";
+        return -1;
+    }
+
+    return 0;
+}
+
+
+int
+SharedMemoryChannel::sendID(int dbTag, int commitTag,
+    const ID &theID, ChannelAddress *theAddress)
+{
+    ExpTimer timer(OF_Timing_Send);
+
+    if (this->sendBytes((const char *)theID.data,
+        theID.sz * sizeof(int)) < 0)  {
+        opserr << "SharedMemoryChannel::sendID() - "
+            << "connection closed by peer\n";
+        return -1;
+    }
+
+    return 0;
+}
+
+
+char *
+SharedMemoryChannel::addToProgram()
+{
+    // the other process is given the type and the port number
+    char *newStuff = (char *)malloc(30*sizeof(char));
+    sprintf(newStuff, " 3 %u", myPort);
+
+    return newStuff;
+}
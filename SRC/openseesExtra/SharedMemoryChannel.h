@@ -0,0 +1,126 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef SharedMemoryChannel_h
+#define SharedMemoryChannel_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// SharedMemoryChannel. A SharedMemoryChannel is a sub-class of
+// channel for two processes on the same machine. The data is passed
+// through a shared memory region with one single-producer/single-
+// consumer byte ring for each direction, so that sending and
+// receiving does not need any system calls. A waiting process first
+// polls the ring and only blocks (futex on Linux) if the peer does
+// not respond within a short time. The region is named after the
+// port number, so that the channel can be used wherever a TCP_Socket
+// with the same port would be used. Like a TCP_Socket, one process
+// creates the region and waits for the other one to connect.
+
+#include <bool.h>
+#include <Channel.h>
+
+struct SharedMemoryRegion;
+
+class SharedMemoryChannel : public Channel
+{
+  public:
+    SharedMemoryChannel(unsigned int port);
+    SharedMemoryChannel(unsigned int other_Port,
+        const char *other_InetAddr);
+    ~SharedMemoryChannel();
+
+    char *addToProgram();
+
+    virtual int setUpConnection();
+
+    int setNextAddress(const ChannelAddress &otherChannelAddress);
+    virtual ChannelAddress *getLastSendersAddress(){ return 0;};
+
+    int sendObj(int commitTag,
+		MovableObject &theObject,
+		ChannelAddress *theAddress =0);
+    int recvObj(int commitTag,
+		MovableObject &theObject,
+		FEM_ObjectBroker &theBroker,
+		ChannelAddress *theAddress =0);
+
+    int sendMsg(int dbTag, int commitTag,
+		const Message &,
+		ChannelAddress *theAddress =0);
+    int recvMsg(int dbTag, int commitTag,
+		Message &,
+		ChannelAddress *theAddress =0);
+    int recvMsgUnknownSize(int dbTag, int commitTag,
+		Message &,
+		ChannelAddress *theAddress =0);
+
+    int sendMatrix(int dbTag, int commitTag,
+		   const Matrix &theMatrix,
+		   ChannelAddress *theAddress =0);
+    int recvMatrix(int dbTag, int commitTag,
+		   Matrix &theMatrix,
+		   ChannelAddress *theAddress =0);
+
+    int sendVector(int dbTag, int commitTag,
+		   const Vector &theVector,
+		   ChannelAddress *theAddress =0);
+    int recvVector(int dbTag, int commitTag,
+		   Vector &theVector,
+		   ChannelAddress *theAddress =0);
+
+    int sendID(int dbTag, int commitTag,
+	       const ID &theID,
+	       ChannelAddress *theAddress =0);
+    int recvID(int dbTag, int commitTag,
+	       ID &theID,
+	       ChannelAddress *theAddress =0);
+
+  private:
+    // copy bytes into the send ring and out of the receive ring,
+    // both block until all bytes are transferred and return -1 if
+    // the peer closed the connection
+    int sendBytes(const char *buffer, int numBytes);
+    int recvBytes(char *buffer, int numBytes);
+
+    unsigned int myPort;        // port number the region is named after
+    int connectType;            // 0: creates the region, 1: connects
+    char name[32];              // name of the shared memory region
+
+    SharedMemoryRegion *theRegion;  // mapped shared memory region
+    int sendRing;               // index of the ring this process writes
+    int recvRing;               // index of the ring this process reads
+    int peerPid;                // process id of the peer
+
+#ifdef _WIN32
+    void *hMapping;             // handle of the file mapping
+#else
+    int fd;                     // file descriptor of the region
+#endif
+};
+
+#endif
@@ -33,12 +33,24 @@
 #include <string.h>
 #include <Matrix.h>
 #include <Vector.h>
+#include <ExpTiming.h>
 #include <ID.h>
 #include <Message.h>
 #include <ChannelAddress.h>
 #include <MovableObject.h>
 #include <SocketAddress.h>
 
+#include <chrono>
+#ifndef _WIN32
+#include <poll.h>
+#include <errno.h>
+#endif
+
+using std::chrono::steady_clock;
+using std::chrono::duration;
+using std::chrono::duration_cast;
+using std::chrono::milliseconds;
+
 static int GetHostAddr(char *host, char *IntAddr);
 static void inttoa(unsigned int no, char *string, int *cnt);
 
@@ -52,7 +64,9 @@ static void byte_swap(void *array, long long nArray,int size);
 //	given by the OS. 
 TCP_Socket::TCP_Socket()
     : myPort(0), connectType(0),
-    checkEndianness(false), endiannessProblem(false), noDelay(0)
+    checkEndianness(false), endiannessProblem(false), noDelay(0),
+    recvBuffer(0), recvBufferSize(0), recvBufferLength(0),
+    recvTimeout(-1), recvWaitTime(0.0), recvTransferTime(0.0)
 {
     // initialize sockets
     startup_sockets();
@@ -89,7 +103,8 @@ TCP_Socket::TCP_Socket()
 TCP_Socket::TCP_Socket(unsigned int port, bool checkendianness, int nodelay) 
     : myPort(0), connectType(0),
     checkEndianness(checkendianness), endiannessProblem(false),
-    noDelay(nodelay)
+    noDelay(nodelay), recvBuffer(0), recvBufferSize(0), recvBufferLength(0),
+    recvTimeout(-1), recvWaitTime(0.0), recvTransferTime(0.0)
 {
     // initialize sockets
     startup_sockets();
@@ -132,7 +147,8 @@ TCP_Socket::TCP_Socket(unsigned int other_Port,
     const char *other_InetAddr, bool checkendianness, int nodelay)
     : myPort(0), connectType(1),
     checkEndianness(checkendianness), endiannessProblem(false),
-    noDelay(nodelay)
+    noDelay(nodelay), recvBuffer(0), recvBufferSize(0), recvBufferLength(0),
+    recvTimeout(-1), recvWaitTime(0.0), recvTransferTime(0.0)
 {
     // initialize sockets
     startup_sockets();
@@ -190,6 +206,9 @@ TCP_Socket::~TCP_Socket()
 
     // cleanup sockets
     cleanup_sockets();
+
+    if (recvBuffer != 0)
+        delete [] recvBuffer;
 }
 
 
@@ -257,40 +276,183 @@ TCP_Socket::setUpConnection()
 #endif
         sockfd = newsockfd;
         
-        // get my_address info
-        getsockname(sockfd, &my_Addr.addr, &addrLength);
-        
-        // set TCP_NODELAY option
-        if ((setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, 
-            (char *) &noDelay, sizeof(int))) < 0) { 
-                opserr << "TCP_Socket::setUpConnection() - "
-                    << "could not set TCP_NODELAY option\n";
-        }
-        
-        // check for endianness problem if requested
-        if (checkEndianness) {
-            int i;
-            int j = 1;
+        this->setUpAcceptedConnection();
+    }    
+    
+    return 0;
+}    
 
-            int *data = &i;
-            char *gMsg = (char *)data;
-            recv(sockfd, gMsg, sizeof(int), 0);
 
-            data = &j;
-            gMsg = (char *)data;
-            send(sockfd, gMsg, sizeof(int), 0);
+// TCP_Socket(socket_type newsockfd, const TCP_Socket &theListener): 
+//	constructor for a connection accepted by a listening TCP_Socket,
+//	the options are taken from the listening socket.
+TCP_Socket::TCP_Socket(socket_type newsockfd,
+    const TCP_Socket &theListener)
+    : sockfd(newsockfd), myPort(0), connectType(0),
+    checkEndianness(theListener.checkEndianness), endiannessProblem(false),
+    noDelay(theListener.noDelay), recvBuffer(0), recvBufferSize(0), recvBufferLength(0),
+    recvTimeout(-1), recvWaitTime(0.0), recvTransferTime(0.0)
+{
+    // initialize sockets (balanced by the destructor)
+    startup_sockets();
 
-            if (i != j) {
-                int k = 0x41424344;
-                char *c = (char *)&k;
-                if (*c == 0x41)
-                    endiannessProblem = true;
-            }
+    bzero((char *) &my_Addr, sizeof(my_Addr));
+    bzero((char *) &other_Addr, sizeof(other_Addr));
+    addrLength = sizeof(my_Addr.addr);
+}
+
+
+void
+TCP_Socket::setUpAcceptedConnection()
+{
+    // get my_address info
+    getsockname(sockfd, &my_Addr.addr, &addrLength);
+    myPort = ntohs(my_Addr.addr_in.sin_port);
+    
+    // set TCP_NODELAY option
+    if ((setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, 
+        (char *) &noDelay, sizeof(int))) < 0) { 
+            opserr << "TCP_Socket::setUpConnection() - "
+                << "could not set TCP_NODELAY option\n";
+    }
+    
+    // check for endianness problem if requested
+    if (checkEndianness) {
+        int i;
+        int j = 1;
+
+        int *data = &i;
+        char *gMsg = (char *)data;
+        recv(sockfd, gMsg, sizeof(int), 0);
+
+        data = &j;
+        gMsg = (char *)data;
+        send(sockfd, gMsg, sizeof(int), 0);
+
+        if (i != j) {
+            int k = 0x41424344;
+            char *c = (char *)&k;
+            if (*c == 0x41)
+                endiannessProblem = true;
         }
-    }    
+    }
+}
+
+
+int
+TCP_Socket::listenForConnections(int numConnections)
+{
+    if (connectType != 0) {
+        opserr << "TCP_Socket::listenForConnections() - "
+            << "only a server socket can listen for connections\n";
+        return -1;
+    }
+    if (listen(sockfd, numConnections) < 0) {
+        opserr << "TCP_Socket::listenForConnections() - could not listen\n";
+        return -1;
+    }
     
     return 0;
-}    
+}
+
+
+TCP_Socket *
+TCP_Socket::acceptConnection()
+{
+    // wait for the next process to contact me, the listening
+    // socket stays open for further connections
+    socket_type newsockfd;
+    addrLength = sizeof(other_Addr.addr);
+    newsockfd = accept(sockfd, &other_Addr.addr, &addrLength);
+    if (newsockfd < 0) {
+        opserr << "TCP_Socket::acceptConnection() - could not accept connection\n";
+        return 0;
+    }
+    
+    TCP_Socket *theSocket = new TCP_Socket(newsockfd, *this);
+    theSocket->other_Addr = other_Addr;
+    theSocket->setUpAcceptedConnection();
+    
+    return theSocket;
+}
+
+
+int
+TCP_Socket::waitForData(TCP_Socket **theSockets, int numSockets,
+    bool *ready, int timeout)
+{
+    // bytes left in the buffer of recvMsgUnknownSize are ready at once
+    int i, numReady = 0;
+    for (i=0; i<numSockets; i++) {
+        ready[i] = (theSockets[i] != 0 && theSockets[i]->recvBufferLength > 0);
+        if (ready[i])
+            numReady++;
+    }
+    if (numReady > 0)
+        return numReady;
+    
+    // closed connections (null pointers) are skipped
+    const int maxNumStack = 32;
+#ifdef _WIN32
+    WSAPOLLFD pfdStack[maxNumStack];
+    WSAPOLLFD *pfd = (numSockets <= maxNumStack) ?
+        pfdStack : new WSAPOLLFD [numSockets];
+#else
+    struct pollfd pfdStack[maxNumStack];
+    struct pollfd *pfd = (numSockets <= maxNumStack) ?
+        pfdStack : new struct pollfd [numSockets];
+#endif
+    int numFds = 0;
+    for (i=0; i<numSockets; i++) {
+        if (theSockets[i] == 0)
+            continue;
+        pfd[numFds].fd = theSockets[i]->sockfd;
+#ifdef _WIN32
+        pfd[numFds].events = POLLRDNORM;
+#else
+        pfd[numFds].events = POLLIN;
+#endif
+        pfd[numFds].revents = 0;
+        numFds++;
+    }
+    
+    int rc;
+    do {
+#ifdef _WIN32
+        rc = WSAPoll(pfd, numFds, timeout);
+#else
+        rc = poll(pfd, numFds, timeout);
+#endif
+    }
+#ifdef _WIN32
+    while (false);
+#else
+    while (rc < 0 && errno == EINTR);
+#endif
+    
+    // a closed or failed connection is also reported as ready,
+    // so that the following receive detects it
+    if (rc > 0) {
+        numFds = 0;
+        for (i=0; i<numSockets; i++) {
+            if (theSockets[i] == 0)
+                continue;
+            ready[i] = (pfd[numFds].revents != 0);
+            if (ready[i])
+                numReady++;
+            numFds++;
+        }
+    }
+    else if (rc < 0) {
+        opserr << "TCP_Socket::waitForData() - poll failed\n";
+        numReady = -1;
+    }
+    
+    if (pfd != pfdStack)
+        delete [] pfd;
+    
+    return numReady;
+}
 
 
 int
@@ -384,6 +546,8 @@ int
 TCP_Socket::recvMsg(int dbTag, int commitTag,
     Message &msg, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Recv);
+
     // first check address is the only address a TCP_socket can send to
     SocketAddress *theSocketAddress = 0;
     if (theAddress != 0) {
@@ -413,6 +577,15 @@ TCP_Socket::recvMsg(int dbTag, int commitTag,
 
     while (nleft > 0) {
         nread = recv(sockfd,gMsg,nleft,0);
+        if (nread <= 0) {
+#ifndef _WIN32
+            if (nread < 0 && errno == EINTR)
+                continue;
+#endif
+            opserr << "TCP_Socket::recvMsg() - "
+                << "connection closed by peer\n";
+            return -1;
+        }
         nleft -= nread;
         gMsg +=  nread;
     }
@@ -427,6 +600,8 @@ int
 TCP_Socket::recvMsgUnknownSize(int dbTag, int commitTag,
     Message &msg, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Recv);
+
     // first check address is the only address a TCP_socket can send to
     SocketAddress *theSocketAddress = 0;
     if (theAddress != 0) {
@@ -447,38 +622,135 @@ TCP_Socket::recvMsgUnknownSize(int dbTag, int commitTag,
         }
     }
 
-    // if o.k. get a pointer to the data in the message and 
-    // place the incoming data there
-    int nleft, nread;
-    bool eol = false;
-    char *gMsg;
-    gMsg = msg.data;
+    // look for a terminator in the bytes left over from the last call
+    int i, eolPos = -1;
+    for (i=0; i<recvBufferLength && eolPos < 0; i++)
+        if (recvBuffer[i] == '\0' || recvBuffer[i] == '\n')
+            eolPos = i;
+
+    steady_clock::time_point tStart = steady_clock::now();
+    steady_clock::time_point tFirst = tStart;
+    bool gotData = (recvBufferLength > 0);
+
+    while (eolPos < 0) {
+        // block until data arrives or the timeout expires
+        int timeout = recvTimeout;
+        if (recvTimeout >= 0) {
+            timeout -= (int)duration_cast<milliseconds>(steady_clock::now()-tStart).count();
+            if (timeout < 0)
+                timeout = 0;
+        }
+#ifdef _WIN32
+        WSAPOLLFD pfd;
+        pfd.fd = sockfd;
+        pfd.events = POLLRDNORM;
+        pfd.revents = 0;
+        int rc = WSAPoll(&pfd, 1, timeout);
+#else
+        struct pollfd pfd;
+        pfd.fd = sockfd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        int rc = poll(&pfd, 1, timeout);
+        if (rc < 0 && errno == EINTR)
+            continue;
+#endif
+        if (rc == 0) {
+            opserr << "TCP_Socket::recvMsgUnknownSize() - timeout after "
+                << recvTimeout << " msec\n";
+            return -2;
+        }
+        if (rc < 0) {
+            opserr << "TCP_Socket::recvMsgUnknownSize() - poll failed\n";
+            return -1;
+        }
 
-    while (!eol) {
-        nleft = this->getBytesAvailable();
-        while (nleft > 0) {
-            nread = recv(sockfd,gMsg,nleft,0);
-            nleft -= nread;
-            gMsg  += nread;
-            if (*(gMsg-1) == '\0')
-                eol = true;
-            else if (*(gMsg-1) == '\n') {
-                eol = true;
-                *gMsg = '\0';
+        // grow the buffer if it is full
+        if (recvBufferLength == recvBufferSize) {
+            int newSize = (recvBufferSize > 0) ? 2*recvBufferSize : 1024;
+            char *newBuffer = new char [newSize];
+            if (recvBuffer != 0) {
+                memcpy(newBuffer, recvBuffer, recvBufferLength);
+                delete [] recvBuffer;
             }
+            recvBuffer = newBuffer;
+            recvBufferSize = newSize;
         }
+
+        int nread = recv(sockfd, &recvBuffer[recvBufferLength],
+            recvBufferSize-recvBufferLength, 0);
+        if (nread <= 0) {
+            opserr << "TCP_Socket::recvMsgUnknownSize() - "
+                << "connection closed by peer\n";
+            return -1;
+        }
+        if (!gotData) {
+            tFirst = steady_clock::now();
+            gotData = true;
+        }
+
+        // only scan the bytes that were just received
+        for (i=recvBufferLength; i<recvBufferLength+nread && eolPos < 0; i++)
+            if (recvBuffer[i] == '\0' || recvBuffer[i] == '\n')
+                eolPos = i;
+        recvBufferLength += nread;
     }
 
+    steady_clock::time_point tEnd = steady_clock::now();
+    recvWaitTime = duration<double>(tFirst-tStart).count();
+    recvTransferTime = duration<double>(tEnd-tFirst).count();
+
+    // copy the message including its terminator and null terminate it
+    int res = 0;
+    int msgLength = eolPos+1;
+    int numCopy = msgLength;
+    if (numCopy > msg.length-1) {
+        opserr << "TCP_Socket::recvMsgUnknownSize() - message of size "
+            << msgLength << " truncated to " << msg.length-1 << endln;
+        numCopy = msg.length-1;
+        res = -3;
+    }
+    memcpy(msg.data, recvBuffer, numCopy);
+    msg.data[numCopy] = '\0';
+
+    recvBufferLength -= msgLength;
+    if (recvBufferLength > 0)
+        memmove(recvBuffer, &recvBuffer[msgLength], recvBufferLength);
+
+    return res;
+}
+
+
+int
+TCP_Socket::setRecvTimeout(int timeout)
+{
+    recvTimeout = timeout;
     return 0;
 }
 
 
+double
+TCP_Socket::getRecvWaitTime() const
+{
+    return recvWaitTime;
+}
+
+
+double
+TCP_Socket::getRecvTransferTime() const
+{
+    return recvTransferTime;
+}
+
+
 // void Send(Message &):
 // 	Method to send a message to an address given by other_Addr.addr_in.
 int 
 TCP_Socket::sendMsg(int dbTag, int commitTag,
     const Message &msg, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Send);
+
     // first check address is the only address a TCP_socket can send to
     SocketAddress *theSocketAddress = 0;
     if (theAddress != 0) {
@@ -521,6 +793,8 @@ int
 TCP_Socket::recvMatrix(int dbTag, int commitTag,
     Matrix &theMatrix, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Recv);
+
     // first check address is the only address a TCP_socket can send to
     SocketAddress *theSocketAddress = 0;
     if (theAddress != 0) {
@@ -550,6 +824,15 @@ TCP_Socket::recvMatrix(int dbTag, int commitTag,
 
     while (nleft > 0) {
         nread = recv(sockfd,gMsg,nleft,0);
+        if (nread <= 0) {
+#ifndef _WIN32
+            if (nread < 0 && errno == EINTR)
+                continue;
+#endif
+            opserr << "TCP_Socket::recvMatrix() - "
+                << "connection closed by peer\n";
+            return -1;
+        }
         nleft -= nread;
         gMsg +=  nread;
     }
@@ -571,6 +854,8 @@ int
 TCP_Socket::sendMatrix(int dbTag, int commitTag,
     const Matrix &theMatrix, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Send);
+
     // first check address is the only address a TCP_socket can send to
     SocketAddress *theSocketAddress = 0;
     if (theAddress != 0) {
@@ -627,6 +912,8 @@ int
 TCP_Socket::recvVector(int dbTag, int commitTag,
     Vector &theVector, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Recv);
+
     // first check address is the only address a TCP_socket can send to
     SocketAddress *theSocketAddress = 0;
     if (theAddress != 0) {
@@ -656,6 +943,15 @@ TCP_Socket::recvVector(int dbTag, int commitTag,
 
     while (nleft > 0) {
         nread = recv(sockfd,gMsg,nleft,0);
+        if (nread <= 0) {
+#ifndef _WIN32
+            if (nread < 0 && errno == EINTR)
+                continue;
+#endif
+            opserr << "TCP_Socket::recvVector() - "
+                << "connection closed by peer\n";
+            return -1;
+        }
         nleft -= nread;
         gMsg +=  nread;
     }
@@ -677,6 +973,8 @@ int
 TCP_Socket::sendVector(int dbTag, int commitTag,
     const Vector &theVector, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Send);
+
     // first check address is the only address a TCP_socket can send to
     SocketAddress *theSocketAddress = 0;
     if (theAddress != 0) {
@@ -732,6 +1030,8 @@ int
 TCP_Socket::recvID(int dbTag, int commitTag,
     ID &theID, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Recv);
+
     // first check address is the only address a TCP_socket can send to
     SocketAddress *theSocketAddress = 0;
     if (theAddress != 0) {
@@ -761,6 +1061,15 @@ TCP_Socket::recvID(int dbTag, int commitTag,
 
     while (nleft > 0) {
         nread = recv(sockfd,gMsg,nleft,0);
+        if (nread <= 0) {
+#ifndef _WIN32
+            if (nread < 0 && errno == EINTR)
+                continue;
+#endif
+            opserr << "TCP_Socket::recvID() - "
+                << "connection closed by peer\n";
+            return -1;
+        }
         nleft -= nread;
         gMsg +=  nread;
     }
@@ -782,6 +1091,8 @@ int
 TCP_Socket::sendID(int dbTag, int commitTag,
     const ID &theID, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Send);
+
     // first check address is the only address a TCP_socket can send to
     SocketAddress *theSocketAddress = 0;
     if (theAddress != 0) {
@@ -833,6 +1144,24 @@ TCP_Socket::sendID(int dbTag, int commitTag,
 }
 
 
+int
+TCP_Socket::setNoDelay(int nodelay)
+{
+    if (nodelay == noDelay)
+        return 0;
+    
+    noDelay = nodelay;
+    if ((setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, 
+        (char *) &noDelay, sizeof(int))) < 0) { 
+            opserr << "TCP_Socket::setNoDelay() - "
+                << "could not set TCP_NODELAY option\n";
+            return -1;
+    }
+    
+    return 0;
+}
+
+
 unsigned int 
 TCP_Socket::getPortNumber() const
 {
@@ -51,6 +51,18 @@ class TCP_Socket : public Channel
     char *addToProgram();
     
     virtual int setUpConnection();
+    
+    // methods for a server that accepts several connections on its
+    // port, the listening socket stays open and every accepted
+    // connection is returned as a new TCP_Socket
+    int listenForConnections(int numConnections);
+    TCP_Socket *acceptConnection();
+    
+    // wait [msec] until data (or a connection) is available on any of
+    // the sockets (negative waits forever), returns the number of
+    // ready sockets, 0 on timeout or -1 on failure
+    static int waitForData(TCP_Socket **theSockets, int numSockets,
+        bool *ready, int timeout = -1);
 
     int setNextAddress(const ChannelAddress &otherChannelAddress);
     virtual ChannelAddress *getLastSendersAddress(){ return 0;};
@@ -73,6 +85,16 @@ class TCP_Socket : public Channel
 		Message &, 
 		ChannelAddress *theAddress =0);        
 
+    // timeout [msec] for recvMsgUnknownSize (negative waits forever)
+    int setRecvTimeout(int timeout);
+    // timing [sec] of the last recvMsgUnknownSize transaction: time
+    // waited for the first byte and time to receive the rest
+    double getRecvWaitTime() const;
+    double getRecvTransferTime() const;
+    
+    // switch the TCP_NODELAY option on or off
+    int setNoDelay(int noDelay);
+
     int sendMatrix(int dbTag, int commitTag, 
 		   const Matrix &theMatrix, 
 		   ChannelAddress *theAddress =0);
@@ -99,6 +121,9 @@ class TCP_Socket : public Channel
     unsigned int getBytesAvailable();
     
   private:
+    TCP_Socket(socket_type newsockfd, const TCP_Socket &theListener);
+    void setUpAcceptedConnection();
+    
     socket_type sockfd;
 
     union {
@@ -117,6 +142,15 @@ class TCP_Socket : public Channel
     bool checkEndianness;
     bool endiannessProblem;
     int noDelay;
+
+    // buffer for recvMsgUnknownSize, keeps bytes received after
+    // the terminator for the next message
+    char *recvBuffer;
+    int recvBufferSize;
+    int recvBufferLength;
+    int recvTimeout;
+    double recvWaitTime;
+    double recvTransferTime;
 };
 
 #endif 
@@ -33,6 +33,7 @@
 #include <string.h>
 #include <Matrix.h>
 #include <Vector.h>
+#include <ExpTiming.h>
 #include <ID.h>
 #include <Message.h>
 #include <ChannelAddress.h>
@@ -548,6 +549,8 @@ int
 TCP_SocketSSL::recvMsg(int dbTag, int commitTag,
     Message &msg, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Recv);
+
     // first check address is the only address a TCP_socket can send to
     SocketAddress *theSocketAddress = 0;
     if (theAddress != 0) {
@@ -599,6 +602,8 @@ int
 TCP_SocketSSL::recvMsgUnknownSize(int dbTag, int commitTag,
     Message &msg, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Recv);
+
     // first check address is the only address a TCP_socket can send to
     SocketAddress *theSocketAddress = 0;
     if (theAddress != 0) {
@@ -659,6 +664,8 @@ int
 TCP_SocketSSL::sendMsg(int dbTag, int commitTag,
     const Message &msg, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Send);
+
     // first check address is the only address a TCP_socket can send to
     SocketAddress *theSocketAddress = 0;
     if (theAddress != 0) {
@@ -703,6 +710,8 @@ int
 TCP_SocketSSL::recvMatrix(int dbTag, int commitTag,
     Matrix &theMatrix, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Recv);
+
     // first check address is the only address a TCP_socket can send to
     SocketAddress *theSocketAddress = 0;
     if (theAddress != 0) {
@@ -761,6 +770,8 @@ int
 TCP_SocketSSL::sendMatrix(int dbTag, int commitTag,
     const Matrix &theMatrix, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Send);
+
     // first check address is the only address a TCP_socket can send to
     SocketAddress *theSocketAddress = 0;
     if (theAddress != 0) {
@@ -820,6 +831,8 @@ int
 TCP_SocketSSL::recvVector(int dbTag, int commitTag,
     Vector &theVector, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Recv);
+
     // first check address is the only address a TCP_socket can send to
     SocketAddress *theSocketAddress = 0;
     if (theAddress != 0) {
@@ -878,6 +891,8 @@ int
 TCP_SocketSSL::sendVector(int dbTag, int commitTag,
     const Vector &theVector, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Send);
+
     // first check address is the only address a TCP_socket can send to
     SocketAddress *theSocketAddress = 0;
     if (theAddress != 0) {
@@ -936,6 +951,8 @@ int
 TCP_SocketSSL::recvID(int dbTag, int commitTag,
     ID &theID, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Recv);
+
     // first check address is the only address a TCP_socket can send to
     SocketAddress *theSocketAddress = 0;
     if (theAddress != 0) {
@@ -994,6 +1011,8 @@ int
 TCP_SocketSSL::sendID(int dbTag, int commitTag,
     const ID &theID, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Send);
+
     // first check address is the only address a TCP_socket can send to
     SocketAddress *theSocketAddress = 0;
     if (theAddress != 0) {
@@ -1048,6 +1067,24 @@ TCP_SocketSSL::sendID(int dbTag, int commitTag,
 }
 
 
+int
+TCP_SocketSSL::setNoDelay(int nodelay)
+{
+    if (nodelay == noDelay)
+        return 0;
+    
+    noDelay = nodelay;
+    if ((setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, 
+        (char *) &noDelay, sizeof(int))) < 0) { 
+            opserr << "TCP_SocketSSL::setNoDelay() - "
+                << "could not set TCP_NODELAY option\n";
+            return -1;
+    }
+    
+    return 0;
+}
+
+
 unsigned int 
 TCP_SocketSSL::getPortNumber() const
 {
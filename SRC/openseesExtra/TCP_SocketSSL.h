@@ -104,6 +104,9 @@ public:
     int recvID(int dbTag, int commitTag, 
         ID &theID, 
         ChannelAddress *theAddress =0);    
+    
+    // switch the TCP_NODELAY option on or off
+    int setNoDelay(int noDelay);
 
 protected:
     unsigned int getPortNumber() const;
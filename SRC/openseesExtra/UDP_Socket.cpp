@@ -33,6 +33,7 @@
 #include <string.h>
 #include <Matrix.h>
 #include <Vector.h>
+#include <ExpTiming.h>
 #include <ID.h>
 #include <Message.h>
 #include <ChannelAddress.h>
@@ -349,6 +350,8 @@ int
 UDP_Socket::recvMsg(int dbTag, int commitTag,
     Message &msg, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Recv);
+
     // if o.k. get a pointer to the data in the message and 
     // place the incoming data there
     int size;
@@ -408,6 +411,8 @@ int
 UDP_Socket::sendMsg(int dbTag, int commitTag,
     const Message &msg, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Send);
+
     // set up the address of the Socket to which data will be sent
     if (theAddress != 0) {
         SocketAddress *theSocketAddress = 0;
@@ -453,6 +458,8 @@ int
 UDP_Socket::recvMatrix(int dbTag, int commitTag,
     Matrix &theMatrix, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Recv);
+
     // if o.k. get a pointer to the data in the message and 
     // place the incoming data there
     int size;
@@ -510,6 +517,8 @@ int
 UDP_Socket::sendMatrix(int dbTag, int commitTag,
     const Matrix &theMatrix, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Send);
+
     // set up the address of the Socket to which data will be sent
     if (theAddress != 0) {
         SocketAddress *theSocketAddress = 0;
@@ -569,6 +578,8 @@ int
 UDP_Socket::recvVector(int dbTag, int commitTag,
     Vector &theVector, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Recv);
+
     // if o.k. get a pointer to the data in the message and 
     // place the incoming data there
     int size;
@@ -626,6 +637,8 @@ int
 UDP_Socket::sendVector(int dbTag, int commitTag,
     const Vector &theVector, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Send);
+
     // set up the address of the Socket to which data will be sent
     if (theAddress != 0) {
         SocketAddress *theSocketAddress = 0;
@@ -685,6 +698,8 @@ int
 UDP_Socket::recvID(int dbTag, int commitTag,
     ID &theID, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Recv);
+
     // if o.k. get a pointer to the data in the message and 
     // place the incoming data there
     int size;
@@ -742,6 +757,8 @@ int
 UDP_Socket::sendID(int dbTag, int commitTag,
     const ID &theID, ChannelAddress *theAddress)
 {	
+    ExpTimer timer(OF_Timing_Send);
+
     // set up the address of the Socket to which data will be sent
     if (theAddress != 0) {
         SocketAddress *theSocketAddress = 0;
@@ -797,6 +814,36 @@ UDP_Socket::sendID(int dbTag, int commitTag,
 }
 
 
+int
+UDP_Socket::sendFramedVector(int dbTag, int commitTag,
+    const Vector &theVector, int numData,
+    ChannelAddress *theAddress)
+{
+    if (numData < 1 || numData > theVector.Size()) {
+        opserr << "UDP_Socket::sendFramedVector() - invalid number of data "
+            << numData << endln;
+        return -1;
+    }
+    framedMode = true;
+    
+    // every datagram is received on its own and there is no Nagle
+    // algorithm on UDP, so the header and the payload are sent as
+    // two datagrams and the payload is not copied
+    double header[3];
+    Vector theHeader(header, 3);
+    header[0] = theVector(0);
+    header[1] = numData - 1;
+    header[2] = ++sendSeqNum;
+    
+    int res = this->sendVector(dbTag, commitTag, theHeader, theAddress);
+    if (res < 0 || numData == 1)
+        return res;
+    
+    Vector thePayload(&(const_cast<Vector &>(theVector))(1), numData-1);
+    return this->sendVector(dbTag, commitTag, thePayload, theAddress);
+}
+
+
 unsigned int 
 UDP_Socket::getPortNumber() const
 {
@@ -92,6 +92,10 @@ class UDP_Socket : public Channel
 	       ID &theID, 
 	       ChannelAddress *theAddress =0);    
     
+    int sendFramedVector(int dbTag, int commitTag, 
+        const Vector &theVector, int numData,
+        ChannelAddress *theAddress =0);
+    
   protected:
     unsigned int getPortNumber() const;
     unsigned int getBytesAvailable();
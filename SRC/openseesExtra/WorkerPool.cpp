@@ -0,0 +1,137 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of WorkerPool.
+
+#include "WorkerPool.h"
+
+
+WorkerPool::WorkerPool(int nThreads)
+    : numThreads(nThreads), workers(0), task(0),
+    jobCount(0), stopping(false), numBusy(0)
+{
+    if (numThreads < 1)
+        numThreads = 1;
+}
+
+
+WorkerPool::~WorkerPool()
+{
+    this->stopWorkers();
+}
+
+
+void WorkerPool::run(const std::function<void(int)> &theTask)
+{
+    if (numThreads > 1)  {
+        if (workers == 0)
+            this->startWorkers();
+        
+        // post the task to the workers
+        {
+            std::lock_guard<std::mutex> lock(theMutex);
+            task = &theTask;
+            numBusy = numThreads-1;
+            jobCount++;
+        }
+        jobReady.notify_all();
+    }
+    
+    // the calling thread runs the first share of the task
+    theTask(0);
+    
+    // wait until the workers have run their shares
+    if (numThreads > 1)  {
+        std::unique_lock<std::mutex> lock(theMutex);
+        while (numBusy > 0)
+            jobDone.wait(lock);
+        task = 0;
+    }
+}
+
+
+void WorkerPool::startWorkers()
+{
+    // the calling thread is the first of the numThreads threads
+    workers = new std::thread [numThreads-1];
+    for (int k=1; k<numThreads; k++)
+        workers[k-1] = std::thread(&WorkerPool::workerLoop, this, k);
+}
+
+
+void WorkerPool::stopWorkers()
+{
+    if (workers == 0)
+        return;
+    
+    {
+        std::lock_guard<std::mutex> lock(theMutex);
+        stopping = true;
+        jobCount++;
+    }
+    jobReady.notify_all();
+    
+    for (int k=1; k<numThreads; k++)
+        workers[k-1].join();
+    delete [] workers;
+    workers = 0;
+    stopping = false;
+}
+
+
+void WorkerPool::workerLoop(int k)
+{
+    // no job has been posted before the workers are started
+    long lastJob = 0;
+    const std::function<void(int)> *theTask;
+    
+    while (true)  {
+        // wait for the next job
+        {
+            std::unique_lock<std::mutex> lock(theMutex);
+            while (jobCount == lastJob)
+                jobReady.wait(lock);
+            lastJob = jobCount;
+            if (stopping)
+                return;
+            theTask = task;
+        }
+        
+        // run the share of this thread
+        (*theTask)(k);
+        
+        // the last worker wakes up the calling thread
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(theMutex);
+            last = (--numBusy == 0);
+        }
+        if (last)
+            jobDone.notify_one();
+    }
+}
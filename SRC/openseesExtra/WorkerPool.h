@@ -0,0 +1,77 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmx.net)              **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// $Revision$
+// $Date$
+// $URL$
+
+#ifndef WorkerPool_h
+#define WorkerPool_h
+
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// WorkerPool. A WorkerPool runs one task on a fixed number of threads,
+// the calling thread being thread 0. The numThreads-1 worker threads
+// are started on first use and then wait for the next task, so that
+// objects that are only copied do not start any threads. The task is
+// called with the index of the thread, which selects the share of the
+// work of that thread, and run() returns once all threads are done.
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+class WorkerPool
+{
+public:
+    // constructor
+    WorkerPool(int numThreads);
+    
+    // destructor
+    ~WorkerPool();
+    
+    // method to run theTask(k) on the threads k = 0..numThreads-1
+    void run(const std::function<void(int)> &theTask);
+    
+    int getNumThreads() const {return numThreads;};
+    
+private:
+    void startWorkers();
+    void stopWorkers();
+    void workerLoop(int k);
+    
+    int numThreads;         // number of threads incl. the calling thread
+    
+    // worker threads (numThreads-1 threads, started on first use)
+    std::thread *workers;
+    std::mutex theMutex;
+    std::condition_variable jobReady;   // signaled by the calling thread
+    std::condition_variable jobDone;    // signaled by the last worker
+    const std::function<void(int)> *task;  // task of the current job
+    long jobCount;          // number of jobs posted to the workers
+    bool stopping;          // flag if the workers have to exit
+    int numBusy;            // number of workers still running the task
+};
+
+#endif
@@ -139,6 +139,8 @@ extern int TclRemoveExpRecorder(ClientData clientData, Tcl_Interp *interp,
     int argc, TCL_Char **argv);
 extern int TclExpRecord(ClientData clientData, Tcl_Interp *interp,
     int argc, TCL_Char **argv);
+extern int TclExpTimingReport(ClientData clientData, Tcl_Interp *interp,
+    int argc, TCL_Char **argv);
 
 int openFresco_addExperimentalRecorder(ClientData clientData,
     Tcl_Interp *interp, int argc, TCL_Char **argv)
@@ -282,6 +284,13 @@ int openFresco_record(ClientData clientData,
 }
 
 
+int openFresco_timingReport(ClientData clientData,
+    Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+    return TclExpTimingReport(clientData, interp, argc, argv);
+}
+
+
 int openFresco_version(ClientData clientData,
     Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
@@ -372,6 +381,9 @@ OpenFresco(ClientData clientData, Tcl_Interp *interp, int argc,
     Tcl_CreateCommand(interp, "recordExp", openFresco_record,
         (ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
     
+    Tcl_CreateCommand(interp, "expTimingReport", openFresco_timingReport,
+        (ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
+    
     Tcl_CreateCommand(interp, "packageVersion", openFresco_version,
         (ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
     
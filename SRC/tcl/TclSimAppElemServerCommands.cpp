@@ -32,21 +32,77 @@
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <SharedMemoryChannel.h>
 
 #include <ExperimentalElement.h>
 
 
+// connection of one simulation application client (e.g. a
+// GenericClient element) to an experimental element
+struct SimAppElemClient
+{
+    SimAppElemClient(Channel *theChannel);
+    ~SimAppElemClient();
+    
+    int recvSizes();
+    int setElement(ExperimentalElement *theElement);
+    int recvAction();
+    void serveAction(int action, Domain *theDomain, bool multi);
+    
+    Channel *theChannel;
+    bool framed;        // framed protocol requested by the client
+    int state;          // 0: wait for the data sizes, 1: wait for the
+                        // first action, 2: connected to the element
+    bool committed;     // flag if the client committed in this step
+    
+    ExperimentalElement *theElement;
+    Node **theNodes;
+    int numNodes, ndf;
+    
+    int intData[2*OF_Resp_All+1];
+    int dataSize;
+    double *rData, *sData;
+    Vector *recvData, *sendData, *sDaqData, *sMatrixData;
+    Vector *rDisp, *rVel, *rAccel, *rForce, *rTime;
+    Vector *sDisp, *sVel, *sAccel, *sForce, *sTime;
+    Matrix *sMatrix;
+    Vector nodeData;
+};
+
+
+// send the reply either padded to the full data size (fixed protocol)
+// or as the exact-size response vector (framed protocol)
+static int sendReply(Channel *theChannel, bool framed,
+    Vector &sendData, Vector &theResponse)
+{
+    if (framed)
+        return theChannel->sendFramedVector(0, 0, theResponse,
+            theResponse.Size(), 0);
+    
+    return theChannel->sendVector(0, 0, sendData, 0);
+}
+
+
+static int startSimAppElemServerMulti(Tcl_Interp *interp,
+    int argc, TCL_Char **argv, Domain *theDomain);
+
+
 int TclStartSimAppElemServer(ClientData clientData, Tcl_Interp *interp,
     int argc, TCL_Char **argv, Domain *theDomain)
 { 
     if (argc < 3)  {
         opserr << "WARNING insufficient arguments\n"
-            << "Want: startSimAppElemServer eleTag ipPort <-udp> <-ssl>\n";
+            << "Want: startSimAppElemServer eleTag ipPort <-udp> <-ssl> <-shm>\n"
+            << "  or: startSimAppElemServer -multi ipPort eleTag1 eleTag2 ...\n";
         return TCL_ERROR;
     }
     
+    // several clients on one port
+    if (strcmp(argv[1], "-multi") == 0)
+        return startSimAppElemServerMulti(interp, argc, argv, theDomain);
+    
     int eleTag, ipPort;
-    int ssl = 0, udp = 0;
+    int ssl = 0, udp = 0, shm = 0;
     Channel *theChannel = 0;
     
     if (Tcl_GetInt(interp, argv[1], &eleTag) != TCL_OK)  {
@@ -69,6 +125,8 @@ int TclStartSimAppElemServer(ClientData clientData, Tcl_Interp *interp,
             ssl = 1;
         else if (strcmp(argv[3], "-udp") == 0)
             udp = 1;
+        else if (strcmp(argv[3], "-shm") == 0)
+            shm = 1;
     }
     
     // setup the connection
@@ -92,6 +150,16 @@ int TclStartSimAppElemServer(ClientData clientData, Tcl_Interp *interp,
             return TCL_ERROR;
         }
     }
+    else if (shm)  {
+        theChannel = new SharedMemoryChannel(ipPort);
+        if (theChannel != 0) {
+            opserr << "\nShared Memory Channel successfully created: "
+                << "Waiting for Simulation Application Client...\n";
+        } else {
+            opserr << "WARNING could not create shared memory channel\n";
+            return TCL_ERROR;
+        }
+    }
     else  {
         theChannel = new TCP_Socket(ipPort);
         if (theChannel != 0) {
@@ -104,58 +172,295 @@ int TclStartSimAppElemServer(ClientData clientData, Tcl_Interp *interp,
     }
     if (theChannel->setUpConnection() != 0)  {
         opserr << "WARNING could not setup connection\n";
+        delete theChannel;
         return TCL_ERROR;
     }
     
-    // get the data size for the experimental element
-    int intData[2*OF_Resp_All+1];
-    ID idData(intData, 2*OF_Resp_All+1);
-    ID sizeCtrl(intData, OF_Resp_All);
-    ID sizeDaq(&intData[OF_Resp_All], OF_Resp_All);
-    int *dataSize = &intData[2*OF_Resp_All];
-    idData.Zero();
-    
-    theChannel->recvID(0, 0, idData, 0);
+    // get the data size and check it against the experimental element
+    SimAppElemClient theClient(theChannel);
+    if (theClient.recvSizes() != 0)  {
+        opserr << "WARNING could not receive data sizes\n";
+        return TCL_ERROR;
+    }
+    if (theClient.setElement(theExperimentalElement) != 0)
+        return TCL_ERROR;
     
-    // check data size of experimental element
-    int i, ndf = 0;
-    const ID eleNodes = theExperimentalElement->getExternalNodes();
-    int numNodes = eleNodes.Size();
-    Node **theNodes = theExperimentalElement->getNodePtrs();
+    // start server loop
+    opserr << "\nSimAppElemServer with ExpElement " << eleTag
+        << " now running...\n";
+    int action = 0;
+    while (action != OF_RemoteTest_DIE) {
+        action = theClient.recvAction();
+        if (action < 0)  {
+            opserr << "WARNING SimAppElemServer lost connection "
+                << "to Simulation Application Client\n";
+            break;
+        }
+        theClient.serveAction(action, theDomain, false);
+    }
+    opserr << "\nSimAppElemServer with ExpElement " << eleTag
+        << " shutdown\n\n";
     
-    for (i=0; i<numNodes; i++) {
-        ndf += theNodes[i]->getNumberDOF();
+    return TCL_OK;
+}
+
+
+// serve several clients on one TCP port, each client is connected to
+// the element whose tag it sends with the open action (EEGeneric sends
+// its tag), a client whose first action is not an open action with a
+// free element tag is rejected, so that the connection does not depend
+// on the order in which the clients connect, all clients are served by
+// one thread, so that the domain is only accessed sequentially
+static int startSimAppElemServerMulti(Tcl_Interp *interp,
+    int argc, TCL_Char **argv, Domain *theDomain)
+{
+    if (argc < 4)  {
+        opserr << "WARNING insufficient arguments\n"
+            << "Want: startSimAppElemServer -multi ipPort eleTag1 eleTag2 ...\n";
+        return TCL_ERROR;
     }
     
-    if ((sizeCtrl(OF_Resp_Disp) != 0 && sizeCtrl(OF_Resp_Disp) != ndf) ||
-        (sizeCtrl(OF_Resp_Vel) != 0 && sizeCtrl(OF_Resp_Vel) != ndf) ||
-        (sizeCtrl(OF_Resp_Accel) != 0 && sizeCtrl(OF_Resp_Accel) != ndf) ||
-        (sizeCtrl(OF_Resp_Force) != 0 && sizeCtrl(OF_Resp_Force) != ndf) ||
-        (sizeCtrl(OF_Resp_Time) != 0 && sizeCtrl(OF_Resp_Time) != 1)) {
-        opserr << "WARNING incorrect number of control degrees of freedom (ndf)\n";
-        opserr << "want: " << ndf << " but got: " << sizeCtrl << endln;
+    int ipPort, i, j;
+    if (Tcl_GetInt(interp, argv[2], &ipPort) != TCL_OK)  {
+        opserr << "WARNING invalid startSimAppElemServer ipPort\n";
         return TCL_ERROR;
     }
-    if ((sizeDaq(OF_Resp_Disp) != 0 && sizeDaq(OF_Resp_Disp) != ndf) ||
-        (sizeDaq(OF_Resp_Vel) != 0 && sizeDaq(OF_Resp_Vel) != ndf) ||
-        (sizeDaq(OF_Resp_Accel) != 0 && sizeDaq(OF_Resp_Accel) != ndf) ||
-        (sizeDaq(OF_Resp_Force) != 0 && sizeDaq(OF_Resp_Force) != ndf) ||
-        (sizeDaq(OF_Resp_Time) != 0 && sizeDaq(OF_Resp_Time) != 1)) {
-        opserr << "WARNING incorrect number of daq degrees of freedom (ndf)\n";
-        opserr << "want: " << ndf << " but got: " << sizeDaq << endln;
+    int numEle = argc-3;
+    ID eleTags(numEle);
+    for (i=0; i<numEle; i++)  {
+        if (Tcl_GetInt(interp, argv[3+i], &eleTags(i)) != TCL_OK)  {
+            opserr << "WARNING invalid startSimAppElemServer eleTag\n";
+            return TCL_ERROR;
+        }
+        if (dynamic_cast <ExperimentalElement*>
+            (theDomain->getElement(eleTags(i))) == 0)  {
+            opserr << "WARNING experimental element not found\n";
+            opserr << "startSimAppElemServer expElement: " << eleTags(i) << endln;
+            return TCL_ERROR;
+        }
+    }
+    
+    // setup the listening socket
+    TCP_Socket *theListener = new TCP_Socket(ipPort);
+    if (theListener->listenForConnections(numEle) != 0)  {
+        opserr << "WARNING could not setup connection\n";
+        delete theListener;
         return TCL_ERROR;
     }
+    opserr << "\nTCP Channel successfully created: Waiting for "
+        << numEle << " Simulation Application Clients...\n";
     
-    // initialize the receive and send vectors
-    Vector *rDisp  = 0, *sDisp  = 0;
-    Vector *rVel   = 0, *sVel   = 0;
-    Vector *rAccel = 0, *sAccel = 0;
-    Vector *rForce = 0, *sForce = 0;
-    Vector *rTime  = 0, *sTime  = 0;
+    // theSockets[0] is the listening socket and theSockets[1+i] the
+    // socket of client i, closed sockets are set to zero
+    TCP_Socket **theSockets = new TCP_Socket* [numEle+1];
+    SimAppElemClient **theClients = new SimAppElemClient* [numEle];
+    bool *ready = new bool [numEle+1];
+    ID clientOfEle(numEle);
+    for (i=0; i<numEle; i++)  {
+        theSockets[1+i] = 0;
+        theClients[i] = 0;
+        clientOfEle(i) = -1;
+    }
+    theSockets[0] = theListener;
+    
+    // start server loop
+    opserr << "\nSimAppElemServer with " << numEle
+        << " ExpElements now running...\n";
+    int numAccepted = 0, numClosed = 0;
+    while (numClosed < numEle)  {
+        if (TCP_Socket::waitForData(theSockets, numEle+1, ready) < 0)
+            break;
+        
+        // accept a new client, stop listening when all have connected
+        if (ready[0])  {
+            TCP_Socket *theSocket = theListener->acceptConnection();
+            if (theSocket != 0)  {
+                theSockets[1+numAccepted] = theSocket;
+                theClients[numAccepted] = new SimAppElemClient(theSocket);
+                numAccepted++;
+                if (numAccepted == numEle)
+                    theSockets[0] = 0;
+            }
+        }
+        
+        // serve one action of every ready client
+        for (i=0; i<numAccepted; i++)  {
+            if (ready[1+i] == false || theSockets[1+i] == 0)
+                continue;
+            SimAppElemClient *theClient = theClients[i];
+            int action = 0;
+            int rValue = 0;
+            if (theClient->state == 0)  {
+                rValue = theClient->recvSizes();
+            }
+            else  {
+                action = theClient->recvAction();
+                if (action < 0)  {
+                    opserr << "WARNING SimAppElemServer lost connection "
+                        << "to client " << i+1 << endln;
+                    rValue = -1;
+                }
+            }
+            
+            // connect the client to an element with its open action
+            if (rValue == 0 && theClient->state == 1 && action != 0)  {
+                int id = 0, k = -1;
+                if (action == OF_RemoteTest_open)
+                    id = (int)theClient->rData[1];
+                for (j=0; j<numEle && k<0; j++)  {
+                    if (clientOfEle(j) < 0 && eleTags(j) == id)
+                        k = j;
+                }
+                if (action != OF_RemoteTest_open)  {
+                    opserr << "WARNING SimAppElemServer client " << i+1
+                        << " did not send its ExpElement tag with an open action\n";
+                    rValue = -1;
+                }
+                else if (k < 0)  {
+                    opserr << "WARNING SimAppElemServer client " << i+1
+                        << " requested ExpElement " << id
+                        << " which is not served or not free\n";
+                    rValue = -1;
+                }
+                else  {
+                    rValue = theClient->setElement((ExperimentalElement*)
+                        theDomain->getElement(eleTags(k)));
+                    if (rValue == 0)  {
+                        clientOfEle(k) = i;
+                        opserr << "\nSimAppElemServer client " << i+1
+                            << " connected to ExpElement " << eleTags(k) << endln;
+                    }
+                }
+            }
+            
+            if (rValue == 0 && action > 0)
+                theClient->serveAction(action, theDomain, true);
+            
+            // close the connection
+            if (rValue != 0 || action == OF_RemoteTest_DIE)  {
+                delete theClient;
+                theClients[i] = 0;
+                theSockets[1+i] = 0;
+                numClosed++;
+                if (rValue == 0)
+                    opserr << "\nSimAppElemServer client " << i+1
+                        << " disconnected\n";
+            }
+        }
+        
+        // record the domain once all connected clients have committed
+        int numCommitted = 0, numRunning = 0;
+        for (i=0; i<numAccepted; i++)  {
+            if (theClients[i] != 0 && theClients[i]->state == 2)  {
+                numRunning++;
+                if (theClients[i]->committed)
+                    numCommitted++;
+            }
+        }
+        if (numRunning > 0 && numCommitted == numRunning)  {
+            theDomain->setCommittedTime(theDomain->getCurrentTime());
+            theDomain->record();
+            for (i=0; i<numAccepted; i++)
+                if (theClients[i] != 0)
+                    theClients[i]->committed = false;
+        }
+    }
+    opserr << "\nSimAppElemServer with " << numEle
+        << " ExpElements shutdown\n\n";
+    
+    // delete allocated memory
+    for (i=0; i<numAccepted; i++)
+        if (theClients[i] != 0)
+            delete theClients[i];
+    delete [] theClients;
+    delete [] theSockets;
+    delete [] ready;
+    delete theListener;
+    
+    return TCL_OK;
+}
+
+
+SimAppElemClient::SimAppElemClient(Channel *channel)
+    : theChannel(channel), framed(false), state(0), committed(false),
+    theElement(0), theNodes(0), numNodes(0), ndf(0), dataSize(0),
+    rData(0), sData(0),
+    recvData(0), sendData(0), sDaqData(0), sMatrixData(0),
+    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0),
+    sDisp(0), sVel(0), sAccel(0), sForce(0), sTime(0),
+    sMatrix(0), nodeData(1)
+{
+    for (int i=0; i<2*OF_Resp_All+1; i++)
+        intData[i] = 0;
+}
+
+
+SimAppElemClient::~SimAppElemClient()
+{
+    // delete allocated memory
+    if (theChannel != 0)
+        delete theChannel;
     
+    if (rDisp != 0)
+        delete rDisp;
+    if (rVel != 0)
+        delete rVel;
+    if (rAccel != 0)
+        delete rAccel;
+    if (rForce != 0)
+        delete rForce;
+    if (rTime != 0)
+        delete rTime;
+    if (recvData != 0)
+        delete recvData;
+    if (rData != 0)
+        delete [] rData;
+    
+    if (sDisp != 0)
+        delete sDisp;
+    if (sVel != 0)
+        delete sVel;
+    if (sAccel != 0)
+        delete sAccel;
+    if (sForce != 0)
+        delete sForce;
+    if (sTime != 0)
+        delete sTime;
+    if (sMatrix != 0)
+        delete sMatrix;
+    if (sMatrixData != 0)
+        delete sMatrixData;
+    if (sDaqData != 0)
+        delete sDaqData;
+    if (sendData != 0)
+        delete sendData;
+    if (sData != 0)
+        delete [] sData;
+}
+
+
+int SimAppElemClient::recvSizes()
+{
+    // get the data size for the experimental element
+    ID idData(intData, 2*OF_Resp_All+1);
+    ID sizeCtrl(intData, OF_Resp_All);
+    ID sizeDaq(&intData[OF_Resp_All], OF_Resp_All);
+    idData.Zero();
+    
+    if (theChannel->recvID(0, 0, idData, 0) < 0)
+        return -1;
+    
+    // a negative data size requests the framed protocol
+    dataSize = intData[2*OF_Resp_All];
+    if (dataSize < 0)  {
+        framed = true;
+        dataSize = -dataSize;
+    }
+    
+    // initialize the receive and send vectors
     int id = 1;
-    double *rData = new double [*dataSize];
-    Vector *recvData = new Vector(rData, *dataSize);
+    rData = new double [dataSize];
+    recvData = new Vector(rData, dataSize);
     if (sizeCtrl(OF_Resp_Disp) != 0)  {
         rDisp = new Vector(&rData[id], sizeCtrl(OF_Resp_Disp));
         id += sizeCtrl(OF_Resp_Disp);
@@ -179,8 +484,8 @@ int TclStartSimAppElemServer(ClientData clientData, Tcl_Interp *interp,
     recvData->Zero();
     
     id = 0;
-    double *sData = new double [*dataSize];
-    Vector *sendData = new Vector(sData, *dataSize);
+    sData = new double [dataSize];
+    sendData = new Vector(sData, dataSize);
     if (sizeDaq(OF_Resp_Disp) != 0)  {
         sDisp = new Vector(&sData[id], sizeDaq(OF_Resp_Disp));
         id += sizeDaq(OF_Resp_Disp);
@@ -201,145 +506,182 @@ int TclStartSimAppElemServer(ClientData clientData, Tcl_Interp *interp,
         sTime = new Vector(&sData[id], sizeDaq(OF_Resp_Time));
         id += sizeDaq(OF_Resp_Time);
     }
+    sDaqData = new Vector(sData, id);
     sendData->Zero();
-    Matrix *sMatrix = new Matrix(sData, ndf, ndf);
-    sMatrix->Zero();
     
-    // start server loop
-    opserr << "\nSimAppElemServer with ExpElement " << eleTag
-        << " now running...\n";
-    Vector nodeData(1);
-    bool exitYet = false;
-    while (!exitYet) {
-        theChannel->recvVector(0, 0, *recvData, 0);
-        int action = (int)rData[0];
-        
-        //opserr << "\nLOOP action: " << *recvData << endln;
-        switch(action) {
-        case OF_RemoteTest_open:
-            opserr << "\nConnected to GenericClient Element\n";
-            break;
-        case OF_RemoteTest_setup:
-            opserr << "WARNING SimAppElemServer action setup "
-                << "received which does nothing, continuing execution\n";
-            break;
-        case OF_RemoteTest_setTrialResponse:
-            id = 0;
-            for (i=0; i<numNodes; i++) {
-                ndf = theNodes[i]->getNumberDOF();
-                nodeData.resize(ndf);
-                if (rDisp != 0) {
-                    nodeData.Extract(*rDisp,id);
-                    theNodes[i]->setTrialDisp(nodeData);
-                }
-                if (rVel != 0) {
-                    nodeData.Extract(*rVel,id);
-                    theNodes[i]->setTrialVel(nodeData);
-                }
-                if (rAccel != 0) {
-                    nodeData.Extract(*rAccel,id);
-                    theNodes[i]->setTrialAccel(nodeData);
-                }
-                id += ndf;
-            }
-            if (rTime != 0)
-                theDomain->setCurrentTime((*rTime)(0));
-            theDomain->update();
-            break;
-        case OF_RemoteTest_commitState:
-            theDomain->commit();
-            break;
-        case OF_RemoteTest_getDaqResponse:
-            if (sDisp != 0)
-                (*sDisp) = theExperimentalElement->getDisp();
-            if (sVel != 0)
-                (*sVel) = theExperimentalElement->getVel();
-            if (sAccel != 0)
-                (*sAccel) = theExperimentalElement->getAccel();
-            if (sForce != 0)
-                (*sForce) = theExperimentalElement->getResistingForce();
-            if (sTime != 0)
-                (*sTime) = theExperimentalElement->getTime();
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
-        case OF_RemoteTest_getDisp:
-            (*sDisp) = theExperimentalElement->getDisp();
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
-        case OF_RemoteTest_getVel:
-            (*sVel) = theExperimentalElement->getVel();
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
-        case OF_RemoteTest_getAccel:
-            (*sAccel) = theExperimentalElement->getAccel();
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
-        case OF_RemoteTest_getForce:
-            (*sForce) = theExperimentalElement->getResistingForce();
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
-        case OF_RemoteTest_getTime:
-            (*sTime) = theExperimentalElement->getTime();
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
-        case OF_RemoteTest_getInitialStiff:
-            (*sMatrix) = theExperimentalElement->getInitialStiff();
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
-        case OF_RemoteTest_getTangentStiff:
-            (*sMatrix) = theExperimentalElement->getTangentStiff();
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
-        case OF_RemoteTest_getDamp:
-            (*sMatrix) = theExperimentalElement->getDamp();
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
-        case OF_RemoteTest_getMass:
-            (*sMatrix) = theExperimentalElement->getMass();
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
-        case OF_RemoteTest_DIE:
-            exitYet = true;
-            break;
-        default:
-            opserr << "WARNING SimAppElemServer invalid action "
-                << action << " received\n";
-            break;
-        }
+    state = 1;
+    
+    return 0;
+}
+
+
+int SimAppElemClient::setElement(ExperimentalElement *element)
+{
+    ID sizeCtrl(intData, OF_Resp_All);
+    ID sizeDaq(&intData[OF_Resp_All], OF_Resp_All);
+    
+    // check data size of experimental element
+    theElement = element;
+    numNodes = theElement->getExternalNodes().Size();
+    theNodes = theElement->getNodePtrs();
+    ndf = 0;
+    for (int i=0; i<numNodes; i++) {
+        ndf += theNodes[i]->getNumberDOF();
     }
-    opserr << "\nSimAppElemServer with ExpElement " << eleTag
-        << " shutdown\n\n";
     
-    // delete allocated memory
-    if (theChannel != 0)
-        delete theChannel;
+    if ((sizeCtrl(OF_Resp_Disp) != 0 && sizeCtrl(OF_Resp_Disp) != ndf) ||
+        (sizeCtrl(OF_Resp_Vel) != 0 && sizeCtrl(OF_Resp_Vel) != ndf) ||
+        (sizeCtrl(OF_Resp_Accel) != 0 && sizeCtrl(OF_Resp_Accel) != ndf) ||
+        (sizeCtrl(OF_Resp_Force) != 0 && sizeCtrl(OF_Resp_Force) != ndf) ||
+        (sizeCtrl(OF_Resp_Time) != 0 && sizeCtrl(OF_Resp_Time) != 1)) {
+        opserr << "WARNING incorrect number of control degrees of freedom (ndf)\n";
+        opserr << "want: " << ndf << " but got: " << sizeCtrl << endln;
+        return -1;
+    }
+    if ((sizeDaq(OF_Resp_Disp) != 0 && sizeDaq(OF_Resp_Disp) != ndf) ||
+        (sizeDaq(OF_Resp_Vel) != 0 && sizeDaq(OF_Resp_Vel) != ndf) ||
+        (sizeDaq(OF_Resp_Accel) != 0 && sizeDaq(OF_Resp_Accel) != ndf) ||
+        (sizeDaq(OF_Resp_Force) != 0 && sizeDaq(OF_Resp_Force) != ndf) ||
+        (sizeDaq(OF_Resp_Time) != 0 && sizeDaq(OF_Resp_Time) != 1)) {
+        opserr << "WARNING incorrect number of daq degrees of freedom (ndf)\n";
+        opserr << "want: " << ndf << " but got: " << sizeDaq << endln;
+        return -1;
+    }
     
-    if (rDisp != 0)
-        delete rDisp;
-    if (rVel != 0)
-        delete rVel;
-    if (rAccel != 0)
-        delete rAccel;
-    if (rForce != 0)
-        delete rForce;
-    if (rTime != 0)
-        delete rTime;
-    delete recvData;
-    delete [] rData;
+    sMatrix = new Matrix(sData, ndf, ndf);
+    sMatrixData = new Vector(sData, ndf*ndf);
+    sMatrix->Zero();
     
-    if (sDisp != 0)
-        delete sDisp;
-    if (sVel != 0)
-        delete sVel;
-    if (sAccel != 0)
-        delete sAccel;
-    if (sForce != 0)
-        delete sForce;
-    if (sTime != 0)
-        delete sTime;
-    delete sMatrix;
-    delete sendData;
-    delete [] sData;
+    state = 2;
     
-    return TCL_OK;
+    return 0;
+}
+
+
+int SimAppElemClient::recvAction()
+{
+    int numData, rValue;
+    if (framed)
+        rValue = theChannel->recvFramedVector(0, 0, *recvData, numData, 0);
+    else
+        rValue = theChannel->recvVector(0, 0, *recvData, 0);
+    if (rValue < 0)
+        return -1;
+    
+    return (int)rData[0];
+}
+
+
+void SimAppElemClient::serveAction(int action, Domain *theDomain,
+    bool multi)
+{
+    int i, id;
+    
+    //opserr << "\nLOOP action: " << *recvData << endln;
+    switch(action) {
+    case OF_RemoteTest_open:
+        opserr << "\nConnected to GenericClient Element\n";
+        break;
+    case OF_RemoteTest_setup:
+        opserr << "WARNING SimAppElemServer action setup "
+            << "received which does nothing, continuing execution\n";
+        break;
+    case OF_RemoteTest_commitState:
+        // with several clients only the nodes and the element of
+        // this client are committed, the domain is recorded once
+        // all clients have committed
+        if (multi)  {
+            for (i=0; i<numNodes; i++)
+                theNodes[i]->commitState();
+            theElement->commitState();
+            committed = true;
+        }
+        else
+            theDomain->commit();
+        break;
+    case OF_RemoteTest_setTrialResponse:
+    case OF_RemoteTest_setTrialGetDaqResponse:
+        id = 0;
+        for (i=0; i<numNodes; i++) {
+            int ndfNode = theNodes[i]->getNumberDOF();
+            nodeData.resize(ndfNode);
+            if (rDisp != 0) {
+                nodeData.Extract(*rDisp,id);
+                theNodes[i]->setTrialDisp(nodeData);
+            }
+            if (rVel != 0) {
+                nodeData.Extract(*rVel,id);
+                theNodes[i]->setTrialVel(nodeData);
+            }
+            if (rAccel != 0) {
+                nodeData.Extract(*rAccel,id);
+                theNodes[i]->setTrialAccel(nodeData);
+            }
+            id += ndfNode;
+        }
+        if (rTime != 0)
+            theDomain->setCurrentTime((*rTime)(0));
+        if (multi)
+            theElement->update();
+        else
+            theDomain->update();
+        if (action == OF_RemoteTest_setTrialResponse)
+            break;
+        // else reply with the daq response in the same transaction
+    case OF_RemoteTest_getDaqResponse:
+        if (sDisp != 0)
+            (*sDisp) = theElement->getDisp();
+        if (sVel != 0)
+            (*sVel) = theElement->getVel();
+        if (sAccel != 0)
+            (*sAccel) = theElement->getAccel();
+        if (sForce != 0)
+            (*sForce) = theElement->getResistingForce();
+        if (sTime != 0)
+            (*sTime) = theElement->getTime();
+        sendReply(theChannel, framed, *sendData, *sDaqData);
+        break;
+    case OF_RemoteTest_getDisp:
+        (*sDisp) = theElement->getDisp();
+        sendReply(theChannel, framed, *sendData, *sDisp);
+        break;
+    case OF_RemoteTest_getVel:
+        (*sVel) = theElement->getVel();
+        sendReply(theChannel, framed, *sendData, *sVel);
+        break;
+    case OF_RemoteTest_getAccel:
+        (*sAccel) = theElement->getAccel();
+        sendReply(theChannel, framed, *sendData, *sAccel);
+        break;
+    case OF_RemoteTest_getForce:
+        (*sForce) = theElement->getResistingForce();
+        sendReply(theChannel, framed, *sendData, *sForce);
+        break;
+    case OF_RemoteTest_getTime:
+        (*sTime) = theElement->getTime();
+        sendReply(theChannel, framed, *sendData, *sTime);
+        break;
+    case OF_RemoteTest_getInitialStiff:
+        (*sMatrix) = theElement->getInitialStiff();
+        sendReply(theChannel, framed, *sendData, *sMatrixData);
+        break;
+    case OF_RemoteTest_getTangentStiff:
+        (*sMatrix) = theElement->getTangentStiff();
+        sendReply(theChannel, framed, *sendData, *sMatrixData);
+        break;
+    case OF_RemoteTest_getDamp:
+        (*sMatrix) = theElement->getDamp();
+        sendReply(theChannel, framed, *sendData, *sMatrixData);
+        break;
+    case OF_RemoteTest_getMass:
+        (*sMatrix) = theElement->getMass();
+        sendReply(theChannel, framed, *sendData, *sMatrixData);
+        break;
+    case OF_RemoteTest_DIE:
+        break;
+    default:
+        opserr << "WARNING SimAppElemServer invalid action "
+            << action << " received\n";
+        break;
+    }
 }
@@ -30,6 +30,7 @@
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <SharedMemoryChannel.h>
 
 #include <ExperimentalSite.h>
 
@@ -37,17 +38,67 @@ extern ExperimentalSite *getExperimentalSite(int tag);
 extern int removeExperimentalSite(int tag);
 
 
+// connection of one simulation application client to an
+// experimental site
+struct SimAppSiteClient
+{
+    SimAppSiteClient(Channel *theChannel);
+    ~SimAppSiteClient();
+    
+    int recvSizes();
+    int setSite(ExperimentalSite *theSite);
+    int recvAction();
+    void serveAction(int action);
+    
+    Channel *theChannel;
+    bool framed;        // framed protocol requested by the client
+    int state;          // 0: wait for the data sizes, 1: wait for the
+                        // first action, 2: connected to the site
+    
+    ExperimentalSite *theSite;
+    
+    int intData[2*OF_Resp_All+1];
+    int dataSize;
+    double *rData, *sData;
+    Vector *recvData, *sendData, *sDaqData;
+    Vector *rDisp, *rVel, *rAccel, *rForce, *rTime;
+    Vector *sDisp, *sVel, *sAccel, *sForce, *sTime;
+};
+
+
+// send the reply either padded to the full data size (fixed protocol)
+// or as the exact-size response vector (framed protocol)
+static int sendReply(Channel *theChannel, bool framed,
+    Vector &sendData, Vector &theResponse)
+{
+    if (framed)
+        return theChannel->sendFramedVector(0, 0, theResponse,
+            theResponse.Size(), 0);
+    
+    return theChannel->sendVector(0, 0, sendData, 0);
+}
+
+
+static int startSimAppSiteServerMulti(Tcl_Interp *interp,
+    int argc, TCL_Char **argv);
+
+
 int TclStartSimAppSiteServer(ClientData clientData,
     Tcl_Interp *interp, int argc, TCL_Char **argv)
 { 
     if (argc < 3)  {
         opserr << "WARNING insufficient arguments\n"
-            << "Want: startSimAppSiteServer siteTag ipPort <-udp> <-ssl>\n";
+            << "Want: startSimAppSiteServer siteTag ipPort <-udp> <-ssl> <-shm>\n"
+            << "  or: startSimAppSiteServer -multi ipPort siteTag1 siteTag2 ...\n";
         return TCL_ERROR;
     }
     
+    // several clients on one port
+    if (strcmp(argv[1], "-multi") == 0)
+        return startSimAppSiteServerMulti(interp, argc, argv);
+    
     int siteTag, ipPort;
-    int ssl = 0, udp = 0;
+    int ssl = 0, udp = 0, shm = 0;
     Channel *theChannel = 0;
     
     if (Tcl_GetInt(interp, argv[1], &siteTag) != TCL_OK)  {
@@ -69,6 +120,8 @@ int TclStartSimAppSiteServer(ClientData clientData,
             ssl = 1;
         else if (strcmp(argv[3], "-udp") == 0)
             udp = 1;
+        else if (strcmp(argv[3], "-shm") == 0)
+            shm = 1;
     }
     
     // setup the connection
@@ -92,6 +145,16 @@ int TclStartSimAppSiteServer(ClientData clientData,
             return TCL_ERROR;
         }
     }
+    else if (shm)  {
+        theChannel = new SharedMemoryChannel(ipPort);
+        if (theChannel != 0) {
+            opserr << "\nShared Memory Channel successfully created: "
+                << "Waiting for Simulation Application Client...\n";
+        } else {
+            opserr << "WARNING could not create shared memory channel\n";
+            return TCL_ERROR;
+        }
+    }
     else  {
         theChannel = new TCP_Socket(ipPort);
         if (theChannel != 0) {
@@ -104,30 +167,267 @@ int TclStartSimAppSiteServer(ClientData clientData,
     }
     if (theChannel->setUpConnection() != 0)  {
         opserr << "WARNING could not setup connection\n";
+        delete theChannel;
         return TCL_ERROR;
     }
     
     // get the data size for the experimental site
-    int intData[2*OF_Resp_All+1];
+    SimAppSiteClient theClient(theChannel);
+    if (theClient.recvSizes() != 0)  {
+        opserr << "WARNING could not receive data sizes\n";
+        return TCL_ERROR;
+    }
+    theClient.setSite(theExperimentalSite);
+    
+    // start server loop
+    opserr << "\nSimAppSiteServer with ExpSite " << siteTag
+        << " now running...\n";
+    int action = 0;
+    while (action != OF_RemoteTest_DIE) {
+        action = theClient.recvAction();
+        if (action < 0)  {
+            opserr << "WARNING SimAppSiteServer lost connection "
+                << "to Simulation Application Client\n";
+            break;
+        }
+        theClient.serveAction(action);
+    }
+    opserr << "\nSimAppSiteServer with ExpSite " << siteTag
+        << " shutdown\n\n";
+    
+    return TCL_OK;
+}
+
+
+// serve several clients on one TCP port, each client is connected to
+// the site whose tag it sends with the open action (ShadowExpSite
+// sends its tag), a client whose first action is not an open action
+// with a free site tag is rejected, so that the connection does not
+// depend on the order in which the clients connect, all clients are
+// served in the order they connected by one thread
+static int startSimAppSiteServerMulti(Tcl_Interp *interp,
+    int argc, TCL_Char **argv)
+{
+    if (argc < 4)  {
+        opserr << "WARNING insufficient arguments\n"
+            << "Want: startSimAppSiteServer -multi ipPort siteTag1 siteTag2 ...\n";
+        return TCL_ERROR;
+    }
+    
+    int ipPort, i, j;
+    if (Tcl_GetInt(interp, argv[2], &ipPort) != TCL_OK)  {
+        opserr << "WARNING invalid startSimAppSiteServer ipPort\n";
+        return TCL_ERROR;
+    }
+    int numSites = argc-3;
+    ID siteTags(numSites);
+    for (i=0; i<numSites; i++)  {
+        if (Tcl_GetInt(interp, argv[3+i], &siteTags(i)) != TCL_OK)  {
+            opserr << "WARNING invalid startSimAppSiteServer siteTag\n";
+            return TCL_ERROR;
+        }
+        if (getExperimentalSite(siteTags(i)) == 0)  {
+            opserr << "WARNING experimental site not found\n";
+            opserr << "startSimAppSiteServer expSite: " << siteTags(i) << endln;
+            return TCL_ERROR;
+        }
+    }
+    
+    // setup the listening socket
+    TCP_Socket *theListener = new TCP_Socket(ipPort);
+    if (theListener->listenForConnections(numSites) != 0)  {
+        opserr << "WARNING could not setup connection\n";
+        delete theListener;
+        return TCL_ERROR;
+    }
+    opserr << "\nTCP Channel successfully created: Waiting for "
+        << numSites << " Simulation Application Clients...\n";
+    
+    // theSockets[0] is the listening socket and theSockets[1+i] the
+    // socket of client i, closed sockets are set to zero
+    TCP_Socket **theSockets = new TCP_Socket* [numSites+1];
+    SimAppSiteClient **theClients = new SimAppSiteClient* [numSites];
+    bool *ready = new bool [numSites+1];
+    ID clientOfSite(numSites);
+    for (i=0; i<numSites; i++)  {
+        theSockets[1+i] = 0;
+        theClients[i] = 0;
+        clientOfSite(i) = -1;
+    }
+    theSockets[0] = theListener;
+    
+    // start server loop
+    opserr << "\nSimAppSiteServer with " << numSites
+        << " ExpSites now running...\n";
+    int numAccepted = 0, numClosed = 0;
+    while (numClosed < numSites)  {
+        if (TCP_Socket::waitForData(theSockets, numSites+1, ready) < 0)
+            break;
+        
+        // accept a new client, stop listening when all have connected
+        if (ready[0])  {
+            TCP_Socket *theSocket = theListener->acceptConnection();
+            if (theSocket != 0)  {
+                theSockets[1+numAccepted] = theSocket;
+                theClients[numAccepted] = new SimAppSiteClient(theSocket);
+                numAccepted++;
+                if (numAccepted == numSites)
+                    theSockets[0] = 0;
+            }
+        }
+        
+        // serve one action of every ready client
+        for (i=0; i<numAccepted; i++)  {
+            if (ready[1+i] == false || theSockets[1+i] == 0)
+                continue;
+            SimAppSiteClient *theClient = theClients[i];
+            int action = 0;
+            int rValue = 0;
+            if (theClient->state == 0)  {
+                rValue = theClient->recvSizes();
+            }
+            else  {
+                action = theClient->recvAction();
+                if (action < 0)  {
+                    opserr << "WARNING SimAppSiteServer lost connection "
+                        << "to client " << i+1 << endln;
+                    rValue = -1;
+                }
+            }
+            
+            // connect the client to a site with its open action
+            if (rValue == 0 && theClient->state == 1 && action != 0)  {
+                int id = 0, k = -1;
+                if (action == OF_RemoteTest_open)
+                    id = (int)theClient->rData[1];
+                for (j=0; j<numSites && k<0; j++)  {
+                    if (clientOfSite(j) < 0 && siteTags(j) == id)
+                        k = j;
+                }
+                if (action != OF_RemoteTest_open)  {
+                    opserr << "WARNING SimAppSiteServer client " << i+1
+                        << " did not send its ExpSite tag with an open action\n";
+                    rValue = -1;
+                }
+                else if (k < 0)  {
+                    opserr << "WARNING SimAppSiteServer client " << i+1
+                        << " requested ExpSite " << id
+                        << " which is not served or not free\n";
+                    rValue = -1;
+                }
+                else  {
+                    clientOfSite(k) = i;
+                    theClient->setSite(getExperimentalSite(siteTags(k)));
+                    opserr << "\nSimAppSiteServer client " << i+1
+                        << " connected to ExpSite " << siteTags(k) << endln;
+                }
+            }
+            
+            if (rValue == 0 && action > 0)
+                theClient->serveAction(action);
+            
+            // close the connection
+            if (rValue != 0 || action == OF_RemoteTest_DIE)  {
+                delete theClient;
+                theClients[i] = 0;
+                theSockets[1+i] = 0;
+                numClosed++;
+                if (rValue == 0)
+                    opserr << "\nSimAppSiteServer client " << i+1
+                        << " disconnected\n";
+            }
+        }
+    }
+    opserr << "\nSimAppSiteServer with " << numSites
+        << " ExpSites shutdown\n\n";
+    
+    // delete allocated memory
+    for (i=0; i<numAccepted; i++)
+        if (theClients[i] != 0)
+            delete theClients[i];
+    delete [] theClients;
+    delete [] theSockets;
+    delete [] ready;
+    delete theListener;
+    
+    return TCL_OK;
+}
+
+
+SimAppSiteClient::SimAppSiteClient(Channel *channel)
+    : theChannel(channel), framed(false), state(0),
+    theSite(0), dataSize(0), rData(0), sData(0),
+    recvData(0), sendData(0), sDaqData(0),
+    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0),
+    sDisp(0), sVel(0), sAccel(0), sForce(0), sTime(0)
+{
+    for (int i=0; i<2*OF_Resp_All+1; i++)
+        intData[i] = 0;
+}
+
+
+SimAppSiteClient::~SimAppSiteClient()
+{
+    // delete allocated memory
+    if (theChannel != 0)
+        delete theChannel;
+    
+    if (rDisp != 0)
+        delete rDisp;
+    if (rVel != 0)
+        delete rVel;
+    if (rAccel != 0)
+        delete rAccel;
+    if (rForce != 0)
+        delete rForce;
+    if (rTime != 0)
+        delete rTime;
+    if (recvData != 0)
+        delete recvData;
+    if (rData != 0)
+        delete [] rData;
+    
+    if (sDisp != 0)
+        delete sDisp;
+    if (sVel != 0)
+        delete sVel;
+    if (sAccel != 0)
+        delete sAccel;
+    if (sForce != 0)
+        delete sForce;
+    if (sTime != 0)
+        delete sTime;
+    if (sDaqData != 0)
+        delete sDaqData;
+    if (sendData != 0)
+        delete sendData;
+    if (sData != 0)
+        delete [] sData;
+}
+
+
+int SimAppSiteClient::recvSizes()
+{
+    // get the data size for the experimental site
     ID idData(intData, 2*OF_Resp_All+1);
     ID sizeCtrl(intData, OF_Resp_All);
     ID sizeDaq(&intData[OF_Resp_All], OF_Resp_All);
-    int *dataSize = &intData[2*OF_Resp_All];
     idData.Zero();
     
-    theChannel->recvID(0, 0, idData, 0);
-    theExperimentalSite->setSize(sizeCtrl, sizeDaq);
+    if (theChannel->recvID(0, 0, idData, 0) < 0)
+        return -1;
     
-    // initialize the receive and send vectors
-    Vector *rDisp  = 0, *sDisp  = 0;
-    Vector *rVel   = 0, *sVel   = 0;
-    Vector *rAccel = 0, *sAccel = 0;
-    Vector *rForce = 0, *sForce = 0;
-    Vector *rTime  = 0, *sTime  = 0;
+    // a negative data size requests the framed protocol
+    dataSize = intData[2*OF_Resp_All];
+    if (dataSize < 0)  {
+        framed = true;
+        dataSize = -dataSize;
+    }
     
+    // initialize the receive and send vectors
     int id = 1;
-    double *rData = new double [*dataSize];
-    Vector *recvData = new Vector(rData, *dataSize);
+    rData = new double [dataSize];
+    recvData = new Vector(rData, dataSize);
     if (sizeCtrl(OF_Resp_Disp) != 0)  {
         rDisp = new Vector(&rData[id], sizeCtrl(OF_Resp_Disp));
         id += sizeCtrl(OF_Resp_Disp);
@@ -151,8 +451,8 @@ int TclStartSimAppSiteServer(ClientData clientData,
     recvData->Zero();
     
     id = 0;
-    double *sData = new double [*dataSize];
-    Vector *sendData = new Vector(sData, *dataSize);
+    sData = new double [dataSize];
+    sendData = new Vector(sData, dataSize);
     if (sizeDaq(OF_Resp_Disp) != 0)  {
         sDisp = new Vector(&sData[id], sizeDaq(OF_Resp_Disp));
         id += sizeDaq(OF_Resp_Disp);
@@ -173,98 +473,94 @@ int TclStartSimAppSiteServer(ClientData clientData,
         sTime = new Vector(&sData[id], sizeDaq(OF_Resp_Time));
         id += sizeDaq(OF_Resp_Time);
     }
+    sDaqData = new Vector(sData, id);
     sendData->Zero();
     
-    // start server loop
-    opserr << "\nSimAppSiteServer with ExpSite " << siteTag
-        << " now running...\n";
-    bool exitYet = false;
-    while (!exitYet) {
-        theChannel->recvVector(0, 0, *recvData, 0);
-        int action = (int)rData[0];
-        
-        //opserr << "\nLOOP action: " << *recvData << endln;
-        switch(action) {
-        case OF_RemoteTest_open:
-            opserr << "\nConnected to Experimental Element\n";
-            break;
-        case OF_RemoteTest_setup:
-            opserr << "WARNING SimAppSiteServer action setup "
-                << "received which does nothing, continuing execution\n";
-            break;
-        case OF_RemoteTest_setTrialResponse:
-            theExperimentalSite->setTrialResponse(rDisp, rVel, rAccel, rForce, rTime);
-            break;
-        case OF_RemoteTest_commitState:
-            theExperimentalSite->commitState(rTime);
-            break;
-        case OF_RemoteTest_getDaqResponse:
-            theExperimentalSite->getDaqResponse(sDisp, sVel, sAccel, sForce, sTime);
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
-        case OF_RemoteTest_getDisp:
-            (*sDisp) = theExperimentalSite->getDisp();
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
-        case OF_RemoteTest_getVel:
-            (*sVel) = theExperimentalSite->getVel();
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
-        case OF_RemoteTest_getAccel:
-            (*sAccel) = theExperimentalSite->getAccel();
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
-        case OF_RemoteTest_getForce:
-            (*sForce) = theExperimentalSite->getForce();
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
-        case OF_RemoteTest_getTime:
-            (*sTime) = theExperimentalSite->getTime();
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
-        case OF_RemoteTest_DIE:
-            //removeExperimentalSite(siteTag);
-            //theExperimentalSite = 0;
-            exitYet = true;
-            break;
-        default:
-            opserr << "WARNING SimAppSiteServer invalid action "
-                << action << " received\n";
-            break;
-        }
-    }
-    opserr << "\nSimAppSiteServer with ExpSite " << siteTag
-        << " shutdown\n\n";
+    state = 1;
     
-    // delete allocated memory
-    if (theChannel != 0)
-        delete theChannel;
+    return 0;
+}
+
+
+int SimAppSiteClient::setSite(ExperimentalSite *site)
+{
+    ID sizeCtrl(intData, OF_Resp_All);
+    ID sizeDaq(&intData[OF_Resp_All], OF_Resp_All);
     
-    if (rDisp != 0)
-        delete rDisp;
-    if (rVel != 0)
-        delete rVel;
-    if (rAccel != 0)
-        delete rAccel;
-    if (rForce != 0)
-        delete rForce;
-    if (rTime != 0)
-        delete rTime;
-    delete recvData;
-    delete [] rData;
+    theSite = site;
+    theSite->setSize(sizeCtrl, sizeDaq);
     
-    if (sDisp != 0)
-        delete sDisp;
-    if (sVel != 0)
-        delete sVel;
-    if (sAccel != 0)
-        delete sAccel;
-    if (sForce != 0)
-        delete sForce;
-    if (sTime != 0)
-        delete sTime;
-    delete sendData;
-    delete [] sData;
+    state = 2;
     
-    return TCL_OK;
+    return 0;
+}
+
+
+int SimAppSiteClient::recvAction()
+{
+    int numData, rValue;
+    if (framed)
+        rValue = theChannel->recvFramedVector(0, 0, *recvData, numData, 0);
+    else
+        rValue = theChannel->recvVector(0, 0, *recvData, 0);
+    if (rValue < 0)
+        return -1;
+    
+    return (int)rData[0];
+}
+
+
+void SimAppSiteClient::serveAction(int action)
+{
+    //opserr << "\nLOOP action: " << *recvData << endln;
+    switch(action) {
+    case OF_RemoteTest_open:
+        opserr << "\nConnected to Experimental Element\n";
+        break;
+    case OF_RemoteTest_setup:
+        opserr << "WARNING SimAppSiteServer action setup "
+            << "received which does nothing, continuing execution\n";
+        break;
+    case OF_RemoteTest_commitState:
+        theSite->commitState(rTime);
+        break;
+    case OF_RemoteTest_setTrialResponse:
+    case OF_RemoteTest_setTrialGetDaqResponse:
+        theSite->setTrialResponse(rDisp, rVel, rAccel, rForce, rTime);
+        if (action == OF_RemoteTest_setTrialResponse)
+            break;
+        // else reply with the daq response in the same transaction
+    case OF_RemoteTest_getDaqResponse:
+        theSite->getDaqResponse(sDisp, sVel, sAccel, sForce, sTime);
+        sendReply(theChannel, framed, *sendData, *sDaqData);
+        break;
+    case OF_RemoteTest_getDisp:
+        (*sDisp) = theSite->getDisp();
+        sendReply(theChannel, framed, *sendData, *sDisp);
+        break;
+    case OF_RemoteTest_getVel:
+        (*sVel) = theSite->getVel();
+        sendReply(theChannel, framed, *sendData, *sVel);
+        break;
+    case OF_RemoteTest_getAccel:
+        (*sAccel) = theSite->getAccel();
+        sendReply(theChannel, framed, *sendData, *sAccel);
+        break;
+    case OF_RemoteTest_getForce:
+        (*sForce) = theSite->getForce();
+        sendReply(theChannel, framed, *sendData, *sForce);
+        break;
+    case OF_RemoteTest_getTime:
+        (*sTime) = theSite->getTime();
+        sendReply(theChannel, framed, *sendData, *sTime);
+        break;
+    case OF_RemoteTest_DIE:
+        //removeExperimentalSite(siteTag);
+        //theExperimentalSite = 0;
+        break;
+    default:
+        opserr << "WARNING SimAppSiteServer invalid action "
+            << action << " received\n";
+        break;
+    }
 }
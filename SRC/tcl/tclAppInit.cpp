@@ -261,6 +261,8 @@ extern int TclRemoveExpRecorder(ClientData clientData, Tcl_Interp *interp,
     int argc, TCL_Char **argv);
 extern int TclExpRecord(ClientData clientData, Tcl_Interp *interp,
     int argc, TCL_Char **argv);
+extern int TclExpTimingReport(ClientData clientData, Tcl_Interp *interp,
+    int argc, TCL_Char **argv);
 
 int openFresco_addExperimentalRecorder(ClientData clientData,
     Tcl_Interp *interp, int argc, TCL_Char **argv)
@@ -449,6 +451,13 @@ int openFresco_record(ClientData clientData,
 }
 
 
+int openFresco_timingReport(ClientData clientData,
+    Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+    return TclExpTimingReport(clientData, interp, argc, argv);
+}
+
+
 // model builder command
 int specifyModelBuilder(ClientData clientData, Tcl_Interp *interp,
     int argc, TCL_Char **argv)
@@ -1067,6 +1076,9 @@ int Tcl_AppInit(Tcl_Interp *interp)
     Tcl_CreateCommand(interp, "recordExp", openFresco_record,
         (ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
     
+    Tcl_CreateCommand(interp, "expTimingReport", openFresco_timingReport,
+        (ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
+    
     Tcl_CreateCommand(interp, "model", specifyModelBuilder,
         (ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
     